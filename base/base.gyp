@@ -21,6 +21,7 @@
         'optimize': 'max',
       },
       'dependencies': [
+        'base_simd',
         'base_static',
         'allocator/allocator.gyp:allocator_extension_thunks',
         '../testing/gtest.gyp:gtest_prod',
@@ -346,6 +347,8 @@
         'prefs/pref_service.h',
         'prefs/pref_service_factory.cc',
         'prefs/pref_service_factory.h',
+        'prefs/pref_snapshot.cc',
+        'prefs/pref_snapshot.h',
         'prefs/pref_store.cc',
         'prefs/pref_store.h',
         'prefs/pref_value_map.cc',
@@ -377,6 +380,33 @@
         'prefs/testing_pref_store.h',
       ],
     },
+    {
+      # base64/hex vector kernels, split out so the SSSE3 files can be built
+      # with the matching compiler flags while the rest of base stays on the
+      # baseline instruction set. Callers check CPU support at runtime.
+      'target_name': 'base_simd',
+      'type': 'static_library',
+      'include_dirs': [
+        '..',
+      ],
+      'sources': [
+        'simd_codecs.h',
+        'simd_codecs_neon.cc',
+        'simd_codecs_ssse3.cc',
+      ],
+      'conditions': [
+        ['(target_arch=="ia32" or target_arch=="x64") and OS!="win"', {
+          'cflags': [
+            '-mssse3',
+          ],
+          'xcode_settings': {
+            'OTHER_CFLAGS': [
+              '-mssse3',
+            ],
+          },
+        }],
+      ],
+    },
     {
       # This is the subset of files from base that should not be used with a
       # dynamic library. Note that this library cannot depend on base because
@@ -438,6 +468,7 @@
         'callback_unittest.nc',
         'cancelable_callback_unittest.cc',
         'command_line_unittest.cc',
+        'containers/flat_map_unittest.cc',
         'containers/hash_tables_unittest.cc',
         'containers/linked_list_unittest.cc',
         'containers/mru_cache_unittest.cc',
@@ -445,6 +476,7 @@
         'containers/stack_container_unittest.cc',
         'cpu_unittest.cc',
         'debug/crash_logging_unittest.cc',
+        'debug/heap_accounting_unittest.cc',
         'debug/leak_tracker_unittest.cc',
         'debug/proc_maps_linux_unittest.cc',
         'debug/stack_trace_unittest.cc',
@@ -484,6 +516,7 @@
         'ios/device_util_unittest.mm',
         'json/json_parser_unittest.cc',
         'json/json_reader_unittest.cc',
+        'json/json_stream_parser_unittest.cc',
         'json/json_value_converter_unittest.cc',
         'json/json_value_serializer_unittest.cc',
         'json/json_writer_unittest.cc',
@@ -501,6 +534,7 @@
         'memory/aligned_memory_unittest.cc',
         'memory/discardable_memory_manager_unittest.cc',
         'memory/discardable_memory_unittest.cc',
+        'memory/discardable_shared_memory_unittest.cc',
         'memory/linked_ptr_unittest.cc',
         'memory/ref_counted_memory_unittest.cc',
         'memory/ref_counted_unittest.cc',
@@ -525,6 +559,7 @@
         'metrics/histogram_delta_serialization_unittest.cc',
         'metrics/histogram_snapshot_manager_unittest.cc',
         'metrics/histogram_unittest.cc',
+        'metrics/sharded_counter_unittest.cc',
         'metrics/sparse_histogram_unittest.cc',
         'metrics/stats_table_unittest.cc',
         'metrics/statistics_recorder_unittest.cc',
@@ -543,6 +578,7 @@
         'prefs/pref_member_unittest.cc',
         'prefs/pref_notifier_impl_unittest.cc',
         'prefs/pref_service_unittest.cc',
+        'prefs/pref_snapshot_unittest.cc',
         'prefs/pref_value_map_unittest.cc',
         'prefs/pref_value_store_unittest.cc',
         'prefs/scoped_user_pref_update_unittest.cc',
@@ -605,6 +641,7 @@
         'threading/thread_local_unittest.cc',
         'threading/thread_unittest.cc',
         'threading/watchdog_unittest.cc',
+        'threading/work_stealing_task_scheduler_unittest.cc',
         'threading/worker_pool_posix_unittest.cc',
         'threading/worker_pool_unittest.cc',
         'time/pr_time_unittest.cc',
@@ -794,6 +831,7 @@
         '../testing/gtest.gyp:gtest',
       ],
       'sources': [
+        'base64_perftest.cc',
         'threading/thread_perftest.cc',
         'test/run_all_unittests.cc',
         '../testing/perf/perf_test.cc'
@@ -4,16 +4,58 @@
 
 #include "base/base64.h"
 
+#include "base/cpu.h"
+#include "base/simd_codecs.h"
+#include "build/build_config.h"
 #include "third_party/modp_b64/modp_b64.h"
 
 namespace base {
 
+namespace {
+
+// Below this size the scalar code wins; the SIMD kernels also need enough
+// input to keep their wide loads in bounds.
+const size_t kMinSizeForSimdEncode = 64;
+
+#if defined(ARCH_CPU_X86_FAMILY)
+bool SSSE3Supported() {
+  // Benign race: concurrent initializers compute the same value.
+  static bool supported = CPU().has_ssse3();
+  return supported;
+}
+#endif
+
+// Encodes a whole-group prefix of the input with the vector kernel when
+// available. Returns the number of input bytes consumed; the scalar code
+// finishes from there (including '=' padding).
+size_t Base64EncodePrefix(const StringPiece& input, char* output) {
+  if (input.size() < kMinSizeForSimdEncode)
+    return 0;
+#if defined(ARCH_CPU_X86_FAMILY)
+  if (SSSE3Supported()) {
+    return internal::Base64EncodeSSSE3(
+        reinterpret_cast<const uint8*>(input.data()), input.size(), output);
+  }
+#elif defined(__ARM_NEON__)
+  return internal::Base64EncodeNEON(
+      reinterpret_cast<const uint8*>(input.data()), input.size(), output);
+#endif
+  return 0;
+}
+
+}  // namespace
+
 void Base64Encode(const StringPiece& input, std::string* output) {
   std::string temp;
   temp.resize(modp_b64_encode_len(input.size()));  // makes room for null byte
 
+  size_t consumed = Base64EncodePrefix(input, &(temp[0]));
+  size_t written = consumed / 3 * 4;
+
   // modp_b64_encode_len() returns at least 1, so temp[0] is safe to use.
-  size_t output_size = modp_b64_encode(&(temp[0]), input.data(), input.size());
+  size_t output_size = written + modp_b64_encode(&(temp[written]),
+                                                 input.data() + consumed,
+                                                 input.size() - consumed);
 
   temp.resize(output_size);  // strips off null byte
   output->swap(temp);
@@ -0,0 +1,60 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/base64.h"
+
+#include <string>
+
+#include "base/strings/string_number_conversions.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace base {
+namespace {
+
+const size_t kInputSize = 1024 * 1024;
+const int kIterations = 200;
+
+std::string MakeTestInput() {
+  std::string input(kInputSize, '\0');
+  // Cheap pseudo-random bytes; contents don't affect codec speed.
+  uint32 state = 0x12345678;
+  for (size_t i = 0; i < input.size(); ++i) {
+    state = state * 1664525 + 1013904223;
+    input[i] = static_cast<char>(state >> 24);
+  }
+  return input;
+}
+
+double ThroughputMBps(TimeDelta elapsed) {
+  return (static_cast<double>(kInputSize) * kIterations) /
+         (1024 * 1024 * elapsed.InSecondsF());
+}
+
+TEST(Base64Perftest, EncodeThroughput) {
+  std::string input = MakeTestInput();
+  std::string output;
+  TimeTicks start = TimeTicks::HighResNow();
+  for (int i = 0; i < kIterations; ++i)
+    Base64Encode(input, &output);
+  TimeDelta elapsed = TimeTicks::HighResNow() - start;
+  perf_test::PrintResult("base64_encode", "", "throughput",
+                         ThroughputMBps(elapsed), "MB/s", true);
+}
+
+TEST(Base64Perftest, HexEncodeThroughput) {
+  std::string input = MakeTestInput();
+  TimeTicks start = TimeTicks::HighResNow();
+  for (int i = 0; i < kIterations; ++i) {
+    std::string output = HexEncode(input.data(), input.size());
+    ASSERT_EQ(kInputSize * 2, output.size());
+  }
+  TimeDelta elapsed = TimeTicks::HighResNow() - start;
+  perf_test::PrintResult("hex_encode", "", "throughput",
+                         ThroughputMBps(elapsed), "MB/s", true);
+}
+
+}  // namespace
+}  // namespace base
@@ -24,4 +24,22 @@ TEST(Base64Test, Basic) {
   EXPECT_EQ(kText, decoded);
 }
 
+// Exercises the vectorized encode path, which only engages for inputs large
+// enough for whole SIMD blocks, and checks it agrees with decode for every
+// length (covering all block-boundary and padding cases).
+TEST(Base64Test, LargeInputRoundtrip) {
+  std::string input;
+  for (int i = 0; i < 1024; ++i)
+    input.push_back(static_cast<char>(i * 31 + 7));
+
+  for (size_t length = 64; length <= input.size(); length += 13) {
+    std::string encoded;
+    Base64Encode(std::string(input, 0, length), &encoded);
+
+    std::string decoded;
+    ASSERT_TRUE(Base64Decode(encoded, &decoded)) << "length " << length;
+    EXPECT_EQ(std::string(input, 0, length), decoded) << "length " << length;
+  }
+}
+
 }  // namespace base
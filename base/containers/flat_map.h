@@ -0,0 +1,160 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_CONTAINERS_FLAT_MAP_H_
+#define BASE_CONTAINERS_FLAT_MAP_H_
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace base {
+
+// An associative container backed by a sorted std::vector. Lookups are
+// O(log n) binary searches over contiguous memory, which is typically faster
+// and far more cache- and allocation-friendly than std::map's node-based
+// red-black tree. The trade-off is that insert() and erase() are O(n), so
+// FlatMap is best for maps that are small, built once and then queried, or
+// read-mostly.
+//
+// Unlike std::map, value_type is pair<Key, Mapped> rather than
+// pair<const Key, Mapped> (vector elements must be assignable), and any
+// mutating operation may invalidate all iterators.
+//
+// FlatMap implements enough of the std::map interface to be used as the
+// fall-back map type of a SmallMap, which makes the promoted representation
+// a single heap allocation:
+//
+//   base::SmallMap<base::FlatMap<std::string, int> > map;
+template <typename KeyType,
+          typename MappedType,
+          typename Compare = std::less<KeyType> >
+class FlatMap {
+ public:
+  typedef KeyType key_type;
+  typedef MappedType data_type;
+  typedef MappedType mapped_type;
+  typedef std::pair<KeyType, MappedType> value_type;
+  typedef Compare key_compare;
+
+ private:
+  typedef std::vector<value_type> Storage;
+
+ public:
+  typedef typename Storage::iterator iterator;
+  typedef typename Storage::const_iterator const_iterator;
+  typedef typename Storage::size_type size_type;
+
+  FlatMap() {}
+  explicit FlatMap(const Compare& comp) : comp_(comp) {}
+
+  // The default copy constructor, assignment operator and destructor are fine.
+
+  key_compare key_comp() const { return comp_; }
+
+  iterator begin() { return storage_.begin(); }
+  const_iterator begin() const { return storage_.begin(); }
+  iterator end() { return storage_.end(); }
+  const_iterator end() const { return storage_.end(); }
+
+  size_type size() const { return storage_.size(); }
+  bool empty() const { return storage_.empty(); }
+
+  void clear() { storage_.clear(); }
+
+  // Preallocates storage for |n| elements, like std::vector. Useful when the
+  // final size is known in advance to avoid repeated reallocation.
+  void reserve(size_type n) { storage_.reserve(n); }
+
+  void swap(FlatMap& other) {
+    storage_.swap(other.storage_);
+    std::swap(comp_, other.comp_);
+  }
+
+  // Returns an iterator to the first element whose key is not less than |key|.
+  iterator lower_bound(const key_type& key) {
+    return std::lower_bound(storage_.begin(), storage_.end(), key,
+                            KeyValueCompare(comp_));
+  }
+  const_iterator lower_bound(const key_type& key) const {
+    return std::lower_bound(storage_.begin(), storage_.end(), key,
+                            KeyValueCompare(comp_));
+  }
+
+  iterator find(const key_type& key) {
+    iterator iter = lower_bound(key);
+    if (iter != storage_.end() && !comp_(key, iter->first))
+      return iter;
+    return storage_.end();
+  }
+  const_iterator find(const key_type& key) const {
+    const_iterator iter = lower_bound(key);
+    if (iter != storage_.end() && !comp_(key, iter->first))
+      return iter;
+    return storage_.end();
+  }
+
+  size_type count(const key_type& key) const {
+    return (find(key) == end()) ? 0 : 1;
+  }
+
+  // Invalidates iterators.
+  mapped_type& operator[](const key_type& key) {
+    iterator iter = lower_bound(key);
+    if (iter != storage_.end() && !comp_(key, iter->first))
+      return iter->second;
+    return storage_.insert(iter, value_type(key, mapped_type()))->second;
+  }
+
+  // Invalidates iterators.
+  std::pair<iterator, bool> insert(const value_type& x) {
+    iterator iter = lower_bound(x.first);
+    if (iter != storage_.end() && !comp_(x.first, iter->first))
+      return std::make_pair(iter, false);
+    return std::make_pair(storage_.insert(iter, x), true);
+  }
+
+  // Invalidates iterators.
+  template <class InputIterator>
+  void insert(InputIterator f, InputIterator l) {
+    while (f != l) {
+      insert(*f);
+      ++f;
+    }
+  }
+
+  // Invalidates iterators.
+  iterator erase(iterator position) { return storage_.erase(position); }
+
+  // Invalidates iterators.
+  size_type erase(const key_type& key) {
+    iterator iter = find(key);
+    if (iter == end())
+      return 0u;
+    storage_.erase(iter);
+    return 1u;
+  }
+
+ private:
+  // Adapts the key comparator to the stored key/value pairs for the standard
+  // binary search algorithms.
+  class KeyValueCompare {
+   public:
+    explicit KeyValueCompare(const Compare& comp) : comp_(comp) {}
+    bool operator()(const value_type& element, const key_type& key) const {
+      return comp_(element.first, key);
+    }
+
+   private:
+    Compare comp_;
+  };
+
+  Storage storage_;
+  Compare comp_;
+};
+
+}  // namespace base
+
+#endif  // BASE_CONTAINERS_FLAT_MAP_H_
@@ -0,0 +1,114 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/containers/flat_map.h"
+
+#include <functional>
+#include <string>
+
+#include "base/containers/small_map.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+
+TEST(FlatMap, General) {
+  FlatMap<int, int> m;
+
+  EXPECT_TRUE(m.empty());
+  EXPECT_EQ(0u, m.size());
+  EXPECT_TRUE(m.find(0) == m.end());
+
+  m[3] = 9;
+  m[1] = 1;
+  m[2] = 4;
+
+  EXPECT_FALSE(m.empty());
+  EXPECT_EQ(3u, m.size());
+  EXPECT_EQ(9, m[3]);
+  EXPECT_EQ(1, m[1]);
+  EXPECT_EQ(4, m[2]);
+  EXPECT_EQ(1u, m.count(2));
+  EXPECT_EQ(0u, m.count(4));
+
+  // Iteration visits the elements in key order.
+  FlatMap<int, int>::const_iterator iter = m.begin();
+  ASSERT_TRUE(iter != m.end());
+  EXPECT_EQ(1, iter->first);
+  ++iter;
+  ASSERT_TRUE(iter != m.end());
+  EXPECT_EQ(2, iter->first);
+  ++iter;
+  ASSERT_TRUE(iter != m.end());
+  EXPECT_EQ(3, iter->first);
+  ++iter;
+  EXPECT_TRUE(iter == m.end());
+}
+
+TEST(FlatMap, Insert) {
+  FlatMap<std::string, int> m;
+
+  std::pair<FlatMap<std::string, int>::iterator, bool> ret =
+      m.insert(std::make_pair(std::string("monday"), 1));
+  EXPECT_TRUE(ret.second);
+  EXPECT_EQ(1, ret.first->second);
+
+  // Inserting a duplicate key leaves the existing element alone.
+  ret = m.insert(std::make_pair(std::string("monday"), 100));
+  EXPECT_FALSE(ret.second);
+  EXPECT_EQ(1, ret.first->second);
+  EXPECT_EQ(1u, m.size());
+}
+
+TEST(FlatMap, Erase) {
+  FlatMap<int, int> m;
+  for (int i = 0; i < 5; ++i)
+    m[i] = i * i;
+
+  EXPECT_EQ(1u, m.erase(3));
+  EXPECT_EQ(0u, m.erase(3));
+  EXPECT_EQ(4u, m.size());
+  EXPECT_TRUE(m.find(3) == m.end());
+
+  FlatMap<int, int>::iterator next = m.erase(m.find(1));
+  ASSERT_TRUE(next != m.end());
+  EXPECT_EQ(2, next->first);
+
+  m.clear();
+  EXPECT_TRUE(m.empty());
+}
+
+TEST(FlatMap, Comparator) {
+  FlatMap<int, int, std::greater<int> > m;
+  m[1] = 1;
+  m[3] = 9;
+  m[2] = 4;
+
+  // With std::greater the elements come out in descending key order.
+  FlatMap<int, int, std::greater<int> >::const_iterator iter = m.begin();
+  EXPECT_EQ(3, iter->first);
+  ++iter;
+  EXPECT_EQ(2, iter->first);
+  ++iter;
+  EXPECT_EQ(1, iter->first);
+
+  EXPECT_TRUE(m.find(2) != m.end());
+  EXPECT_TRUE(m.find(4) == m.end());
+}
+
+TEST(FlatMap, AsSmallMapFallback) {
+  SmallMap<FlatMap<int, int>, 4> m;
+
+  for (int i = 0; i < 10; ++i)
+    m[i] = i * 10;
+
+  EXPECT_TRUE(m.UsingFullMap());
+  EXPECT_EQ(10u, m.size());
+  for (int i = 0; i < 10; ++i) {
+    SmallMap<FlatMap<int, int>, 4>::iterator iter = m.find(i);
+    ASSERT_TRUE(iter != m.end());
+    EXPECT_EQ(i * 10, iter->second);
+  }
+}
+
+}  // namespace base
@@ -305,6 +305,175 @@ class HashingMRUCache : public MRUCacheBase<KeyType,
   DISALLOW_COPY_AND_ASSIGN(HashingMRUCache);
 };
 
+// SizedMRUCache ---------------------------------------------------------------
+
+// A cache that bounds the total declared memory footprint of its payloads
+// rather than the number of entries. Each Put() supplies the size of the
+// payload in bytes, and the cache evicts least-recently-used entries until the
+// running total fits under max_bytes(). The per-entry size is stored with the
+// index entry so no separate accounting structure is needed.
+//
+// A payload larger than max_bytes() is still inserted (after emptying the
+// cache); callers that want to reject such payloads should check the size
+// themselves first.
+template <class KeyType, class PayloadType>
+class SizedMRUCache {
+ public:
+  // The payload of the list. This maintains a copy of the key so we can
+  // efficiently delete things given an element of the list.
+  typedef std::pair<KeyType, PayloadType> value_type;
+
+ private:
+  typedef std::list<value_type> PayloadList;
+
+  // The index holds the recency-list iterator for a key along with the size
+  // the caller declared for the payload, so that eviction can subtract it.
+  struct IndexValue {
+    typename PayloadList::iterator list_iter;
+    size_t payload_size;
+  };
+  typedef std::map<KeyType, IndexValue> KeyIndex;
+
+ public:
+  typedef typename PayloadList::size_type size_type;
+
+  typedef typename PayloadList::iterator iterator;
+  typedef typename PayloadList::const_iterator const_iterator;
+  typedef typename PayloadList::reverse_iterator reverse_iterator;
+  typedef typename PayloadList::const_reverse_iterator const_reverse_iterator;
+
+  explicit SizedMRUCache(size_t max_bytes)
+      : max_bytes_(max_bytes), bytes_(0) {
+  }
+
+  ~SizedMRUCache() {
+  }
+
+  size_t max_bytes() const { return max_bytes_; }
+
+  // Returns the total declared size of all payloads currently in the cache.
+  size_t bytes() const { return bytes_; }
+
+  // Inserts a payload item with the given key and declared size in bytes. If
+  // an existing item has the same key, it is removed prior to insertion. Old
+  // entries are evicted until the total fits under max_bytes(). An iterator
+  // indicating the inserted item will be returned (this will always be the
+  // front of the list).
+  iterator Put(const KeyType& key,
+               const PayloadType& payload,
+               size_t payload_size) {
+    // Remove any existing payload with that key.
+    typename KeyIndex::iterator index_iter = index_.find(key);
+    if (index_iter != index_.end())
+      Erase(index_iter->second.list_iter);
+
+    // Kick the oldest things out until the new item fits.
+    while (!ordering_.empty() && bytes_ + payload_size > max_bytes_)
+      Erase(rbegin());
+
+    ordering_.push_front(value_type(key, payload));
+    IndexValue index_value;
+    index_value.list_iter = ordering_.begin();
+    index_value.payload_size = payload_size;
+    index_.insert(std::make_pair(key, index_value));
+    bytes_ += payload_size;
+    return ordering_.begin();
+  }
+
+  // Retrieves the contents of the given key, or end() if not found. This
+  // method has the side effect of moving the requested item to the front of
+  // the recency list.
+  iterator Get(const KeyType& key) {
+    typename KeyIndex::iterator index_iter = index_.find(key);
+    if (index_iter == index_.end())
+      return end();
+    typename PayloadList::iterator iter = index_iter->second.list_iter;
+
+    // Move the touched item to the front of the recency ordering.
+    ordering_.splice(ordering_.begin(), ordering_, iter);
+    return ordering_.begin();
+  }
+
+  // Retrieves the payload associated with a given key without affecting the
+  // ordering (unlike Get).
+  iterator Peek(const KeyType& key) {
+    typename KeyIndex::iterator index_iter = index_.find(key);
+    if (index_iter == index_.end())
+      return end();
+    return index_iter->second.list_iter;
+  }
+
+  const_iterator Peek(const KeyType& key) const {
+    typename KeyIndex::const_iterator index_iter = index_.find(key);
+    if (index_iter == index_.end())
+      return end();
+    return index_iter->second.list_iter;
+  }
+
+  // Erases the item referenced by the given iterator. An iterator to the item
+  // following it will be returned. The iterator must be valid.
+  iterator Erase(iterator pos) {
+    typename KeyIndex::iterator index_iter = index_.find(pos->first);
+    DCHECK(index_iter != index_.end());
+    DCHECK(bytes_ >= index_iter->second.payload_size);
+    bytes_ -= index_iter->second.payload_size;
+    index_.erase(index_iter);
+    return ordering_.erase(pos);
+  }
+
+  reverse_iterator Erase(reverse_iterator pos) {
+    // We have to actually give it the incremented iterator to delete, since
+    // the forward iterator that base() returns is actually one past the item
+    // being iterated over.
+    return reverse_iterator(Erase((++pos).base()));
+  }
+
+  // Evicts least-recently-used items until the total declared size is no
+  // bigger than |new_bytes|.
+  void ShrinkToBytes(size_t new_bytes) {
+    while (bytes_ > new_bytes)
+      Erase(rbegin());
+  }
+
+  // Deletes everything from the cache.
+  void Clear() {
+    index_.clear();
+    ordering_.clear();
+    bytes_ = 0;
+  }
+
+  // Returns the number of elements in the cache.
+  size_type size() const {
+    // We don't use ordering_.size() for the return value because
+    // (as a linked list) it can be O(n).
+    DCHECK(index_.size() == ordering_.size());
+    return index_.size();
+  }
+
+  // Allows iteration over the list. Forward iteration starts with the most
+  // recent item and works backwards.
+  iterator begin() { return ordering_.begin(); }
+  const_iterator begin() const { return ordering_.begin(); }
+  iterator end() { return ordering_.end(); }
+  const_iterator end() const { return ordering_.end(); }
+
+  reverse_iterator rbegin() { return ordering_.rbegin(); }
+  const_reverse_iterator rbegin() const { return ordering_.rbegin(); }
+  reverse_iterator rend() { return ordering_.rend(); }
+  const_reverse_iterator rend() const { return ordering_.rend(); }
+
+  bool empty() const { return ordering_.empty(); }
+
+ private:
+  PayloadList ordering_;
+  KeyIndex index_;
+
+  size_t max_bytes_;
+  size_t bytes_;
+
+  DISALLOW_COPY_AND_ASSIGN(SizedMRUCache);
+};
+
 }  // namespace base
 
 #endif  // BASE_CONTAINERS_MRU_CACHE_H_
@@ -252,6 +252,54 @@ TEST(MRUCacheTest, AutoEvict) {
   EXPECT_EQ(initial_count, cached_item_live_count);
 }
 
+TEST(MRUCacheTest, Sized) {
+  typedef base::SizedMRUCache<int, CachedItem> Cache;
+  Cache cache(100);
+
+  static const int kItem1Key = 1;
+  CachedItem item1(10);
+  cache.Put(kItem1Key, item1, 40);
+
+  static const int kItem2Key = 2;
+  CachedItem item2(20);
+  cache.Put(kItem2Key, item2, 40);
+
+  EXPECT_EQ(2U, cache.size());
+  EXPECT_EQ(80U, cache.bytes());
+
+  // A third item doesn't fit, so the oldest (item1) should be evicted.
+  static const int kItem3Key = 3;
+  CachedItem item3(30);
+  cache.Put(kItem3Key, item3, 40);
+
+  EXPECT_EQ(2U, cache.size());
+  EXPECT_EQ(80U, cache.bytes());
+  EXPECT_TRUE(cache.Get(kItem1Key) == cache.end());
+  EXPECT_TRUE(cache.Get(kItem2Key) != cache.end());
+
+  // Replacing an entry should swap out its old size for the new one.
+  cache.Put(kItem2Key, item2, 10);
+  EXPECT_EQ(2U, cache.size());
+  EXPECT_EQ(50U, cache.bytes());
+
+  // An oversized payload empties the cache but is still stored.
+  static const int kItem4Key = 4;
+  CachedItem item4(40);
+  cache.Put(kItem4Key, item4, 200);
+  EXPECT_EQ(1U, cache.size());
+  EXPECT_EQ(200U, cache.bytes());
+
+  // ShrinkToBytes should evict until under the given total.
+  cache.ShrinkToBytes(100);
+  EXPECT_EQ(0U, cache.size());
+  EXPECT_EQ(0U, cache.bytes());
+
+  cache.Put(kItem1Key, item1, 40);
+  cache.Clear();
+  EXPECT_EQ(0U, cache.size());
+  EXPECT_EQ(0U, cache.bytes());
+}
+
 TEST(MRUCacheTest, HashingMRUCache) {
   // Very simple test to make sure that the hashing cache works correctly.
   typedef base::HashingMRUCache<std::string, CachedItem> Cache;
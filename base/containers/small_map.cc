@@ -0,0 +1,31 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/containers/small_map.h"
+
+#include "base/atomicops.h"
+
+namespace base {
+namespace internal {
+
+namespace {
+
+// Number of SmallMaps in the process that have outgrown their inline array
+// and been promoted to the full map representation. A high count relative to
+// the number of SmallMaps created suggests that callers are picking
+// kArraySize too small and paying for both the linear scan and the map.
+subtle::Atomic32 g_promotion_count = 0;
+
+}  // namespace
+
+void RecordSmallMapPromotion() {
+  subtle::NoBarrier_AtomicIncrement(&g_promotion_count, 1);
+}
+
+int GetSmallMapPromotionCountForTesting() {
+  return subtle::NoBarrier_Load(&g_promotion_count);
+}
+
+}  // namespace internal
+}  // namespace base
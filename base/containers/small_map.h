@@ -9,6 +9,7 @@
 #include <string>
 #include <utility>
 
+#include "base/base_export.h"
 #include "base/basictypes.h"
 #include "base/containers/hash_tables.h"
 #include "base/logging.h"
@@ -99,6 +100,15 @@ namespace base {
 
 namespace internal {
 
+// Bumps a process-wide counter of SmallMaps that have outgrown their inline
+// array and fallen back to the full map representation. This is cheap enough
+// to record unconditionally and lets profiling spot SmallMaps whose
+// kArraySize was picked too small.
+BASE_EXPORT void RecordSmallMapPromotion();
+
+// Returns the current value of the promotion counter.
+BASE_EXPORT int GetSmallMapPromotionCountForTesting();
+
 template <typename NormalMap>
 class SmallMapDefaultInit {
  public:
@@ -589,6 +599,8 @@ class SmallMap {
   };
 
   void ConvertToRealMap() {
+    internal::RecordSmallMapPromotion();
+
     // Move the current elements into a temporary array.
     ManualConstructor<value_type> temp_array[kArraySize];
 
@@ -480,4 +480,25 @@ TEST(SmallMap, SubclassInitializationWithFunctionObject) {
   EXPECT_EQ(1u, m.count(-1));
 }
 
+TEST(SmallMap, PromotionTelemetry) {
+  int initial_count = internal::GetSmallMapPromotionCountForTesting();
+
+  SmallMap<std::map<int, int>, 2> m;
+  m[1] = 1;
+  m[2] = 2;
+  EXPECT_FALSE(m.UsingFullMap());
+  EXPECT_EQ(initial_count, internal::GetSmallMapPromotionCountForTesting());
+
+  // Exceeding the array size promotes to the full map and records it.
+  m[3] = 3;
+  EXPECT_TRUE(m.UsingFullMap());
+  EXPECT_EQ(initial_count + 1,
+            internal::GetSmallMapPromotionCountForTesting());
+
+  // Further growth of an already-promoted map is not recorded again.
+  m[4] = 4;
+  EXPECT_EQ(initial_count + 1,
+            internal::GetSmallMapPromotionCountForTesting());
+}
+
 }  // namespace base
@@ -0,0 +1,71 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/debug/heap_accounting.h"
+
+#include "base/lazy_instance.h"
+#include "base/synchronization/lock.h"
+
+namespace base {
+namespace debug {
+
+namespace {
+
+// Guards the registry list heads below.
+LazyInstance<Lock>::Leaky g_registry_lock = LAZY_INSTANCE_INITIALIZER;
+
+HeapAccount* g_first_account = NULL;
+HeapAccount* g_last_account = NULL;
+
+}  // namespace
+
+HeapAccount::HeapAccount(const char* name)
+    : name_(name), next_(NULL), prev_(NULL) {
+  AutoLock lock(g_registry_lock.Get());
+  prev_ = g_last_account;
+  if (g_last_account)
+    g_last_account->next_ = this;
+  else
+    g_first_account = this;
+  g_last_account = this;
+}
+
+HeapAccount::~HeapAccount() {
+  AutoLock lock(g_registry_lock.Get());
+  if (prev_)
+    prev_->next_ = next_;
+  else
+    g_first_account = next_;
+  if (next_)
+    next_->prev_ = prev_;
+  else
+    g_last_account = prev_;
+}
+
+void HeapAccount::RecordAlloc(size_t bytes) {
+  live_bytes_.Add(static_cast<int32>(bytes));
+  alloc_count_.Increment();
+}
+
+void HeapAccount::RecordFree(size_t bytes) {
+  live_bytes_.Add(-static_cast<int32>(bytes));
+  free_count_.Increment();
+}
+
+// static
+void HeapAccount::GetSnapshot(std::vector<Snapshot>* snapshots) {
+  AutoLock lock(g_registry_lock.Get());
+  for (HeapAccount* account = g_first_account; account;
+       account = account->next_) {
+    Snapshot snapshot;
+    snapshot.name = account->name_;
+    snapshot.live_bytes = account->live_bytes_.Get();
+    snapshot.alloc_count = account->alloc_count_.Get();
+    snapshot.free_count = account->free_count_.Get();
+    snapshots->push_back(snapshot);
+  }
+}
+
+}  // namespace debug
+}  // namespace base
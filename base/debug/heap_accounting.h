@@ -0,0 +1,75 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_DEBUG_HEAP_ACCOUNTING_H_
+#define BASE_DEBUG_HEAP_ACCOUNTING_H_
+
+#include <vector>
+
+#include "base/base_export.h"
+#include "base/basictypes.h"
+#include "base/metrics/sharded_counter.h"
+
+namespace base {
+namespace debug {
+
+// HeapAccount tallies the heap usage of one subsystem ("cc", "net", "skia",
+// ...) for always-on accounting. Subsystems that own their allocation paths
+// call RecordAlloc()/RecordFree() with the sizes they allocate and release;
+// the account keeps live byte and operation counts in sharded counters, so
+// recording is cheap enough for hot paths and safe from any thread.
+//
+// This complements the tcmalloc-based heap profiler (see
+// base/debug/trace_event_memory.h): that attributes allocations to stacks but
+// only while tracing is on and only with a tcmalloc build; HeapAccount is
+// allocator-independent and always available, at subsystem rather than
+// call-site granularity.
+//
+// Accounts are expected to be long-lived, typically function-local statics:
+//
+//   static base::debug::HeapAccount* account =
+//       new base::debug::HeapAccount("net");
+//   account->RecordAlloc(bytes);
+class BASE_EXPORT HeapAccount {
+ public:
+  struct Snapshot {
+    const char* name;
+    int64 live_bytes;
+    int64 alloc_count;
+    int64 free_count;
+  };
+
+  // |name| must be a static string; it is kept by pointer, not copied.
+  explicit HeapAccount(const char* name);
+  ~HeapAccount();
+
+  void RecordAlloc(size_t bytes);
+  void RecordFree(size_t bytes);
+
+  const char* name() const { return name_; }
+  int64 GetLiveBytes() const { return live_bytes_.Get(); }
+
+  // Appends a snapshot of every registered account to |snapshots|, in
+  // registration order.
+  static void GetSnapshot(std::vector<Snapshot>* snapshots);
+
+ private:
+  const char* const name_;
+
+  ShardedCounter live_bytes_;
+  ShardedCounter alloc_count_;
+  ShardedCounter free_count_;
+
+  // Links in the global registry, maintained under a lock. Registration
+  // happens once per account; recording never takes the lock.
+  HeapAccount* next_;
+  HeapAccount* prev_;
+
+  DISALLOW_COPY_AND_ASSIGN(HeapAccount);
+};
+
+}  // namespace debug
+}  // namespace base
+
+#endif  // BASE_DEBUG_HEAP_ACCOUNTING_H_
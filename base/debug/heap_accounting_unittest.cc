@@ -0,0 +1,45 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/debug/heap_accounting.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+namespace debug {
+
+TEST(HeapAccountingTest, RecordAndSnapshot) {
+  HeapAccount account("test");
+  account.RecordAlloc(100);
+  account.RecordAlloc(50);
+  account.RecordFree(30);
+  EXPECT_EQ(120, account.GetLiveBytes());
+
+  std::vector<HeapAccount::Snapshot> snapshots;
+  HeapAccount::GetSnapshot(&snapshots);
+  ASSERT_EQ(1u, snapshots.size());
+  EXPECT_STREQ("test", snapshots[0].name);
+  EXPECT_EQ(120, snapshots[0].live_bytes);
+  EXPECT_EQ(2, snapshots[0].alloc_count);
+  EXPECT_EQ(1, snapshots[0].free_count);
+}
+
+TEST(HeapAccountingTest, RegistrationOrderAndUnregistration) {
+  HeapAccount first("first");
+  std::vector<HeapAccount::Snapshot> snapshots;
+  {
+    HeapAccount second("second");
+    HeapAccount::GetSnapshot(&snapshots);
+    ASSERT_EQ(2u, snapshots.size());
+    EXPECT_STREQ("first", snapshots[0].name);
+    EXPECT_STREQ("second", snapshots[1].name);
+  }
+  snapshots.clear();
+  HeapAccount::GetSnapshot(&snapshots);
+  ASSERT_EQ(1u, snapshots.size());
+  EXPECT_STREQ("first", snapshots[0].name);
+}
+
+}  // namespace debug
+}  // namespace base
@@ -984,11 +984,18 @@ class TraceLog::ThreadLocalEventBuffer
                       const TimeTicks& event_thread_timestamp);
 
   TraceEvent* GetEventByHandle(TraceEventHandle handle) {
-    if (!chunk_ || handle.chunk_seq != chunk_->seq() ||
-        handle.chunk_index != chunk_index_)
-      return NULL;
-
-    return chunk_->GetEventAt(handle.event_index);
+    if (chunk_ && handle.chunk_seq == chunk_->seq() &&
+        handle.chunk_index == chunk_index_)
+      return chunk_->GetEventAt(handle.event_index);
+
+    // The chunk may have filled up and be parked in the local completed
+    // ring awaiting the next batched handoff.
+    for (size_t i = 0; i < completed_chunks_.size(); ++i) {
+      if (handle.chunk_seq == completed_chunks_[i]->seq() &&
+          handle.chunk_index == completed_chunk_indices_[i])
+        return completed_chunks_[i]->GetEventAt(handle.event_index);
+    }
+    return NULL;
   }
 
   int generation() const { return generation_; }
@@ -999,15 +1006,32 @@ class TraceLog::ThreadLocalEventBuffer
 
   void FlushWhileLocked();
 
+  // Hands all locally held chunks (completed, current and unused free ones)
+  // back to the main buffer and refills the local free-chunk ring. Called
+  // with trace_log_->lock_ held, at most once per kLocalChunkBatch full
+  // chunks, so the common AddTraceEvent() path never touches the lock.
+  void ExchangeChunksWhileLocked();
+
   void CheckThisIsCurrentBuffer() const {
     DCHECK(trace_log_->thread_local_event_buffer_.Get() == this);
   }
 
+  // Number of chunks this thread keeps to itself between lock acquisitions.
+  // At 64 events per chunk this amortizes the global lock over 256 events.
+  static const size_t kLocalChunkBatch = 4;
+
   // Since TraceLog is a leaky singleton, trace_log_ will always be valid
   // as long as the thread exists.
   TraceLog* trace_log_;
   scoped_ptr<TraceBufferChunk> chunk_;
   size_t chunk_index_;
+  // Per-thread ring of chunks: full chunks wait here for the next batched
+  // handoff instead of being returned to the main buffer one at a time.
+  ScopedVector<TraceBufferChunk> completed_chunks_;
+  std::vector<size_t> completed_chunk_indices_;
+  // Empty chunks pre-acquired from the main buffer during the last exchange.
+  ScopedVector<TraceBufferChunk> free_chunks_;
+  std::vector<size_t> free_chunk_indices_;
   int event_count_;
   TimeDelta overhead_;
   int generation_;
@@ -1057,13 +1081,26 @@ TraceEvent* TraceLog::ThreadLocalEventBuffer::AddTraceEvent(
   CheckThisIsCurrentBuffer();
 
   if (chunk_ && chunk_->IsFull()) {
-    AutoLock lock(trace_log_->lock_);
-    FlushWhileLocked();
-    chunk_.reset();
+    // Park the full chunk locally; it is handed to the main buffer in the
+    // next batched exchange or on flush, not here, so no lock is needed.
+    completed_chunks_.push_back(chunk_.release());
+    completed_chunk_indices_.push_back(chunk_index_);
+  }
+  if (!chunk_ && !free_chunks_.empty()) {
+    chunk_.reset(free_chunks_.back());
+    free_chunks_.weak_erase(free_chunks_.end() - 1);
+    chunk_index_ = free_chunk_indices_.back();
+    free_chunk_indices_.pop_back();
   }
   if (!chunk_) {
     AutoLock lock(trace_log_->lock_);
-    chunk_ = trace_log_->logged_events_->GetChunk(&chunk_index_);
+    ExchangeChunksWhileLocked();
+    if (!free_chunks_.empty()) {
+      chunk_.reset(free_chunks_.back());
+      free_chunks_.weak_erase(free_chunks_.end() - 1);
+      chunk_index_ = free_chunk_indices_.back();
+      free_chunk_indices_.pop_back();
+    }
     trace_log_->CheckIfBufferIsFullWhileLocked();
   }
   if (!chunk_)
@@ -1109,16 +1146,49 @@ void TraceLog::ThreadLocalEventBuffer::WillDestroyCurrentMessageLoop() {
 }
 
 void TraceLog::ThreadLocalEventBuffer::FlushWhileLocked() {
-  if (!chunk_)
-    return;
-
   trace_log_->lock_.AssertAcquired();
   if (trace_log_->CheckGeneration(generation_)) {
-    // Return the chunk to the buffer only if the generation matches.
-    trace_log_->logged_events_->ReturnChunk(chunk_index_, chunk_.Pass());
+    // Return the chunks to the buffer only if the generation matches. The
+    // completed ring drains oldest-first so events keep their rough order,
+    // then the in-progress chunk, then the unused free chunks (which simply
+    // become recyclable again).
+    for (size_t i = 0; i < completed_chunks_.size(); ++i) {
+      trace_log_->logged_events_->ReturnChunk(
+          completed_chunk_indices_[i],
+          make_scoped_ptr(completed_chunks_[i]));
+    }
+    if (chunk_)
+      trace_log_->logged_events_->ReturnChunk(chunk_index_, chunk_.Pass());
+    for (size_t i = 0; i < free_chunks_.size(); ++i) {
+      trace_log_->logged_events_->ReturnChunk(
+          free_chunk_indices_[i], make_scoped_ptr(free_chunks_[i]));
+    }
   }
   // Otherwise this method may be called from the destructor, or TraceLog will
   // find the generation mismatch and delete this buffer soon.
+  completed_chunks_.weak_clear();
+  completed_chunk_indices_.clear();
+  free_chunks_.weak_clear();
+  free_chunk_indices_.clear();
+  chunk_.reset();
+}
+
+void TraceLog::ThreadLocalEventBuffer::ExchangeChunksWhileLocked() {
+  trace_log_->lock_.AssertAcquired();
+  // Hand everything back first so the buffer can recycle the completed
+  // chunks, then pull a fresh batch for the local free ring.
+  FlushWhileLocked();
+  if (!trace_log_->CheckGeneration(generation_))
+    return;
+  for (size_t i = 0; i < kLocalChunkBatch; ++i) {
+    size_t index;
+    scoped_ptr<TraceBufferChunk> chunk =
+        trace_log_->logged_events_->GetChunk(&index);
+    if (!chunk)
+      break;  // Buffer is full (record-until-full mode).
+    free_chunks_.push_back(chunk.release());
+    free_chunk_indices_.push_back(index);
+  }
 }
 
 // static
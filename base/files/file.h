@@ -241,6 +241,15 @@ class BASE_EXPORT File {
   // platforms. Returns the number of bytes written, or -1 on error.
   int WriteAtCurrentPosNoBestEffort(const char* data, int size);
 
+  // Asks the OS to start reading the given byte range into the page cache in
+  // the background and returns without waiting for the data. A subsequent
+  // Read() of that range will then usually not block on the disk. This is a
+  // hint: it may do nothing, and it says nothing about whether the eventual
+  // read succeeds. Returns true if the request was issued. Currently only
+  // implemented on Linux (posix_fadvise with POSIX_FADV_WILLNEED); elsewhere
+  // it returns false.
+  bool Prefetch(int64 offset, int64 length);
+
   // Returns the current size of this file, or a negative number on failure.
   int64 GetLength();
 
@@ -398,6 +398,19 @@ int File::WriteAtCurrentPosNoBestEffort(const char* data, int size) {
   return HANDLE_EINTR(write(file_.get(), data, size));
 }
 
+bool File::Prefetch(int64 offset, int64 length) {
+  DCHECK(IsValid());
+  // No AssertIOAllowed(): this only queues readahead in the kernel and does
+  // not wait for the data, which is exactly why IO-restricted threads want to
+  // call it.
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+  return posix_fadvise(file_.get(), static_cast<off_t>(offset),
+                       static_cast<off_t>(length), POSIX_FADV_WILLNEED) == 0;
+#else
+  return false;
+#endif
+}
+
 int64 File::GetLength() {
   DCHECK(IsValid());
 
@@ -217,6 +217,11 @@ int File::WriteAtCurrentPosNoBestEffort(const char* data, int size) {
   return WriteAtCurrentPos(data, size);
 }
 
+bool File::Prefetch(int64 offset, int64 length) {
+  // There is no cheap readahead request on Windows.
+  return false;
+}
+
 int64 File::GetLength() {
   base::ThreadRestrictions::AssertIOAllowed();
   DCHECK(IsValid());
@@ -47,6 +47,14 @@ class BASE_EXPORT MemoryMappedFile {
   // Is file_ a valid file handle that points to an open, memory mapped file?
   bool IsValid() const;
 
+  // Hints to the OS that the mapped pages will be needed soon, so that it can
+  // start reading them from disk before the first access faults them in. On
+  // POSIX this issues madvise(MADV_WILLNEED), which schedules asynchronous
+  // readahead and returns immediately. On Windows there is no equivalent
+  // non-blocking API before Win8's PrefetchVirtualMemory(), so this is a
+  // no-op. Does nothing if no file is mapped; failures are benign.
+  void Prefetch();
+
  private:
   // Map the file to memory, set data_ to that memory address. Return true on
   // success, false on any kind of failure. This is a helper for Initialize().
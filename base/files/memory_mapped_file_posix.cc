@@ -34,6 +34,16 @@ bool MemoryMappedFile::MapFileToMemory() {
   return data_ != MAP_FAILED;
 }
 
+void MemoryMappedFile::Prefetch() {
+  if (data_ == NULL)
+    return;
+
+  // Kick off asynchronous readahead of the whole mapping. If this fails the
+  // pages will simply fault in on demand as before.
+  if (madvise(data_, length_, MADV_WILLNEED) == -1)
+    DPLOG(WARNING) << "madvise";
+}
+
 void MemoryMappedFile::CloseHandles() {
   ThreadRestrictions::AssertIOAllowed();
 
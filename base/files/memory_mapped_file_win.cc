@@ -41,6 +41,12 @@ bool MemoryMappedFile::MapFileToMemory() {
   return data_ != NULL;
 }
 
+void MemoryMappedFile::Prefetch() {
+  // Windows has no asynchronous prefetch hint for mapped files before Win8's
+  // PrefetchVirtualMemory(); touching the pages here would block the caller
+  // on disk I/O, so do nothing.
+}
+
 void MemoryMappedFile::CloseHandles() {
   if (data_)
     ::UnmapViewOfFile(data_);
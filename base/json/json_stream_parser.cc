@@ -0,0 +1,315 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/json/json_stream_parser.h"
+
+#include <cstdlib>
+
+#include "base/logging.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/utf_string_conversion_utils.h"
+#include "base/third_party/icu/icu_utf.h"
+
+namespace base {
+
+namespace {
+
+const int kStackMaxDepth = 100;
+
+bool IsJSONWhitespace(char c) {
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+}  // namespace
+
+JSONStreamParser::JSONStreamParser(JSONStreamParserHandler* handler)
+    : handler_(handler),
+      start_(NULL),
+      pos_(NULL),
+      end_(NULL),
+      error_(JSON_NO_ERROR),
+      error_offset_(0) {
+  DCHECK(handler);
+}
+
+JSONStreamParser::~JSONStreamParser() {
+}
+
+JSONStreamParser::ParseError JSONStreamParser::Parse(const StringPiece& input) {
+  start_ = pos_ = input.data();
+  end_ = input.data() + input.length();
+  error_ = JSON_NO_ERROR;
+  error_offset_ = 0;
+
+  // Skip over a UTF-8 BOM, mirroring JSONReader.
+  if (end_ - pos_ >= 3 && pos_[0] == '\xEF' && pos_[1] == '\xBB' &&
+      pos_[2] == '\xBF') {
+    pos_ += 3;
+  }
+
+  SkipWhitespace();
+  if (!ParseValue(0))
+    return error_;
+  SkipWhitespace();
+  if (pos_ != end_) {
+    ReportError(JSON_TRAILING_DATA);
+    return error_;
+  }
+  return JSON_NO_ERROR;
+}
+
+bool JSONStreamParser::ParseValue(int depth) {
+  if (depth > kStackMaxDepth)
+    return ReportError(JSON_TOO_MUCH_NESTING);
+  if (pos_ == end_)
+    return ReportError(JSON_SYNTAX_ERROR);
+
+  switch (*pos_) {
+    case '{':
+      return ParseDictionary(depth);
+    case '[':
+      return ParseList(depth);
+    case '"': {
+      StringPiece value;
+      return ParseString(&value) && (handler_->HandleString(value) ||
+                                     ReportError(JSON_PARSE_CANCELLED));
+    }
+    case 't':
+      return ParseToken("true", 4) &&
+             (handler_->HandleBool(true) || ReportError(JSON_PARSE_CANCELLED));
+    case 'f':
+      return ParseToken("false", 5) &&
+             (handler_->HandleBool(false) || ReportError(JSON_PARSE_CANCELLED));
+    case 'n':
+      return ParseToken("null", 4) &&
+             (handler_->HandleNull() || ReportError(JSON_PARSE_CANCELLED));
+    default:
+      if (*pos_ == '-' || (*pos_ >= '0' && *pos_ <= '9'))
+        return ParseNumber();
+      return ReportError(JSON_UNEXPECTED_TOKEN);
+  }
+}
+
+bool JSONStreamParser::ParseDictionary(int depth) {
+  DCHECK_EQ('{', *pos_);
+  ++pos_;
+  if (!handler_->HandleDictionaryBegin())
+    return ReportError(JSON_PARSE_CANCELLED);
+
+  SkipWhitespace();
+  bool first = true;
+  while (pos_ != end_ && *pos_ != '}') {
+    if (!first) {
+      if (*pos_ != ',')
+        return ReportError(JSON_SYNTAX_ERROR);
+      ++pos_;
+      SkipWhitespace();
+    }
+    first = false;
+
+    if (pos_ == end_ || *pos_ != '"')
+      return ReportError(JSON_UNEXPECTED_TOKEN);
+    StringPiece key;
+    if (!ParseString(&key))
+      return false;
+    if (!handler_->HandleKey(key))
+      return ReportError(JSON_PARSE_CANCELLED);
+
+    SkipWhitespace();
+    if (pos_ == end_ || *pos_ != ':')
+      return ReportError(JSON_SYNTAX_ERROR);
+    ++pos_;
+    SkipWhitespace();
+
+    if (!ParseValue(depth + 1))
+      return false;
+    SkipWhitespace();
+  }
+  if (pos_ == end_)
+    return ReportError(JSON_SYNTAX_ERROR);
+  ++pos_;  // Consume '}'.
+  if (!handler_->HandleDictionaryEnd())
+    return ReportError(JSON_PARSE_CANCELLED);
+  return true;
+}
+
+bool JSONStreamParser::ParseList(int depth) {
+  DCHECK_EQ('[', *pos_);
+  ++pos_;
+  if (!handler_->HandleListBegin())
+    return ReportError(JSON_PARSE_CANCELLED);
+
+  SkipWhitespace();
+  bool first = true;
+  while (pos_ != end_ && *pos_ != ']') {
+    if (!first) {
+      if (*pos_ != ',')
+        return ReportError(JSON_SYNTAX_ERROR);
+      ++pos_;
+      SkipWhitespace();
+    }
+    first = false;
+
+    if (!ParseValue(depth + 1))
+      return false;
+    SkipWhitespace();
+  }
+  if (pos_ == end_)
+    return ReportError(JSON_SYNTAX_ERROR);
+  ++pos_;  // Consume ']'.
+  if (!handler_->HandleListEnd())
+    return ReportError(JSON_PARSE_CANCELLED);
+  return true;
+}
+
+bool JSONStreamParser::ParseString(StringPiece* out) {
+  DCHECK_EQ('"', *pos_);
+  ++pos_;
+  const char* literal_start = pos_;
+
+  // Fast path: scan for the closing quote. If no backslash is seen the
+  // result aliases the input buffer and nothing is copied.
+  while (pos_ != end_ && *pos_ != '"' && *pos_ != '\\') {
+    if (static_cast<unsigned char>(*pos_) < 0x20)
+      return ReportError(JSON_SYNTAX_ERROR);
+    ++pos_;
+  }
+  if (pos_ == end_)
+    return ReportError(JSON_SYNTAX_ERROR);
+  if (*pos_ == '"') {
+    *out = StringPiece(literal_start, pos_ - literal_start);
+    ++pos_;
+    return true;
+  }
+
+  // Slow path: the string contains escapes; unescape into the scratch
+  // buffer. The returned piece is valid until the next string is parsed.
+  unescape_buffer_.assign(literal_start, pos_ - literal_start);
+  while (pos_ != end_ && *pos_ != '"') {
+    if (*pos_ != '\\') {
+      if (static_cast<unsigned char>(*pos_) < 0x20)
+        return ReportError(JSON_SYNTAX_ERROR);
+      unescape_buffer_.push_back(*pos_++);
+      continue;
+    }
+    ++pos_;
+    if (pos_ == end_)
+      return ReportError(JSON_SYNTAX_ERROR);
+    switch (*pos_) {
+      case '"': unescape_buffer_.push_back('"'); break;
+      case '\\': unescape_buffer_.push_back('\\'); break;
+      case '/': unescape_buffer_.push_back('/'); break;
+      case 'b': unescape_buffer_.push_back('\b'); break;
+      case 'f': unescape_buffer_.push_back('\f'); break;
+      case 'n': unescape_buffer_.push_back('\n'); break;
+      case 'r': unescape_buffer_.push_back('\r'); break;
+      case 't': unescape_buffer_.push_back('\t'); break;
+      case 'u': {
+        if (end_ - pos_ < 5)
+          return ReportError(JSON_SYNTAX_ERROR);
+        int code_unit;
+        if (!HexStringToInt(StringPiece(pos_ + 1, 4), &code_unit))
+          return ReportError(JSON_SYNTAX_ERROR);
+        pos_ += 4;
+        uint32 code_point = static_cast<uint32>(code_unit);
+        if (CBU16_IS_LEAD(code_unit)) {
+          // Expect a trailing surrogate; decode the pair.
+          if (end_ - pos_ < 7 || pos_[1] != '\\' || pos_[2] != 'u')
+            return ReportError(JSON_SYNTAX_ERROR);
+          int trail;
+          if (!HexStringToInt(StringPiece(pos_ + 3, 4), &trail) ||
+              !CBU16_IS_TRAIL(trail))
+            return ReportError(JSON_SYNTAX_ERROR);
+          code_point = CBU16_GET_SUPPLEMENTARY(code_unit, trail);
+          pos_ += 6;
+        } else if (CBU16_IS_TRAIL(code_unit)) {
+          return ReportError(JSON_SYNTAX_ERROR);
+        }
+        if (!IsValidCharacter(code_point))
+          return ReportError(JSON_UNSUPPORTED_ENCODING);
+        WriteUnicodeCharacter(code_point, &unescape_buffer_);
+        break;
+      }
+      default:
+        return ReportError(JSON_SYNTAX_ERROR);
+    }
+    ++pos_;
+  }
+  if (pos_ == end_)
+    return ReportError(JSON_SYNTAX_ERROR);
+  ++pos_;  // Consume closing '"'.
+  *out = StringPiece(unescape_buffer_);
+  return true;
+}
+
+bool JSONStreamParser::ParseNumber(void) {
+  const char* number_start = pos_;
+  bool is_double = false;
+
+  if (pos_ != end_ && *pos_ == '-')
+    ++pos_;
+  if (pos_ == end_ || *pos_ < '0' || *pos_ > '9')
+    return ReportError(JSON_SYNTAX_ERROR);
+  while (pos_ != end_ && *pos_ >= '0' && *pos_ <= '9')
+    ++pos_;
+  if (pos_ != end_ && *pos_ == '.') {
+    is_double = true;
+    ++pos_;
+    if (pos_ == end_ || *pos_ < '0' || *pos_ > '9')
+      return ReportError(JSON_SYNTAX_ERROR);
+    while (pos_ != end_ && *pos_ >= '0' && *pos_ <= '9')
+      ++pos_;
+  }
+  if (pos_ != end_ && (*pos_ == 'e' || *pos_ == 'E')) {
+    is_double = true;
+    ++pos_;
+    if (pos_ != end_ && (*pos_ == '+' || *pos_ == '-'))
+      ++pos_;
+    if (pos_ == end_ || *pos_ < '0' || *pos_ > '9')
+      return ReportError(JSON_SYNTAX_ERROR);
+    while (pos_ != end_ && *pos_ >= '0' && *pos_ <= '9')
+      ++pos_;
+  }
+
+  StringPiece number(number_start, pos_ - number_start);
+  if (!is_double) {
+    int int_value;
+    if (StringToInt(number, &int_value)) {
+      if (!handler_->HandleInt(int_value))
+        return ReportError(JSON_PARSE_CANCELLED);
+      return true;
+    }
+    // Too large for an int; degrade to double like JSONReader does.
+  }
+  double double_value;
+  if (!StringToDouble(number.as_string(), &double_value))
+    return ReportError(JSON_SYNTAX_ERROR);
+  if (!handler_->HandleDouble(double_value))
+    return ReportError(JSON_PARSE_CANCELLED);
+  return true;
+}
+
+bool JSONStreamParser::ParseToken(const char* token, size_t length) {
+  if (static_cast<size_t>(end_ - pos_) < length ||
+      StringPiece(pos_, length) != StringPiece(token, length))
+    return ReportError(JSON_UNEXPECTED_TOKEN);
+  pos_ += length;
+  return true;
+}
+
+void JSONStreamParser::SkipWhitespace() {
+  while (pos_ != end_ && IsJSONWhitespace(*pos_))
+    ++pos_;
+}
+
+bool JSONStreamParser::ReportError(ParseError error) {
+  // Keep the first error; helpers may unwind through several frames.
+  if (error_ == JSON_NO_ERROR) {
+    error_ = error;
+    error_offset_ = pos_ - start_;
+  }
+  return false;
+}
+
+}  // namespace base
@@ -0,0 +1,110 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// A streaming, SAX-style JSON parser. Unlike JSONReader it does not build a
+// base::Value tree; instead it invokes a handler for every token it
+// encounters. This avoids the per-node heap allocations of the Value
+// hierarchy, which dominate parse time for multi-megabyte inputs such as
+// policy blobs and extension message catalogs.
+//
+// Keys and string values are reported as StringPieces. Whenever a string
+// contains no escape sequences the piece aliases the input buffer directly
+// (zero copy); otherwise it points into a scratch buffer owned by the parser.
+// Either way the piece is only valid for the duration of the callback, so
+// handlers must copy anything they need to keep.
+//
+// Limitations match JSONReader: ints are parsed within a signed 32 bit
+// range (larger magnitudes degrade to double), input must be UTF-8, and
+// nesting is capped at 100 levels.
+
+#ifndef BASE_JSON_JSON_STREAM_PARSER_H_
+#define BASE_JSON_JSON_STREAM_PARSER_H_
+
+#include <string>
+
+#include "base/base_export.h"
+#include "base/basictypes.h"
+#include "base/strings/string_piece.h"
+
+namespace base {
+
+// Implemented by consumers of JSONStreamParser. Each method may return false
+// to abort the parse; JSONStreamParser::Parse() then fails with
+// JSON_PARSE_CANCELLED.
+class BASE_EXPORT JSONStreamParserHandler {
+ public:
+  virtual bool HandleDictionaryBegin() = 0;
+  virtual bool HandleDictionaryEnd() = 0;
+  virtual bool HandleListBegin() = 0;
+  virtual bool HandleListEnd() = 0;
+
+  // Called for a dictionary key, before the callback for its value.
+  virtual bool HandleKey(const StringPiece& key) = 0;
+
+  virtual bool HandleNull() = 0;
+  virtual bool HandleBool(bool value) = 0;
+  virtual bool HandleInt(int value) = 0;
+  virtual bool HandleDouble(double value) = 0;
+  virtual bool HandleString(const StringPiece& value) = 0;
+
+ protected:
+  virtual ~JSONStreamParserHandler() {}
+};
+
+class BASE_EXPORT JSONStreamParser {
+ public:
+  enum ParseError {
+    JSON_NO_ERROR = 0,
+    JSON_SYNTAX_ERROR,
+    JSON_UNEXPECTED_TOKEN,
+    JSON_TRAILING_DATA,
+    JSON_TOO_MUCH_NESTING,
+    JSON_UNSUPPORTED_ENCODING,
+    JSON_PARSE_CANCELLED,
+  };
+
+  explicit JSONStreamParser(JSONStreamParserHandler* handler);
+  ~JSONStreamParser();
+
+  // Parses |input|, invoking the handler for each token. |input| must stay
+  // alive and unmodified for the duration of the call (pieces handed to the
+  // handler alias it). Returns JSON_NO_ERROR on success.
+  ParseError Parse(const StringPiece& input);
+
+  // Byte offset into the input at which the last Parse() failed, 0 on
+  // success. Useful for error messages.
+  size_t error_offset() const { return error_offset_; }
+
+ private:
+  // All Parse* helpers consume input starting at |pos_| and return false on
+  // error after recording |error_| and |error_offset_|.
+  bool ParseValue(int depth);
+  bool ParseDictionary(int depth);
+  bool ParseList(int depth);
+  bool ParseString(StringPiece* out);
+  bool ParseNumber();
+  bool ParseToken(const char* token, size_t length);
+
+  void SkipWhitespace();
+  bool ReportError(ParseError error);
+
+  JSONStreamParserHandler* const handler_;
+
+  const char* start_;
+  const char* pos_;
+  const char* end_;
+
+  // Backing store for strings that required unescaping; reused across
+  // strings to avoid reallocation.
+  std::string unescape_buffer_;
+
+  ParseError error_;
+  size_t error_offset_;
+
+  DISALLOW_COPY_AND_ASSIGN(JSONStreamParser);
+};
+
+}  // namespace base
+
+#endif  // BASE_JSON_JSON_STREAM_PARSER_H_
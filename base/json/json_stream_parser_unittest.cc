@@ -0,0 +1,134 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/json/json_stream_parser.h"
+
+#include <string>
+#include <vector>
+
+#include "base/strings/stringprintf.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+
+namespace {
+
+// Records each callback as a printable token so tests can assert on the
+// whole event stream with one string comparison.
+class RecordingHandler : public JSONStreamParserHandler {
+ public:
+  RecordingHandler() : fail_after_(-1) {}
+
+  // Makes the handler return false (cancelling the parse) after |n| events.
+  void set_fail_after(int n) { fail_after_ = n; }
+
+  std::string events() const { return events_; }
+
+  virtual bool HandleDictionaryBegin() OVERRIDE { return Record("{"); }
+  virtual bool HandleDictionaryEnd() OVERRIDE { return Record("}"); }
+  virtual bool HandleListBegin() OVERRIDE { return Record("["); }
+  virtual bool HandleListEnd() OVERRIDE { return Record("]"); }
+  virtual bool HandleKey(const StringPiece& key) OVERRIDE {
+    return Record("key:" + key.as_string());
+  }
+  virtual bool HandleNull() OVERRIDE { return Record("null"); }
+  virtual bool HandleBool(bool value) OVERRIDE {
+    return Record(value ? "true" : "false");
+  }
+  virtual bool HandleInt(int value) OVERRIDE {
+    return Record(StringPrintf("int:%d", value));
+  }
+  virtual bool HandleDouble(double value) OVERRIDE {
+    return Record(StringPrintf("double:%g", value));
+  }
+  virtual bool HandleString(const StringPiece& value) OVERRIDE {
+    return Record("str:" + value.as_string());
+  }
+
+ private:
+  bool Record(const std::string& event) {
+    if (fail_after_ == 0)
+      return false;
+    if (fail_after_ > 0)
+      --fail_after_;
+    if (!events_.empty())
+      events_ += " ";
+    events_ += event;
+    return true;
+  }
+
+  std::string events_;
+  int fail_after_;
+};
+
+}  // namespace
+
+TEST(JSONStreamParserTest, SimpleValues) {
+  RecordingHandler handler;
+  JSONStreamParser parser(&handler);
+  EXPECT_EQ(JSONStreamParser::JSON_NO_ERROR,
+            parser.Parse("[true, false, null, 42, -1.5, \"hi\"]"));
+  EXPECT_EQ("[ true false null int:42 double:-1.5 str:hi ]",
+            handler.events());
+}
+
+TEST(JSONStreamParserTest, NestedDictionary) {
+  RecordingHandler handler;
+  JSONStreamParser parser(&handler);
+  EXPECT_EQ(JSONStreamParser::JSON_NO_ERROR,
+            parser.Parse("{\"a\": {\"b\": [1, 2]}, \"c\": \"d\"}"));
+  EXPECT_EQ("{ key:a { key:b [ int:1 int:2 ] } key:c str:d }",
+            handler.events());
+}
+
+TEST(JSONStreamParserTest, EscapedStringsAreUnescaped) {
+  RecordingHandler handler;
+  JSONStreamParser parser(&handler);
+  EXPECT_EQ(JSONStreamParser::JSON_NO_ERROR,
+            parser.Parse("[\"a\\nb\", \"\\u0041\"]"));
+  EXPECT_EQ("[ str:a\nb str:A ]", handler.events());
+}
+
+TEST(JSONStreamParserTest, LargeIntDegradesToDouble) {
+  RecordingHandler handler;
+  JSONStreamParser parser(&handler);
+  EXPECT_EQ(JSONStreamParser::JSON_NO_ERROR, parser.Parse("[2147483648]"));
+  EXPECT_EQ("[ double:2.14748e+09 ]", handler.events());
+}
+
+TEST(JSONStreamParserTest, SyntaxErrors) {
+  const char* const kCases[] = {
+    "",
+    "[1,]",
+    "{\"a\" 1}",
+    "[1",
+    "nul",
+    "[1] x",
+  };
+  for (size_t i = 0; i < arraysize(kCases); ++i) {
+    RecordingHandler handler;
+    JSONStreamParser parser(&handler);
+    EXPECT_NE(JSONStreamParser::JSON_NO_ERROR, parser.Parse(kCases[i]))
+        << kCases[i];
+  }
+}
+
+TEST(JSONStreamParserTest, HandlerCanCancel) {
+  RecordingHandler handler;
+  handler.set_fail_after(2);
+  JSONStreamParser parser(&handler);
+  EXPECT_EQ(JSONStreamParser::JSON_PARSE_CANCELLED,
+            parser.Parse("[1, 2, 3]"));
+}
+
+TEST(JSONStreamParserTest, TooMuchNesting) {
+  std::string input;
+  for (int i = 0; i < 200; ++i)
+    input += "[";
+  RecordingHandler handler;
+  JSONStreamParser parser(&handler);
+  EXPECT_EQ(JSONStreamParser::JSON_TOO_MUCH_NESTING, parser.Parse(input));
+}
+
+}  // namespace base
@@ -0,0 +1,106 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/memory/arena.h"
+
+#include <stdlib.h>
+
+#include <algorithm>
+
+#include "base/logging.h"
+
+namespace base {
+
+namespace {
+
+// Every allocation is rounded up to this, so any object type can be placed
+// at the start of a block. Matches the guarantee malloc() gives.
+const size_t kAlignment = 8;
+
+const size_t kDefaultChunkSize = 4096;
+
+size_t AlignUp(size_t size) {
+  return (size + kAlignment - 1) & ~(kAlignment - 1);
+}
+
+}  // namespace
+
+// Chunk headers precede the usable memory of each chunk. The header is kept
+// to a multiple of kAlignment so the payload starts aligned.
+struct Arena::Chunk {
+  Chunk* next;
+  size_t payload_size;
+};
+
+Arena::Arena(size_t chunk_size)
+    : chunks_(NULL),
+      next_(NULL),
+      limit_(NULL),
+      chunk_size_(AlignUp(chunk_size)),
+      bytes_allocated_(0) {
+  COMPILE_ASSERT(sizeof(Chunk) % kAlignment == 0,
+                 chunk_header_breaks_alignment);
+  DCHECK_GT(chunk_size, 0u);
+}
+
+Arena::Arena()
+    : chunks_(NULL),
+      next_(NULL),
+      limit_(NULL),
+      chunk_size_(kDefaultChunkSize),
+      bytes_allocated_(0) {
+}
+
+Arena::~Arena() {
+  FreeChunks();
+}
+
+void* Arena::Allocate(size_t size) {
+  size = AlignUp(size);
+  if (static_cast<size_t>(limit_ - next_) < size)
+    return AllocateFromNewChunk(size);
+  char* result = next_;
+  next_ += size;
+  bytes_allocated_ += size;
+  return result;
+}
+
+void Arena::Reset() {
+  FreeChunks();
+  chunks_ = NULL;
+  next_ = NULL;
+  limit_ = NULL;
+  bytes_allocated_ = 0;
+}
+
+void* Arena::AllocateFromNewChunk(size_t size) {
+  // Requests bigger than the chunk size get a dedicated chunk. The bump
+  // pointer is left alone in that case, so the unused tail of the current
+  // chunk still serves subsequent small allocations.
+  size_t payload_size = std::max(size, chunk_size_);
+  Chunk* chunk = static_cast<Chunk*>(malloc(sizeof(Chunk) + payload_size));
+  CHECK(chunk);
+  chunk->next = chunks_;
+  chunk->payload_size = payload_size;
+  chunks_ = chunk;
+
+  char* data = reinterpret_cast<char*>(chunk + 1);
+  if (size < payload_size) {
+    next_ = data + size;
+    limit_ = data + payload_size;
+  }
+  bytes_allocated_ += size;
+  return data;
+}
+
+void Arena::FreeChunks() {
+  Chunk* chunk = chunks_;
+  while (chunk) {
+    Chunk* next = chunk->next;
+    free(chunk);
+    chunk = next;
+  }
+}
+
+}  // namespace base
@@ -0,0 +1,155 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_MEMORY_ARENA_H_
+#define BASE_MEMORY_ARENA_H_
+
+#include <cstddef>
+#include <new>
+
+#include "base/base_export.h"
+#include "base/basictypes.h"
+
+namespace base {
+
+// Arena is a chunked bump allocator for building short-lived object graphs
+// without paying one heap allocation per node. Allocation is a pointer bump
+// within the current chunk; a new chunk is fetched from the heap only when
+// the current one is exhausted. Individual allocations cannot be freed:
+// everything is released at once by Reset() or by destroying the arena.
+//
+// Because of that, destructors of arena-allocated objects are never run.
+// Only use the typed helpers for types that don't need their destructor
+// called (or run it manually before resetting the arena).
+//
+// Arena is not thread safe; callers must provide their own locking.
+class BASE_EXPORT Arena {
+ public:
+  // |chunk_size| is the usable payload size of each chunk. Requests larger
+  // than the chunk size are given a dedicated chunk of their own.
+  explicit Arena(size_t chunk_size);
+  Arena();  // Uses a default chunk size suitable for small object graphs.
+  ~Arena();
+
+  // Returns |size| bytes of uninitialized memory, aligned suitably for any
+  // object type. The memory stays valid until Reset() or destruction.
+  void* Allocate(size_t size);
+
+  // Allocates and constructs a T. The destructor will not be run; see the
+  // class comment.
+  template <typename T>
+  T* New() {
+    return new (Allocate(sizeof(T))) T();
+  }
+  template <typename T, typename A1>
+  T* New(const A1& a1) {
+    return new (Allocate(sizeof(T))) T(a1);
+  }
+  template <typename T, typename A1, typename A2>
+  T* New(const A1& a1, const A2& a2) {
+    return new (Allocate(sizeof(T))) T(a1, a2);
+  }
+
+  // Allocates an uninitialized array of |count| Ts.
+  template <typename T>
+  T* AllocateArray(size_t count) {
+    return static_cast<T*>(Allocate(count * sizeof(T)));
+  }
+
+  // Releases all memory allocated from the arena. Anything previously
+  // returned by Allocate() is invalidated.
+  void Reset();
+
+  // Total number of bytes handed out by Allocate(), including alignment
+  // padding. Mostly useful for tests and tuning chunk sizes.
+  size_t bytes_allocated() const { return bytes_allocated_; }
+
+ private:
+  struct Chunk;
+
+  // Slow path of Allocate() for when the current chunk is out of space.
+  // |size| is already aligned.
+  void* AllocateFromNewChunk(size_t size);
+
+  void FreeChunks();
+
+  // Singly-linked list of all chunks owned by the arena, newest first.
+  Chunk* chunks_;
+
+  // Bump pointer and end of the chunk currently being allocated from.
+  char* next_;
+  char* limit_;
+
+  const size_t chunk_size_;
+  size_t bytes_allocated_;
+
+  DISALLOW_COPY_AND_ASSIGN(Arena);
+};
+
+// An STL-compatible allocator that takes its memory from an Arena, for
+// containers that live and die with a parse or a frame:
+//
+//   base::Arena arena;
+//   std::vector<int, base::ArenaAllocator<int> > v((
+//       base::ArenaAllocator<int>(&arena)));
+//
+// deallocate() is a no-op; the memory is reclaimed when the arena is. The
+// container must not outlive the arena, and a container that keeps growing
+// will keep consuming arena space since freed blocks are never reused.
+template <typename T>
+class ArenaAllocator {
+ public:
+  typedef T value_type;
+  typedef T* pointer;
+  typedef const T* const_pointer;
+  typedef T& reference;
+  typedef const T& const_reference;
+  typedef size_t size_type;
+  typedef ptrdiff_t difference_type;
+
+  template <typename U>
+  struct rebind {
+    typedef ArenaAllocator<U> other;
+  };
+
+  explicit ArenaAllocator(Arena* arena) : arena_(arena) {}
+  template <typename U>
+  ArenaAllocator(const ArenaAllocator<U>& other) : arena_(other.arena()) {}
+
+  pointer allocate(size_type n, const void* hint = NULL) {
+    return static_cast<pointer>(arena_->Allocate(n * sizeof(T)));
+  }
+  void deallocate(pointer p, size_type n) {
+    // Freed in bulk when the arena is reset or destroyed.
+  }
+
+  size_type max_size() const {
+    return static_cast<size_type>(-1) / sizeof(T);
+  }
+
+  void construct(pointer p, const T& value) { new (p) T(value); }
+  void destroy(pointer p) { p->~T(); }
+
+  pointer address(reference x) const { return &x; }
+  const_pointer address(const_reference x) const { return &x; }
+
+  Arena* arena() const { return arena_; }
+
+ private:
+  Arena* arena_;
+};
+
+template <typename T, typename U>
+inline bool operator==(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) {
+  return a.arena() == b.arena();
+}
+
+template <typename T, typename U>
+inline bool operator!=(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) {
+  return a.arena() != b.arena();
+}
+
+}  // namespace base
+
+#endif  // BASE_MEMORY_ARENA_H_
@@ -0,0 +1,137 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/memory/arena.h"
+
+#include <string.h>
+
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+
+namespace {
+
+struct Point {
+  Point(int x, int y) : x(x), y(y) {}
+  int x;
+  int y;
+};
+
+}  // namespace
+
+TEST(ArenaTest, Basic) {
+  Arena arena;
+  EXPECT_EQ(0u, arena.bytes_allocated());
+
+  void* a = arena.Allocate(16);
+  void* b = arena.Allocate(16);
+  ASSERT_TRUE(a);
+  ASSERT_TRUE(b);
+  EXPECT_NE(a, b);
+  EXPECT_EQ(32u, arena.bytes_allocated());
+
+  // The memory must be usable.
+  memset(a, 0xab, 16);
+  memset(b, 0xcd, 16);
+}
+
+TEST(ArenaTest, Alignment) {
+  Arena arena;
+  for (size_t size = 1; size <= 17; ++size) {
+    uintptr_t address = reinterpret_cast<uintptr_t>(arena.Allocate(size));
+    EXPECT_EQ(0u, address % 8) << "size " << size;
+  }
+}
+
+TEST(ArenaTest, New) {
+  Arena arena;
+  int* i = arena.New<int>();
+  EXPECT_EQ(0, *i);
+  Point* p = arena.New<Point>(3, 4);
+  EXPECT_EQ(3, p->x);
+  EXPECT_EQ(4, p->y);
+
+  Point* points = arena.AllocateArray<Point>(100);
+  for (int j = 0; j < 100; ++j)
+    new (&points[j]) Point(j, -j);
+  EXPECT_EQ(99, points[99].x);
+}
+
+TEST(ArenaTest, SpansChunks) {
+  // A tiny chunk size forces many chunks to be chained together.
+  Arena arena(64);
+  std::vector<int*> allocations;
+  for (int i = 0; i < 1000; ++i) {
+    int* p = arena.New<int>(i);
+    allocations.push_back(p);
+  }
+  // Nothing may have been clobbered by later chunk allocations.
+  for (int i = 0; i < 1000; ++i)
+    EXPECT_EQ(i, *allocations[i]);
+}
+
+TEST(ArenaTest, OversizedAllocation) {
+  Arena arena(64);
+  // Much larger than the chunk size; gets a dedicated chunk.
+  char* big = static_cast<char*>(arena.Allocate(1024));
+  ASSERT_TRUE(big);
+  memset(big, 0xef, 1024);
+
+  // Small allocations still work afterwards.
+  int* small = arena.New<int>(42);
+  EXPECT_EQ(42, *small);
+}
+
+TEST(ArenaTest, Reset) {
+  Arena arena(64);
+  for (int i = 0; i < 100; ++i)
+    arena.Allocate(16);
+  EXPECT_EQ(1600u, arena.bytes_allocated());
+
+  arena.Reset();
+  EXPECT_EQ(0u, arena.bytes_allocated());
+
+  // The arena is usable again after a reset.
+  int* p = arena.New<int>(7);
+  EXPECT_EQ(7, *p);
+}
+
+TEST(ArenaTest, StlVector) {
+  Arena arena;
+  std::vector<int, ArenaAllocator<int> > v((ArenaAllocator<int>(&arena)));
+  for (int i = 0; i < 1000; ++i)
+    v.push_back(i);
+  ASSERT_EQ(1000u, v.size());
+  EXPECT_EQ(999, v[999]);
+  EXPECT_GE(arena.bytes_allocated(), 1000 * sizeof(int));
+}
+
+TEST(ArenaTest, StlMap) {
+  Arena arena;
+  typedef std::pair<const int, int> Entry;
+  std::less<int> compare;
+  ArenaAllocator<Entry> allocator(&arena);
+  std::map<int, int, std::less<int>, ArenaAllocator<Entry> > m(compare,
+                                                               allocator);
+  for (int i = 0; i < 100; ++i)
+    m.insert(std::make_pair(i, i * i));
+  ASSERT_EQ(100u, m.size());
+  EXPECT_EQ(81, m[9]);
+}
+
+TEST(ArenaTest, AllocatorEquality) {
+  Arena arena1;
+  Arena arena2;
+  ArenaAllocator<int> a1(&arena1);
+  ArenaAllocator<char> a1_char(&arena1);
+  ArenaAllocator<int> a2(&arena2);
+  EXPECT_TRUE(a1 == a1_char);
+  EXPECT_TRUE(a1 != a2);
+}
+
+}  // namespace base
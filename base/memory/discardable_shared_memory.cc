@@ -0,0 +1,175 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/memory/discardable_shared_memory.h"
+
+#include "base/atomicops.h"
+#include "base/logging.h"
+#include "base/numerics/safe_math.h"
+
+namespace base {
+namespace {
+
+typedef subtle::Atomic32 AtomicType;
+typedef uint32 UAtomicType;
+
+// The state of the memory, shared by every process that maps the region.
+// The lock state occupies the low bit; while unlocked, the remaining bits
+// hold the last usage time in seconds since epoch. An unlocked state with a
+// zero timestamp means the memory has been purged. Second granularity is
+// enough for purge decisions and keeps the state within 32 bits, which all
+// supported platforms can update atomically.
+struct SharedState {
+  enum LockState { UNLOCKED = 0, LOCKED = 1 };
+
+  explicit SharedState(AtomicType ivalue) { value.i = ivalue; }
+  SharedState(LockState lock_state, Time timestamp) {
+    value.u = (static_cast<UAtomicType>(timestamp.ToDoubleT()) << 1) |
+              (lock_state & 1);
+  }
+
+  LockState GetLockState() const {
+    return static_cast<LockState>(value.u & 1);
+  }
+
+  Time GetTimestamp() const { return Time::FromDoubleT(value.u >> 1); }
+
+  union {
+    AtomicType i;
+    UAtomicType u;
+  } value;
+};
+
+// The shared state occupies the first bytes of the mapped region; the
+// client's memory follows. Padded so the memory handed out is suitably
+// aligned for any data type.
+const size_t kDataOffset = 8;
+COMPILE_ASSERT(sizeof(SharedState) <= kDataOffset,
+               shared_state_doesnt_fit_in_data_offset);
+
+}  // namespace
+
+DiscardableSharedMemory::DiscardableSharedMemory()
+    : mapped_size_(0), locked_(false) {
+}
+
+DiscardableSharedMemory::DiscardableSharedMemory(SharedMemoryHandle handle)
+    : shared_memory_(handle, false), mapped_size_(0), locked_(false) {
+}
+
+DiscardableSharedMemory::~DiscardableSharedMemory() {
+  DCHECK(!locked_);
+}
+
+bool DiscardableSharedMemory::CreateAndMap(size_t size) {
+  CheckedNumeric<size_t> checked_size = size;
+  checked_size += kDataOffset;
+  if (!checked_size.IsValid())
+    return false;
+
+  if (!shared_memory_.CreateAndMapAnonymous(checked_size.ValueOrDie()))
+    return false;
+
+  mapped_size_ = shared_memory_.mapped_size() - kDataOffset;
+
+  // Memory is created in the locked state.
+  SharedState locked_state(SharedState::LOCKED, Time());
+  subtle::NoBarrier_Store(
+      &static_cast<SharedState*>(shared_memory_.memory())->value.i,
+      locked_state.value.i);
+  locked_ = true;
+  return true;
+}
+
+bool DiscardableSharedMemory::Map(size_t size) {
+  if (!shared_memory_.Map(kDataOffset + size))
+    return false;
+
+  mapped_size_ = shared_memory_.mapped_size() - kDataOffset;
+  return true;
+}
+
+bool DiscardableSharedMemory::Lock() {
+  DCHECK(!locked_);
+  DCHECK(shared_memory_.memory());
+
+  // The only other valid writer while the memory is unlocked is a purger, so
+  // a single compare-and-swap against the last known usage is enough: if it
+  // fails the memory has been purged.
+  SharedState old_state(SharedState::UNLOCKED, last_known_usage_);
+  SharedState new_state(SharedState::LOCKED, Time());
+  SharedState result(subtle::Acquire_CompareAndSwap(
+      &static_cast<SharedState*>(shared_memory_.memory())->value.i,
+      old_state.value.i,
+      new_state.value.i));
+  if (result.value.i != old_state.value.i) {
+    last_known_usage_ = Time();
+    return false;
+  }
+
+  locked_ = true;
+  last_known_usage_ = Time();
+  return true;
+}
+
+void DiscardableSharedMemory::Unlock() {
+  DCHECK(locked_);
+  DCHECK(shared_memory_.memory());
+
+  Time now = Time::Now();
+
+  SharedState old_state(SharedState::LOCKED, Time());
+  SharedState new_state(SharedState::UNLOCKED, now);
+  SharedState result(subtle::Release_CompareAndSwap(
+      &static_cast<SharedState*>(shared_memory_.memory())->value.i,
+      old_state.value.i,
+      new_state.value.i));
+  DCHECK_EQ(old_state.value.i, result.value.i);
+
+  last_known_usage_ = new_state.GetTimestamp();
+  locked_ = false;
+}
+
+void* DiscardableSharedMemory::memory() const {
+  DCHECK(locked_);
+  return reinterpret_cast<uint8*>(shared_memory_.memory()) + kDataOffset;
+}
+
+bool DiscardableSharedMemory::Purge(Time current_time) {
+  DCHECK(shared_memory_.memory());
+
+  SharedState old_state(SharedState::UNLOCKED, last_known_usage_);
+  SharedState new_state(SharedState::UNLOCKED, Time());
+  SharedState result(subtle::Acquire_CompareAndSwap(
+      &static_cast<SharedState*>(shared_memory_.memory())->value.i,
+      old_state.value.i,
+      new_state.value.i));
+  if (result.value.i != old_state.value.i) {
+    // The memory is locked or was used more recently than this object knew.
+    // Adopt the time found in the shared state so a later purge attempt can
+    // succeed once enough time has passed.
+    last_known_usage_ = result.GetLockState() == SharedState::LOCKED
+                            ? current_time
+                            : result.GetTimestamp();
+    return false;
+  }
+
+  last_known_usage_ = Time();
+  return true;
+}
+
+bool DiscardableSharedMemory::IsMemoryResident() const {
+  DCHECK(shared_memory_.memory());
+
+  SharedState result(subtle::NoBarrier_Load(
+      &static_cast<SharedState*>(shared_memory_.memory())->value.i));
+  return result.GetLockState() == SharedState::LOCKED ||
+         !result.GetTimestamp().is_null();
+}
+
+void DiscardableSharedMemory::Close() {
+  shared_memory_.Close();
+}
+
+}  // namespace base
@@ -0,0 +1,108 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_MEMORY_DISCARDABLE_SHARED_MEMORY_H_
+#define BASE_MEMORY_DISCARDABLE_SHARED_MEMORY_H_
+
+#include "base/base_export.h"
+#include "base/memory/shared_memory.h"
+#include "base/time/time.h"
+
+namespace base {
+
+// Discardable memory backed by shared memory, so that the region can be
+// handed to another process and purged from there.
+//
+// The first bytes of the mapped region hold a small state word shared by
+// every process that maps the region. It records whether the memory is
+// locked and, while unlocked, when it was last used. Purge() uses it to
+// atomically discard the contents only if no process holds the lock and the
+// memory has not been used since the caller last observed it.
+//
+// Only one client may lock and use the memory at any given time, but any
+// process that maps the region may purge it. Memory is created in the locked
+// state.
+class BASE_EXPORT DiscardableSharedMemory {
+ public:
+  DiscardableSharedMemory();
+
+  // Create a new DiscardableSharedMemory object from an existing, open shared
+  // memory file. Memory must be mapped with Map() before it can be used.
+  explicit DiscardableSharedMemory(SharedMemoryHandle handle);
+
+  virtual ~DiscardableSharedMemory();
+
+  // Creates and maps a locked DiscardableSharedMemory object with |size|.
+  // Returns true on success and false on failure.
+  bool CreateAndMap(size_t size);
+
+  // Maps the locked discardable memory into the caller's address space.
+  // Returns true on success, false otherwise.
+  bool Map(size_t size);
+
+  // The actual size of the mapped memory, which can be larger than the
+  // requested size.
+  size_t mapped_size() const { return mapped_size_; }
+
+  // Locks the memory so that it will not be purged by any process. Returns
+  // true if the lock was successfully acquired and the memory is still
+  // resident. If it returns false the memory has been purged and this object
+  // should be discarded.
+  bool Lock();
+
+  // Unlocks the memory so that it can be purged. Must be called after every
+  // successful Lock() call.
+  void Unlock();
+
+  // Returns the memory address held by this object. The object must be
+  // locked before calling this.
+  void* memory() const;
+
+  // Returns the last time the memory was unlocked, as far as this object
+  // knows. The shared state may hold a more recent time if another process
+  // mapping the region used the memory since.
+  Time last_known_usage() const { return last_known_usage_; }
+
+  // Purges the memory if it is not locked and has not been used since
+  // |current_time| was last observed by this object. Returns true if the
+  // memory was successfully purged, false if it is locked or was used more
+  // recently than this object knew; in the latter case last_known_usage() is
+  // updated to the time found in the shared state. Note that this only marks
+  // the contents as discarded; releasing the underlying pages is up to the
+  // owner of the shared memory segment.
+  bool Purge(Time current_time);
+
+  // Returns true if the memory is still resident, i.e. has not been purged.
+  bool IsMemoryResident() const;
+
+  // Closes the open discardable memory segment. It is safe to call Close
+  // repeatedly.
+  void Close();
+
+  // Shares the discardable memory segment with a process, so it can map the
+  // same region and participate in purge coordination.
+  bool ShareToProcess(ProcessHandle process_handle,
+                      SharedMemoryHandle* new_handle) {
+    return shared_memory_.ShareToProcess(process_handle, new_handle);
+  }
+
+  SharedMemoryHandle handle() const { return shared_memory_.handle(); }
+
+ private:
+  SharedMemory shared_memory_;
+  size_t mapped_size_;
+
+  // Tracks whether this object acquired the shared lock, to catch unbalanced
+  // Lock()/Unlock() calls.
+  bool locked_;
+
+  // The last usage timestamp this object has observed in the shared state.
+  Time last_known_usage_;
+
+  DISALLOW_COPY_AND_ASSIGN(DiscardableSharedMemory);
+};
+
+}  // namespace base
+
+#endif  // BASE_MEMORY_DISCARDABLE_SHARED_MEMORY_H_
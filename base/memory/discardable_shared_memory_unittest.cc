@@ -0,0 +1,107 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/basictypes.h"
+#include "base/memory/discardable_shared_memory.h"
+#include "base/process/process_handle.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+namespace {
+
+const uint32 kDataSize = 1024;
+
+TEST(DiscardableSharedMemoryTest, CreateAndMap) {
+  DiscardableSharedMemory memory;
+  bool rv = memory.CreateAndMap(kDataSize);
+  ASSERT_TRUE(rv);
+  EXPECT_GE(memory.mapped_size(), kDataSize);
+  EXPECT_TRUE(memory.IsMemoryResident());
+
+  // Memory is created in the locked state.
+  memory.Unlock();
+}
+
+TEST(DiscardableSharedMemoryTest, CreateFromHandle) {
+  DiscardableSharedMemory memory1;
+  bool rv = memory1.CreateAndMap(kDataSize);
+  ASSERT_TRUE(rv);
+
+  SharedMemoryHandle shared_handle;
+  ASSERT_TRUE(
+      memory1.ShareToProcess(GetCurrentProcessHandle(), &shared_handle));
+
+  DiscardableSharedMemory memory2(shared_handle);
+  rv = memory2.Map(kDataSize);
+  ASSERT_TRUE(rv);
+  EXPECT_TRUE(memory2.IsMemoryResident());
+
+  memory1.Unlock();
+}
+
+TEST(DiscardableSharedMemoryTest, LockAndUnlock) {
+  DiscardableSharedMemory memory;
+  bool rv = memory.CreateAndMap(kDataSize);
+  ASSERT_TRUE(rv);
+
+  // Memory is initially locked. Unlock it and lock it again.
+  memory.Unlock();
+  EXPECT_TRUE(memory.Lock());
+
+  // Write to the memory while locked; the contents must survive an
+  // unlock/lock cycle when no purge happens in between.
+  memset(memory.memory(), 0xaa, kDataSize);
+  memory.Unlock();
+  EXPECT_TRUE(memory.Lock());
+  EXPECT_EQ(0xaa, static_cast<uint8*>(memory.memory())[0]);
+  memory.Unlock();
+}
+
+TEST(DiscardableSharedMemoryTest, Purge) {
+  DiscardableSharedMemory memory1;
+  bool rv = memory1.CreateAndMap(kDataSize);
+  ASSERT_TRUE(rv);
+
+  SharedMemoryHandle shared_handle;
+  ASSERT_TRUE(
+      memory1.ShareToProcess(GetCurrentProcessHandle(), &shared_handle));
+
+  DiscardableSharedMemory memory2(shared_handle);
+  rv = memory2.Map(kDataSize);
+  ASSERT_TRUE(rv);
+
+  // This should fail as the memory is locked.
+  EXPECT_FALSE(memory2.Purge(Time::FromDoubleT(1)));
+
+  memory1.Unlock();
+
+  // A purge attempt that is not aware of the last usage fails and brings
+  // |memory2|'s view of the last usage up to date.
+  EXPECT_FALSE(memory2.Purge(Time::FromDoubleT(1)));
+
+  // This should succeed now that the last usage is known.
+  EXPECT_TRUE(memory2.Purge(memory2.last_known_usage() +
+                            TimeDelta::FromSeconds(1)));
+  EXPECT_FALSE(memory2.IsMemoryResident());
+  EXPECT_FALSE(memory1.IsMemoryResident());
+
+  // Lock should fail as the memory has been purged.
+  EXPECT_FALSE(memory1.Lock());
+  EXPECT_FALSE(memory2.Lock());
+}
+
+TEST(DiscardableSharedMemoryTest, LastKnownUsage) {
+  DiscardableSharedMemory memory;
+  bool rv = memory.CreateAndMap(kDataSize);
+  ASSERT_TRUE(rv);
+
+  // Memory has not been unlocked yet, so there is no last usage.
+  EXPECT_TRUE(memory.last_known_usage().is_null());
+
+  memory.Unlock();
+  EXPECT_FALSE(memory.last_known_usage().is_null());
+}
+
+}  // namespace
+}  // namespace base
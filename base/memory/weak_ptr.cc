@@ -22,12 +22,6 @@ void WeakReference::Flag::Invalidate() {
   is_valid_ = false;
 }
 
-bool WeakReference::Flag::IsValid() const {
-  DCHECK(sequence_checker_.CalledOnValidSequencedThread())
-      << "WeakPtrs must be checked on the same sequenced thread.";
-  return is_valid_;
-}
-
 WeakReference::Flag::~Flag() {
 }
 
@@ -40,8 +34,6 @@ WeakReference::WeakReference(const Flag* flag) : flag_(flag) {
 WeakReference::~WeakReference() {
 }
 
-bool WeakReference::is_valid() const { return flag_.get() && flag_->IsValid(); }
-
 WeakReferenceOwner::WeakReferenceOwner() {
 }
 
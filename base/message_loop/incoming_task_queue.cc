@@ -12,9 +12,50 @@
 namespace base {
 namespace internal {
 
+namespace {
+
+// Returns true if the pump must be woken up for every single posted task
+// rather than only when the incoming queue transitions from empty to
+// non-empty (see MessageLoop::ScheduleWork).
+bool AlwaysNotifyPump(MessageLoop::Type type) {
+#if defined(OS_ANDROID)
+  return type == MessageLoop::TYPE_UI || type == MessageLoop::TYPE_JAVA;
+#else
+  return false;
+#endif
+}
+
+// Matches MessageLoop::GetTaskTraceID() so that the flow events emitted on
+// the posting side pair up with the ones emitted when the task runs.
+uint64 GetTaskTraceID(const PendingTask& task, intptr_t loop_id) {
+  return (static_cast<uint64>(task.sequence_num) << 32) |
+         ((static_cast<uint64>(loop_id) << 32) >> 32);
+}
+
+}  // namespace
+
+// The nodes of the lock-free incoming stack. Nodes are allocated by the
+// posting threads and freed by the consuming thread, or by the destructor for
+// tasks that were never consumed.
+struct IncomingTaskQueue::TaskNode {
+  explicit TaskNode(const PendingTask& task) : task(task), next(NULL) {}
+
+  PendingTask task;
+  TaskNode* next;
+};
+
 IncomingTaskQueue::IncomingTaskQueue(MessageLoop* message_loop)
-    : message_loop_(message_loop),
-      next_sequence_num_(0) {
+    :
+#if defined(OS_WIN)
+      high_res_timer_active_(0),
+#endif
+      incoming_queue_head_(0),
+      accepting_tasks_(1),
+      always_schedule_work_(AlwaysNotifyPump(message_loop->type())),
+      message_loop_(message_loop),
+      message_loop_id_(reinterpret_cast<intptr_t>(message_loop)),
+      next_sequence_num_(0),
+      coalescing_interval_us_(0) {
 }
 
 bool IncomingTaskQueue::AddToIncomingQueue(
@@ -22,10 +63,55 @@ bool IncomingTaskQueue::AddToIncomingQueue(
     const Closure& task,
     TimeDelta delay,
     bool nestable) {
-  AutoLock locked(incoming_queue_lock_);
-  PendingTask pending_task(
-      from_here, task, CalculateDelayedRuntime(delay), nestable);
-  return PostPendingTask(&pending_task);
+  // Warning: Don't try to short-circuit, and handle this thread's tasks more
+  // directly, as it could starve handling of foreign threads.  Put every task
+  // into this queue.
+
+  // Checking the flag outside the lock is fine: it is only cleared while the
+  // message loop shuts down, at which point the poster was racing with the
+  // shutdown anyway. A task that slips through after the flag is cleared is
+  // deleted by the destructor without running.
+  if (!subtle::Acquire_Load(&accepting_tasks_))
+    return false;
+
+  TaskNode* node = new TaskNode(
+      PendingTask(from_here, task, CalculateDelayedRuntime(delay), nestable));
+
+  // Initialize the sequence number. The sequence number is used for delayed
+  // tasks (to faciliate FIFO sorting when two tasks have the same
+  // delayed_run_time value) and for identifying the task in about:tracing.
+  // Tasks from different threads may enter the queue in an order that differs
+  // slightly from their sequence numbers, but that only matters for delayed
+  // tasks sharing a run time, which sort consistently either way.
+  node->task.sequence_num =
+      subtle::NoBarrier_AtomicIncrement(&next_sequence_num_, 1);
+
+  TRACE_EVENT_FLOW_BEGIN0(TRACE_DISABLED_BY_DEFAULT("toplevel.flow"),
+      "MessageLoop::PostTask",
+      TRACE_ID_MANGLE(GetTaskTraceID(node->task, message_loop_id_)));
+
+  // Push the node with a single compare-and-swap. The consuming thread reaps
+  // the whole stack at once in ReloadWorkQueue(), so this is the only point
+  // where posting threads can contend with each other.
+  subtle::AtomicWord old_head;
+  do {
+    old_head = subtle::Acquire_Load(&incoming_queue_head_);
+    node->next = reinterpret_cast<TaskNode*>(old_head);
+  } while (subtle::Release_CompareAndSwap(
+               &incoming_queue_head_,
+               old_head,
+               reinterpret_cast<subtle::AtomicWord>(node)) != old_head);
+
+  // Wake up the pump. Posts that found the queue already non-empty can skip
+  // this, and the lock that keeps |message_loop_| alive for it, entirely:
+  // whoever made the queue non-empty has already scheduled the work.
+  bool was_empty = (old_head == 0);
+  if (was_empty || always_schedule_work_) {
+    AutoLock locked(incoming_queue_lock_);
+    if (message_loop_)
+      message_loop_->ScheduleWork(was_empty);
+  }
+  return true;
 }
 
 bool IncomingTaskQueue::IsHighResolutionTimerEnabledForTesting() {
@@ -37,20 +123,49 @@ bool IncomingTaskQueue::IsHighResolutionTimerEnabledForTesting() {
 }
 
 bool IncomingTaskQueue::IsIdleForTesting() {
-  AutoLock lock(incoming_queue_lock_);
-  return incoming_queue_.empty();
+  return subtle::Acquire_Load(&incoming_queue_head_) == 0;
 }
 
 void IncomingTaskQueue::ReloadWorkQueue(TaskQueue* work_queue) {
   // Make sure no tasks are lost.
   DCHECK(work_queue->empty());
 
-  // Acquire all we can from the inter-thread queue with one lock acquisition.
-  AutoLock lock(incoming_queue_lock_);
-  if (!incoming_queue_.empty())
-    incoming_queue_.Swap(work_queue);  // Constant time
+  // Reap everything posted so far with a single atomic exchange. The
+  // compare-and-swap only retries if a producer got a push in between the
+  // load and the swap.
+  subtle::AtomicWord head;
+  do {
+    head = subtle::Acquire_Load(&incoming_queue_head_);
+    if (!head)
+      return;
+  } while (subtle::Acquire_CompareAndSwap(&incoming_queue_head_, head, 0) !=
+           head);
 
-  DCHECK(incoming_queue_.empty());
+  // The stack pops in reverse posting order; put the batch back into posting
+  // order before handing it to the work queue.
+  TaskNode* reversed = NULL;
+  TaskNode* node = reinterpret_cast<TaskNode*>(head);
+  while (node) {
+    TaskNode* next = node->next;
+    node->next = reversed;
+    reversed = node;
+    node = next;
+  }
+
+  while (reversed) {
+    work_queue->push(reversed->task);
+    TaskNode* consumed = reversed;
+    reversed = reversed->next;
+    delete consumed;
+  }
+}
+
+void IncomingTaskQueue::SetDelayedTaskCoalescingInterval(TimeDelta interval) {
+  DCHECK(interval >= TimeDelta());
+  DCHECK_LE(interval.InMicroseconds(), static_cast<int64>(kint32max));
+  subtle::Release_Store(
+      &coalescing_interval_us_,
+      static_cast<subtle::Atomic32>(interval.InMicroseconds()));
 }
 
 void IncomingTaskQueue::WillDestroyCurrentMessageLoop() {
@@ -65,12 +180,23 @@ void IncomingTaskQueue::WillDestroyCurrentMessageLoop() {
 #endif
 
   AutoLock lock(incoming_queue_lock_);
+  subtle::Release_Store(&accepting_tasks_, 0);
   message_loop_ = NULL;
 }
 
 IncomingTaskQueue::~IncomingTaskQueue() {
   // Verify that WillDestroyCurrentMessageLoop() has been called.
   DCHECK(!message_loop_);
+
+  // Drop tasks that were posted while the loop was shutting down and never
+  // made it to the work queue.
+  TaskNode* node = reinterpret_cast<TaskNode*>(
+      subtle::NoBarrier_AtomicExchange(&incoming_queue_head_, 0));
+  while (node) {
+    TaskNode* next = node->next;
+    delete node;
+    node = next;
+  }
 }
 
 TimeTicks IncomingTaskQueue::CalculateDelayedRuntime(TimeDelta delay) {
@@ -78,7 +204,23 @@ TimeTicks IncomingTaskQueue::CalculateDelayedRuntime(TimeDelta delay) {
   if (delay > TimeDelta()) {
     delayed_run_time = TimeTicks::Now() + delay;
 
+    // Round the run time up to the next coalescing bucket boundary, if
+    // coalescing is enabled, so that timers in the same bucket are serviced
+    // together by one wakeup. Rounding up means a task never runs before the
+    // delay its poster asked for.
+    int32 coalescing_us = subtle::Acquire_Load(&coalescing_interval_us_);
+    if (coalescing_us > 0) {
+      int64 run_us = (delayed_run_time - TimeTicks()).InMicroseconds();
+      int64 aligned_us =
+          (run_us + coalescing_us - 1) / coalescing_us * coalescing_us;
+      delayed_run_time += TimeDelta::FromMicroseconds(aligned_us - run_us);
+    }
+
 #if defined(OS_WIN)
+    // The high resolution timer bookkeeping is the one piece of posting state
+    // still guarded by the lock; it is only touched for delayed tasks and
+    // when the timer is known to be active (see below).
+    AutoLock locked(incoming_queue_lock_);
     if (high_resolution_timer_expiration_.is_null()) {
       // Windows timers are granular to 15.6ms.  If we only set high-res
       // timers for those under 15.6ms, then a 18ms timer ticks at ~32ms,
@@ -92,6 +234,7 @@ TimeTicks IncomingTaskQueue::CalculateDelayedRuntime(TimeDelta delay) {
           high_resolution_timer_expiration_ = TimeTicks::Now() +
               TimeDelta::FromMilliseconds(
                   MessageLoop::kHighResolutionTimerModeLeaseTimeMs);
+          subtle::Release_Store(&high_res_timer_active_, 1);
         }
       }
     }
@@ -101,10 +244,15 @@ TimeTicks IncomingTaskQueue::CalculateDelayedRuntime(TimeDelta delay) {
   }
 
 #if defined(OS_WIN)
-  if (!high_resolution_timer_expiration_.is_null()) {
-    if (TimeTicks::Now() > high_resolution_timer_expiration_) {
+  // Only take the lock to check for expiration while the timer is known to
+  // be activated; otherwise posting an immediate task stays lock-free.
+  if (subtle::Acquire_Load(&high_res_timer_active_)) {
+    AutoLock locked(incoming_queue_lock_);
+    if (!high_resolution_timer_expiration_.is_null() &&
+        TimeTicks::Now() > high_resolution_timer_expiration_) {
       Time::ActivateHighResolutionTimer(false);
       high_resolution_timer_expiration_ = TimeTicks();
+      subtle::Release_Store(&high_res_timer_active_, 0);
     }
   }
 #endif
@@ -112,37 +260,5 @@ TimeTicks IncomingTaskQueue::CalculateDelayedRuntime(TimeDelta delay) {
   return delayed_run_time;
 }
 
-bool IncomingTaskQueue::PostPendingTask(PendingTask* pending_task) {
-  // Warning: Don't try to short-circuit, and handle this thread's tasks more
-  // directly, as it could starve handling of foreign threads.  Put every task
-  // into this queue.
-
-  // This should only be called while the lock is taken.
-  incoming_queue_lock_.AssertAcquired();
-
-  if (!message_loop_) {
-    pending_task->task.Reset();
-    return false;
-  }
-
-  // Initialize the sequence number. The sequence number is used for delayed
-  // tasks (to faciliate FIFO sorting when two tasks have the same
-  // delayed_run_time value) and for identifying the task in about:tracing.
-  pending_task->sequence_num = next_sequence_num_++;
-
-  TRACE_EVENT_FLOW_BEGIN0(TRACE_DISABLED_BY_DEFAULT("toplevel.flow"),
-      "MessageLoop::PostTask",
-      TRACE_ID_MANGLE(message_loop_->GetTaskTraceID(*pending_task)));
-
-  bool was_empty = incoming_queue_.empty();
-  incoming_queue_.push(*pending_task);
-  pending_task->task.Reset();
-
-  // Wake up the pump.
-  message_loop_->ScheduleWork(was_empty);
-
-  return true;
-}
-
 }  // namespace internal
 }  // namespace base
@@ -5,6 +5,7 @@
 #ifndef BASE_MESSAGE_LOOP_INCOMING_TASK_QUEUE_H_
 #define BASE_MESSAGE_LOOP_INCOMING_TASK_QUEUE_H_
 
+#include "base/atomicops.h"
 #include "base/base_export.h"
 #include "base/memory/ref_counted.h"
 #include "base/pending_task.h"
@@ -45,10 +46,16 @@ class BASE_EXPORT IncomingTaskQueue
   // Returns true if the message loop is "idle". Provided for testing.
   bool IsIdleForTesting();
 
-  // Loads tasks from the |incoming_queue_| into |*work_queue|. Must be called
+  // Loads tasks from the incoming queue into |*work_queue|. Must be called
   // from the thread that is running the loop.
   void ReloadWorkQueue(TaskQueue* work_queue);
 
+  // Sets the interval to whose multiples delayed run times are aligned
+  // (rounded up); zero disables the alignment. See
+  // MessageLoop::SetDelayedTaskCoalescingInterval. May be called from any
+  // thread.
+  void SetDelayedTaskCoalescingInterval(TimeDelta interval);
+
   // Disconnects |this| from the parent message loop.
   void WillDestroyCurrentMessageLoop();
 
@@ -56,33 +63,55 @@ class BASE_EXPORT IncomingTaskQueue
   friend class RefCountedThreadSafe<IncomingTaskQueue>;
   virtual ~IncomingTaskQueue();
 
+  // A heap-allocated link in the lock-free incoming stack. Defined in the
+  // implementation file.
+  struct TaskNode;
+
   // Calculates the time at which a PendingTask should run.
   TimeTicks CalculateDelayedRuntime(TimeDelta delay);
 
-  // Adds a task to |incoming_queue_|. The caller retains ownership of
-  // |pending_task|, but this function will reset the value of
-  // |pending_task->task|. This is needed to ensure that the posting call stack
-  // does not retain |pending_task->task| beyond this function call.
-  bool PostPendingTask(PendingTask* pending_task);
-
 #if defined(OS_WIN)
   TimeTicks high_resolution_timer_expiration_;
+
+  // Non-zero while the high resolution timer is activated, so posting threads
+  // can check for its expiration without taking |incoming_queue_lock_|.
+  subtle::Atomic32 high_res_timer_active_;
 #endif
 
-  // The lock that protects access to |incoming_queue_|, |message_loop_| and
-  // |next_sequence_num_|.
+  // Protects |message_loop_| and the high resolution timer bookkeeping. The
+  // posting fast path does not take this lock; it is only acquired to wake up
+  // the pump when the incoming queue becomes non-empty and during shutdown.
   base::Lock incoming_queue_lock_;
 
-  // An incoming queue of tasks that are acquired under a mutex for processing
-  // on this instance's thread. These tasks have not yet been been pushed to
-  // |message_loop_|.
-  TaskQueue incoming_queue_;
+  // Head of a lock-free multiple-producer single-consumer intrusive stack of
+  // tasks that have not yet been moved to the owning thread's work queue.
+  // Producers push one node with a compare-and-swap; the consumer reaps the
+  // whole batch with a single atomic exchange and reverses it to restore
+  // posting order.
+  subtle::AtomicWord incoming_queue_head_;
+
+  // Cleared during shutdown, before |message_loop_| goes away; checked on the
+  // post path so that tasks posted afterwards are refused.
+  subtle::Atomic32 accepting_tasks_;
+
+  // Whether the pump must be notified for every post rather than only when
+  // the incoming queue becomes non-empty (see MessageLoop::ScheduleWork).
+  const bool always_schedule_work_;
 
   // Points to the message loop that owns |this|.
   MessageLoop* message_loop_;
 
+  // The pointer value of |message_loop_| at construction, kept separately so
+  // the posting fast path can compute task trace IDs without holding the lock
+  // that guards |message_loop_|.
+  const intptr_t message_loop_id_;
+
   // The next sequence number to use for delayed tasks.
-  int next_sequence_num_;
+  subtle::Atomic32 next_sequence_num_;
+
+  // Microseconds of the coalescing interval for delayed run times, or zero
+  // when coalescing is disabled. Read on every delayed post.
+  subtle::Atomic32 coalescing_interval_us_;
 
   DISALLOW_COPY_AND_ASSIGN(IncomingTaskQueue);
 };
@@ -280,6 +280,16 @@ class BASE_EXPORT MessageLoop : public MessagePump::Delegate {
     pump_->SetTimerSlack(timer_slack);
   }
 
+  // Sets the coalescing interval for delayed tasks. When the interval is
+  // non-zero, the run time of every delayed task is rounded up to the next
+  // multiple of the interval, so timers that land in the same bucket are
+  // serviced by a single wakeup instead of one wakeup each. A task never
+  // runs earlier than the delay its poster asked for; it may run up to one
+  // interval late. Pass a zero interval to restore exact delayed run times.
+  void SetDelayedTaskCoalescingInterval(TimeDelta interval) {
+    incoming_task_queue_->SetDelayedTaskCoalescingInterval(interval);
+  }
+
   // Returns true if this loop is |type|. This allows subclasses (especially
   // those in tests) to specialize how they are identified.
   virtual bool IsType(Type type) const;
@@ -0,0 +1,102 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/bind.h"
+#include "base/memory/scoped_vector.h"
+#include "base/message_loop/message_loop.h"
+#include "base/synchronization/waitable_event.h"
+#include "base/threading/thread.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace base {
+
+namespace {
+
+const int kNumPostsPerProducer = 100000;
+
+// Measures the rate at which tasks can be posted to a message loop from other
+// threads. All producers hammer the same consumer loop, so with more than one
+// producer this exercises contention on the incoming queue.
+class MessageLoopPostPerfTest : public testing::Test {
+ protected:
+  void RunPostThroughputTest(const std::string& name, int num_producers) {
+    MessageLoop loop;
+    total_tasks_ = num_producers * kNumPostsPerProducer;
+    num_tasks_run_ = 0;
+
+    // Stage the producer threads so that they all start posting at once.
+    WaitableEvent start_event(true, false);
+    std::vector<TimeDelta> post_times(num_producers);
+    ScopedVector<Thread> producers;
+    for (int i = 0; i < num_producers; i++) {
+      producers.push_back(new Thread("MessageLoopPostPerfTest producer"));
+      producers.back()->Start();
+      producers.back()->message_loop_proxy()->PostTask(
+          FROM_HERE,
+          Bind(&MessageLoopPostPerfTest::ProducerRun,
+               Unretained(this),
+               loop.message_loop_proxy(),
+               &start_event,
+               &post_times[i]));
+    }
+
+    TimeTicks start = TimeTicks::HighResNow();
+    start_event.Signal();
+    // CountTask() quits the loop once every post has been consumed.
+    loop.Run();
+    TimeDelta wall_time = TimeTicks::HighResNow() - start;
+
+    // Join the producers before reading their posting times.
+    producers.clear();
+
+    TimeDelta posting_time;
+    for (int i = 0; i < num_producers; i++)
+      posting_time += post_times[i];
+
+    // End-to-end consumption rate, and the average cost of one PostTask()
+    // call summed across the producer threads.
+    perf_test::PrintResult("post_rate", "", name,
+                           total_tasks_ / wall_time.InSecondsF(), "posts/s",
+                           true);
+    perf_test::PrintResult("post_cost", "", name,
+                           posting_time.InMicroseconds() * 1000.0 /
+                               total_tasks_,
+                           "ns/post", true);
+  }
+
+  void ProducerRun(scoped_refptr<MessageLoopProxy> consumer,
+                   WaitableEvent* start_event,
+                   TimeDelta* post_time) {
+    // Bind the counting task once up front so the loop below measures the
+    // posting path rather than closure creation.
+    Closure task =
+        Bind(&MessageLoopPostPerfTest::CountTask, Unretained(this));
+    start_event->Wait();
+    TimeTicks start = TimeTicks::HighResNow();
+    for (int i = 0; i < kNumPostsPerProducer; i++)
+      consumer->PostTask(FROM_HERE, task);
+    *post_time = TimeTicks::HighResNow() - start;
+  }
+
+  void CountTask() {
+    if (++num_tasks_run_ == total_tasks_)
+      MessageLoop::current()->QuitWhenIdle();
+  }
+
+ private:
+  // Only touched from the consumer thread.
+  int num_tasks_run_;
+  int total_tasks_;
+};
+
+TEST_F(MessageLoopPostPerfTest, PostTaskRate) {
+  RunPostThroughputTest("1_Producer_Threads", 1);
+  RunPostThroughputTest("4_Producer_Threads", 4);
+}
+
+}  // namespace
+
+}  // namespace base
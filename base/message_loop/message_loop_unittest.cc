@@ -933,6 +933,52 @@ TEST(MessageLoopTest, IsType) {
   EXPECT_FALSE(loop.IsType(MessageLoop::TYPE_DEFAULT));
 }
 
+namespace {
+
+void RecordRunTicksFunc(TimeTicks* run_time, int* task_counter) {
+  *run_time = TimeTicks::Now();
+  if (--(*task_counter) == 0)
+    MessageLoop::current()->QuitWhenIdle();
+}
+
+}  // namespace
+
+TEST(MessageLoopTest, DelayedTaskCoalescing) {
+  MessageLoop loop;
+  const TimeDelta kInterval = TimeDelta::FromMilliseconds(200);
+  loop.SetDelayedTaskCoalescingInterval(kInterval);
+
+  // Aim both tasks at the middle of the same coalescing bucket so the test
+  // does not depend on where "now" happens to fall relative to a bucket
+  // boundary. A pause of more than ~50ms between here and the posts below
+  // (e.g. a context switch) could still push them into different buckets.
+  const int64 interval_us = kInterval.InMicroseconds();
+  int64 now_us = (TimeTicks::Now() - TimeTicks()).InMicroseconds();
+  int64 bucket_start_us = (now_us / interval_us + 1) * interval_us;
+  TimeDelta delay1 =
+      TimeDelta::FromMicroseconds(bucket_start_us - now_us) + kInterval / 2;
+  TimeDelta delay2 =
+      TimeDelta::FromMicroseconds(bucket_start_us - now_us) + kInterval / 4;
+
+  // Post the task with the longer delay first. Both delays align to the end
+  // of the same bucket, so the tasks must run in posting order even though
+  // the second one asked for an earlier run time, and neither may run before
+  // the delay it asked for.
+  int num_tasks = 2;
+  TimeTicks run_time1, run_time2;
+  TimeTicks time_before_run = TimeTicks::Now();
+  loop.PostDelayedTask(
+      FROM_HERE, Bind(&RecordRunTicksFunc, &run_time1, &num_tasks), delay1);
+  loop.PostDelayedTask(
+      FROM_HERE, Bind(&RecordRunTicksFunc, &run_time2, &num_tasks), delay2);
+  loop.Run();
+
+  EXPECT_EQ(0, num_tasks);
+  EXPECT_TRUE(run_time1 <= run_time2);
+  EXPECT_LE(delay1, run_time1 - time_before_run);
+  EXPECT_LE(delay2, run_time2 - time_before_run);
+}
+
 #if defined(OS_WIN)
 void EmptyFunction() {}
 
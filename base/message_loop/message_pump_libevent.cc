@@ -41,6 +41,11 @@
 
 namespace base {
 
+// Upper bound for the adaptive task batch in Run(). Large enough to amortize
+// the cost of an empty libevent poll across a burst of cheap tasks, small
+// enough that newly ready I/O never waits behind more than a handful of them.
+static const int kMaxTaskBatchSize = 8;
+
 // Return 0 on success
 // Too small a function to bother putting in a library?
 static int SetNonBlocking(int fd) {
@@ -112,6 +117,7 @@ MessagePumpLibevent::MessagePumpLibevent()
     : keep_running_(true),
       in_run_(false),
       processed_io_events_(false),
+      task_batch_size_(1),
       event_base_(event_base_new()),
       wakeup_pipe_in_(-1),
       wakeup_pipe_out_(-1) {
@@ -229,12 +235,24 @@ void MessagePumpLibevent::Run(Delegate* delegate) {
     mac::ScopedNSAutoreleasePool autorelease_pool;
 #endif
 
-    bool did_work = delegate->DoWork();
+    bool did_work = false;
+    for (int i = 0; i < task_batch_size_ && keep_running_; ++i) {
+      if (!delegate->DoWork())
+        break;
+      did_work = true;
+    }
     if (!keep_running_)
       break;
 
     event_base_loop(event_base_, EVLOOP_NONBLOCK);
     did_work |= processed_io_events_;
+    // Adapt the batch size. While polls keep coming back empty, spend more of
+    // each iteration draining queued tasks; once I/O is seen, fall back to
+    // polling after every task so that I/O is serviced promptly.
+    if (processed_io_events_)
+      task_batch_size_ = 1;
+    else if (task_batch_size_ < kMaxTaskBatchSize)
+      ++task_batch_size_;
     processed_io_events_ = false;
     if (!keep_running_)
       break;
@@ -153,6 +153,12 @@ class BASE_EXPORT MessagePumpLibevent : public MessagePump {
   // This flag is set if libevent has processed I/O events.
   bool processed_io_events_;
 
+  // Number of tasks Run() may execute between polls of libevent. Grows while
+  // polling keeps finding no I/O ready and resets to one as soon as I/O is
+  // processed, so queued tasks do not pay one poll syscall each while I/O
+  // latency stays low under load.
+  int task_batch_size_;
+
   // The time at which we should call DoDelayedWork.
   TimeTicks delayed_work_time_;
 
@@ -336,11 +336,36 @@ FieldTrial* FieldTrialList::FactoryGetFieldTrialWithRandomizationSeed(
   return field_trial;
 }
 
+// static
+void FieldTrialList::SetTrialResolver(const TrialResolver& resolver) {
+  if (!global_)
+    return;
+  AutoLock auto_lock(global_->lock_);
+  global_->trial_resolver_ = resolver;
+}
+
 // static
 FieldTrial* FieldTrialList::Find(const std::string& name) {
   if (!global_)
     return NULL;
+  TrialResolver resolver;
+  {
+    AutoLock auto_lock(global_->lock_);
+    FieldTrial* field_trial = global_->PreLockedFind(name);
+    if (field_trial)
+      return field_trial;
+    if (global_->trial_resolver_.is_null() ||
+        global_->resolving_trials_.count(name)) {
+      return NULL;
+    }
+    global_->resolving_trials_.insert(name);
+    resolver = global_->trial_resolver_;
+  }
+  // The resolver registers the trial, if it knows about it, through the
+  // regular factory methods, which acquire |lock_| themselves.
+  resolver.Run(name);
   AutoLock auto_lock(global_->lock_);
+  global_->resolving_trials_.erase(name);
   return global_->PreLockedFind(name);
 }
 
@@ -60,6 +60,7 @@
 #include <vector>
 
 #include "base/base_export.h"
+#include "base/callback.h"
 #include "base/gtest_prod_util.h"
 #include "base/memory/ref_counted.h"
 #include "base/observer_list_threadsafe.h"
@@ -374,6 +375,21 @@ class BASE_EXPORT FieldTrialList {
       uint32 randomization_seed,
       int* default_group_number);
 
+  // Callback that is given a chance to register a trial the first time an
+  // unregistered trial name is looked up. See SetTrialResolver().
+  typedef base::Callback<void(const std::string& trial_name)> TrialResolver;
+
+  // Sets a resolver that is invoked the first time Find() (or any of the
+  // lookup methods built on it) misses for a trial name. This allows trials
+  // whose definitions come from an external source (e.g. the variations
+  // seed) to be registered lazily on first query instead of eagerly at
+  // startup. The resolver is invoked without any locks held and should
+  // register the trial through the regular factory methods, after which the
+  // lookup is retried. While a name is being resolved, lookups of that name
+  // from other threads return NULL as if the trial did not exist. Pass a
+  // null callback to remove the resolver.
+  static void SetTrialResolver(const TrialResolver& resolver);
+
   // The Find() method can be used to test to see if a named Trial was already
   // registered, or to retrieve a pointer to it from the global map.
   static FieldTrial* Find(const std::string& name);
@@ -472,6 +488,13 @@ class BASE_EXPORT FieldTrialList {
   base::Lock lock_;
   RegistrationMap registered_;
 
+  // Resolver invoked on lookup misses, if set. See SetTrialResolver().
+  TrialResolver trial_resolver_;
+
+  // Names that are currently being resolved. Guards against the resolver
+  // re-entering Find() for the same name while it registers the trial.
+  std::set<std::string> resolving_trials_;
+
   // Entropy provider to be used for one-time randomized field trials. If NULL,
   // one-time randomization is not supported.
   scoped_ptr<const FieldTrial::EntropyProvider> entropy_provider_;
@@ -4,6 +4,7 @@
 
 #include "base/metrics/field_trial.h"
 
+#include "base/bind.h"
 #include "base/message_loop/message_loop.h"
 #include "base/rand_util.h"
 #include "base/run_loop.h"
@@ -37,6 +38,17 @@ int GetLastYear() {
   return exploded.year;
 }
 
+// Number of times the trial resolver installed by the TrialResolver test
+// has been invoked.
+int g_resolver_call_count = 0;
+
+// Trial resolver that registers the trial "LazyTrial" on demand.
+void ResolverThatCreatesLazyTrial(const std::string& trial_name) {
+  ++g_resolver_call_count;
+  if (trial_name == "LazyTrial")
+    FieldTrialList::CreateFieldTrial("LazyTrial", "Winner");
+}
+
 // FieldTrialList::Observer implementation for testing.
 class TestFieldTrialObserver : public FieldTrialList::Observer {
  public:
@@ -972,4 +984,28 @@ TEST_F(FieldTrialTest, CreateSimulatedFieldTrial) {
   }
 }
 
+TEST_F(FieldTrialTest, TrialResolver) {
+  g_resolver_call_count = 0;
+  FieldTrialList::SetTrialResolver(Bind(&ResolverThatCreatesLazyTrial));
+
+  // The resolver materializes known trials on first lookup. Note that the
+  // resolver itself calls CreateFieldTrial(), whose internal lookup must not
+  // re-enter the resolver.
+  EXPECT_EQ("Winner", FieldTrialList::FindFullName("LazyTrial"));
+  EXPECT_EQ(1, g_resolver_call_count);
+
+  // Once registered, the trial is found without consulting the resolver.
+  EXPECT_EQ("Winner", FieldTrialList::FindFullName("LazyTrial"));
+  EXPECT_EQ(1, g_resolver_call_count);
+
+  // Unknown names still miss, and each lookup asks the resolver again.
+  EXPECT_EQ(std::string(), FieldTrialList::FindFullName("UnknownTrial"));
+  EXPECT_EQ(2, g_resolver_call_count);
+
+  // A null callback removes the resolver.
+  FieldTrialList::SetTrialResolver(FieldTrialList::TrialResolver());
+  EXPECT_EQ(std::string(), FieldTrialList::FindFullName("OtherTrial"));
+  EXPECT_EQ(2, g_resolver_call_count);
+}
+
 }  // namespace base
@@ -6,6 +6,7 @@
 
 #include "base/logging.h"
 #include "base/metrics/bucket_ranges.h"
+#include "base/threading/platform_thread.h"
 
 using std::vector;
 
@@ -48,11 +49,65 @@ Count SampleVector::GetCountAtIndex(size_t bucket_index) const {
   return subtle::NoBarrier_Load(&counts_[bucket_index]);
 }
 
+void SampleVector::AddCountAtIndex(size_t bucket_index, Count count) {
+  DCHECK(bucket_index < counts_.size());
+  subtle::NoBarrier_AtomicIncrement(&counts_[bucket_index], count);
+}
+
 scoped_ptr<SampleCountIterator> SampleVector::Iterator() const {
   return scoped_ptr<SampleCountIterator>(
       new SampleVectorIterator(&counts_, bucket_ranges_));
 }
 
+ShardedSampleVector::ShardedSampleVector(const BucketRanges* bucket_ranges)
+    : SampleVector(bucket_ranges) {
+  for (size_t i = 0; i < kShardCount; ++i)
+    shards_[i].resize(bucket_ranges->bucket_count());
+}
+
+ShardedSampleVector::~ShardedSampleVector() {}
+
+void ShardedSampleVector::Accumulate(Sample value, Count count) {
+  size_t bucket_index = GetBucketIndex(value);
+  size_t shard = static_cast<size_t>(PlatformThread::CurrentId()) &
+                 (kShardCount - 1);
+  subtle::NoBarrier_AtomicIncrement(&shards_[shard][bucket_index], count);
+  IncreaseSum(count * value);
+  IncreaseRedundantCount(count);
+}
+
+Count ShardedSampleVector::GetCount(Sample value) const {
+  FoldShards();
+  return SampleVector::GetCount(value);
+}
+
+Count ShardedSampleVector::GetCountAtIndex(size_t bucket_index) const {
+  FoldShards();
+  return SampleVector::GetCountAtIndex(bucket_index);
+}
+
+Count ShardedSampleVector::TotalCount() const {
+  FoldShards();
+  return SampleVector::TotalCount();
+}
+
+scoped_ptr<SampleCountIterator> ShardedSampleVector::Iterator() const {
+  FoldShards();
+  return SampleVector::Iterator();
+}
+
+void ShardedSampleVector::FoldShards() const {
+  ShardedSampleVector* self = const_cast<ShardedSampleVector*>(this);
+  for (size_t shard = 0; shard < kShardCount; ++shard) {
+    for (size_t i = 0; i < self->shards_[shard].size(); ++i) {
+      Count count = subtle::NoBarrier_AtomicExchange(&self->shards_[shard][i],
+                                                     0);
+      if (count)
+        self->AddCountAtIndex(i, count);
+    }
+  }
+}
+
 bool SampleVector::AddSubtractImpl(SampleCountIterator* iter,
                                    HistogramSamples::Operator op) {
   HistogramBase::Sample min;
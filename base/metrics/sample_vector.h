@@ -34,9 +34,13 @@ class BASE_EXPORT_PRIVATE SampleVector : public HistogramSamples {
   virtual scoped_ptr<SampleCountIterator> Iterator() const OVERRIDE;
 
   // Get count of a specific bucket.
-  HistogramBase::Count GetCountAtIndex(size_t bucket_index) const;
+  virtual HistogramBase::Count GetCountAtIndex(size_t bucket_index) const;
 
  protected:
+  // Adds |count| directly to the bucket at |bucket_index|. Used by
+  // ShardedSampleVector to fold shard counters into the main vector.
+  void AddCountAtIndex(size_t bucket_index, HistogramBase::Count count);
+
   virtual bool AddSubtractImpl(
       SampleCountIterator* iter,
       HistogramSamples::Operator op) OVERRIDE;  // |op| is ADD or SUBTRACT.
@@ -54,6 +58,45 @@ class BASE_EXPORT_PRIVATE SampleVector : public HistogramSamples {
   DISALLOW_COPY_AND_ASSIGN(SampleVector);
 };
 
+// A SampleVector variant that spreads recording across several shards so
+// concurrent Accumulate() calls on different threads do not contend on the
+// same cache lines. Shards are folded into the main vector lazily, whenever
+// the samples are read (snapshot, iteration, count queries), so steady-state
+// recording is a single uncontended atomic increment. Intended for the
+// handful of very hot histograms recorded from performance-critical threads;
+// it costs kShardCount extra count vectors per histogram.
+class BASE_EXPORT_PRIVATE ShardedSampleVector : public SampleVector {
+ public:
+  explicit ShardedSampleVector(const BucketRanges* bucket_ranges);
+  virtual ~ShardedSampleVector();
+
+  // HistogramSamples implementation:
+  virtual void Accumulate(HistogramBase::Sample value,
+                          HistogramBase::Count count) OVERRIDE;
+  virtual HistogramBase::Count GetCount(
+      HistogramBase::Sample value) const OVERRIDE;
+  virtual HistogramBase::Count TotalCount() const OVERRIDE;
+  virtual scoped_ptr<SampleCountIterator> Iterator() const OVERRIDE;
+
+  // SampleVector:
+  virtual HistogramBase::Count GetCountAtIndex(
+      size_t bucket_index) const OVERRIDE;
+
+ private:
+  // Enough shards that threads on a many-core machine rarely collide; each
+  // shard vector is a separate heap allocation, so shards do not share
+  // cache lines.
+  static const size_t kShardCount = 8;  // Must be a power of two.
+
+  // Drains every shard bucket into the main vector with an atomic exchange.
+  // Logically const: folding does not change the observable totals.
+  void FoldShards() const;
+
+  std::vector<HistogramBase::AtomicCount> shards_[kShardCount];
+
+  DISALLOW_COPY_AND_ASSIGN(ShardedSampleVector);
+};
+
 class BASE_EXPORT_PRIVATE SampleVectorIterator : public SampleCountIterator {
  public:
   SampleVectorIterator(const std::vector<HistogramBase::AtomicCount>* counts,
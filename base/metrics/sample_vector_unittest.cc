@@ -261,5 +261,36 @@ TEST(SampleVectorIteratorDeathTest, IterateDoneTest) {
 #endif
 // (!defined(NDEBUG) || defined(DCHECK_ALWAYS_ON)) && GTEST_HAS_DEATH_TEST
 
+TEST(ShardedSampleVectorTest, AccumulateAndFold) {
+  // Custom buckets: [1, 5) [5, 10)
+  BucketRanges ranges(3);
+  ranges.set_range(0, 1);
+  ranges.set_range(1, 5);
+  ranges.set_range(2, 10);
+  ShardedSampleVector samples(&ranges);
+
+  samples.Accumulate(1, 200);
+  samples.Accumulate(2, -300);
+  samples.Accumulate(5, 200);
+
+  // Reads fold the shards lazily and see the merged totals.
+  EXPECT_EQ(-100, samples.GetCountAtIndex(0));
+  EXPECT_EQ(200, samples.GetCountAtIndex(1));
+  EXPECT_EQ(100, samples.TotalCount());
+  EXPECT_EQ(samples.redundant_count(), samples.TotalCount());
+
+  // Folding is idempotent.
+  EXPECT_EQ(100, samples.TotalCount());
+
+  scoped_ptr<SampleCountIterator> it = samples.Iterator();
+  HistogramBase::Sample min;
+  HistogramBase::Sample max;
+  HistogramBase::Count count;
+  it->Get(&min, &max, &count);
+  EXPECT_EQ(1, min);
+  EXPECT_EQ(5, max);
+  EXPECT_EQ(-100, count);
+}
+
 }  // namespace
 }  // namespace base
@@ -0,0 +1,54 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/metrics/sharded_counter.h"
+
+#include <string.h>
+
+#include "base/lazy_instance.h"
+#include "base/threading/thread_local.h"
+
+namespace base {
+
+namespace {
+
+// Stores each thread's shard index, biased by one so that NULL means
+// "not yet assigned". The mapping is global: a thread uses the same shard
+// index in every ShardedCounter.
+LazyInstance<ThreadLocalPointer<void> >::Leaky g_thread_shard =
+    LAZY_INSTANCE_INITIALIZER;
+
+subtle::Atomic32 g_next_shard = 0;
+
+}  // namespace
+
+ShardedCounter::ShardedCounter() {
+  memset(shards_, 0, sizeof(shards_));
+}
+
+void ShardedCounter::Add(int32 delta) {
+  subtle::NoBarrier_AtomicIncrement(&shards_[CurrentThreadShard()].value,
+                                    delta);
+}
+
+int64 ShardedCounter::Get() const {
+  int64 sum = 0;
+  for (int i = 0; i < kShardCount; ++i)
+    sum += subtle::NoBarrier_Load(&shards_[i].value);
+  return sum;
+}
+
+// static
+int ShardedCounter::CurrentThreadShard() {
+  void* value = g_thread_shard.Get().Get();
+  if (!value) {
+    int shard = (subtle::NoBarrier_AtomicIncrement(&g_next_shard, 1) - 1) &
+                (kShardCount - 1);
+    value = reinterpret_cast<void*>(static_cast<intptr_t>(shard + 1));
+    g_thread_shard.Get().Set(value);
+  }
+  return static_cast<int>(reinterpret_cast<intptr_t>(value)) - 1;
+}
+
+}  // namespace base
@@ -0,0 +1,60 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_METRICS_SHARDED_COUNTER_H_
+#define BASE_METRICS_SHARDED_COUNTER_H_
+
+#include "base/atomicops.h"
+#include "base/base_export.h"
+#include "base/basictypes.h"
+
+namespace base {
+
+// ShardedCounter is a counter designed for always-on monitoring of hot paths:
+// it may be incremented concurrently from many threads with no locking and,
+// unlike a single shared atomic, without bouncing one cache line between the
+// cores doing the counting. Each update goes to one of a fixed number of
+// cache-line-padded shards selected by the calling thread; reading sums the
+// shards. Use it for counters that are updated far more often than they are
+// read. Reads and updates may race, so Get() is a point-in-time approximation
+// while updates are in flight, and values may transiently appear torn only in
+// the sense of missing the most recent updates, never corrupted.
+class BASE_EXPORT ShardedCounter {
+ public:
+  ShardedCounter();
+
+  // Adds |delta| (which may be negative) to the counter.
+  void Add(int32 delta);
+
+  void Increment() { Add(1); }
+  void Decrement() { Add(-1); }
+
+  // Returns the sum of all shards.
+  int64 Get() const;
+
+ private:
+  // Power of two so the shard index is a mask away. 16 shards keeps the
+  // object small (one KB) while making it unlikely that two busy threads
+  // share a shard.
+  static const int kShardCount = 16;
+
+  struct Shard {
+    subtle::Atomic32 value;
+    // Pad to a cache line so neighbouring shards never share one.
+    char padding[64 - sizeof(subtle::Atomic32)];
+  };
+
+  // Returns the shard index assigned to the calling thread. Threads are
+  // assigned shards round-robin on first use; the assignment is shared by
+  // all ShardedCounter instances.
+  static int CurrentThreadShard();
+
+  Shard shards_[kShardCount];
+
+  DISALLOW_COPY_AND_ASSIGN(ShardedCounter);
+};
+
+}  // namespace base
+
+#endif  // BASE_METRICS_SHARDED_COUNTER_H_
@@ -0,0 +1,63 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/metrics/sharded_counter.h"
+
+#include "base/memory/scoped_ptr.h"
+#include "base/threading/simple_thread.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+
+namespace {
+
+class CounterThread : public SimpleThread {
+ public:
+  CounterThread(ShardedCounter* counter, int iterations)
+      : SimpleThread("counter_thread"),
+        counter_(counter),
+        iterations_(iterations) {}
+
+  virtual void Run() OVERRIDE {
+    for (int i = 0; i < iterations_; ++i)
+      counter_->Increment();
+  }
+
+ private:
+  ShardedCounter* counter_;
+  int iterations_;
+};
+
+}  // namespace
+
+TEST(ShardedCounterTest, SingleThread) {
+  ShardedCounter counter;
+  EXPECT_EQ(0, counter.Get());
+
+  counter.Increment();
+  counter.Add(41);
+  EXPECT_EQ(42, counter.Get());
+
+  counter.Decrement();
+  counter.Add(-41);
+  EXPECT_EQ(0, counter.Get());
+}
+
+TEST(ShardedCounterTest, ManyThreads) {
+  const int kThreads = 8;
+  const int kIterations = 10000;
+
+  ShardedCounter counter;
+  scoped_ptr<CounterThread> threads[kThreads];
+  for (int i = 0; i < kThreads; ++i) {
+    threads[i].reset(new CounterThread(&counter, kIterations));
+    threads[i]->Start();
+  }
+  for (int i = 0; i < kThreads; ++i)
+    threads[i]->Join();
+
+  EXPECT_EQ(static_cast<int64>(kThreads) * kIterations, counter.Get());
+}
+
+}  // namespace base
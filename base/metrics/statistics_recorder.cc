@@ -5,7 +5,9 @@
 #include "base/metrics/statistics_recorder.h"
 
 #include "base/at_exit.h"
+#include "base/atomicops.h"
 #include "base/debug/leak_annotations.h"
+#include "base/hash.h"
 #include "base/json/string_escape.h"
 #include "base/logging.h"
 #include "base/memory/scoped_ptr.h"
@@ -33,6 +35,41 @@ void StatisticsRecorder::Initialize() {
 
 
 // static
+namespace {
+
+// A small lock-free cache in front of the |histograms_| map. Slots hold
+// pointers to registered histograms, which are intentionally leaked for the
+// life of the process, so readers can dereference a published pointer
+// without holding |lock_|. A hash collision just overwrites the slot; the
+// locked map remains the source of truth.
+const size_t kHistogramCacheSize = 512;  // Must be a power of two.
+subtle::AtomicWord g_histogram_name_cache[kHistogramCacheSize] = {0};
+
+size_t HistogramCacheSlot(const std::string& name) {
+  return Hash(name) & (kHistogramCacheSize - 1);
+}
+
+HistogramBase* CachedHistogramLookup(const std::string& name) {
+  HistogramBase* histogram = reinterpret_cast<HistogramBase*>(
+      subtle::Acquire_Load(&g_histogram_name_cache[HistogramCacheSlot(name)]));
+  if (histogram && histogram->histogram_name() == name)
+    return histogram;
+  return NULL;
+}
+
+void PublishHistogramToCache(HistogramBase* histogram) {
+  subtle::Release_Store(
+      &g_histogram_name_cache[HistogramCacheSlot(histogram->histogram_name())],
+      reinterpret_cast<subtle::AtomicWord>(histogram));
+}
+
+void ClearHistogramCache() {
+  for (size_t i = 0; i < kHistogramCacheSize; ++i)
+    subtle::NoBarrier_Store(&g_histogram_name_cache[i], 0);
+}
+
+}  // namespace
+
 bool StatisticsRecorder::IsActive() {
   if (lock_ == NULL)
     return false;
@@ -65,6 +102,7 @@ HistogramBase* StatisticsRecorder::RegisterOrDeleteDuplicate(
       if (histograms_->end() == it) {
         (*histograms_)[name] = histogram;
         ANNOTATE_LEAKING_OBJECT_PTR(histogram);  // see crbug.com/79322
+        PublishHistogramToCache(histogram);
         histogram_to_return = histogram;
       } else if (histogram == it->second) {
         // The histogram was registered before.
@@ -236,6 +274,13 @@ void StatisticsRecorder::GetBucketRanges(
 HistogramBase* StatisticsRecorder::FindHistogram(const std::string& name) {
   if (lock_ == NULL)
     return NULL;
+
+  // Fast path: repeated lookups of hot histograms (e.g. through code that
+  // does not cache the pointer itself) are answered without the lock.
+  HistogramBase* histogram = CachedHistogramLookup(name);
+  if (histogram)
+    return histogram;
+
   base::AutoLock auto_lock(*lock_);
   if (histograms_ == NULL)
     return NULL;
@@ -243,6 +288,7 @@ HistogramBase* StatisticsRecorder::FindHistogram(const std::string& name) {
   HistogramMap::iterator it = histograms_->find(name);
   if (histograms_->end() == it)
     return NULL;
+  PublishHistogramToCache(it->second);
   return it->second;
 }
 
@@ -309,6 +355,9 @@ StatisticsRecorder::~StatisticsRecorder() {
     ranges_deleter.reset(ranges_);
     histograms_ = NULL;
     ranges_ = NULL;
+    // The cached pointers stay valid (histograms leak), but must not leak
+    // into a recorder created later, e.g. across tests.
+    ClearHistogramCache();
   }
   // We are going to leak the histograms and the ranges.
 }
@@ -0,0 +1,75 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/observer_list.h"
+
+#include <vector>
+
+#include "base/compiler_specific.h"
+#include "base/observer_list_read_mostly.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace base {
+namespace {
+
+const int kNumObservers = 100;
+const int kNumNotifications = 100000;
+
+class Observer {
+ public:
+  virtual void Observe(int x) = 0;
+  virtual ~Observer() {}
+};
+
+class CountingObserver : public Observer {
+ public:
+  CountingObserver() : total(0) {}
+  virtual ~CountingObserver() {}
+  virtual void Observe(int x) OVERRIDE { total += x; }
+
+  int total;
+};
+
+double NotifiesPerSecond(TimeDelta elapsed) {
+  return kNumNotifications / elapsed.InSecondsF();
+}
+
+TEST(ObserverListPerfTest, NotifyThroughput) {
+  std::vector<CountingObserver> observers(kNumObservers);
+
+  ObserverList<Observer> observer_list;
+  for (int i = 0; i < kNumObservers; ++i)
+    observer_list.AddObserver(&observers[i]);
+
+  TimeTicks start = TimeTicks::HighResNow();
+  for (int i = 0; i < kNumNotifications; ++i)
+    FOR_EACH_OBSERVER(Observer, observer_list, Observe(1));
+  TimeDelta elapsed = TimeTicks::HighResNow() - start;
+
+  EXPECT_EQ(kNumNotifications, observers[0].total);
+  perf_test::PrintResult("observer_list", "", "100_observers",
+                         NotifiesPerSecond(elapsed), "notifies/s", true);
+}
+
+TEST(ObserverListPerfTest, ReadMostlyNotifyThroughput) {
+  std::vector<CountingObserver> observers(kNumObservers);
+
+  ObserverListReadMostly<Observer> observer_list;
+  for (int i = 0; i < kNumObservers; ++i)
+    observer_list.AddObserver(&observers[i]);
+
+  TimeTicks start = TimeTicks::HighResNow();
+  for (int i = 0; i < kNumNotifications; ++i)
+    FOR_EACH_READ_MOSTLY_OBSERVER(Observer, observer_list, Observe(1));
+  TimeDelta elapsed = TimeTicks::HighResNow() - start;
+
+  EXPECT_EQ(kNumNotifications, observers[0].total);
+  perf_test::PrintResult("observer_list_read_mostly", "", "100_observers",
+                         NotifiesPerSecond(elapsed), "notifies/s", true);
+}
+
+}  // namespace
+}  // namespace base
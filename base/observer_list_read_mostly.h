@@ -0,0 +1,169 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_OBSERVER_LIST_READ_MOSTLY_H_
+#define BASE_OBSERVER_LIST_READ_MOSTLY_H_
+
+#include <algorithm>
+#include <vector>
+
+#include "base/basictypes.h"
+#include "base/logging.h"
+#include "base/memory/ref_counted.h"
+#include "base/synchronization/lock.h"
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// OVERVIEW:
+//
+//   A read-mostly companion to ObserverList for high-frequency notifiers.
+//   The observers live in an immutable, reference-counted snapshot array.
+//   A notifying thread takes the lock just long enough to grab a reference
+//   to the current snapshot and then iterates one contiguous allocation with
+//   no lock held. Mutators copy the array and swap in the new snapshot, so
+//   adds and removes are linear in the number of observers but neither block
+//   nor get blocked by notifications already in flight.
+//
+//   Unlike ObserverListThreadSafe, notifications run synchronously on the
+//   calling thread, whichever thread that is.
+//
+//   Differences from ObserverList to be aware of:
+//    * A notification pass only sees observers present when it started;
+//      observers added during the pass are not notified by it.
+//    * Removing an observer does not cancel its notification in passes that
+//      have already begun (on this or any other thread), so an observer can
+//      be notified once more after RemoveObserver() returns. Observers must
+//      tolerate such calls, or the caller must sequence removals with its
+//      notifications.
+//
+// TYPICAL USAGE:
+//
+//   Mirrors ObserverList, with FOR_EACH_READ_MOSTLY_OBSERVER for sending
+//   out notifications.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+template <class ObserverType>
+class ObserverListReadMostly {
+ private:
+  // The immutable snapshot shared between the list and any iterators that
+  // are currently walking it.
+  struct Snapshot : public base::RefCountedThreadSafe<Snapshot> {
+    Snapshot() {}
+
+    std::vector<ObserverType*> observers;
+
+   private:
+    friend class base::RefCountedThreadSafe<Snapshot>;
+    ~Snapshot() {}
+
+    DISALLOW_COPY_AND_ASSIGN(Snapshot);
+  };
+
+ public:
+  // An iterator class that can be used to access the list of observers. See
+  // also the FOR_EACH_READ_MOSTLY_OBSERVER macro defined below. Holds a
+  // reference to the snapshot that was current when it was constructed.
+  class Iterator {
+   public:
+    explicit Iterator(const ObserverListReadMostly<ObserverType>& list)
+        : snapshot_(list.GetSnapshot()),
+          index_(0) {
+    }
+
+    ObserverType* GetNext() {
+      if (!snapshot_.get() || index_ >= snapshot_->observers.size())
+        return NULL;
+      return snapshot_->observers[index_++];
+    }
+
+   private:
+    scoped_refptr<const Snapshot> snapshot_;
+    size_t index_;
+  };
+
+  ObserverListReadMostly() {}
+
+  // Add an observer to the list.  An observer should not be added to
+  // the same list more than once.
+  void AddObserver(ObserverType* obs) {
+    base::AutoLock lock(lock_);
+    if (snapshot_.get() &&
+        std::find(snapshot_->observers.begin(), snapshot_->observers.end(),
+                  obs) != snapshot_->observers.end()) {
+      NOTREACHED() << "Observers can only be added once!";
+      return;
+    }
+    scoped_refptr<Snapshot> copy(new Snapshot);
+    if (snapshot_.get())
+      copy->observers = snapshot_->observers;
+    copy->observers.push_back(obs);
+    snapshot_ = copy;
+  }
+
+  // Remove an observer from the list if it is in the list. See the note
+  // above about notification passes that are already in flight.
+  void RemoveObserver(ObserverType* obs) {
+    base::AutoLock lock(lock_);
+    if (!snapshot_.get())
+      return;
+    typename std::vector<ObserverType*>::iterator it =
+        std::find(snapshot_->observers.begin(), snapshot_->observers.end(),
+                  obs);
+    if (it == snapshot_->observers.end())
+      return;
+    scoped_refptr<Snapshot> copy(new Snapshot);
+    copy->observers.reserve(snapshot_->observers.size() - 1);
+    copy->observers.insert(copy->observers.end(),
+                           snapshot_->observers.begin(), it);
+    copy->observers.insert(copy->observers.end(),
+                           it + 1, snapshot_->observers.end());
+    snapshot_ = copy;
+  }
+
+  bool HasObserver(ObserverType* observer) const {
+    scoped_refptr<const Snapshot> snapshot = GetSnapshot();
+    if (!snapshot.get())
+      return false;
+    return std::find(snapshot->observers.begin(), snapshot->observers.end(),
+                     observer) != snapshot->observers.end();
+  }
+
+  void Clear() {
+    base::AutoLock lock(lock_);
+    snapshot_ = NULL;
+  }
+
+  bool might_have_observers() const {
+    base::AutoLock lock(lock_);
+    return snapshot_.get() && !snapshot_->observers.empty();
+  }
+
+ private:
+  friend class Iterator;
+
+  scoped_refptr<const Snapshot> GetSnapshot() const {
+    base::AutoLock lock(lock_);
+    return snapshot_;
+  }
+
+  // Guards |snapshot_|; never held while observers are being notified.
+  mutable base::Lock lock_;
+  scoped_refptr<Snapshot> snapshot_;
+
+  DISALLOW_COPY_AND_ASSIGN(ObserverListReadMostly);
+};
+
+#define FOR_EACH_READ_MOSTLY_OBSERVER(ObserverType, observer_list, func)   \
+  do {                                                                     \
+    if ((observer_list).might_have_observers()) {                          \
+      ObserverListReadMostly<ObserverType>::Iterator                       \
+          it_inside_observer_macro(observer_list);                         \
+      ObserverType* obs;                                                   \
+      while ((obs = it_inside_observer_macro.GetNext()) != NULL)           \
+        obs->func;                                                         \
+    }                                                                      \
+  } while (0)
+
+#endif  // BASE_OBSERVER_LIST_READ_MOSTLY_H_
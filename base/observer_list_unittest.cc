@@ -3,6 +3,7 @@
 // found in the LICENSE file.
 
 #include "base/observer_list.h"
+#include "base/observer_list_read_mostly.h"
 #include "base/observer_list_threadsafe.h"
 
 #include <vector>
@@ -545,5 +546,119 @@ TEST(ObserverListTest, IteratorOutlivesList) {
   // of scope.
 }
 
+class ReadMostlyDisrupter : public Foo {
+ public:
+  ReadMostlyDisrupter(ObserverListReadMostly<Foo>* list, Foo* doomed)
+      : list_(list),
+        doomed_(doomed) {
+  }
+  virtual ~ReadMostlyDisrupter() {}
+  virtual void Observe(int x) OVERRIDE {
+    list_->RemoveObserver(doomed_);
+  }
+
+ private:
+  ObserverListReadMostly<Foo>* list_;
+  Foo* doomed_;
+};
+
+TEST(ObserverListReadMostlyTest, BasicTest) {
+  ObserverListReadMostly<Foo> observer_list;
+  Adder a(1), b(-1), c(1), d(-1);
+
+  observer_list.AddObserver(&a);
+  observer_list.AddObserver(&b);
+
+  EXPECT_TRUE(observer_list.HasObserver(&a));
+  EXPECT_FALSE(observer_list.HasObserver(&c));
+
+  FOR_EACH_READ_MOSTLY_OBSERVER(Foo, observer_list, Observe(10));
+
+  observer_list.AddObserver(&c);
+  observer_list.AddObserver(&d);
+  observer_list.RemoveObserver(&c);
+
+  FOR_EACH_READ_MOSTLY_OBSERVER(Foo, observer_list, Observe(10));
+
+  EXPECT_EQ(20, a.total);
+  EXPECT_EQ(-20, b.total);
+  EXPECT_EQ(0, c.total);
+  EXPECT_EQ(-10, d.total);
+}
+
+TEST(ObserverListReadMostlyTest, ClearAndRemoveNonMember) {
+  ObserverListReadMostly<Foo> observer_list;
+  Adder a(1), b(1);
+
+  // Removing an observer that was never added should do nothing.
+  observer_list.RemoveObserver(&a);
+  EXPECT_FALSE(observer_list.might_have_observers());
+
+  observer_list.AddObserver(&a);
+  observer_list.AddObserver(&b);
+  EXPECT_TRUE(observer_list.might_have_observers());
+
+  observer_list.Clear();
+  EXPECT_FALSE(observer_list.might_have_observers());
+  FOR_EACH_READ_MOSTLY_OBSERVER(Foo, observer_list, Observe(10));
+
+  EXPECT_EQ(0, a.total);
+  EXPECT_EQ(0, b.total);
+}
+
+TEST(ObserverListReadMostlyTest, RemoveDoesNotAffectPassInFlight) {
+  ObserverListReadMostly<Foo> observer_list;
+  Adder a(1), b(1);
+  ReadMostlyDisrupter disrupter(&observer_list, &b);
+
+  observer_list.AddObserver(&a);
+  observer_list.AddObserver(&disrupter);
+  observer_list.AddObserver(&b);
+
+  // The pass iterates the snapshot taken when it started, so |b| is still
+  // notified even though the disrupter removed it mid-pass. This is the
+  // documented difference from ObserverList.
+  FOR_EACH_READ_MOSTLY_OBSERVER(Foo, observer_list, Observe(10));
+  EXPECT_EQ(10, a.total);
+  EXPECT_EQ(10, b.total);
+
+  // The next pass sees the removal.
+  FOR_EACH_READ_MOSTLY_OBSERVER(Foo, observer_list, Observe(10));
+  EXPECT_EQ(20, a.total);
+  EXPECT_EQ(10, b.total);
+}
+
+TEST(ObserverListReadMostlyTest, AddDuringNotificationSeenNextPass) {
+  ObserverListReadMostly<Foo> observer_list;
+  AddInObserve<ObserverListReadMostly<Foo> > observer(&observer_list);
+
+  observer_list.AddObserver(&observer);
+
+  // The pass in which the observer adds |observer.adder| does not notify it.
+  FOR_EACH_READ_MOSTLY_OBSERVER(Foo, observer_list, Observe(10));
+  EXPECT_TRUE(observer.added);
+  EXPECT_EQ(0, observer.adder.total);
+
+  // The next pass does.
+  FOR_EACH_READ_MOSTLY_OBSERVER(Foo, observer_list, Observe(10));
+  EXPECT_EQ(10, observer.adder.total);
+}
+
+TEST(ObserverListReadMostlyTest, IteratorOutlivesList) {
+  ObserverListReadMostly<Foo>* observer_list =
+      new ObserverListReadMostly<Foo>;
+  Adder a(1);
+  observer_list->AddObserver(&a);
+
+  ObserverListReadMostly<Foo>::Iterator it(*observer_list);
+  delete observer_list;
+
+  // The iterator keeps the snapshot it started with alive.
+  Foo* obs;
+  while ((obs = it.GetNext()) != NULL)
+    obs->Observe(10);
+  EXPECT_EQ(10, a.total);
+}
+
 }  // namespace
 }  // namespace base
@@ -13,6 +13,7 @@
 #include "base/gtest_prod_util.h"
 #include "base/logging.h"
 #include "base/strings/string16.h"
+#include "base/strings/string_piece.h"
 
 class Pickle;
 
@@ -38,8 +39,12 @@ class BASE_EXPORT PickleIterator {
   bool ReadFloat(float* result) WARN_UNUSED_RESULT;
   bool ReadDouble(double* result) WARN_UNUSED_RESULT;
   bool ReadString(std::string* result) WARN_UNUSED_RESULT;
+  // The StringPiece data will only be valid for the lifetime of the message.
+  bool ReadStringPiece(base::StringPiece* result) WARN_UNUSED_RESULT;
   bool ReadWString(std::wstring* result) WARN_UNUSED_RESULT;
   bool ReadString16(base::string16* result) WARN_UNUSED_RESULT;
+  // The StringPiece16 data will only be valid for the lifetime of the message.
+  bool ReadStringPiece16(base::StringPiece16* result) WARN_UNUSED_RESULT;
   bool ReadData(const char** data, int* length) WARN_UNUSED_RESULT;
   bool ReadBytes(const char** data, int length) WARN_UNUSED_RESULT;
 
@@ -184,6 +189,10 @@ class BASE_EXPORT Pickle {
                   std::string* result) const WARN_UNUSED_RESULT {
     return iter->ReadString(result);
   }
+  bool ReadStringPiece(PickleIterator* iter,
+                       base::StringPiece* result) const WARN_UNUSED_RESULT {
+    return iter->ReadStringPiece(result);
+  }
   bool ReadWString(PickleIterator* iter,
                    std::wstring* result) const WARN_UNUSED_RESULT {
     return iter->ReadWString(result);
@@ -192,6 +201,11 @@ class BASE_EXPORT Pickle {
                     base::string16* result) const WARN_UNUSED_RESULT {
     return iter->ReadString16(result);
   }
+  bool ReadStringPiece16(PickleIterator* iter,
+                         base::StringPiece16* result) const
+      WARN_UNUSED_RESULT {
+    return iter->ReadStringPiece16(result);
+  }
   // A pointer to the data will be placed in *data, and the length will be
   // placed in *length. This buffer will be into the message's buffer so will
   // be scoped to the lifetime of the message (or until the message data is
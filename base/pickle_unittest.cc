@@ -8,6 +8,7 @@
 #include "base/memory/scoped_ptr.h"
 #include "base/pickle.h"
 #include "base/strings/string16.h"
+#include "base/strings/utf_string_conversions.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
 // Remove when this file is in the base namespace.
@@ -368,3 +369,23 @@ TEST(PickleTest, ReadBytes) {
   memcpy(&outdata, outdata_char, sizeof(outdata));
   EXPECT_EQ(data, outdata);
 }
+
+// Tests that zero-copy StringPiece reads alias the pickle's payload.
+TEST(PickleTest, ReadStringPiece) {
+  const string16 test16(base::ASCIIToUTF16("Hello world 16"));
+  Pickle pickle;
+  EXPECT_TRUE(pickle.WriteString(teststr));
+  EXPECT_TRUE(pickle.WriteString16(test16));
+
+  PickleIterator iter(pickle);
+  base::StringPiece piece;
+  EXPECT_TRUE(pickle.ReadStringPiece(&iter, &piece));
+  EXPECT_EQ(teststr, piece);
+  EXPECT_GE(piece.data(), static_cast<const char*>(pickle.data()));
+  EXPECT_LT(piece.data(),
+            static_cast<const char*>(pickle.data()) + pickle.size());
+
+  base::StringPiece16 piece16;
+  EXPECT_TRUE(pickle.ReadStringPiece16(&iter, &piece16));
+  EXPECT_EQ(test16, piece16.as_string());
+}
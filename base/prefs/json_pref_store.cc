@@ -15,7 +15,9 @@
 #include "base/memory/ref_counted.h"
 #include "base/message_loop/message_loop_proxy.h"
 #include "base/metrics/histogram.h"
+#include "base/pickle.h"
 #include "base/prefs/pref_filter.h"
+#include "base/prefs/pref_snapshot.h"
 #include "base/sequenced_task_runner.h"
 #include "base/strings/string_util.h"
 #include "base/threading/sequenced_worker_pool.h"
@@ -26,6 +28,33 @@ namespace {
 // Some extensions we'll tack on to copies of the Preferences files.
 const base::FilePath::CharType* kBadExtension = FILE_PATH_LITERAL("bad");
 
+// Extension of the side file that journals changes made since the last full
+// snapshot was written.
+const base::FilePath::CharType* kJournalExtension =
+    FILE_PATH_LITERAL("journal");
+
+// Number of journal records to accumulate before collapsing the journal into
+// a full snapshot. Bounds both the journal file size and the replay work at
+// load time, while keeping full serializations rare.
+const int kJournalRecordsPerSnapshot = 1024;
+
+base::FilePath JournalPath(const base::FilePath& path) {
+  return path.empty() ? path : path.ReplaceExtension(kJournalExtension);
+}
+
+// Appends a single journal record on the file task runner.
+void AppendToJournal(const base::FilePath& journal_path,
+                     const std::string& record) {
+  base::AppendToFile(journal_path, record.data(),
+                     static_cast<int>(record.size()));
+}
+
+// Deletes the journal on the file task runner, after a snapshot that
+// supersedes it has been handed to the writer.
+void DeleteJournal(const base::FilePath& journal_path) {
+  base::DeleteFile(journal_path, false);
+}
+
 // Differentiates file loading between origin thread and passed
 // (aka file) thread.
 class FileThreadDeserializer
@@ -78,11 +107,41 @@ class FileThreadDeserializer
       base::Move(alternate_path, path);
     }
 
-    int error_code;
+    // Try the binary snapshot format first; fall back to JSON for files
+    // written before the snapshot format existed. The JSON parse also
+    // classifies read errors (missing file, access denied, corruption).
+    int error_code = 0;
     std::string error_msg;
-    JSONFileValueSerializer serializer(path);
-    base::Value* value = serializer.Deserialize(&error_code, &error_msg);
+    base::Value* value = NULL;
+    std::string contents;
+    if (base::ReadFileToString(path, &contents))
+      value = PrefSnapshot::DeserializeSnapshot(contents);
+    if (!value) {
+      JSONFileValueSerializer serializer(path);
+      value = serializer.Deserialize(&error_code, &error_msg);
+    }
     HandleErrors(value, path, error_code, error_msg, error);
+
+    // Replay changes journaled since the last full write. This works no
+    // matter which format the base file was in.
+    std::string journal;
+    if (base::ReadFileToString(JournalPath(path), &journal) &&
+        !journal.empty()) {
+      if (!value && *error == PersistentPrefStore::PREF_READ_ERROR_NO_FILE) {
+        // All writes so far were journaled and no snapshot has been written
+        // yet; the journal alone holds the preferences.
+        value = new base::DictionaryValue;
+        *error = PersistentPrefStore::PREF_READ_ERROR_NONE;
+      }
+      if (value && value->IsType(base::Value::TYPE_DICTIONARY)) {
+        if (!PrefSnapshot::ReplayJournal(
+                journal, static_cast<base::DictionaryValue*>(value))) {
+          DVLOG(1) << "Corrupt record at end of preferences journal, ignored: "
+                   << JournalPath(path).value();
+        }
+      }
+    }
+
     *no_dir = !base::PathExists(path.DirName());
     return value;
   }
@@ -168,6 +227,7 @@ JsonPrefStore::JsonPrefStore(const base::FilePath& filename,
                              base::SequencedTaskRunner* sequenced_task_runner,
                              scoped_ptr<PrefFilter> pref_filter)
     : path_(filename),
+      journal_path_(JournalPath(filename)),
       sequenced_task_runner_(sequenced_task_runner),
       prefs_(new base::DictionaryValue()),
       read_only_(false),
@@ -175,7 +235,8 @@ JsonPrefStore::JsonPrefStore(const base::FilePath& filename,
       pref_filter_(pref_filter.Pass()),
       initialized_(false),
       filtering_in_progress_(false),
-      read_error_(PREF_READ_ERROR_NONE) {
+      read_error_(PREF_READ_ERROR_NONE),
+      journal_records_since_snapshot_(0) {
 }
 
 JsonPrefStore::JsonPrefStore(const base::FilePath& filename,
@@ -184,6 +245,7 @@ JsonPrefStore::JsonPrefStore(const base::FilePath& filename,
                              scoped_ptr<PrefFilter> pref_filter)
     : path_(filename),
       alternate_path_(alternate_filename),
+      journal_path_(JournalPath(filename)),
       sequenced_task_runner_(sequenced_task_runner),
       prefs_(new base::DictionaryValue()),
       read_only_(false),
@@ -191,7 +253,8 @@ JsonPrefStore::JsonPrefStore(const base::FilePath& filename,
       pref_filter_(pref_filter.Pass()),
       initialized_(false),
       filtering_in_progress_(false),
-      read_error_(PREF_READ_ERROR_NONE) {
+      read_error_(PREF_READ_ERROR_NONE),
+      journal_records_since_snapshot_(0) {
 }
 
 bool JsonPrefStore::GetValue(const std::string& key,
@@ -246,7 +309,7 @@ void JsonPrefStore::SetValueSilently(const std::string& key,
   if (!old_value || !value->Equals(old_value)) {
     prefs_->Set(key, new_value.release());
     if (!read_only_)
-      writer_.ScheduleWrite(this);
+      ScheduleChangeWrite(key);
   }
 }
 
@@ -258,7 +321,7 @@ void JsonPrefStore::RemoveValue(const std::string& key) {
 void JsonPrefStore::RemoveValueSilently(const std::string& key) {
   prefs_->RemovePath(key, NULL);
   if (!read_only_)
-    writer_.ScheduleWrite(this);
+    ScheduleChangeWrite(key);
 }
 
 bool JsonPrefStore::ReadOnly() const {
@@ -314,7 +377,7 @@ void JsonPrefStore::ReportValueChanged(const std::string& key) {
   FOR_EACH_OBSERVER(PrefStore::Observer, observers_, OnPrefValueChanged(key));
 
   if (!read_only_)
-    writer_.ScheduleWrite(this);
+    ScheduleChangeWrite(key);
 }
 
 void JsonPrefStore::RegisterOnNextSuccessfulWriteCallback(
@@ -322,6 +385,12 @@ void JsonPrefStore::RegisterOnNextSuccessfulWriteCallback(
   writer_.RegisterOnNextSuccessfulWriteCallback(on_next_successful_write);
 }
 
+bool JsonPrefStore::SerializeJsonForDebugging(std::string* output) const {
+  JSONStringValueSerializer serializer(output);
+  serializer.set_pretty_print(true);
+  return serializer.Serialize(*prefs_);
+}
+
 void JsonPrefStore::OnFileRead(scoped_ptr<base::Value> value,
                                PersistentPrefStore::PrefReadError error,
                                bool no_dir) {
@@ -389,29 +458,35 @@ bool JsonPrefStore::SerializeData(std::string* output) {
   if (pref_filter_)
     pref_filter_->FilterSerializeData(prefs_.get());
 
-  JSONStringValueSerializer serializer(output);
-  serializer.set_pretty_print(true);
-  bool result = serializer.Serialize(*prefs_);
-
-  if (result) {
-    std::string spaceless_basename;
-    base::ReplaceChars(path_.BaseName().MaybeAsASCII(), " ", "_",
-                       &spaceless_basename);
-
-    // The histogram below is an expansion of the UMA_HISTOGRAM_COUNTS_10000
-    // macro adapted to allow for a dynamically suffixed histogram name.
-    // Note: The factory creates and owns the histogram.
-    base::HistogramBase* histogram =
-        base::LinearHistogram::FactoryGet(
-            "Settings.JsonDataSizeKilobytes." + spaceless_basename,
-            1,
-            10000,
-            50,
-            base::HistogramBase::kUmaTargetedHistogramFlag);
-    histogram->Add(static_cast<int>(output->size()) / 1024);
-  }
+  PrefSnapshot::SerializeSnapshot(*prefs_, output);
+
+  // The snapshot being serialized supersedes everything journaled so far.
+  // Posting the deletion before ImportantFileWriter posts the file write
+  // means records journaled from this point on survive, at the cost of a
+  // task-sized window where a crash drops the journal before the new
+  // snapshot lands; the same crash under the old scheme lost the entire
+  // pending serialization.
+  journal_records_since_snapshot_ = 0;
+  sequenced_task_runner_->PostTask(
+      FROM_HERE, base::Bind(&DeleteJournal, journal_path_));
+
+  std::string spaceless_basename;
+  base::ReplaceChars(path_.BaseName().MaybeAsASCII(), " ", "_",
+                     &spaceless_basename);
+
+  // The histogram below is an expansion of the UMA_HISTOGRAM_COUNTS_10000
+  // macro adapted to allow for a dynamically suffixed histogram name.
+  // Note: The factory creates and owns the histogram.
+  base::HistogramBase* histogram =
+      base::LinearHistogram::FactoryGet(
+          "Settings.JsonDataSizeKilobytes." + spaceless_basename,
+          1,
+          10000,
+          50,
+          base::HistogramBase::kUmaTargetedHistogramFlag);
+  histogram->Add(static_cast<int>(output->size()) / 1024);
 
-  return result;
+  return true;
 }
 
 void JsonPrefStore::FinalizeFileRead(bool initialization_successful,
@@ -442,3 +517,27 @@ void JsonPrefStore::FinalizeFileRead(bool initialization_successful,
 
   return;
 }
+
+void JsonPrefStore::ScheduleChangeWrite(const std::string& key) {
+  DCHECK(!read_only_);
+  if (path_.empty())
+    return;
+
+  std::string record;
+  const base::Value* value = NULL;
+  if (prefs_->Get(key, &value))
+    PrefSnapshot::AppendSetRecord(key, *value, &record);
+  else
+    PrefSnapshot::AppendRemoveRecord(key, &record);
+  sequenced_task_runner_->PostTask(
+      FROM_HERE, base::Bind(&AppendToJournal, journal_path_, record));
+
+  if (++journal_records_since_snapshot_ >= kJournalRecordsPerSnapshot)
+    ScheduleSnapshotWrite();
+}
+
+void JsonPrefStore::ScheduleSnapshotWrite() {
+  DCHECK(!read_only_);
+  journal_records_since_snapshot_ = 0;
+  writer_.ScheduleWrite(this);
+}
@@ -32,6 +32,10 @@ class Value;
 
 
 // A writable PrefStore implementation that is used for user preferences.
+// Despite the name, preferences are persisted as a binary snapshot plus an
+// incremental change journal (see base/prefs/pref_snapshot.h); files in the
+// legacy JSON format are still read, and are replaced by a snapshot on the
+// next full write.
 class BASE_PREFS_EXPORT JsonPrefStore
     : public PersistentPrefStore,
       public base::ImportantFileWriter::DataSerializer,
@@ -94,6 +98,11 @@ class BASE_PREFS_EXPORT JsonPrefStore
   void RegisterOnNextSuccessfulWriteCallback(
       const base::Closure& on_next_successful_write);
 
+  // Serializes the current preferences as pretty-printed JSON. The on-disk
+  // format is a binary snapshot (see base/prefs/pref_snapshot.h); this is
+  // provided only as a human-readable export for debugging.
+  bool SerializeJsonForDebugging(std::string* output) const;
+
   // This method is called after the JSON file has been read.  It then hands
   // |value| (or an empty dictionary in some read error cases) to the
   // |pref_filter| if one is set. It also gives a callback pointing at
@@ -126,8 +135,19 @@ class BASE_PREFS_EXPORT JsonPrefStore
                         scoped_ptr<base::DictionaryValue> prefs,
                         bool schedule_write);
 
+  // Records the change to the preference at |key| (which may have been set or
+  // removed) by appending a record to the journal file; every
+  // |kJournalRecordsPerSnapshot| records the journal is collapsed into a full
+  // snapshot instead. Must not be called when read-only.
+  void ScheduleChangeWrite(const std::string& key);
+
+  // Writes a full snapshot of the current preferences through |writer_| and
+  // resets the journal. Must not be called when read-only.
+  void ScheduleSnapshotWrite();
+
   const base::FilePath path_;
   const base::FilePath alternate_path_;
+  const base::FilePath journal_path_;
   const scoped_refptr<base::SequencedTaskRunner> sequenced_task_runner_;
 
   scoped_ptr<base::DictionaryValue> prefs_;
@@ -146,6 +166,9 @@ class BASE_PREFS_EXPORT JsonPrefStore
   bool filtering_in_progress_;
   PrefReadError read_error_;
 
+  // Number of journal records appended since the last full snapshot.
+  int journal_records_since_snapshot_;
+
   std::set<std::string> keys_need_empty_value_;
 
   DISALLOW_COPY_AND_ASSIGN(JsonPrefStore);
@@ -7,11 +7,13 @@
 #include "base/bind.h"
 #include "base/file_util.h"
 #include "base/files/scoped_temp_dir.h"
+#include "base/json/json_file_value_serializer.h"
 #include "base/memory/ref_counted.h"
 #include "base/memory/scoped_ptr.h"
 #include "base/message_loop/message_loop.h"
 #include "base/path_service.h"
 #include "base/prefs/pref_filter.h"
+#include "base/prefs/pref_snapshot.h"
 #include "base/run_loop.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/string_util.h"
@@ -217,12 +219,36 @@ void RunBasicJsonPrefStoreTest(JsonPrefStore* pref_store,
   base::StringToInt64(string_value, &value);
   EXPECT_EQ(214748364842LL, value);
 
-  // Serialize and compare to expected output.
+  // Flush and compare the persisted state (base file plus change journal)
+  // against the expected output. The base file may be either a binary
+  // snapshot or a legacy JSON file that has not been rewritten yet.
   ASSERT_TRUE(PathExists(golden_output_file));
   pref_store->CommitPendingWrite();
   RunLoop().RunUntilIdle();
-  EXPECT_TRUE(TextContentsEqual(golden_output_file, output_file));
+
+  JSONFileValueSerializer golden_serializer(golden_output_file);
+  scoped_ptr<Value> golden_value(golden_serializer.Deserialize(NULL, NULL));
+  ASSERT_TRUE(golden_value.get());
+
+  std::string contents;
+  ASSERT_TRUE(base::ReadFileToString(output_file, &contents));
+  scoped_ptr<DictionaryValue> written_prefs(
+      PrefSnapshot::DeserializeSnapshot(contents));
+  if (!written_prefs) {
+    JSONFileValueSerializer serializer(output_file);
+    scoped_ptr<Value> value(serializer.Deserialize(NULL, NULL));
+    ASSERT_TRUE(value.get() && value->IsType(Value::TYPE_DICTIONARY));
+    written_prefs.reset(static_cast<DictionaryValue*>(value.release()));
+  }
+  base::FilePath journal_file =
+      output_file.ReplaceExtension(FILE_PATH_LITERAL("journal"));
+  std::string journal;
+  if (base::ReadFileToString(journal_file, &journal))
+    EXPECT_TRUE(PrefSnapshot::ReplayJournal(journal, written_prefs.get()));
+  EXPECT_TRUE(written_prefs->Equals(golden_value.get()));
+
   ASSERT_TRUE(base::DeleteFile(output_file, false));
+  base::DeleteFile(journal_file, false);
 }
 
 TEST_F(JsonPrefStoreTest, Basic) {
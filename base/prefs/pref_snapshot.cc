@@ -0,0 +1,274 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/prefs/pref_snapshot.h"
+
+#include <string.h>
+
+#include "base/logging.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/pickle.h"
+#include "base/values.h"
+
+namespace {
+
+// Identifies a snapshot file; present so that a JSON-format preferences file
+// (which a downgraded or not-yet-migrated profile may contain) is never
+// misparsed as a snapshot.
+const uint32 kSnapshotMagic = 0x66657250;  // "Pref".
+
+// Bump this whenever the value encoding below changes incompatibly. Readers
+// reject snapshots with an unknown version and fall back to defaults.
+const int kSnapshotVersion = 1;
+
+// Journal record types.
+enum RecordType {
+  SET_VALUE_RECORD = 1,
+  REMOVE_VALUE_RECORD = 2,
+};
+
+// Nested dictionaries and lists deeper than this are rejected when reading.
+// Matches the depth limit the JSON parser imposes and bounds the recursion a
+// corrupt file can trigger.
+const int kMaxReadDepth = 100;
+
+void WriteValue(const base::Value& value, Pickle* pickle) {
+  pickle->WriteInt(value.GetType());
+  switch (value.GetType()) {
+    case base::Value::TYPE_NULL:
+      break;
+    case base::Value::TYPE_BOOLEAN: {
+      bool bool_value = false;
+      value.GetAsBoolean(&bool_value);
+      pickle->WriteBool(bool_value);
+      break;
+    }
+    case base::Value::TYPE_INTEGER: {
+      int int_value = 0;
+      value.GetAsInteger(&int_value);
+      pickle->WriteInt(int_value);
+      break;
+    }
+    case base::Value::TYPE_DOUBLE: {
+      double double_value = 0;
+      value.GetAsDouble(&double_value);
+      pickle->WriteDouble(double_value);
+      break;
+    }
+    case base::Value::TYPE_STRING: {
+      std::string string_value;
+      value.GetAsString(&string_value);
+      pickle->WriteString(string_value);
+      break;
+    }
+    case base::Value::TYPE_BINARY: {
+      const base::BinaryValue& binary_value =
+          static_cast<const base::BinaryValue&>(value);
+      pickle->WriteData(binary_value.GetBuffer(),
+                        static_cast<int>(binary_value.GetSize()));
+      break;
+    }
+    case base::Value::TYPE_DICTIONARY: {
+      const base::DictionaryValue& dict_value =
+          static_cast<const base::DictionaryValue&>(value);
+      pickle->WriteInt(static_cast<int>(dict_value.size()));
+      for (base::DictionaryValue::Iterator it(dict_value); !it.IsAtEnd();
+           it.Advance()) {
+        pickle->WriteString(it.key());
+        WriteValue(it.value(), pickle);
+      }
+      break;
+    }
+    case base::Value::TYPE_LIST: {
+      const base::ListValue& list_value =
+          static_cast<const base::ListValue&>(value);
+      pickle->WriteInt(static_cast<int>(list_value.GetSize()));
+      for (base::ListValue::const_iterator it = list_value.begin();
+           it != list_value.end(); ++it) {
+        WriteValue(**it, pickle);
+      }
+      break;
+    }
+  }
+}
+
+// Reads a value written by WriteValue(). Returns NULL if |iter| does not hold
+// a well-formed value.
+base::Value* ReadValue(PickleIterator* iter, int depth) {
+  if (depth > kMaxReadDepth)
+    return NULL;
+
+  int type = -1;
+  if (!iter->ReadInt(&type))
+    return NULL;
+  switch (type) {
+    case base::Value::TYPE_NULL:
+      return base::Value::CreateNullValue();
+    case base::Value::TYPE_BOOLEAN: {
+      bool bool_value = false;
+      if (!iter->ReadBool(&bool_value))
+        return NULL;
+      return new base::FundamentalValue(bool_value);
+    }
+    case base::Value::TYPE_INTEGER: {
+      int int_value = 0;
+      if (!iter->ReadInt(&int_value))
+        return NULL;
+      return new base::FundamentalValue(int_value);
+    }
+    case base::Value::TYPE_DOUBLE: {
+      double double_value = 0;
+      if (!iter->ReadDouble(&double_value))
+        return NULL;
+      return new base::FundamentalValue(double_value);
+    }
+    case base::Value::TYPE_STRING: {
+      std::string string_value;
+      if (!iter->ReadString(&string_value))
+        return NULL;
+      return new base::StringValue(string_value);
+    }
+    case base::Value::TYPE_BINARY: {
+      const char* data = NULL;
+      int length = 0;
+      if (!iter->ReadData(&data, &length))
+        return NULL;
+      return base::BinaryValue::CreateWithCopiedBuffer(data, length);
+    }
+    case base::Value::TYPE_DICTIONARY: {
+      int size = 0;
+      if (!iter->ReadInt(&size) || size < 0)
+        return NULL;
+      scoped_ptr<base::DictionaryValue> dict_value(new base::DictionaryValue);
+      for (int i = 0; i < size; ++i) {
+        std::string key;
+        if (!iter->ReadString(&key))
+          return NULL;
+        base::Value* entry = ReadValue(iter, depth + 1);
+        if (!entry)
+          return NULL;
+        dict_value->SetWithoutPathExpansion(key, entry);
+      }
+      return dict_value.release();
+    }
+    case base::Value::TYPE_LIST: {
+      int size = 0;
+      if (!iter->ReadInt(&size) || size < 0)
+        return NULL;
+      scoped_ptr<base::ListValue> list_value(new base::ListValue);
+      for (int i = 0; i < size; ++i) {
+        base::Value* entry = ReadValue(iter, depth + 1);
+        if (!entry)
+          return NULL;
+        list_value->Append(entry);
+      }
+      return list_value.release();
+    }
+    default:
+      return NULL;
+  }
+}
+
+// Appends |pickle| to |output| as a length-prefixed journal record. The
+// explicit prefix is needed because Pickle's read constructor assumes a
+// pickle spans its entire buffer, which isn't true for concatenated records.
+void AppendPickleRecord(const Pickle& pickle, std::string* output) {
+  uint32 size = static_cast<uint32>(pickle.size());
+  output->append(reinterpret_cast<const char*>(&size), sizeof(size));
+  output->append(static_cast<const char*>(pickle.data()), pickle.size());
+}
+
+}  // namespace
+
+// static
+void PrefSnapshot::SerializeSnapshot(const base::DictionaryValue& prefs,
+                                     std::string* output) {
+  Pickle pickle;
+  pickle.WriteUInt32(kSnapshotMagic);
+  pickle.WriteInt(kSnapshotVersion);
+  WriteValue(prefs, &pickle);
+  output->assign(static_cast<const char*>(pickle.data()), pickle.size());
+}
+
+// static
+base::DictionaryValue* PrefSnapshot::DeserializeSnapshot(
+    const std::string& data) {
+  Pickle pickle(data.data(), static_cast<int>(data.size()));
+  if (!pickle.data())
+    return NULL;
+
+  PickleIterator iter(pickle);
+  uint32 magic = 0;
+  int version = 0;
+  if (!iter.ReadUInt32(&magic) || magic != kSnapshotMagic ||
+      !iter.ReadInt(&version) || version != kSnapshotVersion) {
+    return NULL;
+  }
+
+  scoped_ptr<base::Value> value(ReadValue(&iter, 0));
+  if (!value || !value->IsType(base::Value::TYPE_DICTIONARY))
+    return NULL;
+  return static_cast<base::DictionaryValue*>(value.release());
+}
+
+// static
+void PrefSnapshot::AppendSetRecord(const std::string& path,
+                                   const base::Value& value,
+                                   std::string* output) {
+  Pickle pickle;
+  pickle.WriteInt(SET_VALUE_RECORD);
+  pickle.WriteString(path);
+  WriteValue(value, &pickle);
+  AppendPickleRecord(pickle, output);
+}
+
+// static
+void PrefSnapshot::AppendRemoveRecord(const std::string& path,
+                                      std::string* output) {
+  Pickle pickle;
+  pickle.WriteInt(REMOVE_VALUE_RECORD);
+  pickle.WriteString(path);
+  AppendPickleRecord(pickle, output);
+}
+
+// static
+bool PrefSnapshot::ReplayJournal(const std::string& journal,
+                                 base::DictionaryValue* prefs) {
+  size_t offset = 0;
+  while (offset < journal.size()) {
+    uint32 record_size = 0;
+    if (journal.size() - offset < sizeof(record_size))
+      return false;
+    memcpy(&record_size, journal.data() + offset, sizeof(record_size));
+    offset += sizeof(record_size);
+    if (journal.size() - offset < record_size)
+      return false;
+
+    Pickle pickle(journal.data() + offset, record_size);
+    offset += record_size;
+    if (!pickle.data())
+      return false;
+
+    PickleIterator iter(pickle);
+    int type = -1;
+    std::string path;
+    if (!iter.ReadInt(&type) || !iter.ReadString(&path))
+      return false;
+    switch (type) {
+      case SET_VALUE_RECORD: {
+        base::Value* value = ReadValue(&iter, 0);
+        if (!value)
+          return false;
+        prefs->Set(path, value);
+        break;
+      }
+      case REMOVE_VALUE_RECORD:
+        prefs->RemovePath(path, NULL);
+        break;
+      default:
+        return false;
+    }
+  }
+  return true;
+}
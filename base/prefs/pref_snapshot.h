@@ -0,0 +1,65 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_PREFS_PREF_SNAPSHOT_H_
+#define BASE_PREFS_PREF_SNAPSHOT_H_
+
+#include <string>
+
+#include "base/basictypes.h"
+#include "base/prefs/base_prefs_export.h"
+
+namespace base {
+class DictionaryValue;
+class Value;
+}
+
+// Binary serialization for preference data, used by JsonPrefStore in place of
+// JSON for its on-disk files. Two formats are provided:
+//
+// A *snapshot* is a complete preferences dictionary serialized into a single
+// Pickle. It is written atomically and replaces the whole file.
+//
+// A *journal* is a sequence of self-delimiting Pickle records, each recording
+// a single key path that was set or removed. Records are appended to a side
+// file between snapshots so that an individual preference change only writes
+// a few bytes; the journal is replayed on top of the snapshot at load time
+// and deleted whenever a new snapshot is written.
+//
+// Both formats are host-specific (they inherit Pickle's endianness and
+// alignment) which is fine for files that never leave the profile directory.
+class BASE_PREFS_EXPORT PrefSnapshot {
+ public:
+  // Serializes |prefs| as a complete snapshot into |output|.
+  static void SerializeSnapshot(const base::DictionaryValue& prefs,
+                                std::string* output);
+
+  // Parses a snapshot previously produced by SerializeSnapshot(). Returns the
+  // deserialized dictionary, or NULL if |data| is not a well-formed snapshot
+  // (wrong magic, unsupported version or corrupt payload). The caller takes
+  // ownership of the result.
+  static base::DictionaryValue* DeserializeSnapshot(const std::string& data);
+
+  // Appends a journal record to |output| stating that the preference at
+  // |path| now holds |value|.
+  static void AppendSetRecord(const std::string& path,
+                              const base::Value& value,
+                              std::string* output);
+
+  // Appends a journal record to |output| stating that the preference at
+  // |path| was removed.
+  static void AppendRemoveRecord(const std::string& path, std::string* output);
+
+  // Applies the records in |journal| to |prefs| in order. Returns false if
+  // trailing data could not be parsed (e.g. a record truncated by a crash
+  // mid-append); all complete records before the corrupt tail are still
+  // applied.
+  static bool ReplayJournal(const std::string& journal,
+                            base::DictionaryValue* prefs);
+
+ private:
+  DISALLOW_IMPLICIT_CONSTRUCTORS(PrefSnapshot);
+};
+
+#endif  // BASE_PREFS_PREF_SNAPSHOT_H_
@@ -0,0 +1,90 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/prefs/pref_snapshot.h"
+
+#include "base/memory/scoped_ptr.h"
+#include "base/values.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+namespace {
+
+// Builds a dictionary exercising every value type the snapshot format
+// supports, including empty containers.
+scoped_ptr<DictionaryValue> MakeTestPrefs() {
+  scoped_ptr<DictionaryValue> prefs(new DictionaryValue);
+  prefs->SetBoolean("bool", true);
+  prefs->SetInteger("int", -42);
+  prefs->SetDouble("double", 3.25);
+  prefs->SetString("string", "a string");
+  prefs->SetString("nested.string", "nested value");
+  prefs->Set("null", Value::CreateNullValue());
+  prefs->Set("empty_dict", new DictionaryValue);
+  prefs->Set("empty_list", new ListValue);
+  ListValue* list = new ListValue;
+  list->AppendInteger(1);
+  list->AppendString("two");
+  prefs->Set("list", list);
+  prefs->Set("binary", BinaryValue::CreateWithCopiedBuffer("\0\1\2", 3));
+  return prefs.Pass();
+}
+
+TEST(PrefSnapshotTest, SnapshotRoundTrip) {
+  scoped_ptr<DictionaryValue> prefs(MakeTestPrefs());
+
+  std::string data;
+  PrefSnapshot::SerializeSnapshot(*prefs, &data);
+  scoped_ptr<DictionaryValue> read_back(
+      PrefSnapshot::DeserializeSnapshot(data));
+  ASSERT_TRUE(read_back.get());
+  EXPECT_TRUE(prefs->Equals(read_back.get()));
+}
+
+TEST(PrefSnapshotTest, RejectsNonSnapshotData) {
+  EXPECT_FALSE(PrefSnapshot::DeserializeSnapshot(std::string()));
+  EXPECT_FALSE(PrefSnapshot::DeserializeSnapshot("{ \"homepage\": \"a\" }"));
+
+  // A truncated snapshot must be rejected rather than misparsed.
+  std::string data;
+  PrefSnapshot::SerializeSnapshot(*MakeTestPrefs(), &data);
+  EXPECT_FALSE(
+      PrefSnapshot::DeserializeSnapshot(data.substr(0, data.size() / 2)));
+}
+
+TEST(PrefSnapshotTest, JournalRoundTrip) {
+  std::string journal;
+  PrefSnapshot::AppendSetRecord("a.b", StringValue("value"), &journal);
+  PrefSnapshot::AppendSetRecord("a.b", StringValue("newer"), &journal);
+  PrefSnapshot::AppendSetRecord("c", FundamentalValue(7), &journal);
+  PrefSnapshot::AppendRemoveRecord("c", &journal);
+
+  DictionaryValue prefs;
+  EXPECT_TRUE(PrefSnapshot::ReplayJournal(journal, &prefs));
+
+  std::string string_value;
+  EXPECT_TRUE(prefs.GetString("a.b", &string_value));
+  EXPECT_EQ("newer", string_value);
+  EXPECT_FALSE(prefs.HasKey("c"));
+}
+
+TEST(PrefSnapshotTest, JournalTruncatedTail) {
+  std::string journal;
+  PrefSnapshot::AppendSetRecord("kept", FundamentalValue(1), &journal);
+  size_t complete_size = journal.size();
+  PrefSnapshot::AppendSetRecord("torn", FundamentalValue(2), &journal);
+
+  // Simulate a crash mid-append: everything before the torn record must
+  // still be applied.
+  journal.resize(complete_size + 5);
+  DictionaryValue prefs;
+  EXPECT_FALSE(PrefSnapshot::ReplayJournal(journal, &prefs));
+  int int_value = 0;
+  EXPECT_TRUE(prefs.GetInteger("kept", &int_value));
+  EXPECT_EQ(1, int_value);
+  EXPECT_FALSE(prefs.HasKey("torn"));
+}
+
+}  // namespace
+}  // namespace base
@@ -0,0 +1,42 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// Vectorized kernels for the base64 and hex codecs. These are internal to
+// base; use Base64Encode() and HexEncode(), which dispatch here at runtime
+// when the CPU supports it. Each kernel processes as many whole input blocks
+// as it can and returns the number of input bytes consumed; the caller
+// finishes the remainder (and any padding) with the scalar code.
+
+#ifndef BASE_SIMD_CODECS_H_
+#define BASE_SIMD_CODECS_H_
+
+#include "base/basictypes.h"
+#include "build/build_config.h"
+
+namespace base {
+namespace internal {
+
+#if defined(ARCH_CPU_X86_FAMILY)
+// Encodes input in 12-byte groups, 16 output characters per group. Requires
+// SSSE3; the caller must check base::CPU::has_ssse3() first. Consumes at
+// most input_size - 4 bytes (each load reads 16 bytes).
+size_t Base64EncodeSSSE3(const uint8* input, size_t input_size, char* output);
+
+// Encodes input in 16-byte groups, 32 uppercase hex characters per group.
+// Requires SSSE3.
+size_t HexEncodeSSSE3(const uint8* input, size_t input_size, char* output);
+#endif
+
+#if defined(__ARM_NEON__)
+// NEON versions of the above. Base64 consumes 24-byte groups; hex consumes
+// 8-byte groups. NEON availability is a compile-time property here, so no
+// runtime check is needed.
+size_t Base64EncodeNEON(const uint8* input, size_t input_size, char* output);
+size_t HexEncodeNEON(const uint8* input, size_t input_size, char* output);
+#endif
+
+}  // namespace internal
+}  // namespace base
+
+#endif  // BASE_SIMD_CODECS_H_
@@ -0,0 +1,90 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// NEON base64/hex encode kernels. Built only when the target enables NEON
+// (arm_neon==1), in which case availability is unconditional.
+
+#include "base/simd_codecs.h"
+
+#if defined(__ARM_NEON__)
+
+#include <arm_neon.h>
+
+namespace base {
+namespace internal {
+
+namespace {
+
+// Maps eight 6-bit indices to their base64 alphabet characters. See the
+// SSSE3 version for the derivation of the offset table.
+uint8x8_t TranslateIndices(uint8x8_t indices, uint8x8x2_t offset_lut) {
+  uint8x8_t reduced = vqsub_u8(indices, vdup_n_u8(51));
+  uint8x8_t gt25 = vcgt_u8(indices, vdup_n_u8(25));
+  reduced = vsub_u8(reduced, gt25);  // gt25 lanes are 0xFF, i.e. -1.
+  uint8x8_t offsets = vtbl2_u8(offset_lut, reduced);
+  return vadd_u8(indices, offsets);
+}
+
+}  // namespace
+
+size_t Base64EncodeNEON(const uint8* input, size_t input_size, char* output) {
+  // Offsets as unsigned bytes: 65, 71, -4 x10, -19, -16 (mod 256).
+  static const uint8 kOffsets[16] = {
+    65, 71, 252, 252, 252, 252, 252, 252, 252, 252, 252, 252, 237, 240, 0, 0
+  };
+  uint8x8x2_t offset_lut;
+  offset_lut.val[0] = vld1_u8(kOffsets);
+  offset_lut.val[1] = vld1_u8(kOffsets + 8);
+  const uint8x8_t k63 = vdup_n_u8(63);
+
+  size_t consumed = 0;
+  // vld3 deinterleaves 24 bytes into the a/b/c bytes of eight 3-byte
+  // groups; each group becomes four characters, stored with vst4.
+  while (input_size - consumed >= 24) {
+    uint8x8x3_t abc = vld3_u8(input + consumed);
+    uint8x8x4_t chars;
+    chars.val[0] = TranslateIndices(vshr_n_u8(abc.val[0], 2), offset_lut);
+    chars.val[1] = TranslateIndices(
+        vand_u8(vorr_u8(vshl_n_u8(abc.val[0], 4), vshr_n_u8(abc.val[1], 4)),
+                k63),
+        offset_lut);
+    chars.val[2] = TranslateIndices(
+        vand_u8(vorr_u8(vshl_n_u8(abc.val[1], 2), vshr_n_u8(abc.val[2], 6)),
+                k63),
+        offset_lut);
+    chars.val[3] = TranslateIndices(vand_u8(abc.val[2], k63), offset_lut);
+    vst4_u8(reinterpret_cast<uint8*>(output), chars);
+    consumed += 24;
+    output += 32;
+  }
+  return consumed;
+}
+
+size_t HexEncodeNEON(const uint8* input, size_t input_size, char* output) {
+  static const uint8 kHexChars[16] = {
+    '0', '1', '2', '3', '4', '5', '6', '7',
+    '8', '9', 'A', 'B', 'C', 'D', 'E', 'F'
+  };
+  uint8x8x2_t hex_lut;
+  hex_lut.val[0] = vld1_u8(kHexChars);
+  hex_lut.val[1] = vld1_u8(kHexChars + 8);
+
+  size_t consumed = 0;
+  while (input_size - consumed >= 8) {
+    uint8x8_t in = vld1_u8(input + consumed);
+    uint8x8x2_t chars;
+    chars.val[0] = vtbl2_u8(hex_lut, vshr_n_u8(in, 4));
+    chars.val[1] = vtbl2_u8(hex_lut, vand_u8(in, vdup_n_u8(0x0f)));
+    // vst2 interleaves to hi0 lo0 hi1 lo1 ...
+    vst2_u8(reinterpret_cast<uint8*>(output), chars);
+    consumed += 8;
+    output += 16;
+  }
+  return consumed;
+}
+
+}  // namespace internal
+}  // namespace base
+
+#endif  // defined(__ARM_NEON__)
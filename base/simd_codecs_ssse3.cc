@@ -0,0 +1,90 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// SSSE3 base64/hex encode kernels. This file is compiled with -mssse3 (see
+// the base_simd target); callers gate on base::CPU::has_ssse3() at runtime.
+
+#include "base/simd_codecs.h"
+
+#if defined(ARCH_CPU_X86_FAMILY)
+
+#include <tmmintrin.h>
+
+namespace base {
+namespace internal {
+
+size_t Base64EncodeSSSE3(const uint8* input, size_t input_size, char* output) {
+  // Split each 12-byte group into sixteen 6-bit indices, then translate the
+  // indices to their base64 alphabet characters with a saturated-subtract
+  // plus table-lookup trick (after Wojciech Mula's vectorized base64).
+  //
+  // Gathers each output character's source bytes: for a 3-byte group
+  // [a b c] the four 6-bit indices draw bits from [a], [a b], [b c], [c].
+  const __m128i kShuffle =
+      _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+  // Offset from a 6-bit index to its ASCII character, indexed by the reduced
+  // value computed below: 'A' for 0-25, 'a'-26 for 26-51, '0'-52 for 52-61,
+  // '+' and '/' for 62 and 63.
+  const __m128i kOffsetLut = _mm_setr_epi8(
+      65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0);
+
+  size_t consumed = 0;
+  // Each iteration loads 16 bytes but only encodes the first 12, so stay
+  // 16 bytes clear of the end; the scalar code finishes the tail.
+  while (input_size - consumed >= 16) {
+    __m128i in = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(input + consumed));
+    in = _mm_shuffle_epi8(in, kShuffle);
+
+    // Isolate the four 6-bit fields of each group into separate bytes.
+    __m128i t0 = _mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00));
+    __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+    __m128i t2 = _mm_and_si128(in, _mm_set1_epi32(0x003f03f0));
+    __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+    __m128i indices = _mm_or_si128(t1, t3);
+
+    // reduced = 0 for 0-51, index-51 for 52-63, then +1 for indices > 25,
+    // giving a unique LUT row per alphabet range.
+    __m128i reduced = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+    __m128i gt25 = _mm_cmpgt_epi8(indices, _mm_set1_epi8(25));
+    reduced = _mm_sub_epi8(reduced, gt25);
+
+    __m128i offsets = _mm_shuffle_epi8(kOffsetLut, reduced);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(output),
+                     _mm_add_epi8(indices, offsets));
+    consumed += 12;
+    output += 16;
+  }
+  return consumed;
+}
+
+size_t HexEncodeSSSE3(const uint8* input, size_t input_size, char* output) {
+  const __m128i kHexLut = _mm_setr_epi8('0', '1', '2', '3', '4', '5', '6',
+                                        '7', '8', '9', 'A', 'B', 'C', 'D',
+                                        'E', 'F');
+  const __m128i kNibbleMask = _mm_set1_epi8(0x0f);
+
+  size_t consumed = 0;
+  while (input_size - consumed >= 16) {
+    __m128i in = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(input + consumed));
+    __m128i hi = _mm_and_si128(_mm_srli_epi16(in, 4), kNibbleMask);
+    __m128i lo = _mm_and_si128(in, kNibbleMask);
+    __m128i hi_chars = _mm_shuffle_epi8(kHexLut, hi);
+    __m128i lo_chars = _mm_shuffle_epi8(kHexLut, lo);
+    // Interleaving restores source byte order: hi0 lo0 hi1 lo1 ...
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(output),
+                     _mm_unpacklo_epi8(hi_chars, lo_chars));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(output + 16),
+                     _mm_unpackhi_epi8(hi_chars, lo_chars));
+    consumed += 16;
+    output += 32;
+  }
+  return consumed;
+}
+
+}  // namespace internal
+}  // namespace base
+
+#endif  // defined(ARCH_CPU_X86_FAMILY)
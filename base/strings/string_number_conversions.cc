@@ -11,7 +11,9 @@
 
 #include <limits>
 
+#include "base/cpu.h"
 #include "base/logging.h"
+#include "base/simd_codecs.h"
 #include "base/scoped_clear_errno.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/third_party/dmg_fp/dmg_fp.h"
@@ -494,7 +496,26 @@ std::string HexEncode(const void* bytes, size_t size) {
   // Each input byte creates two output hex characters.
   std::string ret(size * 2, '\0');
 
-  for (size_t i = 0; i < size; ++i) {
+  // Let the vector kernel convert as many whole blocks as it can; disk_cache
+  // keys and net logging push large buffers through here.
+  size_t i = 0;
+#if defined(ARCH_CPU_X86_FAMILY)
+  if (size >= 64) {
+    // Benign race: concurrent initializers compute the same value.
+    static bool ssse3_supported = CPU().has_ssse3();
+    if (ssse3_supported) {
+      i = internal::HexEncodeSSSE3(reinterpret_cast<const uint8*>(bytes),
+                                   size, &ret[0]);
+    }
+  }
+#elif defined(__ARM_NEON__)
+  if (size >= 64) {
+    i = internal::HexEncodeNEON(reinterpret_cast<const uint8*>(bytes), size,
+                                &ret[0]);
+  }
+#endif
+
+  for (; i < size; ++i) {
     char b = reinterpret_cast<const char*>(bytes)[i];
     ret[(i * 2)] = kHexChars[(b >> 4) & 0xf];
     ret[(i * 2) + 1] = kHexChars[b & 0xf];
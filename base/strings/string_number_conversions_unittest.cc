@@ -784,6 +784,23 @@ TEST(StringNumberConversionsTest, DoubleToString) {
   EXPECT_EQ("1334890332160", DoubleToString(input));
 }
 
+TEST(StringNumberConversionsTest, HexEncodeLargeInput) {
+  // Large enough to engage the vectorized path; verify each byte against
+  // the scalar definition across block boundaries.
+  std::string input;
+  for (int i = 0; i < 300; ++i)
+    input.push_back(static_cast<char>(i));
+  static const char kHexChars[] = "0123456789ABCDEF";
+  for (size_t length = 64; length <= input.size(); length += 7) {
+    std::string hex = HexEncode(input.data(), length);
+    ASSERT_EQ(length * 2, hex.size());
+    for (size_t i = 0; i < length; ++i) {
+      EXPECT_EQ(kHexChars[(input[i] >> 4) & 0xf], hex[i * 2]);
+      EXPECT_EQ(kHexChars[input[i] & 0xf], hex[i * 2 + 1]);
+    }
+  }
+}
+
 TEST(StringNumberConversionsTest, HexEncode) {
   std::string hex(HexEncode(NULL, 0));
   EXPECT_EQ(hex.length(), 0U);
@@ -35,6 +35,36 @@ void SplitStringT(const STR& str,
   }
 }
 
+// Trims leading and trailing ASCII whitespace from |piece| without copying.
+StringPiece TrimWhitespacePiece(const StringPiece& piece) {
+  size_t start = piece.find_first_not_of(kWhitespaceASCII);
+  if (start == StringPiece::npos)
+    return StringPiece();
+  size_t end = piece.find_last_not_of(kWhitespaceASCII);
+  return piece.substr(start, end - start + 1);
+}
+
+void SplitStringPieceT(const StringPiece& str,
+                       char s,
+                       bool trim_whitespace,
+                       std::vector<StringPiece>* r) {
+  r->clear();
+  size_t last = 0;
+  size_t c = str.size();
+  for (size_t i = 0; i <= c; ++i) {
+    if (i == c || str[i] == s) {
+      StringPiece piece = str.substr(last, i - last);
+      if (trim_whitespace)
+        piece = TrimWhitespacePiece(piece);
+      // Avoid converting an empty or all-whitespace source string into a
+      // vector of one empty piece.
+      if (i != c || !r->empty() || !piece.empty())
+        r->push_back(piece);
+      last = i + 1;
+    }
+  }
+}
+
 bool SplitStringIntoKeyValue(const std::string& line,
                              char key_value_delimiter,
                              std::string* key,
@@ -144,6 +174,55 @@ void SplitString(const std::string& str,
   SplitStringT(str, c, true, r);
 }
 
+void SplitStringPiece(const StringPiece& str,
+                      char c,
+                      std::vector<StringPiece>* r) {
+#if CHAR_MIN < 0
+  DCHECK(c >= 0);
+#endif
+  DCHECK(c < 0x7F);
+  SplitStringPieceT(str, c, true, r);
+}
+
+void SplitStringPieceDontTrim(const StringPiece& str,
+                              char c,
+                              std::vector<StringPiece>* r) {
+#if CHAR_MIN < 0
+  DCHECK(c >= 0);
+#endif
+  DCHECK(c < 0x7F);
+  SplitStringPieceT(str, c, false, r);
+}
+
+StringPieceSplitter::StringPieceSplitter(const StringPiece& str, char c)
+    : remaining_(str),
+      delim_(c),
+      // Like SplitStringPieceDontTrim(), an empty input yields no pieces at
+      // all rather than a single empty one.
+      is_done_(str.empty()) {
+#if CHAR_MIN < 0
+  DCHECK(c >= 0);
+#endif
+  DCHECK(c < 0x7F);
+}
+
+bool StringPieceSplitter::GetNext() {
+  if (is_done_)
+    return false;
+  size_t end = remaining_.find(delim_);
+  if (end == StringPiece::npos) {
+    // The last piece runs to the end of the input; there is nothing left to
+    // report after it, not even an empty piece.
+    piece_ = remaining_;
+    remaining_ = StringPiece();
+    is_done_ = true;
+  } else {
+    piece_ = remaining_.substr(0, end);
+    remaining_.remove_prefix(end + 1);
+  }
+  return true;
+}
+
 bool SplitStringIntoKeyValuePairs(const std::string& line,
                                   char key_value_delimiter,
                                   char key_value_pair_delimiter,
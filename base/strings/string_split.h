@@ -11,6 +11,7 @@
 
 #include "base/base_export.h"
 #include "base/strings/string16.h"
+#include "base/strings/string_piece.h"
 
 namespace base {
 
@@ -64,6 +65,47 @@ BASE_EXPORT void SplitStringDontTrim(const std::string& str,
                                      char c,
                                      std::vector<std::string>* r);
 
+// The same as SplitString, but returns pieces of the input rather than
+// copies of it. The pieces point into the memory backing |str|, so the
+// caller must keep that memory alive for as long as |r| refers to it.
+// Note: |c| must be in the ASCII range.
+BASE_EXPORT void SplitStringPiece(const StringPiece& str,
+                                  char c,
+                                  std::vector<StringPiece>* r);
+
+// The same as SplitStringPiece, but don't trim white space.
+BASE_EXPORT void SplitStringPieceDontTrim(const StringPiece& str,
+                                          char c,
+                                          std::vector<StringPiece>* r);
+
+// A single-pass alternative to SplitStringPiece() for hot paths that only
+// look at each piece once. It touches the heap not at all:
+//
+//   base::StringPieceSplitter splitter(header_value, ',');
+//   while (splitter.GetNext())
+//     Handle(splitter.piece());
+//
+// Every piece is reported, including the empty ones produced by leading,
+// trailing or consecutive delimiters, matching SplitStringPieceDontTrim().
+// The pieces point into the memory backing |str|, which must outlive the
+// splitter.
+class BASE_EXPORT StringPieceSplitter {
+ public:
+  StringPieceSplitter(const StringPiece& str, char c);
+
+  // Advances to the next piece. Returns false once all pieces have been
+  // consumed, after which piece() may no longer be called.
+  bool GetNext();
+
+  const StringPiece& piece() const { return piece_; }
+
+ private:
+  StringPiece remaining_;
+  StringPiece piece_;
+  char delim_;
+  bool is_done_;
+};
+
 // WARNING: this uses whitespace as defined by the HTML5 spec. If you need
 // a function similar to this but want to trim all types of whitespace, then
 // factor this out into a function that takes a string containing the characters
@@ -291,6 +291,86 @@ TEST(StringSplitTest, StringSplitDontTrim) {
   EXPECT_EQ(r[1], "b\tcc");
 }
 
+TEST(StringSplitTest, SplitStringPiece) {
+  std::vector<StringPiece> r;
+
+  SplitStringPiece(StringPiece(), ',', &r);
+  EXPECT_EQ(0U, r.size());
+
+  SplitStringPiece("a, b, c", ',', &r);
+  ASSERT_EQ(3U, r.size());
+  EXPECT_EQ("a", r[0]);
+  EXPECT_EQ("b", r[1]);
+  EXPECT_EQ("c", r[2]);
+
+  SplitStringPiece("a,,c", ',', &r);
+  ASSERT_EQ(3U, r.size());
+  EXPECT_EQ("a", r[0]);
+  EXPECT_EQ("", r[1]);
+  EXPECT_EQ("c", r[2]);
+
+  SplitStringPiece("   ", '*', &r);
+  EXPECT_EQ(0U, r.size());
+
+  SplitStringPiece("foo ,", ',', &r);
+  ASSERT_EQ(2U, r.size());
+  EXPECT_EQ("foo", r[0]);
+  EXPECT_EQ("", r[1]);
+
+  // The pieces must refer to the input rather than copies of it.
+  std::string input("one,two");
+  SplitStringPiece(input, ',', &r);
+  ASSERT_EQ(2U, r.size());
+  EXPECT_EQ(input.data(), r[0].data());
+  EXPECT_EQ(input.data() + 4, r[1].data());
+}
+
+TEST(StringSplitTest, SplitStringPieceDontTrim) {
+  std::vector<StringPiece> r;
+
+  SplitStringPieceDontTrim("   ", '*', &r);
+  ASSERT_EQ(1U, r.size());
+  EXPECT_EQ("   ", r[0]);
+
+  SplitStringPieceDontTrim("\t  \ta\t ", '\t', &r);
+  ASSERT_EQ(4U, r.size());
+  EXPECT_EQ("", r[0]);
+  EXPECT_EQ("  ", r[1]);
+  EXPECT_EQ("a", r[2]);
+  EXPECT_EQ(" ", r[3]);
+}
+
+TEST(StringSplitTest, StringPieceSplitter) {
+  std::string input(",a,,bc,");
+  StringPieceSplitter splitter(input, ',');
+
+  ASSERT_TRUE(splitter.GetNext());
+  EXPECT_EQ("", splitter.piece());
+  ASSERT_TRUE(splitter.GetNext());
+  EXPECT_EQ("a", splitter.piece());
+  EXPECT_EQ(input.data() + 1, splitter.piece().data());
+  ASSERT_TRUE(splitter.GetNext());
+  EXPECT_EQ("", splitter.piece());
+  ASSERT_TRUE(splitter.GetNext());
+  EXPECT_EQ("bc", splitter.piece());
+  ASSERT_TRUE(splitter.GetNext());
+  EXPECT_EQ("", splitter.piece());
+  EXPECT_FALSE(splitter.GetNext());
+  EXPECT_FALSE(splitter.GetNext());
+}
+
+TEST(StringSplitTest, StringPieceSplitterSinglePiece) {
+  StringPieceSplitter splitter("no delimiter here", ',');
+  ASSERT_TRUE(splitter.GetNext());
+  EXPECT_EQ("no delimiter here", splitter.piece());
+  EXPECT_FALSE(splitter.GetNext());
+}
+
+TEST(StringSplitTest, StringPieceSplitterEmptyInput) {
+  StringPieceSplitter splitter(StringPiece(), ',');
+  EXPECT_FALSE(splitter.GetNext());
+}
+
 TEST(StringSplitTest, SplitStringAlongWhitespace) {
   struct TestData {
     const char* input;
@@ -247,6 +247,7 @@ BASE_EXPORT bool ContainsOnlyChars(const StringPiece16& input,
 // add a new function for that.
 BASE_EXPORT bool IsStringUTF8(const std::string& str);
 BASE_EXPORT bool IsStringASCII(const StringPiece& str);
+BASE_EXPORT bool IsStringASCII(const StringPiece16& str);
 BASE_EXPORT bool IsStringASCII(const string16& str);
 
 }  // namespace base
@@ -56,6 +56,13 @@ std::string WideToUTF8(const std::wstring& wide) {
 }
 
 bool UTF8ToWide(const char* src, size_t src_len, std::wstring* output) {
+  // UI strings are almost always plain ASCII, in which case the conversion is
+  // just a widening copy and the two codepoint-decoding passes below can be
+  // skipped entirely.
+  if (IsStringASCII(StringPiece(src, src_len))) {
+    output->assign(src, src + src_len);
+    return true;
+  }
   PrepareForUTF16Or32Output(src, src_len, output);
   return ConvertUnicode(src, src_len, output);
 }
@@ -126,6 +133,11 @@ std::wstring UTF16ToWide(const string16& utf16) {
 #if defined(WCHAR_T_IS_UTF32)
 
 bool UTF8ToUTF16(const char* src, size_t src_len, string16* output) {
+  // See the ASCII fast path in UTF8ToWide().
+  if (IsStringASCII(StringPiece(src, src_len))) {
+    output->assign(src, src + src_len);
+    return true;
+  }
   PrepareForUTF16Or32Output(src, src_len, output);
   return ConvertUnicode(src, src_len, output);
 }
@@ -139,6 +151,11 @@ string16 UTF8ToUTF16(const StringPiece& utf8) {
 }
 
 bool UTF16ToUTF8(const char16* src, size_t src_len, std::string* output) {
+  // See the ASCII fast path in UTF8ToWide().
+  if (IsStringASCII(StringPiece16(src, src_len))) {
+    output->assign(src, src + src_len);
+    return true;
+  }
   PrepareForUTF8Output(src, src_len, output);
   return ConvertUnicode(src, src_len, output);
 }
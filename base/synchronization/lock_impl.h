@@ -49,6 +49,11 @@ class BASE_EXPORT LockImpl {
   // unnecessary.
   NativeHandle* native_handle() { return &native_handle_; }
 
+  // Returns the number of Lock() calls in the process that found the lock
+  // already held and had to take the blocking slow path. This is only bumped
+  // on the contended path, so it is cheap enough to keep in all builds.
+  static int GetContendedAcquisitionCountForTesting();
+
  private:
   NativeHandle native_handle_;
 
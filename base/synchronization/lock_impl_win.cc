@@ -4,9 +4,19 @@
 
 #include "base/synchronization/lock_impl.h"
 
+#include "base/atomicops.h"
+
 namespace base {
 namespace internal {
 
+namespace {
+
+// Process-wide count of Lock() calls that found the lock held and had to
+// block. Only written on the contended slow path.
+subtle::Atomic32 g_contended_acquisitions = 0;
+
+}  // namespace
+
 LockImpl::LockImpl() {
   // The second parameter is the spin count, for short-held locks it avoid the
   // contending thread from going to sleep which helps performance greatly.
@@ -25,9 +35,19 @@ bool LockImpl::Try() {
 }
 
 void LockImpl::Lock() {
+  // The critical section already spins before blocking (see the constructor);
+  // the extra try here only serves to count contended acquisitions.
+  if (::TryEnterCriticalSection(&native_handle_) != FALSE)
+    return;
+  subtle::NoBarrier_AtomicIncrement(&g_contended_acquisitions, 1);
   ::EnterCriticalSection(&native_handle_);
 }
 
+// static
+int LockImpl::GetContendedAcquisitionCountForTesting() {
+  return subtle::NoBarrier_Load(&g_contended_acquisitions);
+}
+
 void LockImpl::Unlock() {
   ::LeaveCriticalSection(&native_handle_);
 }
@@ -213,4 +213,45 @@ TEST(LockTest, MutexFourThreads) {
   EXPECT_EQ(4 * 40, value);
 }
 
+// Test the contention instrumentation -----------------------------------------
+
+class ContendedLockTestThread : public PlatformThread::Delegate {
+ public:
+  explicit ContendedLockTestThread(Lock* lock) : lock_(lock) {}
+
+  virtual void ThreadMain() OVERRIDE {
+    // The main thread holds |lock_| until after this thread has started, so
+    // this acquisition blocks and must be counted as contended.
+    lock_->Acquire();
+    lock_->Release();
+  }
+
+ private:
+  Lock* lock_;
+
+  DISALLOW_COPY_AND_ASSIGN(ContendedLockTestThread);
+};
+
+TEST(LockTest, ContendedAcquisitionCount) {
+  int initial_count =
+      internal::LockImpl::GetContendedAcquisitionCountForTesting();
+
+  Lock lock;
+  lock.Acquire();
+
+  ContendedLockTestThread thread(&lock);
+  PlatformThreadHandle handle;
+  ASSERT_TRUE(PlatformThread::Create(0, &thread, &handle));
+
+  // Give the other thread time to block on the lock before releasing it.
+  PlatformThread::Sleep(TimeDelta::FromMilliseconds(20));
+  lock.Release();
+  PlatformThread::Join(handle);
+
+  // Other locks in the process may also be contended in the meantime, so only
+  // check that at least our blocked acquisition was recorded.
+  EXPECT_GE(internal::LockImpl::GetContendedAcquisitionCountForTesting(),
+            initial_count + 1);
+}
+
 }  // namespace base
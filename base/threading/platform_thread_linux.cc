@@ -43,6 +43,21 @@ int ThreadNiceValue(ThreadPriority priority) {
   }
 }
 
+#if !defined(OS_NACL) && defined(__NR_ioprio_set)
+// I/O priority constants from linux/ioprio.h. glibc provides no wrapper for
+// ioprio_set(2), so the syscall is invoked directly.
+const int kIOPrioClassShift = 13;
+const int kIOPrioClassBestEffort = 2;
+const int kIOPrioWhoProcess = 1;  // Takes a thread id, like setpriority(2).
+
+bool SetThreadIOPriority(PlatformThreadId id, int io_class, int io_data) {
+  return syscall(__NR_ioprio_set,
+                 kIOPrioWhoProcess,
+                 id,
+                 (io_class << kIOPrioClassShift) | io_data) == 0;
+}
+#endif  // !defined(OS_NACL) && defined(__NR_ioprio_set)
+
 }  // namespace
 
 // static
@@ -92,6 +107,21 @@ void PlatformThread::SetThreadPriority(PlatformThreadHandle handle,
     DVPLOG(1) << "Failed to set nice value of thread ("
               << handle.id_ << ") to " << kNiceSetting;
   }
+
+#if defined(__NR_ioprio_set)
+  // Background threads should also yield the disk to more important work.
+  // They are moved to the lowest best-effort I/O class rather than the idle
+  // class, since idle threads only get disk time when the disk is otherwise
+  // untouched and could starve indefinitely under sustained foreground I/O.
+  if (priority == kThreadPriority_Background) {
+    const int kIOPrioBestEffortLowest = 7;
+    if (!SetThreadIOPriority(handle.id_, kIOPrioClassBestEffort,
+                             kIOPrioBestEffortLowest)) {
+      DVPLOG(1) << "Failed to set I/O priority of thread (" << handle.id_
+                << ")";
+    }
+  }
+#endif  // defined(__NR_ioprio_set)
 #endif  //  !defined(OS_NACL)
 }
 
@@ -0,0 +1,414 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/threading/work_stealing_task_scheduler.h"
+
+#include <deque>
+
+#include "base/bind.h"
+#include "base/callback.h"
+#include "base/lazy_instance.h"
+#include "base/location.h"
+#include "base/logging.h"
+#include "base/rand_util.h"
+#include "base/sequenced_task_runner.h"
+#include "base/strings/stringprintf.h"
+#include "base/threading/platform_thread.h"
+#include "base/threading/thread_local.h"
+#include "base/threading/thread_restrictions.h"
+
+namespace base {
+
+namespace {
+
+// Maps a worker thread back to its scheduler and worker index so that posts
+// from pool threads can use the thread's own deque.
+LazyInstance<ThreadLocalPointer<internal::WorkStealingWorker> >::Leaky
+    g_current_worker = LAZY_INSTANCE_INITIALIZER;
+
+}  // namespace
+
+namespace internal {
+
+// A fixed-capacity Chase-Lev work-stealing deque holding heap-allocated
+// Closures. The owning worker pushes/pops at |bottom_| without locks; thieves
+// CAS |top_|. When the deque is full the owner falls back to the scheduler's
+// injection queues rather than growing the array, which keeps the memory
+// management trivial at the cost of an occasional locked post under extreme
+// backlog.
+class WorkStealingDeque {
+ public:
+  // Must be a power of two; 8k in-flight tasks per worker is far beyond what
+  // any current pool consumer queues.
+  static const size_t kCapacity = 8192;
+
+  WorkStealingDeque() : top_(0), bottom_(0) {
+    for (size_t i = 0; i < kCapacity; ++i)
+      tasks_[i] = NULL;
+  }
+
+  ~WorkStealingDeque() {
+    for (size_t i = 0; i < kCapacity; ++i)
+      delete tasks_[i];
+  }
+
+  // Called only by the owning worker. Returns false if full.
+  bool PushBottom(const Closure& task) {
+    subtle::AtomicWord bottom = subtle::NoBarrier_Load(&bottom_);
+    subtle::AtomicWord top = subtle::Acquire_Load(&top_);
+    if (bottom - top >= static_cast<subtle::AtomicWord>(kCapacity))
+      return false;
+    tasks_[bottom & (kCapacity - 1)] = new Closure(task);
+    // Release so a thief that acquires |bottom_| sees the stored task.
+    subtle::Release_Store(&bottom_, bottom + 1);
+    return true;
+  }
+
+  // Called only by the owning worker. Pops the most recently pushed task
+  // (LIFO keeps caches warm for dependent work). Returns a null closure if
+  // the deque is empty or the last element was lost to a racing thief.
+  Closure PopBottom() {
+    subtle::AtomicWord bottom = subtle::NoBarrier_Load(&bottom_) - 1;
+    // Publish the claim on |bottom| before re-reading |top_| so a concurrent
+    // thief and this pop cannot both take the final element. The store must
+    // be globally visible before the load of |top_|, which Release_Store
+    // alone does not guarantee, so follow it with a full fence.
+    subtle::Release_Store(&bottom_, bottom);
+    subtle::MemoryBarrier();
+    subtle::AtomicWord top = subtle::Acquire_Load(&top_);
+    if (top > bottom) {
+      // Deque was empty; restore.
+      subtle::Release_Store(&bottom_, bottom + 1);
+      return Closure();
+    }
+    Closure* task = tasks_[bottom & (kCapacity - 1)];
+    if (top < bottom) {
+      // More than one element; no race possible.
+      Closure result = *task;
+      delete task;
+      tasks_[bottom & (kCapacity - 1)] = NULL;
+      return result;
+    }
+    // Exactly one element: race the thieves with a CAS on |top_|.
+    Closure result;
+    if (subtle::Acquire_CompareAndSwap(&top_, top, top + 1) == top) {
+      result = *task;
+      delete task;
+      tasks_[bottom & (kCapacity - 1)] = NULL;
+    }
+    subtle::Release_Store(&bottom_, top + 1);
+    return result;
+  }
+
+  // Called by any other worker. Steals the oldest task (FIFO order preserves
+  // rough submission fairness across the pool). Returns a null closure if
+  // the deque appears empty or the steal lost a race.
+  Closure StealTop() {
+    subtle::AtomicWord top = subtle::Acquire_Load(&top_);
+    subtle::AtomicWord bottom = subtle::Acquire_Load(&bottom_);
+    if (top >= bottom)
+      return Closure();
+    Closure* task = tasks_[top & (kCapacity - 1)];
+    if (subtle::Acquire_CompareAndSwap(&top_, top, top + 1) != top)
+      return Closure();  // Lost the race; the caller will pick a new victim.
+    Closure result = *task;
+    delete task;
+    tasks_[top & (kCapacity - 1)] = NULL;
+    return result;
+  }
+
+  bool IsEmpty() const {
+    return subtle::Acquire_Load(&top_) >= subtle::Acquire_Load(&bottom_);
+  }
+
+ private:
+  subtle::AtomicWord top_;
+  subtle::AtomicWord bottom_;
+  Closure* tasks_[kCapacity];
+
+  DISALLOW_COPY_AND_ASSIGN(WorkStealingDeque);
+};
+
+class WorkStealingWorker : public PlatformThread::Delegate {
+ public:
+  WorkStealingWorker(WorkStealingTaskScheduler* scheduler,
+                     size_t index,
+                     const std::string& name)
+      : scheduler_(scheduler), index_(index), name_(name), handle_() {}
+
+  virtual ~WorkStealingWorker() {}
+
+  void Start() { PlatformThread::Create(0, this, &handle_); }
+  void Join() { PlatformThread::Join(handle_); }
+
+  WorkStealingDeque* deque() { return &deque_; }
+  WorkStealingTaskScheduler* scheduler() { return scheduler_; }
+
+  // PlatformThread::Delegate:
+  virtual void ThreadMain() OVERRIDE {
+    PlatformThread::SetName(name_.c_str());
+    g_current_worker.Get().Set(this);
+    for (;;) {
+      // Capture the work generation before scanning. A post that lands after
+      // the scan misses it bumps the generation, so WaitForWork() below will
+      // return immediately instead of sleeping through the wakeup.
+      uint64 generation = scheduler_->GetWorkGeneration();
+      Closure task = deque_.PopBottom();
+      if (task.is_null())
+        task = scheduler_->FindWork(index_);
+      if (task.is_null()) {
+        if (!scheduler_->WaitForWork(generation))
+          break;
+        continue;
+      }
+      task.Run();
+    }
+    g_current_worker.Get().Set(NULL);
+  }
+
+ private:
+  WorkStealingTaskScheduler* const scheduler_;
+  const size_t index_;
+  const std::string name_;
+  PlatformThreadHandle handle_;
+  WorkStealingDeque deque_;
+
+  DISALLOW_COPY_AND_ASSIGN(WorkStealingWorker);
+};
+
+}  // namespace internal
+
+namespace {
+
+// TaskRunner that forwards to WorkStealingTaskScheduler::PostWorkerTask.
+class SchedulerTaskRunner : public TaskRunner {
+ public:
+  explicit SchedulerTaskRunner(
+      const scoped_refptr<WorkStealingTaskScheduler>& scheduler)
+      : scheduler_(scheduler) {}
+
+  // TaskRunner:
+  virtual bool PostDelayedTask(const tracked_objects::Location& from_here,
+                               const Closure& task,
+                               TimeDelta delay) OVERRIDE {
+    DCHECK_EQ(0, delay.InMilliseconds())
+        << "WorkStealingTaskScheduler does not support delayed tasks";
+    return scheduler_->PostWorkerTask(from_here, task);
+  }
+
+  virtual bool RunsTasksOnCurrentThread() const OVERRIDE {
+    return scheduler_->RunsTasksOnCurrentThread();
+  }
+
+ private:
+  virtual ~SchedulerTaskRunner() {}
+
+  const scoped_refptr<WorkStealingTaskScheduler> scheduler_;
+
+  DISALLOW_COPY_AND_ASSIGN(SchedulerTaskRunner);
+};
+
+// SequencedTaskRunner that serializes its tasks on the pool. At most one of
+// its tasks is in flight on the pool at a time; completion of one schedules
+// the next, so the sequence migrates between workers but never overlaps.
+class SchedulerSequencedTaskRunner : public SequencedTaskRunner {
+ public:
+  explicit SchedulerSequencedTaskRunner(
+      const scoped_refptr<WorkStealingTaskScheduler>& scheduler)
+      : scheduler_(scheduler), running_(false) {}
+
+  // SequencedTaskRunner:
+  virtual bool PostDelayedTask(const tracked_objects::Location& from_here,
+                               const Closure& task,
+                               TimeDelta delay) OVERRIDE {
+    DCHECK_EQ(0, delay.InMilliseconds())
+        << "WorkStealingTaskScheduler does not support delayed tasks";
+    {
+      AutoLock lock(lock_);
+      if (running_) {
+        queue_.push_back(task);
+        return true;
+      }
+      running_ = true;
+    }
+    return scheduler_->PostWorkerTask(
+        from_here,
+        Bind(&SchedulerSequencedTaskRunner::RunTask, this, task));
+  }
+
+  virtual bool PostNonNestableDelayedTask(
+      const tracked_objects::Location& from_here,
+      const Closure& task,
+      TimeDelta delay) OVERRIDE {
+    // Pool tasks never nest, so non-nestable is the same as nestable.
+    return PostDelayedTask(from_here, task, delay);
+  }
+
+  virtual bool RunsTasksOnCurrentThread() const OVERRIDE {
+    return scheduler_->RunsTasksOnCurrentThread();
+  }
+
+ private:
+  virtual ~SchedulerSequencedTaskRunner() {}
+
+  void RunTask(const Closure& task) {
+    task.Run();
+    Closure next;
+    {
+      AutoLock lock(lock_);
+      if (queue_.empty()) {
+        running_ = false;
+        return;
+      }
+      next = queue_.front();
+      queue_.pop_front();
+    }
+    scheduler_->PostWorkerTask(
+        FROM_HERE, Bind(&SchedulerSequencedTaskRunner::RunTask, this, next));
+  }
+
+  const scoped_refptr<WorkStealingTaskScheduler> scheduler_;
+
+  Lock lock_;
+  std::deque<Closure> queue_;
+  bool running_;
+
+  DISALLOW_COPY_AND_ASSIGN(SchedulerSequencedTaskRunner);
+};
+
+}  // namespace
+
+struct WorkStealingTaskScheduler::InjectionQueue {
+  Lock lock;
+  std::deque<Closure> tasks;
+};
+
+WorkStealingTaskScheduler::WorkStealingTaskScheduler(
+    size_t num_threads,
+    const std::string& thread_name_prefix)
+    : thread_name_prefix_(thread_name_prefix),
+      next_injection_queue_(0),
+      idle_cv_(&idle_lock_),
+      idle_workers_(0),
+      work_generation_(0),
+      shutdown_called_(false) {
+  DCHECK_GT(num_threads, 0u);
+  for (size_t i = 0; i < num_threads; ++i) {
+    injection_queues_.push_back(new InjectionQueue);
+    workers_.push_back(new internal::WorkStealingWorker(
+        this, i,
+        StringPrintf("%sWorker%d", thread_name_prefix.c_str(),
+                     static_cast<int>(i + 1))));
+  }
+  for (size_t i = 0; i < workers_.size(); ++i)
+    workers_[i]->Start();
+}
+
+WorkStealingTaskScheduler::~WorkStealingTaskScheduler() {
+  // Production code leaks the scheduler; tests call Shutdown() first.
+  for (size_t i = 0; i < workers_.size(); ++i)
+    delete workers_[i];
+  for (size_t i = 0; i < injection_queues_.size(); ++i)
+    delete injection_queues_[i];
+}
+
+bool WorkStealingTaskScheduler::PostWorkerTask(
+    const tracked_objects::Location& from_here,
+    const Closure& task) {
+  DCHECK(!task.is_null());
+  internal::WorkStealingWorker* worker = g_current_worker.Get().Get();
+  if (worker && worker->scheduler() == this &&
+      worker->deque()->PushBottom(task)) {
+    SignalWork();
+    return true;
+  }
+  // External post (or this worker's deque is full): pick an injection queue
+  // stripe round-robin so concurrent posters spread across the locks.
+  size_t stripe =
+      static_cast<size_t>(subtle::NoBarrier_AtomicIncrement(
+          &next_injection_queue_, 1)) % injection_queues_.size();
+  {
+    AutoLock lock(injection_queues_[stripe]->lock);
+    injection_queues_[stripe]->tasks.push_back(task);
+  }
+  SignalWork();
+  return true;
+}
+
+scoped_refptr<TaskRunner> WorkStealingTaskScheduler::GetTaskRunner() {
+  return new SchedulerTaskRunner(this);
+}
+
+scoped_refptr<SequencedTaskRunner>
+WorkStealingTaskScheduler::GetSequencedTaskRunner() {
+  return new SchedulerSequencedTaskRunner(this);
+}
+
+bool WorkStealingTaskScheduler::RunsTasksOnCurrentThread() const {
+  internal::WorkStealingWorker* worker = g_current_worker.Get().Get();
+  return worker && worker->scheduler() == this;
+}
+
+void WorkStealingTaskScheduler::Shutdown() {
+  {
+    AutoLock lock(idle_lock_);
+    shutdown_called_ = true;
+    idle_cv_.Broadcast();
+  }
+  ThreadRestrictions::ScopedAllowIO allow_join;
+  for (size_t i = 0; i < workers_.size(); ++i)
+    workers_[i]->Join();
+}
+
+Closure WorkStealingTaskScheduler::FindWork(size_t worker_index) {
+  // Drain injection queues first (starting at our own stripe) so externally
+  // posted work is not starved by long-running internal task chains.
+  for (size_t i = 0; i < injection_queues_.size(); ++i) {
+    InjectionQueue* queue =
+        injection_queues_[(worker_index + i) % injection_queues_.size()];
+    AutoLock lock(queue->lock);
+    if (!queue->tasks.empty()) {
+      Closure task = queue->tasks.front();
+      queue->tasks.pop_front();
+      return task;
+    }
+  }
+  // Steal from a random victim, then sweep the rest.
+  size_t start = RandInt(0, static_cast<int>(workers_.size()) - 1);
+  for (size_t i = 0; i < workers_.size(); ++i) {
+    size_t victim = (start + i) % workers_.size();
+    if (victim == worker_index)
+      continue;
+    Closure task = workers_[victim]->deque()->StealTop();
+    if (!task.is_null())
+      return task;
+  }
+  return Closure();
+}
+
+uint64 WorkStealingTaskScheduler::GetWorkGeneration() const {
+  AutoLock lock(idle_lock_);
+  return work_generation_;
+}
+
+bool WorkStealingTaskScheduler::WaitForWork(uint64 generation) {
+  AutoLock lock(idle_lock_);
+  ++idle_workers_;
+  // An unchanged generation means no work has been posted since the caller's
+  // scan came up empty; anything newer warrants another scan. The loop also
+  // guards against spurious wakeups.
+  while (!shutdown_called_ && work_generation_ == generation)
+    idle_cv_.Wait();
+  --idle_workers_;
+  return !shutdown_called_;
+}
+
+void WorkStealingTaskScheduler::SignalWork() {
+  AutoLock lock(idle_lock_);
+  ++work_generation_;
+  if (idle_workers_ > 0)
+    idle_cv_.Signal();
+}
+
+}  // namespace base
@@ -0,0 +1,131 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_THREADING_WORK_STEALING_TASK_SCHEDULER_H_
+#define BASE_THREADING_WORK_STEALING_TASK_SCHEDULER_H_
+
+#include <string>
+#include <vector>
+
+#include "base/atomicops.h"
+#include "base/base_export.h"
+#include "base/basictypes.h"
+#include "base/callback_forward.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/synchronization/condition_variable.h"
+#include "base/synchronization/lock.h"
+#include "base/task_runner.h"
+
+namespace tracked_objects {
+class Location;
+}  // namespace tracked_objects
+
+namespace base {
+
+class SequencedTaskRunner;
+
+namespace internal {
+class WorkStealingWorker;
+class WorkStealingDeque;
+}  // namespace internal
+
+// A worker thread pool built around per-thread work-stealing deques.
+//
+// Unlike SequencedWorkerPool, which funnels every post and every task
+// acquisition through a single lock, each worker thread owns a Chase-Lev
+// style deque. A worker pushes and pops tasks at the bottom of its own deque
+// without taking any lock; idle workers steal from the top of other workers'
+// deques using a single compare-and-swap. Posts from non-worker threads go to
+// a striped set of injection queues so that concurrent posters rarely contend
+// on the same lock.
+//
+// Ordering between unsequenced tasks is unspecified, exactly as with
+// SequencedWorkerPool::PostWorkerTask. Sequenced execution is available
+// through GetSequencedTaskRunner(), which serializes its tasks while still
+// drawing threads from the shared pool, so existing SequencedTaskRunner
+// consumers (e.g. BrowserThread well-known sequences, cc's raster paths) can
+// migrate without API changes.
+//
+// The pool is intended to be leaked on shutdown, mirroring the fast-shutdown
+// behavior of SequencedWorkerPool; Shutdown() exists for tests.
+class BASE_EXPORT WorkStealingTaskScheduler
+    : public RefCountedThreadSafe<WorkStealingTaskScheduler> {
+ public:
+  // Creates |num_threads| workers. |thread_name_prefix| is used to label the
+  // worker threads, e.g. a prefix of "Raster" yields "RasterWorker1" etc.
+  WorkStealingTaskScheduler(size_t num_threads,
+                            const std::string& thread_name_prefix);
+
+  // Posts |task| for execution on any worker thread. If called from a worker
+  // thread owned by this scheduler, the task is pushed onto that worker's own
+  // deque (cheap, lock-free); otherwise it goes to an injection queue.
+  bool PostWorkerTask(const tracked_objects::Location& from_here,
+                      const Closure& task);
+
+  // Returns a TaskRunner whose PostTask forwards to PostWorkerTask. Delayed
+  // tasks are unsupported and DCHECK, as with SequencedWorkerPool's runners.
+  scoped_refptr<TaskRunner> GetTaskRunner();
+
+  // Returns a new SequencedTaskRunner. Tasks posted to it run one at a time,
+  // in order, on pool threads. Each call returns an independent sequence.
+  scoped_refptr<SequencedTaskRunner> GetSequencedTaskRunner();
+
+  // Returns true iff the current thread is a worker owned by this scheduler.
+  bool RunsTasksOnCurrentThread() const;
+
+  // Blocks until all workers have joined. Tasks already posted are run first;
+  // posts racing with shutdown may be dropped. Test-only; production code
+  // leaks the pool.
+  void Shutdown();
+
+ private:
+  friend class RefCountedThreadSafe<WorkStealingTaskScheduler>;
+  friend class internal::WorkStealingWorker;
+
+  ~WorkStealingTaskScheduler();
+
+  // Called by workers: steals a task from a victim's deque or takes one from
+  // an injection queue. Returns a null closure if no work was found.
+  Closure FindWork(size_t worker_index);
+
+  // Returns the current work generation; workers capture it before scanning
+  // for work so that WaitForWork() can detect posts that raced with the scan.
+  uint64 GetWorkGeneration() const;
+
+  // Blocks until work newer than |generation| may be available or shutdown
+  // starts. Returns false when the worker should exit.
+  bool WaitForWork(uint64 generation);
+
+  // Wakes one sleeping worker if any work might be pending.
+  void SignalWork();
+
+  struct InjectionQueue;
+
+  const std::string thread_name_prefix_;
+
+  std::vector<internal::WorkStealingWorker*> workers_;
+
+  // Striped queues for posts from threads outside the pool. A poster picks a
+  // stripe by a round-robin counter, so two posters typically hit different
+  // locks.
+  std::vector<InjectionQueue*> injection_queues_;
+  subtle::Atomic32 next_injection_queue_;
+
+  // Guards |idle_workers_| and shutdown state; never held while running a
+  // task or while touching a deque.
+  mutable Lock idle_lock_;
+  ConditionVariable idle_cv_;
+  size_t idle_workers_;
+  // Incremented on every post; lets a worker that found nothing to do detect
+  // a post that landed between its scan and its wait.
+  uint64 work_generation_;
+  bool shutdown_called_;
+
+  DISALLOW_COPY_AND_ASSIGN(WorkStealingTaskScheduler);
+};
+
+}  // namespace base
+
+#endif  // BASE_THREADING_WORK_STEALING_TASK_SCHEDULER_H_
@@ -0,0 +1,100 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/threading/work_stealing_task_scheduler.h"
+
+#include <vector>
+
+#include "base/bind.h"
+#include "base/callback.h"
+#include "base/memory/ref_counted.h"
+#include "base/sequenced_task_runner.h"
+#include "base/synchronization/lock.h"
+#include "base/synchronization/waitable_event.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+
+namespace {
+
+class TaskTracker {
+ public:
+  TaskTracker() : count_(0), done_(true, false) {}
+
+  Closure MakeTask(int expected_total) {
+    return Bind(&TaskTracker::RunTask, Unretained(this), expected_total);
+  }
+
+  void RunTask(int expected_total) {
+    AutoLock lock(lock_);
+    if (++count_ == expected_total)
+      done_.Signal();
+  }
+
+  void RecordOrdered(int value, int expected_total) {
+    AutoLock lock(lock_);
+    order_.push_back(value);
+    if (++count_ == expected_total)
+      done_.Signal();
+  }
+
+  void WaitUntilDone() { done_.Wait(); }
+
+  std::vector<int> order() {
+    AutoLock lock(lock_);
+    return order_;
+  }
+
+ private:
+  Lock lock_;
+  int count_;
+  std::vector<int> order_;
+  WaitableEvent done_;
+};
+
+}  // namespace
+
+TEST(WorkStealingTaskSchedulerTest, RunsPostedTasks) {
+  scoped_refptr<WorkStealingTaskScheduler> scheduler(
+      new WorkStealingTaskScheduler(4, "Test"));
+  TaskTracker tracker;
+  const int kNumTasks = 100;
+  for (int i = 0; i < kNumTasks; ++i)
+    scheduler->PostWorkerTask(FROM_HERE, tracker.MakeTask(kNumTasks));
+  tracker.WaitUntilDone();
+  scheduler->Shutdown();
+}
+
+TEST(WorkStealingTaskSchedulerTest, TaskRunnerRunsTasksOnPoolThreads) {
+  scoped_refptr<WorkStealingTaskScheduler> scheduler(
+      new WorkStealingTaskScheduler(2, "Test"));
+  scoped_refptr<TaskRunner> runner = scheduler->GetTaskRunner();
+  EXPECT_FALSE(runner->RunsTasksOnCurrentThread());
+  TaskTracker tracker;
+  runner->PostTask(FROM_HERE, tracker.MakeTask(1));
+  tracker.WaitUntilDone();
+  scheduler->Shutdown();
+}
+
+TEST(WorkStealingTaskSchedulerTest, SequencedTasksRunInOrder) {
+  scoped_refptr<WorkStealingTaskScheduler> scheduler(
+      new WorkStealingTaskScheduler(4, "Test"));
+  scoped_refptr<SequencedTaskRunner> runner =
+      scheduler->GetSequencedTaskRunner();
+  TaskTracker tracker;
+  const int kNumTasks = 50;
+  for (int i = 0; i < kNumTasks; ++i) {
+    runner->PostTask(FROM_HERE,
+                     Bind(&TaskTracker::RecordOrdered, Unretained(&tracker),
+                          i, kNumTasks));
+  }
+  tracker.WaitUntilDone();
+  std::vector<int> order = tracker.order();
+  ASSERT_EQ(static_cast<size_t>(kNumTasks), order.size());
+  for (int i = 0; i < kNumTasks; ++i)
+    EXPECT_EQ(i, order[i]);
+  scheduler->Shutdown();
+}
+
+}  // namespace base
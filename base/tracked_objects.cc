@@ -112,6 +112,8 @@ void DeathData::RecordDeath(const int32 queue_duration,
     ++count_;
   queue_duration_sum_ += queue_duration;
   run_duration_sum_ += run_duration;
+  run_duration_sum_squares_ +=
+      static_cast<int64>(run_duration) * run_duration;
 
   if (queue_duration_max_ < queue_duration)
     queue_duration_max_ = queue_duration;
@@ -135,6 +137,10 @@ int DeathData::count() const { return count_; }
 
 int32 DeathData::run_duration_sum() const { return run_duration_sum_; }
 
+int64 DeathData::run_duration_sum_squares() const {
+  return run_duration_sum_squares_;
+}
+
 int32 DeathData::run_duration_max() const { return run_duration_max_; }
 
 int32 DeathData::run_duration_sample() const {
@@ -161,6 +167,7 @@ void DeathData::ResetMax() {
 void DeathData::Clear() {
   count_ = 0;
   run_duration_sum_ = 0;
+  run_duration_sum_squares_ = 0;
   run_duration_max_ = 0;
   run_duration_sample_ = 0;
   queue_duration_sum_ = 0;
@@ -172,6 +179,7 @@ void DeathData::Clear() {
 DeathDataSnapshot::DeathDataSnapshot()
     : count(-1),
       run_duration_sum(-1),
+      run_duration_sum_squares(-1),
       run_duration_max(-1),
       run_duration_sample(-1),
       queue_duration_sum(-1),
@@ -183,6 +191,7 @@ DeathDataSnapshot::DeathDataSnapshot(
     const tracked_objects::DeathData& death_data)
     : count(death_data.count()),
       run_duration_sum(death_data.run_duration_sum()),
+      run_duration_sum_squares(death_data.run_duration_sum_squares()),
       run_duration_max(death_data.run_duration_max()),
       run_duration_sample(death_data.run_duration_sample()),
       queue_duration_sum(death_data.queue_duration_sum()),
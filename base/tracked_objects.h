@@ -278,6 +278,7 @@ class BASE_EXPORT DeathData {
   // Metrics accessors, used only for serialization and in tests.
   int count() const;
   int32 run_duration_sum() const;
+  int64 run_duration_sum_squares() const;
   int32 run_duration_max() const;
   int32 run_duration_sample() const;
   int32 queue_duration_sum() const;
@@ -298,6 +299,11 @@ class BASE_EXPORT DeathData {
   // Basic tallies, used to compute averages.
   int32 run_duration_sum_;
   int32 queue_duration_sum_;
+  // Sum of squared run durations, used together with run_duration_sum_ and
+  // count_ to compute the variance of run times, which attributes aggregate
+  // cost to locations whose tasks are occasionally (rather than uniformly)
+  // expensive.
+  int64 run_duration_sum_squares_;
   // Max values, used by local visualization routines.  These are often read,
   // but rarely updated.
   int32 run_duration_max_;
@@ -318,6 +324,7 @@ struct BASE_EXPORT DeathDataSnapshot {
 
   int count;
   int32 run_duration_sum;
+  int64 run_duration_sum_squares;
   int32 run_duration_max;
   int32 run_duration_sample;
   int32 queue_duration_sum;
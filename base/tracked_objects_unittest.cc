@@ -236,6 +236,7 @@ TEST_F(TrackedObjectsTest, DeathDataTest) {
   scoped_ptr<DeathData> data(new DeathData());
   ASSERT_NE(data, reinterpret_cast<DeathData*>(NULL));
   EXPECT_EQ(data->run_duration_sum(), 0);
+  EXPECT_EQ(data->run_duration_sum_squares(), 0);
   EXPECT_EQ(data->run_duration_sample(), 0);
   EXPECT_EQ(data->queue_duration_sum(), 0);
   EXPECT_EQ(data->queue_duration_sample(), 0);
@@ -247,6 +248,8 @@ TEST_F(TrackedObjectsTest, DeathDataTest) {
   const int kUnrandomInt = 0;  // Fake random int that ensure we sample data.
   data->RecordDeath(queue_ms, run_ms, kUnrandomInt);
   EXPECT_EQ(data->run_duration_sum(), run_ms);
+  EXPECT_EQ(data->run_duration_sum_squares(),
+            static_cast<int64>(run_ms) * run_ms);
   EXPECT_EQ(data->run_duration_sample(), run_ms);
   EXPECT_EQ(data->queue_duration_sum(), queue_ms);
   EXPECT_EQ(data->queue_duration_sample(), queue_ms);
@@ -254,6 +257,8 @@ TEST_F(TrackedObjectsTest, DeathDataTest) {
 
   data->RecordDeath(queue_ms, run_ms, kUnrandomInt);
   EXPECT_EQ(data->run_duration_sum(), run_ms + run_ms);
+  EXPECT_EQ(data->run_duration_sum_squares(),
+            2 * static_cast<int64>(run_ms) * run_ms);
   EXPECT_EQ(data->run_duration_sample(), run_ms);
   EXPECT_EQ(data->queue_duration_sum(), queue_ms + queue_ms);
   EXPECT_EQ(data->queue_duration_sample(), queue_ms);
@@ -262,6 +267,8 @@ TEST_F(TrackedObjectsTest, DeathDataTest) {
   DeathDataSnapshot snapshot(*data);
   EXPECT_EQ(2, snapshot.count);
   EXPECT_EQ(2 * run_ms, snapshot.run_duration_sum);
+  EXPECT_EQ(2 * static_cast<int64>(run_ms) * run_ms,
+            snapshot.run_duration_sum_squares);
   EXPECT_EQ(run_ms, snapshot.run_duration_max);
   EXPECT_EQ(run_ms, snapshot.run_duration_sample);
   EXPECT_EQ(2 * queue_ms, snapshot.queue_duration_sum);
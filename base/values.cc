@@ -4,6 +4,7 @@
 
 #include "base/values.h"
 
+#include <stdlib.h>
 #include <string.h>
 
 #include <algorithm>
@@ -20,6 +21,35 @@ namespace base {
 
 namespace {
 
+// Header prepended to every Value allocation (heap or arena) so that
+// Value::operator delete can tell the two apart. The union keeps the
+// following object aligned for any Value subclass.
+union ValueAllocationHeader {
+  // Non-NULL iff the node was allocated from an arena.
+  ValueArena* arena;
+  double align_double;
+  void* align_pointer;
+};
+
+const size_t kValueHeaderSize = sizeof(ValueAllocationHeader);
+
+ValueAllocationHeader* HeaderForValue(void* ptr) {
+  return reinterpret_cast<ValueAllocationHeader*>(
+      static_cast<char*>(ptr) - kValueHeaderSize);
+}
+
+}  // namespace
+
+// Blocks hold the usable memory immediately after the struct itself.
+struct ValueArena::Block {
+  size_t size;
+  size_t used;
+
+  char* start() { return reinterpret_cast<char*>(this + 1); }
+};
+
+namespace {
+
 // Make a deep copy of |node|, but don't include empty lists or dictionaries
 // in the copy. It's possible for this function to return NULL and it
 // expects |node| to always be non-NULL.
@@ -81,6 +111,70 @@ class ValueEquals {
 
 }  // namespace
 
+ValueArena::ValueArena() : bytes_allocated_(0) {
+}
+
+ValueArena::~ValueArena() {
+  for (size_t i = 0; i < blocks_.size(); ++i)
+    free(blocks_[i]);
+}
+
+void* ValueArena::Allocate(size_t size) {
+  // Keep every allocation aligned for the header union.
+  size = (size + kValueHeaderSize - 1) & ~(kValueHeaderSize - 1);
+  Block* block = blocks_.empty() ? NULL : blocks_.back();
+  if (!block || block->size - block->used < size)
+    block = AddBlock(size);
+  void* result = block->start() + block->used;
+  block->used += size;
+  bytes_allocated_ += size;
+  return result;
+}
+
+ValueArena::Block* ValueArena::AddBlock(size_t minimum_size) {
+  // 32K blocks amortize malloc; oversized requests get their own block.
+  const size_t kDefaultBlockSize = 32768;
+  size_t size = std::max(minimum_size, kDefaultBlockSize);
+  Block* block = static_cast<Block*>(malloc(sizeof(Block) + size));
+  CHECK(block);
+  block->size = size;
+  block->used = 0;
+  blocks_.push_back(block);
+  return block;
+}
+
+void* Value::operator new(size_t size) {
+  void* base = malloc(kValueHeaderSize + size);
+  CHECK(base);
+  ValueAllocationHeader* header =
+      static_cast<ValueAllocationHeader*>(base);
+  header->arena = NULL;
+  return static_cast<char*>(base) + kValueHeaderSize;
+}
+
+void* Value::operator new(size_t size, ValueArena* arena) {
+  DCHECK(arena);
+  void* base = arena->Allocate(kValueHeaderSize + size);
+  ValueAllocationHeader* header =
+      static_cast<ValueAllocationHeader*>(base);
+  header->arena = arena;
+  return static_cast<char*>(base) + kValueHeaderSize;
+}
+
+void Value::operator delete(void* ptr) {
+  if (!ptr)
+    return;
+  ValueAllocationHeader* header = HeaderForValue(ptr);
+  // Arena nodes are reclaimed wholesale when the arena dies.
+  if (!header->arena)
+    free(header);
+}
+
+void Value::operator delete(void* ptr, ValueArena* arena) {
+  // Only reached if a constructor throws during arena placement new; the
+  // memory stays in the arena.
+}
+
 Value::~Value() {
 }
 
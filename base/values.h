@@ -42,6 +42,43 @@ class Value;
 typedef std::vector<Value*> ValueVector;
 typedef std::map<std::string, Value*> ValueMap;
 
+// A region allocator for Value trees. Values placed in an arena via
+// |new (&arena) DictionaryValue()| have their node storage bump-allocated
+// from large contiguous blocks instead of the general heap. Deleting such a
+// Value runs its destructor as usual (releasing heap-held strings etc.) but
+// the node memory itself is reclaimed only when the arena is destroyed, in
+// one shot. This suits read-mostly trees that are built once and die
+// together, e.g. preferences and extension manifests, where per-node
+// malloc/free is a measurable fraction of load time and a long-lived source
+// of heap fragmentation.
+//
+// Arena and heap Values can be mixed freely in one tree; each node remembers
+// where it came from. The arena must outlive every Value allocated from it.
+// ValueArena is not thread safe.
+class BASE_EXPORT ValueArena {
+ public:
+  ValueArena();
+  ~ValueArena();
+
+  // Returns |size| bytes suitably aligned for any Value subclass. Called by
+  // Value::operator new(size_t, ValueArena*); not generally useful directly.
+  void* Allocate(size_t size);
+
+  // Total bytes handed out, for memory accounting.
+  size_t bytes_allocated() const { return bytes_allocated_; }
+
+ private:
+  struct Block;
+
+  // Adds a block of at least |minimum_size| usable bytes.
+  Block* AddBlock(size_t minimum_size);
+
+  std::vector<Block*> blocks_;
+  size_t bytes_allocated_;
+
+  DISALLOW_COPY_AND_ASSIGN(ValueArena);
+};
+
 // The Value class is the base class for Values. A Value can be instantiated
 // via the Create*Value() factory methods, or by directly creating instances of
 // the subclasses.
@@ -63,6 +100,14 @@ class BASE_EXPORT Value {
 
   virtual ~Value();
 
+  // All Values carry a small allocation header recording whether they came
+  // from the heap or from a ValueArena, so existing |delete| sites work
+  // unchanged for both kinds of node.
+  void* operator new(size_t size);
+  void* operator new(size_t size, ValueArena* arena);
+  void operator delete(void* ptr);
+  void operator delete(void* ptr, ValueArena* arena);
+
   static Value* CreateNullValue();
   // DEPRECATED: Do not use the following 5 functions. Instead, use
   // new FundamentalValue or new StringValue.
@@ -1094,4 +1094,35 @@ TEST(ValuesTest, GetWithNullOutValue) {
   EXPECT_FALSE(main_list.GetList(7, NULL));
 }
 
+
+TEST(ValuesTest, ArenaAllocatedTree) {
+  ValueArena arena;
+  DictionaryValue* root = new (&arena) DictionaryValue;
+  root->Set("list", new (&arena) ListValue);
+  root->SetString("key", "value");
+  root->SetInteger("int", 42);
+  ListValue* list = NULL;
+  ASSERT_TRUE(root->GetList("list", &list));
+  list->Append(new (&arena) StringValue("element"));
+  EXPECT_GT(arena.bytes_allocated(), 0u);
+
+  std::string string_value;
+  EXPECT_TRUE(root->GetString("key", &string_value));
+  EXPECT_EQ("value", string_value);
+
+  // Deleting the root runs destructors but leaves node memory to the arena.
+  delete root;
+}
+
+TEST(ValuesTest, ArenaAndHeapValuesCanMix) {
+  ValueArena arena;
+  scoped_ptr<DictionaryValue> root(new DictionaryValue);
+  root->Set("arena", new (&arena) FundamentalValue(true));
+  root->Set("heap", new FundamentalValue(2.5));
+  bool bool_value = false;
+  EXPECT_TRUE(root->GetBoolean("arena", &bool_value));
+  EXPECT_TRUE(bool_value);
+  root.reset();
+}
+
 }  // namespace base
@@ -0,0 +1,319 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "cc/base/span_region.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "base/logging.h"
+
+namespace cc {
+
+namespace {
+
+// The 1-d routines below operate on sorted, disjoint lists of half-open
+// [left, right) spans stored as consecutive int pairs.
+
+void UnionSpans(const int* a,
+                size_t a_size,
+                const int* b,
+                size_t b_size,
+                std::vector<int>* out) {
+  size_t ia = 0;
+  size_t ib = 0;
+  while (ia < a_size || ib < b_size) {
+    int left;
+    int right;
+    if (ia < a_size && (ib >= b_size || a[ia] <= b[ib])) {
+      left = a[ia];
+      right = a[ia + 1];
+      ia += 2;
+    } else {
+      left = b[ib];
+      right = b[ib + 1];
+      ib += 2;
+    }
+    // Absorb any spans that overlap or touch the one being built.
+    for (;;) {
+      if (ia < a_size && a[ia] <= right) {
+        right = std::max(right, a[ia + 1]);
+        ia += 2;
+      } else if (ib < b_size && b[ib] <= right) {
+        right = std::max(right, b[ib + 1]);
+        ib += 2;
+      } else {
+        break;
+      }
+    }
+    out->push_back(left);
+    out->push_back(right);
+  }
+}
+
+void SubtractSpans(const int* a,
+                   size_t a_size,
+                   const int* b,
+                   size_t b_size,
+                   std::vector<int>* out) {
+  size_t ib = 0;
+  for (size_t ia = 0; ia < a_size; ia += 2) {
+    int left = a[ia];
+    int right = a[ia + 1];
+    while (ib < b_size && b[ib + 1] <= left)
+      ib += 2;
+    // A subtracted span may extend into the next span of |a|, so scan with a
+    // local index and leave |ib| at the first span that may matter again.
+    size_t j = ib;
+    while (left < right && j < b_size && b[j] < right) {
+      if (b[j] > left) {
+        out->push_back(left);
+        out->push_back(b[j]);
+      }
+      left = std::max(left, b[j + 1]);
+      if (b[j + 1] <= right)
+        j += 2;
+      else
+        break;
+    }
+    if (left < right) {
+      out->push_back(left);
+      out->push_back(right);
+    }
+  }
+}
+
+void IntersectSpans(const int* a,
+                    size_t a_size,
+                    const int* b,
+                    size_t b_size,
+                    std::vector<int>* out) {
+  size_t ia = 0;
+  size_t ib = 0;
+  while (ia < a_size && ib < b_size) {
+    int left = std::max(a[ia], b[ib]);
+    int right = std::min(a[ia + 1], b[ib + 1]);
+    if (left < right) {
+      out->push_back(left);
+      out->push_back(right);
+    }
+    if (a[ia + 1] < b[ib + 1])
+      ia += 2;
+    else
+      ib += 2;
+  }
+}
+
+}  // namespace
+
+SpanRegion::SpanRegion() {}
+
+SpanRegion::SpanRegion(const gfx::Rect& rect) {
+  *this = rect;
+}
+
+SpanRegion::SpanRegion(const Region& region) {
+  for (Region::Iterator rects(region); rects.has_rect(); rects.next())
+    Union(rects.rect());
+}
+
+SpanRegion::~SpanRegion() {}
+
+const SpanRegion& SpanRegion::operator=(const gfx::Rect& rect) {
+  Clear();
+  if (!rect.IsEmpty()) {
+    Band band;
+    band.top = rect.y();
+    band.bottom = rect.bottom();
+    band.begin = 0;
+    band.end = 2;
+    bands_.push_back(band);
+    spans_.push_back(rect.x());
+    spans_.push_back(rect.right());
+  }
+  return *this;
+}
+
+void SpanRegion::Swap(SpanRegion* region) {
+  bands_.swap(region->bands_);
+  spans_.swap(region->spans_);
+}
+
+void SpanRegion::Clear() {
+  bands_.clear();
+  spans_.clear();
+}
+
+void SpanRegion::Subtract(const gfx::Rect& rect) {
+  if (IsEmpty() || rect.IsEmpty())
+    return;
+  Subtract(SpanRegion(rect));
+}
+
+void SpanRegion::Subtract(const SpanRegion& region) {
+  if (IsEmpty() || region.IsEmpty())
+    return;
+  SpanRegion result;
+  Combine(*this, region, COMBINE_SUBTRACT, &result);
+  Swap(&result);
+}
+
+void SpanRegion::Union(const gfx::Rect& rect) {
+  if (rect.IsEmpty())
+    return;
+  Union(SpanRegion(rect));
+}
+
+void SpanRegion::Union(const SpanRegion& region) {
+  if (region.IsEmpty())
+    return;
+  SpanRegion result;
+  Combine(*this, region, COMBINE_UNION, &result);
+  Swap(&result);
+}
+
+void SpanRegion::Intersect(const gfx::Rect& rect) {
+  if (IsEmpty())
+    return;
+  if (rect.IsEmpty()) {
+    Clear();
+    return;
+  }
+  SpanRegion result;
+  Combine(*this, SpanRegion(rect), COMBINE_INTERSECT, &result);
+  Swap(&result);
+}
+
+gfx::Rect SpanRegion::bounds() const {
+  if (IsEmpty())
+    return gfx::Rect();
+  int left = std::numeric_limits<int>::max();
+  int right = std::numeric_limits<int>::min();
+  for (size_t i = 0; i < bands_.size(); ++i) {
+    left = std::min(left, spans_[bands_[i].begin]);
+    right = std::max(right, spans_[bands_[i].end - 1]);
+  }
+  int top = bands_.front().top;
+  int bottom = bands_.back().bottom;
+  return gfx::Rect(left, top, right - left, bottom - top);
+}
+
+Region SpanRegion::ToRegion() const {
+  Region region;
+  for (Iterator rects(*this); rects.has_rect(); rects.next())
+    region.Union(rects.rect());
+  return region;
+}
+
+// static
+void SpanRegion::Combine(const SpanRegion& a,
+                         const SpanRegion& b,
+                         CombineOp op,
+                         SpanRegion* out) {
+  DCHECK(out->IsEmpty());
+  DCHECK(out != &a);
+  DCHECK(out != &b);
+
+  size_t ia = 0;
+  size_t ib = 0;
+  std::vector<int> merged;
+  int y = std::numeric_limits<int>::min();
+  for (;;) {
+    while (ia < a.bands_.size() && a.bands_[ia].bottom <= y)
+      ++ia;
+    while (ib < b.bands_.size() && b.bands_[ib].bottom <= y)
+      ++ib;
+    if (ia == a.bands_.size() && ib == b.bands_.size())
+      break;
+
+    // The next y-segment starts at the closest band top at or below |y|, and
+    // ends at the next band boundary that changes which spans are active.
+    int seg_top = std::numeric_limits<int>::max();
+    if (ia < a.bands_.size())
+      seg_top = std::min(seg_top, std::max(a.bands_[ia].top, y));
+    if (ib < b.bands_.size())
+      seg_top = std::min(seg_top, std::max(b.bands_[ib].top, y));
+
+    int seg_bottom = std::numeric_limits<int>::max();
+    bool a_active = false;
+    bool b_active = false;
+    if (ia < a.bands_.size()) {
+      if (a.bands_[ia].top > seg_top) {
+        seg_bottom = std::min(seg_bottom, a.bands_[ia].top);
+      } else {
+        seg_bottom = std::min(seg_bottom, a.bands_[ia].bottom);
+        a_active = true;
+      }
+    }
+    if (ib < b.bands_.size()) {
+      if (b.bands_[ib].top > seg_top) {
+        seg_bottom = std::min(seg_bottom, b.bands_[ib].top);
+      } else {
+        seg_bottom = std::min(seg_bottom, b.bands_[ib].bottom);
+        b_active = true;
+      }
+    }
+
+    const int* a_spans = NULL;
+    size_t a_size = 0;
+    if (a_active) {
+      a_spans = &a.spans_[a.bands_[ia].begin];
+      a_size = a.bands_[ia].end - a.bands_[ia].begin;
+    }
+    const int* b_spans = NULL;
+    size_t b_size = 0;
+    if (b_active) {
+      b_spans = &b.spans_[b.bands_[ib].begin];
+      b_size = b.bands_[ib].end - b.bands_[ib].begin;
+    }
+
+    merged.clear();
+    switch (op) {
+      case COMBINE_UNION:
+        UnionSpans(a_spans, a_size, b_spans, b_size, &merged);
+        break;
+      case COMBINE_SUBTRACT:
+        SubtractSpans(a_spans, a_size, b_spans, b_size, &merged);
+        break;
+      case COMBINE_INTERSECT:
+        IntersectSpans(a_spans, a_size, b_spans, b_size, &merged);
+        break;
+    }
+    if (!merged.empty())
+      out->AppendBand(seg_top, seg_bottom, merged);
+
+    y = seg_bottom;
+  }
+}
+
+void SpanRegion::AppendBand(int top,
+                            int bottom,
+                            const std::vector<int>& spans) {
+  DCHECK_LT(top, bottom);
+  DCHECK(!spans.empty());
+  if (!bands_.empty()) {
+    Band& last = bands_.back();
+    if (last.bottom == top && last.end - last.begin == spans.size() &&
+        std::equal(spans.begin(), spans.end(), spans_.begin() + last.begin)) {
+      last.bottom = bottom;
+      return;
+    }
+  }
+  Band band;
+  band.top = top;
+  band.bottom = bottom;
+  band.begin = spans_.size();
+  spans_.insert(spans_.end(), spans.begin(), spans.end());
+  band.end = spans_.size();
+  bands_.push_back(band);
+}
+
+SpanRegion::Iterator::Iterator(const SpanRegion& region)
+    : region_(&region),
+      band_index_(0),
+      span_index_(region.bands_.empty() ? 0 : region.bands_[0].begin) {}
+
+SpanRegion::Iterator::~Iterator() {}
+
+}  // namespace cc
@@ -0,0 +1,98 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CC_BASE_SPAN_REGION_H_
+#define CC_BASE_SPAN_REGION_H_
+
+#include <vector>
+
+#include "cc/base/cc_export.h"
+#include "cc/base/region.h"
+#include "ui/gfx/rect.h"
+
+namespace cc {
+
+// A set of axis-aligned rects stored as sorted horizontal bands of x-spans
+// held in contiguous arrays. It covers exactly the same point sets as Region,
+// but its merge loops walk flat vectors linearly instead of chasing
+// SkRegion's run records, which makes the thousands of Union and Subtract
+// operations the occlusion tracker performs per frame considerably cheaper.
+// Convert with ToRegion() only at boundaries where a Region is required.
+class CC_EXPORT SpanRegion {
+ public:
+  SpanRegion();
+  SpanRegion(const gfx::Rect& rect);  // NOLINT(runtime/explicit)
+  explicit SpanRegion(const Region& region);
+  ~SpanRegion();
+
+  const SpanRegion& operator=(const gfx::Rect& rect);
+
+  void Swap(SpanRegion* region);
+  void Clear();
+  bool IsEmpty() const { return bands_.empty(); }
+
+  void Subtract(const gfx::Rect& rect);
+  void Subtract(const SpanRegion& region);
+  void Union(const gfx::Rect& rect);
+  void Union(const SpanRegion& region);
+  void Intersect(const gfx::Rect& rect);
+
+  gfx::Rect bounds() const;
+
+  Region ToRegion() const;
+
+  class CC_EXPORT Iterator {
+   public:
+    explicit Iterator(const SpanRegion& region);
+    ~Iterator();
+
+    gfx::Rect rect() const {
+      const Band& band = region_->bands_[band_index_];
+      int left = region_->spans_[span_index_];
+      int right = region_->spans_[span_index_ + 1];
+      return gfx::Rect(left, band.top, right - left, band.bottom - band.top);
+    }
+
+    void next() {
+      span_index_ += 2;
+      if (span_index_ >= region_->bands_[band_index_].end) {
+        ++band_index_;
+        if (band_index_ < region_->bands_.size())
+          span_index_ = region_->bands_[band_index_].begin;
+      }
+    }
+
+    bool has_rect() const { return band_index_ < region_->bands_.size(); }
+
+   private:
+    const SpanRegion* region_;
+    size_t band_index_;
+    size_t span_index_;
+  };
+
+ private:
+  // A horizontal band [top, bottom) whose x-spans are the half-open
+  // [left, right) pairs stored at spans_[begin, end).
+  struct Band {
+    int top;
+    int bottom;
+    size_t begin;
+    size_t end;
+  };
+
+  enum CombineOp { COMBINE_UNION, COMBINE_SUBTRACT, COMBINE_INTERSECT };
+
+  static void Combine(const SpanRegion& a,
+                      const SpanRegion& b,
+                      CombineOp op,
+                      SpanRegion* out);
+  void AppendBand(int top, int bottom, const std::vector<int>& spans);
+
+  std::vector<Band> bands_;
+  std::vector<int> spans_;
+};
+
+}  // namespace cc
+
+#endif  // CC_BASE_SPAN_REGION_H_
@@ -0,0 +1,173 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "cc/base/span_region.h"
+
+#include "base/basictypes.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace cc {
+namespace {
+
+// SpanRegion must cover exactly the same point sets as Region, so most tests
+// here apply the same sequence of operations to both and compare the results
+// through ToRegion(). SkRegion keeps a canonical form, so regions covering
+// the same points always compare equal.
+
+TEST(SpanRegionTest, Empty) {
+  SpanRegion r;
+  EXPECT_TRUE(r.IsEmpty());
+  EXPECT_EQ(gfx::Rect(), r.bounds());
+  EXPECT_EQ(Region(), r.ToRegion());
+
+  r = gfx::Rect(2, 3, 4, 5);
+  EXPECT_FALSE(r.IsEmpty());
+  r.Clear();
+  EXPECT_TRUE(r.IsEmpty());
+
+  r = gfx::Rect(2, 3, 0, 0);
+  EXPECT_TRUE(r.IsEmpty());
+}
+
+TEST(SpanRegionTest, SingleRect) {
+  SpanRegion r(gfx::Rect(10, 20, 30, 40));
+  EXPECT_FALSE(r.IsEmpty());
+  EXPECT_EQ(gfx::Rect(10, 20, 30, 40), r.bounds());
+  EXPECT_EQ(Region(gfx::Rect(10, 20, 30, 40)), r.ToRegion());
+
+  SpanRegion::Iterator it(r);
+  ASSERT_TRUE(it.has_rect());
+  EXPECT_EQ(gfx::Rect(10, 20, 30, 40), it.rect());
+  it.next();
+  EXPECT_FALSE(it.has_rect());
+}
+
+TEST(SpanRegionTest, UnionMatchesRegion) {
+  gfx::Rect rects[] = {
+    gfx::Rect(0, 0, 10, 10),      // Starting rect.
+    gfx::Rect(0, 0, 10, 10),      // Same rect again.
+    gfx::Rect(5, 5, 10, 10),      // Overlapping.
+    gfx::Rect(10, 0, 10, 10),     // Sharing an edge.
+    gfx::Rect(50, 50, 10, 10),    // Disjoint.
+    gfx::Rect(0, 10, 60, 5),      // Spanning several bands.
+    gfx::Rect(-20, -20, 10, 10),  // Negative coordinates.
+  };
+
+  SpanRegion span_region;
+  Region region;
+  for (size_t i = 0; i < arraysize(rects); ++i) {
+    span_region.Union(rects[i]);
+    region.Union(rects[i]);
+    EXPECT_EQ(region, span_region.ToRegion()) << "i = " << i;
+    EXPECT_EQ(region.bounds(), span_region.bounds()) << "i = " << i;
+  }
+}
+
+TEST(SpanRegionTest, SubtractMatchesRegion) {
+  gfx::Rect start(0, 0, 100, 100);
+  gfx::Rect rects[] = {
+    gfx::Rect(200, 200, 10, 10),  // Disjoint; no change.
+    gfx::Rect(0, 0, 10, 10),      // A corner.
+    gfx::Rect(40, 40, 20, 20),    // A hole in the middle.
+    gfx::Rect(-10, 70, 200, 10),  // A full-width strip.
+    gfx::Rect(90, 0, 20, 200),    // A full-height strip.
+    gfx::Rect(0, 0, 100, 100),    // Everything that is left.
+  };
+
+  SpanRegion span_region(start);
+  Region region(start);
+  for (size_t i = 0; i < arraysize(rects); ++i) {
+    span_region.Subtract(rects[i]);
+    region.Subtract(rects[i]);
+    EXPECT_EQ(region, span_region.ToRegion()) << "i = " << i;
+  }
+  EXPECT_TRUE(span_region.IsEmpty());
+}
+
+TEST(SpanRegionTest, SubtractRegion) {
+  SpanRegion r(gfx::Rect(0, 0, 100, 100));
+  SpanRegion holes;
+  holes.Union(gfx::Rect(10, 10, 10, 10));
+  holes.Union(gfx::Rect(30, 10, 10, 10));
+  holes.Union(gfx::Rect(10, 50, 80, 10));
+  r.Subtract(holes);
+
+  Region expected(gfx::Rect(0, 0, 100, 100));
+  expected.Subtract(gfx::Rect(10, 10, 10, 10));
+  expected.Subtract(gfx::Rect(30, 10, 10, 10));
+  expected.Subtract(gfx::Rect(10, 50, 80, 10));
+  EXPECT_EQ(expected, r.ToRegion());
+}
+
+TEST(SpanRegionTest, UnionRegion) {
+  SpanRegion a;
+  a.Union(gfx::Rect(0, 0, 10, 30));
+  a.Union(gfx::Rect(40, 10, 10, 10));
+  SpanRegion b;
+  b.Union(gfx::Rect(5, 5, 40, 10));
+  b.Union(gfx::Rect(0, 50, 10, 10));
+  a.Union(b);
+
+  Region expected;
+  expected.Union(gfx::Rect(0, 0, 10, 30));
+  expected.Union(gfx::Rect(40, 10, 10, 10));
+  expected.Union(gfx::Rect(5, 5, 40, 10));
+  expected.Union(gfx::Rect(0, 50, 10, 10));
+  EXPECT_EQ(expected, a.ToRegion());
+}
+
+TEST(SpanRegionTest, IntersectMatchesRegion) {
+  SpanRegion span_region;
+  Region region;
+  gfx::Rect rects[] = {
+    gfx::Rect(0, 0, 10, 10),
+    gfx::Rect(20, 0, 10, 10),
+    gfx::Rect(0, 20, 30, 10),
+  };
+  for (size_t i = 0; i < arraysize(rects); ++i) {
+    span_region.Union(rects[i]);
+    region.Union(rects[i]);
+  }
+
+  span_region.Intersect(gfx::Rect(5, 5, 20, 20));
+  region.Intersect(gfx::Rect(5, 5, 20, 20));
+  EXPECT_EQ(region, span_region.ToRegion());
+
+  span_region.Intersect(gfx::Rect(200, 200, 10, 10));
+  EXPECT_TRUE(span_region.IsEmpty());
+}
+
+TEST(SpanRegionTest, FromRegion) {
+  Region region;
+  region.Union(gfx::Rect(0, 0, 10, 10));
+  region.Union(gfx::Rect(20, 5, 10, 10));
+  region.Union(gfx::Rect(0, 30, 50, 10));
+
+  SpanRegion span_region(region);
+  EXPECT_EQ(region, span_region.ToRegion());
+  EXPECT_EQ(region.bounds(), span_region.bounds());
+}
+
+TEST(SpanRegionTest, IteratorCoversEveryRect) {
+  SpanRegion r;
+  r.Union(gfx::Rect(0, 0, 10, 10));
+  r.Union(gfx::Rect(20, 0, 10, 20));
+  r.Union(gfx::Rect(0, 40, 30, 10));
+
+  Region rebuilt;
+  for (SpanRegion::Iterator it(r); it.has_rect(); it.next())
+    rebuilt.Union(it.rect());
+  EXPECT_EQ(r.ToRegion(), rebuilt);
+}
+
+TEST(SpanRegionTest, Swap) {
+  SpanRegion a(gfx::Rect(0, 0, 10, 10));
+  SpanRegion b(gfx::Rect(20, 20, 10, 10));
+  a.Swap(&b);
+  EXPECT_EQ(Region(gfx::Rect(20, 20, 10, 10)), a.ToRegion());
+  EXPECT_EQ(Region(gfx::Rect(0, 0, 10, 10)), b.ToRegion());
+}
+
+}  // namespace
+}  // namespace cc
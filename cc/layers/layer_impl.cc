@@ -412,6 +412,18 @@ void LayerImpl::ApplyScrollDeltasSinceBeginMainFrame() {
   }
 }
 
+void LayerImpl::SetHaveWheelEventHandlers(bool have_wheel_event_handlers) {
+  if (have_wheel_event_handlers_ == have_wheel_event_handlers)
+    return;
+  have_wheel_event_handlers_ = have_wheel_event_handlers;
+  layer_tree_impl()->set_hit_test_candidate_layers_dirty();
+}
+
+void LayerImpl::SetTouchEventHandlerRegion(const Region& region) {
+  touch_event_handler_region_ = region;
+  layer_tree_impl()->set_hit_test_candidate_layers_dirty();
+}
+
 InputHandler::ScrollStatus LayerImpl::TryScroll(
     const gfx::PointF& screen_space_point,
     InputHandler::ScrollInputType type) const {
@@ -684,6 +696,13 @@ void LayerImpl::NoteLayerPropertyChangedForSubtree() {
   SetNeedsPushProperties();
 }
 
+void LayerImpl::NoteAnimatedPropertyChangedForSubtree() {
+  layer_property_changed_ = true;
+  layer_tree_impl()->set_needs_update_draw_properties();
+  for (size_t i = 0; i < children_.size(); ++i)
+    children_[i]->NoteLayerPropertyChangedForDescendantsInternal();
+}
+
 void LayerImpl::NoteLayerPropertyChangedForDescendantsInternal() {
   layer_property_changed_ = true;
   for (size_t i = 0; i < children_.size(); ++i)
@@ -730,15 +749,28 @@ gfx::Vector2dF LayerImpl::ScrollOffsetForAnimation() const {
 }
 
 void LayerImpl::OnFilterAnimated(const FilterOperations& filters) {
-  SetFilters(filters);
+  if (filters_ == filters)
+    return;
+
+  filters_ = filters;
+  NoteAnimatedPropertyChangedForSubtree();
 }
 
 void LayerImpl::OnOpacityAnimated(float opacity) {
-  SetOpacity(opacity);
+  if (opacity_ == opacity)
+    return;
+
+  opacity_ = opacity;
+  NoteAnimatedPropertyChangedForSubtree();
 }
 
 void LayerImpl::OnTransformAnimated(const gfx::Transform& transform) {
-  SetTransform(transform);
+  if (transform_ == transform)
+    return;
+
+  transform_ = transform;
+  transform_is_invertible_ = transform_.IsInvertible();
+  NoteAnimatedPropertyChangedForSubtree();
 }
 
 void LayerImpl::OnScrollOffsetAnimated(const gfx::Vector2dF& scroll_offset) {
@@ -416,9 +416,7 @@ class CC_EXPORT LayerImpl : public LayerAnimationValueObserver,
     return should_scroll_on_main_thread_;
   }
 
-  void SetHaveWheelEventHandlers(bool have_wheel_event_handlers) {
-    have_wheel_event_handlers_ = have_wheel_event_handlers;
-  }
+  void SetHaveWheelEventHandlers(bool have_wheel_event_handlers);
   bool have_wheel_event_handlers() const { return have_wheel_event_handlers_; }
 
   void SetHaveScrollEventHandlers(bool have_scroll_event_handlers) {
@@ -435,9 +433,7 @@ class CC_EXPORT LayerImpl : public LayerAnimationValueObserver,
     return non_fast_scrollable_region_;
   }
 
-  void SetTouchEventHandlerRegion(const Region& region) {
-    touch_event_handler_region_ = region;
-  }
+  void SetTouchEventHandlerRegion(const Region& region);
   const Region& touch_event_handler_region() const {
     return touch_event_handler_region_;
   }
@@ -568,6 +564,14 @@ class CC_EXPORT LayerImpl : public LayerAnimationValueObserver,
   void NoteLayerPropertyChanged();
   void NoteLayerPropertyChangedForSubtree();
 
+  // Like NoteLayerPropertyChangedForSubtree(), but does not mark the layer as
+  // needing push properties. Used for animated property changes: animated
+  // values are produced by the animation controllers, which tick the layers
+  // on both trees directly, so they never need to be synced through a commit
+  // or activation, and requesting a push here would re-dirty the layer's
+  // whole ancestor chain on every animation frame.
+  void NoteAnimatedPropertyChangedForSubtree();
+
   // Note carefully this does not affect the current layer.
   void NoteLayerPropertyChangedForDescendants();
 
@@ -241,6 +241,49 @@ TEST(LayerImplTest, VerifyLayerChangesAreTrackedProperly) {
       root->SetClipChildren(clip_children));
 }
 
+TEST(LayerImplTest, AnimatedPropertyChangesDoNotNeedPushProperties) {
+  // Animated property changes come from the animation controllers, which tick
+  // the layers on both trees directly, so they should mark the subtree as
+  // changed without requesting a push of properties.
+  FakeImplProxy proxy;
+  TestSharedBitmapManager shared_bitmap_manager;
+  FakeLayerTreeHostImpl host_impl(&proxy, &shared_bitmap_manager);
+  EXPECT_TRUE(host_impl.InitializeRenderer(
+      FakeOutputSurface::Create3d().PassAs<OutputSurface>()));
+  host_impl.active_tree()->SetRootLayer(
+      LayerImpl::Create(host_impl.active_tree(), 1));
+  LayerImpl* root = host_impl.active_tree()->root_layer();
+  root->AddChild(LayerImpl::Create(host_impl.active_tree(), 2));
+  LayerImpl* child = root->children()[0];
+
+  gfx::Transform arbitrary_transform;
+  arbitrary_transform.Scale3d(0.1f, 0.2f, 0.3f);
+  FilterOperations arbitrary_filters;
+  arbitrary_filters.Append(FilterOperation::CreateOpacityFilter(0.5f));
+
+  root->ResetAllChangeTrackingForSubtree();
+  root->OnOpacityAnimated(0.5f);
+  EXPECT_TRUE(root->LayerPropertyChanged());
+  EXPECT_TRUE(child->LayerPropertyChanged());
+  EXPECT_TRUE(host_impl.active_tree()->needs_update_draw_properties());
+  EXPECT_FALSE(root->needs_push_properties());
+  EXPECT_FALSE(child->needs_push_properties());
+
+  root->ResetAllChangeTrackingForSubtree();
+  host_impl.ForcePrepareToDraw();
+  root->OnTransformAnimated(arbitrary_transform);
+  EXPECT_TRUE(root->LayerPropertyChanged());
+  EXPECT_TRUE(host_impl.active_tree()->needs_update_draw_properties());
+  EXPECT_FALSE(root->needs_push_properties());
+
+  root->ResetAllChangeTrackingForSubtree();
+  host_impl.ForcePrepareToDraw();
+  root->OnFilterAnimated(arbitrary_filters);
+  EXPECT_TRUE(root->LayerPropertyChanged());
+  EXPECT_TRUE(host_impl.active_tree()->needs_update_draw_properties());
+  EXPECT_FALSE(root->needs_push_properties());
+}
+
 TEST(LayerImplTest, VerifyNeedsUpdateDrawProperties) {
   FakeImplProxy proxy;
   TestSharedBitmapManager shared_bitmap_manager;
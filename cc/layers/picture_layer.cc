@@ -71,6 +71,8 @@ void PictureLayer::SetLayerTreeHost(LayerTreeHost* host) {
         host->debug_state().slow_down_raster_scale_factor);
     pile_->set_show_debug_picture_borders(
         host->debug_state().show_picture_borders);
+    pile_->set_detect_identical_recordings(
+        host->settings().detect_identical_recordings);
   }
 }
 
@@ -42,7 +42,7 @@ class TestOcclusionTracker : public OcclusionTracker<Layer> {
   }
 
   void SetOcclusion(const Region& occlusion) {
-    stack_.back().occlusion_from_inside_target = occlusion;
+    stack_.back().occlusion_from_inside_target = SpanRegion(occlusion);
   }
 };
 
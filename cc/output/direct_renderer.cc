@@ -13,6 +13,7 @@
 #include "base/metrics/histogram.h"
 #include "cc/base/math_util.h"
 #include "cc/output/copy_output_request.h"
+#include "cc/output/output_surface.h"
 #include "cc/quads/draw_quad.h"
 #include "cc/resources/raster_worker_pool.h"
 #include "ui/gfx/rect_conversions.h"
@@ -210,6 +211,13 @@ void DirectRenderer::DrawFrame(RenderPassList* render_passes_in_draw_order,
   frame.root_damage_rect = Capabilities().using_partial_swap
                                ? root_render_pass->damage_rect
                                : root_render_pass->output_rect;
+  if (Capabilities().using_partial_swap) {
+    // If the buffer being drawn into holds a frame older than the last one
+    // swapped, it is also missing the damage of the swaps in between, so that
+    // region has to be repainted as well.
+    frame.root_damage_rect.Union(output_surface_->AccumulatedDamageForBufferAge(
+        output_surface_->GetCurrentBufferAge()));
+  }
   frame.root_damage_rect.Intersect(gfx::Rect(device_viewport_rect.size()));
   frame.device_viewport_rect = device_viewport_rect;
   frame.device_clip_rect = device_clip_rect;
@@ -1103,8 +1103,8 @@ void GLRenderer::DrawRenderPassQuad(DrawingFrame* frame,
   if (use_aa && mask_texture_id && !use_color_matrix) {
     const RenderPassMaskProgramAA* program =
         GetRenderPassMaskProgramAA(tex_coord_precision);
-    SetUseProgram(program->program());
-    GLC(gl_, gl_->Uniform1i(program->fragment_shader().sampler_location(), 0));
+    SetUseProgramWithSampler(program->program(),
+                             program->fragment_shader().sampler_location());
 
     shader_quad_location = program->vertex_shader().quad_location();
     shader_edge_location = program->vertex_shader().edge_location();
@@ -1122,8 +1122,8 @@ void GLRenderer::DrawRenderPassQuad(DrawingFrame* frame,
   } else if (!use_aa && mask_texture_id && !use_color_matrix) {
     const RenderPassMaskProgram* program =
         GetRenderPassMaskProgram(tex_coord_precision);
-    SetUseProgram(program->program());
-    GLC(gl_, gl_->Uniform1i(program->fragment_shader().sampler_location(), 0));
+    SetUseProgramWithSampler(program->program(),
+                             program->fragment_shader().sampler_location());
 
     shader_mask_sampler_location =
         program->fragment_shader().mask_sampler_location();
@@ -1138,8 +1138,8 @@ void GLRenderer::DrawRenderPassQuad(DrawingFrame* frame,
   } else if (use_aa && !mask_texture_id && !use_color_matrix) {
     const RenderPassProgramAA* program =
         GetRenderPassProgramAA(tex_coord_precision);
-    SetUseProgram(program->program());
-    GLC(gl_, gl_->Uniform1i(program->fragment_shader().sampler_location(), 0));
+    SetUseProgramWithSampler(program->program(),
+                             program->fragment_shader().sampler_location());
 
     shader_quad_location = program->vertex_shader().quad_location();
     shader_edge_location = program->vertex_shader().edge_location();
@@ -1151,8 +1151,8 @@ void GLRenderer::DrawRenderPassQuad(DrawingFrame* frame,
   } else if (use_aa && mask_texture_id && use_color_matrix) {
     const RenderPassMaskColorMatrixProgramAA* program =
         GetRenderPassMaskColorMatrixProgramAA(tex_coord_precision);
-    SetUseProgram(program->program());
-    GLC(gl_, gl_->Uniform1i(program->fragment_shader().sampler_location(), 0));
+    SetUseProgramWithSampler(program->program(),
+                             program->fragment_shader().sampler_location());
 
     shader_matrix_location = program->vertex_shader().matrix_location();
     shader_quad_location = program->vertex_shader().quad_location();
@@ -1174,8 +1174,8 @@ void GLRenderer::DrawRenderPassQuad(DrawingFrame* frame,
   } else if (use_aa && !mask_texture_id && use_color_matrix) {
     const RenderPassColorMatrixProgramAA* program =
         GetRenderPassColorMatrixProgramAA(tex_coord_precision);
-    SetUseProgram(program->program());
-    GLC(gl_, gl_->Uniform1i(program->fragment_shader().sampler_location(), 0));
+    SetUseProgramWithSampler(program->program(),
+                             program->fragment_shader().sampler_location());
 
     shader_matrix_location = program->vertex_shader().matrix_location();
     shader_quad_location = program->vertex_shader().quad_location();
@@ -1191,8 +1191,8 @@ void GLRenderer::DrawRenderPassQuad(DrawingFrame* frame,
   } else if (!use_aa && mask_texture_id && use_color_matrix) {
     const RenderPassMaskColorMatrixProgram* program =
         GetRenderPassMaskColorMatrixProgram(tex_coord_precision);
-    SetUseProgram(program->program());
-    GLC(gl_, gl_->Uniform1i(program->fragment_shader().sampler_location(), 0));
+    SetUseProgramWithSampler(program->program(),
+                             program->fragment_shader().sampler_location());
 
     shader_matrix_location = program->vertex_shader().matrix_location();
     shader_tex_transform_location =
@@ -1211,8 +1211,8 @@ void GLRenderer::DrawRenderPassQuad(DrawingFrame* frame,
   } else if (!use_aa && !mask_texture_id && use_color_matrix) {
     const RenderPassColorMatrixProgram* program =
         GetRenderPassColorMatrixProgram(tex_coord_precision);
-    SetUseProgram(program->program());
-    GLC(gl_, gl_->Uniform1i(program->fragment_shader().sampler_location(), 0));
+    SetUseProgramWithSampler(program->program(),
+                             program->fragment_shader().sampler_location());
 
     shader_matrix_location = program->vertex_shader().matrix_location();
     shader_tex_transform_location =
@@ -1225,8 +1225,8 @@ void GLRenderer::DrawRenderPassQuad(DrawingFrame* frame,
   } else {
     const RenderPassProgram* program =
         GetRenderPassProgram(tex_coord_precision);
-    SetUseProgram(program->program());
-    GLC(gl_, gl_->Uniform1i(program->fragment_shader().sampler_location(), 0));
+    SetUseProgramWithSampler(program->program(),
+                             program->fragment_shader().sampler_location());
 
     shader_matrix_location = program->vertex_shader().matrix_location();
     shader_alpha_location = program->fragment_shader().alpha_location();
@@ -1644,8 +1644,7 @@ void GLRenderer::DrawContentQuad(const DrawingFrame* frame,
     }
   }
 
-  SetUseProgram(uniforms.program);
-  GLC(gl_, gl_->Uniform1i(uniforms.sampler_location, 0));
+  SetUseProgramWithSampler(uniforms.program, uniforms.sampler_location);
 
   if (use_aa) {
     float viewport[4] = {static_cast<float>(viewport_.x()),
@@ -1961,11 +1960,9 @@ void GLRenderer::FlushTextureQuadCache() {
   // Set the correct blending mode.
   SetBlendEnabled(draw_cache_.needs_blending);
 
-  // Bind the program to the GL state.
-  SetUseProgram(draw_cache_.program_id);
-
-  // Bind the correct texture sampler location.
-  GLC(gl_, gl_->Uniform1i(draw_cache_.sampler_location, 0));
+  // Bind the program to the GL state, together with its sampler.
+  SetUseProgramWithSampler(draw_cache_.program_id,
+                           draw_cache_.sampler_location);
 
   // Assume the current active textures is 0.
   ResourceProvider::ScopedReadLockGL locked_quad(resource_provider_,
@@ -2095,8 +2092,7 @@ void GLRenderer::DrawIOSurfaceQuad(const DrawingFrame* frame,
   TexTransformTextureProgramBinding binding;
   binding.Set(GetTextureIOSurfaceProgram(tex_coord_precision));
 
-  SetUseProgram(binding.program_id);
-  GLC(gl_, gl_->Uniform1i(binding.sampler_location, 0));
+  SetUseProgramWithSampler(binding.program_id, binding.sampler_location);
   if (quad->orientation == IOSurfaceDrawQuad::FLIPPED) {
     GLC(gl_,
         gl_->Uniform4f(binding.tex_transform_location,
@@ -2229,6 +2225,13 @@ void GLRenderer::SetUseProgram(unsigned program) {
   program_shadow_ = program;
 }
 
+void GLRenderer::SetUseProgramWithSampler(unsigned program,
+                                          int sampler_location) {
+  SetUseProgram(program);
+  if (programs_with_initialized_sampler_.insert(program).second)
+    GLC(gl_, gl_->Uniform1i(sampler_location, 0));
+}
+
 void GLRenderer::DrawQuadGeometry(const DrawingFrame* frame,
                                   const gfx::Transform& draw_transform,
                                   const gfx::RectF& quad_rect,
@@ -2251,9 +2254,8 @@ void GLRenderer::CopyTextureToFramebuffer(const DrawingFrame* frame,
       gl_, &highp_threshold_cache_, highp_threshold_min_, rect.bottom_right());
 
   const RenderPassProgram* program = GetRenderPassProgram(tex_coord_precision);
-  SetUseProgram(program->program());
-
-  GLC(gl_, gl_->Uniform1i(program->fragment_shader().sampler_location(), 0));
+  SetUseProgramWithSampler(program->program(),
+                           program->fragment_shader().sampler_location());
 
   if (flip_vertically) {
     GLC(gl_,
@@ -3084,6 +3086,10 @@ void GLRenderer::CleanupSharedObjects() {
 
   tile_checkerboard_program_.Cleanup(gl_);
 
+  // The programs are gone and their ids may get reused, so their sampler
+  // uniforms will need to be uploaded again.
+  programs_with_initialized_sampler_.clear();
+
   debug_border_program_.Cleanup(gl_);
   solid_color_program_.Cleanup(gl_);
   solid_color_program_aa_.Cleanup(gl_);
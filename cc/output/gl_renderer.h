@@ -5,6 +5,8 @@
 #ifndef CC_OUTPUT_GL_RENDERER_H_
 #define CC_OUTPUT_GL_RENDERER_H_
 
+#include <set>
+
 #include "base/cancelable_callback.h"
 #include "cc/base/cc_export.h"
 #include "cc/base/scoped_ptr_deque.h"
@@ -175,6 +177,9 @@ class CC_EXPORT GLRenderer : public DirectRenderer {
                         const gfx::RectF& quad_rect,
                         int matrix_location);
   void SetUseProgram(unsigned program);
+  // Binds |program| and uploads its sampler uniform the first time the
+  // program is used. Only valid for programs that sample texture unit 0.
+  void SetUseProgramWithSampler(unsigned program, int sampler_location);
 
   void CopyTextureToFramebuffer(const DrawingFrame* frame,
                                 int texture_id,
@@ -404,6 +409,10 @@ class CC_EXPORT GLRenderer : public DirectRenderer {
   bool stencil_shadow_;
   bool blend_shadow_;
   unsigned program_shadow_;
+  // Programs whose sampler uniform has already been uploaded. Uniform values
+  // stick with the program object, so this only has to happen once per
+  // program.
+  std::set<unsigned> programs_with_initialized_sampler_;
   TexturedQuadDrawCache draw_cache_;
   int highp_threshold_min_;
   int highp_threshold_cache_;
@@ -0,0 +1,229 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "cc/output/gl_renderer.h"
+
+#include "base/time/time.h"
+#include "cc/debug/lap_timer.h"
+#include "cc/quads/tile_draw_quad.h"
+#include "cc/test/fake_output_surface.h"
+#include "cc/test/fake_output_surface_client.h"
+#include "cc/test/fake_renderer_client.h"
+#include "cc/test/render_pass_test_common.h"
+#include "cc/test/render_pass_test_utils.h"
+#include "cc/test/test_shared_bitmap_manager.h"
+#include "cc/test/test_web_graphics_context_3d.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace cc {
+namespace {
+
+static const int kTimeLimitMillis = 2000;
+static const int kWarmupRuns = 5;
+static const int kTimeCheckInterval = 10;
+
+static const int kViewportSize = 1000;
+static const int kTileSize = 100;
+
+// Counts the GL commands that dominate driver overhead when drawing quads:
+// program binds, texture binds and parameters, uniform uploads and draw
+// calls. One-time work such as shader compilation is not counted.
+class GLCallCountingContext : public TestWebGraphicsContext3D {
+ public:
+  GLCallCountingContext() : num_calls_(0) {}
+
+  virtual void useProgram(GLuint program) OVERRIDE {
+    ++num_calls_;
+    TestWebGraphicsContext3D::useProgram(program);
+  }
+  virtual void bindTexture(GLenum target, GLuint texture_id) OVERRIDE {
+    ++num_calls_;
+    TestWebGraphicsContext3D::bindTexture(target, texture_id);
+  }
+  virtual void texParameteri(GLenum target,
+                             GLenum pname,
+                             GLint param) OVERRIDE {
+    ++num_calls_;
+    TestWebGraphicsContext3D::texParameteri(target, pname, param);
+  }
+  virtual void drawElements(GLenum mode,
+                            GLsizei count,
+                            GLenum type,
+                            GLintptr offset) OVERRIDE {
+    ++num_calls_;
+  }
+  virtual void uniform1f(GLint location, GLfloat x) OVERRIDE { ++num_calls_; }
+  virtual void uniform1fv(GLint location,
+                          GLsizei count,
+                          const GLfloat* v) OVERRIDE {
+    ++num_calls_;
+  }
+  virtual void uniform1i(GLint location, GLint x) OVERRIDE { ++num_calls_; }
+  virtual void uniform2f(GLint location, GLfloat x, GLfloat y) OVERRIDE {
+    ++num_calls_;
+  }
+  virtual void uniform2fv(GLint location,
+                          GLsizei count,
+                          const GLfloat* v) OVERRIDE {
+    ++num_calls_;
+  }
+  virtual void uniform3fv(GLint location,
+                          GLsizei count,
+                          const GLfloat* v) OVERRIDE {
+    ++num_calls_;
+  }
+  virtual void uniform4f(GLint location,
+                         GLfloat x,
+                         GLfloat y,
+                         GLfloat z,
+                         GLfloat w) OVERRIDE {
+    ++num_calls_;
+  }
+  virtual void uniform4fv(GLint location,
+                          GLsizei count,
+                          const GLfloat* v) OVERRIDE {
+    ++num_calls_;
+  }
+  virtual void uniformMatrix4fv(GLint location,
+                                GLsizei count,
+                                GLboolean transpose,
+                                const GLfloat* value) OVERRIDE {
+    ++num_calls_;
+  }
+
+  void ResetNumCalls() { num_calls_ = 0; }
+  int num_calls() const { return num_calls_; }
+
+ private:
+  int num_calls_;
+};
+
+class GLRendererPerfTest : public testing::Test {
+ protected:
+  GLRendererPerfTest()
+      : timer_(kWarmupRuns,
+               base::TimeDelta::FromMilliseconds(kTimeLimitMillis),
+               kTimeCheckInterval) {}
+
+  virtual void SetUp() OVERRIDE {
+    scoped_ptr<GLCallCountingContext> context(new GLCallCountingContext);
+    context_ = context.get();
+    output_surface_ = FakeOutputSurface::Create3d(
+        context.PassAs<TestWebGraphicsContext3D>()).Pass();
+    CHECK(output_surface_->BindToClient(&output_surface_client_));
+
+    shared_bitmap_manager_.reset(new TestSharedBitmapManager());
+    resource_provider_ =
+        ResourceProvider::Create(
+            output_surface_.get(), shared_bitmap_manager_.get(), 0, false, 1,
+            false).Pass();
+    renderer_ = GLRenderer::Create(&renderer_client_,
+                                   &settings_,
+                                   output_surface_.get(),
+                                   resource_provider_.get(),
+                                   NULL,
+                                   0);
+  }
+
+  // Builds a frame with a single pass containing |num_quads| opaque tile
+  // quads, each sampling its own texture, laid out in a grid.
+  void SetUpTileFrame(int num_quads) {
+    gfx::Rect viewport_rect(kViewportSize, kViewportSize);
+    TestRenderPass* pass = AddRenderPass(&render_passes_in_draw_order_,
+                                         RenderPass::Id(1, 1),
+                                         viewport_rect,
+                                         gfx::Transform());
+
+    SharedQuadState* shared_state = pass->CreateAndAppendSharedQuadState();
+    shared_state->SetAll(gfx::Transform(),
+                         viewport_rect.size(),
+                         viewport_rect,
+                         viewport_rect,
+                         false,
+                         1,
+                         SkXfermode::kSrcOver_Mode,
+                         0);
+
+    gfx::Size tile_size(kTileSize, kTileSize);
+    int tiles_per_row = kViewportSize / kTileSize;
+    for (int i = 0; i < num_quads; ++i) {
+      ResourceProvider::ResourceId resource_id =
+          resource_provider_->CreateResource(
+              tile_size,
+              GL_CLAMP_TO_EDGE,
+              ResourceProvider::TextureUsageAny,
+              resource_provider_->best_texture_format());
+      resource_provider_->AllocateForTesting(resource_id);
+
+      gfx::Rect tile_rect(gfx::Point((i % tiles_per_row) * kTileSize,
+                                     (i / tiles_per_row) * kTileSize),
+                          tile_size);
+      TileDrawQuad* quad = pass->CreateAndAppendDrawQuad<TileDrawQuad>();
+      quad->SetNew(shared_state,
+                   tile_rect,
+                   tile_rect,
+                   tile_rect,
+                   resource_id,
+                   gfx::RectF(tile_rect.size()),
+                   tile_size,
+                   false);
+    }
+  }
+
+  void DrawFrame() {
+    gfx::Rect viewport_rect(kViewportSize, kViewportSize);
+    renderer_->DrawFrame(&render_passes_in_draw_order_,
+                         1.f,
+                         viewport_rect,
+                         viewport_rect,
+                         false);
+  }
+
+  void RunTest(const std::string& test_name, int num_quads) {
+    SetUpTileFrame(num_quads);
+    renderer_->SetVisible(true);
+
+    // The first frame does one-time work like compiling programs; draw it
+    // outside the timed and counted region.
+    DrawFrame();
+
+    context_->ResetNumCalls();
+    DrawFrame();
+    perf_test::PrintResult("gl_calls_per_frame",
+                           "",
+                           test_name,
+                           static_cast<size_t>(context_->num_calls()),
+                           "calls",
+                           true);
+
+    timer_.Reset();
+    do {
+      DrawFrame();
+      timer_.NextLap();
+    } while (!timer_.HasTimeLimitExpired());
+    perf_test::PrintResult(
+        "draw_frame", "", test_name, timer_.LapsPerSecond(), "runs/s", true);
+  }
+
+  LapTimer timer_;
+  GLCallCountingContext* context_;
+  FakeOutputSurfaceClient output_surface_client_;
+  scoped_ptr<FakeOutputSurface> output_surface_;
+  FakeRendererClient renderer_client_;
+  scoped_ptr<SharedBitmapManager> shared_bitmap_manager_;
+  scoped_ptr<ResourceProvider> resource_provider_;
+  scoped_ptr<GLRenderer> renderer_;
+  LayerTreeSettings settings_;
+  RenderPassList render_passes_in_draw_order_;
+};
+
+TEST_F(GLRendererPerfTest, DrawTileQuads_10) { RunTest("10_tile_quads", 10); }
+
+TEST_F(GLRendererPerfTest, DrawTileQuads_100) {
+  RunTest("100_tile_quads", 100);
+}
+
+}  // namespace
+}  // namespace cc
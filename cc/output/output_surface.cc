@@ -33,6 +33,14 @@ using std::set;
 using std::string;
 using std::vector;
 
+namespace {
+
+// How many swaps' damage to remember for AccumulatedDamageForBufferAge().
+// Buffer ages beyond this are treated as fully damaged.
+const size_t kMaxSwapDamageHistory = 8;
+
+}  // namespace
+
 namespace cc {
 
 OutputSurface::OutputSurface(scoped_refptr<ContextProvider> context_provider)
@@ -222,6 +230,7 @@ void OutputSurface::BindFramebuffer() {
 
 void OutputSurface::SwapBuffers(CompositorFrame* frame) {
   if (frame->software_frame_data) {
+    RecordSwapDamage(frame->software_frame_data->damage_rect);
     PostSwapBuffersComplete();
     client_->DidSwapBuffers();
     return;
@@ -233,14 +242,38 @@ void OutputSurface::SwapBuffers(CompositorFrame* frame) {
   if (frame->gl_frame_data->sub_buffer_rect ==
       gfx::Rect(frame->gl_frame_data->size)) {
     context_provider_->ContextSupport()->Swap();
+    RecordSwapDamage(gfx::Rect(frame->gl_frame_data->size));
   } else {
     context_provider_->ContextSupport()->PartialSwapBuffers(
         frame->gl_frame_data->sub_buffer_rect);
+    // |sub_buffer_rect| has a bottom-up origin; flip it back so the recorded
+    // damage is in the same space as the render pass damage it came from.
+    gfx::Rect damage = frame->gl_frame_data->sub_buffer_rect;
+    damage.set_y(frame->gl_frame_data->size.height() - damage.bottom());
+    RecordSwapDamage(damage);
   }
 
   client_->DidSwapBuffers();
 }
 
+int OutputSurface::GetCurrentBufferAge() const { return 1; }
+
+gfx::Rect OutputSurface::AccumulatedDamageForBufferAge(int buffer_age) const {
+  if (buffer_age < 1 ||
+      static_cast<size_t>(buffer_age) > swap_damage_history_.size() + 1)
+    return gfx::Rect(SurfaceSize());
+  gfx::Rect damage;
+  for (int i = 0; i < buffer_age - 1; ++i)
+    damage.Union(swap_damage_history_[i]);
+  return damage;
+}
+
+void OutputSurface::RecordSwapDamage(const gfx::Rect& damage) {
+  swap_damage_history_.push_front(damage);
+  if (swap_damage_history_.size() > kMaxSwapDamageHistory)
+    swap_damage_history_.pop_back();
+}
+
 void OutputSurface::PostSwapBuffersComplete() {
   base::MessageLoop::current()->PostTask(
       FROM_HERE,
@@ -17,13 +17,13 @@
 #include "cc/output/context_provider.h"
 #include "cc/output/overlay_candidate_validator.h"
 #include "cc/output/software_output_device.h"
+#include "ui/gfx/rect.h"
 
 namespace base { class SingleThreadTaskRunner; }
 
 namespace ui { struct LatencyInfo; }
 
 namespace gfx {
-class Rect;
 class Size;
 class Transform;
 }
@@ -122,6 +122,20 @@ class CC_EXPORT OutputSurface {
   virtual void SwapBuffers(CompositorFrame* frame);
   virtual void OnSwapBuffersComplete();
 
+  // Returns the age of the buffer the next frame will be drawn into, in
+  // swaps: 1 means the buffer still holds the last swapped frame's content,
+  // 0 means its content is undefined. The default assumes the backbuffer is
+  // preserved across swaps, which matches PartialSwapBuffers semantics;
+  // surfaces backed by a swap chain should override this.
+  virtual int GetCurrentBufferAge() const;
+
+  // Returns the region a buffer of age |buffer_age| is missing relative to
+  // the last swapped frame, i.e. the union of the damage submitted with the
+  // swaps in between. A frame drawn into that buffer must repaint at least
+  // this region in addition to its own damage to avoid showing stale pixels.
+  // Returns the full surface if the age is 0 or exceeds the tracked history.
+  gfx::Rect AccumulatedDamageForBufferAge(int buffer_age) const;
+
   // Notifies frame-rate smoothness preference. If true, all non-critical
   // processing should be stopped, or lowered in priority.
   virtual void UpdateSmoothnessTakesPriority(bool prefer_smoothness) {}
@@ -172,9 +186,14 @@ class CC_EXPORT OutputSurface {
   void SetUpContext3d();
   void ResetContext3d();
   void SetMemoryPolicy(const ManagedMemoryPolicy& policy);
+  void RecordSwapDamage(const gfx::Rect& damage);
 
   bool external_stencil_test_enabled_;
 
+  // Damage rects of the most recent swaps, newest first, for
+  // AccumulatedDamageForBufferAge().
+  std::deque<gfx::Rect> swap_damage_history_;
+
   base::WeakPtrFactory<OutputSurface> weak_ptr_factory_;
 
   DISALLOW_COPY_AND_ASSIGN(OutputSurface);
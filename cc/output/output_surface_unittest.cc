@@ -4,7 +4,9 @@
 
 #include "cc/output/output_surface.h"
 
+#include "base/message_loop/message_loop.h"
 #include "base/test/test_simple_task_runner.h"
+#include "cc/output/compositor_frame.h"
 #include "cc/output/managed_memory_policy.h"
 #include "cc/output/output_surface_client.h"
 #include "cc/output/software_output_device.h"
@@ -121,6 +123,39 @@ TEST(OutputSurfaceTest, ClientPointerIndicatesBindToClientFailure) {
   EXPECT_FALSE(output_surface.HasClient());
 }
 
+TEST(OutputSurfaceTest, AccumulatedDamageForBufferAge) {
+  base::MessageLoop message_loop;
+  TestOutputSurface output_surface(
+      scoped_ptr<SoftwareOutputDevice>(new SoftwareOutputDevice));
+  FakeOutputSurfaceClient client;
+  EXPECT_TRUE(output_surface.BindToClient(&client));
+  output_surface.Reshape(gfx::Size(100, 100), 1.f);
+
+  // An unknown buffer age means everything has to be repainted.
+  EXPECT_EQ(gfx::Rect(100, 100).ToString(),
+            output_surface.AccumulatedDamageForBufferAge(0).ToString());
+
+  CompositorFrame frame;
+  frame.software_frame_data = make_scoped_ptr(new SoftwareFrameData);
+  frame.software_frame_data->damage_rect = gfx::Rect(0, 0, 10, 10);
+  output_surface.SwapBuffers(&frame);
+  frame.software_frame_data->damage_rect = gfx::Rect(20, 20, 10, 10);
+  output_surface.SwapBuffers(&frame);
+
+  // A buffer of age 1 already holds the last swapped frame's content.
+  EXPECT_EQ(gfx::Rect().ToString(),
+            output_surface.AccumulatedDamageForBufferAge(1).ToString());
+  // A buffer of age 2 is missing the last swap's damage, age 3 the last two
+  // swaps' damage.
+  EXPECT_EQ(gfx::Rect(20, 20, 10, 10).ToString(),
+            output_surface.AccumulatedDamageForBufferAge(2).ToString());
+  EXPECT_EQ(gfx::Rect(0, 0, 30, 30).ToString(),
+            output_surface.AccumulatedDamageForBufferAge(3).ToString());
+  // Ages beyond the tracked history also repaint everything.
+  EXPECT_EQ(gfx::Rect(100, 100).ToString(),
+            output_surface.AccumulatedDamageForBufferAge(10).ToString());
+}
+
 class OutputSurfaceTestInitializeNewContext3d : public ::testing::Test {
  public:
   OutputSurfaceTestInitializeNewContext3d()
@@ -46,6 +46,7 @@ scoped_ptr<base::Value> ManagedTileBinAsValue(ManagedTileBin bin) {
 
 ManagedTileState::ManagedTileState()
     : raster_mode(LOW_QUALITY_RASTER_MODE),
+      analysis_valid(false),
       bin(NEVER_BIN),
       resolution(NON_IDEAL_RESOLUTION),
       required_for_activation(false),
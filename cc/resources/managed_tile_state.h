@@ -6,6 +6,7 @@
 #define CC_RESOURCES_MANAGED_TILE_STATE_H_
 
 #include "base/memory/scoped_ptr.h"
+#include "cc/resources/picture_pile_impl.h"
 #include "cc/resources/platform_color.h"
 #include "cc/resources/raster_mode.h"
 #include "cc/resources/rasterizer.h"
@@ -110,6 +111,13 @@ class CC_EXPORT ManagedTileState {
   TileVersion tile_versions[NUM_RASTER_MODES];
   RasterMode raster_mode;
 
+  // Result of the last completed picture analysis for this tile. Reused to
+  // skip re-analysis when the tile is rasterized again without its picture
+  // pile having changed, e.g. after resource eviction during scroll.
+  // Tile::set_picture_pile() clears |analysis_valid| when the pile changes.
+  PicturePileImpl::Analysis analysis;
+  bool analysis_valid;
+
   ManagedTileBin bin;
 
   TileResolution resolution;
@@ -10,6 +10,7 @@
 
 #include "base/base64.h"
 #include "base/debug/trace_event.h"
+#include "base/hash.h"
 #include "base/values.h"
 #include "cc/base/math_util.h"
 #include "cc/base/util.h"
@@ -65,6 +66,15 @@ SkData* EncodeBitmap(size_t* offset, const SkBitmap& bm) {
   return NULL;
 }
 
+SkData* FingerprintBitmap(size_t* offset, const SkBitmap& bm) {
+  // Represent the pixel contents by the bitmap's generation id, which
+  // changes whenever the pixels change. This keeps fingerprint serialization
+  // cheap compared to actually encoding the pixels.
+  uint32_t generation_id = bm.getGenerationID();
+  *offset = 0;
+  return SkData::NewWithCopy(&generation_id, sizeof(generation_id));
+}
+
 bool DecodeBitmap(const void* buffer, size_t size, SkBitmap* bm) {
   const unsigned char* data = static_cast<const unsigned char *>(buffer);
 
@@ -102,6 +112,7 @@ scoped_refptr<Picture> Picture::Create(
 
 Picture::Picture(const gfx::Rect& layer_rect)
   : layer_rect_(layer_rect),
+    content_fingerprint_computed_(false),
     cell_size_(layer_rect.size()) {
   // Instead of recording a trace event for object creation here, we wait for
   // the picture to be recorded in Picture::Record.
@@ -172,6 +183,7 @@ Picture::Picture(SkPicture* picture,
     layer_rect_(layer_rect),
     opaque_rect_(opaque_rect),
     picture_(skia::AdoptRef(picture)),
+    content_fingerprint_computed_(false),
     cell_size_(layer_rect.size()) {
 }
 
@@ -182,6 +194,7 @@ Picture::Picture(const skia::RefPtr<SkPicture>& picture,
     layer_rect_(layer_rect),
     opaque_rect_(opaque_rect),
     picture_(picture),
+    content_fingerprint_computed_(false),
     pixel_refs_(pixel_refs),
     cell_size_(layer_rect.size()) {
 }
@@ -380,6 +393,27 @@ void Picture::GatherPixelRefs(
   max_pixel_cell_ = gfx::Point(max_x, max_y);
 }
 
+bool Picture::GetContentFingerprint(ContentFingerprint* fingerprint) {
+  DCHECK(picture_);
+  // SkRecord-backed recordings have no stable serialized form to compare.
+  if (playback_)
+    return false;
+  if (!content_fingerprint_computed_) {
+    TRACE_EVENT0("cc", "Picture::GetContentFingerprint");
+    SkDynamicMemoryWStream stream;
+    picture_->serialize(&stream, &FingerprintBitmap);
+    size_t serialized_size = stream.bytesWritten();
+    scoped_ptr<char[]> serialized_picture(new char[serialized_size]);
+    stream.copyTo(serialized_picture.get());
+    content_fingerprint_.hash =
+        base::Hash(serialized_picture.get(), serialized_size);
+    content_fingerprint_.num_bytes = serialized_size;
+    content_fingerprint_computed_ = true;
+  }
+  *fingerprint = content_fingerprint_;
+  return true;
+}
+
 int Picture::Raster(
     SkCanvas* canvas,
     SkDrawPictureCallback* callback,
@@ -131,6 +131,23 @@ class CC_EXPORT Picture
 
   bool WillPlayBackBitmaps() const { return picture_->willPlayBackBitmaps(); }
 
+  // Cheap fingerprint of the recorded ops, used to detect re-recordings with
+  // identical content. Bitmaps contribute their generation ids rather than
+  // their pixels, so computing this never encodes or decodes image data.
+  struct ContentFingerprint {
+    uint32 hash;
+    size_t num_bytes;
+
+    bool operator==(const ContentFingerprint& other) const {
+      return hash == other.hash && num_bytes == other.num_bytes;
+    }
+  };
+
+  // Computes the fingerprint of this recording, caching the result. Returns
+  // false if the recording has no stable serialized form to fingerprint
+  // (SkRecord-backed recordings). Main thread only.
+  bool GetContentFingerprint(ContentFingerprint* fingerprint);
+
  private:
   explicit Picture(const gfx::Rect& layer_rect);
   // This constructor assumes SkPicture is already ref'd and transfers
@@ -162,6 +179,9 @@ class CC_EXPORT Picture
   skia::RefPtr<SkPicture> picture_;
   scoped_ptr<const EXPERIMENTAL::SkPlayback> playback_;
 
+  bool content_fingerprint_computed_;
+  ContentFingerprint content_fingerprint_;
+
   typedef std::vector<scoped_refptr<Picture> > PictureVector;
   PictureVector clones_;
 
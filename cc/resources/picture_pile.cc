@@ -6,6 +6,7 @@
 
 #include <algorithm>
 #include <limits>
+#include <map>
 #include <vector>
 
 #include "cc/base/region.h"
@@ -146,7 +147,10 @@ float ClusterTiles(const std::vector<gfx::Rect>& invalid_tiles,
 
 namespace cc {
 
-PicturePile::PicturePile() : is_suitable_for_gpu_rasterization_(true) {}
+PicturePile::PicturePile()
+    : is_suitable_for_gpu_rasterization_(true),
+      detect_identical_recordings_(false) {
+}
 
 PicturePile::~PicturePile() {
 }
@@ -257,6 +261,11 @@ bool PicturePile::UpdateAndExpandInvalidation(
     }
   }
 
+  // Pictures dropped by invalidation below, kept so that a re-recording with
+  // identical content can be detected and its raster invalidation skipped.
+  typedef std::map<PictureMapKey, scoped_refptr<Picture> > PriorPictureMap;
+  PriorPictureMap prior_pictures;
+
   Region invalidation_expanded_to_full_tiles;
   for (Region::Iterator i(*invalidation); i.has_rect(); i.next()) {
     gfx::Rect invalid_rect = i.rect();
@@ -285,6 +294,9 @@ bool PicturePile::UpdateAndExpandInvalidation(
       if (picture_it == picture_map_.end())
         continue;
 
+      if (detect_identical_recordings_ && picture_it->second.GetPicture())
+        prior_pictures[key] = picture_it->second.GetPicture();
+
       // Inform the grid cell that it has been invalidated in this frame.
       updated = picture_it->second.Invalidate(frame_number) || updated;
       // Invalidate drops the picture so the whole tile better be invalidated if
@@ -391,6 +403,23 @@ bool PicturePile::UpdateAndExpandInvalidation(
         PictureInfo& info = picture_map_[key];
         info.SetPicture(picture);
         found_tile_for_recorded_picture = true;
+
+        // If this tile's new recording has exactly the same content as the
+        // one the invalidation dropped, its raster output can't have changed,
+        // so don't invalidate raster tiles for it. This keeps e.g. a repaint
+        // that only touches a neighboring tile from re-rastering this one.
+        PriorPictureMap::const_iterator prior_it = prior_pictures.find(key);
+        if (prior_it != prior_pictures.end()) {
+          Picture::ContentFingerprint old_fingerprint;
+          Picture::ContentFingerprint new_fingerprint;
+          if (prior_it->second->LayerRect() == picture->LayerRect() &&
+              prior_it->second->GetContentFingerprint(&old_fingerprint) &&
+              picture->GetContentFingerprint(&new_fingerprint) &&
+              old_fingerprint == new_fingerprint) {
+            invalidation->Subtract(
+                tiling_.TileBounds(key.first, key.second));
+          }
+        }
       }
     }
     DCHECK(found_tile_for_recorded_picture);
@@ -44,6 +44,13 @@ class CC_EXPORT PicturePile : public PicturePileBase {
     show_debug_picture_borders_ = show;
   }
 
+  // When enabled, a re-recorded tile whose new recording has exactly the same
+  // content as the recording its invalidation dropped is removed from the
+  // expanded invalidation, so raster tiles for unchanged content are kept.
+  void set_detect_identical_recordings(bool detect) {
+    detect_identical_recordings_ = detect;
+  }
+
   bool is_suitable_for_gpu_rasterization() const {
     return is_suitable_for_gpu_rasterization_;
   }
@@ -58,6 +65,7 @@ class CC_EXPORT PicturePile : public PicturePileBase {
   friend class PicturePileImpl;
 
   bool is_suitable_for_gpu_rasterization_;
+  bool detect_identical_recordings_;
 
   DISALLOW_COPY_AND_ASSIGN(PicturePile);
 };
@@ -113,6 +113,33 @@ TEST_F(PicturePileTest, SmallInvalidateInflated) {
       picture_rect.ToString();
 }
 
+TEST_F(PicturePileTest, IdenticalRecordingDropsInvalidation) {
+  pile_->set_detect_identical_recordings(true);
+
+  // The client hasn't changed, so re-recording produces a picture with
+  // exactly the same content and the invalidation should be dropped.
+  Region invalidation(gfx::Rect(50, 50, 1, 1));
+  UpdateAndExpandInvalidation(&invalidation, tiling_size(), tiling_rect());
+  EXPECT_EQ(Region().ToString(), invalidation.ToString());
+
+  // The tile keeps a valid recording.
+  TestPicturePile::PictureInfo& picture_info =
+      pile_->picture_map().find(TestPicturePile::PictureMapKey(0, 0))->second;
+  EXPECT_TRUE(!!picture_info.GetPicture());
+
+  // Once the client paints something new, the re-recording no longer matches
+  // and the invalidation is kept.
+  SkPaint paint;
+  paint.setColor(SK_ColorRED);
+  client_.add_draw_rect(gfx::Rect(45, 45, 10, 10), paint);
+
+  Region changed_invalidation(gfx::Rect(50, 50, 1, 1));
+  UpdateAndExpandInvalidation(
+      &changed_invalidation, tiling_size(), tiling_rect());
+  EXPECT_EQ(gfx::Rect(50, 50, 1, 1).ToString(),
+            changed_invalidation.ToString());
+}
+
 TEST_F(PicturePileTest, LargeInvalidateInflated) {
   // Invalidate something inside a tile.
   Region invalidate_rect(gfx::Rect(50, 50, 100, 100));
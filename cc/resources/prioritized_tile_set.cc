@@ -74,6 +74,17 @@ void PrioritizedTileSet::InsertTile(Tile* tile, ManagedTileBin bin) {
   bin_sorted_[bin] = false;
 }
 
+bool PrioritizedTileSet::RemoveTile(Tile* tile, ManagedTileBin bin) {
+  TileVector& tiles = tiles_[bin];
+  TileVector::iterator it = std::find(tiles.begin(), tiles.end(), tile);
+  if (it == tiles.end())
+    return false;
+  // Erasing preserves the relative order of the remaining tiles, so the
+  // sorted state of the bin is unaffected.
+  tiles.erase(it);
+  return true;
+}
+
 void PrioritizedTileSet::Clear() {
   for (int bin = 0; bin < NUM_BINS; ++bin) {
     tiles_[bin].clear();
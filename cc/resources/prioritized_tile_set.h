@@ -19,6 +19,9 @@ class CC_EXPORT PrioritizedTileSet {
   ~PrioritizedTileSet();
 
   void InsertTile(Tile* tile, ManagedTileBin bin);
+  // Removes |tile| from |bin| if present. Returns false if the tile was not
+  // in that bin.
+  bool RemoveTile(Tile* tile, ManagedTileBin bin);
   void Clear();
 
   class CC_EXPORT Iterator {
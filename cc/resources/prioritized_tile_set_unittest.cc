@@ -659,6 +659,31 @@ TEST_F(PrioritizedTileSetTest, TilesForFirstAndLastBins) {
   EXPECT_FALSE(it);
 }
 
+TEST_F(PrioritizedTileSetTest, RemoveTile) {
+  // Removing a tile should not disturb the order of the remaining tiles,
+  // and removing a tile that isn't in the given bin should fail.
+
+  scoped_refptr<Tile> first = CreateTile();
+  scoped_refptr<Tile> second = CreateTile();
+  scoped_refptr<Tile> third = CreateTile();
+
+  PrioritizedTileSet set;
+  set.InsertTile(first, NOW_BIN);
+  set.InsertTile(second, NOW_BIN);
+  set.InsertTile(third, NOW_BIN);
+
+  EXPECT_TRUE(set.RemoveTile(second, NOW_BIN));
+  EXPECT_FALSE(set.RemoveTile(second, NOW_BIN));
+  EXPECT_FALSE(set.RemoveTile(first, SOON_BIN));
+
+  PrioritizedTileSet::Iterator it(&set, false);
+  EXPECT_TRUE(*it == first.get());
+  ++it;
+  EXPECT_TRUE(*it == third.get());
+  ++it;
+  EXPECT_FALSE(it);
+}
+
 TEST_F(PrioritizedTileSetTest, MultipleIterators) {
   // Ensure that multiple iterators don't interfere with each other.
 
@@ -4,8 +4,11 @@
 
 #include "cc/resources/raster_worker_pool.h"
 
+#include "base/strings/stringprintf.h"
 #include "base/test/test_simple_task_runner.h"
+#include "base/threading/simple_thread.h"
 #include "base/time/time.h"
+#include "cc/base/scoped_ptr_deque.h"
 #include "cc/debug/lap_timer.h"
 #include "cc/output/context_provider.h"
 #include "cc/resources/gpu_raster_worker_pool.h"
@@ -466,5 +469,81 @@ TEST_F(RasterWorkerPoolCommonPerfTest, BuildRasterTaskQueue) {
   RunBuildRasterTaskQueueTest("32_4", 32, 4);
 }
 
+class RasterWorkerPoolThroughputPerfTest
+    : public RasterWorkerPoolPerfTestBase,
+      public testing::TestWithParam<int>,
+      public base::DelegateSimpleThread::Delegate {
+ public:
+  // Overridden from testing::Test:
+  virtual void SetUp() OVERRIDE {
+    const size_t num_threads = GetParam();
+    namespace_token_ = task_graph_runner_->GetNamespaceToken();
+    while (workers_.size() < num_threads) {
+      scoped_ptr<base::DelegateSimpleThread> worker =
+          make_scoped_ptr(new base::DelegateSimpleThread(this, "PerfWorker"));
+      worker->Start();
+      workers_.push_back(worker.Pass());
+    }
+  }
+  virtual void TearDown() OVERRIDE {
+    task_graph_runner_->Shutdown();
+    while (workers_.size()) {
+      scoped_ptr<base::DelegateSimpleThread> worker = workers_.take_front();
+      worker->Join();
+    }
+  }
+
+  void RunExecuteTasksThroughputTest(const std::string& test_name,
+                                     unsigned num_raster_tasks) {
+    ImageDecodeTask::Vector empty_image_decode_tasks;
+    RasterTaskVector raster_tasks;
+    CreateRasterTasks(num_raster_tasks, empty_image_decode_tasks,
+                      &raster_tasks);
+
+    // Avoid unnecessary heap allocations by reusing the same graph and
+    // completed tasks vector.
+    TaskGraph graph;
+    Task::Vector completed_tasks;
+
+    timer_.Reset();
+    do {
+      graph.Reset();
+      for (size_t i = 0u; i < raster_tasks.size(); ++i)
+        graph.nodes.push_back(TaskGraph::Node(raster_tasks[i].get(), 0u, 0u));
+      task_graph_runner_->ScheduleTasks(namespace_token_, &graph);
+      task_graph_runner_->WaitForTasksToFinishRunning(namespace_token_);
+      task_graph_runner_->CollectCompletedTasks(namespace_token_,
+                                                &completed_tasks);
+      completed_tasks.clear();
+      for (size_t i = 0u; i < raster_tasks.size(); ++i)
+        static_cast<PerfRasterTaskImpl*>(raster_tasks[i].get())->Reset();
+      timer_.NextLap();
+    } while (!timer_.HasTimeLimitExpired());
+
+    perf_test::PrintResult("execute_tasks_throughput",
+                           base::StringPrintf("_%d_threads", GetParam()),
+                           test_name,
+                           num_raster_tasks * timer_.LapsPerSecond(),
+                           "tasks/s",
+                           true);
+  }
+
+ private:
+  // Overridden from base::DelegateSimpleThread::Delegate:
+  virtual void Run() OVERRIDE { task_graph_runner_->Run(); }
+
+  NamespaceToken namespace_token_;
+  ScopedPtrDeque<base::DelegateSimpleThread> workers_;
+};
+
+TEST_P(RasterWorkerPoolThroughputPerfTest, ExecuteTasks) {
+  RunExecuteTasksThroughputTest("32", 32);
+  RunExecuteTasksThroughputTest("512", 512);
+}
+
+INSTANTIATE_TEST_CASE_P(RasterWorkerPoolThroughputPerfTests,
+                        RasterWorkerPoolThroughputPerfTest,
+                        ::testing::Values(2, 4, 8, 16));
+
 }  // namespace
 }  // namespace cc
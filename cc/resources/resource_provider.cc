@@ -70,6 +70,8 @@ GLenum TextureToStorageFormat(ResourceFormat format) {
       storage_format = GL_BGRA8_EXT;
       break;
     case RGBA_4444:
+      storage_format = GL_RGBA4;
+      break;
     case LUMINANCE_8:
     case RGB_565:
     case ETC1:
@@ -84,8 +86,8 @@ bool IsFormatSupportedForStorage(ResourceFormat format) {
   switch (format) {
     case RGBA_8888:
     case BGRA_8888:
-      return true;
     case RGBA_4444:
+      return true;
     case LUMINANCE_8:
     case RGB_565:
     case ETC1:
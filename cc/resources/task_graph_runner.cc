@@ -13,6 +13,13 @@
 namespace cc {
 namespace {
 
+// Maximum number of tasks to claim each time |lock_| is acquired. Claiming
+// tasks in batches amortizes the cost of the lock over several tasks when
+// many are ready to run. Batches never span priority bands so that higher
+// priority tasks made ready by a completed task are not left waiting behind
+// lower priority work claimed earlier.
+const size_t kMaxTasksPerBatch = 4;
+
 // Helper class for iterating over all dependents of a task.
 class DependentIterator {
  public:
@@ -362,7 +369,7 @@ void TaskGraphRunner::Run() {
       continue;
     }
 
-    RunTaskWithLockAcquired();
+    RunTaskBatchWithLockAcquired();
   }
 
   // We noticed we should exit. Wake up the next worker so it knows it should
@@ -374,12 +381,54 @@ void TaskGraphRunner::RunUntilIdle() {
   base::AutoLock lock(lock_);
 
   while (!ready_to_run_namespaces_.empty())
-    RunTaskWithLockAcquired();
+    RunTaskBatchWithLockAcquired();
 }
 
-void TaskGraphRunner::RunTaskWithLockAcquired() {
-  TRACE_EVENT0("toplevel", "TaskGraphRunner::RunTask");
+void TaskGraphRunner::RunTaskBatchWithLockAcquired() {
+  TRACE_EVENT0("toplevel", "TaskGraphRunner::RunTaskBatch");
+
+  lock_.AssertAcquired();
+  DCHECK(!ready_to_run_namespaces_.empty());
+
+  // Claim a batch of tasks from the same priority band so that the cost of
+  // acquiring |lock_| is shared by several tasks.
+  ClaimedTask::Vector batch;
+  batch.push_back(ClaimTaskWithLockAcquired());
+  while (batch.size() < kMaxTasksPerBatch &&
+         !ready_to_run_namespaces_.empty()) {
+    const PrioritizedTask& next_task =
+        ready_to_run_namespaces_.front()->ready_to_run_tasks.front();
+    if (next_task.priority != batch.front().priority)
+      break;
+    batch.push_back(ClaimTaskWithLockAcquired());
+  }
+
+  size_t num_completed = 0;
+
+  {
+    base::AutoUnlock unlock(lock_);
+
+    for (size_t i = 0; i < batch.size(); ++i) {
+      batch[i].task->RunOnWorkerThread();
+
+      // Publish finished tasks between runs if |lock_| happens to be
+      // uncontended so that other workers can start on newly ready
+      // dependents. Never block on the lock while tasks from the batch
+      // remain to be run.
+      if (i + 1 < batch.size() && lock_.Try()) {
+        while (num_completed <= i)
+          CompleteTaskWithLockAcquired(batch[num_completed++]);
+        lock_.Release();
+      }
+    }
+  }
 
+  // Publish any remaining finished tasks now that |lock_| is held again.
+  while (num_completed < batch.size())
+    CompleteTaskWithLockAcquired(batch[num_completed++]);
+}
+
+TaskGraphRunner::ClaimedTask TaskGraphRunner::ClaimTaskWithLockAcquired() {
   lock_.AssertAcquired();
   DCHECK(!ready_to_run_namespaces_.empty());
 
@@ -395,7 +444,9 @@ void TaskGraphRunner::RunTaskWithLockAcquired() {
   std::pop_heap(task_namespace->ready_to_run_tasks.begin(),
                 task_namespace->ready_to_run_tasks.end(),
                 CompareTaskPriority);
-  scoped_refptr<Task> task(task_namespace->ready_to_run_tasks.back().task);
+  ClaimedTask claimed(task_namespace->ready_to_run_tasks.back().task,
+                      task_namespace->ready_to_run_tasks.back().priority,
+                      task_namespace);
   task_namespace->ready_to_run_tasks.pop_back();
 
   // Add task namespace back to |ready_to_run_namespaces_| if not empty after
@@ -408,19 +459,22 @@ void TaskGraphRunner::RunTaskWithLockAcquired() {
   }
 
   // Add task to |running_tasks|.
-  task_namespace->running_tasks.push_back(task.get());
+  task_namespace->running_tasks.push_back(claimed.task.get());
 
   // There may be more work available, so wake up another worker thread.
   has_ready_to_run_tasks_cv_.Signal();
 
   // Call WillRun() before releasing |lock_| and running task.
-  task->WillRun();
+  claimed.task->WillRun();
 
-  {
-    base::AutoUnlock unlock(lock_);
+  return claimed;
+}
 
-    task->RunOnWorkerThread();
-  }
+void TaskGraphRunner::CompleteTaskWithLockAcquired(const ClaimedTask& claimed) {
+  lock_.AssertAcquired();
+
+  const scoped_refptr<Task>& task = claimed.task;
+  TaskNamespace* task_namespace = claimed.task_namespace;
 
   // This will mark task as finished running.
   task->DidRun();
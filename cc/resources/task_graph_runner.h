@@ -169,6 +169,20 @@ class CC_EXPORT TaskGraphRunner {
     TaskVector running_tasks;
   };
 
+  // A ready to run task that a worker has claimed together with the
+  // namespace it was claimed from. Workers claim small batches of tasks
+  // under a single |lock_| acquisition and run them with the lock released.
+  struct ClaimedTask {
+    typedef std::vector<ClaimedTask> Vector;
+
+    ClaimedTask(Task* task, unsigned priority, TaskNamespace* task_namespace)
+        : task(task), priority(priority), task_namespace(task_namespace) {}
+
+    scoped_refptr<Task> task;
+    unsigned priority;
+    TaskNamespace* task_namespace;
+  };
+
   typedef std::map<int, TaskNamespace> TaskNamespaceMap;
 
   static bool CompareTaskPriority(const PrioritizedTask& a,
@@ -195,9 +209,19 @@ class CC_EXPORT TaskGraphRunner {
            task_namespace->ready_to_run_tasks.empty();
   }
 
-  // Run next task. Caller must acquire |lock_| prior to calling this function
-  // and make sure at least one task is ready to run.
-  void RunTaskWithLockAcquired();
+  // Run a batch of ready to run tasks from the same priority band. Caller
+  // must acquire |lock_| prior to calling this function and make sure at
+  // least one task is ready to run.
+  void RunTaskBatchWithLockAcquired();
+
+  // Take the top priority task from |ready_to_run_namespaces_|, add it to
+  // |running_tasks| and call WillRun() on it. The caller is responsible for
+  // running the task and calling CompleteTaskWithLockAcquired() when done.
+  ClaimedTask ClaimTaskWithLockAcquired();
+
+  // Bookkeeping for a claimed task that has finished running. Dependents
+  // with no remaining dependencies become ready to run.
+  void CompleteTaskWithLockAcquired(const ClaimedTask& claimed);
 
   // This lock protects all members of this class. Do not read or modify
   // anything without holding this lock. Do not block while holding this lock.
@@ -112,6 +112,10 @@ class CC_EXPORT Tile : public RefCountedManaged<Tile> {
     DCHECK(pile->CanRaster(contents_scale_, content_rect_))
         << gfx::ScaleToEnclosingRect(content_rect_, 1.f / contents_scale_)
                .ToString();
+    // A new pile means the cached analysis no longer describes this tile's
+    // content.
+    if (pile.get() != picture_pile_.get())
+      managed_state_.analysis_valid = false;
     picture_pile_ = pile;
   }
 
@@ -43,10 +43,13 @@ class RasterTaskImpl : public RasterTask {
       const void* tile_id,
       int source_frame_number,
       bool analyze_picture,
+      bool have_cached_analysis,
+      const PicturePileImpl::Analysis& cached_analysis,
       RenderingStatsInstrumentation* rendering_stats,
       const base::Callback<void(const PicturePileImpl::Analysis&, bool)>& reply,
       ImageDecodeTask::Vector* dependencies)
       : RasterTask(resource, dependencies),
+        analysis_(cached_analysis),
         picture_pile_(picture_pile),
         content_rect_(content_rect),
         contents_scale_(contents_scale),
@@ -56,6 +59,7 @@ class RasterTaskImpl : public RasterTask {
         tile_id_(tile_id),
         source_frame_number_(source_frame_number),
         analyze_picture_(analyze_picture),
+        have_cached_analysis_(have_cached_analysis),
         rendering_stats_(rendering_stats),
         reply_(reply),
         canvas_(NULL) {}
@@ -94,7 +98,10 @@ class RasterTaskImpl : public RasterTask {
     DCHECK(canvas_);
 
     if (analyze_picture_) {
-      Analyze(picture_pile);
+      // Skip replaying the pile when a still-valid analysis from a previous
+      // raster of this tile was provided.
+      if (!have_cached_analysis_)
+        Analyze(picture_pile);
       if (analysis_.is_solid_color)
         return;
     }
@@ -177,6 +184,7 @@ class RasterTaskImpl : public RasterTask {
   const void* tile_id_;
   int source_frame_number_;
   bool analyze_picture_;
+  bool have_cached_analysis_;
   RenderingStatsInstrumentation* rendering_stats_;
   const base::Callback<void(const PicturePileImpl::Analysis&, bool)> reply_;
   SkCanvas* canvas_;
@@ -227,6 +235,11 @@ class ImageDecodeTaskImpl : public ImageDecodeTask {
 
 const size_t kScheduledRasterTasksLimit = 32u;
 
+// Number of individual tile priority changes we track before giving up and
+// rebuilding the prioritized tile set from scratch. Re-binning a tile costs
+// a scan of its old bin, so past this point a full rebuild is cheaper.
+const size_t kMaxTilesWithChangedPriority = 64u;
+
 // Memory limit policy works by mapping some bin states to the NEVER bin.
 const ManagedTileBin kBinPolicyMap[NUM_TILE_MEMORY_LIMIT_POLICIES][NUM_BINS] = {
     // [ALLOW_NOTHING]
@@ -411,7 +424,18 @@ void TileManager::Release(Tile* tile) {
 }
 
 void TileManager::DidChangeTilePriority(Tile* tile) {
-  prioritized_tiles_dirty_ = true;
+  // If the set is already slated for a full rebuild, there is no point in
+  // tracking individual changes.
+  if (prioritized_tiles_dirty_)
+    return;
+
+  if (tiles_with_changed_priority_.size() >= kMaxTilesWithChangedPriority) {
+    tiles_with_changed_priority_.clear();
+    prioritized_tiles_dirty_ = true;
+    return;
+  }
+
+  tiles_with_changed_priority_.push_back(tile);
 }
 
 bool TileManager::ShouldForceTasksRequiredForActivationToComplete() const {
@@ -448,16 +472,48 @@ void TileManager::CleanUpReleasedTiles() {
 }
 
 void TileManager::UpdatePrioritizedTileSetIfNeeded() {
-  if (!prioritized_tiles_dirty_)
+  if (!prioritized_tiles_dirty_) {
+    // Patch the set in place when only individual tile priorities changed
+    // since the last rebuild, so the cost scales with the number of changed
+    // tiles rather than the total number of tiles.
+    if (!tiles_with_changed_priority_.empty())
+      RebinTilesWithChangedPriority();
     return;
+  }
 
   CleanUpReleasedTiles();
 
+  tiles_with_changed_priority_.clear();
   prioritized_tiles_.Clear();
   GetTilesWithAssignedBins(&prioritized_tiles_);
   prioritized_tiles_dirty_ = false;
 }
 
+void TileManager::RebinTilesWithChangedPriority() {
+  TRACE_EVENT1("cc",
+               "TileManager::RebinTilesWithChangedPriority",
+               "count",
+               tiles_with_changed_priority_.size());
+
+  // A tile may have been recorded once per tree; only re-bin it once.
+  std::sort(tiles_with_changed_priority_.begin(),
+            tiles_with_changed_priority_.end());
+  TileVector::iterator end = std::unique(tiles_with_changed_priority_.begin(),
+                                         tiles_with_changed_priority_.end());
+
+  for (TileVector::iterator it = tiles_with_changed_priority_.begin();
+       it != end;
+       ++it) {
+    Tile* tile = *it;
+    // The tile is not in the set if its last bin assignment released its
+    // resources instead of inserting it.
+    prioritized_tiles_.RemoveTile(tile, tile->managed_state().bin);
+    AssignBinToTile(tile, &prioritized_tiles_);
+  }
+
+  tiles_with_changed_priority_.clear();
+}
+
 void TileManager::DidFinishRunningTasks() {
   TRACE_EVENT0("cc", "TileManager::DidFinishRunningTasks");
 
@@ -530,110 +586,112 @@ void TileManager::DidFinishRunningTasksRequiredForActivation() {
 void TileManager::GetTilesWithAssignedBins(PrioritizedTileSet* tiles) {
   TRACE_EVENT0("cc", "TileManager::GetTilesWithAssignedBins");
 
+  // For each tree, bin into different categories of tiles.
+  for (TileMap::const_iterator it = tiles_.begin(); it != tiles_.end(); ++it)
+    AssignBinToTile(it->second, tiles);
+}
+
+void TileManager::AssignBinToTile(Tile* tile, PrioritizedTileSet* tiles) {
   const TileMemoryLimitPolicy memory_policy = global_state_.memory_limit_policy;
   const TreePriority tree_priority = global_state_.tree_priority;
 
-  // For each tree, bin into different categories of tiles.
-  for (TileMap::const_iterator it = tiles_.begin(); it != tiles_.end(); ++it) {
-    Tile* tile = it->second;
-    ManagedTileState& mts = tile->managed_state();
-
-    const ManagedTileState::TileVersion& tile_version =
-        tile->GetTileVersionForDrawing();
-    bool tile_is_ready_to_draw = tile_version.IsReadyToDraw();
-    bool tile_is_active = tile_is_ready_to_draw ||
-                          mts.tile_versions[mts.raster_mode].raster_task_;
-
-    // Get the active priority and bin.
-    TilePriority active_priority = tile->priority(ACTIVE_TREE);
-    ManagedTileBin active_bin = BinFromTilePriority(active_priority);
-
-    // Get the pending priority and bin.
-    TilePriority pending_priority = tile->priority(PENDING_TREE);
-    ManagedTileBin pending_bin = BinFromTilePriority(pending_priority);
-
-    bool pending_is_low_res = pending_priority.resolution == LOW_RESOLUTION;
-    bool pending_is_non_ideal =
-        pending_priority.resolution == NON_IDEAL_RESOLUTION;
-    bool active_is_non_ideal =
-        active_priority.resolution == NON_IDEAL_RESOLUTION;
-
-    // Adjust bin state based on if ready to draw.
-    active_bin = kBinReadyToDrawMap[tile_is_ready_to_draw][active_bin];
-    pending_bin = kBinReadyToDrawMap[tile_is_ready_to_draw][pending_bin];
-
-    // Adjust bin state based on if active.
-    active_bin = kBinIsActiveMap[tile_is_active][active_bin];
-    pending_bin = kBinIsActiveMap[tile_is_active][pending_bin];
-
-    // We never want to paint new non-ideal tiles, as we always have
-    // a high-res tile covering that content (paint that instead).
-    if (!tile_is_ready_to_draw && active_is_non_ideal)
-      active_bin = NEVER_BIN;
-    if (!tile_is_ready_to_draw && pending_is_non_ideal)
-      pending_bin = NEVER_BIN;
-
-    ManagedTileBin tree_bin[NUM_TREES];
-    tree_bin[ACTIVE_TREE] = kBinPolicyMap[memory_policy][active_bin];
-    tree_bin[PENDING_TREE] = kBinPolicyMap[memory_policy][pending_bin];
-
-    // Adjust pending bin state for low res tiles. This prevents pending tree
-    // low-res tiles from being initialized before high-res tiles.
-    if (pending_is_low_res)
-      tree_bin[PENDING_TREE] = std::max(tree_bin[PENDING_TREE], EVENTUALLY_BIN);
-
-    TilePriority tile_priority;
-    switch (tree_priority) {
-      case SAME_PRIORITY_FOR_BOTH_TREES:
-        mts.bin = std::min(tree_bin[ACTIVE_TREE], tree_bin[PENDING_TREE]);
-        tile_priority = tile->combined_priority();
-        break;
-      case SMOOTHNESS_TAKES_PRIORITY:
-        mts.bin = tree_bin[ACTIVE_TREE];
-        tile_priority = active_priority;
-        break;
-      case NEW_CONTENT_TAKES_PRIORITY:
-        mts.bin = tree_bin[PENDING_TREE];
-        tile_priority = pending_priority;
-        break;
-    }
+  ManagedTileState& mts = tile->managed_state();
 
-    // Bump up the priority if we determined it's NEVER_BIN on one tree,
-    // but is still required on the other tree.
-    bool is_in_never_bin_on_both_trees = tree_bin[ACTIVE_TREE] == NEVER_BIN &&
-                                         tree_bin[PENDING_TREE] == NEVER_BIN;
-
-    if (mts.bin == NEVER_BIN && !is_in_never_bin_on_both_trees)
-      mts.bin = tile_is_active ? AT_LAST_AND_ACTIVE_BIN : AT_LAST_BIN;
-
-    mts.resolution = tile_priority.resolution;
-    mts.priority_bin = tile_priority.priority_bin;
-    mts.distance_to_visible = tile_priority.distance_to_visible;
-    mts.required_for_activation = tile_priority.required_for_activation;
-
-    mts.visible_and_ready_to_draw =
-        tree_bin[ACTIVE_TREE] == NOW_AND_READY_TO_DRAW_BIN;
-
-    // Tiles that are required for activation shouldn't be in NEVER_BIN unless
-    // smoothness takes priority or memory policy allows nothing to be
-    // initialized.
-    DCHECK(!mts.required_for_activation || mts.bin != NEVER_BIN ||
-           tree_priority == SMOOTHNESS_TAKES_PRIORITY ||
-           memory_policy == ALLOW_NOTHING);
-
-    // If the tile is in NEVER_BIN and it does not have an active task, then we
-    // can release the resources early. If it does have the task however, we
-    // should keep it in the prioritized tile set to ensure that AssignGpuMemory
-    // can visit it.
-    if (mts.bin == NEVER_BIN &&
-        !mts.tile_versions[mts.raster_mode].raster_task_) {
-      FreeResourcesForTileAndNotifyClientIfTileWasReadyToDraw(tile);
-      continue;
-    }
+  const ManagedTileState::TileVersion& tile_version =
+      tile->GetTileVersionForDrawing();
+  bool tile_is_ready_to_draw = tile_version.IsReadyToDraw();
+  bool tile_is_active = tile_is_ready_to_draw ||
+                        mts.tile_versions[mts.raster_mode].raster_task_;
+
+  // Get the active priority and bin.
+  TilePriority active_priority = tile->priority(ACTIVE_TREE);
+  ManagedTileBin active_bin = BinFromTilePriority(active_priority);
+
+  // Get the pending priority and bin.
+  TilePriority pending_priority = tile->priority(PENDING_TREE);
+  ManagedTileBin pending_bin = BinFromTilePriority(pending_priority);
+
+  bool pending_is_low_res = pending_priority.resolution == LOW_RESOLUTION;
+  bool pending_is_non_ideal =
+      pending_priority.resolution == NON_IDEAL_RESOLUTION;
+  bool active_is_non_ideal =
+      active_priority.resolution == NON_IDEAL_RESOLUTION;
+
+  // Adjust bin state based on if ready to draw.
+  active_bin = kBinReadyToDrawMap[tile_is_ready_to_draw][active_bin];
+  pending_bin = kBinReadyToDrawMap[tile_is_ready_to_draw][pending_bin];
+
+  // Adjust bin state based on if active.
+  active_bin = kBinIsActiveMap[tile_is_active][active_bin];
+  pending_bin = kBinIsActiveMap[tile_is_active][pending_bin];
+
+  // We never want to paint new non-ideal tiles, as we always have
+  // a high-res tile covering that content (paint that instead).
+  if (!tile_is_ready_to_draw && active_is_non_ideal)
+    active_bin = NEVER_BIN;
+  if (!tile_is_ready_to_draw && pending_is_non_ideal)
+    pending_bin = NEVER_BIN;
+
+  ManagedTileBin tree_bin[NUM_TREES];
+  tree_bin[ACTIVE_TREE] = kBinPolicyMap[memory_policy][active_bin];
+  tree_bin[PENDING_TREE] = kBinPolicyMap[memory_policy][pending_bin];
+
+  // Adjust pending bin state for low res tiles. This prevents pending tree
+  // low-res tiles from being initialized before high-res tiles.
+  if (pending_is_low_res)
+    tree_bin[PENDING_TREE] = std::max(tree_bin[PENDING_TREE], EVENTUALLY_BIN);
+
+  TilePriority tile_priority;
+  switch (tree_priority) {
+    case SAME_PRIORITY_FOR_BOTH_TREES:
+      mts.bin = std::min(tree_bin[ACTIVE_TREE], tree_bin[PENDING_TREE]);
+      tile_priority = tile->combined_priority();
+      break;
+    case SMOOTHNESS_TAKES_PRIORITY:
+      mts.bin = tree_bin[ACTIVE_TREE];
+      tile_priority = active_priority;
+      break;
+    case NEW_CONTENT_TAKES_PRIORITY:
+      mts.bin = tree_bin[PENDING_TREE];
+      tile_priority = pending_priority;
+      break;
+  }
 
-    // Insert the tile into a priority set.
-    tiles->InsertTile(tile, mts.bin);
+  // Bump up the priority if we determined it's NEVER_BIN on one tree,
+  // but is still required on the other tree.
+  bool is_in_never_bin_on_both_trees = tree_bin[ACTIVE_TREE] == NEVER_BIN &&
+                                       tree_bin[PENDING_TREE] == NEVER_BIN;
+
+  if (mts.bin == NEVER_BIN && !is_in_never_bin_on_both_trees)
+    mts.bin = tile_is_active ? AT_LAST_AND_ACTIVE_BIN : AT_LAST_BIN;
+
+  mts.resolution = tile_priority.resolution;
+  mts.priority_bin = tile_priority.priority_bin;
+  mts.distance_to_visible = tile_priority.distance_to_visible;
+  mts.required_for_activation = tile_priority.required_for_activation;
+
+  mts.visible_and_ready_to_draw =
+      tree_bin[ACTIVE_TREE] == NOW_AND_READY_TO_DRAW_BIN;
+
+  // Tiles that are required for activation shouldn't be in NEVER_BIN unless
+  // smoothness takes priority or memory policy allows nothing to be
+  // initialized.
+  DCHECK(!mts.required_for_activation || mts.bin != NEVER_BIN ||
+         tree_priority == SMOOTHNESS_TAKES_PRIORITY ||
+         memory_policy == ALLOW_NOTHING);
+
+  // If the tile is in NEVER_BIN and it does not have an active task, then we
+  // can release the resources early. If it does have the task however, we
+  // should keep it in the prioritized tile set to ensure that AssignGpuMemory
+  // can visit it.
+  if (mts.bin == NEVER_BIN &&
+      !mts.tile_versions[mts.raster_mode].raster_task_) {
+    FreeResourcesForTileAndNotifyClientIfTileWasReadyToDraw(tile);
+    return;
   }
+
+  // Insert the tile into a priority set.
+  tiles->InsertTile(tile, mts.bin);
 }
 
 void TileManager::ManageTiles(const GlobalStateThatImpactsTilePriority& state) {
@@ -1023,6 +1081,12 @@ scoped_refptr<RasterTask> TileManager::CreateRasterTask(Tile* tile) {
     existing_pixel_refs[id] = decode_task;
   }
 
+  // Reuse the analysis from a previous raster of this tile if its pile has
+  // not changed since that analysis was computed; replaying the pile would
+  // produce the same answer.
+  bool have_cached_analysis =
+      tile->use_picture_analysis() && mts.analysis_valid;
+
   return make_scoped_refptr(
       new RasterTaskImpl(const_resource,
                          tile->picture_pile(),
@@ -1034,6 +1098,9 @@ scoped_refptr<RasterTask> TileManager::CreateRasterTask(Tile* tile) {
                          static_cast<const void*>(tile),
                          tile->source_frame_number(),
                          tile->use_picture_analysis(),
+                         have_cached_analysis,
+                         have_cached_analysis ? mts.analysis
+                                              : PicturePileImpl::Analysis(),
                          rendering_stats_instrumentation_,
                          base::Bind(&TileManager::OnRasterTaskCompleted,
                                     base::Unretained(this),
@@ -1091,6 +1158,11 @@ void TileManager::OnRasterTaskCompleted(
 
   ++update_visible_tiles_stats_.completed_count;
 
+  if (tile->use_picture_analysis()) {
+    mts.analysis = analysis;
+    mts.analysis_valid = true;
+  }
+
   if (analysis.is_solid_color) {
     tile_version.set_solid_color(analysis.solid_color);
     resource_pool_->ReleaseResource(resource.Pass());
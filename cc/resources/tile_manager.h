@@ -260,6 +260,7 @@ class CC_EXPORT TileManager : public RasterizerClient,
   void AssignGpuMemoryToTiles(PrioritizedTileSet* tiles,
                               TileVector* tiles_that_need_to_be_rasterized);
   void GetTilesWithAssignedBins(PrioritizedTileSet* tiles);
+  void AssignBinToTile(Tile* tile, PrioritizedTileSet* tiles);
 
  private:
   void OnImageDecodeTaskCompleted(int layer_id,
@@ -284,6 +285,7 @@ class CC_EXPORT TileManager : public RasterizerClient,
                                                        SkPixelRef* pixel_ref);
   scoped_refptr<RasterTask> CreateRasterTask(Tile* tile);
   void UpdatePrioritizedTileSetIfNeeded();
+  void RebinTilesWithChangedPriority();
 
   bool IsReadyToActivate() const;
   void CheckIfReadyToActivate();
@@ -299,6 +301,10 @@ class CC_EXPORT TileManager : public RasterizerClient,
 
   PrioritizedTileSet prioritized_tiles_;
   bool prioritized_tiles_dirty_;
+  // Tiles whose priority changed since the last rebuild of
+  // |prioritized_tiles_|. Only tracked while |prioritized_tiles_dirty_| is
+  // false; a full rebuild makes patching these in place pointless.
+  TileVector tiles_with_changed_priority_;
 
   bool all_tiles_that_need_to_be_rasterized_have_memory_;
   bool all_tiles_required_for_activation_have_memory_;
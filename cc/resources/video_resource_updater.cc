@@ -154,21 +154,35 @@ VideoFrameExternalResources VideoResourceUpdater::CreateForSoftwarePlanes(
 
     ResourceProvider::ResourceId resource_id = 0;
     gpu::Mailbox mailbox;
+    bool contents_match = false;
 
-    // Try recycle a previously-allocated resource.
-    for (size_t i = 0; i < recycled_resources_.size(); ++i) {
+    // Try recycle a previously-allocated resource. Prefer one that still
+    // holds this plane's contents, so that re-compositing the same frame
+    // (e.g. while the video is paused) skips the upload entirely.
+    size_t recycle_index = recycled_resources_.size();
+    for (size_t j = 0; j < recycled_resources_.size(); ++j) {
       bool resource_matches =
-          recycled_resources_[i].resource_format == output_resource_format &&
-          recycled_resources_[i].resource_size == output_plane_resource_size;
+          recycled_resources_[j].resource_format == output_resource_format &&
+          recycled_resources_[j].resource_size == output_plane_resource_size;
       bool not_in_use =
           !software_compositor || !resource_provider_->InUseByConsumer(
-                                       recycled_resources_[i].resource_id);
-      if (resource_matches && not_in_use) {
-        resource_id = recycled_resources_[i].resource_id;
-        mailbox = recycled_resources_[i].mailbox;
-        recycled_resources_.erase(recycled_resources_.begin() + i);
+                                       recycled_resources_[j].resource_id);
+      if (!resource_matches || !not_in_use)
+        continue;
+      if (recycled_resources_[j].frame_ptr == video_frame.get() &&
+          recycled_resources_[j].plane_index == i &&
+          recycled_resources_[j].timestamp == video_frame->timestamp()) {
+        recycle_index = j;
+        contents_match = true;
         break;
       }
+      if (recycle_index == recycled_resources_.size())
+        recycle_index = j;
+    }
+    if (recycle_index != recycled_resources_.size()) {
+      resource_id = recycled_resources_[recycle_index].resource_id;
+      mailbox = recycled_resources_[recycle_index].mailbox;
+      recycled_resources_.erase(recycled_resources_.begin() + recycle_index);
     }
 
     if (resource_id == 0) {
@@ -208,7 +222,11 @@ VideoFrameExternalResources VideoResourceUpdater::CreateForSoftwarePlanes(
     plane_resources.push_back(PlaneResource(resource_id,
                                             output_plane_resource_size,
                                             output_resource_format,
-                                            mailbox));
+                                            mailbox,
+                                            contents_match ? video_frame.get()
+                                                           : NULL,
+                                            i,
+                                            video_frame->timestamp()));
   }
 
   if (!allocation_success) {
@@ -227,7 +245,8 @@ VideoFrameExternalResources VideoResourceUpdater::CreateForSoftwarePlanes(
     if (!video_renderer_)
       video_renderer_.reset(new media::SkCanvasVideoRenderer);
 
-    {
+    // A recycled resource that already holds this frame needs no repaint.
+    if (plane_resources[0].frame_ptr != video_frame.get()) {
       ResourceProvider::ScopedWriteLockSoftware lock(
           resource_provider_, plane_resources[0].resource_id);
       video_renderer_->Paint(video_frame.get(),
@@ -240,7 +259,10 @@ VideoFrameExternalResources VideoResourceUpdater::CreateForSoftwarePlanes(
       plane_resources[0].resource_id,
       plane_resources[0].resource_size,
       plane_resources[0].resource_format,
-      gpu::Mailbox()
+      gpu::Mailbox(),
+      video_frame.get(),
+      0,
+      video_frame->timestamp()
     };
     external_resources.software_resources.push_back(
         plane_resources[0].resource_id);
@@ -252,27 +274,33 @@ VideoFrameExternalResources VideoResourceUpdater::CreateForSoftwarePlanes(
   }
 
   for (size_t i = 0; i < plane_resources.size(); ++i) {
-    // Update each plane's resource id with its content.
+    // Update each plane's resource id with its content, unless a recycled
+    // resource already holds this plane of this frame.
     DCHECK_EQ(plane_resources[i].resource_format, kYUVResourceFormat);
 
-    const uint8_t* input_plane_pixels = video_frame->data(i);
-
-    gfx::Rect image_rect(0,
-                         0,
-                         video_frame->stride(i),
-                         plane_resources[i].resource_size.height());
-    gfx::Rect source_rect(plane_resources[i].resource_size);
-    resource_provider_->SetPixels(plane_resources[i].resource_id,
-                                  input_plane_pixels,
-                                  image_rect,
-                                  source_rect,
-                                  gfx::Vector2d());
+    if (plane_resources[i].frame_ptr != video_frame.get()) {
+      const uint8_t* input_plane_pixels = video_frame->data(i);
+
+      gfx::Rect image_rect(0,
+                           0,
+                           video_frame->stride(i),
+                           plane_resources[i].resource_size.height());
+      gfx::Rect source_rect(plane_resources[i].resource_size);
+      resource_provider_->SetPixels(plane_resources[i].resource_id,
+                                    input_plane_pixels,
+                                    image_rect,
+                                    source_rect,
+                                    gfx::Vector2d());
+    }
 
     RecycleResourceData recycle_data = {
       plane_resources[i].resource_id,
       plane_resources[i].resource_size,
       plane_resources[i].resource_format,
-      plane_resources[i].mailbox
+      plane_resources[i].mailbox,
+      video_frame.get(),
+      i,
+      video_frame->timestamp()
     };
 
     external_resources.mailboxes.push_back(
@@ -363,7 +391,10 @@ void VideoResourceUpdater::RecycleResource(
   PlaneResource recycled_resource(data.resource_id,
                                   data.resource_size,
                                   data.resource_format,
-                                  data.mailbox);
+                                  data.mailbox,
+                                  data.frame_ptr,
+                                  data.plane_index,
+                                  data.timestamp);
   updater->recycled_resources_.push_back(recycled_resource);
 }
 
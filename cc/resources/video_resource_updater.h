@@ -11,6 +11,7 @@
 #include "base/memory/ref_counted.h"
 #include "base/memory/scoped_ptr.h"
 #include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
 #include "cc/base/cc_export.h"
 #include "cc/resources/release_callback.h"
 #include "cc/resources/resource_format.h"
@@ -78,15 +79,28 @@ class CC_EXPORT VideoResourceUpdater
     gfx::Size resource_size;
     ResourceFormat resource_format;
     gpu::Mailbox mailbox;
+    // Identifies the frame plane whose contents the resource holds, so that
+    // re-compositing the same frame can skip the upload. The frame pointer is
+    // only ever compared, never dereferenced; the timestamp guards against a
+    // recycled allocation reusing the same address.
+    const void* frame_ptr;
+    size_t plane_index;
+    base::TimeDelta timestamp;
 
     PlaneResource(unsigned resource_id,
                   const gfx::Size& resource_size,
                   ResourceFormat resource_format,
-                  gpu::Mailbox mailbox)
+                  gpu::Mailbox mailbox,
+                  const void* frame_ptr,
+                  size_t plane_index,
+                  base::TimeDelta timestamp)
         : resource_id(resource_id),
           resource_size(resource_size),
           resource_format(resource_format),
-          mailbox(mailbox) {}
+          mailbox(mailbox),
+          frame_ptr(frame_ptr),
+          plane_index(plane_index),
+          timestamp(timestamp) {}
   };
 
   void DeleteResource(unsigned resource_id);
@@ -101,6 +115,9 @@ class CC_EXPORT VideoResourceUpdater
     gfx::Size resource_size;
     ResourceFormat resource_format;
     gpu::Mailbox mailbox;
+    const void* frame_ptr;
+    size_t plane_index;
+    base::TimeDelta timestamp;
   };
   static void RecycleResource(base::WeakPtr<VideoResourceUpdater> updater,
                               RecycleResourceData data,
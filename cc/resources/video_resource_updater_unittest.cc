@@ -71,5 +71,32 @@ TEST_F(VideoResourceUpdaterTest, SoftwareFrame) {
   EXPECT_EQ(VideoFrameExternalResources::YUV_RESOURCE, resources.type);
 }
 
+TEST_F(VideoResourceUpdaterTest, ReuseResource) {
+  VideoResourceUpdater updater(output_surface3d_->context_provider().get(),
+                               resource_provider3d_.get());
+  scoped_refptr<media::VideoFrame> video_frame = CreateTestYUVVideoFrame();
+  video_frame->set_timestamp(base::TimeDelta::FromSeconds(1234));
+
+  // Allocate the resources for a YUV video frame.
+  VideoFrameExternalResources resources =
+      updater.CreateExternalResourcesFromVideoFrame(video_frame);
+  EXPECT_EQ(VideoFrameExternalResources::YUV_RESOURCE, resources.type);
+  EXPECT_EQ(3u, resources.mailboxes.size());
+  EXPECT_EQ(3u, resources.release_callbacks.size());
+
+  // Return the resources to the pool.
+  for (size_t i = 0; i < resources.release_callbacks.size(); ++i)
+    resources.release_callbacks[i].Run(0, false);
+
+  // Allocate resources for the same frame; the same resources must be
+  // recycled, plane for plane.
+  VideoFrameExternalResources new_resources =
+      updater.CreateExternalResourcesFromVideoFrame(video_frame);
+  EXPECT_EQ(VideoFrameExternalResources::YUV_RESOURCE, new_resources.type);
+  ASSERT_EQ(3u, new_resources.mailboxes.size());
+  for (size_t i = 0; i < new_resources.mailboxes.size(); ++i)
+    EXPECT_TRUE(new_resources.mailboxes[i].Equals(resources.mailboxes[i]));
+}
+
 }  // namespace
 }  // namespace cc
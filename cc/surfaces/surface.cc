@@ -10,7 +10,7 @@
 namespace cc {
 
 Surface::Surface(SurfaceId id, const gfx::Size& size, SurfaceFactory* factory)
-    : surface_id_(id), size_(size), factory_(factory) {
+    : surface_id_(id), size_(size), factory_(factory), frame_index_(0) {
 }
 
 Surface::~Surface() {
@@ -26,6 +26,7 @@ Surface::~Surface() {
 void Surface::QueueFrame(scoped_ptr<CompositorFrame> frame) {
   scoped_ptr<CompositorFrame> previous_frame = current_frame_.Pass();
   current_frame_ = frame.Pass();
+  ++frame_index_;
   factory_->ReceiveFromChild(
       current_frame_->delegated_frame_data->resource_list);
 
@@ -30,12 +30,17 @@ class CC_SURFACES_EXPORT Surface {
   // Returns the most recent frame that is eligible to be rendered.
   CompositorFrame* GetEligibleFrame();
 
+  // Increments with each frame queued; lets clients tell whether the surface
+  // has new content since they last looked at it.
+  int frame_index() const { return frame_index_; }
+
   SurfaceFactory* factory() { return factory_; }
 
  private:
   SurfaceId surface_id_;
   gfx::Size size_;
   SurfaceFactory* factory_;
+  int frame_index_;
   // TODO(jamesr): Support multiple frames in flight.
   scoped_ptr<CompositorFrame> current_frame_;
 
@@ -101,6 +101,18 @@ bool SurfaceAggregator::TakeResources(Surface* surface,
   if (!provider_)  // TODO(jamesr): hack for unit tests that don't set up rp
     return false;
 
+  SurfaceToFrameIndexMap::iterator taken_it =
+      surface_id_to_taken_frame_index_.find(surface->surface_id());
+  if (taken_it != surface_id_to_taken_frame_index_.end() &&
+      taken_it->second == surface->frame_index()) {
+    // The surface still shows the frame whose resources were taken by an
+    // earlier aggregation. Its quads already hold remapped resource ids and
+    // the earlier DeclareUsedResourcesFromChild is still in effect, so there
+    // is nothing to do; remapping the quads' ids a second time would not even
+    // be valid, as they no longer refer to the child's id space.
+    return false;
+  }
+
   int child_id = ChildIdForSurface(surface);
   provider_->ReceiveFromChild(child_id, frame_data->resource_list);
   surface->factory()->RefResources(frame_data->resource_list);
@@ -125,8 +137,11 @@ bool SurfaceAggregator::TakeResources(Surface* surface,
       (*quad_it)->IterateResources(remap);
     }
   }
-  if (!invalid_frame)
+  if (!invalid_frame) {
     provider_->DeclareUsedResourcesFromChild(child_id, referenced_resources);
+    surface_id_to_taken_frame_index_[surface->surface_id()] =
+        surface->frame_index();
+  }
 
   return invalid_frame;
 }
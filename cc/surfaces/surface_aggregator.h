@@ -61,6 +61,12 @@ class CC_SURFACES_EXPORT SurfaceAggregator {
   typedef base::hash_map<SurfaceId, int> SurfaceToResourceChildIdMap;
   SurfaceToResourceChildIdMap surface_id_to_resource_child_id_;
 
+  // The frame index that resources were last successfully taken from for each
+  // surface, so that aggregating a surface that still shows the same frame
+  // can skip the resource receive/remap/declare pass entirely.
+  typedef base::hash_map<SurfaceId, int> SurfaceToFrameIndexMap;
+  SurfaceToFrameIndexMap surface_id_to_taken_frame_index_;
+
   // The following state is only valid for the duration of one Aggregate call
   // and is only stored on the class to avoid having to pass through every
   // function call.
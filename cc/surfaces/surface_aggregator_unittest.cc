@@ -880,6 +880,33 @@ TEST_F(SurfaceAggregatorWithResourcesTest, TakeResourcesOneSurface) {
   factory.Destroy(surface_id);
 }
 
+// Aggregating a surface again while it still shows the same frame should
+// reuse the resources taken by the first aggregation instead of attempting
+// to remap the already-remapped ids held by the frame's quads.
+TEST_F(SurfaceAggregatorWithResourcesTest, AggregateSameFrameTwice) {
+  ResourceTrackingSurfaceFactoryClient client;
+  SurfaceFactory factory(&manager_, &client);
+  SurfaceId surface_id(7u);
+  factory.Create(surface_id, SurfaceSize());
+
+  ResourceProvider::ResourceId ids[] = {11, 12, 13};
+  SubmitFrameWithResources(ids, arraysize(ids), &factory, surface_id);
+
+  scoped_ptr<CompositorFrame> frame = aggregator_->Aggregate(surface_id);
+  ASSERT_TRUE(frame);
+
+  frame = aggregator_->Aggregate(surface_id);
+  ASSERT_TRUE(frame);
+  const RenderPassList& pass_list =
+      frame->delegated_frame_data->render_pass_list;
+  ASSERT_EQ(1u, pass_list.size());
+  EXPECT_EQ(3u, pass_list.back()->quad_list.size());
+
+  // No new frame was submitted, so nothing should have been returned.
+  EXPECT_TRUE(client.returned_resources().empty());
+  factory.Destroy(surface_id);
+}
+
 }  // namespace
 }  // namespace cc
 
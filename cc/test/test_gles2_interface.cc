@@ -116,6 +116,57 @@ void TestGLES2Interface::UseProgram(GLuint program) {
   test_context_->useProgram(program);
 }
 
+void TestGLES2Interface::Uniform1f(GLint location, GLfloat x) {
+  test_context_->uniform1f(location, x);
+}
+
+void TestGLES2Interface::Uniform1fv(GLint location,
+                                    GLsizei count,
+                                    const GLfloat* v) {
+  test_context_->uniform1fv(location, count, v);
+}
+
+void TestGLES2Interface::Uniform1i(GLint location, GLint x) {
+  test_context_->uniform1i(location, x);
+}
+
+void TestGLES2Interface::Uniform2f(GLint location, GLfloat x, GLfloat y) {
+  test_context_->uniform2f(location, x, y);
+}
+
+void TestGLES2Interface::Uniform2fv(GLint location,
+                                    GLsizei count,
+                                    const GLfloat* v) {
+  test_context_->uniform2fv(location, count, v);
+}
+
+void TestGLES2Interface::Uniform3fv(GLint location,
+                                    GLsizei count,
+                                    const GLfloat* v) {
+  test_context_->uniform3fv(location, count, v);
+}
+
+void TestGLES2Interface::Uniform4f(GLint location,
+                                   GLfloat x,
+                                   GLfloat y,
+                                   GLfloat z,
+                                   GLfloat w) {
+  test_context_->uniform4f(location, x, y, z, w);
+}
+
+void TestGLES2Interface::Uniform4fv(GLint location,
+                                    GLsizei count,
+                                    const GLfloat* v) {
+  test_context_->uniform4fv(location, count, v);
+}
+
+void TestGLES2Interface::UniformMatrix4fv(GLint location,
+                                          GLsizei count,
+                                          GLboolean transpose,
+                                          const GLfloat* value) {
+  test_context_->uniformMatrix4fv(location, count, transpose, value);
+}
+
 GLenum TestGLES2Interface::CheckFramebufferStatus(GLenum target) {
   return test_context_->checkFramebufferStatus(target);
 }
@@ -46,6 +46,30 @@ class TestGLES2Interface : public gpu::gles2::GLES2InterfaceStub {
   virtual void Viewport(GLint x, GLint y, GLsizei width, GLsizei height)
       OVERRIDE;
   virtual void UseProgram(GLuint program) OVERRIDE;
+  virtual void Uniform1f(GLint location, GLfloat x) OVERRIDE;
+  virtual void Uniform1fv(GLint location,
+                          GLsizei count,
+                          const GLfloat* v) OVERRIDE;
+  virtual void Uniform1i(GLint location, GLint x) OVERRIDE;
+  virtual void Uniform2f(GLint location, GLfloat x, GLfloat y) OVERRIDE;
+  virtual void Uniform2fv(GLint location,
+                          GLsizei count,
+                          const GLfloat* v) OVERRIDE;
+  virtual void Uniform3fv(GLint location,
+                          GLsizei count,
+                          const GLfloat* v) OVERRIDE;
+  virtual void Uniform4f(GLint location,
+                         GLfloat x,
+                         GLfloat y,
+                         GLfloat z,
+                         GLfloat w) OVERRIDE;
+  virtual void Uniform4fv(GLint location,
+                          GLsizei count,
+                          const GLfloat* v) OVERRIDE;
+  virtual void UniformMatrix4fv(GLint location,
+                                GLsizei count,
+                                GLboolean transpose,
+                                const GLfloat* value) OVERRIDE;
   virtual void Scissor(GLint x, GLint y, GLsizei width, GLsizei height)
       OVERRIDE;
   virtual void DrawElements(GLenum mode,
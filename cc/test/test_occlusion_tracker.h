@@ -20,11 +20,11 @@ class TestOcclusionTracker : public OcclusionTracker<LayerType> {
 
   Region occlusion_from_inside_target() const {
     return OcclusionTracker<LayerType>::stack_.back()
-        .occlusion_from_inside_target;
+        .occlusion_from_inside_target.ToRegion();
   }
   Region occlusion_from_outside_target() const {
     return OcclusionTracker<LayerType>::stack_.back()
-        .occlusion_from_outside_target;
+        .occlusion_from_outside_target.ToRegion();
   }
 
   Region occlusion_on_contributing_surface_from_inside_target() const {
@@ -32,23 +32,23 @@ class TestOcclusionTracker : public OcclusionTracker<LayerType> {
     if (stack_size < 2)
       return Region();
     return OcclusionTracker<LayerType>::stack_[stack_size - 2]
-        .occlusion_from_inside_target;
+        .occlusion_from_inside_target.ToRegion();
   }
   Region occlusion_on_contributing_surface_from_outside_target() const {
     size_t stack_size = OcclusionTracker<LayerType>::stack_.size();
     if (stack_size < 2)
       return Region();
     return OcclusionTracker<LayerType>::stack_[stack_size - 2]
-        .occlusion_from_outside_target;
+        .occlusion_from_outside_target.ToRegion();
   }
 
   void set_occlusion_from_outside_target(const Region& region) {
     OcclusionTracker<LayerType>::stack_.back().occlusion_from_outside_target =
-        region;
+        SpanRegion(region);
   }
   void set_occlusion_from_inside_target(const Region& region) {
     OcclusionTracker<LayerType>::stack_.back().occlusion_from_inside_target =
-        region;
+        SpanRegion(region);
   }
 };
 
@@ -103,6 +103,23 @@ class TestWebGraphicsContext3D {
 
   virtual void useProgram(GLuint program);
 
+  virtual void uniform1f(GLint location, GLfloat x) {}
+  virtual void uniform1fv(GLint location, GLsizei count, const GLfloat* v) {}
+  virtual void uniform1i(GLint location, GLint x) {}
+  virtual void uniform2f(GLint location, GLfloat x, GLfloat y) {}
+  virtual void uniform2fv(GLint location, GLsizei count, const GLfloat* v) {}
+  virtual void uniform3fv(GLint location, GLsizei count, const GLfloat* v) {}
+  virtual void uniform4f(GLint location,
+                         GLfloat x,
+                         GLfloat y,
+                         GLfloat z,
+                         GLfloat w) {}
+  virtual void uniform4fv(GLint location, GLsizei count, const GLfloat* v) {}
+  virtual void uniformMatrix4fv(GLint location,
+                                GLsizei count,
+                                GLboolean transpose,
+                                const GLfloat* value) {}
+
   virtual void viewport(GLint x, GLint y, GLsizei width, GLsizei height) {}
 
   virtual void genBuffers(GLsizei count, GLuint* ids);
@@ -225,6 +225,7 @@ LayerTreeHostImpl::LayerTreeHostImpl(
       wheel_scrolling_(false),
       scroll_affects_scroll_handler_(false),
       scroll_layer_id_when_mouse_over_scrollbar_(0),
+      scroll_inverse_transform_cached_(false),
       tile_priorities_dirty_(false),
       root_layer_scroll_offset_delegate_(NULL),
       settings_(settings),
@@ -1936,10 +1937,13 @@ void LayerTreeHostImpl::CreateAndSetTileManager() {
                                     resource_provider_.get());
     on_demand_task_graph_runner_ = &synchronous_task_graph_runner_;
   } else if (UseZeroCopyTextureUpload()) {
-    resource_pool_ =
-        ResourcePool::Create(resource_provider_.get(),
-                             GetMapImageTextureTarget(context_provider),
-                             resource_provider_->best_texture_format());
+    // GpuMemoryBuffer-backed images support the memory efficient texture
+    // format, so zero-copy doesn't have to force the raster output to the
+    // best texture format.
+    resource_pool_ = ResourcePool::Create(
+        resource_provider_.get(),
+        GetMapImageTextureTarget(context_provider),
+        resource_provider_->memory_efficient_texture_format());
 
     raster_worker_pool_ =
         ImageRasterWorkerPool::Create(proxy_->ImplThreadTaskRunner(),
@@ -2383,13 +2387,24 @@ gfx::Vector2dF LayerTreeHostImpl::ScrollLayerWithViewportSpaceDelta(
   // Layers with non-invertible screen space transforms should not have passed
   // the scroll hit test in the first place.
   DCHECK(layer_impl->screen_space_transform().IsInvertible());
-  gfx::Transform inverse_screen_space_transform(
-      gfx::Transform::kSkipInitialization);
-  bool did_invert = layer_impl->screen_space_transform().GetInverse(
-      &inverse_screen_space_transform);
-  // TODO(shawnsingh): With the advent of impl-side crolling for non-root
-  // layers, we may need to explicitly handle uninvertible transforms here.
-  DCHECK(did_invert);
+
+  // Reuse the cached inverse if the transform has not changed since the last
+  // scroll event; checking 16 components is much cheaper than inverting.
+  if (!scroll_inverse_transform_cached_ ||
+      last_scroll_screen_space_transform_ !=
+          layer_impl->screen_space_transform()) {
+    gfx::Transform inverse(gfx::Transform::kSkipInitialization);
+    bool did_invert =
+        layer_impl->screen_space_transform().GetInverse(&inverse);
+    // TODO(shawnsingh): With the advent of impl-side crolling for non-root
+    // layers, we may need to explicitly handle uninvertible transforms here.
+    DCHECK(did_invert);
+    last_scroll_screen_space_transform_ = layer_impl->screen_space_transform();
+    last_scroll_inverse_transform_ = inverse;
+    scroll_inverse_transform_cached_ = true;
+  }
+  const gfx::Transform& inverse_screen_space_transform =
+      last_scroll_inverse_transform_;
 
   gfx::PointF screen_space_point =
       gfx::ScalePoint(viewport_point, scale_from_viewport_to_screen_space);
@@ -35,6 +35,7 @@
 #include "skia/ext/refptr.h"
 #include "third_party/skia/include/core/SkColor.h"
 #include "ui/gfx/rect.h"
+#include "ui/gfx/transform.h"
 
 namespace cc {
 
@@ -601,6 +602,16 @@ class CC_EXPORT LayerTreeHostImpl
   bool wheel_scrolling_;
   bool scroll_affects_scroll_handler_;
   int scroll_layer_id_when_mouse_over_scrollbar_;
+
+  // Caches the most recently inverted screen space transform and its inverse.
+  // During a scroll gesture ScrollLayerWithViewportSpaceDelta() runs for every
+  // input event, but the scrolling layer's transform only changes when new
+  // draw properties are computed, so the 4x4 inversion can usually be reused.
+  // The cache is keyed purely on the transform's value, so it stays correct
+  // across layer destruction and tree activation.
+  bool scroll_inverse_transform_cached_;
+  gfx::Transform last_scroll_screen_space_transform_;
+  gfx::Transform last_scroll_inverse_transform_;
   ScopedPtrVector<SwapPromise> swap_promises_for_main_thread_scroll_update_;
 
   bool tile_priorities_dirty_;
@@ -83,6 +83,7 @@ LayerTreeImpl::LayerTreeImpl(LayerTreeHostImpl* layer_tree_host_impl)
       sent_page_scale_delta_(1),
       min_page_scale_factor_(0),
       max_page_scale_factor_(0),
+      hit_test_candidate_layers_dirty_(true),
       scrolling_layer_id_from_previous_tree_(0),
       contents_textures_purged_(false),
       requires_high_res_to_draw_(false),
@@ -559,6 +560,9 @@ void LayerTreeImpl::RegisterLayer(LayerImpl* layer) {
 void LayerTreeImpl::UnregisterLayer(LayerImpl* layer) {
   DCHECK(LayerById(layer->id()));
   layer_id_map_.erase(layer->id());
+  // The hit test candidate list may reference this layer, and not every path
+  // that destroys layers dirties draw properties, so invalidate it here.
+  hit_test_candidate_layers_dirty_ = true;
 }
 
 size_t LayerTreeImpl::NumLayers() {
@@ -1186,35 +1190,26 @@ static bool PointHitsLayer(const LayerImpl* layer,
   return true;
 }
 
-struct FindClosestMatchingLayerDataForRecursion {
-  FindClosestMatchingLayerDataForRecursion()
-      : closest_match(NULL),
-        closest_distance(-std::numeric_limits<float>::infinity()) {}
-  LayerImpl* closest_match;
-  // Note that the positive z-axis points towards the camera, so bigger means
-  // closer in this case, counterintuitively.
-  float closest_distance;
-};
-
 template <typename Functor>
-static void FindClosestMatchingLayer(
+static LayerImpl* FindClosestMatchingLayer(
     const gfx::PointF& screen_space_point,
-    LayerImpl* layer,
-    const Functor& func,
-    FindClosestMatchingLayerDataForRecursion* data_for_recursion) {
-  for (int i = layer->children().size() - 1; i >= 0; --i) {
-    FindClosestMatchingLayer(
-        screen_space_point, layer->children()[i], func, data_for_recursion);
-  }
-
-  float distance_to_intersection = 0.f;
-  if (func(layer) &&
-      PointHitsLayer(layer, screen_space_point, &distance_to_intersection) &&
-      ((!data_for_recursion->closest_match ||
-        distance_to_intersection > data_for_recursion->closest_distance))) {
-    data_for_recursion->closest_distance = distance_to_intersection;
-    data_for_recursion->closest_match = layer;
+    const std::vector<LayerImpl*>& layers,
+    const Functor& func) {
+  LayerImpl* closest_match = NULL;
+  // Note that the positive z-axis points towards the camera, so bigger means
+  // closer in this case, counterintuitively.
+  float closest_distance = -std::numeric_limits<float>::infinity();
+  for (size_t i = 0; i < layers.size(); ++i) {
+    LayerImpl* layer = layers[i];
+    float distance_to_intersection = 0.f;
+    if (func(layer) &&
+        PointHitsLayer(layer, screen_space_point, &distance_to_intersection) &&
+        (!closest_match || distance_to_intersection > closest_distance)) {
+      closest_distance = distance_to_intersection;
+      closest_match = layer;
+    }
   }
+  return closest_match;
 }
 
 static bool ScrollsAnyDrawnRenderSurfaceLayerListMember(LayerImpl* layer) {
@@ -1234,6 +1229,37 @@ static bool ScrollsAnyDrawnRenderSurfaceLayerListMember(LayerImpl* layer) {
   return false;
 }
 
+// Every layer that any of the hit-testing queries below could return
+// satisfies this predicate; layers that fail it never need to be considered.
+static bool LayerIsHitTestCandidate(LayerImpl* layer) {
+  return layer->IsDrawnRenderSurfaceLayerListMember() ||
+         ScrollsAnyDrawnRenderSurfaceLayerListMember(layer) ||
+         !layer->touch_event_handler_region().IsEmpty() ||
+         layer->have_wheel_event_handlers();
+}
+
+static void CollectHitTestCandidateLayers(LayerImpl* layer,
+                                          std::vector<LayerImpl*>* layers) {
+  // Visit children in reverse order and a layer after its children, matching
+  // the order the tree recursion used to test layers in, so that iterating
+  // the flat list still visits layers front to back and the distance
+  // tie-break in FindClosestMatchingLayer picks the same layer the tree walk
+  // would have.
+  for (int i = layer->children().size() - 1; i >= 0; --i)
+    CollectHitTestCandidateLayers(layer->children()[i], layers);
+  if (LayerIsHitTestCandidate(layer))
+    layers->push_back(layer);
+}
+
+void LayerTreeImpl::RebuildHitTestCandidateLayersIfNeeded() {
+  if (!hit_test_candidate_layers_dirty_)
+    return;
+  hit_test_candidate_layers_.clear();
+  if (root_layer())
+    CollectHitTestCandidateLayers(root_layer(), &hit_test_candidate_layers_);
+  hit_test_candidate_layers_dirty_ = false;
+}
+
 struct FindScrollingLayerFunctor {
   bool operator()(LayerImpl* layer) const {
     return ScrollsAnyDrawnRenderSurfaceLayerListMember(layer);
@@ -1242,20 +1268,15 @@ struct FindScrollingLayerFunctor {
 
 LayerImpl* LayerTreeImpl::FindFirstScrollingLayerThatIsHitByPoint(
     const gfx::PointF& screen_space_point) {
-  FindClosestMatchingLayerDataForRecursion data_for_recursion;
-  FindClosestMatchingLayer(screen_space_point,
-                           root_layer(),
-                           FindScrollingLayerFunctor(),
-                           &data_for_recursion);
-  return data_for_recursion.closest_match;
+  RebuildHitTestCandidateLayersIfNeeded();
+  return FindClosestMatchingLayer(screen_space_point,
+                                  hit_test_candidate_layers_,
+                                  FindScrollingLayerFunctor());
 }
 
 struct HitTestVisibleScrollableOrTouchableFunctor {
   bool operator()(LayerImpl* layer) const {
-    return layer->IsDrawnRenderSurfaceLayerListMember() ||
-           ScrollsAnyDrawnRenderSurfaceLayerListMember(layer) ||
-           !layer->touch_event_handler_region().IsEmpty() ||
-           layer->have_wheel_event_handlers();
+    return LayerIsHitTestCandidate(layer);
   }
 };
 
@@ -1265,12 +1286,10 @@ LayerImpl* LayerTreeImpl::FindLayerThatIsHitByPoint(
     return NULL;
   if (!UpdateDrawProperties())
     return NULL;
-  FindClosestMatchingLayerDataForRecursion data_for_recursion;
-  FindClosestMatchingLayer(screen_space_point,
-                           root_layer(),
-                           HitTestVisibleScrollableOrTouchableFunctor(),
-                           &data_for_recursion);
-  return data_for_recursion.closest_match;
+  RebuildHitTestCandidateLayersIfNeeded();
+  return FindClosestMatchingLayer(screen_space_point,
+                                  hit_test_candidate_layers_,
+                                  HitTestVisibleScrollableOrTouchableFunctor());
 }
 
 static bool LayerHasTouchEventHandlersAt(const gfx::PointF& screen_space_point,
@@ -1308,11 +1327,10 @@ LayerImpl* LayerTreeImpl::FindLayerThatIsHitByPointInTouchHandlerRegion(
     return NULL;
   if (!UpdateDrawProperties())
     return NULL;
+  RebuildHitTestCandidateLayersIfNeeded();
   FindTouchEventLayerFunctor func = {screen_space_point};
-  FindClosestMatchingLayerDataForRecursion data_for_recursion;
-  FindClosestMatchingLayer(
-      screen_space_point, root_layer(), func, &data_for_recursion);
-  return data_for_recursion.closest_match;
+  return FindClosestMatchingLayer(
+      screen_space_point, hit_test_candidate_layers_, func);
 }
 
 void LayerTreeImpl::RegisterSelection(const LayerSelectionBound& start,
@@ -178,11 +178,19 @@ class CC_EXPORT LayerTreeImpl {
 
   void set_needs_update_draw_properties() {
     needs_update_draw_properties_ = true;
+    hit_test_candidate_layers_dirty_ = true;
   }
   bool needs_update_draw_properties() const {
     return needs_update_draw_properties_;
   }
 
+  // Invalidates the cached hit test candidate list without forcing draw
+  // properties to be recomputed. Needed when a property that only affects
+  // hit testing (e.g. an event handler region) changes.
+  void set_hit_test_candidate_layers_dirty() {
+    hit_test_candidate_layers_dirty_ = true;
+  }
+
   void set_needs_full_tree_sync(bool needs) { needs_full_tree_sync_ = needs; }
   bool needs_full_tree_sync() const { return needs_full_tree_sync_; }
 
@@ -282,6 +290,10 @@ class CC_EXPORT LayerTreeImpl {
   explicit LayerTreeImpl(LayerTreeHostImpl* layer_tree_host_impl);
   void ReleaseResourcesRecursive(LayerImpl* current);
 
+  // Rebuilds |hit_test_candidate_layers_| if anything that could affect it
+  // has changed since the list was last built.
+  void RebuildHitTestCandidateLayersIfNeeded();
+
   LayerTreeHostImpl* layer_tree_host_impl_;
   int source_frame_number_;
   scoped_ptr<LayerImpl> root_layer_;
@@ -313,6 +325,14 @@ class CC_EXPORT LayerTreeImpl {
 
   std::vector<LayerImpl*> layers_with_copy_output_request_;
 
+  // The layers that the point-based hit-testing queries could possibly
+  // return, in the front-to-back order that the tree walk would visit them.
+  // Input events are hit-tested several times per frame, so the queries walk
+  // this (typically short) flat list instead of recursing over every layer
+  // in the tree each time.
+  std::vector<LayerImpl*> hit_test_candidate_layers_;
+  bool hit_test_candidate_layers_dirty_;
+
   // Persisted state for non-impl-side-painting.
   int scrolling_layer_id_from_previous_tree_;
 
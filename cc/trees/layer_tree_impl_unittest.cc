@@ -2070,6 +2070,55 @@ TEST_F(LayerTreeImplTest, HitCheckingTouchHandlerOverlappingRegions) {
   EXPECT_FALSE(result_layer);
 }
 
+TEST_F(LayerTreeImplTest, HitCheckingTouchHandlerRegionAddedAfterHitTest) {
+  gfx::Transform identity_matrix;
+  gfx::Point3F transform_origin;
+
+  scoped_ptr<LayerImpl> root = LayerImpl::Create(host_impl().active_tree(), 1);
+  SetLayerPropertiesForTesting(root.get(),
+                               identity_matrix,
+                               transform_origin,
+                               gfx::PointF(),
+                               gfx::Size(100, 100),
+                               true,
+                               false);
+  root->SetDrawsContent(true);
+  {
+    // This layer does not draw content and starts with no touch handler
+    // region, so the initial hit test does not need to consider it at all.
+    scoped_ptr<LayerImpl> touch_layer =
+        LayerImpl::Create(host_impl().active_tree(), 123);
+    SetLayerPropertiesForTesting(touch_layer.get(),
+                                 identity_matrix,
+                                 transform_origin,
+                                 gfx::PointF(),
+                                 gfx::Size(50, 50),
+                                 true,
+                                 false);
+    root->AddChild(touch_layer.Pass());
+  }
+
+  host_impl().SetViewportSize(root->bounds());
+  host_impl().active_tree()->SetRootLayer(root.Pass());
+  host_impl().active_tree()->UpdateDrawProperties();
+
+  gfx::Point test_point(25, 25);
+  LayerImpl* result_layer =
+      host_impl().active_tree()->FindLayerThatIsHitByPointInTouchHandlerRegion(
+          test_point);
+  EXPECT_FALSE(result_layer);
+
+  // Giving the layer a touch handler region after the first hit test must be
+  // reflected in subsequent hit tests, even though nothing else changed.
+  host_impl().active_tree()->LayerById(123)->SetTouchEventHandlerRegion(
+      gfx::Rect(0, 0, 50, 50));
+  result_layer =
+      host_impl().active_tree()->FindLayerThatIsHitByPointInTouchHandlerRegion(
+          test_point);
+  ASSERT_TRUE(result_layer);
+  EXPECT_EQ(123, result_layer->id());
+}
+
 TEST_F(LayerTreeImplTest, SelectionBoundsForSingleLayer) {
   int root_layer_id = 12345;
   scoped_ptr<LayerImpl> root =
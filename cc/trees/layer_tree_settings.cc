@@ -65,7 +65,8 @@ LayerTreeSettings::LayerTreeSettings()
       touch_hit_testing(true),
       texture_id_allocation_chunk_size(64),
       use_occlusion_for_tile_prioritization(false),
-      record_full_layer(false) {
+      record_full_layer(false),
+      detect_identical_recordings(false) {
 }
 
 LayerTreeSettings::~LayerTreeSettings() {}
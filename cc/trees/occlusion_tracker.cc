@@ -65,26 +65,26 @@ static gfx::Rect ScreenSpaceClipRectInTargetSurface(
 }
 
 template <typename RenderSurfaceType>
-static Region TransformSurfaceOpaqueRegion(
-    const Region& region,
+static SpanRegion TransformSurfaceOpaqueRegion(
+    const SpanRegion& region,
     bool have_clip_rect,
     const gfx::Rect& clip_rect_in_new_target,
     const gfx::Transform& transform) {
   if (region.IsEmpty())
-    return Region();
+    return SpanRegion();
 
   // Verify that rects within the |surface| will remain rects in its target
   // surface after applying |transform|. If this is true, then apply |transform|
-  // to each rect within |region| in order to transform the entire Region.
+  // to each rect within |region| in order to transform the entire region.
 
   // TODO(danakj): Find a rect interior to each transformed quad.
   if (!transform.Preserves2dAxisAlignment())
-    return Region();
+    return SpanRegion();
 
-  // TODO(danakj): If the Region is too complex, degrade gracefully here by
+  // TODO(danakj): If the region is too complex, degrade gracefully here by
   // skipping rects in it.
-  Region transformed_region;
-  for (Region::Iterator rects(region); rects.has_rect(); rects.next()) {
+  SpanRegion transformed_region;
+  for (SpanRegion::Iterator rects(region); rects.has_rect(); rects.next()) {
     bool clipped;
     gfx::QuadF transformed_quad =
         MathUtil::MapQuad(transform, gfx::QuadF(rects.rect()), &clipped);
@@ -244,7 +244,7 @@ static void ReduceOcclusionBelowSurface(LayerType* contributing_layer,
                                         const gfx::Rect& surface_rect,
                                         const gfx::Transform& surface_transform,
                                         LayerType* render_target,
-                                        Region* occlusion_from_inside_target) {
+                                        SpanRegion* occlusion_from_inside_target) {
   if (surface_rect.IsEmpty())
     return;
 
@@ -265,9 +265,9 @@ static void ReduceOcclusionBelowSurface(LayerType* contributing_layer,
   // to expand outside the clip.
   affected_area_in_target.Inset(
       -outset_left, -outset_top, -outset_right, -outset_bottom);
-  Region affected_occlusion = IntersectRegions(*occlusion_from_inside_target,
-                                               affected_area_in_target);
-  Region::Iterator affected_occlusion_rects(affected_occlusion);
+  SpanRegion affected_occlusion = *occlusion_from_inside_target;
+  affected_occlusion.Intersect(affected_area_in_target);
+  SpanRegion::Iterator affected_occlusion_rects(affected_occlusion);
 
   occlusion_from_inside_target->Subtract(affected_area_in_target);
   for (; affected_occlusion_rects.has_rect(); affected_occlusion_rects.next()) {
@@ -309,7 +309,7 @@ void OcclusionTracker<LayerType>::LeaveToRenderTarget(
   const typename LayerType::RenderSurfaceType* old_surface =
       old_target->render_surface();
 
-  Region old_occlusion_from_inside_target_in_new_target =
+  SpanRegion old_occlusion_from_inside_target_in_new_target =
       TransformSurfaceOpaqueRegion<typename LayerType::RenderSurfaceType>(
           stack_[last_index].occlusion_from_inside_target,
           old_surface->is_clipped(),
@@ -324,7 +324,7 @@ void OcclusionTracker<LayerType>::LeaveToRenderTarget(
             old_surface->replica_draw_transform()));
   }
 
-  Region old_occlusion_from_outside_target_in_new_target =
+  SpanRegion old_occlusion_from_outside_target_in_new_target =
       TransformSurfaceOpaqueRegion<typename LayerType::RenderSurfaceType>(
           stack_[last_index].occlusion_from_outside_target,
           false,
@@ -525,7 +525,7 @@ bool OcclusionTracker<LayerType>::Occluded(
 
   // Take the ToEnclosingRect at each step, as we want to contain any unoccluded
   // partial pixels in the resulting Rect.
-  Region unoccluded_region_in_target_surface =
+  SpanRegion unoccluded_region_in_target_surface =
       MathUtil::MapEnclosingClippedRect(draw_transform, content_rect);
   unoccluded_region_in_target_surface.Subtract(
       stack_.back().occlusion_from_inside_target);
@@ -560,7 +560,7 @@ gfx::Rect OcclusionTracker<LayerType>::UnoccludedContentRect(
 
   // Take the ToEnclosingRect at each step, as we want to contain any unoccluded
   // partial pixels in the resulting Rect.
-  Region unoccluded_region_in_target_surface =
+  SpanRegion unoccluded_region_in_target_surface =
       MathUtil::MapEnclosingClippedRect(draw_transform, content_rect);
   unoccluded_region_in_target_surface.Subtract(
       stack_.back().occlusion_from_inside_target);
@@ -605,7 +605,7 @@ gfx::Rect OcclusionTracker<LayerType>::UnoccludedContributingSurfaceContentRect(
 
   // Take the ToEnclosingRect at each step, as we want to contain any unoccluded
   // partial pixels in the resulting Rect.
-  Region unoccluded_region_in_target_surface =
+  SpanRegion unoccluded_region_in_target_surface =
       MathUtil::MapEnclosingClippedRect(draw_transform, content_rect);
   unoccluded_region_in_target_surface.Subtract(
       second_last.occlusion_from_inside_target);
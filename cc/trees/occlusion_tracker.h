@@ -10,6 +10,7 @@
 #include "base/basictypes.h"
 #include "cc/base/cc_export.h"
 #include "cc/base/region.h"
+#include "cc/base/span_region.h"
 #include "cc/layers/layer_iterator.h"
 #include "ui/gfx/rect.h"
 
@@ -66,8 +67,9 @@ class CC_EXPORT OcclusionTracker {
   // Gives the region of the screen that is not occluded by something opaque.
   Region ComputeVisibleRegionInScreen() const {
     DCHECK(!stack_.back().target->parent());
-    return SubtractRegions(screen_space_clip_rect_,
-                           stack_.back().occlusion_from_inside_target);
+    SpanRegion visible(screen_space_clip_rect_);
+    visible.Subtract(stack_.back().occlusion_from_inside_target);
+    return visible.ToRegion();
   }
 
   void set_minimum_tracking_size(const gfx::Size& size) {
@@ -89,8 +91,8 @@ class CC_EXPORT OcclusionTracker {
     StackObject() : target(0) {}
     explicit StackObject(const LayerType* target) : target(target) {}
     const LayerType* target;
-    Region occlusion_from_outside_target;
-    Region occlusion_from_inside_target;
+    SpanRegion occlusion_from_outside_target;
+    SpanRegion occlusion_from_inside_target;
   };
 
   // The stack holds occluded regions for subtrees in the
@@ -70,6 +70,20 @@ int shutdown_num_processes_slow_;
 
 const char kShutdownMsFile[] = "chrome_shutdown_ms.txt";
 
+// Journal file recording how far shutdown has progressed. It is written
+// when shutdown starts, updated as shutdown crosses each phase below and
+// deleted once shutdown completes, so finding it at the next startup means
+// the previous shutdown was cut short.
+const char kShutdownJournalFile[] = "chrome_shutdown_journal.txt";
+
+// Phases recorded in the shutdown journal. These values are written to
+// disk and logged in a histogram, so they should not be reordered.
+enum ShutdownJournalPhase {
+  SHUTDOWN_PHASE_STARTED = 0,
+  SHUTDOWN_PHASE_THREADS_STOPPING,
+  SHUTDOWN_PHASE_MAX
+};
+
 const char* ToShutdownTypeString(ShutdownType type) {
   switch (type) {
     case NOT_VALID:
@@ -85,6 +99,18 @@ const char* ToShutdownTypeString(ShutdownType type) {
   return "";
 }
 
+base::FilePath GetShutdownJournalPath() {
+  base::FilePath journal_file;
+  PathService::Get(chrome::DIR_USER_DATA, &journal_file);
+  return journal_file.AppendASCII(kShutdownJournalFile);
+}
+
+void WriteShutdownJournal(ShutdownJournalPhase phase) {
+  std::string entry = base::IntToString(phase);
+  base::WriteFile(GetShutdownJournalPath(), entry.c_str(),
+                  static_cast<int>(entry.length()));
+}
+
 }  // namespace
 
 void RegisterPrefs(PrefRegistrySimple* registry) {
@@ -128,6 +154,15 @@ void OnShutdownStarting(ShutdownType type) {
     if (!i.GetCurrentValue()->FastShutdownIfPossible())
       ++shutdown_num_processes_slow_;
   }
+
+  // Journal that shutdown has begun so the next launch can tell whether we
+  // made it all the way through, and flush any dirty prefs now while the
+  // worker threads are still running in case shutdown is cut short later.
+  BrowserThread::PostTask(
+      BrowserThread::FILE, FROM_HERE,
+      base::Bind(&WriteShutdownJournal, SHUTDOWN_PHASE_STARTED));
+  if (g_browser_process->local_state())
+    g_browser_process->local_state()->CommitPendingWrite();
 }
 
 base::FilePath GetShutdownMsPath() {
@@ -182,6 +217,10 @@ bool ShutdownPreThreadsStop() {
 
   prefs->CommitPendingWrite();
 
+  BrowserThread::PostTask(
+      BrowserThread::FILE, FROM_HERE,
+      base::Bind(&WriteShutdownJournal, SHUTDOWN_PHASE_THREADS_STOPPING));
+
 #if defined(ENABLE_RLZ)
   // Cleanup any statics created by RLZ. Must be done before NotificationService
   // is destroyed.
@@ -265,6 +304,10 @@ void ShutdownPostThreadsStop(bool restart_last_session) {
     base::WriteFile(shutdown_ms_file, shutdown_ms.c_str(), len);
   }
 
+  // All shutdown work is done; remove the journal so the next launch knows
+  // this shutdown completed.
+  base::DeleteFile(GetShutdownJournalPath(), false);
+
 #if defined(OS_CHROMEOS)
   chrome::NotifyAndTerminate(false);
 #endif
@@ -275,6 +318,20 @@ void ReadLastShutdownFile(ShutdownType type,
                           int num_procs_slow) {
   DCHECK(BrowserThread::CurrentlyOn(BrowserThread::FILE));
 
+  // If the journal from the previous shutdown is still around, that shutdown
+  // never completed; record how far it got before cleaning up.
+  base::FilePath journal_file = GetShutdownJournalPath();
+  std::string journal_str;
+  if (base::ReadFileToString(journal_file, &journal_str)) {
+    int phase = 0;
+    if (base::StringToInt(journal_str, &phase) && phase >= 0 &&
+        phase < SHUTDOWN_PHASE_MAX) {
+      UMA_HISTOGRAM_ENUMERATION("Shutdown.IncompletePhase", phase,
+                                SHUTDOWN_PHASE_MAX);
+    }
+    base::DeleteFile(journal_file, false);
+  }
+
   base::FilePath shutdown_ms_file = GetShutdownMsPath();
   std::string shutdown_ms_str;
   int64 shutdown_ms = 0;
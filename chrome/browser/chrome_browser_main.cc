@@ -56,6 +56,7 @@
 #include "chrome/browser/google/google_search_counter.h"
 #include "chrome/browser/gpu/gl_string_manager.h"
 #include "chrome/browser/gpu/three_d_api_observer.h"
+#include "chrome/browser/idle_purge_coordinator.h"
 #include "chrome/browser/jankometer.h"
 #include "chrome/browser/media/media_capture_devices_dispatcher.h"
 #include "chrome/browser/metrics/field_trial_synchronizer.h"
@@ -1043,6 +1044,11 @@ void ChromeBrowserMainParts::PostBrowserStart() {
   // Allow ProcessSingleton to process messages.
   process_singleton_->Unlock();
 #endif
+#if !defined(OS_ANDROID)
+  // Start watching for long idle periods so subsystem caches can be purged
+  // while the user is away.
+  idle_purge_coordinator_.reset(new IdlePurgeCoordinator());
+#endif
 #if defined(ENABLE_WEBRTC)
   // Set up a task to delete old WebRTC log files for all profiles. Use a delay
   // to reduce the impact on startup time.
@@ -21,6 +21,7 @@
 class BrowserProcessImpl;
 class ChromeBrowserMainExtraParts;
 class FieldTrialSynchronizer;
+class IdlePurgeCoordinator;
 class MetricsService;
 class PrefService;
 class Profile;
@@ -175,6 +176,12 @@ class ChromeBrowserMainParts : public content::BrowserMainParts {
   ProcessSingleton::NotifyResult notify_result_;
   scoped_ptr<ThreeDAPIObserver> three_d_observer_;
 
+#if !defined(OS_ANDROID)
+  // Trims subsystem caches when the user has been idle for a while. Android
+  // relies on the operating system's memory pressure signals instead.
+  scoped_ptr<IdlePurgeCoordinator> idle_purge_coordinator_;
+#endif
+
   // Initialized in SetupMetricsAndFieldTrials.
   scoped_refptr<FieldTrialSynchronizer> field_trial_synchronizer_;
 
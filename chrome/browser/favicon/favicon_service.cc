@@ -232,6 +232,28 @@ base::CancelableTaskTracker::TaskId FaviconService::GetFaviconForPageURL(
       tracker);
 }
 
+base::CancelableTaskTracker::TaskId FaviconService::GetFaviconsForPageURLs(
+    const std::vector<GURL>& page_urls,
+    int icon_types,
+    int desired_size_in_dip,
+    const favicon_base::FaviconResultsForURLsCallback& callback,
+    base::CancelableTaskTracker* tracker) {
+  if (history_service_) {
+    return history_service_->GetFaviconsForURLs(
+        page_urls,
+        icon_types,
+        GetPixelSizesForFaviconScales(desired_size_in_dip),
+        callback,
+        tracker);
+  }
+  return tracker->PostTask(
+      base::MessageLoopProxy::current().get(),
+      FROM_HERE,
+      Bind(callback,
+           std::vector<std::vector<favicon_base::FaviconRawBitmapResult> >(
+               page_urls.size())));
+}
+
 base::CancelableTaskTracker::TaskId
 FaviconService::UpdateFaviconMappingsAndFetch(
     const GURL& page_url,
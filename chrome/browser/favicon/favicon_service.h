@@ -126,6 +126,19 @@ class FaviconService : public KeyedService {
       const favicon_base::FaviconResultsCallback& callback,
       base::CancelableTaskTracker* tracker);
 
+  // Requests favicons for all of |page_urls| with a single task on the
+  // history thread; equivalent to calling GetFaviconForPageURL() once per
+  // page URL but with one thread hop and one callback. The results passed to
+  // |callback| are parallel to |page_urls|. Chrome UI and extension URLs are
+  // not handled by this method and get empty results; use the single-URL
+  // methods for those.
+  base::CancelableTaskTracker::TaskId GetFaviconsForPageURLs(
+      const std::vector<GURL>& page_urls,
+      int icon_types,
+      int desired_size_in_dip,
+      const favicon_base::FaviconResultsForURLsCallback& callback,
+      base::CancelableTaskTracker* tracker);
+
   // Set the favicon mappings to |page_url| for |icon_types| in the history
   // database.
   // Sample |icon_urls|:
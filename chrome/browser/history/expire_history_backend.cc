@@ -112,6 +112,12 @@ const int kExpirationDelaySec = 30;
 // iteration, so we want to wait longer before checking to avoid wasting CPU.
 const int kExpirationEmptyDelayMin = 5;
 
+// Unrestricted bulk deletions (e.g. clearing all browsing data) are
+// partitioned into rounds of at most this many visits, so that the peak
+// memory use and the size of any single database operation stay bounded
+// even when the range covers the whole database.
+const int kExpirationChunkSize = 500;
+
 }  // namespace
 
 
@@ -190,10 +196,23 @@ void ExpireHistoryBackend::ExpireHistoryBetween(
   if (!main_db_)
     return;
 
+  if (restrict_urls.empty()) {
+    // Delete in partitions; every visit read is deleted, so each round makes
+    // progress until the range is drained.
+    VisitVector visits;
+    do {
+      visits.clear();
+      main_db_->GetAllVisitsInRange(begin_time, end_time,
+                                    kExpirationChunkSize, &visits);
+      ExpireVisits(visits);
+    } while (static_cast<int>(visits.size()) == kExpirationChunkSize);
+    return;
+  }
+
   // Find the affected visits and delete them.
   VisitVector visits;
   main_db_->GetAllVisitsInRange(begin_time, end_time, 0, &visits);
-  if (!restrict_urls.empty()) {
+  {
     std::set<URLID> url_ids;
     for (std::set<GURL>::const_iterator url = restrict_urls.begin();
         url != restrict_urls.end(); ++url)
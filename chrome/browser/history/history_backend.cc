@@ -1221,25 +1221,33 @@ void HistoryBackend::QueryHistoryBasic(const QueryOptions& options,
   bool has_more_results = db_->GetVisibleVisitsInRange(options, &visits);
   DCHECK(static_cast<int>(visits.size()) <= options.EffectiveMaxCount());
 
-  // Now add them and the URL rows to the results.
-  URLResult url_result;
+  // Now add them and the URL rows to the results. Visits in a range tend to
+  // repeat a handful of URLs, so cache the rows rather than querying the
+  // urls table once per visit.
+  std::map<URLID, URLResult> url_rows;
   for (size_t i = 0; i < visits.size(); i++) {
     const VisitRow visit = visits[i];
 
     // Add a result row for this visit, get the URL info from the DB.
-    if (!db_->GetURLRow(visit.url_id, &url_result)) {
-      VLOG(0) << "Failed to get id " << visit.url_id
-              << " from history.urls.";
-      continue;  // DB out of sync and URL doesn't exist, try to recover.
+    std::map<URLID, URLResult>::iterator found = url_rows.find(visit.url_id);
+    if (found == url_rows.end()) {
+      URLResult url_row;
+      if (!db_->GetURLRow(visit.url_id, &url_row)) {
+        VLOG(0) << "Failed to get id " << visit.url_id
+                << " from history.urls.";
+        continue;  // DB out of sync and URL doesn't exist, try to recover.
+      }
+      found = url_rows.insert(std::make_pair(visit.url_id, url_row)).first;
     }
 
-    if (!url_result.url().is_valid()) {
+    if (!found->second.url().is_valid()) {
       VLOG(0) << "Got invalid URL from history.urls with id "
               << visit.url_id << ":  "
-              << url_result.url().possibly_invalid_spec();
+              << found->second.url().possibly_invalid_spec();
       continue;  // Don't report invalid URLs in case of corruption.
     }
 
+    URLResult url_result(found->second);
     url_result.set_visit_time(visit.visit_time);
 
     // Set whether the visit was blocked for a managed user by looking at the
@@ -1601,6 +1609,19 @@ void HistoryBackend::GetFaviconsForURL(
   GetFaviconsFromDB(page_url, icon_types, desired_sizes, bitmap_results);
 }
 
+void HistoryBackend::GetFaviconsForURLs(
+    const std::vector<GURL>& page_urls,
+    int icon_types,
+    const std::vector<int>& desired_sizes,
+    std::vector<std::vector<favicon_base::FaviconRawBitmapResult> >*
+        bitmap_results) {
+  DCHECK(bitmap_results);
+  bitmap_results->resize(page_urls.size());
+  for (size_t i = 0; i < page_urls.size(); ++i)
+    GetFaviconsFromDB(page_urls[i], icon_types, desired_sizes,
+                      &(*bitmap_results)[i]);
+}
+
 void HistoryBackend::GetFaviconForID(
     favicon_base::FaviconID favicon_id,
     int desired_size,
@@ -227,6 +227,15 @@ class HistoryBackend : public base::RefCountedThreadSafe<HistoryBackend>,
       const std::vector<int>& desired_sizes,
       std::vector<favicon_base::FaviconRawBitmapResult>* bitmap_results);
 
+  // Looks up favicons for each page URL in |page_urls| in one call on the
+  // history thread. |bitmap_results| is parallel to |page_urls|.
+  void GetFaviconsForURLs(
+      const std::vector<GURL>& page_urls,
+      int icon_types,
+      const std::vector<int>& desired_sizes,
+      std::vector<std::vector<favicon_base::FaviconRawBitmapResult> >*
+          bitmap_results);
+
   void GetFaviconForID(
       favicon_base::FaviconID favicon_id,
       int desired_size,
@@ -2492,6 +2492,43 @@ TEST_F(HistoryBackendTest, GetFaviconsFromDBSelectClosestMatch) {
   EXPECT_EQ(favicon_base::FAVICON, bitmap_results_out[1].icon_type);
 }
 
+// Test that GetFaviconsForURLs() returns results parallel to the passed in
+// page URLs, including empty results for pages with no mapped favicon.
+TEST_F(HistoryBackendTest, GetFaviconsForURLs) {
+  const GURL page_url1("http://www.google.com/");
+  const GURL page_url2("http://maps.google.com/");
+  const GURL page_url_unmapped("http://news.google.com/");
+  const GURL icon_url1("http://www.google.com/icon1");
+  const GURL icon_url2("http://www.google.com/icon2");
+
+  std::vector<favicon_base::FaviconRawBitmapData> favicon_bitmap_data;
+  GenerateFaviconBitmapData(icon_url1, GetEdgeSizesSmall(),
+                            &favicon_bitmap_data);
+  backend_->SetFavicons(page_url1, favicon_base::FAVICON, favicon_bitmap_data);
+  GenerateFaviconBitmapData(icon_url2, GetEdgeSizesLarge(),
+                            &favicon_bitmap_data);
+  backend_->SetFavicons(page_url2, favicon_base::FAVICON, favicon_bitmap_data);
+
+  std::vector<GURL> page_urls;
+  page_urls.push_back(page_url1);
+  page_urls.push_back(page_url_unmapped);
+  page_urls.push_back(page_url2);
+
+  std::vector<std::vector<favicon_base::FaviconRawBitmapResult> >
+      bitmap_results_out;
+  backend_->GetFaviconsForURLs(page_urls,
+                               favicon_base::FAVICON,
+                               GetEdgeSizesSmallAndLarge(),
+                               &bitmap_results_out);
+
+  ASSERT_EQ(3u, bitmap_results_out.size());
+  ASSERT_EQ(1u, bitmap_results_out[0].size());
+  EXPECT_EQ(icon_url1, bitmap_results_out[0][0].icon_url);
+  EXPECT_TRUE(bitmap_results_out[1].empty());
+  ASSERT_EQ(1u, bitmap_results_out[2].size());
+  EXPECT_EQ(icon_url2, bitmap_results_out[2][0].icon_url);
+}
+
 // Test that GetFaviconsFromDB() returns results from the icon URL whose
 // bitmaps most closely match the passed in desired sizes.
 TEST_F(HistoryBackendTest, GetFaviconsFromDBSingleIconURL) {
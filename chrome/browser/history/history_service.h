@@ -616,6 +616,17 @@ class HistoryService : public CancelableRequestProvider,
       const favicon_base::FaviconResultsCallback& callback,
       base::CancelableTaskTracker* tracker);
 
+  // Used by the FaviconService to look up favicons for many page URLs with a
+  // single task on the history thread. The results passed to |callback| are
+  // parallel to |page_urls|; each entry is what GetFaviconsForURL() would
+  // return for that page URL.
+  base::CancelableTaskTracker::TaskId GetFaviconsForURLs(
+      const std::vector<GURL>& page_urls,
+      int icon_types,
+      const std::vector<int>& desired_sizes,
+      const favicon_base::FaviconResultsForURLsCallback& callback,
+      base::CancelableTaskTracker* tracker);
+
   // Used by FaviconService to find the first favicon bitmap whose width and
   // height are greater than that of |minimum_size_in_pixels|. This searches
   // for icons by IconType. Each element of |icon_types| is a bitmask of
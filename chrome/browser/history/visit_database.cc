@@ -19,6 +19,11 @@
 
 namespace history {
 
+const char VisitDatabase::kAddVisitSql[] =
+    "INSERT INTO visits "
+    "(url, visit_time, from_visit, transition, segment_id, "
+    "visit_duration) VALUES (?,?,?,?,?,?)";
+
 VisitDatabase::VisitDatabase() {
 }
 
@@ -142,10 +147,7 @@ bool VisitDatabase::FillVisitVectorWithOptions(sql::Statement& statement,
 }
 
 VisitID VisitDatabase::AddVisit(VisitRow* visit, VisitSource source) {
-  sql::Statement statement(GetDB().GetCachedStatement(SQL_FROM_HERE,
-      "INSERT INTO visits "
-      "(url, visit_time, from_visit, transition, segment_id, "
-      "visit_duration) VALUES (?,?,?,?,?,?)"));
+  sql::Statement statement(GetDB().GetPrecompiledStatement(kAddVisitSql));
   statement.BindInt64(0, visit->url_id);
   statement.BindInt64(1, visit->visit_time.ToInternalValue());
   statement.BindInt64(2, visit->referring_visit);
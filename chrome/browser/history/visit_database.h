@@ -192,6 +192,10 @@ class VisitDatabase {
       std::vector<BriefVisitInfo>* result_vector);
 
  protected:
+  // SQL for the AddVisit() insert, exposed so that owners of the database
+  // can precompile it at open (see sql::Connection::Precompile).
+  static const char kAddVisitSql[];
+
   // Returns the database for the functions in this interface.
   virtual sql::Connection& GetDB() = 0;
 
@@ -0,0 +1,51 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "chrome/browser/idle_purge_coordinator.h"
+
+#include "base/bind.h"
+#include "base/memory/memory_pressure_listener.h"
+
+namespace {
+
+// How often to sample the idle state.
+const int kPollIntervalSeconds = 60;
+
+// How long the user must be away before caches are purged. Short enough to
+// catch a lunch break, long enough not to trigger while reading a page.
+const int kIdleThresholdSeconds = 300;
+
+}  // namespace
+
+IdlePurgeCoordinator::IdlePurgeCoordinator()
+    : purged_this_idle_period_(false),
+      weak_factory_(this) {
+  timer_.Start(FROM_HERE,
+               base::TimeDelta::FromSeconds(kPollIntervalSeconds),
+               this,
+               &IdlePurgeCoordinator::CheckIdleState);
+}
+
+IdlePurgeCoordinator::~IdlePurgeCoordinator() {
+}
+
+void IdlePurgeCoordinator::CheckIdleState() {
+  CalculateIdleState(kIdleThresholdSeconds,
+                     base::Bind(&IdlePurgeCoordinator::OnIdleState,
+                                weak_factory_.GetWeakPtr()));
+}
+
+void IdlePurgeCoordinator::OnIdleState(IdleState state) {
+  if (state == IDLE_STATE_ACTIVE) {
+    purged_this_idle_period_ = false;
+    return;
+  }
+  if (state != IDLE_STATE_IDLE && state != IDLE_STATE_LOCKED)
+    return;
+  if (purged_this_idle_period_)
+    return;
+  purged_this_idle_period_ = true;
+  base::MemoryPressureListener::NotifyMemoryPressure(
+      base::MemoryPressureListener::MEMORY_PRESSURE_MODERATE);
+}
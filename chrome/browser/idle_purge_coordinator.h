@@ -0,0 +1,39 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CHROME_BROWSER_IDLE_PURGE_COORDINATOR_H_
+#define CHROME_BROWSER_IDLE_PURGE_COORDINATOR_H_
+
+#include "base/basictypes.h"
+#include "base/memory/weak_ptr.h"
+#include "base/timer/timer.h"
+#include "chrome/browser/idle.h"
+
+// Periodically samples the user's idle state and, once per continuous idle
+// period, asks subsystems to release memory that is cheap to re-create.
+// Subsystems take part by registering a base::MemoryPressureListener, the
+// same registry the platform pressure signals use; on desktop platforms
+// nothing else broadcasts the moderate pressure level, so a long idle
+// period is the one opportunity to trim caches without hurting interactive
+// performance.
+class IdlePurgeCoordinator {
+ public:
+  IdlePurgeCoordinator();
+  ~IdlePurgeCoordinator();
+
+ private:
+  void CheckIdleState();
+  void OnIdleState(IdleState state);
+
+  // Set once the purge notification has been sent for the current idle
+  // period, and cleared when the user becomes active again.
+  bool purged_this_idle_period_;
+
+  base::RepeatingTimer<IdlePurgeCoordinator> timer_;
+  base::WeakPtrFactory<IdlePurgeCoordinator> weak_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(IdlePurgeCoordinator);
+};
+
+#endif  // CHROME_BROWSER_IDLE_PURGE_COORDINATOR_H_
@@ -159,6 +159,32 @@ bool VariationsSeedStore::LoadSeed(VariationsSeed* seed) {
   return true;
 }
 
+bool VariationsSeedStore::LoadSeedCache(const std::string& fingerprint,
+                                        std::string* cache_data) {
+  const std::string base64_cache_data =
+      local_state_->GetString(prefs::kVariationsSeedCache);
+  if (base64_cache_data.empty())
+    return false;
+
+  if (local_state_->GetString(prefs::kVariationsSeedCacheFingerprint) !=
+          fingerprint ||
+      !base::Base64Decode(base64_cache_data, cache_data)) {
+    VLOG(1) << "Variations seed cache is stale or corrupt, clearing the "
+            << "prefs.";
+    ClearSeedCachePrefs();
+    return false;
+  }
+  return true;
+}
+
+void VariationsSeedStore::StoreSeedCache(const std::string& fingerprint,
+                                         const std::string& cache_data) {
+  std::string base64_cache_data;
+  base::Base64Encode(cache_data, &base64_cache_data);
+  local_state_->SetString(prefs::kVariationsSeedCache, base64_cache_data);
+  local_state_->SetString(prefs::kVariationsSeedCacheFingerprint, fingerprint);
+}
+
 bool VariationsSeedStore::StoreSeedData(
     const std::string& seed_data,
     const std::string& base64_seed_signature,
@@ -197,6 +223,9 @@ bool VariationsSeedStore::StoreSeedData(
   local_state_->ClearPref(prefs::kVariationsSeedHash);
 
   local_state_->SetString(prefs::kVariationsSeed, base64_seed_data);
+  // The filtered-study cache was built from the previous seed; a new seed
+  // invalidates it.
+  ClearSeedCachePrefs();
   UpdateSeedDateAndLogDayChange(date_fetched);
   local_state_->SetString(prefs::kVariationsSeedSignature,
                           base64_seed_signature);
@@ -230,6 +259,9 @@ void VariationsSeedStore::UpdateSeedDateAndLogDayChange(
 // static
 void VariationsSeedStore::RegisterPrefs(PrefRegistrySimple* registry) {
   registry->RegisterStringPref(prefs::kVariationsSeed, std::string());
+  registry->RegisterStringPref(prefs::kVariationsSeedCache, std::string());
+  registry->RegisterStringPref(prefs::kVariationsSeedCacheFingerprint,
+                               std::string());
   registry->RegisterStringPref(prefs::kVariationsSeedHash, std::string());
   registry->RegisterInt64Pref(prefs::kVariationsSeedDate,
                               base::Time().ToInternalValue());
@@ -241,6 +273,12 @@ void VariationsSeedStore::ClearPrefs() {
   local_state_->ClearPref(prefs::kVariationsSeedDate);
   local_state_->ClearPref(prefs::kVariationsSeedHash);
   local_state_->ClearPref(prefs::kVariationsSeedSignature);
+  ClearSeedCachePrefs();
+}
+
+void VariationsSeedStore::ClearSeedCachePrefs() {
+  local_state_->ClearPref(prefs::kVariationsSeedCache);
+  local_state_->ClearPref(prefs::kVariationsSeedCacheFingerprint);
 }
 
 VariationsSeedStore::VerifySignatureResult
@@ -30,6 +30,19 @@ class VariationsSeedStore {
   // successful, |seed| will contain the loaded data and true is returned.
   bool LoadSeed(VariationsSeed* seed);
 
+  // Loads the filtered-study cache blob from local state into |cache_data|.
+  // The cache is only returned if it was stored with the same |fingerprint|
+  // (a string describing the configuration the cache was built for, e.g.
+  // product version and locale); on mismatch or corruption the cache prefs
+  // are cleared and false is returned.
+  bool LoadSeedCache(const std::string& fingerprint, std::string* cache_data);
+
+  // Stores |cache_data| (a blob produced by
+  // VariationsSeedProcessor::BuildSeedCache()) along with |fingerprint| to
+  // local state. The cache is cleared whenever new seed data is stored.
+  void StoreSeedCache(const std::string& fingerprint,
+                      const std::string& cache_data);
+
   // Stores the given seed data (serialized protobuf data) to local state, along
   // with a base64-encoded digital signature for seed and the date when it was
   // fetched. The |seed_data| will be base64 encoded for storage. If the string
@@ -50,6 +63,13 @@ class VariationsSeedStore {
     return variations_serial_number_;
   }
 
+  // Records the serial number of the seed that the filtered-study cache was
+  // built from, so that fetches can report it even when the full seed was
+  // never loaded this session.
+  void set_variations_serial_number(const std::string& serial_number) {
+    variations_serial_number_ = serial_number;
+  }
+
   // Registers Local State prefs used by this class.
   static void RegisterPrefs(PrefRegistrySimple* registry);
 
@@ -80,6 +100,9 @@ class VariationsSeedStore {
   // Clears all prefs related to variations seed storage.
   void ClearPrefs();
 
+  // Clears the prefs holding the filtered-study cache.
+  void ClearSeedCachePrefs();
+
   // The pref service used to persist the variations seed.
   PrefService* local_state_;
 
@@ -125,6 +125,32 @@ TEST(VariationsSeedStoreTest, LoadSeed) {
   EXPECT_FALSE(seed_store.LoadSeed(&loaded_seed));
 }
 
+TEST(VariationsSeedStoreTest, SeedCache) {
+  TestingPrefServiceSimple prefs;
+  VariationsSeedStore::RegisterPrefs(prefs.registry());
+  TestVariationsSeedStore seed_store(&prefs);
+
+  // Loading before anything is stored should fail.
+  std::string cache_data;
+  EXPECT_FALSE(seed_store.LoadSeedCache("fingerprint", &cache_data));
+
+  // A stored cache should round-trip under the same fingerprint.
+  seed_store.StoreSeedCache("fingerprint", "cache blob");
+  EXPECT_TRUE(seed_store.LoadSeedCache("fingerprint", &cache_data));
+  EXPECT_EQ("cache blob", cache_data);
+
+  // Loading with a different fingerprint should clear the cache prefs.
+  EXPECT_FALSE(seed_store.LoadSeedCache("other fingerprint", &cache_data));
+  EXPECT_TRUE(PrefHasDefaultValue(prefs, prefs::kVariationsSeedCache));
+  EXPECT_FALSE(seed_store.LoadSeedCache("fingerprint", &cache_data));
+
+  // Storing new seed data should invalidate the cache.
+  seed_store.StoreSeedCache("fingerprint", "cache blob");
+  EXPECT_TRUE(seed_store.StoreSeedForTesting(SerializeSeed(CreateTestSeed())));
+  EXPECT_FALSE(seed_store.LoadSeedCache("fingerprint", &cache_data));
+  EXPECT_TRUE(PrefHasDefaultValue(prefs, prefs::kVariationsSeedCache));
+}
+
 TEST(VariationsSeedStoreTest, StoreSeedData) {
   const VariationsSeed seed = CreateTestSeed();
   const std::string serialized_seed = SerializeSeed(seed);
@@ -241,10 +241,6 @@ VariationsService::~VariationsService() {
 bool VariationsService::CreateTrialsFromSeed() {
   create_trials_from_seed_called_ = true;
 
-  VariationsSeed seed;
-  if (!seed_store_.LoadSeed(&seed))
-    return false;
-
   const chrome::VersionInfo current_version_info;
   if (!current_version_info.is_valid())
     return false;
@@ -253,10 +249,44 @@ bool VariationsService::CreateTrialsFromSeed() {
   if (!current_version.IsValid())
     return false;
 
-  VariationsSeedProcessor().CreateTrialsFromSeed(
-      seed, g_browser_process->GetApplicationLocale(),
-      GetReferenceDateForExpiryChecks(local_state_), current_version,
-      GetChannelForVariations(), GetCurrentFormFactor(), GetHardwareClass());
+  const std::string locale = g_browser_process->GetApplicationLocale();
+  const base::Time reference_date =
+      GetReferenceDateForExpiryChecks(local_state_);
+  // The filtered-study cache is only valid for the configuration it was
+  // built with. The channel, form factor and hardware class are implied by
+  // the version and the install, so version and locale suffice.
+  const std::string cache_fingerprint =
+      current_version.GetString() + "," + locale;
+
+  std::string cache_data;
+  std::string cached_serial_number;
+  if (seed_store_.LoadSeedCache(cache_fingerprint, &cache_data) &&
+      VariationsSeedProcessor().CreateTrialsFromSeedCache(
+          cache_data, reference_date, &cached_serial_number)) {
+    // Lets seed fetches report the serial number of the seed the trials came
+    // from, even though the full seed was never parsed this session.
+    seed_store_.set_variations_serial_number(cached_serial_number);
+  } else {
+    VariationsSeed seed;
+    if (!seed_store_.LoadSeed(&seed))
+      return false;
+
+    VariationsSeedProcessor().CreateTrialsFromSeed(
+        seed, locale, reference_date, current_version,
+        GetChannelForVariations(), GetCurrentFormFactor(),
+        GetHardwareClass());
+
+    // Build the filtered-study cache so that the next launch can skip seed
+    // processing. This re-runs the study filters, but only when the cache
+    // was missing or stale, i.e. at most once per downloaded seed.
+    std::string new_cache_data;
+    if (VariationsSeedProcessor().BuildSeedCache(
+            seed, locale, reference_date, current_version,
+            GetChannelForVariations(), GetCurrentFormFactor(),
+            GetHardwareClass(), &new_cache_data)) {
+      seed_store_.StoreSeedCache(cache_fingerprint, new_cache_data);
+    }
+  }
 
   // Log the "freshness" of the seed that was just used. The freshness is the
   // time between the last successful seed download and now.
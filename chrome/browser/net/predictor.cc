@@ -71,6 +71,7 @@ const int64 Predictor::kDurationBetweenTrimmingIncrementsSeconds = 15;
 const size_t Predictor::kUrlsTrimmedPerIncrement = 5u;
 const size_t Predictor::kMaxSpeculativeParallelResolves = 3;
 const int Predictor::kMaxUnusedSocketLifetimeSecondsWithoutAGet = 10;
+const size_t Predictor::kMaxSpeculativeStartupPreconnects = 2u;
 // To control our congestion avoidance system, which discards a queue when
 // resolutions are "taking too long," we need an expected resolution time.
 // Common average is in the range of 300-500ms.
@@ -310,6 +311,24 @@ void Predictor::PreconnectUrlAndSubresources(const GURL& url,
   PredictFrameSubresources(url.GetWithEmptyPath(), first_party_for_cookies);
 }
 
+void Predictor::PreconnectStartupUrls(const UrlList& startup_urls) {
+  DCHECK(BrowserThread::CurrentlyOn(BrowserThread::UI) ||
+         BrowserThread::CurrentlyOn(BrowserThread::IO));
+  if (!predictor_enabled_ || !preconnect_enabled())
+    return;
+
+  size_t preconnect_count =
+      std::min(startup_urls.size(), kMaxSpeculativeStartupPreconnects);
+  const int kConnectionsNeeded = 1;
+  for (size_t i = 0; i < preconnect_count; ++i) {
+    const GURL& url = startup_urls[i];
+    if (!url.is_valid() || !url.has_host())
+      continue;
+    PreconnectUrl(CanonicalizeUrl(url), url,
+                  UrlInfo::STARTUP_LIST_MOTIVATED, kConnectionsNeeded);
+  }
+}
+
 UrlList Predictor::GetPredictedUrlListAtStartup(
     PrefService* user_prefs,
     PrefService* local_state) {
@@ -697,6 +716,11 @@ void Predictor::FinalizeInitializationOnIOThread(
   // TODO(groby): Check if WeakPtrFactory has the same constraint.
   weak_factory_.reset(new base::WeakPtrFactory<Predictor>(this));
 
+  // Preconnect to the leading entries of the startup list, which were the
+  // most significant navigations of the last session, so that connections are
+  // warm before any render process has started up to request them.
+  PreconnectStartupUrls(startup_urls);
+
   // Prefetch these hostnames on startup.
   DnsPrefetchMotivatedList(startup_urls, UrlInfo::STARTUP_LIST_MOTIVATED);
   DeserializeReferrersThenDelete(referral_list);
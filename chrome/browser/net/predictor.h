@@ -106,6 +106,14 @@ class Predictor {
   // avoidance will kick in and all speculations in the queue will be discarded.
   static const int kMaxSpeculativeResolveQueueDelayMs;
 
+  // At startup we preconnect to the first few URLs learned from the previous
+  // session's navigation history, rather than merely pre-resolving their
+  // hostnames.  The startup list is ordered by original navigation time, so
+  // the leading entries were (presumably) the most significant to the user,
+  // and will (presumably) be needed first again.  We keep the count small to
+  // avoid burning sockets the user may not need this session.
+  static const size_t kMaxSpeculativeStartupPreconnects;
+
   // We don't bother learning to preconnect via a GET if the original URL
   // navigation was so long ago, that a preconnection would have been dropped
   // anyway.  We believe most servers will drop the connection in 10 seconds, so
@@ -142,6 +150,11 @@ class Predictor {
   void PreconnectUrlAndSubresources(const GURL& url,
                                     const GURL& first_party_for_cookies);
 
+  // Preconnect to the leading entries of |startup_urls|, the navigations that
+  // began the previous session, capped at kMaxSpeculativeStartupPreconnects.
+  // Later entries are left to the ordinary startup DNS pre-resolution.
+  void PreconnectStartupUrls(const UrlList& startup_urls);
+
   static UrlList GetPredictedUrlListAtStartup(PrefService* user_prefs,
                                               PrefService* local_state);
 
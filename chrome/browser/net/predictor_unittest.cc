@@ -711,6 +711,27 @@ class TestPredictorObserver : public PredictorObserver {
   std::vector<GURL> preconnected_urls_;
 };
 
+// Tests that only the leading entries of the startup list are speculatively
+// preconnected.
+TEST_F(PredictorTest, PreconnectStartupUrls) {
+  Predictor predictor(true);
+  TestPredictorObserver observer;
+  predictor.SetObserver(&observer);
+
+  UrlList startup_urls;
+  startup_urls.push_back(GURL("http://www.google.com:80"));
+  startup_urls.push_back(GURL("http://www.example.com:80"));
+  startup_urls.push_back(GURL("http://www.chromium.org:80"));
+  predictor.PreconnectStartupUrls(startup_urls);
+
+  ASSERT_EQ(Predictor::kMaxSpeculativeStartupPreconnects,
+            observer.preconnected_urls_.size());
+  EXPECT_EQ(startup_urls[0], observer.preconnected_urls_[0]);
+  EXPECT_EQ(startup_urls[1], observer.preconnected_urls_[1]);
+
+  predictor.Shutdown();
+}
+
 // Tests that preconnects apply the HSTS list.
 TEST_F(PredictorTest, HSTSRedirect) {
   const GURL kHttpUrl("http://example.com");
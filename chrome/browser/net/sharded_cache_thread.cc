@@ -0,0 +1,68 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "chrome/browser/net/sharded_cache_thread.h"
+
+#include "base/files/file_path.h"
+#include "base/format_macros.h"
+#include "base/hash.h"
+#include "base/lazy_instance.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/message_loop/message_loop_proxy.h"
+#include "base/strings/stringprintf.h"
+#include "base/synchronization/lock.h"
+#include "base/threading/thread.h"
+#include "content/public/browser/browser_thread.h"
+
+namespace chrome_browser_net {
+
+namespace {
+
+// Shard 0 is the regular CACHE browser thread; the other shards are backed by
+// threads created lazily the first time some cache path hashes to them, so a
+// single-profile browser never pays for more than one cache thread.
+const size_t kNumCacheShards = 4;
+
+struct CacheShards {
+  CacheShards() {
+    for (size_t i = 0; i < kNumCacheShards; ++i)
+      threads[i] = NULL;
+  }
+
+  base::Lock lock;
+
+  // The extra cache threads. These are intentionally never destroyed: cache
+  // backends may post work to them until very late in shutdown, just as they
+  // do with the CACHE browser thread.
+  base::Thread* threads[kNumCacheShards];
+};
+
+base::LazyInstance<CacheShards>::Leaky g_cache_shards =
+    LAZY_INSTANCE_INITIALIZER;
+
+}  // namespace
+
+scoped_refptr<base::MessageLoopProxy> GetCacheThreadForCachePath(
+    const base::FilePath& cache_path) {
+  size_t shard = base::Hash(cache_path.AsUTF8Unsafe()) % kNumCacheShards;
+  if (shard == 0) {
+    return content::BrowserThread::GetMessageLoopProxyForThread(
+        content::BrowserThread::CACHE);
+  }
+
+  CacheShards* shards = g_cache_shards.Pointer();
+  base::AutoLock lock(shards->lock);
+  if (!shards->threads[shard]) {
+    scoped_ptr<base::Thread> thread(
+        new base::Thread(base::StringPrintf("CacheShard%" PRIuS, shard)));
+    base::Thread::Options options;
+    // The blockfile backend on Windows does overlapped IO on this thread.
+    options.message_loop_type = base::MessageLoop::TYPE_IO;
+    CHECK(thread->StartWithOptions(options));
+    shards->threads[shard] = thread.release();
+  }
+  return shards->threads[shard]->message_loop_proxy();
+}
+
+}  // namespace chrome_browser_net
@@ -0,0 +1,29 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CHROME_BROWSER_NET_SHARDED_CACHE_THREAD_H_
+#define CHROME_BROWSER_NET_SHARDED_CACHE_THREAD_H_
+
+#include "base/memory/ref_counted.h"
+
+namespace base {
+class FilePath;
+class MessageLoopProxy;
+}
+
+namespace chrome_browser_net {
+
+// Returns the thread that disk cache backends using |cache_path| should run
+// on. Cache paths are sharded over a small set of cache threads so that in
+// multi-profile deployments the backends of different profiles do not
+// serialize all of their control operations behind the single CACHE browser
+// thread. The shard chosen for a path is stable for the lifetime of the
+// process, so every backend for one cache directory always ends up on the
+// same thread. May be called from any thread.
+scoped_refptr<base::MessageLoopProxy> GetCacheThreadForCachePath(
+    const base::FilePath& cache_path);
+
+}  // namespace chrome_browser_net
+
+#endif  // CHROME_BROWSER_NET_SHARDED_CACHE_THREAD_H_
@@ -79,6 +79,7 @@ class PrefixSet {
 
   friend class PrefixSetTest;
   FRIEND_TEST_ALL_PREFIXES(PrefixSetTest, AllBig);
+  FRIEND_TEST_ALL_PREFIXES(PrefixSetTest, BloomFilter);
   FRIEND_TEST_ALL_PREFIXES(PrefixSetTest, EdgeCases);
   FRIEND_TEST_ALL_PREFIXES(PrefixSetTest, Empty);
   FRIEND_TEST_ALL_PREFIXES(PrefixSetTest, FullHashBuild);
@@ -117,6 +118,17 @@ class PrefixSet {
   // Provided for testing purposes.
   bool PrefixExists(SBPrefix prefix) const;
 
+  // Rebuild the Bloom pre-filter from |index_| and |deltas_|.  Called once
+  // the prefix data is final.
+  void BuildBloomFilter();
+
+  // Set the pre-filter bits for |prefix|.
+  void AddToBloomFilter(SBPrefix prefix);
+
+  // |false| only if |prefix| is definitely not in the set, allowing
+  // |PrefixExists()| to reject most misses with two cache probes.
+  bool PrefixMightExist(SBPrefix prefix) const;
+
   // Regenerate the vector of prefixes passed to the constructor into
   // |prefixes|.  Prefixes will be added in sorted order.  Useful for testing.
   void GetPrefixes(std::vector<SBPrefix>* prefixes) const;
@@ -143,6 +155,11 @@ class PrefixSet {
   // Full hashes ordered by SBFullHashLess.
   std::vector<SBFullHash> full_hashes_;
 
+  // Bit array of the Bloom pre-filter over all prefixes, sized to a power
+  // of two bits.  Not persisted; rebuilt when the set is built or loaded.
+  std::vector<uint32> bloom_filter_;
+  uint32 bloom_bit_mask_;
+
   DISALLOW_COPY_AND_ASSIGN(PrefixSet);
 };
 
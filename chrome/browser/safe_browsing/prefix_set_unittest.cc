@@ -217,6 +217,26 @@ TEST_F(PrefixSetTest, Baseline) {
   CheckPrefixes(*builder.GetPrefixSetNoHashes(), shared_prefixes_);
 }
 
+// The Bloom pre-filter may pass prefixes that aren't in the set, but must
+// never reject one that is, whether the set was built or read from disk.
+TEST_F(PrefixSetTest, BloomFilter) {
+  PrefixSetBuilder builder(shared_prefixes_);
+  scoped_ptr<PrefixSet> prefix_set = builder.GetPrefixSetNoHashes();
+  EXPECT_FALSE(prefix_set->bloom_filter_.empty());
+  for (size_t i = 0; i < shared_prefixes_.size(); ++i) {
+    EXPECT_TRUE(prefix_set->PrefixMightExist(shared_prefixes_[i]));
+  }
+
+  base::FilePath filename;
+  ASSERT_TRUE(GetPrefixSetFile(&filename));
+  scoped_ptr<PrefixSet> read_set = PrefixSet::LoadFile(filename);
+  ASSERT_TRUE(read_set.get());
+  EXPECT_FALSE(read_set->bloom_filter_.empty());
+  for (size_t i = 0; i < shared_prefixes_.size(); ++i) {
+    EXPECT_TRUE(read_set->PrefixMightExist(shared_prefixes_[i]));
+  }
+}
+
 // Test that the empty set doesn't appear to have anything in it.
 TEST_F(PrefixSetTest, Empty) {
   const std::vector<SBPrefix> empty;
@@ -98,6 +98,12 @@ bool SessionFileReader::Read(BaseSessionService::SessionType type,
       header.version != kFileCurrentVersion)
     return false;
 
+  // Size the buffer to the remainder of the file so the command loop consumes
+  // it with a single read rather than refilling a small buffer repeatedly.
+  int64 remaining = file_->GetLength() - sizeof(header);
+  if (remaining > static_cast<int64>(buffer_.size()))
+    buffer_.resize(static_cast<size_t>(remaining), 0);
+
   ScopedVector<SessionCommand> read_commands;
   for (SessionCommand* command = ReadCommand(); command && !errored_;
        command = ReadCommand())
@@ -303,36 +309,36 @@ bool SessionBackend::ReadCurrentSessionCommandsImpl(
 
 bool SessionBackend::AppendCommandsToFile(base::File* file,
     const std::vector<SessionCommand*>& commands) {
+  // Serialize all the commands into one buffer and write it in a single
+  // call. Resets rewrite the complete session state as one command batch, so
+  // writing record-at-a-time costs three write calls per command for what is
+  // logically one snapshot.
+  std::string buffer;
   for (std::vector<SessionCommand*>::const_iterator i = commands.begin();
        i != commands.end(); ++i) {
-    int wrote;
     const size_type content_size = static_cast<size_type>((*i)->size());
     const size_type total_size =  content_size + sizeof(id_type);
     if (type_ == BaseSessionService::TAB_RESTORE)
       UMA_HISTOGRAM_COUNTS("TabRestore.command_size", total_size);
     else
       UMA_HISTOGRAM_COUNTS("SessionRestore.command_size", total_size);
-    wrote = file->WriteAtCurrentPos(reinterpret_cast<const char*>(&total_size),
-                                    sizeof(total_size));
-    if (wrote != sizeof(total_size)) {
-      NOTREACHED() << "error writing";
-      return false;
-    }
+    buffer.append(reinterpret_cast<const char*>(&total_size),
+                  sizeof(total_size));
     id_type command_id = (*i)->id();
-    wrote = file->WriteAtCurrentPos(reinterpret_cast<char*>(&command_id),
-                                    sizeof(command_id));
-    if (wrote != sizeof(command_id)) {
+    buffer.append(reinterpret_cast<const char*>(&command_id),
+                  sizeof(command_id));
+    if (content_size > 0) {
+      buffer.append(reinterpret_cast<const char*>((*i)->contents()),
+                    content_size);
+    }
+  }
+  if (!buffer.empty()) {
+    int wrote = file->WriteAtCurrentPos(buffer.data(),
+                                        static_cast<int>(buffer.size()));
+    if (wrote != static_cast<int>(buffer.size())) {
       NOTREACHED() << "error writing";
       return false;
     }
-    if (content_size > 0) {
-      wrote = file->WriteAtCurrentPos(reinterpret_cast<char*>((*i)->contents()),
-                                      content_size);
-      if (wrote != content_size) {
-        NOTREACHED() << "error writing";
-        return false;
-      }
-    }
   }
 #if defined(OS_CHROMEOS)
   file->Flush();
@@ -128,7 +128,17 @@ bool TypedUrlChangeProcessor::CreateOrUpdateSyncNode(
   syncer::BaseNode::InitByLookupResult result =
       update_node.InitByClientTagLookup(syncer::TYPED_URLS, tag);
   if (result == syncer::BaseNode::INIT_OK) {
-    model_associator_->WriteToSyncNode(url, visit_vector, &update_node);
+    // Only touch the node if something sync-visible changed. Many history
+    // notifications (visit count bumps past the visit cap, fixups done by
+    // the associator) produce specifics identical to what the node already
+    // holds, and rewriting an unchanged node just generates sync traffic.
+    sync_pb::TypedUrlSpecifics new_specifics;
+    TypedUrlModelAssociator::WriteToTypedUrlSpecifics(url, visit_vector,
+                                                      &new_specifics);
+    if (new_specifics.SerializeAsString() !=
+        update_node.GetTypedUrlSpecifics().SerializeAsString()) {
+      update_node.SetTypedUrlSpecifics(new_specifics);
+    }
   } else if (result == syncer::BaseNode::INIT_FAILED_DECRYPT_IF_NECESSARY) {
     // TODO(tim): Investigating bug 121587.
     syncer::Cryptographer* crypto = trans->GetCryptographer();
@@ -59,6 +59,10 @@ void DeathDataSnapshotToValue(const DeathDataSnapshot& death_data,
                   base::Value::CreateIntegerValue(death_data.count));
   dictionary->Set("run_ms",
                   base::Value::CreateIntegerValue(death_data.run_duration_sum));
+  // Sums of squares can exceed the integer range; serialize as a double.
+  dictionary->Set("run_ms_sum_squares",
+                  base::Value::CreateDoubleValue(static_cast<double>(
+                      death_data.run_duration_sum_squares)));
   dictionary->Set("run_ms_max",
                   base::Value::CreateIntegerValue(death_data.run_duration_max));
   dictionary->Set("run_ms_sample",
@@ -77,6 +77,7 @@ TEST(TaskProfilerDataSerializerTest, SerializeProcessDataToJson) {
     process_data.tasks.back().death_data.run_duration_max = 5;
     process_data.tasks.back().death_data.run_duration_sample = 3;
     process_data.tasks.back().death_data.run_duration_sum = 17;
+    process_data.tasks.back().death_data.run_duration_sum_squares = 107;
     process_data.tasks.back().death_data.queue_duration_max = 53;
     process_data.tasks.back().death_data.queue_duration_sample = 13;
     process_data.tasks.back().death_data.queue_duration_sum = 79;
@@ -89,6 +90,7 @@ TEST(TaskProfilerDataSerializerTest, SerializeProcessDataToJson) {
     process_data.tasks.back().death_data.run_duration_max = 205;
     process_data.tasks.back().death_data.run_duration_sample = 203;
     process_data.tasks.back().death_data.run_duration_sum = 2017;
+    process_data.tasks.back().death_data.run_duration_sum_squares = 20017;
     process_data.tasks.back().death_data.queue_duration_max = 2053;
     process_data.tasks.back().death_data.queue_duration_sample = 2013;
     process_data.tasks.back().death_data.queue_duration_sum = 2079;
@@ -133,7 +135,8 @@ TEST(TaskProfilerDataSerializerTest, SerializeProcessDataToJson) {
                                 "\"queue_ms_sample\":13,"
                                 "\"run_ms\":17,"
                                 "\"run_ms_max\":5,"
-                                "\"run_ms_sample\":3"
+                                "\"run_ms_sample\":3,"
+                                "\"run_ms_sum_squares\":107.0"
                              "},"
                              "\"death_thread\":\"WorkerPool/-1340960768\""
                           "},{"
@@ -150,7 +153,8 @@ TEST(TaskProfilerDataSerializerTest, SerializeProcessDataToJson) {
                                 "\"queue_ms_sample\":2013,"
                                 "\"run_ms\":2017,"
                                 "\"run_ms_max\":205,"
-                                "\"run_ms_sample\":203"
+                                "\"run_ms_sample\":203,"
+                                "\"run_ms_sum_squares\":20017.0"
                              "},"
                              "\"death_thread\":\"PAC thread #3\""
                           "}],"
@@ -120,8 +120,11 @@ static const SkColor kMiniTitleChangeGradientColor2 =
     SkColorSetARGB(0, 255, 255, 255);
 
 // Max number of images to cache. This has to be at least two since rounding
-// errors may lead to tabs in the same tabstrip having different sizes.
-const size_t kMaxImageCacheSize = 4;
+// errors may lead to tabs in the same tabstrip having different sizes. It
+// also has to leave room for each image to be cached at two device scale
+// factors, so that moving a window between displays with different scales
+// doesn't evict one display's images while painting for the other.
+const size_t kMaxImageCacheSize = 8;
 
 // Height of the miniature tab strip in immersive mode.
 const int kImmersiveTabHeight = 3;
@@ -1633,11 +1636,15 @@ void Tab::LoadTabImages() {
 gfx::ImageSkia Tab::GetCachedImage(int resource_id,
                                    const gfx::Size& size,
                                    ui::ScaleFactor scale_factor) {
-  for (ImageCache::const_iterator i = image_cache_->begin();
+  for (ImageCache::iterator i = image_cache_->begin();
        i != image_cache_->end(); ++i) {
     if (i->resource_id == resource_id && i->scale_factor == scale_factor &&
         i->image.size() == size) {
-      return i->image;
+      // Move the entry to the front so that eviction is least-recently-used.
+      // Otherwise entries that are hit on every paint can be evicted by
+      // one-off entries, e.g. the sizes generated during a tab animation.
+      image_cache_->splice(image_cache_->begin(), *image_cache_, i);
+      return image_cache_->front().image;
     }
   }
   return gfx::ImageSkia();
@@ -1003,6 +1003,11 @@ const char kProfilingAtStart[]              = "profiling-at-start";
 // The default is chrome-profile-{pid}.
 const char kProfilingFile[]                 = "profiling-file";
 
+// Bounds a sampling profiler run started via kProfilingAtStart or the
+// profiling hotkey: profiling is stopped and the profile written out after
+// the given number of seconds instead of running until exit.
+const char kProfilingDuration[]             = "profiling-duration";
+
 // Specifies a path for the output of task-level profiling which can be loaded
 // and viewed in about:profiler.
 const char kProfilingOutputFile[]           = "profiling-output-file";
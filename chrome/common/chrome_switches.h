@@ -284,6 +284,7 @@ extern const char kPrivetIPv6Only[];
 extern const char kProductVersion[];
 extern const char kProfileDirectory[];
 extern const char kProfilingAtStart[];
+extern const char kProfilingDuration[];
 extern const char kProfilingFile[];
 extern const char kProfilingFlush[];
 extern const char kProfilingOutputFile[];
@@ -1286,6 +1286,15 @@ const char kVariationsRestrictParameter[] = "variations_restrict_parameter";
 // String serialized form of variations seed protobuf.
 const char kVariationsSeed[] = "variations_seed";
 
+// Serialized form of the filtered studies from the last processed seed,
+// used to create field trials without re-processing the full seed.
+const char kVariationsSeedCache[] = "variations_seed_cache";
+
+// Describes the configuration (e.g. product version and locale) that
+// kVariationsSeedCache was built for; the cache is discarded on mismatch.
+const char kVariationsSeedCacheFingerprint[] =
+    "variations_seed_cache_fingerprint";
+
 // 64-bit integer serialization of the base::Time from the last seed received.
 const char kVariationsSeedDate[] = "variations_seed_date";
 
@@ -420,6 +420,8 @@ extern const char kCrashReportingEnabled[];
 extern const char kVariationsLastFetchTime[];
 extern const char kVariationsRestrictParameter[];
 extern const char kVariationsSeed[];
+extern const char kVariationsSeedCache[];
+extern const char kVariationsSeedCacheFingerprint[];
 extern const char kVariationsSeedDate[];
 extern const char kVariationsSeedHash[];
 extern const char kVariationsSeedSignature[];
@@ -85,21 +85,38 @@ void FlushProfilingData(base::Thread* thread) {
       base::TimeDelta::FromSeconds(flush_seconds));
 }
 
+// Stops a bounded profiling run; scheduled by ScheduleStop(). Runs on the
+// profiling control thread, so it must not tear that thread down.
+void StopProfilingTask() {
+  if (base::debug::BeingProfiled())
+    base::debug::StopProfiling();
+}
+
 class ProfilingThreadControl {
  public:
-  ProfilingThreadControl() : thread_(NULL) {}
+  ProfilingThreadControl() : thread_(NULL), flush_scheduled_(false) {}
 
   void Start() {
     base::AutoLock locked(lock_);
-
-    if (thread_ && thread_->IsRunning())
+    if (flush_scheduled_)
       return;
-    thread_ = new base::Thread("Profiling_Flush");
-    thread_->Start();
+    EnsureThreadRunning();
+    flush_scheduled_ = true;
     thread_->message_loop()->PostTask(
         FROM_HERE, base::Bind(&FlushProfilingData, thread_));
   }
 
+  // Arranges for profiling to be stopped (and the profile written out)
+  // |seconds| from now.
+  void ScheduleStop(int seconds) {
+    base::AutoLock locked(lock_);
+    EnsureThreadRunning();
+    thread_->message_loop()->PostDelayedTask(
+        FROM_HERE,
+        base::Bind(&StopProfilingTask),
+        base::TimeDelta::FromSeconds(seconds));
+  }
+
   void Stop() {
     base::AutoLock locked(lock_);
 
@@ -108,12 +125,26 @@ class ProfilingThreadControl {
     thread_->Stop();
     delete thread_;
     thread_ = NULL;
+    flush_scheduled_ = false;
   }
 
  private:
+  // Starts the control thread if it is not already running. |lock_| must be
+  // held.
+  void EnsureThreadRunning() {
+    lock_.AssertAcquired();
+    if (thread_ && thread_->IsRunning())
+      return;
+    thread_ = new base::Thread("Profiling_Flush");
+    thread_->Start();
+  }
+
   base::Thread* thread_;
   base::Lock lock_;
 
+  // Whether the periodic flush task chain has been posted to |thread_|.
+  bool flush_scheduled_;
+
   DISALLOW_COPY_AND_ASSIGN(ProfilingThreadControl);
 };
 
@@ -175,6 +206,17 @@ void Profiling::Start() {
   // get written out correctly on exit.
   if (flush)
     g_flush_thread_control.Get().Start();
+
+  // A bounded run stops itself and writes the profile out once the requested
+  // sampling window has elapsed.
+  std::string duration =
+      command_line.GetSwitchValueASCII(switches::kProfilingDuration);
+  if (!duration.empty()) {
+    int seconds = atoi(duration.c_str());
+    DCHECK(seconds > 0);
+    if (seconds > 0)
+      g_flush_thread_control.Get().ScheduleStop(seconds);
+  }
 }
 
 // static
@@ -1081,12 +1081,15 @@ void PrintWebViewHelper::OnFramePreparedForPreviewDocument() {
     PrepareFrameForPreviewDocument();
     return;
   }
-  DidFinishPrinting(CreatePreviewDocument() ? OK : FAIL_PREVIEW);
+  const CreatePreviewDocumentResult result = CreatePreviewDocument();
+  if (result != CREATE_IN_PROGRESS)
+    DidFinishPrinting(result == CREATE_SUCCESS ? OK : FAIL_PREVIEW);
 }
 
-bool PrintWebViewHelper::CreatePreviewDocument() {
+PrintWebViewHelper::CreatePreviewDocumentResult
+PrintWebViewHelper::CreatePreviewDocument() {
   if (!print_pages_params_ || CheckForCancel())
-    return false;
+    return CREATE_FAIL;
 
   UMA_HISTOGRAM_ENUMERATION("PrintPreview.PreviewEvent",
                             PREVIEW_EVENT_CREATE_DOCUMENT, PREVIEW_EVENT_MAX);
@@ -1096,7 +1099,7 @@ bool PrintWebViewHelper::CreatePreviewDocument() {
 
   if (!print_preview_context_.CreatePreviewDocument(prep_frame_view_.release(),
                                                     pages)) {
-    return false;
+    return CREATE_FAIL;
   }
 
   PageSizeMargins default_page_layout;
@@ -1129,36 +1132,72 @@ bool PrintWebViewHelper::CreatePreviewDocument() {
   params.clear_preview_data = print_preview_context_.generate_draft_pages();
   Send(new PrintHostMsg_DidGetPreviewPageCount(routing_id(), params));
   if (CheckForCancel())
-    return false;
+    return CREATE_FAIL;
 
-  while (!print_preview_context_.IsFinalPageRendered()) {
-    int page_number = print_preview_context_.GetNextPageNumber();
-    DCHECK_GE(page_number, 0);
-    if (!RenderPreviewPage(page_number, print_params))
-      return false;
+  // Render the pages one per posted task rather than all in one loop, so
+  // that the renderer keeps processing input and IPC between pages. Each
+  // finished page is streamed to the browser immediately via
+  // PreviewPageRendered(), so the preview UI fills in as pages complete.
+  base::MessageLoop::current()->PostTask(
+      FROM_HERE,
+      base::Bind(&PrintWebViewHelper::RenderNextPreviewPage,
+                 weak_ptr_factory_.GetWeakPtr(),
+                 print_params.preview_request_id));
+  return CREATE_IN_PROGRESS;
+}
 
-    if (CheckForCancel())
-      return false;
+void PrintWebViewHelper::RenderNextPreviewPage(int preview_request_id) {
+  // A new preview request may have superseded this one while the task was
+  // queued; in that case a task for the new request is already pending.
+  if (!print_pages_params_ ||
+      print_pages_params_->params.preview_request_id != preview_request_id) {
+    return;
+  }
+
+  const PrintMsg_Print_Params& print_params = print_pages_params_->params;
+
+  int page_number = print_preview_context_.GetNextPageNumber();
+  DCHECK_GE(page_number, 0);
+  if (!RenderPreviewPage(page_number, print_params)) {
+    DidFinishPrinting(FAIL_PREVIEW);
+    return;
+  }
 
-    // We must call PrepareFrameAndViewForPrint::FinishPrinting() (by way of
-    // print_preview_context_.AllPagesRendered()) before calling
-    // FinalizePrintReadyDocument() when printing a PDF because the plugin
-    // code does not generate output until we call FinishPrinting().  We do not
-    // generate draft pages for PDFs, so IsFinalPageRendered() and
-    // IsLastPageOfPrintReadyMetafile() will be true in the same iteration of
-    // the loop.
-    if (print_preview_context_.IsFinalPageRendered())
-      print_preview_context_.AllPagesRendered();
-
-    if (print_preview_context_.IsLastPageOfPrintReadyMetafile()) {
-      DCHECK(print_preview_context_.IsModifiable() ||
-             print_preview_context_.IsFinalPageRendered());
-      if (!FinalizePrintReadyDocument())
-        return false;
+  if (CheckForCancel()) {
+    DidFinishPrinting(FAIL_PREVIEW);
+    return;
+  }
+
+  // We must call PrepareFrameAndViewForPrint::FinishPrinting() (by way of
+  // print_preview_context_.AllPagesRendered()) before calling
+  // FinalizePrintReadyDocument() when printing a PDF because the plugin
+  // code does not generate output until we call FinishPrinting().  We do not
+  // generate draft pages for PDFs, so IsFinalPageRendered() and
+  // IsLastPageOfPrintReadyMetafile() will be true in the same iteration of
+  // the loop.
+  if (print_preview_context_.IsFinalPageRendered())
+    print_preview_context_.AllPagesRendered();
+
+  if (print_preview_context_.IsLastPageOfPrintReadyMetafile()) {
+    DCHECK(print_preview_context_.IsModifiable() ||
+           print_preview_context_.IsFinalPageRendered());
+    if (!FinalizePrintReadyDocument()) {
+      DidFinishPrinting(FAIL_PREVIEW);
+      return;
     }
   }
-  print_preview_context_.Finished();
-  return true;
+
+  if (print_preview_context_.IsFinalPageRendered()) {
+    print_preview_context_.Finished();
+    DidFinishPrinting(OK);
+    return;
+  }
+
+  base::MessageLoop::current()->PostTask(
+      FROM_HERE,
+      base::Bind(&PrintWebViewHelper::RenderNextPreviewPage,
+                 weak_ptr_factory_.GetWeakPtr(),
+                 preview_request_id));
 }
 
 bool PrintWebViewHelper::FinalizePrintReadyDocument() {
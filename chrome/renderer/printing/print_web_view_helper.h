@@ -91,6 +91,12 @@ class PrintWebViewHelper
     FAIL_PREVIEW,
   };
 
+  enum CreatePreviewDocumentResult {
+    CREATE_SUCCESS,
+    CREATE_IN_PROGRESS,
+    CREATE_FAIL,
+  };
+
   enum PrintPreviewErrorBuckets {
     PREVIEW_ERROR_NONE,  // Always first.
     PREVIEW_ERROR_BAD_SETTING,
@@ -145,8 +151,17 @@ class PrintWebViewHelper
   // Continue creating preview document.
   void OnFramePreparedForPreviewDocument();
 
-  // Initialize the print preview document.
-  bool CreatePreviewDocument();
+  // Initialize the print preview document. On CREATE_IN_PROGRESS, page
+  // rendering continues asynchronously via RenderNextPreviewPage().
+  CreatePreviewDocumentResult CreatePreviewDocument();
+
+  // Renders one preview page and posts a task to render the following one,
+  // so that each finished page is streamed to the browser while the renderer
+  // keeps processing input and IPC between pages. |preview_request_id|
+  // identifies the preview request this task belongs to; tasks from a
+  // superseded request do nothing. Calls DidFinishPrinting() when the last
+  // page is done or on failure.
+  void RenderNextPreviewPage(int preview_request_id);
 
   // Renders a print preview page. |page_number| is 0-based.
   // Returns true if print preview should continue, false on failure.
@@ -530,6 +530,12 @@ void AutofillProfile::OverwriteOrAppendNames(
     NameInfo imported_name = *it;
     bool should_append_imported_name = true;
 
+    // Precompute the imported name's normalized full name; GetInfo()
+    // reassembles the string on every call.
+    const AutofillType type = AutofillType(NAME_FULL);
+    const base::string16 imported_full_name =
+        StringToLowerASCII(imported_name.GetInfo(type, app_locale));
+
     for (size_t index = 0; index < name_.size(); ++index) {
       NameInfo current_name = name_[index];
       if (current_name.ParsedNamesAreEqual(imported_name)) {
@@ -542,10 +548,8 @@ void AutofillProfile::OverwriteOrAppendNames(
         break;
       }
 
-      AutofillType type = AutofillType(NAME_FULL);
       base::string16 full_name = current_name.GetInfo(type, app_locale);
-      if (StringToLowerASCII(full_name) ==
-          StringToLowerASCII(imported_name.GetInfo(type, app_locale))) {
+      if (StringToLowerASCII(full_name) == imported_full_name) {
         // The imported name has the same full name string as one of the
         // existing names for this profile.  Because full names are
         // _heuristically_ parsed into {first, middle, last} name components,
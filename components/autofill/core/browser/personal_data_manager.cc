@@ -743,6 +743,11 @@ std::string PersonalDataManager::MergeProfile(
   bool matching_profile_found = false;
   std::string guid = new_profile.guid();
 
+  // Precompute the normalized key used for matching; PrimaryValue() builds a
+  // fresh string every call, so don't recompute it per existing profile.
+  const base::string16 new_primary_value =
+      StringToLowerASCII(new_profile.PrimaryValue());
+
   // If we have already saved this address, merge in any missing values.
   // Only merge with the first match.
   for (std::vector<AutofillProfile*>::const_iterator iter =
@@ -750,9 +755,9 @@ std::string PersonalDataManager::MergeProfile(
        iter != existing_profiles.end(); ++iter) {
     AutofillProfile* existing_profile = *iter;
     if (!matching_profile_found &&
-        !new_profile.PrimaryValue().empty() &&
+        !new_primary_value.empty() &&
         StringToLowerASCII(existing_profile->PrimaryValue()) ==
-            StringToLowerASCII(new_profile.PrimaryValue())) {
+            new_primary_value) {
       // Unverified profiles should always be updated with the newer data,
       // whereas verified profiles should only ever be overwritten by verified
       // data.  If an automatically aggregated profile would overwrite a
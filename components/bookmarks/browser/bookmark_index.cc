@@ -260,48 +260,70 @@ void BookmarkIndex::AddMatchToResults(
 bool BookmarkIndex::GetBookmarksMatchingTerm(const base::string16& term,
                                                       bool first_term,
                                                       Matches* matches) {
-  Index::const_iterator i = index_.lower_bound(term);
-  if (i == index_.end())
-    return false;
-
   if (!query_parser::QueryParser::IsWordLongEnoughForPrefixSearch(term)) {
     // Term is too short for prefix match, compare using exact match.
-    if (i->first != term)
+    TermLookup::const_iterator lookup = term_lookup_.find(term);
+    if (lookup == term_lookup_.end())
       return false;  // No bookmarks with this term.
 
     if (first_term) {
       Match match;
-      match.terms.push_back(i);
+      match.terms.push_back(lookup->second);
       matches->push_back(match);
       return true;
     }
-    CombineMatchesInPlace(i, matches);
-  } else if (first_term) {
-    // This is the first term and we're doing a prefix match. Loop through
-    // index adding all entries that start with term to matches.
-    while (i != index_.end() &&
-           i->first.size() >= term.size() &&
-           term.compare(0, term.size(), i->first, 0, term.size()) == 0) {
-      Match match;
-      match.terms.push_back(i);
-      matches->push_back(match);
-      ++i;
-    }
+    CombineMatchesInPlace(lookup->second, matches);
   } else {
-    // Prefix match and not the first term. Loop through index combining
-    // current matches in matches with term, placing result in result.
-    Matches result;
-    while (i != index_.end() &&
-           i->first.size() >= term.size() &&
-           term.compare(0, term.size(), i->first, 0, term.size()) == 0) {
-      CombineMatches(i, *matches, &result);
-      ++i;
+    std::vector<Index::const_iterator> prefix_terms;
+    GetTermsWithPrefix(term, &prefix_terms);
+    if (first_term) {
+      // This is the first term and we're doing a prefix match. Add all
+      // entries that start with term to matches.
+      for (size_t i = 0; i < prefix_terms.size(); ++i) {
+        Match match;
+        match.terms.push_back(prefix_terms[i]);
+        matches->push_back(match);
+      }
+    } else {
+      // Prefix match and not the first term. Combine current matches in
+      // matches with each matching term, placing result in result.
+      Matches result;
+      for (size_t i = 0; i < prefix_terms.size(); ++i)
+        CombineMatches(prefix_terms[i], *matches, &result);
+      matches->swap(result);
     }
-    matches->swap(result);
   }
   return !matches->empty();
 }
 
+void BookmarkIndex::GetTermsWithPrefix(
+    const base::string16& prefix,
+    std::vector<Index::const_iterator>* prefix_terms) {
+  DCHECK(prefix_terms->empty());
+  if (!cached_prefix_.empty() && prefix.size() >= cached_prefix_.size() &&
+      prefix.compare(0, cached_prefix_.size(), cached_prefix_) == 0) {
+    // The new prefix extends the cached one, so its matches are a subset of
+    // the cached matches.
+    for (size_t i = 0; i < cached_prefix_terms_.size(); ++i) {
+      const Index::const_iterator& term_i = cached_prefix_terms_[i];
+      if (term_i->first.size() >= prefix.size() &&
+          prefix.compare(0, prefix.size(), term_i->first, 0, prefix.size()) ==
+              0) {
+        prefix_terms->push_back(term_i);
+      }
+    }
+  } else {
+    for (Index::const_iterator i = index_.lower_bound(prefix);
+         i != index_.end() && i->first.size() >= prefix.size() &&
+             prefix.compare(0, prefix.size(), i->first, 0, prefix.size()) == 0;
+         ++i) {
+      prefix_terms->push_back(i);
+    }
+  }
+  cached_prefix_ = prefix;
+  cached_prefix_terms_ = *prefix_terms;
+}
+
 void BookmarkIndex::CombineMatchesInPlace(const Index::const_iterator& index_i,
                                           Matches* matches) {
   for (size_t i = 0; i < matches->size(); ) {
@@ -351,20 +373,37 @@ std::vector<base::string16> BookmarkIndex::ExtractQueryWords(
 
 void BookmarkIndex::RegisterNode(const base::string16& term,
                                  const BookmarkNode* node) {
-  index_[term].insert(node);
+  TermLookup::const_iterator lookup = term_lookup_.find(term);
+  if (lookup != term_lookup_.end()) {
+    // Adding a node to an existing term doesn't change the set of terms, so
+    // the cached prefix query result stays valid.
+    lookup->second->second.insert(node);
+    return;
+  }
+  Index::iterator i =
+      index_.insert(Index::value_type(term, NodeSet())).first;
+  i->second.insert(node);
+  term_lookup_[term] = i;
+  cached_prefix_.clear();
+  cached_prefix_terms_.clear();
 }
 
 void BookmarkIndex::UnregisterNode(const base::string16& term,
                                    const BookmarkNode* node) {
-  Index::iterator i = index_.find(term);
-  if (i == index_.end()) {
+  TermLookup::iterator lookup = term_lookup_.find(term);
+  if (lookup == term_lookup_.end()) {
     // We can get here if the node has the same term more than once. For
     // example, a bookmark with the title 'foo foo' would end up here.
     return;
   }
+  Index::iterator i = lookup->second;
   i->second.erase(node);
-  if (i->second.empty())
+  if (i->second.empty()) {
+    term_lookup_.erase(lookup);
     index_.erase(i);
+    cached_prefix_.clear();
+    cached_prefix_terms_.clear();
+  }
 }
 
 }  // namespace bookmarks
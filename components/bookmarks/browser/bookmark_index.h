@@ -11,6 +11,7 @@
 #include <vector>
 
 #include "base/basictypes.h"
+#include "base/containers/hash_tables.h"
 #include "base/strings/string16.h"
 #include "components/query_parser/query_parser.h"
 
@@ -55,6 +56,9 @@ class BookmarkIndex {
   typedef std::vector<const BookmarkNode*> Nodes;
   typedef std::set<const BookmarkNode*> NodeSet;
   typedef std::map<base::string16, NodeSet> Index;
+  // Hash lookup from a term to its entry in |index_|. Entries in a std::map
+  // are stable, so the iterators stay valid until the term itself is erased.
+  typedef base::hash_map<base::string16, Index::iterator> TermLookup;
 
   struct Match;
   typedef std::vector<Match> Matches;
@@ -101,6 +105,14 @@ class BookmarkIndex {
   // Returns the set of query words from |query|.
   std::vector<base::string16> ExtractQueryWords(const base::string16& query);
 
+  // Fills |prefix_terms| with iterators for every term in |index_| starting
+  // with |prefix|, reusing and updating the cached result of the previous
+  // prefix query where possible. As the omnibox re-queries on every
+  // keystroke, the new prefix usually extends the previous one and the scan
+  // can be restricted to the previously matched terms.
+  void GetTermsWithPrefix(const base::string16& prefix,
+                          std::vector<Index::const_iterator>* prefix_terms);
+
   // Adds |node| to |index_|.
   void RegisterNode(const base::string16& term, const BookmarkNode* node);
 
@@ -109,6 +121,17 @@ class BookmarkIndex {
 
   Index index_;
 
+  // Accelerates exact-term lookups into |index_|, which otherwise cost a
+  // string comparison per tree level; Add() and Remove() perform one such
+  // lookup per term of every bookmark.
+  TermLookup term_lookup_;
+
+  // The prefix used for the last prefix query and the terms it matched.
+  // Cleared whenever a term is added to or erased from |index_| since either
+  // can change the set of matching terms (and erasing invalidates iterators).
+  base::string16 cached_prefix_;
+  std::vector<Index::const_iterator> cached_prefix_terms_;
+
   BookmarkClient* const client_;
 
   // Languages used to help parse IDNs in URLs for the bookmark index.
@@ -388,6 +388,32 @@ TEST_F(BookmarkIndexTest, ChangeTitle) {
   ExpectMatches("BlAh", expected, ARRAYSIZE_UNSAFE(expected));
 }
 
+// Exercises the cached prefix query path: repeated queries where each prefix
+// extends the previous one, interleaved with index mutations that must
+// invalidate the cached result.
+TEST_F(BookmarkIndexTest, RepeatedPrefixQueriesWithMutations) {
+  const char* titles[] = { "abcd", "abcde", "abxy" };
+  const char* urls[] = {kAboutBlankURL, kAboutBlankURL, kAboutBlankURL};
+  AddBookmarks(titles, urls, ARRAYSIZE_UNSAFE(titles));
+
+  // Simulate typing: each query narrows the previous one.
+  const char* expected_abc[] = { "abcd", "abcde" };
+  ExpectMatches("abc", titles, ARRAYSIZE_UNSAFE(titles));
+  ExpectMatches("abcd", expected_abc, ARRAYSIZE_UNSAFE(expected_abc));
+
+  // Adding a bookmark that matches the narrowed prefix must show up in a
+  // repeat of the same query.
+  model_->AddURL(model_->other_node(), 0, ASCIIToUTF16("abcdx"),
+                 GURL(kAboutBlankURL));
+  const char* expected_after_add[] = { "abcd", "abcde", "abcdx" };
+  ExpectMatches("abcd", expected_after_add,
+                ARRAYSIZE_UNSAFE(expected_after_add));
+
+  // Removing one must drop it from a repeated query as well.
+  model_->Remove(model_->other_node(), 0);
+  ExpectMatches("abcd", expected_abc, ARRAYSIZE_UNSAFE(expected_abc));
+}
+
 // Makes sure no more than max queries is returned.
 TEST_F(BookmarkIndexTest, HonorMax) {
   const char* titles[] = { "abcd", "abcde" };
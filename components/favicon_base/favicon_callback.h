@@ -29,6 +29,12 @@ typedef base::Callback<void(const FaviconRawBitmapResult&)>
 typedef base::Callback<void(const std::vector<FaviconRawBitmapResult>&)>
     FaviconResultsCallback;
 
+// Callback for functions returning raw favicon data for a batch of page URLs.
+// The outer vector is parallel to the vector of requested page URLs.
+typedef base::Callback<void(
+    const std::vector<std::vector<FaviconRawBitmapResult> >&)>
+    FaviconResultsForURLsCallback;
+
 }  // namespace favicon_base
 
 #endif  // COMPONENTS_FAVICON_BASE_FAVICON_CALLBACK_H_
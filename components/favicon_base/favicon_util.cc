@@ -125,10 +125,13 @@ SkBitmap ResizeBitmapByDownsamplingIfPossible(
     canvas.drawBitmapRect(best_bitmap, NULL, dest);
     return bitmap;
   }
-  return skia::ImageOperations::Resize(best_bitmap,
-                                       skia::ImageOperations::RESIZE_LANCZOS3,
-                                       desired_size_in_pixel,
-                                       desired_size_in_pixel);
+  // ResizeParallel() only fans out to the worker pool for destinations big
+  // enough to be worth it; favicon-sized ones stay on this thread.
+  return skia::ImageOperations::ResizeParallel(
+      best_bitmap,
+      skia::ImageOperations::RESIZE_LANCZOS3,
+      desired_size_in_pixel,
+      desired_size_in_pixel);
 }
 
 }  // namespace
@@ -161,10 +161,13 @@ SkBitmap GetResizedBitmap(const SkBitmap& source_bitmap,
       desired_size_in_pixel % original_size.height() == 0) {
     return SampleNearestNeighbor(source_bitmap, desired_size_in_pixel);
   }
-  return skia::ImageOperations::Resize(source_bitmap,
-                                       skia::ImageOperations::RESIZE_LANCZOS3,
-                                       desired_size_in_pixel,
-                                       desired_size_in_pixel);
+  // ResizeParallel() only fans out to the worker pool for destinations big
+  // enough to be worth it; favicon-sized ones stay on this thread.
+  return skia::ImageOperations::ResizeParallel(
+      source_bitmap,
+      skia::ImageOperations::RESIZE_LANCZOS3,
+      desired_size_in_pixel,
+      desired_size_in_pixel);
 }
 
 class FaviconImageSource : public gfx::ImageSkiaSource {
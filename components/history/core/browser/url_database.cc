@@ -21,6 +21,15 @@ namespace history {
 const char URLDatabase::kURLRowFields[] = HISTORY_URL_ROW_FIELDS;
 const int URLDatabase::kNumURLRowFields = 9;
 
+const char URLDatabase::kAddURLSql[] =
+    "INSERT INTO urls (url, title, visit_count, typed_count, "
+    "last_visit_time, hidden) VALUES (?,?,?,?,?,?)";
+
+const char URLDatabase::kUpdateURLRowSql[] =
+    "UPDATE urls SET title=?,visit_count=?,typed_count=?,last_visit_time=?,"
+      "hidden=?"
+    "WHERE id=?";
+
 URLDatabase::URLEnumeratorBase::URLEnumeratorBase()
     : initialized_(false) {
 }
@@ -115,10 +124,7 @@ URLID URLDatabase::GetRowForURL(const GURL& url, history::URLRow* info) {
 
 bool URLDatabase::UpdateURLRow(URLID url_id,
                                const history::URLRow& info) {
-  sql::Statement statement(GetDB().GetCachedStatement(SQL_FROM_HERE,
-      "UPDATE urls SET title=?,visit_count=?,typed_count=?,last_visit_time=?,"
-        "hidden=?"
-      "WHERE id=?"));
+  sql::Statement statement(GetDB().GetPrecompiledStatement(kUpdateURLRowSql));
   statement.BindString16(0, info.title());
   statement.BindInt(1, info.visit_count());
   statement.BindInt(2, info.typed_count());
@@ -131,27 +137,21 @@ bool URLDatabase::UpdateURLRow(URLID url_id,
 
 URLID URLDatabase::AddURLInternal(const history::URLRow& info,
                                   bool is_temporary) {
-  // This function is used to insert into two different tables, so we have to
-  // do some shuffling. Unfortinately, we can't use the macro
+  // This function is used to insert into two different tables, so we need
+  // two flavors of the insert SQL. Unfortinately, we can't use the macro
   // HISTORY_URL_ROW_FIELDS because that specifies the table name which is
-  // invalid in the insert syntax.
-  #define ADDURL_COMMON_SUFFIX \
-      " (url, title, visit_count, typed_count, "\
-      "last_visit_time, hidden) "\
-      "VALUES (?,?,?,?,?,?)"
-  const char* statement_name;
+  // invalid in the insert syntax. The non-temporary flavor is the hot path
+  // and is precompiled by owners of the database (see kAddURLSql).
   const char* statement_sql;
   if (is_temporary) {
-    statement_name = "AddURLTemporary";
-    statement_sql = "INSERT INTO temp_urls" ADDURL_COMMON_SUFFIX;
+    statement_sql =
+        "INSERT INTO temp_urls (url, title, visit_count, typed_count, "
+        "last_visit_time, hidden) VALUES (?,?,?,?,?,?)";
   } else {
-    statement_name = "AddURL";
-    statement_sql = "INSERT INTO urls" ADDURL_COMMON_SUFFIX;
+    statement_sql = kAddURLSql;
   }
-  #undef ADDURL_COMMON_SUFFIX
 
-  sql::Statement statement(GetDB().GetCachedStatement(
-      sql::StatementID(statement_name), statement_sql));
+  sql::Statement statement(GetDB().GetPrecompiledStatement(statement_sql));
   statement.BindString(0, GURLToDatabaseURL(info.url()));
   statement.BindString16(1, info.title());
   statement.BindInt(2, info.visit_count());
@@ -359,25 +359,50 @@ bool URLDatabase::GetTextMatches(const base::string16& query,
   ScopedVector<query_parser::QueryNode> query_nodes;
   query_parser_.ParseQueryNodes(query, &query_nodes.get());
 
+  // The lower-cased terms of the query. A row can only match if every term
+  // appears as a substring of its URL, IDN-decoded host or title, which is
+  // far cheaper to test than running the word breaker over every row.
+  std::vector<base::string16> query_terms;
+  query_parser_.ParseQueryWords(base::i18n::ToLower(query), &query_terms);
+
   results->clear();
   sql::Statement statement(GetDB().GetCachedStatement(SQL_FROM_HERE,
       "SELECT" HISTORY_URL_ROW_FIELDS "FROM urls WHERE hidden = 0"));
 
   while (statement.Step()) {
-    query_parser::QueryWordVector query_words;
     base::string16 url = base::i18n::ToLower(statement.ColumnString16(1));
-    query_parser_.ExtractQueryWords(url, &query_words);
+    base::string16 title = base::i18n::ToLower(statement.ColumnString16(2));
     GURL gurl(url);
+    base::string16 utf;
     if (gurl.is_valid()) {
       // Decode punycode to match IDN.
-      // |query_words| won't be shown to user - therefore we can use empty
-      // |languages| to reduce dependency (no need to call PrefService).
+      // The decoded host won't be shown to the user - therefore we can use
+      // empty |languages| to reduce dependency (no need to call PrefService).
       base::string16 ascii = base::ASCIIToUTF16(gurl.host());
-      base::string16 utf = net::IDNToUnicode(gurl.host(), std::string());
-      if (ascii != utf)
-        query_parser_.ExtractQueryWords(utf, &query_words);
+      utf = net::IDNToUnicode(gurl.host(), std::string());
+      if (ascii == utf)
+        utf.clear();
     }
-    base::string16 title = base::i18n::ToLower(statement.ColumnString16(2));
+
+    // A word can only start with a query term if the term occurs as a
+    // substring somewhere, so rows missing any term cannot match.
+    bool may_match = true;
+    for (size_t i = 0; i < query_terms.size(); ++i) {
+      const base::string16& term = query_terms[i];
+      if (url.find(term) == base::string16::npos &&
+          title.find(term) == base::string16::npos &&
+          utf.find(term) == base::string16::npos) {
+        may_match = false;
+        break;
+      }
+    }
+    if (!may_match)
+      continue;
+
+    query_parser::QueryWordVector query_words;
+    query_parser_.ExtractQueryWords(url, &query_words);
+    if (!utf.empty())
+      query_parser_.ExtractQueryWords(utf, &query_words);
     query_parser_.ExtractQueryWords(title, &query_words);
 
     if (query_parser_.DoesQueryMatch(query_words, query_nodes.get())) {
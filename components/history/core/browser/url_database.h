@@ -241,6 +241,12 @@ class URLDatabase {
   // fields following kURLRowFields.
   static const int kNumURLRowFields;
 
+  // SQL for the hot AddURL() insert and UpdateURLRow() update, exposed so
+  // that owners of the database can precompile them at open (see
+  // sql::Connection::Precompile).
+  static const char kAddURLSql[];
+  static const char kUpdateURLRowSql[];
+
   // Drops the starred_id column from urls, returning true on success. This does
   // nothing (and returns true) if the urls doesn't contain the starred_id
   // column.
@@ -42,6 +42,14 @@ class ProtoDatabase {
       scoped_ptr<std::vector<std::string> > keys_to_remove,
       UpdateCallback callback) = 0;
 
+  // Brackets a sequence of UpdateEntries() calls that the implementation may
+  // aggregate into a single write to the backing store. Every UpdateEntries()
+  // callback is still invoked, with the result of the combined write. Calls
+  // nest; the batch is issued when the outermost EndUpdateBatch() runs. The
+  // default implementation leaves every UpdateEntries() call to stand alone.
+  virtual void BeginUpdateBatch() {}
+  virtual void EndUpdateBatch() {}
+
   // Asynchronously loads all entries from the database and invokes |callback|
   // when complete.
   virtual void LoadEntries(LoadCallback callback) = 0;
@@ -5,6 +5,7 @@
 #ifndef COMPONENTS_LEVELDB_PROTO_PROTO_DATABASE_IMPL_H_
 #define COMPONENTS_LEVELDB_PROTO_PROTO_DATABASE_IMPL_H_
 
+#include <algorithm>
 #include <string>
 #include <vector>
 
@@ -47,6 +48,8 @@ class ProtoDatabaseImpl : public ProtoDatabase<T> {
       typename ProtoDatabase<T>::UpdateCallback callback) OVERRIDE;
   virtual void LoadEntries(
       typename ProtoDatabase<T>::LoadCallback callback) OVERRIDE;
+  virtual void BeginUpdateBatch() OVERRIDE;
+  virtual void EndUpdateBatch() OVERRIDE;
 
   // Allow callers to provide their own Database implementation.
   void InitWithDatabase(scoped_ptr<LevelDB> database,
@@ -54,6 +57,13 @@ class ProtoDatabaseImpl : public ProtoDatabase<T> {
                         typename ProtoDatabase<T>::InitCallback callback);
 
  private:
+  // Folds |entries_to_save| and |keys_to_remove| into the currently open
+  // batch, keeping last-writer-wins semantics between saves and removes of
+  // the same key across the aggregated calls.
+  void AddToBatch(scoped_ptr<typename ProtoDatabase<T>::KeyEntryVector>
+                      entries_to_save,
+                  scoped_ptr<KeyVector> keys_to_remove);
+
   base::ThreadChecker thread_checker_;
 
   // Used to run blocking tasks in-order.
@@ -61,6 +71,14 @@ class ProtoDatabaseImpl : public ProtoDatabase<T> {
 
   scoped_ptr<LevelDB> db_;
 
+  // Depth of BeginUpdateBatch() nesting; updates aggregate while non-zero.
+  int batch_nesting_level_;
+
+  // Updates and callbacks accumulated for the currently open batch.
+  scoped_ptr<typename ProtoDatabase<T>::KeyEntryVector> batched_entries_;
+  scoped_ptr<KeyVector> batched_removes_;
+  std::vector<typename ProtoDatabase<T>::UpdateCallback> batched_callbacks_;
+
   DISALLOW_COPY_AND_ASSIGN(ProtoDatabaseImpl);
 };
 
@@ -78,6 +96,14 @@ void RunUpdateCallback(typename ProtoDatabase<T>::UpdateCallback callback,
   callback.Run(*success);
 }
 
+template <typename T>
+void RunUpdateCallbacks(
+    const std::vector<typename ProtoDatabase<T>::UpdateCallback>& callbacks,
+    const bool* success) {
+  for (size_t i = 0; i < callbacks.size(); ++i)
+    callbacks[i].Run(*success);
+}
+
 template <typename T>
 void RunLoadCallback(typename ProtoDatabase<T>::LoadCallback callback,
                      const bool* success, scoped_ptr<std::vector<T> > entries) {
@@ -134,11 +160,12 @@ void LoadEntriesFromTaskRunner(LevelDB* database, std::vector<T>* entries,
 template <typename T>
 ProtoDatabaseImpl<T>::ProtoDatabaseImpl(
     scoped_refptr<base::SequencedTaskRunner> task_runner)
-    : task_runner_(task_runner) {}
+    : task_runner_(task_runner), batch_nesting_level_(0) {}
 
 template <typename T>
 ProtoDatabaseImpl<T>::~ProtoDatabaseImpl() {
   DCHECK(thread_checker_.CalledOnValidThread());
+  DCHECK_EQ(0, batch_nesting_level_);
   if (!task_runner_->DeleteSoon(FROM_HERE, db_.release())) {
     DLOG(WARNING) << "DOM distiller database will not be deleted.";
   }
@@ -173,6 +200,11 @@ void ProtoDatabaseImpl<T>::UpdateEntries(
     scoped_ptr<KeyVector> keys_to_remove,
     typename ProtoDatabase<T>::UpdateCallback callback) {
   DCHECK(thread_checker_.CalledOnValidThread());
+  if (batch_nesting_level_ > 0) {
+    AddToBatch(entries_to_save.Pass(), keys_to_remove.Pass());
+    batched_callbacks_.push_back(callback);
+    return;
+  }
   bool* success = new bool(false);
   task_runner_->PostTaskAndReply(
       FROM_HERE,
@@ -182,6 +214,68 @@ void ProtoDatabaseImpl<T>::UpdateEntries(
       base::Bind(RunUpdateCallback<T>, callback, base::Owned(success)));
 }
 
+template <typename T>
+void ProtoDatabaseImpl<T>::BeginUpdateBatch() {
+  DCHECK(thread_checker_.CalledOnValidThread());
+  if (batch_nesting_level_++ == 0) {
+    batched_entries_.reset(new typename ProtoDatabase<T>::KeyEntryVector());
+    batched_removes_.reset(new KeyVector());
+    batched_callbacks_.clear();
+  }
+}
+
+template <typename T>
+void ProtoDatabaseImpl<T>::EndUpdateBatch() {
+  DCHECK(thread_checker_.CalledOnValidThread());
+  DCHECK_GT(batch_nesting_level_, 0);
+  if (--batch_nesting_level_ > 0)
+    return;
+
+  scoped_ptr<typename ProtoDatabase<T>::KeyEntryVector> entries_to_save(
+      batched_entries_.Pass());
+  scoped_ptr<KeyVector> keys_to_remove(batched_removes_.Pass());
+  std::vector<typename ProtoDatabase<T>::UpdateCallback> callbacks;
+  callbacks.swap(batched_callbacks_);
+  if (callbacks.empty())
+    return;
+
+  bool* success = new bool(false);
+  task_runner_->PostTaskAndReply(
+      FROM_HERE,
+      base::Bind(UpdateEntriesFromTaskRunner<T>, base::Unretained(db_.get()),
+                 base::Passed(&entries_to_save), base::Passed(&keys_to_remove),
+                 success),
+      base::Bind(RunUpdateCallbacks<T>, callbacks, base::Owned(success)));
+}
+
+template <typename T>
+void ProtoDatabaseImpl<T>::AddToBatch(
+    scoped_ptr<typename ProtoDatabase<T>::KeyEntryVector> entries_to_save,
+    scoped_ptr<KeyVector> keys_to_remove) {
+  // LevelDB::Save() applies all saves before all removes, so cross-call
+  // ordering between operations on the same key has to be resolved here:
+  // a save cancels a pending remove of the key and vice versa.
+  for (typename ProtoDatabase<T>::KeyEntryVector::iterator it =
+           entries_to_save->begin();
+       it != entries_to_save->end(); ++it) {
+    batched_removes_->erase(
+        std::remove(batched_removes_->begin(), batched_removes_->end(),
+                    it->first),
+        batched_removes_->end());
+    batched_entries_->push_back(*it);
+  }
+  for (KeyVector::iterator it = keys_to_remove->begin();
+       it != keys_to_remove->end(); ++it) {
+    for (size_t i = 0; i < batched_entries_->size();) {
+      if ((*batched_entries_)[i].first == *it)
+        batched_entries_->erase(batched_entries_->begin() + i);
+      else
+        ++i;
+    }
+    batched_removes_->push_back(*it);
+  }
+}
+
 template <typename T>
 void ProtoDatabaseImpl<T>::LoadEntries(
     typename ProtoDatabase<T>::LoadCallback callback) {
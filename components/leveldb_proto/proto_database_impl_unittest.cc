@@ -296,6 +296,63 @@ TEST_F(ProtoDatabaseImplTest, TestDBRemoveSuccess) {
   base::RunLoop().RunUntilIdle();
 }
 
+// Test that UpdateEntries() calls made between BeginUpdateBatch() and
+// EndUpdateBatch() are aggregated into a single Save on the underlying
+// database, that all callbacks run with the combined result, and that a save
+// and a remove of the same key resolve in call order.
+TEST_F(ProtoDatabaseImplTest, TestDBUpdateBatch) {
+  base::FilePath path(FILE_PATH_LITERAL("/fake/path"));
+
+  MockDB* mock_db = new MockDB();
+  MockDatabaseCaller caller;
+  EntryMap model = GetSmallModel();
+
+  EXPECT_CALL(*mock_db, Init(_));
+  EXPECT_CALL(caller, InitCallback(_));
+  db_->InitWithDatabase(
+      scoped_ptr<LevelDB>(mock_db), base::FilePath(path),
+      base::Bind(&MockDatabaseCaller::InitCallback, base::Unretained(&caller)));
+
+  EXPECT_CALL(*mock_db, Save(_, _)).Times(0);
+  db_->BeginUpdateBatch();
+
+  // First call: save entry "0" and remove key "1".
+  scoped_ptr<ProtoDatabase<TestProto>::KeyEntryVector> first_entries(
+      new ProtoDatabase<TestProto>::KeyEntryVector());
+  first_entries->push_back(std::make_pair(model["0"].id(), model["0"]));
+  scoped_ptr<KeyVector> first_removes(new KeyVector());
+  first_removes->push_back("1");
+  db_->UpdateEntries(
+      first_entries.Pass(), first_removes.Pass(),
+      base::Bind(&MockDatabaseCaller::SaveCallback, base::Unretained(&caller)));
+
+  // Second call: re-save key "1", superseding the pending remove, and remove
+  // key "0", superseding the pending save.
+  scoped_ptr<ProtoDatabase<TestProto>::KeyEntryVector> second_entries(
+      new ProtoDatabase<TestProto>::KeyEntryVector());
+  second_entries->push_back(std::make_pair(model["1"].id(), model["1"]));
+  scoped_ptr<KeyVector> second_removes(new KeyVector());
+  second_removes->push_back("0");
+  db_->UpdateEntries(
+      second_entries.Pass(), second_removes.Pass(),
+      base::Bind(&MockDatabaseCaller::SaveCallback, base::Unretained(&caller)));
+
+  // Nothing reaches the database until the batch closes.
+  base::RunLoop().RunUntilIdle();
+  testing::Mock::VerifyAndClearExpectations(mock_db);
+
+  EntryMap expected_saves;
+  expected_saves["1"] = model["1"];
+  KeyVector expected_removes;
+  expected_removes.push_back("0");
+  EXPECT_CALL(*mock_db, Save(_, expected_removes))
+      .WillOnce(VerifyUpdateEntries(expected_saves));
+  EXPECT_CALL(caller, SaveCallback(true)).Times(2);
+  db_->EndUpdateBatch();
+
+  base::RunLoop().RunUntilIdle();
+}
+
 TEST_F(ProtoDatabaseImplTest, TestDBRemoveFailure) {
   base::FilePath path(FILE_PATH_LITERAL("/fake/path"));
 
@@ -6,7 +6,9 @@
 
 #include <vector>
 
+#include "base/bind.h"
 #include "base/command_line.h"
+#include "base/memory/singleton.h"
 #include "base/metrics/field_trial.h"
 #include "components/variations/processed_study.h"
 #include "components/variations/study_filtering.h"
@@ -58,6 +60,20 @@ void RegisterVariationIds(const Study_Experiment& experiment,
   }
 }
 
+// Holds the studies registered for lazy trial creation by
+// CreateTrialsFromSeedCache(), keyed by study name. The embedded seed owns
+// the Study objects that |studies| points into; both live for the rest of
+// the process so that trials can materialize at any time.
+struct LazyStudyRegistry {
+  static LazyStudyRegistry* GetInstance() {
+    return Singleton<LazyStudyRegistry>::get();
+  }
+
+  VariationsSeed seed;
+  std::map<std::string, const Study*> studies;
+  base::Time reference_date;
+};
+
 }  // namespace
 
 VariationsSeedProcessor::VariationsSeedProcessor() {
@@ -82,6 +98,92 @@ void VariationsSeedProcessor::CreateTrialsFromSeed(
     CreateTrialFromStudy(filtered_studies[i]);
 }
 
+bool VariationsSeedProcessor::BuildSeedCache(
+    const VariationsSeed& seed,
+    const std::string& locale,
+    const base::Time& reference_date,
+    const base::Version& version,
+    Study_Channel channel,
+    Study_FormFactor form_factor,
+    const std::string& hardware_class,
+    std::string* cache_data) {
+  std::vector<ProcessedStudy> filtered_studies;
+  FilterAndValidateStudies(seed, locale, reference_date, version, channel,
+                           form_factor, hardware_class, &filtered_studies);
+
+  VariationsSeed filtered_seed;
+  filtered_seed.set_serial_number(seed.serial_number());
+  for (size_t i = 0; i < filtered_studies.size(); ++i)
+    filtered_seed.add_study()->CopyFrom(*filtered_studies[i].study());
+
+  return filtered_seed.SerializeToString(cache_data);
+}
+
+bool VariationsSeedProcessor::CreateTrialsFromSeedCache(
+    const std::string& cache_data,
+    const base::Time& reference_date,
+    std::string* seed_serial_number) {
+  LazyStudyRegistry* registry = LazyStudyRegistry::GetInstance();
+  registry->studies.clear();
+  if (!registry->seed.ParseFromString(cache_data)) {
+    registry->seed.Clear();
+    return false;
+  }
+  registry->reference_date = reference_date;
+
+  CommandLine* command_line = CommandLine::ForCurrentProcess();
+  for (int i = 0; i < registry->seed.study_size(); ++i) {
+    const Study& study = registry->seed.study(i);
+
+    // Trials that take effect without anyone querying them cannot be
+    // registered lazily: studies that activate automatically and studies
+    // forced by a command-line flag are created right away.
+    bool create_eagerly =
+        study.activation_type() == Study_ActivationType_ACTIVATION_AUTO;
+    for (int j = 0; !create_eagerly && j < study.experiment_size(); ++j) {
+      const Study_Experiment& experiment = study.experiment(j);
+      if (experiment.has_forcing_flag() &&
+          command_line->HasSwitch(experiment.forcing_flag())) {
+        create_eagerly = true;
+      }
+    }
+
+    if (create_eagerly)
+      MaterializeStudy(study, reference_date);
+    else
+      registry->studies[study.name()] = &study;
+  }
+
+  base::FieldTrialList::SetTrialResolver(
+      base::Bind(&VariationsSeedProcessor::MaterializeTrialForQuery));
+
+  if (seed_serial_number)
+    *seed_serial_number = registry->seed.serial_number();
+  return true;
+}
+
+// static
+void VariationsSeedProcessor::MaterializeStudy(
+    const Study& study,
+    const base::Time& reference_date) {
+  std::vector<ProcessedStudy> processed_studies;
+  if (ProcessedStudy::ValidateAndAppendStudy(
+          &study, internal::IsStudyExpired(study, reference_date),
+          &processed_studies)) {
+    VariationsSeedProcessor().CreateTrialFromStudy(processed_studies[0]);
+  }
+}
+
+// static
+void VariationsSeedProcessor::MaterializeTrialForQuery(
+    const std::string& trial_name) {
+  LazyStudyRegistry* registry = LazyStudyRegistry::GetInstance();
+  std::map<std::string, const Study*>::const_iterator it =
+      registry->studies.find(trial_name);
+  if (it != registry->studies.end())
+    MaterializeStudy(*it->second, registry->reference_date);
+}
+
 void VariationsSeedProcessor::CreateTrialFromStudy(
     const ProcessedStudy& processed_study) {
   const Study& study = *processed_study.study();
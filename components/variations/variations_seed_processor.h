@@ -37,6 +37,37 @@ class VariationsSeedProcessor {
                             Study_FormFactor form_factor,
                             const std::string& hardware_class);
 
+  // Filters the studies in |seed| with the same configuration that
+  // CreateTrialsFromSeed() uses and serializes the surviving studies into a
+  // compact binary blob that the embedder can persist and pass to
+  // CreateTrialsFromSeedCache() on a later launch. The blob records the
+  // seed's serial number; the embedder must discard it whenever a new seed
+  // is stored or the filter configuration (e.g. product version or locale)
+  // changes. Returns false if serialization fails.
+  bool BuildSeedCache(const VariationsSeed& seed,
+                      const std::string& locale,
+                      const base::Time& reference_date,
+                      const base::Version& version,
+                      Study_Channel channel,
+                      Study_FormFactor form_factor,
+                      const std::string& hardware_class,
+                      std::string* cache_data);
+
+  // Creates field trials from a cache built by BuildSeedCache(), without
+  // filtering the full seed again. Trials that take effect even if nobody
+  // queries them -- studies with ACTIVATION_AUTO activation or forced by a
+  // command-line flag -- are created immediately; all remaining trials are
+  // registered for lazy creation and materialize on the first lookup
+  // through base::FieldTrialList::FindFullName() and friends. Study expiry
+  // is evaluated against |reference_date|. On success, returns true and
+  // stores the serial number of the seed the cache was built from in
+  // |seed_serial_number| (which may be NULL). Returns false if |cache_data|
+  // cannot be parsed; callers should then fall back to
+  // CreateTrialsFromSeed().
+  bool CreateTrialsFromSeedCache(const std::string& cache_data,
+                                 const base::Time& reference_date,
+                                 std::string* seed_serial_number);
+
  private:
   friend class VariationsSeedProcessorTest;
   FRIEND_TEST_ALL_PREFIXES(VariationsSeedProcessorTest,
@@ -65,6 +96,17 @@ class VariationsSeedProcessor {
   // Disables the trial if |processed_study.is_expired| is true.
   void CreateTrialFromStudy(const ProcessedStudy& processed_study);
 
+  // Validates |study| (evaluating expiry against |reference_date|) and
+  // creates its field trial.
+  static void MaterializeStudy(const Study& study,
+                               const base::Time& reference_date);
+
+  // Materializes the lazily registered trial named |trial_name|, if the
+  // cached seed contains a matching study. Invoked through
+  // base::FieldTrialList's trial resolver on the first lookup of an
+  // unregistered trial name.
+  static void MaterializeTrialForQuery(const std::string& trial_name);
+
   DISALLOW_COPY_AND_ASSIGN(VariationsSeedProcessor);
 };
 
@@ -341,6 +341,69 @@ TEST_F(VariationsSeedProcessorTest, StartsActive) {
   EXPECT_TRUE(IsFieldTrialActive("C"));
 }
 
+TEST_F(VariationsSeedProcessorTest, SeedCacheCreatesTrialsLazily) {
+  base::FieldTrialList field_trial_list(NULL);
+
+  VariationsSeed seed;
+  seed.set_serial_number("123");
+  Study* study = seed.add_study();
+  study->set_name("LazyStudy");
+  study->set_default_experiment_name("Default");
+  AddExperiment("Default", 100, study);
+
+  VariationsSeedProcessor seed_processor;
+  std::string cache_data;
+  EXPECT_TRUE(seed_processor.BuildSeedCache(
+      seed, "en-CA", base::Time::Now(), base::Version("20.0.0.0"),
+      Study_Channel_STABLE, Study_FormFactor_DESKTOP, "", &cache_data));
+  EXPECT_FALSE(cache_data.empty());
+
+  std::string serial_number;
+  EXPECT_TRUE(seed_processor.CreateTrialsFromSeedCache(
+      cache_data, base::Time::Now(), &serial_number));
+  EXPECT_EQ("123", serial_number);
+
+  // The trial should not exist until it is first queried.
+  EXPECT_EQ(0u, base::FieldTrialList::GetFieldTrialCount());
+  EXPECT_EQ("Default", base::FieldTrialList::FindFullName("LazyStudy"));
+  EXPECT_EQ(1u, base::FieldTrialList::GetFieldTrialCount());
+
+  // Unknown trial names should still miss.
+  EXPECT_EQ(std::string(), base::FieldTrialList::FindFullName("Unknown"));
+}
+
+TEST_F(VariationsSeedProcessorTest, SeedCacheAutoActivationIsEager) {
+  base::FieldTrialList field_trial_list(NULL);
+
+  VariationsSeed seed;
+  seed.set_serial_number("123");
+  Study* study = seed.add_study();
+  study->set_name("AutoStudy");
+  study->set_default_experiment_name("Default");
+  AddExperiment("Default", 100, study);
+  study->set_activation_type(Study_ActivationType_ACTIVATION_AUTO);
+
+  VariationsSeedProcessor seed_processor;
+  std::string cache_data;
+  EXPECT_TRUE(seed_processor.BuildSeedCache(
+      seed, "en-CA", base::Time::Now(), base::Version("20.0.0.0"),
+      Study_Channel_STABLE, Study_FormFactor_DESKTOP, "", &cache_data));
+  EXPECT_TRUE(seed_processor.CreateTrialsFromSeedCache(
+      cache_data, base::Time::Now(), NULL));
+
+  // ACTIVATION_AUTO studies must take effect without being queried.
+  EXPECT_TRUE(IsFieldTrialActive("AutoStudy"));
+}
+
+TEST_F(VariationsSeedProcessorTest, SeedCacheRejectsCorruptData) {
+  base::FieldTrialList field_trial_list(NULL);
+
+  VariationsSeedProcessor seed_processor;
+  EXPECT_FALSE(seed_processor.CreateTrialsFromSeedCache(
+      "not a serialized seed", base::Time::Now(), NULL));
+  EXPECT_EQ(0u, base::FieldTrialList::GetFieldTrialCount());
+}
+
 TEST_F(VariationsSeedProcessorTest, StartsActiveWithFlag) {
   CommandLine::ForCurrentProcess()->AppendSwitch(kForcingFlag1);
 
@@ -301,6 +301,17 @@ void VisitedLinkMaster::AddURL(const GURL& url) {
 }
 
 void VisitedLinkMaster::AddURLs(const std::vector<GURL>& url) {
+  // Grow the table to its final size up front, so that a bulk addition
+  // rehashes the table (and sends a NewTable notification to the child
+  // processes) at most once, rather than rebuilding it at every size step
+  // along the way.
+  if (!table_builder_.get() && hash_table_ && table_length_ > 0) {
+    uint32 final_size =
+        NewTableSizeForCount(used_items_ + static_cast<int32>(url.size()));
+    if (final_size > static_cast<uint32>(table_length_))
+      ResizeTable(final_size);
+  }
+
   for (std::vector<GURL>::const_iterator i = url.begin();
        i != url.end(); ++i) {
     Hash index = TryToAddURL(*i);
@@ -400,6 +400,34 @@ TEST_F(VisitedLinkTest, Resizing) {
   Reload();
 }
 
+// Tests that adding many URLs at once pre-sizes the table and keeps it
+// consistent.
+TEST_F(VisitedLinkTest, BulkAdd) {
+  // Create a very small database so the bulk addition must grow it.
+  const int32 initial_size = 17;
+  ASSERT_TRUE(InitVisited(initial_size, true));
+
+  std::vector<GURL> urls;
+  for (int i = 0; i < g_test_count; i++)
+    urls.push_back(TestURL(i));
+  master_->AddURLs(urls);
+
+  // Verify that everything was added and that the table was resized
+  // sufficiently in the process.
+  ASSERT_EQ(g_test_count, master_->GetUsedCount());
+  for (int i = 0; i < g_test_count; i++)
+    ASSERT_TRUE(master_->IsVisited(TestURL(i)));
+  int32 table_size;
+  VisitedLinkCommon::Fingerprint* table;
+  master_->GetUsageStatistics(&table_size, &table);
+  ASSERT_GT(table_size, master_->GetUsedCount());
+  master_->DebugValidate();
+
+  // This tests that the file is written correctly by reading it in using
+  // a new database.
+  Reload();
+}
+
 // Tests that if the database doesn't exist, it will be rebuilt from history.
 TEST_F(VisitedLinkTest, Rebuild) {
   // Add half of our URLs to history. This needs to be done before we
@@ -62,6 +62,14 @@ class CONTENT_EXPORT AppCacheGroup
   const GURL& manifest_url() const { return manifest_url_; }
   const base::Time& creation_time() const { return creation_time_; }
   void set_creation_time(const base::Time& time) { creation_time_ = time; }
+
+  // Time the group's last access time was most recently written to storage.
+  const base::Time& last_access_persist_time() const {
+    return last_access_persist_time_;
+  }
+  void set_last_access_persist_time(const base::Time& time) {
+    last_access_persist_time_ = time;
+  }
   bool is_obsolete() const { return is_obsolete_; }
   void set_obsolete(bool value) { is_obsolete_ = value; }
 
@@ -130,6 +138,7 @@ class CONTENT_EXPORT AppCacheGroup
   const int64 group_id_;
   const GURL manifest_url_;
   base::Time creation_time_;
+  base::Time last_access_persist_time_;
   UpdateAppCacheStatus update_status_;
   bool is_obsolete_;
   bool is_being_deleted_;
@@ -40,6 +40,10 @@ static const int kDefaultQuota = 5 * 1024 * 1024;
 
 static const int kMaxDiskCacheSize = 250 * 1024 * 1024;
 static const int kMaxMemDiskCacheSize = 10 * 1024 * 1024;
+
+// Last access times are written at most this often so that frequently used
+// groups don't generate a database update on every use.
+static const int kUpdateLastAccessTimeIntervalMinutes = 10;
 static const base::FilePath::CharType kDiskCacheDirectoryName[] =
     FILE_PATH_LITERAL("Cache");
 
@@ -464,6 +468,9 @@ void AppCacheStorageImpl::StoreOrLoadTask::CreateCacheAndGroupFromRecords(
         storage_, group_record_.manifest_url,
         group_record_.group_id);
     group->get()->set_creation_time(group_record_.creation_time);
+    // The load task wrote a fresh access time, so the next in-memory hit
+    // need not do so again right away.
+    group->get()->set_last_access_persist_time(base::Time::Now());
     group->get()->AddCache(cache->get());
 
     // TODO(michaeln): histogram is fishing for clues to crbug/95101
@@ -1391,12 +1398,8 @@ void AppCacheStorageImpl::LoadCache(int64 id, Delegate* delegate) {
   AppCache* cache = working_set_.GetCache(id);
   if (cache) {
     delegate->OnCacheLoaded(cache, id);
-    if (cache->owning_group()) {
-      scoped_refptr<DatabaseTask> update_task(
-          new UpdateGroupLastAccessTimeTask(
-              this, cache->owning_group(), base::Time::Now()));
-      update_task->Schedule();
-    }
+    if (cache->owning_group())
+      MaybeUpdateGroupLastAccessTime(cache->owning_group());
     return;
   }
   scoped_refptr<CacheLoadTask> task(GetPendingCacheLoadTask(id));
@@ -1410,6 +1413,22 @@ void AppCacheStorageImpl::LoadCache(int64 id, Delegate* delegate) {
   pending_cache_loads_[id] = task.get();
 }
 
+void AppCacheStorageImpl::MaybeUpdateGroupLastAccessTime(
+    AppCacheGroup* group) {
+  base::Time now = base::Time::Now();
+  if (now - group->last_access_persist_time() <
+      base::TimeDelta::FromMinutes(kUpdateLastAccessTimeIntervalMinutes)) {
+    // The access still counts for quota bookkeeping even when the database
+    // write is skipped.
+    NotifyStorageAccessed(group->manifest_url().GetOrigin());
+    return;
+  }
+  group->set_last_access_persist_time(now);
+  scoped_refptr<DatabaseTask> update_task(
+      new UpdateGroupLastAccessTimeTask(this, group, now));
+  update_task->Schedule();
+}
+
 void AppCacheStorageImpl::LoadOrCreateGroup(
     const GURL& manifest_url, Delegate* delegate) {
   DCHECK(delegate);
@@ -1421,10 +1440,7 @@ void AppCacheStorageImpl::LoadOrCreateGroup(
   AppCacheGroup* group = working_set_.GetGroup(manifest_url);
   if (group) {
     delegate->OnGroupLoaded(group, manifest_url);
-    scoped_refptr<DatabaseTask> update_task(
-        new UpdateGroupLastAccessTimeTask(
-            this, group, base::Time::Now()));
-    update_task->Schedule();
+    MaybeUpdateGroupLastAccessTime(group);
     return;
   }
 
@@ -96,6 +96,10 @@ class AppCacheStorageImpl : public AppCacheStorage {
 
   CacheLoadTask* GetPendingCacheLoadTask(int64 cache_id);
   GroupLoadTask* GetPendingGroupLoadTask(const GURL& manifest_url);
+
+  // Schedules a task to persist |group|'s new last access time, unless one
+  // was written recently; per-access writes add up for frequently used pages.
+  void MaybeUpdateGroupLastAccessTime(AppCacheGroup* group);
   void GetPendingForeignMarkingsForCache(
       int64 cache_id, std::vector<GURL>* urls);
 
@@ -1385,7 +1385,8 @@ void AppCacheUpdateJob::OnResponseInfoLoaded(
     if (!http_info->headers.get() ||
         http_info->headers->RequiresValidation(http_info->request_time,
                                                http_info->response_time,
-                                               base::Time::Now()) ||
+                                               base::Time::Now()) !=
+            net::VALIDATION_NONE ||
         http_info->headers->EnumerateHeader(&iter, name, &value)) {
       LoadFromNewestCacheFailed(url, response_info);
     } else {
@@ -614,6 +614,7 @@ int BrowserMainLoop::CreateThreads() {
        ++thread_id) {
     scoped_ptr<BrowserProcessSubThread>* thread_to_start = NULL;
     base::Thread::Options options;
+    base::ThreadPriority priority = base::kThreadPriority_Normal;
 
     switch (thread_id) {
       case BrowserThread::DB:
@@ -622,6 +623,7 @@ int BrowserMainLoop::CreateThreads() {
             "Thread", "BrowserThread::DB");
         thread_to_start = &db_thread_;
         options.timer_slack = base::TIMER_SLACK_MAXIMUM;
+        priority = base::kThreadPriority_Background;
         break;
       case BrowserThread::FILE_USER_BLOCKING:
         TRACE_EVENT_BEGIN1("startup",
@@ -658,6 +660,7 @@ int BrowserMainLoop::CreateThreads() {
         thread_to_start = &cache_thread_;
         options = io_message_loop_options;
         options.timer_slack = base::TIMER_SLACK_MAXIMUM;
+        priority = base::kThreadPriority_Background;
         break;
       case BrowserThread::IO:
         TRACE_EVENT_BEGIN1("startup",
@@ -678,6 +681,11 @@ int BrowserMainLoop::CreateThreads() {
     if (thread_to_start) {
       (*thread_to_start).reset(new BrowserProcessSubThread(id));
       (*thread_to_start)->StartWithOptions(options);
+      // The DB and CACHE threads do I/O that is rarely on the critical path
+      // of a user-visible action; run them at background priority so that
+      // their disk access defers to foreground threads.
+      if (priority != base::kThreadPriority_Normal)
+        (*thread_to_start)->SetPriority(priority);
     } else {
       NOTREACHED();
     }
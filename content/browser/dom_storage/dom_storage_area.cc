@@ -5,6 +5,7 @@
 #include "content/browser/dom_storage/dom_storage_area.h"
 
 #include "base/bind.h"
+#include "base/lazy_instance.h"
 #include "base/location.h"
 #include "base/logging.h"
 #include "base/metrics/histogram.h"
@@ -27,11 +28,63 @@ namespace content {
 
 static const int kCommitTimerSeconds = 1;
 
+// A commit batch that grows beyond this size is committed right away
+// rather than at the end of the commit window, so a fast writer can't
+// accrue an unbounded amount of uncommitted data in memory.
+static const size_t kMaxBytesPerCommitBatch = 1024 * 1024;
+
+namespace {
+
+// Hands out the delays used for commit timers, aligned to shared window
+// boundaries. All areas dirtied within the same window fire their timers
+// at the same boundary, so when many origins are writing at once their
+// commits land back to back on the commit sequence instead of being
+// scattered throughout the window, one second after each area's first
+// change.
+class CommitWindow {
+ public:
+  CommitWindow() {}
+
+  base::TimeDelta NextCommitDelay() {
+    base::TimeTicks now = base::TimeTicks::Now();
+    if (window_end_.is_null() || window_end_ <= now)
+      window_end_ = now + base::TimeDelta::FromSeconds(kCommitTimerSeconds);
+    return window_end_ - now;
+  }
+
+ private:
+  base::TimeTicks window_end_;
+
+  DISALLOW_COPY_AND_ASSIGN(CommitWindow);
+};
+
+base::LazyInstance<CommitWindow>::Leaky g_commit_window =
+    LAZY_INSTANCE_INITIALIZER;
+
+}  // namespace
+
 DOMStorageArea::CommitBatch::CommitBatch()
-  : clear_all_first(false) {
+  : clear_all_first(false),
+    early_commit_posted(false),
+    data_size(0) {
 }
 DOMStorageArea::CommitBatch::~CommitBatch() {}
 
+void DOMStorageArea::CommitBatch::UpdateValue(
+    const base::string16& key,
+    const base::NullableString16& value) {
+  std::pair<DOMStorageValuesMap::iterator, bool> inserted =
+      changed_values.insert(std::make_pair(key, value));
+  if (inserted.second) {
+    data_size += key.length() * sizeof(base::char16);
+  } else {
+    data_size -=
+        inserted.first->second.string().length() * sizeof(base::char16);
+    inserted.first->second = value;
+  }
+  data_size += value.string().length() * sizeof(base::char16);
+}
+
 
 // static
 const base::FilePath::CharType DOMStorageArea::kDatabaseFileExtension[] =
@@ -139,7 +192,8 @@ bool DOMStorageArea::SetItem(const base::string16& key,
   bool success = map_->SetItem(key, value, old_value);
   if (success && backing_) {
     CommitBatch* commit_batch = CreateCommitBatchIfNeeded();
-    commit_batch->changed_values[key] = base::NullableString16(value, false);
+    commit_batch->UpdateValue(key, base::NullableString16(value, false));
+    CommitSoonIfBatchIsFull();
   }
   return success;
 }
@@ -149,12 +203,18 @@ bool DOMStorageArea::RemoveItem(const base::string16& key,
   if (is_shutdown_)
     return false;
   InitialImportIfNeeded();
-  if (!map_->HasOneRef())
+  if (!map_->HasOneRef()) {
+    // Don't deep copy a shared map just to find out the key isn't there.
+    // Values are never null, so a null result means the key is absent.
+    if (map_->GetItem(key).is_null())
+      return false;
     map_ = map_->DeepCopy();
+  }
   bool success = map_->RemoveItem(key, old_value);
   if (success && backing_) {
     CommitBatch* commit_batch = CreateCommitBatchIfNeeded();
-    commit_batch->changed_values[key] = base::NullableString16();
+    commit_batch->UpdateValue(key, base::NullableString16());
+    CommitSoonIfBatchIsFull();
   }
   return success;
 }
@@ -173,6 +233,7 @@ bool DOMStorageArea::Clear() {
     CommitBatch* commit_batch = CreateCommitBatchIfNeeded();
     commit_batch->clear_all_first = true;
     commit_batch->changed_values.clear();
+    commit_batch->data_size = 0;
   }
 
   return true;
@@ -195,6 +256,7 @@ void DOMStorageArea::FastClear() {
     CommitBatch* commit_batch = CreateCommitBatchIfNeeded();
     commit_batch->clear_all_first = true;
     commit_batch->changed_values.clear();
+    commit_batch->data_size = 0;
   }
 }
 
@@ -324,17 +386,33 @@ DOMStorageArea::CommitBatch* DOMStorageArea::CreateCommitBatchIfNeeded() {
 
     // Start a timer to commit any changes that accrue in the batch, but only if
     // no commits are currently in flight. In that case the timer will be
-    // started after the commits have happened.
+    // started after the commits have happened. The timer fires at the next
+    // shared window boundary so dirty areas commit together.
     if (!commit_batches_in_flight_) {
       task_runner_->PostDelayedTask(
           FROM_HERE,
           base::Bind(&DOMStorageArea::OnCommitTimer, this),
-          base::TimeDelta::FromSeconds(kCommitTimerSeconds));
+          g_commit_window.Get().NextCommitDelay());
     }
   }
   return commit_batch_.get();
 }
 
+void DOMStorageArea::CommitSoonIfBatchIsFull() {
+  DCHECK(commit_batch_.get());
+  if (commit_batch_->early_commit_posted ||
+      commit_batch_->data_size <= kMaxBytesPerCommitBatch ||
+      commit_batches_in_flight_)
+    return;
+  // Enough data is pending that it's not worth waiting out the commit
+  // window. The delayed timer task left behind will find nothing to do
+  // when it fires; OnCommitTimer handles that gracefully.
+  commit_batch_->early_commit_posted = true;
+  task_runner_->PostTask(
+      FROM_HERE,
+      base::Bind(&DOMStorageArea::OnCommitTimer, this));
+}
+
 void DOMStorageArea::OnCommitTimer() {
   if (is_shutdown_)
     return;
@@ -377,11 +455,14 @@ void DOMStorageArea::OnCommitComplete() {
   if (is_shutdown_)
     return;
   if (commit_batch_.get() && !commit_batches_in_flight_) {
-    // More changes have accrued, restart the timer.
+    // More changes have accrued, restart the timer. If the batch has
+    // already outgrown the backpressure threshold, don't wait out another
+    // window.
     task_runner_->PostDelayedTask(
         FROM_HERE,
         base::Bind(&DOMStorageArea::OnCommitTimer, this),
-        base::TimeDelta::FromSeconds(kCommitTimerSeconds));
+        commit_batch_->data_size > kMaxBytesPerCommitBatch ?
+            base::TimeDelta() : g_commit_window.Get().NextCommitDelay());
   }
 }
 
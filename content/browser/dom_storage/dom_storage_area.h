@@ -89,6 +89,7 @@ class CONTENT_EXPORT DOMStorageArea
   FRIEND_TEST_ALL_PREFIXES(DOMStorageAreaTest, BackingDatabaseOpened);
   FRIEND_TEST_ALL_PREFIXES(DOMStorageAreaTest, TestDatabaseFilePath);
   FRIEND_TEST_ALL_PREFIXES(DOMStorageAreaTest, CommitTasks);
+  FRIEND_TEST_ALL_PREFIXES(DOMStorageAreaTest, CommitBatchAccounting);
   FRIEND_TEST_ALL_PREFIXES(DOMStorageAreaTest, CommitChangesAtShutdown);
   FRIEND_TEST_ALL_PREFIXES(DOMStorageAreaTest, DeleteOrigin);
   FRIEND_TEST_ALL_PREFIXES(DOMStorageAreaTest, PurgeMemory);
@@ -97,9 +98,17 @@ class CONTENT_EXPORT DOMStorageArea
 
   struct CommitBatch {
     bool clear_all_first;
+    bool early_commit_posted;
     DOMStorageValuesMap changed_values;
+    size_t data_size;  // Bytes of keys and values in |changed_values|.
+
     CommitBatch();
     ~CommitBatch();
+
+    // Records |value| as the pending change for |key|, keeping |data_size|
+    // current when an earlier change for |key| is replaced.
+    void UpdateValue(const base::string16& key,
+                     const base::NullableString16& value);
   };
 
   ~DOMStorageArea();
@@ -113,6 +122,7 @@ class CONTENT_EXPORT DOMStorageArea
   // disk on the commit sequence, and to call back on the primary
   // task sequence when complete.
   CommitBatch* CreateCommitBatchIfNeeded();
+  void CommitSoonIfBatchIsFull();
   void OnCommitTimer();
   void CommitChanges(const CommitBatch* commit_batch);
   void OnCommitComplete();
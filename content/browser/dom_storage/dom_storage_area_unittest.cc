@@ -106,6 +106,10 @@ TEST_F(DOMStorageAreaTest, DOMStorageAreaBasics) {
   EXPECT_NE(copy->map_.get(), area->map_.get());
   copy = area->ShallowCopy(2, std::string());
   EXPECT_EQ(copy->map_.get(), area->map_.get());
+
+  // A no-op removal should not trigger a deep copy.
+  EXPECT_FALSE(area->RemoveItem(ASCIIToUTF16("no-such-key"), &old_value));
+  EXPECT_EQ(copy->map_.get(), area->map_.get());
   EXPECT_NE(0u, area->Length());
   EXPECT_TRUE(area->Clear());
   EXPECT_EQ(0u, area->Length());
@@ -281,6 +285,51 @@ TEST_F(DOMStorageAreaTest, CommitTasks) {
   EXPECT_EQ(kValue2, values[kKey2].string());
 }
 
+TEST_F(DOMStorageAreaTest, CommitBatchAccounting) {
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  scoped_refptr<DOMStorageArea> area(new DOMStorageArea(
+      kOrigin,
+      temp_dir.path(),
+      new MockDOMStorageTaskRunner(base::MessageLoopProxy::current().get())));
+  // Inject an in-memory db to speed up the test.
+  area->backing_.reset(new LocalStorageDatabaseAdapter());
+
+  base::NullableString16 old_nullable_value;
+  base::string16 old_value;
+
+  // The batch tracks the size of the keys and values it holds, without
+  // double counting keys that are changed repeatedly.
+  EXPECT_TRUE(area->SetItem(kKey, kValue, &old_nullable_value));
+  EXPECT_EQ((kKey.length() + kValue.length()) * sizeof(base::char16),
+            area->commit_batch_->data_size);
+  EXPECT_TRUE(area->SetItem(kKey, kValue2, &old_nullable_value));
+  EXPECT_EQ((kKey.length() + kValue2.length()) * sizeof(base::char16),
+            area->commit_batch_->data_size);
+  EXPECT_TRUE(area->RemoveItem(kKey, &old_value));
+  EXPECT_EQ(kKey.length() * sizeof(base::char16),
+            area->commit_batch_->data_size);
+  EXPECT_TRUE(area->SetItem(kKey, kValue, &old_nullable_value));
+  EXPECT_TRUE(area->Clear());
+  EXPECT_EQ(0u, area->commit_batch_->data_size);
+  base::MessageLoop::current()->RunUntilIdle();
+  EXPECT_FALSE(area->commit_batch_.get());
+
+  // A batch that grows past the backpressure threshold posts an early
+  // commit rather than waiting out the commit window.
+  EXPECT_TRUE(area->SetItem(kKey, kValue, &old_nullable_value));
+  EXPECT_FALSE(area->commit_batch_->early_commit_posted);
+  const base::string16 kBigValue(1024 * 1024, 'a');
+  EXPECT_TRUE(area->SetItem(kKey2, kBigValue, &old_nullable_value));
+  EXPECT_TRUE(area->commit_batch_->early_commit_posted);
+  base::MessageLoop::current()->RunUntilIdle();
+  EXPECT_FALSE(area->HasUncommittedChanges());
+  DOMStorageValuesMap values;
+  area->backing_->ReadAllValues(&values);
+  EXPECT_EQ(2u, values.size());
+  EXPECT_EQ(kBigValue, values[kKey2].string());
+}
+
 TEST_F(DOMStorageAreaTest, CommitChangesAtShutdown) {
   base::ScopedTempDir temp_dir;
   ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
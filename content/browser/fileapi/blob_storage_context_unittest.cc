@@ -152,6 +152,43 @@ TEST(BlobStorageContextTest, CompoundBlobs) {
   }
 }
 
+TEST(BlobStorageContextTest, SharedBytesWhenExpanding) {
+  const std::string kId1("id1");
+  const std::string kId2("id2");
+
+  base::MessageLoop fake_io_message_loop;
+
+  scoped_refptr<BlobData> blob_data1(new BlobData(kId1));
+  blob_data1->AppendData("Some data in the source blob.");
+
+  scoped_refptr<BlobData> blob_data2(new BlobData(kId2));
+  blob_data2->AppendBlob(kId1, 5, 4);
+
+  BlobStorageContext context;
+  scoped_ptr<BlobDataHandle> handle1 = context.AddFinishedBlob(blob_data1.get());
+  ASSERT_TRUE(handle1.get());
+  scoped_ptr<BlobDataHandle> handle2 = context.AddFinishedBlob(blob_data2.get());
+  ASSERT_TRUE(handle2.get());
+
+  // Expanding the blob item should share the source's bytes, not copy them.
+  ASSERT_EQ(1u, handle2->data()->items().size());
+  const BlobData::Item& item = handle2->data()->items()[0];
+  EXPECT_EQ(BlobData::Item::TYPE_BYTES, item.type());
+  EXPECT_EQ(handle1->data()->items()[0].bytes() + 5, item.bytes());
+  EXPECT_EQ(4u, item.length());
+
+  // The shared bytes should remain valid after the source blob is gone.
+  scoped_refptr<BlobData> data2 = handle2->data();
+  handle1.reset();
+  handle2.reset();
+  {  // Clean up for ASAN
+    base::RunLoop run_loop;
+    run_loop.RunUntilIdle();
+  }
+  EXPECT_FALSE(context.GetBlobDataFromUUID(kId1));
+  EXPECT_EQ(0, memcmp(data2->items()[0].bytes(), "data", 4));
+}
+
 TEST(BlobStorageContextTest, PublicBlobUrls) {
   BlobStorageContext context;
   BlobStorageHost host(&context);
@@ -372,6 +372,46 @@ TEST_F(SandboxDirectoryDatabaseTest, TestListChildren) {
   }
 }
 
+TEST_F(SandboxDirectoryDatabaseTest, TestListChildrenWithInfo) {
+  typedef SandboxDirectoryDatabase::FileIdAndInfo FileIdAndInfo;
+
+  // No children in the root.
+  std::vector<FileIdAndInfo> children;
+  EXPECT_TRUE(db()->ListChildrenWithInfo(0, &children));
+  EXPECT_TRUE(children.empty());
+
+  // A directory and a file in the root.
+  FileId dir_id;
+  FileInfo info;
+  info.parent_id = 0;
+  info.name = FILE_PATH_LITERAL("foo");
+  EXPECT_EQ(base::File::FILE_OK, db()->AddFileInfo(info, &dir_id));
+  FileId file_id;
+  info.name = FILE_PATH_LITERAL("bar");
+  info.data_path = base::FilePath(FILE_PATH_LITERAL("data"));
+  EXPECT_EQ(base::File::FILE_OK, db()->AddFileInfo(info, &file_id));
+
+  EXPECT_TRUE(db()->ListChildrenWithInfo(0, &children));
+  ASSERT_EQ(2UL, children.size());
+  for (size_t i = 0; i < children.size(); ++i) {
+    FileInfo expected;
+    EXPECT_TRUE(db()->GetFileInfo(children[i].file_id, &expected));
+    EXPECT_EQ(expected.parent_id, children[i].info.parent_id);
+    EXPECT_EQ(expected.name, children[i].info.name);
+    EXPECT_EQ(expected.data_path, children[i].info.data_path);
+  }
+  if (children[0].file_id == dir_id) {
+    EXPECT_EQ(children[1].file_id, file_id);
+  } else {
+    EXPECT_EQ(children[1].file_id, dir_id);
+    EXPECT_EQ(children[0].file_id, file_id);
+  }
+
+  // No children in a subdirectory.
+  EXPECT_TRUE(db()->ListChildrenWithInfo(dir_id, &children));
+  EXPECT_TRUE(children.empty());
+}
+
 TEST_F(SandboxDirectoryDatabaseTest, TestUpdateModificationTime) {
   FileInfo info0;
   FileId file_id;
@@ -5,8 +5,10 @@
 #include "content/browser/histogram_message_filter.h"
 
 #include "base/command_line.h"
+#include "base/memory/shared_memory.h"
 #include "base/metrics/histogram.h"
 #include "base/metrics/statistics_recorder.h"
+#include "base/pickle.h"
 #include "content/browser/histogram_controller.h"
 #include "content/browser/tcmalloc_internals_request_job.h"
 #include "content/common/child_process_messages.h"
@@ -22,6 +24,8 @@ bool HistogramMessageFilter::OnMessageReceived(const IPC::Message& message) {
   IPC_BEGIN_MESSAGE_MAP(HistogramMessageFilter, message)
     IPC_MESSAGE_HANDLER(ChildProcessHostMsg_ChildHistogramData,
                         OnChildHistogramData)
+    IPC_MESSAGE_HANDLER(ChildProcessHostMsg_ChildHistogramSharedMemoryData,
+                        OnChildHistogramSharedMemoryData)
     IPC_MESSAGE_HANDLER(ChildProcessHostMsg_GetBrowserHistogram,
                         OnGetBrowserHistogram)
     IPC_MESSAGE_UNHANDLED(handled = false)
@@ -38,6 +42,34 @@ void HistogramMessageFilter::OnChildHistogramData(
       sequence_number, pickled_histograms);
 }
 
+void HistogramMessageFilter::OnChildHistogramSharedMemoryData(
+    int sequence_number,
+    const base::SharedMemoryHandle& handle,
+    uint32 buffer_size) {
+  std::vector<std::string> pickled_histograms;
+#if defined(OS_WIN)
+  base::SharedMemory memory(handle, true, PeerHandle());
+#else
+  base::SharedMemory memory(handle, true);
+#endif
+  if (memory.Map(buffer_size)) {
+    Pickle pickle(static_cast<const char*>(memory.memory()),
+                  static_cast<int>(buffer_size));
+    PickleIterator iter(pickle);
+    int count = 0;
+    if (pickle.ReadInt(&iter, &count)) {
+      for (int i = 0; i < count; ++i) {
+        std::string histogram;
+        if (!pickle.ReadString(&iter, &histogram))
+          break;
+        pickled_histograms.push_back(histogram);
+      }
+    }
+  }
+  HistogramController::GetInstance()->OnHistogramDataCollected(
+      sequence_number, pickled_histograms);
+}
+
 void HistogramMessageFilter::OnGetBrowserHistogram(
     const std::string& name,
     std::string* histogram_json) {
@@ -8,6 +8,7 @@
 #include <string>
 #include <vector>
 
+#include "base/memory/shared_memory.h"
 #include "content/public/browser/browser_message_filter.h"
 #include "content/public/common/process_type.h"
 
@@ -27,6 +28,9 @@ class HistogramMessageFilter : public BrowserMessageFilter {
   // Message handlers.
   void OnChildHistogramData(int sequence_number,
                             const std::vector<std::string>& pickled_histograms);
+  void OnChildHistogramSharedMemoryData(int sequence_number,
+                                        const base::SharedMemoryHandle& handle,
+                                        uint32 buffer_size);
   void OnGetBrowserHistogram(const std::string& name,
                              std::string* histogram_json);
 
@@ -26,6 +26,7 @@
 #include "third_party/leveldatabase/src/include/leveldb/db.h"
 #include "third_party/leveldatabase/src/include/leveldb/env.h"
 #include "third_party/leveldatabase/src/include/leveldb/slice.h"
+#include "third_party/leveldatabase/src/include/leveldb/write_batch.h"
 
 using base::StringPiece;
 
@@ -47,6 +48,12 @@ static const bool kSyncWrites = true;
 static const bool kSyncWrites = true;
 #endif
 
+// Bounds on the group of unsynced write batches accrued under
+// DURABILITY_RELAXED before the next batch is written with a sync,
+// making the whole group durable at once.
+static const int kMaxUnsyncedWrites = 32;
+static const size_t kMaxUnsyncedBytes = 4 * 1024 * 1024;
+
 static leveldb::Slice MakeSlice(const StringPiece& s) {
   return leveldb::Slice(s.begin(), s.size());
 }
@@ -81,7 +88,10 @@ LevelDBSnapshot::LevelDBSnapshot(LevelDBDatabase* db)
 
 LevelDBSnapshot::~LevelDBSnapshot() { db_->ReleaseSnapshot(snapshot_); }
 
-LevelDBDatabase::LevelDBDatabase() {}
+LevelDBDatabase::LevelDBDatabase()
+    : durability_(DURABILITY_STRICT),
+      unsynced_writes_(0),
+      unsynced_bytes_(0) {}
 
 LevelDBDatabase::~LevelDBDatabase() {
   // db_'s destructor uses comparator_adapter_; order of deletion is important.
@@ -366,6 +376,20 @@ leveldb::Status LevelDBDatabase::Write(const LevelDBWriteBatch& write_batch) {
   leveldb::WriteOptions write_options;
   write_options.sync = kSyncWrites;
 
+  if (durability_ == DURABILITY_RELAXED) {
+    unsynced_writes_++;
+    unsynced_bytes_ += write_batch.DataSize();
+    if (unsynced_writes_ >= kMaxUnsyncedWrites ||
+        unsynced_bytes_ >= kMaxUnsyncedBytes) {
+      // The log is written sequentially, so syncing this batch makes the
+      // whole unsynced group durable with a single sync.
+      unsynced_writes_ = 0;
+      unsynced_bytes_ = 0;
+    } else {
+      write_options.sync = false;
+    }
+  }
+
   const leveldb::Status s =
       db_->Write(write_options, write_batch.write_batch_.get());
   if (!s.ok()) {
@@ -375,6 +399,25 @@ leveldb::Status LevelDBDatabase::Write(const LevelDBWriteBatch& write_batch) {
   return s;
 }
 
+void LevelDBDatabase::SetDurability(Durability durability) {
+  if (durability_ == durability)
+    return;
+  durability_ = durability;
+  if (durability_ == DURABILITY_STRICT && unsynced_writes_) {
+    // Make the writes accrued under relaxed durability durable before
+    // resuming strict semantics. An empty synced batch flushes the log up
+    // to this point.
+    leveldb::WriteOptions write_options;
+    write_options.sync = true;
+    leveldb::WriteBatch empty_batch;
+    const leveldb::Status s = db_->Write(write_options, &empty_batch);
+    if (!s.ok())
+      LOG(ERROR) << "LevelDB sync failed: " << s.ToString();
+    unsynced_writes_ = 0;
+    unsynced_bytes_ = 0;
+  }
+}
+
 scoped_ptr<LevelDBIterator> LevelDBDatabase::CreateIterator(
     const LevelDBSnapshot* snapshot) {
   leveldb::ReadOptions read_options;
@@ -72,6 +72,18 @@ class CONTENT_EXPORT LevelDBDatabase {
     const LevelDBComparator* comparator_;
   };
 
+  // Durability of committed write batches. With DURABILITY_STRICT every
+  // batch is synced to disk before Write() returns. With
+  // DURABILITY_RELAXED batches are applied without syncing, and a single
+  // sync is issued once enough unsynced data or batches accrue, so a
+  // group of small transactions shares one sync. Reads always observe
+  // committed data either way, and a process crash loses nothing; only a
+  // power failure can lose the unsynced tail group.
+  enum Durability {
+    DURABILITY_STRICT,
+    DURABILITY_RELAXED,
+  };
+
   static leveldb::Status Open(const base::FilePath& file_name,
                               const LevelDBComparator* comparator,
                               scoped_ptr<LevelDBDatabase>* db,
@@ -90,6 +102,10 @@ class CONTENT_EXPORT LevelDBDatabase {
                               bool* found,
                               const LevelDBSnapshot* = 0);
   leveldb::Status Write(const LevelDBWriteBatch& write_batch);
+  // Sets the durability applied to subsequent Write() calls. The default
+  // is DURABILITY_STRICT; switching back to it from DURABILITY_RELAXED
+  // syncs any writes still pending in the relaxed group.
+  void SetDurability(Durability durability);
   scoped_ptr<LevelDBIterator> CreateIterator(const LevelDBSnapshot* = 0);
   const LevelDBComparator* Comparator() const;
   void Compact(const base::StringPiece& start, const base::StringPiece& stop);
@@ -105,6 +121,9 @@ class CONTENT_EXPORT LevelDBDatabase {
   scoped_ptr<leveldb::Comparator> comparator_adapter_;
   scoped_ptr<leveldb::DB> db_;
   const LevelDBComparator* comparator_;
+  Durability durability_;
+  int unsynced_writes_;
+  size_t unsynced_bytes_;
 };
 
 }  // namespace content
@@ -11,10 +11,12 @@
 #include "base/files/scoped_temp_dir.h"
 #include "base/strings/string16.h"
 #include "base/strings/string_piece.h"
+#include "base/strings/stringprintf.h"
 #include "content/browser/indexed_db/leveldb/leveldb_comparator.h"
 #include "content/browser/indexed_db/leveldb/leveldb_database.h"
 #include "content/browser/indexed_db/leveldb/leveldb_iterator.h"
 #include "content/browser/indexed_db/leveldb/leveldb_transaction.h"
+#include "content/browser/indexed_db/leveldb/leveldb_write_batch.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "third_party/leveldatabase/env_chromium.h"
 #include "third_party/leveldatabase/env_idb.h"
@@ -84,6 +86,42 @@ TEST(LevelDBDatabaseTest, CorruptionTest) {
   EXPECT_FALSE(found);
 }
 
+TEST(LevelDBDatabaseTest, RelaxedDurability) {
+  base::ScopedTempDir temp_directory;
+  ASSERT_TRUE(temp_directory.CreateUniqueTempDir());
+
+  SimpleComparator comparator;
+  scoped_ptr<LevelDBDatabase> leveldb;
+  LevelDBDatabase::Open(temp_directory.path(), &comparator, &leveldb);
+  EXPECT_TRUE(leveldb);
+
+  // Write enough small batches under relaxed durability to run through at
+  // least one sync of the accrued group, then verify every write is
+  // readable both before and after returning to strict durability.
+  leveldb->SetDurability(LevelDBDatabase::DURABILITY_RELAXED);
+  const int kWrites = 40;
+  for (int i = 0; i < kWrites; ++i) {
+    scoped_ptr<LevelDBWriteBatch> write_batch = LevelDBWriteBatch::Create();
+    const std::string key = base::StringPrintf("key%d", i);
+    const std::string value = base::StringPrintf("value%d", i);
+    write_batch->Put(key, value);
+    EXPECT_EQ(key.size() + value.size(), write_batch->DataSize());
+    leveldb::Status status = leveldb->Write(*write_batch);
+    EXPECT_TRUE(status.ok());
+  }
+  leveldb->SetDurability(LevelDBDatabase::DURABILITY_STRICT);
+
+  for (int i = 0; i < kWrites; ++i) {
+    std::string got_value;
+    bool found = false;
+    leveldb::Status status =
+        leveldb->Get(base::StringPrintf("key%d", i), &got_value, &found);
+    EXPECT_TRUE(status.ok());
+    EXPECT_TRUE(found);
+    EXPECT_EQ(base::StringPrintf("value%d", i), got_value);
+  }
+}
+
 TEST(LevelDBDatabaseTest, Transaction) {
   base::ScopedTempDir temp_directory;
   ASSERT_TRUE(temp_directory.CreateUniqueTempDir());
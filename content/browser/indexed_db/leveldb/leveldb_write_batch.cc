@@ -15,7 +15,7 @@ scoped_ptr<LevelDBWriteBatch> LevelDBWriteBatch::Create() {
 }
 
 LevelDBWriteBatch::LevelDBWriteBatch()
-    : write_batch_(new leveldb::WriteBatch) {}
+    : write_batch_(new leveldb::WriteBatch), data_size_(0) {}
 
 LevelDBWriteBatch::~LevelDBWriteBatch() {}
 
@@ -26,12 +26,17 @@ static leveldb::Slice MakeSlice(const base::StringPiece& s) {
 void LevelDBWriteBatch::Put(const base::StringPiece& key,
                             const base::StringPiece& value) {
   write_batch_->Put(MakeSlice(key), MakeSlice(value));
+  data_size_ += key.size() + value.size();
 }
 
 void LevelDBWriteBatch::Remove(const base::StringPiece& key) {
   write_batch_->Delete(MakeSlice(key));
+  data_size_ += key.size();
 }
 
-void LevelDBWriteBatch::Clear() { write_batch_->Clear(); }
+void LevelDBWriteBatch::Clear() {
+  write_batch_->Clear();
+  data_size_ = 0;
+}
 
 }  // namespace content
@@ -26,11 +26,15 @@ class LevelDBWriteBatch {
                                               // batch.
   void Clear();
 
+  // Bytes of keys and values held by the batch.
+  size_t DataSize() const { return data_size_; }
+
  private:
   friend class LevelDBDatabase;
   LevelDBWriteBatch();
 
   scoped_ptr<leveldb::WriteBatch> write_batch_;
+  size_t data_size_;
 };
 
 }  // namespace content
@@ -115,14 +115,19 @@ void AsyncResourceHandler::OnFollowRedirect(int request_id) {
   ResumeIfDeferred();
 }
 
-void AsyncResourceHandler::OnDataReceivedACK(int request_id) {
-  if (pending_data_count_) {
-    --pending_data_count_;
+void AsyncResourceHandler::OnDataReceivedACK(int request_id,
+                                             int number_of_chunks) {
+  // The renderer coalesces the ACKs for a burst of chunks into one message.
+  // Don't trust it to keep the count within what is actually in flight.
+  number_of_chunks = std::min(number_of_chunks, pending_data_count_);
+  if (number_of_chunks <= 0)
+    return;
 
+  pending_data_count_ -= number_of_chunks;
+  while (number_of_chunks--)
     buffer_->RecycleLeastRecentlyAllocated();
-    if (buffer_->CanAllocate())
-      ResumeIfDeferred();
-  }
+  if (buffer_->CanAllocate())
+    ResumeIfDeferred();
 }
 
 bool AsyncResourceHandler::OnUploadProgress(uint64 position,
@@ -55,7 +55,7 @@ class AsyncResourceHandler : public ResourceHandler,
  private:
   // IPC message handlers:
   void OnFollowRedirect(int request_id);
-  void OnDataReceivedACK(int request_id);
+  void OnDataReceivedACK(int request_id, int number_of_chunks);
 
   bool EnsureResourceBufferIsInitialized();
   void ResumeIfDeferred();
@@ -853,7 +853,7 @@ class ResourceDispatcherHostTest : public testing::Test,
     bool result = PickleIterator(msg).ReadInt(&request_id);
     DCHECK(result);
     scoped_ptr<IPC::Message> ack(
-        new ResourceHostMsg_DataReceived_ACK(request_id));
+        new ResourceHostMsg_DataReceived_ACK(request_id, 1));
 
     base::MessageLoop::current()->PostTask(
         FROM_HERE,
@@ -2674,7 +2674,7 @@ TEST_F(ResourceDispatcherHostTest, DelayedDataReceivedACKs) {
 
       EXPECT_EQ(ResourceMsg_DataReceived::ID, msgs[0][i].type());
 
-      ResourceHostMsg_DataReceived_ACK msg(1);
+      ResourceHostMsg_DataReceived_ACK msg(1, 1);
       host_.OnMessageReceived(msg, filter_.get());
     }
 
@@ -2708,7 +2708,7 @@ TEST_F(ResourceDispatcherHostTest, DataReceivedUnexpectedACKs) {
 
   // Send some unexpected ACKs.
   for (size_t i = 0; i < 128; ++i) {
-    ResourceHostMsg_DataReceived_ACK msg(1);
+    ResourceHostMsg_DataReceived_ACK msg(1, 1);
     host_.OnMessageReceived(msg, filter_.get());
   }
 
@@ -2726,7 +2726,7 @@ TEST_F(ResourceDispatcherHostTest, DataReceivedUnexpectedACKs) {
 
       EXPECT_EQ(ResourceMsg_DataReceived::ID, msgs[0][i].type());
 
-      ResourceHostMsg_DataReceived_ACK msg(1);
+      ResourceHostMsg_DataReceived_ACK msg(1, 1);
       host_.OnMessageReceived(msg, filter_.get());
     }
 
@@ -565,7 +565,10 @@ class ResourceScheduler::Client {
 
     size_t num_delayable_requests_in_flight = total_delayable_count_;
     if (num_delayable_requests_in_flight >= kMaxNumDelayableRequestsPerClient) {
-      return DO_NOT_START_REQUEST_AND_STOP_SEARCHING;
+      // SPDY-capable hosts multiplex responses (and may already be pushing
+      // them) on a single connection, so lower-priority requests to such
+      // hosts may still be issued.
+      return DO_NOT_START_REQUEST_AND_KEEP_SEARCHING;
     }
 
     if (ShouldKeepSearching(host_port_pair)) {
@@ -578,7 +581,9 @@ class ResourceScheduler::Client {
         in_flight_requests_.size() > num_delayable_requests_in_flight;
     if (have_immediate_requests_in_flight && !has_body_ &&
         num_delayable_requests_in_flight != 0) {
-      return DO_NOT_START_REQUEST_AND_STOP_SEARCHING;
+      // As above, there may still be SPDY-capable requests that should be
+      // issued.
+      return DO_NOT_START_REQUEST_AND_KEEP_SEARCHING;
     }
 
     return START_REQUEST;
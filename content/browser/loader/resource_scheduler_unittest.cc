@@ -616,6 +616,31 @@ TEST_F(ResourceSchedulerTest, NewSpdyHostInDelayableRequests) {
   EXPECT_TRUE(low2->started());
 }
 
+TEST_F(ResourceSchedulerTest, PendingSpdyRequestStartsBehindDelayableCap) {
+  scheduler_.OnWillInsertBody(kChildId, kRouteId);
+  const int kMaxNumDelayableRequestsPerClient = 10;  // Should match the .cc.
+
+  ScopedVector<TestRequest> lows;
+  for (int i = 0; i < kMaxNumDelayableRequestsPerClient; ++i) {
+    string url = "http://host" + base::IntToString(i) + "/low";
+    lows.push_back(NewRequest(url.c_str(), net::LOWEST));
+  }
+  scoped_ptr<TestRequest> low(NewRequest("http://host/low", net::LOWEST));
+  scoped_ptr<TestRequest> low_spdy(
+      NewRequest("http://spdyhost:8080/low", net::IDLE));
+  EXPECT_FALSE(low->started());
+  EXPECT_FALSE(low_spdy->started());
+
+  // Even though the client-wide delayable limit only lets |low| start, the
+  // queued request to the now known SPDY-capable host should not stay stuck
+  // behind it.
+  http_server_properties_.SetSupportsSpdy(
+      net::HostPortPair("spdyhost", 8080), true);
+  lows.erase(lows.begin());
+  EXPECT_TRUE(low->started());
+  EXPECT_TRUE(low_spdy->started());
+}
+
 TEST_F(ResourceSchedulerTest, ThrottledClientCreation) {
   EXPECT_TRUE(scheduler_.should_throttle());
   scheduler_.OnClientCreated(kBackgroundChildId2, kBackgroundRouteId2);
@@ -82,6 +82,8 @@ bool ClipboardMessageFilter::OnMessageReceived(const IPC::Message& message) {
   IPC_BEGIN_MESSAGE_MAP(ClipboardMessageFilter, message)
     IPC_MESSAGE_HANDLER(ClipboardHostMsg_WriteObjectsAsync, OnWriteObjectsAsync)
     IPC_MESSAGE_HANDLER(ClipboardHostMsg_WriteObjectsSync, OnWriteObjectsSync)
+    IPC_MESSAGE_HANDLER(ClipboardHostMsg_WriteObjectsSharedMemory,
+                        OnWriteObjectsSharedMemory)
     IPC_MESSAGE_HANDLER(ClipboardHostMsg_GetSequenceNumber, OnGetSequenceNumber)
     IPC_MESSAGE_HANDLER(ClipboardHostMsg_IsFormatAvailable, OnIsFormatAvailable)
     IPC_MESSAGE_HANDLER(ClipboardHostMsg_Clear, OnClear)
@@ -169,6 +171,40 @@ void ClipboardMessageFilter::OnWriteObjectsAsync(
 #endif
 }
 
+void ClipboardMessageFilter::OnWriteObjectsSharedMemory(
+    base::SharedMemoryHandle objects_handle,
+    uint32 objects_size) {
+  DCHECK(base::SharedMemory::IsHandleValid(objects_handle))
+      << "Bad objects handle";
+
+#if defined(OS_WIN)
+  base::SharedMemory shared_objects(objects_handle, true, PeerHandle());
+#else
+  base::SharedMemory shared_objects(objects_handle, true);
+#endif
+  if (!shared_objects.Map(objects_size))
+    return;
+
+  IPC::Message pickle(static_cast<const char*>(shared_objects.memory()),
+                      static_cast<int>(objects_size));
+  PickleIterator iter(pickle);
+  scoped_ptr<ui::Clipboard::ObjectMap> objects(new ui::Clipboard::ObjectMap);
+  if (!IPC::ReadParam(&pickle, &iter, objects.get()))
+    return;
+  // The shared memory transfer never carries a bitmap, so filter them out
+  // just as the async message does.
+  SanitizeObjectMap(objects.get(), kFilterBitmap);
+
+#if defined(OS_WIN)
+  BrowserThread::PostTask(
+      BrowserThread::UI,
+      FROM_HERE,
+      base::Bind(&WriteObjectsOnUIThread, base::Owned(objects.release())));
+#else
+  GetClipboard()->WriteObjects(ui::CLIPBOARD_TYPE_COPY_PASTE, *objects.get());
+#endif
+}
+
 void ClipboardMessageFilter::OnGetSequenceNumber(ui::ClipboardType type,
                                                  uint64* sequence_number) {
   *sequence_number = GetClipboard()->GetSequenceNumber(type);
@@ -31,6 +31,8 @@ class ClipboardMessageFilter : public BrowserMessageFilter {
   void OnWriteObjectsAsync(const ui::Clipboard::ObjectMap& objects);
   void OnWriteObjectsSync(const ui::Clipboard::ObjectMap& objects,
                           base::SharedMemoryHandle bitmap_handle);
+  void OnWriteObjectsSharedMemory(base::SharedMemoryHandle objects_handle,
+                                  uint32 objects_size);
   static void WriteObjectsOnUIThread(const ui::Clipboard::ObjectMap* objects);
 
   void OnGetSequenceNumber(const ui::ClipboardType type,
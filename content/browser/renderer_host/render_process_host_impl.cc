@@ -299,6 +299,79 @@ SiteProcessMap* GetSiteProcessMapForBrowserContext(BrowserContext* context) {
   return map;
 }
 
+// Manages a single spare RenderProcessHost that is launched ahead of need so
+// that creating the next SiteInstance does not pay renderer start-up latency.
+// The spare is bound to a BrowserContext and its default StoragePartition but
+// not to any site; SiteInstanceImpl::GetProcess() claims it when a fresh
+// process would otherwise be created, and a replacement is warmed up right
+// away so one is ready for the caller after that.
+class SpareRenderProcessHostManager : public RenderProcessHostObserver {
+ public:
+  SpareRenderProcessHostManager()
+      : spare_host_(NULL), browser_context_(NULL) {}
+
+  void WarmupSpare(BrowserContext* browser_context) {
+    if (spare_host_ && browser_context_ == browser_context)
+      return;
+    DropSpare();
+    StoragePartitionImpl* partition = static_cast<StoragePartitionImpl*>(
+        BrowserContext::GetDefaultStoragePartition(browser_context));
+    spare_host_ = new RenderProcessHostImpl(browser_context, partition, false);
+    browser_context_ = browser_context;
+    spare_host_->AddObserver(this);
+    spare_host_->Init();
+  }
+
+  RenderProcessHost* MaybeTakeSpare(BrowserContext* browser_context,
+                                    StoragePartitionImpl* partition,
+                                    bool is_guest) {
+    RenderProcessHostImpl* host = spare_host_;
+    if (!host || browser_context_ != browser_context || is_guest ||
+        !host->InSameStoragePartition(partition))
+      return NULL;
+    host->RemoveObserver(this);
+    spare_host_ = NULL;
+    browser_context_ = NULL;
+    WarmupSpare(browser_context);
+    return host;
+  }
+
+  // RenderProcessHostObserver:
+  virtual void RenderProcessExited(RenderProcessHost* host,
+                                   base::ProcessHandle handle,
+                                   base::TerminationStatus status,
+                                   int exit_code) OVERRIDE {
+    // A spare that died before it was claimed is useless; let it go and wait
+    // for the next warm-up request rather than respawning in a crash loop.
+    if (host == spare_host_)
+      DropSpare();
+  }
+
+  virtual void RenderProcessHostDestroyed(RenderProcessHost* host) OVERRIDE {
+    if (host == spare_host_) {
+      spare_host_ = NULL;
+      browser_context_ = NULL;
+    }
+  }
+
+ private:
+  void DropSpare() {
+    if (!spare_host_)
+      return;
+    spare_host_->RemoveObserver(this);
+    // The spare has no listeners, so Cleanup() deletes it.
+    spare_host_->Cleanup();
+    spare_host_ = NULL;
+    browser_context_ = NULL;
+  }
+
+  RenderProcessHostImpl* spare_host_;
+  BrowserContext* browser_context_;
+};
+
+base::LazyInstance<SpareRenderProcessHostManager>::Leaky
+    g_spare_render_process_host_manager = LAZY_INSTANCE_INITIALIZER;
+
 // NOTE: changes to this class need to be reviewed by the security team.
 class RendererSandboxedProcessLauncherDelegate
     : public content::SandboxedProcessLauncherDelegate {
@@ -1875,6 +1948,26 @@ RenderProcessHost* RenderProcessHostImpl::GetProcessHostForSite(
   return host;
 }
 
+// static
+RenderProcessHost* RenderProcessHostImpl::MaybeTakeSpareRenderProcessHost(
+    BrowserContext* browser_context,
+    StoragePartitionImpl* partition,
+    bool is_guest) {
+  return g_spare_render_process_host_manager.Get().MaybeTakeSpare(
+      browser_context, partition, is_guest);
+}
+
+// static
+void RenderProcessHostImpl::WarmupSpareRenderProcessHost(
+    BrowserContext* browser_context) {
+  if (!CommandLine::ForCurrentProcess()->HasSwitch(
+          switches::kEnableSpareRendererProcess) ||
+      run_renderer_in_process()) {
+    return;
+  }
+  g_spare_render_process_host_manager.Get().WarmupSpare(browser_context);
+}
+
 void RenderProcessHostImpl::RegisterProcessHostForSite(
     BrowserContext* browser_context,
     RenderProcessHost* process,
@@ -223,6 +223,21 @@ class CONTENT_EXPORT RenderProcessHostImpl
       RenderProcessHost* process,
       const GURL& url);
 
+  // Returns the pre-launched spare RenderProcessHost if one is available for
+  // |browser_context| and |partition|, transferring ownership to the caller
+  // and warming up a replacement in the background. Returns NULL when no
+  // suitable spare exists.
+  static RenderProcessHost* MaybeTakeSpareRenderProcessHost(
+      BrowserContext* browser_context,
+      StoragePartitionImpl* partition,
+      bool is_guest);
+
+  // Pre-launches a renderer process for |browser_context| that a later call
+  // to MaybeTakeSpareRenderProcessHost() can claim, hiding process start-up
+  // latency from the next SiteInstance that needs a fresh process. Does
+  // nothing unless --enable-spare-renderer-process is specified.
+  static void WarmupSpareRenderProcessHost(BrowserContext* browser_context);
+
   static base::MessageLoop* GetInProcessRendererThreadForTesting();
 
   // This forces a renderer that is running "in process" to shut down.
@@ -12,6 +12,7 @@
 #include "content/browser/ssl/ssl_manager.h"
 #include "content/common/websocket_messages.h"
 #include "ipc/ipc_message_macros.h"
+#include "net/base/io_buffer.h"
 #include "net/http/http_request_headers.h"
 #include "net/http/http_response_headers.h"
 #include "net/http/http_util.h"
@@ -97,7 +98,8 @@ class WebSocketEventHandler : public net::WebSocketEventInterface {
       const std::string& extensions) OVERRIDE;
   virtual ChannelState OnDataFrame(bool fin,
                                    WebSocketMessageType type,
-                                   const std::vector<char>& data) OVERRIDE;
+                                   scoped_refptr<net::IOBuffer> buffer,
+                                   size_t buffer_size) OVERRIDE;
   virtual ChannelState OnClosingHandshake() OVERRIDE;
   virtual ChannelState OnFlowControl(int64 quota) OVERRIDE;
   virtual ChannelState OnDropChannel(bool was_clean,
@@ -173,13 +175,20 @@ ChannelState WebSocketEventHandler::OnAddChannelResponse(
 ChannelState WebSocketEventHandler::OnDataFrame(
     bool fin,
     net::WebSocketFrameHeader::OpCode type,
-    const std::vector<char>& data) {
+    scoped_refptr<net::IOBuffer> buffer,
+    size_t buffer_size) {
   DVLOG(3) << "WebSocketEventHandler::OnDataFrame"
            << " routing_id=" << routing_id_ << " fin=" << fin
-           << " type=" << type << " data is " << data.size() << " bytes";
+           << " type=" << type << " data is " << buffer_size << " bytes";
 
-  return StateCast(dispatcher_->SendFrame(
-      routing_id_, fin, OpCodeToMessageType(type), data));
+  // The IPC layer needs a copy of the payload; this is the only copy made on
+  // the browser side.
+  const char* data = buffer ? buffer->data() : NULL;
+  return StateCast(
+      dispatcher_->SendFrame(routing_id_,
+                             fin,
+                             OpCodeToMessageType(type),
+                             std::vector<char>(data, data + buffer_size)));
 }
 
 ChannelState WebSocketEventHandler::OnClosingHandshake() {
@@ -7,6 +7,7 @@
 #include "base/command_line.h"
 #include "base/stl_util.h"
 #include "base/strings/string16.h"
+#include "base/strings/string_number_conversions.h"
 #include "content/browser/service_worker/embedded_worker_instance.h"
 #include "content/browser/service_worker/embedded_worker_registry.h"
 #include "content/browser/service_worker/service_worker_context_core.h"
@@ -29,6 +30,23 @@ namespace {
 // is also stopped without delay)
 const int64 kStopWorkerDelay = 30;  // 30 secs.
 
+// Returns the delay before an idle worker is stopped. Embedders that rely
+// on quickly handling events like push notifications can keep workers warm
+// longer via the command line, avoiding the script reload and recompile on
+// every spin-up.
+base::TimeDelta GetStopWorkerDelay() {
+  const CommandLine& command_line = *CommandLine::ForCurrentProcess();
+  if (command_line.HasSwitch(switches::kServiceWorkerIdleTimeout)) {
+    int seconds;
+    if (base::StringToInt(command_line.GetSwitchValueASCII(
+            switches::kServiceWorkerIdleTimeout), &seconds) &&
+        seconds >= 0) {
+      return base::TimeDelta::FromSeconds(seconds);
+    }
+  }
+  return base::TimeDelta::FromSeconds(kStopWorkerDelay);
+}
+
 // Default delay for scheduled update.
 const int kUpdateDelaySeconds = 10;
 
@@ -662,7 +680,7 @@ void ServiceWorkerVersion::ScheduleStopWorker() {
     return;
   }
   stop_worker_timer_.Start(
-      FROM_HERE, base::TimeDelta::FromSeconds(kStopWorkerDelay),
+      FROM_HERE, GetStopWorkerDelay(),
       base::Bind(&ServiceWorkerVersion::StopWorker,
                  weak_factory_.GetWeakPtr(),
                  base::Bind(&ServiceWorkerUtils::NoOpStatusCallback)));
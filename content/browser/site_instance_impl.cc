@@ -104,9 +104,18 @@ RenderProcessHost* SiteInstanceImpl::GetProcess() {
         StoragePartitionImpl* partition =
             static_cast<StoragePartitionImpl*>(
                 BrowserContext::GetStoragePartition(browser_context, this));
-        process_ = new RenderProcessHostImpl(browser_context,
-                                             partition,
-                                             site_.SchemeIs(kGuestScheme));
+        bool is_guest = site_.SchemeIs(kGuestScheme);
+        // Prefer the pre-launched spare process, if a suitable one is
+        // available; otherwise launch a new process and start warming up a
+        // spare for the next SiteInstance.
+        process_ = RenderProcessHostImpl::MaybeTakeSpareRenderProcessHost(
+            browser_context, partition, is_guest);
+        if (!process_) {
+          process_ = new RenderProcessHostImpl(browser_context,
+                                               partition,
+                                               is_guest);
+          RenderProcessHostImpl::WarmupSpareRenderProcessHost(browser_context);
+        }
       }
     }
     CHECK(process_);
@@ -96,18 +96,14 @@ void TraceUploader::DoUpload(
     OnUploadError("Already uploading.");
   }
 
-  scoped_ptr<char[]> compressed_contents(new char[kMaxUploadBytes]);
-  int compressed_bytes;
-  if (!Compress(file_contents, kMaxUploadBytes, compressed_contents.get(),
-                &compressed_bytes)) {
+  std::string compressed_contents;
+  if (!Compress(file_contents, kMaxUploadBytes, &compressed_contents)) {
     OnUploadError("Compressing file failed.");
     return;
   }
 
   std::string post_data;
-  SetupMultipart("trace.json.gz",
-                 std::string(compressed_contents.get(), compressed_bytes),
-                 &post_data);
+  SetupMultipart("trace.json.gz", compressed_contents, &post_data);
 
   content::BrowserThread::PostTask(
       content::BrowserThread::UI, FROM_HERE,
@@ -159,12 +155,10 @@ void TraceUploader::AddTraceFile(const std::string& trace_filename,
   post_data->append("\r\n");
 }
 
-bool TraceUploader::Compress(std::string input,
+bool TraceUploader::Compress(const std::string& input,
                              int max_compressed_bytes,
-                             char* compressed,
-                             int* compressed_bytes) {
+                             std::string* compressed) {
   DCHECK(compressed);
-  DCHECK(compressed_bytes);
   z_stream stream = {0};
   int result = deflateInit2(&stream,
                             Z_DEFAULT_COMPRESSION,
@@ -174,22 +168,37 @@ bool TraceUploader::Compress(std::string input,
                             8,  // memLevel = 8 is default.
                             Z_DEFAULT_STRATEGY);
   DCHECK_EQ(Z_OK, result);
-  stream.next_in = reinterpret_cast<uint8*>(&input[0]);
+  stream.next_in =
+      reinterpret_cast<uint8*>(const_cast<char*>(input.data()));
   stream.avail_in = input.size();
-  stream.next_out = reinterpret_cast<uint8*>(compressed);
-  stream.avail_out = max_compressed_bytes;
-  // Do a one-shot compression. This will return Z_STREAM_END only if |output|
-  // is large enough to hold all compressed data.
-  result = deflate(&stream, Z_FINISH);
+
+  // Compress into fixed-size chunks appended to |compressed|, rather than
+  // one shot into a buffer sized for the upload limit; traces routinely run
+  // to hundreds of MB while the compressed output is a small fraction of
+  // that, so this keeps the peak allocation proportional to the result.
+  const int kChunkSize = 1 << 16;
+  scoped_ptr<char[]> chunk(new char[kChunkSize]);
+  do {
+    stream.next_out = reinterpret_cast<uint8*>(chunk.get());
+    stream.avail_out = kChunkSize;
+    result = deflate(&stream, Z_FINISH);
+    int chunk_bytes = kChunkSize - stream.avail_out;
+    if (compressed->size() + chunk_bytes >
+        static_cast<size_t>(max_compressed_bytes)) {
+      LOG(ERROR) << "Compressed trace exceeds upload limit of "
+                 << max_compressed_bytes << " bytes.";
+      deflateEnd(&stream);
+      return false;
+    }
+    compressed->append(chunk.get(), chunk_bytes);
+  } while (result == Z_OK);
+
   bool success = (result == Z_STREAM_END);
   result = deflateEnd(&stream);
   DCHECK(result == Z_OK || result == Z_DATA_ERROR);
 
-  if (success)
-    *compressed_bytes = max_compressed_bytes - stream.avail_out;
-
   LOG(WARNING) << "input size: " << input.size()
-               << ", output size: " << *compressed_bytes;
+               << ", output size: " << compressed->size();
   return success;
 }
 
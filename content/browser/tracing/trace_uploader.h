@@ -64,11 +64,12 @@ class TraceUploader : public net::URLFetcherDelegate {
   void AddTraceFile(const std::string& trace_filename,
                     const std::string& trace_contents,
                     std::string* post_data);
-  // Compresses the input and returns whether compression was successful.
-  bool Compress(std::string input,
+  // Compresses the input in streaming fashion, appending to |compressed|.
+  // Returns false if compression fails or the output would exceed
+  // |max_compressed_bytes|.
+  bool Compress(const std::string& input,
                 int max_compressed_bytes,
-                char* compressed_contents,
-                int* compressed_bytes);
+                std::string* compressed);
   void CreateAndStartURLFetcher(const std::string& post_data);
   void OnUploadError(std::string error_message);
 
@@ -7,8 +7,11 @@
 #include <ctype.h>
 
 #include "base/bind.h"
+#include "base/memory/shared_memory.h"
 #include "base/message_loop/message_loop.h"
 #include "base/metrics/histogram_delta_serialization.h"
+#include "base/pickle.h"
+#include "base/process/process_handle.h"
 #include "content/child/child_process.h"
 #include "content/child/child_thread.h"
 #include "content/common/child_process_messages.h"
@@ -16,6 +19,14 @@
 
 namespace content {
 
+namespace {
+
+// Payloads at least this large are moved to the browser through shared
+// memory rather than being copied through the IPC channel.
+const size_t kHistogramSharedMemoryThreshold = 64 * 1024;
+
+}  // namespace
+
 ChildHistogramMessageFilter::ChildHistogramMessageFilter()
     : sender_(NULL),
       io_message_loop_(ChildProcess::current()->io_message_loop_proxy()) {
@@ -42,6 +53,12 @@ bool ChildHistogramMessageFilter::OnMessageReceived(
   return handled;
 }
 
+bool ChildHistogramMessageFilter::GetSupportedMessageClasses(
+    std::vector<uint32>* supported_message_classes) const {
+  supported_message_classes->push_back(ChildProcessMsgStart);
+  return true;
+}
+
 void ChildHistogramMessageFilter::SendHistograms(int sequence_number) {
   io_message_loop_->PostTask(
       FROM_HERE, base::Bind(&ChildHistogramMessageFilter::UploadAllHistograms,
@@ -60,12 +77,45 @@ void ChildHistogramMessageFilter::UploadAllHistograms(int sequence_number) {
 
   std::vector<std::string> deltas;
   histogram_delta_serialization_->PrepareAndSerializeDeltas(&deltas);
-  sender_->Send(
-      new ChildProcessHostMsg_ChildHistogramData(sequence_number, deltas));
+
+  size_t payload_size = 0;
+  for (size_t i = 0; i < deltas.size(); ++i)
+    payload_size += deltas[i].size();
+  if (payload_size < kHistogramSharedMemoryThreshold ||
+      !UploadHistogramsViaSharedMemory(sequence_number, deltas)) {
+    sender_->Send(
+        new ChildProcessHostMsg_ChildHistogramData(sequence_number, deltas));
+  }
 
   static int count = 0;
   count++;
   DHISTOGRAM_COUNTS("Histogram.ChildProcessHistogramSentCount", count);
 }
 
+bool ChildHistogramMessageFilter::UploadHistogramsViaSharedMemory(
+    int sequence_number,
+    const std::vector<std::string>& deltas) {
+  Pickle pickle;
+  pickle.WriteInt(static_cast<int>(deltas.size()));
+  for (size_t i = 0; i < deltas.size(); ++i)
+    pickle.WriteString(deltas[i]);
+
+  scoped_ptr<base::SharedMemory> memory(new base::SharedMemory);
+  if (!memory->CreateAndMapAnonymous(pickle.size()))
+    return false;
+  memcpy(memory->memory(), pickle.data(), pickle.size());
+
+  base::SharedMemoryHandle handle_to_send = memory->handle();
+#if defined(OS_POSIX)
+  // Windows will take care of duplicating the handle to the browser
+  // process when the message is sent.
+  if (!memory->ShareToProcess(base::GetCurrentProcessHandle(),
+                              &handle_to_send))
+    return false;
+#endif
+  sender_->Send(new ChildProcessHostMsg_ChildHistogramSharedMemoryData(
+      sequence_number, handle_to_send, pickle.size()));
+  return true;
+}
+
 }  // namespace content
@@ -27,6 +27,8 @@ class ChildHistogramMessageFilter : public IPC::MessageFilter {
   virtual void OnFilterAdded(IPC::Sender* sender) OVERRIDE;
   virtual void OnFilterRemoved() OVERRIDE;
   virtual bool OnMessageReceived(const IPC::Message& message) OVERRIDE;
+  virtual bool GetSupportedMessageClasses(
+      std::vector<uint32>* supported_message_classes) const OVERRIDE;
 
   void SendHistograms(int sequence_number);
 
@@ -42,6 +44,13 @@ class ChildHistogramMessageFilter : public IPC::MessageFilter {
   // Send only a delta to what we have already sent.
   void UploadAllHistograms(int sequence_number);
 
+  // Sends |deltas| to the browser packed into a single shared memory
+  // block, avoiding a copy of the payload through the IPC channel.
+  // Returns false if the shared memory could not be set up, in which case
+  // the caller falls back to sending the data inline.
+  bool UploadHistogramsViaSharedMemory(int sequence_number,
+                                       const std::vector<std::string>& deltas);
+
   IPC::Sender* sender_;
 
   scoped_refptr<base::MessageLoopProxy> io_message_loop_;
@@ -30,6 +30,12 @@ bool DBMessageFilter::OnMessageReceived(const IPC::Message& message) {
   return handled;
 }
 
+bool DBMessageFilter::GetSupportedMessageClasses(
+    std::vector<uint32>* supported_message_classes) const {
+  supported_message_classes->push_back(DatabaseMsgStart);
+  return true;
+}
+
 void DBMessageFilter::OnDatabaseUpdateSize(const std::string& origin_identifier,
                                            const base::string16& database_name,
                                            int64 database_size) {
@@ -18,6 +18,8 @@ class DBMessageFilter : public IPC::MessageFilter {
 
   // IPC::MessageFilter
   virtual bool OnMessageReceived(const IPC::Message& message) OVERRIDE;
+  virtual bool GetSupportedMessageClasses(
+      std::vector<uint32>* supported_message_classes) const OVERRIDE;
 
  protected:
   virtual ~DBMessageFilter() {}
@@ -269,6 +269,7 @@ void IPCResourceLoaderBridge::SyncLoad(SyncLoadResponse* response) {
 
 ResourceDispatcher::ResourceDispatcher(IPC::Sender* sender)
     : message_sender_(sender),
+      ack_flush_pending_(false),
       weak_factory_(this),
       delegate_(NULL),
       io_timestamp_(base::TimeTicks()) {
@@ -473,7 +474,31 @@ void ResourceDispatcher::OnReceivedData(int request_id,
 
   // Acknowledge the reception of this data.
   if (send_ack)
-    message_sender_->Send(new ResourceHostMsg_DataReceived_ACK(request_id));
+    ScheduleDataReceivedAck(request_id);
+}
+
+void ResourceDispatcher::ScheduleDataReceivedAck(int request_id) {
+  pending_data_acks_[request_id]++;
+  if (ack_flush_pending_)
+    return;
+  ack_flush_pending_ = true;
+  // The flush task runs once the current burst of incoming messages has been
+  // dispatched, so consecutive DataReceived messages are acknowledged with
+  // one ACK per request rather than one per chunk.
+  base::MessageLoop::current()->PostTask(
+      FROM_HERE,
+      base::Bind(&ResourceDispatcher::FlushDataReceivedAcks,
+                 weak_factory_.GetWeakPtr()));
+}
+
+void ResourceDispatcher::FlushDataReceivedAcks() {
+  ack_flush_pending_ = false;
+  std::map<int, int> acks;
+  acks.swap(pending_data_acks_);
+  for (std::map<int, int>::iterator it = acks.begin(); it != acks.end(); ++it) {
+    message_sender_->Send(
+        new ResourceHostMsg_DataReceived_ACK(it->first, it->second));
+  }
 }
 
 void ResourceDispatcher::OnDownloadedData(int request_id,
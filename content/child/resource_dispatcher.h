@@ -8,6 +8,7 @@
 #define CONTENT_CHILD_RESOURCE_DISPATCHER_H_
 
 #include <deque>
+#include <map>
 #include <string>
 
 #include "base/containers/hash_tables.h"
@@ -171,6 +172,15 @@ class CONTENT_EXPORT ResourceDispatcher : public IPC::Listener {
       int request_id,
       const ResourceMsg_RequestCompleteData& request_complete_data);
 
+  // Records that one more DataReceived message for |request_id| has been
+  // consumed and schedules a task to acknowledge it to the browser. A burst
+  // of data messages dispatched back-to-back is acknowledged with a single
+  // ACK per request instead of one round trip per chunk.
+  void ScheduleDataReceivedAck(int request_id);
+
+  // Sends the coalesced ResourceHostMsg_DataReceived_ACK messages.
+  void FlushDataReceivedAcks();
+
   // Dispatch the message to one of the message response handlers.
   void DispatchMessage(const IPC::Message& message);
 
@@ -210,6 +220,11 @@ class CONTENT_EXPORT ResourceDispatcher : public IPC::Listener {
   // All pending requests issued to the host
   PendingRequestList pending_requests_;
 
+  // Number of consumed data chunks per request that have not yet been
+  // acknowledged to the browser. Flushed by FlushDataReceivedAcks().
+  std::map<int, int> pending_data_acks_;
+  bool ack_flush_pending_;
+
   base::WeakPtrFactory<ResourceDispatcher> weak_factory_;
 
   ResourceDispatcherDelegate* delegate_;
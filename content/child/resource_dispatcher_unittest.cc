@@ -205,13 +205,17 @@ class ResourceDispatcherTest : public testing::Test, public IPC::Sender {
     message_queue_.erase(message_queue_.begin());
   }
 
-  void ConsumeDataReceived_ACK(int expected_request_id) {
+  void ConsumeDataReceived_ACK(int expected_request_id,
+                               int expected_number_of_chunks = 1) {
+    // ACKs for received data are coalesced and sent from a posted task.
+    base::RunLoop().RunUntilIdle();
     ASSERT_FALSE(message_queue_.empty());
-    Tuple1<int> args;
+    Tuple2<int, int> args;
     ASSERT_EQ(ResourceHostMsg_DataReceived_ACK::ID, message_queue_[0].type());
     ASSERT_TRUE(ResourceHostMsg_DataReceived_ACK::Read(
         &message_queue_[0], &args));
     EXPECT_EQ(expected_request_id, args.a);
+    EXPECT_EQ(expected_number_of_chunks, args.b);
     message_queue_.erase(message_queue_.begin());
   }
 
@@ -33,6 +33,7 @@ IPC_STRUCT_TRAITS_END()
 IPC_STRUCT_TRAITS_BEGIN(tracked_objects::DeathDataSnapshot)
   IPC_STRUCT_TRAITS_MEMBER(count)
   IPC_STRUCT_TRAITS_MEMBER(run_duration_sum)
+  IPC_STRUCT_TRAITS_MEMBER(run_duration_sum_squares)
   IPC_STRUCT_TRAITS_MEMBER(run_duration_max)
   IPC_STRUCT_TRAITS_MEMBER(run_duration_sample)
   IPC_STRUCT_TRAITS_MEMBER(queue_duration_sum)
@@ -141,6 +142,14 @@ IPC_MESSAGE_CONTROL2(ChildProcessHostMsg_ChildHistogramData,
                      int, /* sequence_number */
                      std::vector<std::string> /* histogram_data */)
 
+// Send back histograms as a shared memory block holding the pickled
+// histogram strings. Used instead of ChildProcessHostMsg_ChildHistogramData
+// when the payload is large.
+IPC_MESSAGE_CONTROL3(ChildProcessHostMsg_ChildHistogramSharedMemoryData,
+                     int, /* sequence_number */
+                     base::SharedMemoryHandle, /* histogram_data */
+                     uint32 /* buffer size */)
+
 // Request a histogram from the browser. The browser will send the histogram
 // data only if it has been passed the command line flag
 // switches::kDomAutomationController.
@@ -30,6 +30,13 @@ IPC_MESSAGE_CONTROL1(ClipboardHostMsg_WriteObjectsAsync,
 IPC_SYNC_MESSAGE_CONTROL2_0(ClipboardHostMsg_WriteObjectsSync,
                             ui::Clipboard::ObjectMap /* objects */,
                             base::SharedMemoryHandle /* bitmap handle */)
+// This message is used when the object list contains no bitmap but is too
+// large to copy through the IPC channel; the shared memory block holds the
+// pickled object map. It is synchronized so that the renderer knows when it
+// is safe to free the shared memory.
+IPC_SYNC_MESSAGE_CONTROL2_0(ClipboardHostMsg_WriteObjectsSharedMemory,
+                            base::SharedMemoryHandle /* objects handle */,
+                            uint32 /* objects size */)
 IPC_SYNC_MESSAGE_CONTROL1_1(ClipboardHostMsg_GetSequenceNumber,
                             ui::ClipboardType /* type */,
                             uint64 /* result */)
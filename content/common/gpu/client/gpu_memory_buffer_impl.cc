@@ -21,6 +21,7 @@ bool GpuMemoryBufferImpl::IsFormatValid(unsigned internalformat) {
   switch (internalformat) {
     case GL_BGRA8_EXT:
     case GL_RGBA8_OES:
+    case GL_RGBA4:
       return true;
     default:
       return false;
@@ -44,6 +45,8 @@ size_t GpuMemoryBufferImpl::BytesPerPixel(unsigned internalformat) {
     case GL_BGRA8_EXT:
     case GL_RGBA8_OES:
       return 4;
+    case GL_RGBA4:
+      return 2;
     default:
       NOTREACHED();
       return 0;
@@ -33,7 +33,8 @@ GpuChannelManager::ImageOperation::~ImageOperation() {
 GpuChannelManager::GpuChannelManager(MessageRouter* router,
                                      GpuWatchdog* watchdog,
                                      base::MessageLoopProxy* io_message_loop,
-                                     base::WaitableEvent* shutdown_event)
+                                     base::WaitableEvent* shutdown_event,
+                                     const gpu::GPUInfo& gpu_info)
     : weak_factory_(this),
       io_message_loop_(io_message_loop),
       shutdown_event_(shutdown_event),
@@ -42,7 +43,8 @@ GpuChannelManager::GpuChannelManager(MessageRouter* router,
           this,
           GpuMemoryManager::kDefaultMaxSurfacesWithFrontbufferSoftLimit),
       watchdog_(watchdog),
-      sync_point_manager_(new SyncPointManager) {
+      sync_point_manager_(new SyncPointManager),
+      gpu_info_(gpu_info) {
   DCHECK(router_);
   DCHECK(io_message_loop);
   DCHECK(shutdown_event);
@@ -64,6 +66,9 @@ gpu::gles2::ProgramCache* GpuChannelManager::program_cache() {
       !CommandLine::ForCurrentProcess()->HasSwitch(
           switches::kDisableGpuProgramCache)) {
     program_cache_.reset(new gpu::gles2::MemoryProgramCache());
+    program_cache_->set_driver_fingerprint(
+        gpu_info_.gl_vendor + "\n" + gpu_info_.gl_renderer + "\n" +
+        gpu_info_.gl_version_string + "\n" + gpu_info_.driver_version);
   }
   return program_cache_.get();
 }
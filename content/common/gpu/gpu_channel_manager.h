@@ -17,6 +17,7 @@
 #include "build/build_config.h"
 #include "content/common/gpu/devtools_gpu_instrumentation.h"
 #include "content/common/gpu/gpu_memory_manager.h"
+#include "gpu/config/gpu_info.h"
 #include "ipc/ipc_listener.h"
 #include "ipc/ipc_sender.h"
 #include "ui/gfx/native_widget_types.h"
@@ -60,7 +61,8 @@ class GpuChannelManager : public IPC::Listener,
   GpuChannelManager(MessageRouter* router,
                     GpuWatchdog* watchdog,
                     base::MessageLoopProxy* io_message_loop,
-                    base::WaitableEvent* shutdown_event);
+                    base::WaitableEvent* shutdown_event,
+                    const gpu::GPUInfo& gpu_info);
   virtual ~GpuChannelManager();
 
   // Remove the channel for a particular renderer.
@@ -155,6 +157,10 @@ class GpuChannelManager : public IPC::Listener,
   GpuEventsDispatcher gpu_devtools_events_dispatcher_;
   GpuWatchdog* watchdog_;
   scoped_refptr<SyncPointManager> sync_point_manager_;
+  // Information about the GPU collected at process startup. The driver
+  // identity from here keys the program cache so that binaries cached under
+  // one driver are never offered to another.
+  gpu::GPUInfo gpu_info_;
   scoped_ptr<gpu::gles2::ProgramCache> program_cache_;
   scoped_refptr<gpu::gles2::ShaderTranslatorCache> shader_translator_cache_;
   scoped_refptr<gfx::GLSurface> default_offscreen_surface_;
@@ -323,10 +323,12 @@ IPC_SYNC_MESSAGE_ROUTED2_1(ResourceHostMsg_SyncLoad,
                            ResourceHostMsg_Request,
                            content::SyncLoadResult)
 
-// Sent when the renderer process is done processing a DataReceived
-// message.
-IPC_MESSAGE_CONTROL1(ResourceHostMsg_DataReceived_ACK,
-                     int /* request_id */)
+// Sent when the renderer process is done processing one or more DataReceived
+// messages.  The renderer may coalesce the acknowledgements for a burst of
+// DataReceived messages into a single ACK covering all of them.
+IPC_MESSAGE_CONTROL2(ResourceHostMsg_DataReceived_ACK,
+                     int /* request_id */,
+                     int /* number_of_chunks */)
 
 // Sent when the renderer has processed a DataDownloaded message.
 IPC_MESSAGE_CONTROL1(ResourceHostMsg_DataDownloaded_ACK,
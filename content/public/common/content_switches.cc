@@ -456,6 +456,10 @@ const char kEnableSkiaBenchmarking[]        = "enable-skia-benchmarking";
 // On platforms that support it, enables smooth scroll animation.
 const char kEnableSmoothScrolling[]         = "enable-smooth-scrolling";
 
+// Keeps a warm renderer process launched ahead of need, so creating the next
+// tab does not pay process start-up latency.
+const char kEnableSpareRendererProcess[]    = "enable-spare-renderer-process";
+
 // Enable spatial navigation
 const char kEnableSpatialNavigation[]       = "enable-spatial-navigation";
 
@@ -724,6 +728,11 @@ const char kSandboxIPCProcess[]             = "sandbox-ipc";
 // Defaults to disabled.
 const char kScrollEndEffect[] = "scroll-end-effect";
 
+// Number of seconds an idle service worker is kept alive before being
+// stopped. Embedders relying on quick push-event handling can raise this to
+// keep workers warm at the cost of memory.
+const char kServiceWorkerIdleTimeout[]      = "service-worker-idle-timeout";
+
 // Visibly render a border around paint rects in the web page to help debug
 // and study painting behavior.
 const char kShowPaintRects[]                = "show-paint-rects";
@@ -300,12 +300,10 @@ void BlinkAXTreeSource::SerializeNode(blink::WebAXObject src,
     // TODO(ctguil): The tagName in WebKit is lower cased but
     // HTMLElement::nodeName calls localNameUpper. Consider adding
     // a WebElement method that returns the original lower cased tagName.
-    dst->AddStringAttribute(
-        ui::AX_ATTR_HTML_TAG,
-        StringToLowerASCII(UTF16ToUTF8(element.tagName())));
+    dst->AddStringAttribute(ui::AX_ATTR_HTML_TAG,
+                            GetInternedName(element.tagName()));
     for (unsigned i = 0; i < element.attributeCount(); ++i) {
-      std::string name = StringToLowerASCII(UTF16ToUTF8(
-          element.attributeLocalName(i)));
+      const std::string& name = GetInternedName(element.attributeLocalName(i));
       std::string value = UTF16ToUTF8(element.attributeValue(i));
       dst->html_attributes.push_back(std::make_pair(name, value));
     }
@@ -549,6 +547,15 @@ void BlinkAXTreeSource::SerializeNode(blink::WebAXObject src,
     AddIntListAttributeFromWebObjects(ui::AX_ATTR_OWNS_IDS, owns, dst);
 }
 
+const std::string& BlinkAXTreeSource::GetInternedName(
+    const base::string16& name) const {
+  std::map<base::string16, std::string>::const_iterator iter =
+      interned_strings_.find(name);
+  if (iter != interned_strings_.end())
+    return iter->second;
+  return interned_strings_[name] = StringToLowerASCII(UTF16ToUTF8(name));
+}
+
 blink::WebDocument BlinkAXTreeSource::GetMainDocument() const {
   WebView* view = render_view_->GetWebView();
   WebLocalFrame* main_frame =
@@ -5,6 +5,10 @@
 #ifndef CONTENT_RENDERER_ACCESSIBILITY_BLINK_AX_TREE_SOURCE_H_
 #define CONTENT_RENDERER_ACCESSIBILITY_BLINK_AX_TREE_SOURCE_H_
 
+#include <map>
+#include <string>
+
+#include "base/strings/string16.h"
 #include "third_party/WebKit/public/web/WebAXObject.h"
 #include "ui/accessibility/ax_node_data.h"
 #include "ui/accessibility/ax_tree_source.h"
@@ -41,7 +45,18 @@ class BlinkAXTreeSource
   blink::WebDocument GetMainDocument() const;
 
  private:
+  // Returns the lower-cased UTF-8 form of |name|, interned in
+  // |interned_strings_|. Tag and attribute names are drawn from a small
+  // vocabulary that recurs on nearly every node, and SerializeNode() is
+  // called for every node in every incremental update, so converting and
+  // lower-casing each name once is a significant saving. The cache can only
+  // grow to the number of distinct names used by the document.
+  const std::string& GetInternedName(const base::string16& name) const;
+
   RenderViewImpl* render_view_;
+
+  // Interned tag and attribute names; see GetInternedName().
+  mutable std::map<base::string16, std::string> interned_strings_;
 };
 
 }  // namespace content
@@ -128,6 +128,7 @@ class InputEventFilterTest : public testing::Test {
   virtual void SetUp() OVERRIDE {
     filter_ = new InputEventFilter(
         &message_recorder_,
+        message_loop_.message_loop_proxy(),
         message_loop_.message_loop_proxy());
     filter_->SetBoundHandler(
         base::Bind(&InputEventRecorder::HandleInputEvent,
@@ -91,6 +91,13 @@ void AudioInputMessageFilter::OnFilterAdded(IPC::Sender* sender) {
   sender_ = sender;
 }
 
+bool AudioInputMessageFilter::GetSupportedMessageClasses(
+    std::vector<uint32>* supported_message_classes) const {
+  // Audio input messages share the audio message class.
+  supported_message_classes->push_back(AudioMsgStart);
+  return true;
+}
+
 void AudioInputMessageFilter::OnFilterRemoved() {
   DCHECK(io_message_loop_->BelongsToCurrentThread());
 
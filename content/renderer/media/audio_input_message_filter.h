@@ -57,6 +57,8 @@ class CONTENT_EXPORT AudioInputMessageFilter : public IPC::MessageFilter {
   virtual void OnFilterAdded(IPC::Sender* sender) OVERRIDE;
   virtual void OnFilterRemoved() OVERRIDE;
   virtual void OnChannelClosing() OVERRIDE;
+  virtual bool GetSupportedMessageClasses(
+      std::vector<uint32>* supported_message_classes) const OVERRIDE;
 
   // Received when browser process has created an audio input stream.
   void OnStreamCreated(int stream_id,
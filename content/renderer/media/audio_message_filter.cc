@@ -142,6 +142,12 @@ void AudioMessageFilter::OnFilterAdded(IPC::Sender* sender) {
   sender_ = sender;
 }
 
+bool AudioMessageFilter::GetSupportedMessageClasses(
+    std::vector<uint32>* supported_message_classes) const {
+  supported_message_classes->push_back(AudioMsgStart);
+  return true;
+}
+
 void AudioMessageFilter::OnFilterRemoved() {
   DCHECK(io_message_loop_->BelongsToCurrentThread());
 
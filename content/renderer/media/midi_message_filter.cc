@@ -72,6 +72,12 @@ void MidiMessageFilter::OnChannelClosing() {
   sender_ = NULL;
 }
 
+bool MidiMessageFilter::GetSupportedMessageClasses(
+    std::vector<uint32>* supported_message_classes) const {
+  supported_message_classes->push_back(MidiMsgStart);
+  return true;
+}
+
 void MidiMessageFilter::StartSession(blink::WebMIDIAccessorClient* client) {
   // Generate and keep track of a "client id" which is sent to the browser
   // to ask permission to talk to MIDI hardware.
@@ -58,6 +58,8 @@ class CONTENT_EXPORT MidiMessageFilter : public IPC::MessageFilter {
   virtual void OnFilterAdded(IPC::Sender* sender) OVERRIDE;
   virtual void OnFilterRemoved() OVERRIDE;
   virtual void OnChannelClosing() OVERRIDE;
+  virtual bool GetSupportedMessageClasses(
+      std::vector<uint32>* supported_message_classes) const OVERRIDE;
 
   // Called when the browser process has approved (or denied) access to
   // MIDI hardware.
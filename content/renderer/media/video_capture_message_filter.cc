@@ -93,6 +93,12 @@ void VideoCaptureMessageFilter::OnChannelClosing() {
   sender_ = NULL;
 }
 
+bool VideoCaptureMessageFilter::GetSupportedMessageClasses(
+    std::vector<uint32>* supported_message_classes) const {
+  supported_message_classes->push_back(VideoCaptureMsgStart);
+  return true;
+}
+
 VideoCaptureMessageFilter::~VideoCaptureMessageFilter() {}
 
 VideoCaptureMessageFilter::Delegate* VideoCaptureMessageFilter::find_delegate(
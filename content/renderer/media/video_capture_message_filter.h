@@ -83,6 +83,8 @@ class CONTENT_EXPORT VideoCaptureMessageFilter : public IPC::MessageFilter {
   virtual void OnFilterAdded(IPC::Sender* sender) OVERRIDE;
   virtual void OnFilterRemoved() OVERRIDE;
   virtual void OnChannelClosing() OVERRIDE;
+  virtual bool GetSupportedMessageClasses(
+      std::vector<uint32>* supported_message_classes) const OVERRIDE;
 
  protected:
   virtual ~VideoCaptureMessageFilter();
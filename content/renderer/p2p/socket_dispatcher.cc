@@ -85,6 +85,12 @@ void P2PSocketDispatcher::OnChannelClosing() {
   sender_ = NULL;
 }
 
+bool P2PSocketDispatcher::GetSupportedMessageClasses(
+    std::vector<uint32>* supported_message_classes) const {
+  supported_message_classes->push_back(P2PMsgStart);
+  return true;
+}
+
 base::MessageLoopProxy* P2PSocketDispatcher::message_loop() {
   return message_loop_.get();
 }
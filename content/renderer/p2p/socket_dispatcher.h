@@ -77,6 +77,8 @@ class CONTENT_EXPORT P2PSocketDispatcher : public IPC::MessageFilter {
   virtual void OnFilterAdded(IPC::Sender* sender) OVERRIDE;
   virtual void OnFilterRemoved() OVERRIDE;
   virtual void OnChannelClosing() OVERRIDE;
+  virtual bool GetSupportedMessageClasses(
+      std::vector<uint32>* supported_message_classes) const OVERRIDE;
 
   // Returns the IO message loop.
   base::MessageLoopProxy* message_loop();
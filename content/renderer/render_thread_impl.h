@@ -97,6 +97,7 @@ class NetInfoDispatcher;
 class P2PSocketDispatcher;
 class PeerConnectionTracker;
 class RendererDemuxerAndroid;
+class RendererScheduler;
 class RendererWebKitPlatformSupportImpl;
 class RenderProcessObserver;
 class VideoCaptureImplManager;
@@ -208,6 +209,11 @@ class CONTENT_EXPORT RenderThreadImpl : public RenderThread,
     return input_handler_manager_.get();
   }
 
+  // Prioritized task queues for the renderer main thread.
+  RendererScheduler* renderer_scheduler() const {
+    return renderer_scheduler_.get();
+  }
+
   // Will be NULL if threaded compositing has not been enabled.
   scoped_refptr<base::MessageLoopProxy> compositor_message_loop_proxy() const {
     return compositor_message_loop_proxy_;
@@ -542,6 +548,8 @@ class CONTENT_EXPORT RenderThreadImpl : public RenderThread,
   // regardless of whether |compositor_thread_| is overriden.
   scoped_refptr<base::MessageLoopProxy> compositor_message_loop_proxy_;
 
+  scoped_ptr<RendererScheduler> renderer_scheduler_;
+
   // May be null if unused by the |input_handler_manager_|.
   scoped_refptr<InputEventFilter> input_event_filter_;
   scoped_ptr<InputHandlerManager> input_handler_manager_;
@@ -20,6 +20,10 @@ namespace content {
 
 namespace {
 
+// Object maps at least this large are moved to the browser through shared
+// memory rather than being copied through the IPC channel.
+const size_t kObjectsSharedMemoryThreshold = 64 * 1024;
+
 class RendererClipboardWriteContext : public ClipboardClient::WriteContext {
  public:
   RendererClipboardWriteContext();
@@ -30,6 +34,8 @@ class RendererClipboardWriteContext : public ClipboardClient::WriteContext {
   virtual void Flush(const ui::Clipboard::ObjectMap& objects) OVERRIDE;
 
  private:
+  bool FlushViaSharedMemory(const ui::Clipboard::ObjectMap& objects);
+
   scoped_ptr<base::SharedMemory> shared_buf_;
   DISALLOW_COPY_AND_ASSIGN(RendererClipboardWriteContext);
 };
@@ -89,12 +95,46 @@ void RendererClipboardWriteContext::Flush(
   if (shared_buf_) {
     RenderThreadImpl::current()->Send(
         new ClipboardHostMsg_WriteObjectsSync(objects, shared_buf_->handle()));
-  } else {
+    return;
+  }
+  if (!FlushViaSharedMemory(objects)) {
     RenderThreadImpl::current()->Send(
         new ClipboardHostMsg_WriteObjectsAsync(objects));
   }
 }
 
+// Moves large object maps (e.g. sizeable HTML copies) to the browser through
+// a single shared memory block instead of copying them through the IPC
+// channel. Returns false if the payload is small or the shared memory could
+// not be set up, in which case the caller sends the data inline.
+bool RendererClipboardWriteContext::FlushViaSharedMemory(
+    const ui::Clipboard::ObjectMap& objects) {
+  size_t payload_size = 0;
+  for (ui::Clipboard::ObjectMap::const_iterator it = objects.begin();
+       it != objects.end(); ++it) {
+    for (size_t i = 0; i < it->second.size(); ++i)
+      payload_size += it->second[i].size();
+  }
+  if (payload_size < kObjectsSharedMemoryThreshold)
+    return false;
+
+  IPC::Message pickle;
+  IPC::WriteParam(&pickle, objects);
+  scoped_ptr<base::SharedMemory> shared_objects(
+      ChildThread::current()->AllocateSharedMemory(pickle.size()));
+  if (!shared_objects)
+    return false;
+  memcpy(shared_objects->memory(), pickle.data(), pickle.size());
+  shared_objects->Unmap();
+
+  // The message is synchronized, so the shared memory may be freed as soon
+  // as the send completes.
+  RenderThreadImpl::current()->Send(
+      new ClipboardHostMsg_WriteObjectsSharedMemory(
+          shared_objects->handle(), static_cast<uint32>(pickle.size())));
+  return true;
+}
+
 }  // anonymous namespace
 
 RendererClipboardClient::RendererClipboardClient() {
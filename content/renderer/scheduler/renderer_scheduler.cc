@@ -0,0 +1,234 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "content/renderer/scheduler/renderer_scheduler.h"
+
+#include "base/bind.h"
+#include "base/location.h"
+#include "base/message_loop/message_loop_proxy.h"
+
+namespace content {
+
+namespace {
+
+// While the renderer is hidden, suppressible tasks are run at most this
+// often, aligning background timers to a one second interval.
+const int kSuppressedTaskIntervalMs = 1000;
+
+}  // namespace
+
+// Shared between the scheduler and its task runners so that the runners
+// stay usable if they outlive the scheduler.
+class RendererScheduler::Inner
+    : public base::RefCountedThreadSafe<RendererScheduler::Inner> {
+ public:
+  explicit Inner(
+      const scoped_refptr<base::SingleThreadTaskRunner>& main_task_runner)
+      : main_task_runner_(main_task_runner),
+        renderer_hidden_(false),
+        suppressed_pump_scheduled_(false) {}
+
+  // Pumps are matched to queued tasks by count, not identity: the DoWork
+  // posted for one task may end up running a different, higher-priority
+  // one. Every pump therefore runs non-nested, so that a pump executing
+  // inside a nested message loop can never pick up a task that was posted
+  // via PostNonNestableDelayedTask. Running a nestable task outside a
+  // nested loop is always permitted, so this is safe for both kinds.
+  bool PostTask(const tracked_objects::Location& from_here,
+                const base::Closure& task,
+                base::TimeDelta delay,
+                QueuePriority priority) {
+    if (delay > base::TimeDelta()) {
+      // Delayed tasks only become eligible to run once their delay has
+      // expired, so the enqueue itself is deferred.
+      return main_task_runner_->PostNonNestableDelayedTask(
+          from_here,
+          base::Bind(&Inner::EnqueueAndDoWork, this, priority, task),
+          delay);
+    }
+    {
+      base::AutoLock lock(lock_);
+      queues_[priority].push(task);
+      if (priority == SUPPRESSIBLE_PRIORITY && renderer_hidden_) {
+        // Suppressed tasks are not matched by a DoWork; they wait for the
+        // next pump, or for the renderer to be restored.
+        ScheduleSuppressedPump();
+        return true;
+      }
+    }
+    return main_task_runner_->PostNonNestableTask(
+        from_here, base::Bind(&Inner::DoWork, this));
+  }
+
+  void SetRendererHidden(bool hidden) {
+    size_t tasks_to_pump = 0;
+    {
+      base::AutoLock lock(lock_);
+      if (renderer_hidden_ == hidden)
+        return;
+      renderer_hidden_ = hidden;
+      if (hidden) {
+        // Tasks already queued had a DoWork posted for them, but those
+        // DoWorks will now skip the suppressible queue; hand the tasks over
+        // to the pump instead.
+        if (!queues_[SUPPRESSIBLE_PRIORITY].empty())
+          ScheduleSuppressedPump();
+      } else {
+        tasks_to_pump = queues_[SUPPRESSIBLE_PRIORITY].size();
+      }
+    }
+    for (size_t i = 0; i < tasks_to_pump; ++i) {
+      main_task_runner_->PostNonNestableTask(
+          FROM_HERE, base::Bind(&Inner::DoWork, this));
+    }
+  }
+
+  bool RunsTasksOnCurrentThread() const {
+    return main_task_runner_->RunsTasksOnCurrentThread();
+  }
+
+ private:
+  friend class base::RefCountedThreadSafe<Inner>;
+
+  ~Inner() {}
+
+  // Runs the oldest task from the highest-priority queue that has one.
+  // One DoWork is posted per queued task, so every queued task is matched
+  // by a pump even when a higher-priority task overtakes it.
+  void DoWork() {
+    base::Closure task;
+    {
+      base::AutoLock lock(lock_);
+      for (int i = 0; i < PRIORITY_COUNT; ++i) {
+        if (i == SUPPRESSIBLE_PRIORITY && renderer_hidden_)
+          continue;
+        if (!queues_[i].empty()) {
+          task = queues_[i].front();
+          queues_[i].pop();
+          break;
+        }
+      }
+    }
+    if (!task.is_null())
+      task.Run();
+  }
+
+  void EnqueueAndDoWork(QueuePriority priority, const base::Closure& task) {
+    {
+      base::AutoLock lock(lock_);
+      queues_[priority].push(task);
+      if (priority == SUPPRESSIBLE_PRIORITY && renderer_hidden_) {
+        ScheduleSuppressedPump();
+        return;
+      }
+    }
+    DoWork();
+  }
+
+  // Schedules a delayed pump of the suppressible queue, if one is not
+  // already pending. Must be called with |lock_| held.
+  void ScheduleSuppressedPump() {
+    lock_.AssertAcquired();
+    if (suppressed_pump_scheduled_)
+      return;
+    suppressed_pump_scheduled_ = true;
+    main_task_runner_->PostNonNestableDelayedTask(
+        FROM_HERE,
+        base::Bind(&Inner::RunSuppressedTask, this),
+        base::TimeDelta::FromMilliseconds(kSuppressedTaskIntervalMs));
+  }
+
+  // Runs a single suppressible task while the renderer remains hidden,
+  // rescheduling itself while a backlog remains. If the renderer was
+  // restored in the meantime the queue has already been handed back to
+  // DoWork and there is nothing to do.
+  void RunSuppressedTask() {
+    base::Closure task;
+    {
+      base::AutoLock lock(lock_);
+      suppressed_pump_scheduled_ = false;
+      if (!renderer_hidden_ || queues_[SUPPRESSIBLE_PRIORITY].empty())
+        return;
+      task = queues_[SUPPRESSIBLE_PRIORITY].front();
+      queues_[SUPPRESSIBLE_PRIORITY].pop();
+      if (!queues_[SUPPRESSIBLE_PRIORITY].empty())
+        ScheduleSuppressedPump();
+    }
+    task.Run();
+  }
+
+  scoped_refptr<base::SingleThreadTaskRunner> main_task_runner_;
+
+  base::Lock lock_;
+  std::queue<base::Closure> queues_[PRIORITY_COUNT];
+  bool renderer_hidden_;
+  bool suppressed_pump_scheduled_;
+
+  DISALLOW_COPY_AND_ASSIGN(Inner);
+};
+
+class RendererScheduler::TaskQueue : public base::SingleThreadTaskRunner {
+ public:
+  TaskQueue(const scoped_refptr<Inner>& inner, QueuePriority priority)
+      : inner_(inner), priority_(priority) {}
+
+  // base::SingleThreadTaskRunner implementation:
+  virtual bool PostDelayedTask(const tracked_objects::Location& from_here,
+                               const base::Closure& task,
+                               base::TimeDelta delay) OVERRIDE {
+    return inner_->PostTask(from_here, task, delay, priority_);
+  }
+
+  virtual bool PostNonNestableDelayedTask(
+      const tracked_objects::Location& from_here,
+      const base::Closure& task,
+      base::TimeDelta delay) OVERRIDE {
+    // All queued tasks run non-nested; see Inner::PostTask.
+    return inner_->PostTask(from_here, task, delay, priority_);
+  }
+
+  virtual bool RunsTasksOnCurrentThread() const OVERRIDE {
+    return inner_->RunsTasksOnCurrentThread();
+  }
+
+ private:
+  virtual ~TaskQueue() {}
+
+  scoped_refptr<Inner> inner_;
+  QueuePriority priority_;
+
+  DISALLOW_COPY_AND_ASSIGN(TaskQueue);
+};
+
+RendererScheduler::RendererScheduler()
+    : inner_(new Inner(base::MessageLoopProxy::current())) {
+  input_task_runner_ = new TaskQueue(inner_, INPUT_PRIORITY);
+  default_task_runner_ = new TaskQueue(inner_, DEFAULT_PRIORITY);
+  suppressible_task_runner_ = new TaskQueue(inner_, SUPPRESSIBLE_PRIORITY);
+}
+
+RendererScheduler::~RendererScheduler() {
+  DCHECK(thread_checker_.CalledOnValidThread());
+}
+
+scoped_refptr<base::SingleThreadTaskRunner>
+RendererScheduler::InputTaskRunner() {
+  return input_task_runner_;
+}
+
+scoped_refptr<base::SingleThreadTaskRunner>
+RendererScheduler::DefaultTaskRunner() {
+  return default_task_runner_;
+}
+
+scoped_refptr<base::SingleThreadTaskRunner>
+RendererScheduler::SuppressibleTaskRunner() {
+  return suppressible_task_runner_;
+}
+
+void RendererScheduler::SetRendererHidden(bool hidden) {
+  inner_->SetRendererHidden(hidden);
+}
+
+}  // namespace content
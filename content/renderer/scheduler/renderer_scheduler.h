@@ -0,0 +1,78 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CONTENT_RENDERER_SCHEDULER_RENDERER_SCHEDULER_H_
+#define CONTENT_RENDERER_SCHEDULER_RENDERER_SCHEDULER_H_
+
+#include <queue>
+
+#include "base/callback.h"
+#include "base/memory/ref_counted.h"
+#include "base/single_thread_task_runner.h"
+#include "base/synchronization/lock.h"
+#include "base/threading/thread_checker.h"
+#include "content/common/content_export.h"
+
+namespace content {
+
+// Multiplexes prioritized task queues onto the renderer main thread.
+//
+// base::MessageLoop services its queue strictly in FIFO order, so input
+// dispatched to the main thread has to wait behind whatever page work was
+// posted before it. RendererScheduler keeps one queue per priority level
+// and pumps the underlying loop with one DoWork callback per posted task;
+// each DoWork runs the oldest task from the highest-priority queue that is
+// not empty. Input tasks therefore overtake default-priority tasks that
+// are still queued, while tasks within a queue keep their posting order.
+//
+// The scheduler must be created on the thread it schedules (the renderer
+// main thread). The returned task runners are thread safe and may outlive
+// the scheduler; tasks still queued when the underlying message loop shuts
+// down are dropped, just as they would be with a plain PostTask.
+class CONTENT_EXPORT RendererScheduler {
+ public:
+  enum QueuePriority {
+    INPUT_PRIORITY,
+    DEFAULT_PRIORITY,
+    SUPPRESSIBLE_PRIORITY,
+    PRIORITY_COUNT
+  };
+
+  RendererScheduler();
+  ~RendererScheduler();
+
+  // Returns the task runner for input event dispatch on the main thread.
+  scoped_refptr<base::SingleThreadTaskRunner> InputTaskRunner();
+
+  // Returns the task runner for all other main thread work.
+  scoped_refptr<base::SingleThreadTaskRunner> DefaultTaskRunner();
+
+  // Returns the task runner for work that may be suppressed while the
+  // renderer is hidden, e.g. page timers and other periodic housekeeping.
+  scoped_refptr<base::SingleThreadTaskRunner> SuppressibleTaskRunner();
+
+  // Called when the renderer transitions between all widgets hidden and at
+  // least one widget visible. While hidden, tasks posted to
+  // SuppressibleTaskRunner() are run at most once per second; any backlog
+  // runs, in posting order, once the renderer is restored. May be called
+  // from any thread.
+  void SetRendererHidden(bool hidden);
+
+ private:
+  class Inner;
+  class TaskQueue;
+
+  scoped_refptr<Inner> inner_;
+  scoped_refptr<base::SingleThreadTaskRunner> input_task_runner_;
+  scoped_refptr<base::SingleThreadTaskRunner> default_task_runner_;
+  scoped_refptr<base::SingleThreadTaskRunner> suppressible_task_runner_;
+
+  base::ThreadChecker thread_checker_;
+
+  DISALLOW_COPY_AND_ASSIGN(RendererScheduler);
+};
+
+}  // namespace content
+
+#endif  // CONTENT_RENDERER_SCHEDULER_RENDERER_SCHEDULER_H_
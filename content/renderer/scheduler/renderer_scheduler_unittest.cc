@@ -0,0 +1,119 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "content/renderer/scheduler/renderer_scheduler.h"
+
+#include <vector>
+
+#include "base/bind.h"
+#include "base/message_loop/message_loop.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace content {
+namespace {
+
+void AppendToOrder(std::vector<int>* run_order, int task_id) {
+  run_order->push_back(task_id);
+}
+
+TEST(RendererSchedulerTest, InputTasksRunBeforeQueuedDefaultTasks) {
+  base::MessageLoop message_loop;
+  RendererScheduler scheduler;
+
+  std::vector<int> run_order;
+  scheduler.DefaultTaskRunner()->PostTask(
+      FROM_HERE, base::Bind(&AppendToOrder, &run_order, 1));
+  scheduler.DefaultTaskRunner()->PostTask(
+      FROM_HERE, base::Bind(&AppendToOrder, &run_order, 2));
+  scheduler.InputTaskRunner()->PostTask(
+      FROM_HERE, base::Bind(&AppendToOrder, &run_order, 3));
+
+  message_loop.RunUntilIdle();
+
+  // The input task was posted last but overtakes the queued default tasks.
+  ASSERT_EQ(3u, run_order.size());
+  EXPECT_EQ(3, run_order[0]);
+  EXPECT_EQ(1, run_order[1]);
+  EXPECT_EQ(2, run_order[2]);
+}
+
+TEST(RendererSchedulerTest, TasksWithinQueueKeepPostingOrder) {
+  base::MessageLoop message_loop;
+  RendererScheduler scheduler;
+
+  std::vector<int> run_order;
+  for (int i = 0; i < 4; ++i) {
+    scheduler.DefaultTaskRunner()->PostTask(
+        FROM_HERE, base::Bind(&AppendToOrder, &run_order, i));
+  }
+
+  message_loop.RunUntilIdle();
+
+  ASSERT_EQ(4u, run_order.size());
+  for (int i = 0; i < 4; ++i)
+    EXPECT_EQ(i, run_order[i]);
+}
+
+TEST(RendererSchedulerTest, SuppressibleTasksHeldWhileRendererHidden) {
+  base::MessageLoop message_loop;
+  RendererScheduler scheduler;
+
+  scheduler.SetRendererHidden(true);
+  std::vector<int> run_order;
+  scheduler.SuppressibleTaskRunner()->PostTask(
+      FROM_HERE, base::Bind(&AppendToOrder, &run_order, 1));
+  scheduler.SuppressibleTaskRunner()->PostTask(
+      FROM_HERE, base::Bind(&AppendToOrder, &run_order, 2));
+  scheduler.DefaultTaskRunner()->PostTask(
+      FROM_HERE, base::Bind(&AppendToOrder, &run_order, 3));
+
+  // Only the default task runs; the suppressible tasks wait for the delayed
+  // pump, which RunUntilIdle does not reach.
+  message_loop.RunUntilIdle();
+  ASSERT_EQ(1u, run_order.size());
+  EXPECT_EQ(3, run_order[0]);
+
+  // Restoring the renderer releases the backlog in posting order.
+  scheduler.SetRendererHidden(false);
+  message_loop.RunUntilIdle();
+  ASSERT_EQ(3u, run_order.size());
+  EXPECT_EQ(1, run_order[1]);
+  EXPECT_EQ(2, run_order[2]);
+}
+
+TEST(RendererSchedulerTest, SuppressibleTasksRunNormallyWhenVisible) {
+  base::MessageLoop message_loop;
+  RendererScheduler scheduler;
+
+  std::vector<int> run_order;
+  scheduler.SuppressibleTaskRunner()->PostTask(
+      FROM_HERE, base::Bind(&AppendToOrder, &run_order, 1));
+  scheduler.SuppressibleTaskRunner()->PostTask(
+      FROM_HERE, base::Bind(&AppendToOrder, &run_order, 2));
+
+  message_loop.RunUntilIdle();
+  ASSERT_EQ(2u, run_order.size());
+  EXPECT_EQ(1, run_order[0]);
+  EXPECT_EQ(2, run_order[1]);
+}
+
+TEST(RendererSchedulerTest, RunnersUsableAfterSchedulerDestroyed) {
+  base::MessageLoop message_loop;
+  scoped_refptr<base::SingleThreadTaskRunner> default_runner;
+  {
+    RendererScheduler scheduler;
+    default_runner = scheduler.DefaultTaskRunner();
+  }
+
+  std::vector<int> run_order;
+  default_runner->PostTask(FROM_HERE,
+                           base::Bind(&AppendToOrder, &run_order, 1));
+  message_loop.RunUntilIdle();
+
+  ASSERT_EQ(1u, run_order.size());
+  EXPECT_EQ(1, run_order[0]);
+}
+
+}  // namespace
+}  // namespace content
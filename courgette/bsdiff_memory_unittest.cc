@@ -4,8 +4,12 @@
 
 #include "courgette/third_party/bsdiff.h"
 
+#include "base/file_util.h"
+#include "base/files/file.h"
+#include "base/files/scoped_temp_dir.h"
 #include "courgette/base_test_unittest.h"
 #include "courgette/courgette.h"
+#include "courgette/crc.h"
 #include "courgette/streams.h"
 
 class BSDiffMemoryTest : public BaseTest {
@@ -36,6 +40,33 @@ void BSDiffMemoryTest::GenerateAndTestPatch(const std::string& old_text,
   EXPECT_EQ(courgette::OK, status);
   EXPECT_EQ(new_text.length(), new2.Length());
   EXPECT_EQ(0, memcmp(new_text.c_str(), new2.Buffer(), new_text.length()));
+
+  // Streaming the output to a file must produce identical bytes and report
+  // the matching CRC.
+  courgette::SourceStream old3;
+  courgette::SourceStream patch3;
+  old3.Init(old_text.c_str(), old_text.length());
+  patch3.Init(patch1);
+
+  base::ScopedTempDir temp_dir;
+  EXPECT_TRUE(temp_dir.CreateUniqueTempDir());
+  base::FilePath new_path = temp_dir.path().AppendASCII("new");
+  base::File new_file(new_path,
+                      base::File::FLAG_CREATE_ALWAYS | base::File::FLAG_WRITE);
+  EXPECT_TRUE(new_file.IsValid());
+
+  uint32 new_crc = 0;
+  status = ApplyBinaryPatchToFile(&old3, &patch3, &new_file, &new_crc);
+  EXPECT_EQ(courgette::OK, status);
+  new_file.Close();
+
+  std::string new_contents;
+  EXPECT_TRUE(base::ReadFileToString(new_path, &new_contents));
+  EXPECT_EQ(new_text, new_contents);
+  EXPECT_EQ(courgette::CalculateCrc(
+                reinterpret_cast<const uint8*>(new_text.c_str()),
+                new_text.length()),
+            new_crc);
 }
 
 std::string BSDiffMemoryTest::GenerateSyntheticInput(size_t length, int seed)
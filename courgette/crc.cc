@@ -31,4 +31,29 @@ uint32 CalculateCrc(const uint8* buffer, size_t size) {
   return ~crc;
 }
 
+uint32 CrcInitialValue() {
+#ifdef COURGETTE_USE_CRC_LIB
+  return crc32(0, Z_NULL, 0);
+#else
+  CrcGenerateTable();
+  return CRC_INIT_VAL;
+#endif
+}
+
+uint32 UpdateCrc(uint32 partial_crc, const uint8* buffer, size_t size) {
+#ifdef COURGETTE_USE_CRC_LIB
+  return crc32(partial_crc, buffer, size);
+#else
+  return CrcUpdate(partial_crc, buffer, size);
+#endif
+}
+
+uint32 FinalizeCrc(uint32 partial_crc) {
+#ifdef COURGETTE_USE_CRC_LIB
+  return ~partial_crc;
+#else
+  return ~CRC_GET_DIGEST(partial_crc);
+#endif
+}
+
 }  // namespace
@@ -13,5 +13,13 @@ namespace courgette {
 //
 uint32 CalculateCrc(const uint8* buffer, size_t size);
 
+// Incremental version of CalculateCrc for data that is not available as a
+// single contiguous buffer.  Start with CrcInitialValue(), fold in each chunk
+// with UpdateCrc(), and pass the accumulated value to FinalizeCrc().  The
+// result equals CalculateCrc() over the concatenation of the chunks.
+uint32 CrcInitialValue();
+uint32 UpdateCrc(uint32 partial_crc, const uint8* buffer, size_t size);
+uint32 FinalizeCrc(uint32 partial_crc);
+
 }  // namespace courgette
 #endif  // COURGETTE_CRC_H_
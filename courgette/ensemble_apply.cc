@@ -8,6 +8,7 @@
 
 #include "base/basictypes.h"
 #include "base/file_util.h"
+#include "base/files/file.h"
 #include "base/files/memory_mapped_file.h"
 #include "base/logging.h"
 #include "courgette/crc.h"
@@ -53,6 +54,13 @@ class EnsemblePatchApplication {
                              SourceStream* correction,
                              SinkStream* corrected_ensemble);
 
+  // As SubpatchFinalOutput, but streams the corrected ensemble to
+  // |corrected_ensemble_file| through a fixed-size window, so the new image
+  // never has to be memory-resident in full.
+  Status SubpatchFinalOutputToFile(SourceStream* original,
+                                   SourceStream* correction,
+                                   base::File* corrected_ensemble_file);
+
  private:
   Status SubpatchStreamSets(SinkStreamSet* predicted_items,
                             SourceStream* correction,
@@ -279,6 +287,23 @@ Status EnsemblePatchApplication::SubpatchFinalOutput(
   return C_OK;
 }
 
+Status EnsemblePatchApplication::SubpatchFinalOutputToFile(
+    SourceStream* original,
+    SourceStream* correction,
+    base::File* corrected_ensemble_file) {
+  uint32 output_crc = 0;
+  Status delta_status = ApplySimpleDeltaToFile(original, correction,
+                                               corrected_ensemble_file,
+                                               &output_crc);
+  if (delta_status != C_OK)
+    return delta_status;
+
+  if (output_crc != target_checksum_)
+    return C_BAD_ENSEMBLE_CRC;
+
+  return C_OK;
+}
+
 Status EnsemblePatchApplication::SubpatchStreamSets(
     SinkStreamSet* predicted_items,
     SourceStream* correction,
@@ -304,78 +329,89 @@ Status EnsemblePatchApplication::SubpatchStreamSets(
   return C_OK;
 }
 
-Status ApplyEnsemblePatch(SourceStream* base,
-                          SourceStream* patch,
-                          SinkStream* output) {
-  Status status;
-  EnsemblePatchApplication patch_process;
+namespace {
 
-  status = patch_process.ReadHeader(patch);
+// Runs the patch pipeline through TransformDown.  On success |prediction|
+// holds the original ensemble and corrected base elements - the prediction
+// for the final subpatch - and |patch_streams| holds the patch's stream set.
+// The caller finishes by subpatching |prediction| against stream 3 of
+// |patch_streams|.
+Status PredictFinalOutput(EnsemblePatchApplication* patch_process,
+                          SourceStream* base,
+                          SourceStream* patch,
+                          SourceStreamSet* patch_streams,
+                          SinkStream* prediction) {
+  Status status = patch_process->ReadHeader(patch);
   if (status != C_OK)
     return status;
 
-  status = patch_process.InitBase(Region(base->Buffer(), base->Remaining()));
+  status = patch_process->InitBase(Region(base->Buffer(), base->Remaining()));
   if (status != C_OK)
     return status;
 
-  status = patch_process.ValidateBase();
+  status = patch_process->ValidateBase();
   if (status != C_OK)
     return status;
 
   // The rest of the patch stream is a StreamSet.
-  SourceStreamSet patch_streams;
-  patch_streams.Init(patch);
+  patch_streams->Init(patch);
 
-  SourceStream* transformation_descriptions     = patch_streams.stream(0);
-  SourceStream* parameter_correction            = patch_streams.stream(1);
-  SourceStream* transformed_elements_correction = patch_streams.stream(2);
-  SourceStream* ensemble_correction             = patch_streams.stream(3);
+  SourceStream* transformation_descriptions     = patch_streams->stream(0);
+  SourceStream* parameter_correction            = patch_streams->stream(1);
+  SourceStream* transformed_elements_correction = patch_streams->stream(2);
 
-  status = patch_process.ReadInitialParameters(transformation_descriptions);
+  status = patch_process->ReadInitialParameters(transformation_descriptions);
   if (status != C_OK)
     return status;
 
   SinkStreamSet predicted_parameters;
-  status = patch_process.PredictTransformParameters(&predicted_parameters);
+  status = patch_process->PredictTransformParameters(&predicted_parameters);
   if (status != C_OK)
     return status;
 
   SourceStreamSet corrected_parameters;
-  status = patch_process.SubpatchTransformParameters(&predicted_parameters,
-                                                     parameter_correction,
-                                                     &corrected_parameters);
+  status = patch_process->SubpatchTransformParameters(&predicted_parameters,
+                                                      parameter_correction,
+                                                      &corrected_parameters);
   if (status != C_OK)
     return status;
 
   SinkStreamSet transformed_elements;
-  status = patch_process.TransformUp(&corrected_parameters,
-                                     &transformed_elements);
+  status = patch_process->TransformUp(&corrected_parameters,
+                                      &transformed_elements);
   if (status != C_OK)
     return status;
 
   SourceStreamSet corrected_transformed_elements;
-  status = patch_process.SubpatchTransformedElements(
+  status = patch_process->SubpatchTransformedElements(
           &transformed_elements,
           transformed_elements_correction,
           &corrected_transformed_elements);
   if (status != C_OK)
     return status;
 
+  return patch_process->TransformDown(&corrected_transformed_elements,
+                                      prediction);
+}
+
+}  // namespace
+
+Status ApplyEnsemblePatch(SourceStream* base,
+                          SourceStream* patch,
+                          SinkStream* output) {
+  EnsemblePatchApplication patch_process;
+  SourceStreamSet patch_streams;
   SinkStream original_ensemble_and_corrected_base_elements;
-  status = patch_process.TransformDown(
-      &corrected_transformed_elements,
+  Status status = PredictFinalOutput(
+      &patch_process, base, patch, &patch_streams,
       &original_ensemble_and_corrected_base_elements);
   if (status != C_OK)
     return status;
 
   SourceStream final_patch_prediction;
   final_patch_prediction.Init(original_ensemble_and_corrected_base_elements);
-  status = patch_process.SubpatchFinalOutput(&final_patch_prediction,
-                                             ensemble_correction, output);
-  if (status != C_OK)
-    return status;
-
-  return C_OK;
+  return patch_process.SubpatchFinalOutput(&final_patch_prediction,
+                                           patch_streams.stream(3), output);
 }
 
 Status ApplyEnsemblePatch(const base::FilePath::CharType* old_file_name,
@@ -402,28 +438,41 @@ Status ApplyEnsemblePatch(const base::FilePath::CharType* old_file_name,
   if (!old_file.Initialize(old_file_path))
     return C_READ_ERROR;
 
-  // Apply patch on streams.
+  // Apply the patch, streaming the new file to disk as the final subpatch
+  // produces it, so the new image is never held in memory in full.  The
+  // prediction for the final subpatch stays memory-resident because the delta
+  // is applied with random access to it; its storage falls back to
+  // MemoryAllocator's temporary-file paging when the heap cannot satisfy it.
   SourceStream old_source_stream;
   SourceStream patch_source_stream;
   old_source_stream.Init(old_file.data(), old_file.length());
   patch_source_stream.Init(patch_file.data(), patch_file.length());
-  SinkStream new_sink_stream;
-  status = ApplyEnsemblePatch(&old_source_stream, &patch_source_stream,
-                              &new_sink_stream);
+
+  EnsemblePatchApplication patch_application;
+  SourceStreamSet patch_streams;
+  SinkStream prediction;
+  status = PredictFinalOutput(&patch_application, &old_source_stream,
+                              &patch_source_stream, &patch_streams,
+                              &prediction);
   if (status != C_OK)
     return status;
 
-  // Write the patched data to |new_file_name|.
   base::FilePath new_file_path(new_file_name);
-  int written =
-      base::WriteFile(
-          new_file_path,
-          reinterpret_cast<const char*>(new_sink_stream.Buffer()),
-          static_cast<int>(new_sink_stream.Length()));
-  if (written == -1)
+  base::File new_file(new_file_path,
+                      base::File::FLAG_CREATE_ALWAYS | base::File::FLAG_WRITE);
+  if (!new_file.IsValid())
     return C_WRITE_OPEN_ERROR;
-  if (static_cast<size_t>(written) != new_sink_stream.Length())
-    return C_WRITE_ERROR;
+
+  SourceStream final_patch_prediction;
+  final_patch_prediction.Init(prediction);
+  status = patch_application.SubpatchFinalOutputToFile(
+      &final_patch_prediction, patch_streams.stream(3), &new_file);
+  if (status != C_OK) {
+    // The new file may contain partial output; do not leave it behind.
+    new_file.Close();
+    base::DeleteFile(new_file_path, false);
+    return status;
+  }
 
   return C_OK;
 }
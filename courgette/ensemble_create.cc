@@ -14,11 +14,21 @@
 
 #include "courgette/ensemble.h"
 
+#include <algorithm>
 #include <limits>
 #include <vector>
 
+#include "base/atomic_ref_count.h"
+#include "base/atomic_sequence_num.h"
 #include "base/basictypes.h"
+#include "base/bind.h"
+#include "base/callback.h"
+#include "base/location.h"
 #include "base/logging.h"
+#include "base/memory/scoped_vector.h"
+#include "base/synchronization/waitable_event.h"
+#include "base/sys_info.h"
+#include "base/threading/worker_pool.h"
 #include "base/time/time.h"
 
 #include "courgette/crc.h"
@@ -33,6 +43,93 @@
 
 namespace courgette {
 
+namespace {
+
+// Bookkeeping for RunTasksInParallel.  Runners claim task indices until every
+// task has been claimed; the last runner to finish signals |done|.
+struct ParallelTaskList {
+  explicit ParallelTaskList(const std::vector<base::Closure>* task_list)
+      : tasks(task_list),
+        size(static_cast<int>(task_list->size())),
+        active_runners(1),  // The calling thread.
+        done(true, false) {}
+
+  const std::vector<base::Closure>* tasks;
+  const int size;
+  base::AtomicSequenceNumber next_index;
+  base::AtomicRefCount active_runners;
+  base::WaitableEvent done;
+};
+
+// Runs tasks from |list| until none are left unclaimed.  The runner that
+// finishes last signals |list->done| and must not touch |list| afterwards:
+// the waiting thread is then free to destroy it.
+void RunClaimedTasks(ParallelTaskList* list) {
+  for (;;) {
+    int index = list->next_index.GetNext();
+    if (index >= list->size)
+      break;
+    (*list->tasks)[index].Run();
+  }
+  if (!base::AtomicRefCountDec(&list->active_runners))
+    list->done.Signal();
+}
+
+// Runs |tasks| concurrently on worker pool threads and the calling thread,
+// returning once all of them have completed.  The tasks must be independent
+// of each other; for deterministic output each task should write only to
+// result slots of its own.
+void RunTasksInParallel(const std::vector<base::Closure>& tasks) {
+  if (tasks.empty())
+    return;
+
+  ParallelTaskList list(&tasks);
+  int extra_runners = std::min(static_cast<int>(tasks.size()),
+                               base::SysInfo::NumberOfProcessors()) - 1;
+  for (int i = 0;  i < extra_runners;  ++i) {
+    base::AtomicRefCountInc(&list.active_runners);
+    if (!base::WorkerPool::PostTask(FROM_HERE,
+                                    base::Bind(&RunClaimedTasks, &list),
+                                    true)) {
+      // The calling thread will run any tasks this runner would have claimed.
+      base::AtomicRefCountDec(&list.active_runners);
+      break;
+    }
+  }
+
+  RunClaimedTasks(&list);
+  list.done.Wait();
+}
+
+// The tasks run by the parallel sections below.  Each writes only through
+// pointers that no other task holds.
+
+void MeasureTask(DifferenceEstimator* difference_estimator,
+                 DifferenceEstimator::Base* old_base,
+                 DifferenceEstimator::Subject* new_subject,
+                 size_t* difference) {
+  *difference = difference_estimator->Measure(old_base, new_subject);
+}
+
+void TransformTask(TransformationPatchGenerator* generator,
+                   SourceStreamSet* parameters,
+                   SinkStreamSet* predicted_transformed_element,
+                   SinkStreamSet* corrected_transformed_element,
+                   Status* status) {
+  *status = generator->Transform(parameters,
+                                 predicted_transformed_element,
+                                 corrected_transformed_element);
+}
+
+void ReformTask(TransformationPatchGenerator* generator,
+                SourceStreamSet* transformed_element,
+                SinkStream* reformed_element,
+                Status* status) {
+  *status = generator->Reform(transformed_element, reformed_element);
+}
+
+}  // namespace
+
 TransformationPatchGenerator::TransformationPatchGenerator(
     Element* old_element,
     Element* new_element,
@@ -164,42 +261,72 @@ Status FindGenerators(Ensemble* old_ensemble, Ensemble* new_ensemble,
   VLOG(1) << "done make bases "
           << (base::Time::Now() - start_bases_time).InSecondsF() << "s";
 
+  // Measure all candidate (old, new) pairs concurrently.  Measure only reads
+  // the precomputed bases and subjects, so the comparisons are independent.
+  //
+  // TODO(sra): This is O(N x M), i.e. O(N^2) since old_ensemble and
+  // new_ensemble probably have a very similar structure.  We can make the
+  // search faster by making the comparison provided by DifferenceEstimator
+  // more nuanced, returning early if the measured difference is greater than
+  // the current best.  This will be most effective if we can arrange that the
+  // first elements we try to match are likely the 'right' ones.  We could
+  // prioritize elements that are of a similar size or similar position in the
+  // sequence of elements.
+  //
+  size_t old_count = old_elements.size();
+  std::vector<DifferenceEstimator::Subject*> new_subjects;
+  for (size_t new_index = 0;  new_index < new_elements.size();  ++new_index) {
+    new_subjects.push_back(
+        difference_estimator.MakeSubject(new_elements[new_index]->region()));
+  }
+
+  std::vector<size_t> differences(old_count * new_elements.size(), 0);
+  std::vector<base::Closure> measure_tasks;
+  for (size_t new_index = 0;  new_index < new_elements.size();  ++new_index) {
+    Element* new_element = new_elements[new_index];
+    for (size_t old_index = 0;  old_index < old_count;  ++old_index) {
+      Element* old_element = old_elements[old_index];
+      // Elements of different kinds are incompatible.
+      if (old_element->kind() != new_element->kind())
+        continue;
+
+      if (UnsafeDifference(old_element, new_element))
+        continue;
+
+      measure_tasks.push_back(
+          base::Bind(&MeasureTask,
+                     &difference_estimator,
+                     bases[old_index],
+                     new_subjects[new_index],
+                     &differences[new_index * old_count + old_index]));
+    }
+  }
+
+  base::Time start_compare_time = base::Time::Now();
+  RunTasksInParallel(measure_tasks);
+  VLOG(1) << "done measure " << measure_tasks.size() << " pairs in "
+          << (base::Time::Now() - start_compare_time).InSecondsF() << "s";
+
+  // Pick matches from the measurements.  This scans the pairs in the same
+  // order as a sequential search, so the generators - and hence the patch -
+  // do not depend on how the measurements were scheduled.
   for (size_t new_index = 0;  new_index < new_elements.size();  ++new_index) {
     Element* new_element = new_elements[new_index];
-    DifferenceEstimator::Subject* new_subject =
-        difference_estimator.MakeSubject(new_element->region());
-
-    // Search through old elements to find the best match.
-    //
-    // TODO(sra): This is O(N x M), i.e. O(N^2) since old_ensemble and
-    // new_ensemble probably have a very similar structure.  We can make the
-    // search faster by making the comparison provided by DifferenceEstimator
-    // more nuanced, returning early if the measured difference is greater than
-    // the current best.  This will be most effective if we can arrange that the
-    // first elements we try to match are likely the 'right' ones.  We could
-    // prioritize elements that are of a similar size or similar position in the
-    // sequence of elements.
-    //
     Element* best_old_element = NULL;
     size_t best_difference = std::numeric_limits<size_t>::max();
-    for (size_t old_index = 0;  old_index < old_elements.size();  ++old_index) {
+    for (size_t old_index = 0;  old_index < old_count;  ++old_index) {
       Element* old_element = old_elements[old_index];
-      // Elements of different kinds are incompatible.
       if (old_element->kind() != new_element->kind())
         continue;
 
       if (UnsafeDifference(old_element, new_element))
         continue;
 
-      base::Time start_compare = base::Time::Now();
-      DifferenceEstimator::Base* old_base = bases[old_index];
-      size_t difference = difference_estimator.Measure(old_base, new_subject);
+      size_t difference = differences[new_index * old_count + old_index];
 
       VLOG(1) << "Compare " << old_element->Name()
               << " to " << new_element->Name()
-              << " --> " << difference
-              << " in " << (base::Time::Now() - start_compare).InSecondsF()
-              << "s";
+              << " --> " << difference;
       if (difference == 0) {
         VLOG(1) << "Skip " << new_element->Name()
                 << " - identical to " << old_element->Name();
@@ -325,41 +452,59 @@ Status GenerateEnsemblePatch(SourceStream* base,
     return delta1_status;
 
   //
-  // Generate sub-patch for elements.
+  // Generate sub-patch for elements.  The transforms - disassembly and label
+  // adjustment - dominate generation time and are independent per element, so
+  // they run concurrently.  The results are serialized in element order
+  // below, which keeps the patch deterministic.
   //
   corrected_parameters_source.Init(linearized_corrected_parameters);
   SourceStreamSet corrected_parameters_source_set;
   if (!corrected_parameters_source_set.Init(&corrected_parameters_source))
     return C_STREAM_ERROR;
 
+  ScopedVector<SourceStreamSet> all_parameters;
+  ScopedVector<SinkStreamSet> all_predicted_transformed_elements;
+  ScopedVector<SinkStreamSet> all_corrected_transformed_elements;
+  std::vector<Status> transform_statuses(number_of_transformations, C_OK);
+  std::vector<base::Closure> transform_tasks;
+
+  for (size_t i = 0;  i < number_of_transformations;  ++i) {
+    SourceStreamSet* single_parameters = new SourceStreamSet();
+    all_parameters.push_back(single_parameters);
+    if (!corrected_parameters_source_set.ReadSet(single_parameters))
+      return C_STREAM_ERROR;
+    all_predicted_transformed_elements.push_back(new SinkStreamSet());
+    all_corrected_transformed_elements.push_back(new SinkStreamSet());
+    transform_tasks.push_back(
+        base::Bind(&TransformTask,
+                   generators[i],
+                   single_parameters,
+                   all_predicted_transformed_elements[i],
+                   all_corrected_transformed_elements[i],
+                   &transform_statuses[i]));
+  }
+
+  if (!corrected_parameters_source_set.Empty())
+    return C_STREAM_NOT_CONSUMED;
+
+  RunTasksInParallel(transform_tasks);
+
   SinkStreamSet predicted_transformed_elements;
   SinkStreamSet corrected_transformed_elements;
 
   for (size_t i = 0;  i < number_of_transformations;  ++i) {
-    SourceStreamSet single_parameters;
-    if (!corrected_parameters_source_set.ReadSet(&single_parameters))
-      return C_STREAM_ERROR;
-    SinkStreamSet single_predicted_transformed_element;
-    SinkStreamSet single_corrected_transformed_element;
-    Status status = generators[i]->Transform(
-        &single_parameters,
-        &single_predicted_transformed_element,
-        &single_corrected_transformed_element);
-    if (status != C_OK)
-      return status;
-    if (!single_parameters.Empty())
+    if (transform_statuses[i] != C_OK)
+      return transform_statuses[i];
+    if (!all_parameters[i]->Empty())
       return C_STREAM_NOT_CONSUMED;
     if (!predicted_transformed_elements.WriteSet(
-            &single_predicted_transformed_element))
+            all_predicted_transformed_elements[i]))
       return C_STREAM_ERROR;
     if (!corrected_transformed_elements.WriteSet(
-            &single_corrected_transformed_element))
+            all_corrected_transformed_elements[i]))
       return C_STREAM_ERROR;
   }
 
-  if (!corrected_parameters_source_set.Empty())
-    return C_STREAM_NOT_CONSUMED;
-
   SinkStream linearized_predicted_transformed_elements;
   SinkStream linearized_corrected_transformed_elements;
 
@@ -402,22 +547,43 @@ Status GenerateEnsemblePatch(SourceStream* base,
       .Init(&corrected_transformed_elements_source))
     return C_STREAM_ERROR;
 
+  // Reform the elements concurrently into per-element streams, which are
+  // appended to the predicted ensemble in element order below.
+  ScopedVector<SourceStreamSet> reform_inputs;
+  ScopedVector<SinkStream> reformed_elements;
+  std::vector<Status> reform_statuses(number_of_transformations, C_OK);
+  std::vector<base::Closure> reform_tasks;
+
   for (size_t i = 0;  i < number_of_transformations;  ++i) {
-    SourceStreamSet single_corrected_transformed_element;
+    SourceStreamSet* single_corrected_transformed_element =
+        new SourceStreamSet();
+    reform_inputs.push_back(single_corrected_transformed_element);
     if (!corrected_transformed_elements_source_set.ReadSet(
-            &single_corrected_transformed_element))
+            single_corrected_transformed_element))
       return C_STREAM_ERROR;
-    Status status = generators[i]->Reform(&single_corrected_transformed_element,
-                                          &predicted_ensemble);
-    if (status != C_OK)
-      return status;
-    if (!single_corrected_transformed_element.Empty())
-      return C_STREAM_NOT_CONSUMED;
+    reformed_elements.push_back(new SinkStream());
+    reform_tasks.push_back(
+        base::Bind(&ReformTask,
+                   generators[i],
+                   single_corrected_transformed_element,
+                   reformed_elements[i],
+                   &reform_statuses[i]));
   }
 
   if (!corrected_transformed_elements_source_set.Empty())
     return C_STREAM_NOT_CONSUMED;
 
+  RunTasksInParallel(reform_tasks);
+
+  for (size_t i = 0;  i < number_of_transformations;  ++i) {
+    if (reform_statuses[i] != C_OK)
+      return reform_statuses[i];
+    if (!reform_inputs[i]->Empty())
+      return C_STREAM_NOT_CONSUMED;
+    if (!predicted_ensemble.Append(reformed_elements[i]))
+      return C_STREAM_ERROR;
+  }
+
   // No more references to this stream's buffer.
   linearized_corrected_transformed_elements.Retire();
 
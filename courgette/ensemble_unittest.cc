@@ -32,6 +32,22 @@ void EnsembleTest::TestEnsemble(std::string src_bytes,
   status = courgette::GenerateEnsemblePatch(&source, &target, &patch_sink);
   EXPECT_EQ(courgette::C_OK, status);
 
+  // Generating the patch again must produce identical bytes; the concurrent
+  // transforms serialize their results in element order.
+  courgette::SourceStream source2;
+  courgette::SourceStream target2;
+  source2.Init(src_bytes);
+  target2.Init(tgt_bytes);
+
+  courgette::SinkStream patch_sink2;
+  status = courgette::GenerateEnsemblePatch(&source2, &target2, &patch_sink2);
+  EXPECT_EQ(courgette::C_OK, status);
+
+  EXPECT_EQ(patch_sink.Length(), patch_sink2.Length());
+  EXPECT_FALSE(memcmp(patch_sink.Buffer(),
+                      patch_sink2.Buffer(),
+                      patch_sink.Length()));
+
   courgette::SourceStream patch_source;
   patch_source.Init(patch_sink.Buffer(), patch_sink.Length());
 
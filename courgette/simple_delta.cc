@@ -31,6 +31,12 @@ Status ApplySimpleDelta(SourceStream* old, SourceStream* delta,
   return BSDiffStatusToStatus(ApplyBinaryPatch(old, delta, target));
 }
 
+Status ApplySimpleDeltaToFile(SourceStream* old, SourceStream* delta,
+                              base::File* target_file, uint32* target_crc) {
+  return BSDiffStatusToStatus(
+      ApplyBinaryPatchToFile(old, delta, target_file, target_crc));
+}
+
 Status GenerateSimpleDelta(SourceStream* old, SourceStream* target,
                            SinkStream* delta) {
   VLOG(1) << "GenerateSimpleDelta " << old->Remaining()
@@ -10,11 +10,21 @@
 #include "courgette/courgette.h"
 #include "courgette/streams.h"
 
+namespace base {
+class File;
+}
+
 namespace courgette {
 
 Status ApplySimpleDelta(SourceStream* old, SourceStream* delta,
                         SinkStream* target);
 
+// As ApplySimpleDelta, but streams the output to |target_file| through a
+// fixed-size window, so peak memory use is independent of the output size.
+// On success |*target_crc| contains the CRC-32 of the bytes written.
+Status ApplySimpleDeltaToFile(SourceStream* old, SourceStream* delta,
+                              base::File* target_file, uint32* target_crc);
+
 Status GenerateSimpleDelta(SourceStream* old, SourceStream* target,
                            SinkStream* delta);
 
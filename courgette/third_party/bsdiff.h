@@ -40,6 +40,10 @@
 #include "base/basictypes.h"
 #include "base/file_util.h"
 
+namespace base {
+class File;
+}
+
 namespace courgette {
 
 enum BSDiffStatus {
@@ -68,6 +72,15 @@ BSDiffStatus ApplyBinaryPatch(SourceStream* old_stream,
                               SourceStream* patch_stream,
                               SinkStream* new_stream);
 
+// As above, but streams the new file to |new_file| through a fixed-size
+// window instead of accumulating it in a SinkStream, so peak memory use is
+// independent of the size of the new file.  On success |*new_file_crc|
+// contains the CRC-32 of the bytes written.
+BSDiffStatus ApplyBinaryPatchToFile(SourceStream* old_stream,
+                                    SourceStream* patch_stream,
+                                    base::File* new_file,
+                                    uint32* new_file_crc);
+
 // As above, but simply takes the file paths.
 BSDiffStatus ApplyBinaryPatch(const base::FilePath& old_stream,
                               const base::FilePath& patch_stream,
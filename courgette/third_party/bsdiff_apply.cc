@@ -36,12 +36,87 @@
 
 #include "courgette/third_party/bsdiff.h"
 
+#include <string.h>
+
+#include <algorithm>
+
+#include "base/files/file.h"
 #include "base/files/memory_mapped_file.h"
+#include "base/memory/scoped_ptr.h"
 #include "courgette/crc.h"
 #include "courgette/streams.h"
 
 namespace courgette {
 
+namespace {
+
+// Size of the buffer used when streaming the new file to disk.  Big enough to
+// keep the number of write system calls low, small compared to the files
+// being patched.
+const size_t kApplyWindowSize = 256 * 1024;  // 256KB
+
+// Sink for patch application output that appends to a file through a
+// fixed-size window, maintaining a running CRC-32 of everything written.
+// Implements the subset of the SinkStream interface used by
+// MBS_ApplyPatchToSink, so the new file never has to be memory-resident in
+// full.
+class WindowedFileSink {
+ public:
+  explicit WindowedFileSink(base::File* file)
+      : file_(file),
+        window_(new uint8[kApplyWindowSize]),
+        used_(0),
+        partial_crc_(CrcInitialValue()),
+        failed_(false) {
+  }
+
+  // The file grows as windows are flushed; there is nothing to reserve.
+  CheckBool Reserve(size_t /*length*/) { return true; }
+
+  CheckBool Write(const void* data, size_t byte_count) {
+    const uint8* source = static_cast<const uint8*>(data);
+    while (byte_count > 0) {
+      if (used_ == kApplyWindowSize && !FlushWindow())
+        return false;
+      size_t chunk = std::min(byte_count, kApplyWindowSize - used_);
+      memcpy(window_.get() + used_, source, chunk);
+      used_ += chunk;
+      source += chunk;
+      byte_count -= chunk;
+    }
+    return true;
+  }
+
+  // Writes out any buffered bytes.  Must be called before crc().
+  CheckBool Flush() { return used_ == 0 || FlushWindow(); }
+
+  // CRC-32 of all bytes written.  Valid only after a successful Flush().
+  uint32 crc() const { return FinalizeCrc(partial_crc_); }
+
+ private:
+  CheckBool FlushWindow() {
+    if (failed_)
+      return false;
+    partial_crc_ = UpdateCrc(partial_crc_, window_.get(), used_);
+    int byte_count = static_cast<int>(used_);
+    if (file_->WriteAtCurrentPos(reinterpret_cast<const char*>(window_.get()),
+                                 byte_count) != byte_count) {
+      failed_ = true;
+      return false;
+    }
+    used_ = 0;
+    return true;
+  }
+
+  base::File* file_;
+  scoped_ptr<uint8[]> window_;
+  size_t used_;
+  uint32 partial_crc_;
+  bool failed_;
+};
+
+}  // namespace
+
 BSDiffStatus MBS_ReadHeader(SourceStream* stream, MBSPatchHeader* header) {
   if (!stream->Read(header->tag, sizeof(header->tag))) return READ_ERROR;
   if (!stream->ReadVarint32(&header->slen)) return READ_ERROR;
@@ -57,10 +132,14 @@ BSDiffStatus MBS_ReadHeader(SourceStream* stream, MBSPatchHeader* header) {
   return OK;
 }
 
-BSDiffStatus MBS_ApplyPatch(const MBSPatchHeader *header,
-                            SourceStream* patch_stream,
-                            const uint8* old_start, size_t old_size,
-                            SinkStream* new_stream) {
+// The patch application loop, templated over the output sink so that the new
+// file can be built either in memory (SinkStream) or streamed to disk through
+// a fixed-size window (WindowedFileSink).
+template<class Sink>
+BSDiffStatus MBS_ApplyPatchToSink(const MBSPatchHeader *header,
+                                  SourceStream* patch_stream,
+                                  const uint8* old_start, size_t old_size,
+                                  Sink* new_stream) {
   const uint8* old_end = old_start + old_size;
 
   SourceStreamSet patch_streams;
@@ -151,6 +230,14 @@ BSDiffStatus MBS_ApplyPatch(const MBSPatchHeader *header,
   return OK;
 }
 
+BSDiffStatus MBS_ApplyPatch(const MBSPatchHeader *header,
+                            SourceStream* patch_stream,
+                            const uint8* old_start, size_t old_size,
+                            SinkStream* new_stream) {
+  return MBS_ApplyPatchToSink(header, patch_stream, old_start, old_size,
+                              new_stream);
+}
+
 BSDiffStatus ApplyBinaryPatch(SourceStream* old_stream,
                               SourceStream* patch_stream,
                               SinkStream* new_stream) {
@@ -171,6 +258,34 @@ BSDiffStatus ApplyBinaryPatch(SourceStream* old_stream,
   return OK;
 }
 
+BSDiffStatus ApplyBinaryPatchToFile(SourceStream* old_stream,
+                                    SourceStream* patch_stream,
+                                    base::File* new_file,
+                                    uint32* new_file_crc) {
+  MBSPatchHeader header;
+  BSDiffStatus ret = MBS_ReadHeader(patch_stream, &header);
+  if (ret != OK) return ret;
+
+  const uint8* old_start = old_stream->Buffer();
+  size_t old_size = old_stream->Remaining();
+
+  if (old_size != header.slen) return UNEXPECTED_ERROR;
+
+  if (CalculateCrc(old_start, old_size) != header.scrc32)
+    return CRC_ERROR;
+
+  WindowedFileSink sink(new_file);
+  ret = MBS_ApplyPatchToSink(&header, patch_stream, old_start, old_size,
+                             &sink);
+  if (ret != OK) return ret;
+
+  if (!sink.Flush())
+    return WRITE_ERROR;
+
+  *new_file_crc = sink.crc();
+  return OK;
+}
+
 BSDiffStatus ApplyBinaryPatch(const base::FilePath& old_file_path,
                               const base::FilePath& patch_file_path,
                               const base::FilePath& new_file_path) {
@@ -190,22 +305,23 @@ BSDiffStatus ApplyBinaryPatch(const base::FilePath& old_file_path,
   SourceStream patch_file_stream;
   patch_file_stream.Init(patch_file.data(), patch_file.length());
 
-  // Set up the new stream and apply the patch.
-  SinkStream new_sink_stream;
-  BSDiffStatus status = ApplyBinaryPatch(&old_file_stream,
-                                         &patch_file_stream,
-                                         &new_sink_stream);
+  // Apply the patch, streaming the new file to disk as it is produced.
+  base::File new_file(new_file_path,
+                      base::File::FLAG_CREATE_ALWAYS | base::File::FLAG_WRITE);
+  if (!new_file.IsValid())
+    return WRITE_ERROR;
+
+  uint32 new_file_crc;
+  BSDiffStatus status = ApplyBinaryPatchToFile(&old_file_stream,
+                                               &patch_file_stream,
+                                               &new_file,
+                                               &new_file_crc);
   if (status != OK) {
+    // The new file may contain partial output; do not leave it behind.
+    new_file.Close();
+    base::DeleteFile(new_file_path, false);
     return status;
   }
-
-  // Write the stream to disk.
-  int written = base::WriteFile(
-      new_file_path,
-      reinterpret_cast<const char*>(new_sink_stream.Buffer()),
-      static_cast<int>(new_sink_stream.Length()));
-  if (written != static_cast<int>(new_sink_stream.Length()))
-    return WRITE_ERROR;
   return OK;
 }
 
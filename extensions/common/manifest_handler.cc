@@ -8,6 +8,7 @@
 
 #include "base/logging.h"
 #include "base/stl_util.h"
+#include "base/values.h"
 #include "extensions/common/extension.h"
 #include "extensions/common/permissions/manifest_permission.h"
 #include "extensions/common/permissions/manifest_permission_set.h"
@@ -109,7 +110,8 @@ const std::vector<std::string> ManifestHandler::SingleKey(
   return std::vector<std::string>(1, key);
 }
 
-ManifestHandlerRegistry::ManifestHandlerRegistry() : is_finalized_(false) {
+ManifestHandlerRegistry::ManifestHandlerRegistry()
+    : lookup_tables_valid_(false), is_finalized_(false) {
 }
 
 ManifestHandlerRegistry::~ManifestHandlerRegistry() {
@@ -125,19 +127,34 @@ void ManifestHandlerRegistry::RegisterManifestHandler(
     const std::string& key, linked_ptr<ManifestHandler> handler) {
   CHECK(!is_finalized_);
   handlers_[key] = handler;
+  lookup_tables_valid_ = false;
 }
 
 bool ManifestHandlerRegistry::ParseExtension(Extension* extension,
                                              base::string16* error) {
+  EnsureLookupTables();
+
   std::map<int, ManifestHandler*> handlers_by_priority;
-  for (ManifestHandlerMap::iterator iter = handlers_.begin();
-       iter != handlers_.end(); ++iter) {
-    ManifestHandler* handler = iter->second.get();
-    if (extension->manifest()->HasPath(iter->first) ||
-        handler->AlwaysParseForType(extension->GetType())) {
+  const std::vector<ManifestHandler*>& always_parse =
+      always_parse_for_type_[extension->GetType()];
+  for (size_t i = 0; i < always_parse.size(); ++i)
+    handlers_by_priority[priority_map_[always_parse[i]]] = always_parse[i];
+
+  // Walk the keys present in the manifest and look up their handlers,
+  // rather than probing the manifest for every registered key.
+  for (base::DictionaryValue::Iterator iter(*extension->manifest()->value());
+       !iter.IsAtEnd(); iter.Advance()) {
+    std::pair<RootKeyMap::const_iterator, RootKeyMap::const_iterator> range =
+        root_key_map_.equal_range(iter.key());
+    for (RootKeyMap::const_iterator key_iter = range.first;
+         key_iter != range.second; ++key_iter) {
+      if (!extension->manifest()->HasPath(key_iter->second))
+        continue;
+      ManifestHandler* handler = handlers_[key_iter->second].get();
       handlers_by_priority[priority_map_[handler]] = handler;
     }
   }
+
   for (std::map<int, ManifestHandler*>::iterator iter =
            handlers_by_priority.begin();
        iter != handlers_by_priority.end(); ++iter) {
@@ -151,13 +168,20 @@ bool ManifestHandlerRegistry::ValidateExtension(
     const Extension* extension,
     std::string* error,
     std::vector<InstallWarning>* warnings) {
-  std::set<ManifestHandler*> handlers;
-  for (ManifestHandlerMap::iterator iter = handlers_.begin();
-       iter != handlers_.end(); ++iter) {
-    ManifestHandler* handler = iter->second.get();
-    if (extension->manifest()->HasPath(iter->first) ||
-        handler->AlwaysValidateForType(extension->GetType())) {
-      handlers.insert(handler);
+  EnsureLookupTables();
+
+  const std::vector<ManifestHandler*>& always_validate =
+      always_validate_for_type_[extension->GetType()];
+  std::set<ManifestHandler*> handlers(always_validate.begin(),
+                                      always_validate.end());
+  for (base::DictionaryValue::Iterator iter(*extension->manifest()->value());
+       !iter.IsAtEnd(); iter.Advance()) {
+    std::pair<RootKeyMap::const_iterator, RootKeyMap::const_iterator> range =
+        root_key_map_.equal_range(iter.key());
+    for (RootKeyMap::const_iterator key_iter = range.first;
+         key_iter != range.second; ++key_iter) {
+      if (extension->manifest()->HasPath(key_iter->second))
+        handlers.insert(handlers_[key_iter->second].get());
     }
   }
   for (std::set<ManifestHandler*>::iterator iter = handlers.begin();
@@ -247,4 +271,37 @@ void ManifestHandlerRegistry::SortManifestHandlers() {
       << "Extension manifest handlers have circular dependencies!";
 }
 
+void ManifestHandlerRegistry::EnsureLookupTables() {
+  if (lookup_tables_valid_)
+    return;
+
+  root_key_map_.clear();
+  for (int type = 0; type < Manifest::NUM_LOAD_TYPES; ++type) {
+    always_parse_for_type_[type].clear();
+    always_validate_for_type_[type].clear();
+  }
+
+  std::set<ManifestHandler*> unique_handlers;
+  for (ManifestHandlerMap::const_iterator iter = handlers_.begin();
+       iter != handlers_.end(); ++iter) {
+    const std::string& key = iter->first;
+    root_key_map_.insert(
+        RootKeyMap::value_type(key.substr(0, key.find('.')), key));
+    unique_handlers.insert(iter->second.get());
+  }
+
+  for (std::set<ManifestHandler*>::const_iterator iter =
+           unique_handlers.begin();
+       iter != unique_handlers.end(); ++iter) {
+    for (int type = 0; type < Manifest::NUM_LOAD_TYPES; ++type) {
+      if ((*iter)->AlwaysParseForType(static_cast<Manifest::Type>(type)))
+        always_parse_for_type_[type].push_back(*iter);
+      if ((*iter)->AlwaysValidateForType(static_cast<Manifest::Type>(type)))
+        always_validate_for_type_[type].push_back(*iter);
+    }
+  }
+
+  lookup_tables_valid_ = true;
+}
+
 }  // namespace extensions
@@ -5,6 +5,7 @@
 #ifndef EXTENSIONS_COMMON_MANIFEST_HANDLER_H_
 #define EXTENSIONS_COMMON_MANIFEST_HANDLER_H_
 
+#include <map>
 #include <set>
 #include <string>
 #include <vector>
@@ -158,6 +159,14 @@ class ManifestHandlerRegistry {
   // CHECKs that there are no manifest handlers with circular dependencies.
   void SortManifestHandlers();
 
+  // Rebuilds |root_key_map_| and the per-type always-parse/validate handler
+  // lists if handlers have been registered since the last build, so that
+  // parsing an extension only considers the handlers whose keys are actually
+  // present in its manifest.
+  void EnsureLookupTables();
+
+  typedef std::multimap<std::string, std::string> RootKeyMap;
+
   // All registered manifest handlers.
   ManifestHandlerMap handlers_;
 
@@ -165,6 +174,22 @@ class ManifestHandlerRegistry {
   // values are evaluated first.
   ManifestHandlerPriorityMap priority_map_;
 
+  // Maps the top-level manifest key of each registered (possibly dotted)
+  // handler key to the full key, so handlers can be looked up by the keys
+  // present in a manifest instead of probing every registered key.
+  RootKeyMap root_key_map_;
+
+  // Handlers that parse or validate a manifest type regardless of the keys
+  // present, indexed by Manifest::Type.
+  std::vector<ManifestHandler*>
+      always_parse_for_type_[Manifest::NUM_LOAD_TYPES];
+  std::vector<ManifestHandler*>
+      always_validate_for_type_[Manifest::NUM_LOAD_TYPES];
+
+  // False when a handler has been registered since the lookup tables above
+  // were last built.
+  bool lookup_tables_valid_;
+
   bool is_finalized_;
 };
 
@@ -0,0 +1,147 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "extensions/common/url_pattern_index.h"
+
+#include <algorithm>
+
+#include "base/logging.h"
+#include "base/stl_util.h"
+#include "base/strings/string_split.h"
+#include "extensions/common/url_pattern_set.h"
+#include "url/gurl.h"
+
+namespace extensions {
+
+URLPatternIndex::Entry::Entry(ClientID id, const URLPattern& pattern)
+    : id(id), pattern(pattern) {}
+
+URLPatternIndex::Entry::~Entry() {}
+
+URLPatternIndex::HostNode::HostNode() {}
+
+URLPatternIndex::HostNode::~HostNode() {
+  STLDeleteValues(&children);
+}
+
+URLPatternIndex::URLPatternIndex() : size_(0) {}
+
+URLPatternIndex::~URLPatternIndex() {}
+
+void URLPatternIndex::RegisterPatternSet(ClientID id,
+                                         const URLPatternSet& patterns) {
+  for (URLPatternSet::const_iterator pattern = patterns.begin();
+       pattern != patterns.end(); ++pattern) {
+    if (pattern->match_all_urls() ||
+        (pattern->match_subdomains() && pattern->host().empty())) {
+      all_hosts_entries_.push_back(Entry(id, *pattern));
+    } else {
+      std::vector<std::string> components;
+      SplitHost(pattern->host(), &components);
+      HostNode* node = &root_;
+      for (size_t i = 0; i < components.size(); ++i) {
+        HostNode*& child = node->children[components[i]];
+        if (!child)
+          child = new HostNode;
+        node = child;
+      }
+      if (pattern->match_subdomains())
+        node->subdomain_entries.push_back(Entry(id, *pattern));
+      else
+        node->exact_entries.push_back(Entry(id, *pattern));
+    }
+    ++size_;
+  }
+}
+
+void URLPatternIndex::UnregisterPatternSet(ClientID id) {
+  size_t removed = RemoveFromNode(&root_, id) +
+      RemoveEntries(&all_hosts_entries_, id);
+  DCHECK_LE(removed, size_);
+  size_ -= removed;
+}
+
+void URLPatternIndex::MatchesURL(const GURL& url,
+                                 std::set<ClientID>* ids) const {
+  MatchEntries(all_hosts_entries_, url, ids);
+
+  // The trie walk only narrows candidates down by host; scheme, port and
+  // path are left to the patterns themselves. Filesystem URLs nest the
+  // interesting host in the inner URL.
+  const GURL* test = &url;
+  if (url.inner_url() && url.SchemeIsFileSystem())
+    test = url.inner_url();
+
+  std::vector<std::string> components;
+  SplitHost(test->host(), &components);
+  const HostNode* node = &root_;
+  size_t consumed = 0;
+  for (;;) {
+    MatchEntries(node->subdomain_entries, url, ids);
+    if (consumed == components.size()) {
+      MatchEntries(node->exact_entries, url, ids);
+      return;
+    }
+    std::map<std::string, HostNode*>::const_iterator child =
+        node->children.find(components[consumed]);
+    if (child == node->children.end())
+      return;
+    node = child->second;
+    ++consumed;
+  }
+}
+
+// static
+void URLPatternIndex::SplitHost(const std::string& host,
+                                std::vector<std::string>* components) {
+  base::SplitString(host, '.', components);
+  std::reverse(components->begin(), components->end());
+}
+
+// static
+void URLPatternIndex::MatchEntries(const EntryList& entries,
+                                   const GURL& url,
+                                   std::set<ClientID>* ids) {
+  for (EntryList::const_iterator entry = entries.begin();
+       entry != entries.end(); ++entry) {
+    if (!ids->count(entry->id) && entry->pattern.MatchesURL(url))
+      ids->insert(entry->id);
+  }
+}
+
+// static
+size_t URLPatternIndex::RemoveEntries(EntryList* entries, ClientID id) {
+  size_t removed = 0;
+  EntryList::iterator it = entries->begin();
+  while (it != entries->end()) {
+    if (it->id == id) {
+      it = entries->erase(it);
+      ++removed;
+    } else {
+      ++it;
+    }
+  }
+  return removed;
+}
+
+// static
+size_t URLPatternIndex::RemoveFromNode(HostNode* node, ClientID id) {
+  size_t removed = RemoveEntries(&node->exact_entries, id) +
+      RemoveEntries(&node->subdomain_entries, id);
+  std::map<std::string, HostNode*>::iterator it = node->children.begin();
+  while (it != node->children.end()) {
+    removed += RemoveFromNode(it->second, id);
+    if (it->second->exact_entries.empty() &&
+        it->second->subdomain_entries.empty() &&
+        it->second->children.empty()) {
+      delete it->second;
+      node->children.erase(it++);
+    } else {
+      ++it;
+    }
+  }
+  return removed;
+}
+
+}  // namespace extensions
@@ -0,0 +1,121 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef EXTENSIONS_COMMON_URL_PATTERN_INDEX_H_
+#define EXTENSIONS_COMMON_URL_PATTERN_INDEX_H_
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "base/basictypes.h"
+#include "extensions/common/url_pattern.h"
+
+class GURL;
+
+namespace extensions {
+
+class URLPatternSet;
+
+// Indexes the URLPattern lists of many clients (e.g. the webRequest listeners
+// of every loaded extension) so that a URL can be tested against all of them
+// at once. Patterns are bucketed by host in a trie keyed on host components
+// from the registry end inward ("www.google.com" is filed under com ->
+// google -> www), so a lookup only evaluates the handful of patterns whose
+// host could possibly match instead of every registered pattern. Patterns
+// which match all hosts cannot be bucketed and are evaluated on every lookup;
+// they are expected to be rare relative to host-specific patterns.
+//
+// The index is incrementally updatable. Clients register their pattern sets
+// under an opaque key of their choosing and can remove them again as they
+// come and go. Matching a URL yields the key of every client with at least
+// one matching pattern.
+class URLPatternIndex {
+ public:
+  // Key under which a client registers its patterns.
+  typedef int ClientID;
+
+  URLPatternIndex();
+  ~URLPatternIndex();
+
+  // Adds all patterns in |patterns| under |id|. A client which registers a
+  // new set must unregister its old patterns first.
+  void RegisterPatternSet(ClientID id, const URLPatternSet& patterns);
+
+  // Removes every pattern registered under |id|.
+  void UnregisterPatternSet(ClientID id);
+
+  bool IsEmpty() const { return size_ == 0; }
+
+  // Number of registered patterns.
+  size_t size() const { return size_; }
+
+  // Adds to |ids| the key of every registered pattern set containing at
+  // least one pattern which matches |url|.
+  void MatchesURL(const GURL& url, std::set<ClientID>* ids) const;
+
+ private:
+  // A registered pattern and the client which owns it.
+  struct Entry {
+    Entry(ClientID id, const URLPattern& pattern);
+    ~Entry();
+
+    ClientID id;
+    URLPattern pattern;
+  };
+  typedef std::vector<Entry> EntryList;
+
+  // One node per host component.
+  struct HostNode {
+    HostNode();
+    ~HostNode();
+
+    // Patterns whose host ends at this node. |subdomain_entries| also match
+    // any host below this node.
+    EntryList exact_entries;
+    EntryList subdomain_entries;
+
+    // Child nodes, keyed by the next host component toward the subdomain
+    // end. Owned.
+    std::map<std::string, HostNode*> children;
+
+   private:
+    DISALLOW_COPY_AND_ASSIGN(HostNode);
+  };
+
+  // Splits |host| into trie components, rightmost component first.
+  static void SplitHost(const std::string& host,
+                        std::vector<std::string>* components);
+
+  // Adds to |ids| the owner of every entry in |entries| whose pattern
+  // matches |url|, skipping owners already present.
+  static void MatchEntries(const EntryList& entries,
+                           const GURL& url,
+                           std::set<ClientID>* ids);
+
+  // Removes |id|'s entries from |entries|, returning how many were removed.
+  static size_t RemoveEntries(EntryList* entries, ClientID id);
+
+  // Removes |id|'s entries at and below |node|, pruning children left with
+  // neither entries nor children. Returns how many entries were removed.
+  static size_t RemoveFromNode(HostNode* node, ClientID id);
+
+  // Root of the host trie. Patterns with an empty host and no subdomain
+  // wildcard (file: patterns) live at the root itself.
+  HostNode root_;
+
+  // Patterns which match all hosts: <all_urls> and patterns whose host is a
+  // bare "*".
+  EntryList all_hosts_entries_;
+
+  // Total number of registered patterns.
+  size_t size_;
+
+  DISALLOW_COPY_AND_ASSIGN(URLPatternIndex);
+};
+
+}  // namespace extensions
+
+#endif  // EXTENSIONS_COMMON_URL_PATTERN_INDEX_H_
@@ -0,0 +1,193 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "extensions/common/url_pattern_index.h"
+
+#include "extensions/common/url_pattern_set.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace extensions {
+
+namespace {
+
+void AddPattern(URLPatternSet* set, const std::string& pattern) {
+  int schemes = URLPattern::SCHEME_ALL;
+  set->AddPattern(URLPattern(schemes, pattern));
+}
+
+std::set<URLPatternIndex::ClientID> Match(const URLPatternIndex& index,
+                                          const std::string& url) {
+  std::set<URLPatternIndex::ClientID> ids;
+  index.MatchesURL(GURL(url), &ids);
+  return ids;
+}
+
+}  // namespace
+
+TEST(URLPatternIndexTest, Empty) {
+  URLPatternIndex index;
+  EXPECT_TRUE(index.IsEmpty());
+  EXPECT_TRUE(Match(index, "http://www.foo.com/bar").empty());
+  EXPECT_TRUE(Match(index, "invalid").empty());
+}
+
+TEST(URLPatternIndexTest, HostBuckets) {
+  URLPatternIndex index;
+
+  URLPatternSet google;
+  AddPattern(&google, "http://www.google.com/*");
+  AddPattern(&google, "https://*.google.com/foo*");
+  index.RegisterPatternSet(1, google);
+
+  URLPatternSet yahoo;
+  AddPattern(&yahoo, "http://www.yahoo.com/*");
+  index.RegisterPatternSet(2, yahoo);
+
+  EXPECT_EQ(3u, index.size());
+
+  std::set<URLPatternIndex::ClientID> ids =
+      Match(index, "http://www.google.com/monkey");
+  EXPECT_EQ(1u, ids.size());
+  EXPECT_TRUE(ids.count(1));
+
+  // The subdomain pattern matches the bare host and deeper subdomains, but
+  // only for matching paths.
+  EXPECT_EQ(1u, Match(index, "https://google.com/foo").size());
+  EXPECT_EQ(1u, Match(index, "https://mail.google.com/foobar").size());
+  EXPECT_TRUE(Match(index, "https://mail.google.com/bar").empty());
+
+  ids = Match(index, "http://www.yahoo.com/");
+  EXPECT_EQ(1u, ids.size());
+  EXPECT_TRUE(ids.count(2));
+
+  // Hosts sharing a suffix with an indexed pattern must not match.
+  EXPECT_TRUE(Match(index, "http://www.google.com.evil.com/").empty());
+  EXPECT_TRUE(Match(index, "http://google.com/").empty());
+  EXPECT_TRUE(Match(index, "http://www.microsoft.com/").empty());
+}
+
+TEST(URLPatternIndexTest, AllHostsPatterns) {
+  URLPatternIndex index;
+
+  URLPatternSet patterns;
+  AddPattern(&patterns, "http://*/maps*");
+  AddPattern(&patterns, "<all_urls>");
+  index.RegisterPatternSet(1, patterns);
+
+  EXPECT_EQ(1u, Match(index, "http://anything.example/maps").size());
+  EXPECT_EQ(1u, Match(index, "ftp://ftp.example.com/pub").size());
+}
+
+TEST(URLPatternIndexTest, FilePatterns) {
+  URLPatternIndex index;
+
+  URLPatternSet patterns;
+  AddPattern(&patterns, "file:///etc/*");
+  index.RegisterPatternSet(1, patterns);
+
+  EXPECT_EQ(1u, Match(index, "file:///etc/passwd").size());
+  EXPECT_TRUE(Match(index, "file:///usr/local/").empty());
+  EXPECT_TRUE(Match(index, "http://www.example.com/etc/").empty());
+}
+
+TEST(URLPatternIndexTest, MultipleClientsPerHost) {
+  URLPatternIndex index;
+
+  URLPatternSet first;
+  AddPattern(&first, "http://www.example.com/*");
+  index.RegisterPatternSet(1, first);
+
+  URLPatternSet second;
+  AddPattern(&second, "*://www.example.com/*");
+  AddPattern(&second, "http://www.example.org/*");
+  index.RegisterPatternSet(2, second);
+
+  std::set<URLPatternIndex::ClientID> ids =
+      Match(index, "http://www.example.com/");
+  EXPECT_EQ(2u, ids.size());
+
+  ids = Match(index, "https://www.example.com/");
+  EXPECT_EQ(1u, ids.size());
+  EXPECT_TRUE(ids.count(2));
+}
+
+TEST(URLPatternIndexTest, Unregister) {
+  URLPatternIndex index;
+
+  URLPatternSet first;
+  AddPattern(&first, "http://www.example.com/*");
+  AddPattern(&first, "http://*.chromium.org/*");
+  index.RegisterPatternSet(1, first);
+
+  URLPatternSet second;
+  AddPattern(&second, "http://www.example.com/*");
+  index.RegisterPatternSet(2, second);
+
+  EXPECT_EQ(3u, index.size());
+
+  index.UnregisterPatternSet(1);
+  EXPECT_EQ(1u, index.size());
+
+  EXPECT_TRUE(Match(index, "http://build.chromium.org/").empty());
+  std::set<URLPatternIndex::ClientID> ids =
+      Match(index, "http://www.example.com/");
+  EXPECT_EQ(1u, ids.size());
+  EXPECT_TRUE(ids.count(2));
+
+  index.UnregisterPatternSet(2);
+  EXPECT_TRUE(index.IsEmpty());
+  EXPECT_TRUE(Match(index, "http://www.example.com/").empty());
+
+  // Unregistering an unknown client is a no-op.
+  index.UnregisterPatternSet(3);
+  EXPECT_TRUE(index.IsEmpty());
+}
+
+TEST(URLPatternIndexTest, AgreesWithLinearMatch) {
+  const char* kPatterns[] = {
+    "http://www.google.com/*",
+    "https://*.google.com/*",
+    "*://mail.google.com/mail*",
+    "http://*.example.org/path/*",
+    "http://127.0.0.1/*",
+    "http://*/index.html",
+    "file:///*",
+    "<all_urls>",
+  };
+  const char* kUrls[] = {
+    "http://www.google.com/",
+    "https://docs.google.com/document",
+    "http://mail.google.com/mail/inbox",
+    "http://sub.example.org/path/page.html",
+    "http://example.org/path/page.html",
+    "http://127.0.0.1/home",
+    "http://www.example.net/index.html",
+    "file:///etc/hosts",
+    "ftp://ftp.example.net/pub",
+    "about:blank",
+  };
+
+  URLPatternIndex index;
+  std::vector<URLPatternSet> sets;
+  for (size_t i = 0; i < arraysize(kPatterns); ++i) {
+    URLPatternSet set;
+    AddPattern(&set, kPatterns[i]);
+    sets.push_back(set);
+    index.RegisterPatternSet(static_cast<URLPatternIndex::ClientID>(i), set);
+  }
+
+  for (size_t i = 0; i < arraysize(kUrls); ++i) {
+    GURL url(kUrls[i]);
+    std::set<URLPatternIndex::ClientID> ids;
+    index.MatchesURL(url, &ids);
+    for (size_t j = 0; j < sets.size(); ++j) {
+      EXPECT_EQ(sets[j].MatchesURL(url),
+                ids.count(static_cast<URLPatternIndex::ClientID>(j)) > 0)
+          << "Pattern " << kPatterns[j] << " vs url " << kUrls[i];
+    }
+  }
+}
+
+}  // namespace extensions
@@ -4,9 +4,13 @@
 
 #include "extensions/renderer/module_system.h"
 
+#include <map>
+
 #include "base/bind.h"
 #include "base/command_line.h"
 #include "base/debug/trace_event.h"
+#include "base/lazy_instance.h"
+#include "base/memory/linked_ptr.h"
 #include "base/stl_util.h"
 #include "base/strings/string_util.h"
 #include "base/strings/stringprintf.h"
@@ -89,6 +93,60 @@ class DefaultExceptionHandler : public ModuleSystem::ExceptionHandler {
   ScriptContext* context_;
 };
 
+// Caches the compiled-but-unbound script of each module per isolate. The
+// built-in binding modules are compiled for every context that requires
+// them (each extension frame, content script world, etc.) even though
+// their source never changes; v8::UnboundScript is context independent,
+// so one compile can serve every context in the process. The source is
+// kept alongside the script and verified on each hit because tests swap
+// in their own sources under the same module names.
+class UnboundScriptCache {
+ public:
+  UnboundScriptCache() {}
+
+  // Returns the cached script for |module_name| bound to the current
+  // context, or an empty handle on a miss.
+  v8::Handle<v8::Script> Lookup(v8::Isolate* isolate,
+                                const std::string& module_name,
+                                v8::Handle<v8::String> source) {
+    EntryMap& entries = entries_[isolate];
+    EntryMap::iterator it = entries.find(module_name);
+    if (it == entries.end())
+      return v8::Handle<v8::Script>();
+    Entry* entry = it->second.get();
+    v8::Local<v8::String> cached_source =
+        v8::Local<v8::String>::New(isolate, entry->source);
+    if (!cached_source->StrictEquals(source))
+      return v8::Handle<v8::Script>();
+    return v8::Local<v8::UnboundScript>::New(isolate, entry->script)
+        ->BindToCurrentContext();
+  }
+
+  void Store(v8::Isolate* isolate,
+             const std::string& module_name,
+             v8::Handle<v8::String> source,
+             v8::Handle<v8::UnboundScript> script) {
+    linked_ptr<Entry> entry(new Entry());
+    entry->source.Reset(isolate, source);
+    entry->script.Reset(isolate, script);
+    entries_[isolate][module_name] = entry;
+  }
+
+ private:
+  struct Entry {
+    v8::UniquePersistent<v8::String> source;
+    v8::UniquePersistent<v8::UnboundScript> script;
+  };
+  typedef std::map<std::string, linked_ptr<Entry> > EntryMap;
+
+  std::map<v8::Isolate*, EntryMap> entries_;
+
+  DISALLOW_COPY_AND_ASSIGN(UnboundScriptCache);
+};
+
+base::LazyInstance<UnboundScriptCache>::Leaky g_unbound_script_cache =
+    LAZY_INSTANCE_INITIALIZER;
+
 }  // namespace
 
 std::string ModuleSystem::ExceptionHandler::CreateExceptionString(
@@ -474,6 +532,62 @@ v8::Handle<v8::Value> ModuleSystem::RunString(v8::Handle<v8::String> code,
   return handle_scope.Escape(result);
 }
 
+v8::Handle<v8::Script> ModuleSystem::CompileModuleScript(
+    const std::string& module_name,
+    v8::Handle<v8::String> code) {
+  v8::Isolate* isolate = GetIsolate();
+  v8::Handle<v8::Script> script =
+      g_unbound_script_cache.Get().Lookup(isolate, module_name, code);
+  if (!script.IsEmpty())
+    return script;
+
+  // Prepend extensions:: to |module_name| so that internal code can be
+  // differentiated from external code in stack traces. This has no effect
+  // on behaviour.
+  std::string internal_name =
+      base::StringPrintf("extensions::%s", module_name.c_str());
+  v8::ScriptOrigin origin(
+      v8::String::NewFromUtf8(isolate,
+                              internal_name.c_str(),
+                              v8::String::kNormalString,
+                              internal_name.size()));
+  v8::ScriptCompiler::Source source(code, origin);
+  v8::Local<v8::UnboundScript> unbound_script =
+      v8::ScriptCompiler::CompileUnbound(isolate, &source);
+  if (unbound_script.IsEmpty())
+    return v8::Handle<v8::Script>();
+
+  g_unbound_script_cache.Get().Store(isolate, module_name, code,
+                                     unbound_script);
+  return unbound_script->BindToCurrentContext();
+}
+
+v8::Handle<v8::Value> ModuleSystem::RunModuleScript(
+    const std::string& module_name,
+    v8::Handle<v8::String> code) {
+  v8::EscapableHandleScope handle_scope(GetIsolate());
+  v8::Context::Scope context_scope(context()->v8_context());
+
+  blink::WebScopedMicrotaskSuppression suppression;
+  v8::TryCatch try_catch;
+  try_catch.SetCaptureMessage(true);
+  v8::Handle<v8::Script> script(CompileModuleScript(module_name, code));
+  if (try_catch.HasCaught()) {
+    HandleException(try_catch);
+    return v8::Undefined(GetIsolate());
+  }
+  if (script.IsEmpty())
+    return v8::Undefined(GetIsolate());
+
+  v8::Local<v8::Value> result = script->Run();
+  if (try_catch.HasCaught()) {
+    HandleException(try_catch);
+    return v8::Undefined(GetIsolate());
+  }
+
+  return handle_scope.Escape(result);
+}
+
 v8::Handle<v8::Value> ModuleSystem::GetSource(const std::string& module_name) {
   v8::EscapableHandleScope handle_scope(GetIsolate());
   if (!source_map_->Contains(module_name))
@@ -584,8 +698,7 @@ v8::Handle<v8::Value> ModuleSystem::LoadModule(const std::string& module_name) {
       WrapSource(v8::Handle<v8::String>::Cast(source)));
   // Modules are wrapped in (function(){...}) so they always return functions.
   v8::Handle<v8::Value> func_as_value =
-      RunString(wrapped_source,
-                v8::String::NewFromUtf8(GetIsolate(), module_name.c_str()));
+      RunModuleScript(module_name, wrapped_source);
   if (func_as_value.IsEmpty() || func_as_value->IsUndefined()) {
     Fatal(context_, "Bad source for require(" + module_name + ")");
     return v8::Undefined(GetIsolate());
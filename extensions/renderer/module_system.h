@@ -195,6 +195,18 @@ class ModuleSystem : public ObjectBackedNativeHandler,
   // Loads and runs a Javascript module.
   v8::Handle<v8::Value> LoadModule(const std::string& module_name);
 
+  // Compiles the wrapped source of a module, consulting (and filling) the
+  // per-isolate cache of compiled module scripts. Returns an empty handle
+  // on compile failure, leaving the exception in the calling TryCatch.
+  v8::Handle<v8::Script> CompileModuleScript(const std::string& module_name,
+                                             v8::Handle<v8::String> code);
+
+  // Compiles and runs the wrapped source of a module, returning the
+  // function it evaluates to. Equivalent to RunString() but module scripts
+  // are eligible for the compilation cache.
+  v8::Handle<v8::Value> RunModuleScript(const std::string& module_name,
+                                        v8::Handle<v8::String> code);
+
   // Invoked when a module is loaded in response to a requireAsync call.
   // Resolves |resolver| with |value|.
   void OnModuleLoaded(
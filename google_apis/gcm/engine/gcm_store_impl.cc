@@ -383,16 +383,17 @@ void GCMStoreImpl::Backend::RemoveIncomingMessages(
   leveldb::WriteOptions write_options;
   write_options.sync = true;
 
-  leveldb::Status s;
+  // Batch the deletions into a single write so that the synchronous disk
+  // flush is paid once per acknowledged batch rather than once per message.
+  leveldb::WriteBatch write_batch;
   for (PersistentIdList::const_iterator iter = persistent_ids.begin();
        iter != persistent_ids.end();
        ++iter) {
     DVLOG(1) << "Removing incoming message with id " << *iter;
     std::string key = MakeIncomingKey(*iter);
-    s = db_->Delete(write_options, MakeSlice(key));
-    if (!s.ok())
-      break;
+    write_batch.Delete(MakeSlice(key));
   }
+  const leveldb::Status s = db_->Write(write_options, &write_batch);
   if (s.ok()) {
     foreground_task_runner_->PostTask(FROM_HERE, base::Bind(callback, true));
     return;
@@ -445,6 +446,9 @@ void GCMStoreImpl::Backend::RemoveOutgoingMessages(
 
   AppIdToMessageCountMap removed_message_counts;
 
+  // As with incoming messages, batch the deletions so the synchronous disk
+  // flush happens once for the whole acknowledged batch.
+  leveldb::WriteBatch write_batch;
   leveldb::Status s;
   for (PersistentIdList::const_iterator iter = persistent_ids.begin();
        iter != persistent_ids.end();
@@ -466,11 +470,10 @@ void GCMStoreImpl::Backend::RemoveOutgoingMessages(
       else
         removed_message_counts[data_message.category()] = 1;
     }
-    DVLOG(1) << "Removing outgoing message with id " << *iter;
-    s = db_->Delete(write_options, MakeSlice(key));
-    if (!s.ok())
-      break;
+    write_batch.Delete(MakeSlice(key));
   }
+  if (s.ok())
+    s = db_->Write(write_options, &write_batch);
   if (s.ok()) {
     foreground_task_runner_->PostTask(FROM_HERE,
                                       base::Bind(callback,
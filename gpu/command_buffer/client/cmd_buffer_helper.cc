@@ -21,6 +21,7 @@ CommandBufferHelper::CommandBufferHelper(CommandBuffer* command_buffer)
       total_entry_count_(0),
       immediate_entry_count_(0),
       token_(0),
+      flushed_token_(0),
       put_(0),
       last_put_sent_(0),
 #if defined(CMD_HELPER_PERIODIC_FLUSH_CHECK)
@@ -64,9 +65,17 @@ void CommandBufferHelper::CalcImmediateEntries(int waiting_count) {
 
   // Limit entry count to force early flushing.
   if (flush_automatically_) {
-    int32 limit =
-        total_entry_count_ /
-        ((curr_get == last_put_sent_) ? kAutoFlushSmall : kAutoFlushBig);
+    // Scale the auto-flush threshold with the service's backlog: once the
+    // service has consumed everything sent so far, flush in small batches to
+    // keep it fed; while it still has plenty queued, let more commands
+    // accumulate before paying for another flush.
+    int32 backlog =
+        (last_put_sent_ + total_entry_count_ - curr_get) % total_entry_count_;
+    int32 limit = backlog;
+    if (limit < total_entry_count_ / kAutoFlushSmall)
+      limit = total_entry_count_ / kAutoFlushSmall;
+    if (limit > total_entry_count_ / kAutoFlushBig)
+      limit = total_entry_count_ / kAutoFlushBig;
 
     int32 pending =
         (put_ + total_entry_count_ - last_put_sent_) % total_entry_count_;
@@ -153,6 +162,7 @@ void CommandBufferHelper::Flush() {
   if (usable() && last_put_sent_ != put_) {
     last_flush_time_ = base::TimeTicks::Now();
     last_put_sent_ = put_;
+    flushed_token_ = token_;
     command_buffer_->Flush(put_);
     ++flush_generation_;
     CalcImmediateEntries(0);
@@ -201,10 +211,13 @@ int32 CommandBufferHelper::InsertToken() {
     return token_;
   }
   DCHECK(HaveRingBuffer());
+  // Grab the space first: GetCmdSpace can flush, and a flush taken here must
+  // not count the new token as flushed before its SetToken command has been
+  // written to the buffer.
+  cmd::SetToken* cmd = GetCmdSpace<cmd::SetToken>();
   // Increment token as 31-bit integer. Negative values are used to signal an
   // error.
   token_ = (token_ + 1) & 0x7FFFFFFF;
-  cmd::SetToken* cmd = GetCmdSpace<cmd::SetToken>();
   if (cmd) {
     cmd->Init(token_);
     if (token_ == 0) {
@@ -229,7 +242,10 @@ void CommandBufferHelper::WaitForToken(int32 token) {
   if (token > token_) return;  // we wrapped
   if (last_token_read() >= token)
     return;
-  Flush();
+  // Only flush if the token has not gone out yet; commands queued after the
+  // token do not have to be sent for the wait to complete.
+  if (token > flushed_token_)
+    Flush();
   command_buffer_->WaitForTokenInRange(token, token_);
 }
 
@@ -316,6 +316,9 @@ class GPU_EXPORT CommandBufferHelper {
   int32 total_entry_count_;  // the total number of entries
   int32 immediate_entry_count_;
   int32 token_;
+  // The highest token whose SetToken command has been flushed to the service.
+  // WaitForToken does not need to flush for tokens at or below this value.
+  int32 flushed_token_;
   int32 put_;
   int32 last_put_sent_;
 
@@ -380,16 +380,22 @@ TEST_F(CommandBufferHelperTest, TestCalcImmediateEntriesAutoFlushing) {
   helper_->SetAutomaticFlushes(false);
   EXPECT_EQ(ImmediateEntryCount(), kTotalNumCommandEntries - 1);
 
-  // With auto flushes, and Get == Last Put,
+  // With auto flushes, and Get == Last Put (no backlog),
   // up to kTotalNumCommandEntries / kAutoFlushSmall is available.
   helper_->SetAutomaticFlushes(true);
   EXPECT_EQ(ImmediateEntryCount(), kTotalNumCommandEntries / kAutoFlushSmall);
 
-  // With auto flushes, and Get != Last Put,
-  // up to kTotalNumCommandEntries / kAutoFlushBig is available.
+  // The flush threshold scales with the service's backlog, between the
+  // kAutoFlushSmall and kAutoFlushBig bounds. A flushed backlog of 2 entries
+  // is below the small bound, so the small limit still applies.
   AddUniqueCommandWithExpect(error::kNoError, 2);
   helper_->Flush();
-  EXPECT_EQ(ImmediateEntryCount(), kTotalNumCommandEntries / kAutoFlushBig);
+  EXPECT_EQ(ImmediateEntryCount(), kTotalNumCommandEntries / kAutoFlushSmall);
+
+  // A backlog of 8 entries is within the bounds, so the limit tracks it.
+  AddUniqueCommandWithExpect(error::kNoError, 6);
+  helper_->Flush();
+  EXPECT_EQ(ImmediateEntryCount(), 8);
 
   helper_->Finish();
   // Check that the commands did happen.
@@ -136,9 +136,18 @@ void* TransferBuffer::AllocUpTo(
   }
 
   unsigned int max_size = ring_buffer_->GetLargestFreeOrPendingSize();
-  *size_allocated = std::min(max_size, size);
-  bytes_since_last_flush_ += *size_allocated;
-  return ring_buffer_->Alloc(*size_allocated);
+  unsigned int no_wait_size = ring_buffer_->GetLargestFreeSizeNoWaiting();
+  unsigned int size_to_allocate = std::min(max_size, size);
+  // Querying the free size also reclaims, without waiting, any blocks whose
+  // tokens have already been read. If at least half of what a blocking
+  // allocation would return is free right now, hand that out instead of
+  // stalling until older allocations retire; the caller chunks its work
+  // anyway, and this at most doubles the number of chunks.
+  if (no_wait_size < size_to_allocate && no_wait_size >= size_to_allocate / 2)
+    size_to_allocate = no_wait_size;
+  *size_allocated = size_to_allocate;
+  bytes_since_last_flush_ += size_to_allocate;
+  return ring_buffer_->Alloc(size_to_allocate);
 }
 
 void* TransferBuffer::Alloc(unsigned int size) {
@@ -192,6 +192,30 @@ TEST_F(TransferBufferTest, MemoryAlignmentAfterZeroAllocation) {
   transfer_buffer_->FreePendingToken(ptr, 1);
 }
 
+TEST_F(TransferBufferTest, AllocUpToPrefersMemoryFreeWithoutWaiting) {
+  Initialize(0);
+
+  const unsigned int kHalf = (kTransferBufferSize - kStartingOffset) / 2;
+  void* ptr1 = transfer_buffer_->Alloc(kHalf);
+  ASSERT_TRUE(ptr1 != NULL);
+  // The first block's token has already been read by the service; the
+  // second block's token is still pending.
+  transfer_buffer_->FreePendingToken(ptr1, 1);
+  void* ptr2 = transfer_buffer_->Alloc(kHalf);
+  ASSERT_TRUE(ptr2 != NULL);
+  transfer_buffer_->FreePendingToken(ptr2, 99999);
+
+  // Asking for the whole buffer should hand out the first half, which is
+  // free right now, instead of waiting for the second half to retire.
+  unsigned int size_allocated = 0;
+  void* ptr = transfer_buffer_->AllocUpTo(
+      kTransferBufferSize - kStartingOffset, &size_allocated);
+  ASSERT_TRUE(ptr != NULL);
+  EXPECT_EQ(kHalf, size_allocated);
+  EXPECT_EQ(ptr1, ptr);
+  transfer_buffer_->FreePendingToken(ptr, 2);
+}
+
 TEST_F(TransferBufferTest, Flush) {
   Initialize(16u);
   unsigned int size_allocated = 0;
@@ -17,6 +17,12 @@ namespace {
 
 static uint64 g_next_pixel_transfer_state_id = 1;
 
+// Amount of time a single ProcessMorePendingTransfers call may spend running
+// queued uploads. Batching several small uploads into one idle slot avoids a
+// scheduling round trip per texture, while the cap keeps the service
+// responsive when large uploads are queued.
+const int kMaxBatchedTransferTimeMs = 2;
+
 void PerformNotifyCompletion(
     AsyncMemoryParams mem_params,
     scoped_refptr<AsyncPixelTransferCompletionObserver> observer) {
@@ -291,12 +297,19 @@ void AsyncPixelTransferManagerIdle::ProcessMorePendingTransfers() {
   if (shared_state_.tasks.empty())
     return;
 
-  // First task should always be a pixel transfer task.
-  DCHECK(shared_state_.tasks.front().transfer_id);
-  shared_state_.tasks.front().task.Run();
-  shared_state_.tasks.pop_front();
+  base::TimeTicks deadline =
+      base::TimeTicks::HighResNow() +
+      base::TimeDelta::FromMilliseconds(kMaxBatchedTransferTimeMs);
+
+  do {
+    // First task should always be a pixel transfer task.
+    DCHECK(shared_state_.tasks.front().transfer_id);
+    shared_state_.tasks.front().task.Run();
+    shared_state_.tasks.pop_front();
 
-  shared_state_.ProcessNotificationTasks();
+    shared_state_.ProcessNotificationTasks();
+  } while (!shared_state_.tasks.empty() &&
+           base::TimeTicks::HighResNow() < deadline);
 }
 
 bool AsyncPixelTransferManagerIdle::NeedsProcessMorePendingTransfers() {
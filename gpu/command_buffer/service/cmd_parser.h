@@ -57,6 +57,12 @@ class GPU_EXPORT CommandParser {
   // if there are no commands in the buffer.
   error::Error ProcessCommand();
 
+  // Processes up to |num_commands| commands in one handler call, updating the
+  // get pointer by however many entries were consumed. The handler validates
+  // the whole batch of headers and dispatches without returning to the parser
+  // between commands.
+  error::Error ProcessCommands(int num_commands);
+
   // Processes all commands until get == put.
   error::Error ProcessAllCommands();
 
@@ -91,6 +97,23 @@ class AsyncAPIInterface {
       unsigned int arg_count,
       const void* cmd_data) = 0;
 
+  // Executes multiple commands. The default implementation validates each
+  // header and forwards to DoCommand; handlers that can dispatch more cheaply
+  // in bulk should override this.
+  // Parameters:
+  //    num_commands: maximum number of commands to execute from buffer.
+  //    buffer: pointer to first command entry to process.
+  //    num_entries: number of sequential command buffer entries in buffer.
+  //    entries_processed: if not NULL, is set to the number of entries
+  //    consumed.
+  // Returns:
+  //   error::kNoError if no error was found, one of
+  //   error::Error otherwise.
+  virtual error::Error DoCommands(unsigned int num_commands,
+                                  const void* buffer,
+                                  int num_entries,
+                                  int* entries_processed);
+
   // Returns a name for a command. Useful for logging / debuging.
   virtual const char* GetCommandName(unsigned int command_id) const = 0;
 };
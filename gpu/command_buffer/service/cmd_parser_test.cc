@@ -169,6 +169,46 @@ TEST_F(CommandParserTest, TestMultipleCommands) {
   Mock::VerifyAndClearExpectations(api_mock());
 }
 
+// Tests processing commands as a batch through ProcessCommands().
+TEST_F(CommandParserTest, TestBatchedCommands) {
+  scoped_ptr<CommandParser> parser(MakeParser(10));
+  CommandBufferOffset put = parser->put();
+  CommandHeader header;
+
+  // add 3 commands.
+  header.size = 1;
+  header.command = 11;
+  buffer()[put++].value_header = header;
+
+  CommandBufferOffset put_cmd3 = put + 2;
+  header.size = 2;
+  header.command = 22;
+  buffer()[put++].value_header = header;
+  buffer()[put++].value_int32 = 45;
+
+  header.size = 1;
+  header.command = 33;
+  buffer()[put++].value_header = header;
+
+  parser->set_put(put);
+  EXPECT_EQ(put, parser->put());
+
+  // A batch of 2 only processes the first 2 commands.
+  CommandBufferEntry param;
+  param.value_int32 = 45;
+  AddDoCommandExpect(error::kNoError, 11, 0, NULL);
+  AddDoCommandExpect(error::kNoError, 22, 1, &param);
+  EXPECT_EQ(error::kNoError, parser->ProcessCommands(2));
+  EXPECT_EQ(put_cmd3, parser->get());
+  Mock::VerifyAndClearExpectations(api_mock());
+
+  // The next batch stops at put.
+  AddDoCommandExpect(error::kNoError, 33, 0, NULL);
+  EXPECT_EQ(error::kNoError, parser->ProcessCommands(2));
+  EXPECT_EQ(put, parser->get());
+  Mock::VerifyAndClearExpectations(api_mock());
+}
+
 // Tests that the parser will wrap correctly at the end of the buffer.
 TEST_F(CommandParserTest, TestWrap) {
   scoped_ptr<CommandParser> parser(MakeParser(5));
@@ -24,6 +24,10 @@ namespace gpu {
 
 const int64 kUnscheduleFenceTimeOutDelay = 10000;
 
+// Commands are processed in batches of this many; between batches the
+// scheduler checks for preemption and publishes the new get offset.
+const int kParseCommandsSlice = 20;
+
 #if defined(OS_WIN)
 const int64 kRescheduleTimeOutDelay = 1000;
 #endif
@@ -78,10 +82,13 @@ void GpuScheduler::PutChanged() {
     DCHECK(IsScheduled());
     DCHECK(unschedule_fences_.empty());
 
-    error = parser_->ProcessCommand();
+    error = parser_->ProcessCommands(kParseCommandsSlice);
 
     if (error == error::kDeferCommandUntilLater) {
       DCHECK_GT(unscheduled_count_, 0);
+      // The batch may have consumed commands before the deferred one, so the
+      // new get offset still has to be published.
+      command_buffer_->SetGetOffset(static_cast<int32>(parser_->get()));
       break;
     }
 
@@ -106,14 +106,16 @@ void ProgramCache::ComputeProgramHash(
   const size_t shader0_size = kHashLength;
   const size_t shader1_size = kHashLength;
   const size_t map_size = CalculateMapSize(bind_attrib_location_map);
-  const size_t total_size = shader0_size + shader1_size + map_size;
+  const size_t fingerprint_size = driver_fingerprint_.length();
+  const size_t total_size =
+      shader0_size + shader1_size + map_size + fingerprint_size;
 
   scoped_ptr<unsigned char[]> buffer(new unsigned char[total_size]);
   memcpy(buffer.get(), hashed_shader_0, shader0_size);
   memcpy(&buffer[shader0_size], hashed_shader_1, shader1_size);
+  size_t current_pos = shader0_size + shader1_size;
   if (map_size != 0) {
     // copy our map
-    size_t current_pos = shader0_size + shader1_size;
     std::map<std::string, GLint>::const_iterator it;
     for (it = bind_attrib_location_map->begin();
          it != bind_attrib_location_map->end();
@@ -128,6 +130,11 @@ void ProgramCache::ComputeProgramHash(
       buffer[current_pos++] = value;
     }
   }
+  if (fingerprint_size != 0) {
+    memcpy(&buffer.get()[current_pos],
+           driver_fingerprint_.data(),
+           fingerprint_size);
+  }
   base::SHA1HashBytes(buffer.get(),
                       total_size, reinterpret_cast<unsigned char*>(result));
 }
@@ -74,6 +74,14 @@ class GPU_EXPORT ProgramCache {
   // clears the cache
   void Clear();
 
+  // Mixes an identifier for the active GL driver into the program hash, so
+  // that binaries cached under one driver are never offered to a different
+  // one after a driver update. An empty fingerprint leaves the hash
+  // unchanged.
+  void set_driver_fingerprint(const std::string& fingerprint) {
+    driver_fingerprint_ = fingerprint;
+  }
+
   // Only for testing
   void LinkedProgramCacheSuccess(const std::string& shader_a,
                                  const ShaderTranslatorInterface* translator_a,
@@ -108,6 +116,7 @@ class GPU_EXPORT ProgramCache {
   virtual void ClearBackend() = 0;
 
   LinkStatusMap link_status_;
+  std::string driver_fingerprint_;
 
   DISALLOW_COPY_AND_ASSIGN(ProgramCache);
 };
@@ -128,6 +128,20 @@ TEST_F(ProgramCacheTest, LinkUnknownOnVertexSourceChange) {
             cache_->GetLinkedProgramStatus(shader1, NULL, shader2, NULL, NULL));
 }
 
+TEST_F(ProgramCacheTest, LinkUnknownOnDriverFingerprintChange) {
+  const std::string shader1 = "abcd1234";
+  const std::string shader2 = "abcda sda b1~#4 bbbbb1234";
+  cache_->set_driver_fingerprint("Vendor\nRenderer\nOpenGL ES 2.0\n1.0");
+  cache_->SaySuccessfullyCached(shader1, NULL, shader2, NULL, NULL);
+
+  EXPECT_EQ(ProgramCache::LINK_SUCCEEDED,
+            cache_->GetLinkedProgramStatus(shader1, NULL, shader2, NULL, NULL));
+
+  cache_->set_driver_fingerprint("Vendor\nRenderer\nOpenGL ES 2.0\n2.0");
+  EXPECT_EQ(ProgramCache::LINK_UNKNOWN,
+            cache_->GetLinkedProgramStatus(shader1, NULL, shader2, NULL, NULL));
+}
+
 TEST_F(ProgramCacheTest, StatusEviction) {
   const std::string shader1 = "abcd1234";
   const std::string shader2 = "abcda sda b1~#4 bbbbb1234";
@@ -84,7 +84,13 @@ class IPC_EXPORT Channel : public Sender {
     // The client will return the message with hops = 1, *after* it
     // has received the message that contains the FD. When we
     // receive it again on the sender side, we close the FD.
-    CLOSE_FD_MESSAGE_TYPE = HELLO_MESSAGE_TYPE - 1
+    CLOSE_FD_MESSAGE_TYPE = HELLO_MESSAGE_TYPE - 1,
+    // On POSIX, messages above a size threshold are sent out of band: the
+    // payload is placed in a shared memory region and a SHMEM_MESSAGE is
+    // sent over the pipe instead, carrying the payload size and the region's
+    // file descriptor. The receiving channel maps the region, reconstructs
+    // the original message and dispatches it to the listener as usual.
+    SHMEM_MESSAGE_TYPE = HELLO_MESSAGE_TYPE - 2
   };
 
   // The maximum message size in bytes. Attempting to receive a message of this
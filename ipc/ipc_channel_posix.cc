@@ -26,6 +26,7 @@
 #include "base/location.h"
 #include "base/logging.h"
 #include "base/memory/scoped_ptr.h"
+#include "base/memory/shared_memory.h"
 #include "base/memory/singleton.h"
 #include "base/posix/eintr_wrapper.h"
 #include "base/posix/global_descriptors.h"
@@ -38,6 +39,7 @@
 #include "ipc/ipc_descriptors.h"
 #include "ipc/ipc_listener.h"
 #include "ipc/ipc_logging.h"
+#include "ipc/ipc_message_pool.h"
 #include "ipc/ipc_message_utils.h"
 #include "ipc/ipc_switches.h"
 #include "ipc/unix_domain_socket_util.h"
@@ -61,6 +63,17 @@ namespace IPC {
 //------------------------------------------------------------------------------
 namespace {
 
+// Maximum number of queued messages gathered into one vectored sendmsg()
+// call by ProcessOutgoingMessages(). Well under the portable IOV_MAX floor
+// of 16; more buys little once the socket buffer is the bottleneck.
+const size_t kMaxSendIovecs = 16;
+
+// Messages at least this large are sent out of band through shared memory
+// rather than copied through the socket in kReadBufferSize chunks. The
+// threshold is well above typical control messages; the main beneficiaries
+// are bulk payloads such as serialized resource data.
+const size_t kOutOfBandMessageThreshold = 64 * 1024;
+
 // The PipeMap class works around this quirk related to unit tests:
 //
 // When running as a server, we install the client socket in a
@@ -394,6 +407,81 @@ bool ChannelPosix::ProcessOutgoingMessages() {
   while (!output_queue_.empty()) {
     Message* msg = output_queue_.front();
 
+    // Batch the front run of descriptor-free messages into a single
+    // vectored sendmsg() call. Descriptor-bearing messages keep the
+    // one-at-a-time path below, since a call's control data applies to all
+    // of its payload. This collapses syscalls when many small messages are
+    // queued, the common case under load.
+    if (output_queue_.size() > 1 && msg->file_descriptor_set()->empty() &&
+        output_queue_[1]->file_descriptor_set()->empty()) {
+      struct iovec iovs[kMaxSendIovecs];
+      size_t num_iovs = 0;
+      size_t bytes_to_write = 0;
+      for (size_t i = 0; i < output_queue_.size() && num_iovs < kMaxSendIovecs;
+           ++i) {
+        Message* m = output_queue_[i];
+        if (!m->file_descriptor_set()->empty())
+          break;
+        size_t offset = (i == 0) ? message_send_bytes_written_ : 0;
+        iovs[num_iovs].iov_base = const_cast<char*>(
+            reinterpret_cast<const char*>(m->data()) + offset);
+        iovs[num_iovs].iov_len = m->size() - offset;
+        bytes_to_write += iovs[num_iovs].iov_len;
+        ++num_iovs;
+      }
+
+      struct msghdr batch_msgh = {0};
+      batch_msgh.msg_iov = iovs;
+      batch_msgh.msg_iovlen = num_iovs;
+      ssize_t bytes_written =
+          HANDLE_EINTR(sendmsg(pipe_, &batch_msgh, MSG_DONTWAIT));
+
+      if (bytes_written < 0 && !SocketWriteErrorIsRecoverable()) {
+#if defined(OS_MACOSX)
+        // On OSX writing to a pipe with no listener returns EPERM.
+        if (errno == EPERM)
+          return false;
+#endif  // OS_MACOSX
+        if (errno == EPIPE)
+          return false;
+        PLOG(ERROR) << "pipe error on " << pipe_
+                    << " Currently writing batch of " << num_iovs
+                    << " messages, " << bytes_to_write << " bytes";
+        return false;
+      }
+
+      // Retire fully written messages; an incompletely written one keeps
+      // its progress in message_send_bytes_written_ as usual.
+      size_t remaining = bytes_written > 0 ? bytes_written : 0;
+      while (remaining > 0) {
+        Message* sent = output_queue_.front();
+        size_t pending = sent->size() - message_send_bytes_written_;
+        if (remaining < pending) {
+          message_send_bytes_written_ += remaining;
+          break;
+        }
+        remaining -= pending;
+        message_send_bytes_written_ = 0;
+        DVLOG(2) << "sent message @" << sent << " on channel @" << this
+                 << " with type " << sent->type() << " on fd " << pipe_;
+        MessagePool::Release(sent);
+        output_queue_.pop_front();
+      }
+
+      if (static_cast<size_t>(bytes_written) != bytes_to_write) {
+        // Tell libevent to call us back once things are unblocked.
+        is_blocked_on_write_ = true;
+        base::MessageLoopForIO::current()->WatchFileDescriptor(
+            pipe_,
+            false,  // One shot
+            base::MessageLoopForIO::WATCH_WRITE,
+            &write_watcher_,
+            this);
+        return true;
+      }
+      continue;
+    }
+
     size_t amt_to_write = msg->size() - message_send_bytes_written_;
     DCHECK_NE(0U, amt_to_write);
     const char* out_bytes = reinterpret_cast<const char*>(msg->data()) +
@@ -519,13 +607,41 @@ bool ChannelPosix::ProcessOutgoingMessages() {
       // Message sent OK!
       DVLOG(2) << "sent message @" << msg << " on channel @" << this
                << " with type " << msg->type() << " on fd " << pipe_;
-      delete output_queue_.front();
-      output_queue_.pop();
+      MessagePool::Release(output_queue_.front());
+      output_queue_.pop_front();
     }
   }
   return true;
 }
 
+Message* ChannelPosix::MaybeWrapLargeMessage(Message* message) {
+  if (message->size() < kOutOfBandMessageThreshold ||
+      message->HasFileDescriptors() ||
+      message->routing_id() == MSG_ROUTING_NONE) {
+    return message;
+  }
+
+  base::SharedMemory shared_memory;
+  if (!shared_memory.CreateAndMapAnonymous(message->size()))
+    return message;  // Out of regions; fall back to sending in band.
+  memcpy(shared_memory.memory(), message->data(), message->size());
+
+  base::SharedMemoryHandle handle;
+  if (!shared_memory.ShareToProcess(base::GetCurrentProcessHandle(), &handle))
+    return message;
+
+  scoped_ptr<Message> wrapper(new Message(MSG_ROUTING_NONE,
+                                          SHMEM_MESSAGE_TYPE,
+                                          IPC::Message::PRIORITY_NORMAL));
+  wrapper->WriteUInt32(static_cast<uint32>(message->size()));
+  if (!wrapper->WriteFileDescriptor(handle)) {
+    NOTREACHED() << "Unable to pickle shared memory descriptor.";
+    return message;
+  }
+  delete message;
+  return wrapper.release();
+}
+
 bool ChannelPosix::Send(Message* message) {
   DVLOG(2) << "sending message @" << message << " on channel @" << this
            << " with type " << message->type()
@@ -536,7 +652,8 @@ bool ChannelPosix::Send(Message* message) {
 #endif  // IPC_MESSAGE_LOG_ENABLED
 
   message->TraceMessageBegin();
-  output_queue_.push(message);
+  message = MaybeWrapLargeMessage(message);
+  output_queue_.push_back(message);
   if (!is_blocked_on_write_ && !waiting_connect_) {
     return ProcessOutgoingMessages();
   }
@@ -606,7 +723,7 @@ void ChannelPosix::ResetToAcceptingConnectionState() {
 
   while (!output_queue_.empty()) {
     Message* m = output_queue_.front();
-    output_queue_.pop();
+    output_queue_.pop_front();
     delete m;
   }
 
@@ -776,7 +893,7 @@ void ChannelPosix::QueueHelloMessage() {
     DCHECK_EQ(msg->file_descriptor_set()->size(), 1U);
   }
 #endif  // IPC_USES_READWRITE
-  output_queue_.push(msg.release());
+  output_queue_.push_back(msg.release());
 }
 
 ChannelPosix::ReadState ChannelPosix::ReadData(
@@ -961,7 +1078,7 @@ void ChannelPosix::QueueCloseFDMessage(int fd, int hops) {
         NOTREACHED() << "Unable to pickle close fd.";
       }
       // Send(msg.release());
-      output_queue_.push(msg.release());
+      output_queue_.push_back(msg.release());
       break;
     }
 
@@ -1003,6 +1120,41 @@ void ChannelPosix::HandleInternalMessage(const Message& msg) {
       listener()->OnChannelConnected(pid);
       break;
 
+    case Channel::SHMEM_MESSAGE_TYPE: {
+      // A large message sent out of band. The wrapper carries the payload
+      // size and a descriptor for the region holding the serialized message;
+      // map it, reconstruct the original message and dispatch it as if it
+      // had arrived through the pipe.
+      uint32 payload_size = 0;
+      base::FileDescriptor descriptor;
+      if (!msg.ReadUInt32(&iter, &payload_size) ||
+          !msg.ReadFileDescriptor(&iter, &descriptor)) {
+        NOTREACHED();
+        break;
+      }
+      // Takes ownership of the descriptor and closes it on scope exit.
+      base::SharedMemory shared_memory(descriptor, true /* read_only */);
+      if (payload_size > Channel::kMaximumMessageSize ||
+          !shared_memory.Map(payload_size)) {
+        LOG(ERROR) << "Failed to map out-of-band message of size "
+                   << payload_size;
+        ClosePipeOnError();
+        break;
+      }
+      Message unwrapped(static_cast<const char*>(shared_memory.memory()),
+                        static_cast<int>(payload_size));
+      if (unwrapped.size() != payload_size) {
+        LOG(ERROR) << "Malformed out-of-band message";
+        ClosePipeOnError();
+        break;
+      }
+      unwrapped.TraceMessageEnd();
+      listener()->OnMessageReceived(unwrapped);
+      if (unwrapped.dispatch_error())
+        listener()->OnBadMessageReceived(unwrapped);
+      break;
+    }
+
 #if defined(OS_MACOSX)
     case Channel::CLOSE_FD_MESSAGE_TYPE:
       int fd, hops;
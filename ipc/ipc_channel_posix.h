@@ -9,7 +9,7 @@
 
 #include <sys/socket.h>  // for CMSG macros
 
-#include <queue>
+#include <deque>
 #include <set>
 #include <string>
 #include <vector>
@@ -99,6 +99,12 @@ class IPC_EXPORT ChannelPosix : public Channel,
   void CloseFileDescriptors(Message* msg);
   void QueueCloseFDMessage(int fd, int hops);
 
+  // If |message| is large enough to be worth sending out of band, moves its
+  // payload into a shared memory region and returns a small wrapper message
+  // carrying the region's descriptor, deleting |message|. Otherwise returns
+  // |message| unchanged. Takes ownership of |message| either way.
+  Message* MaybeWrapLargeMessage(Message* message);
+
   // ChannelReader implementation.
   virtual ReadState ReadData(char* buffer,
                              int buffer_len,
@@ -172,7 +178,9 @@ class IPC_EXPORT ChannelPosix : public Channel,
   std::string pipe_name_;
 
   // Messages to be sent are queued here.
-  std::queue<Message*> output_queue_;
+  // Deque (rather than std::queue) so ProcessOutgoingMessages() can walk
+  // the front run of messages when batching them into one sendmsg() call.
+  std::deque<Message*> output_queue_;
 
   // We assume a worst case: kReadBufferSize bytes of messages, where each
   // message has no payload and a full complement of descriptors.
@@ -40,7 +40,7 @@ bool ChannelReader::AsyncReadComplete(int bytes_read) {
 
 bool ChannelReader::IsInternalMessage(const Message& m) const {
   return m.routing_id() == MSG_ROUTING_NONE &&
-      m.type() >= Channel::CLOSE_FD_MESSAGE_TYPE &&
+      m.type() >= Channel::SHMEM_MESSAGE_TYPE &&
       m.type() <= Channel::HELLO_MESSAGE_TYPE;
 }
 
@@ -74,6 +74,20 @@ Message::Message(const Message& other) : Pickle(other) {
 #endif
 }
 
+void Message::Recycle(int32 routing_id, uint32 type, PriorityValue priority) {
+  header()->payload_size = 0;
+  header()->routing = routing_id;
+  header()->type = type;
+  DCHECK((priority & 0xffffff00) == 0);
+  header()->flags = priority | GetRefNumUpper24();
+#if defined(OS_POSIX)
+  header()->num_fds = 0;
+  header()->pad = 0;
+  file_descriptor_set_ = NULL;
+#endif
+  Init();
+}
+
 void Message::Init() {
   dispatch_error_ = false;
 #ifdef IPC_MESSAGE_LOG_ENABLED
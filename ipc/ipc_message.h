@@ -69,6 +69,14 @@ class IPC_EXPORT Message : public Pickle {
   Message(const Message& other);
   Message& operator=(const Message& other);
 
+  // Reinitializes this message in place as if freshly constructed with
+  // (routing_id, type, priority), keeping the payload buffer. Used by
+  // MessagePool to recycle messages without reallocating.
+  void Recycle(int32 routing_id, uint32 type, PriorityValue priority);
+
+  // Capacity of the payload buffer, for MessagePool's size bucketing.
+  size_t payload_capacity() const { return capacity_after_header(); }
+
   PriorityValue priority() const {
     return static_cast<PriorityValue>(header()->flags & PRIORITY_MASK);
   }
@@ -0,0 +1,86 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ipc/ipc_message_pool.h"
+
+#include <vector>
+
+#include "base/basictypes.h"
+#include "base/lazy_instance.h"
+#include "base/synchronization/lock.h"
+
+namespace IPC {
+
+namespace {
+
+// Payload-capacity size classes. Released messages land in the largest
+// class their buffer covers; messages that never grew past the initial
+// Pickle allocation are not worth pooling and are deleted.
+const size_t kSizeClasses[] = { 256, 1024, 4096 };
+const size_t kNumSizeClasses = arraysize(kSizeClasses);
+
+// Per-class cap; at the largest class this bounds the pool at ~256KB.
+const size_t kMaxPooledPerClass = 64;
+
+struct PoolState {
+  base::Lock lock;
+  std::vector<Message*> free_lists[kNumSizeClasses];
+};
+
+base::LazyInstance<PoolState>::Leaky g_pool = LAZY_INSTANCE_INITIALIZER;
+
+}  // namespace
+
+// static
+Message* MessagePool::Acquire(int32 routing_id,
+                              uint32 type,
+                              Message::PriorityValue priority) {
+  PoolState& pool = g_pool.Get();
+  Message* message = NULL;
+  {
+    base::AutoLock lock(pool.lock);
+    // Prefer the smallest pooled buffer; any class satisfies any message
+    // since buffers still grow on demand.
+    for (size_t i = 0; i < kNumSizeClasses; ++i) {
+      if (!pool.free_lists[i].empty()) {
+        message = pool.free_lists[i].back();
+        pool.free_lists[i].pop_back();
+        break;
+      }
+    }
+  }
+  if (!message)
+    return new Message(routing_id, type, priority);
+  message->Recycle(routing_id, type, priority);
+  return message;
+}
+
+// static
+void MessagePool::Release(Message* message) {
+  size_t capacity = message->payload_capacity();
+  // Find the largest class the buffer covers.
+  size_t class_index = kNumSizeClasses;
+  for (size_t i = kNumSizeClasses; i > 0; --i) {
+    if (capacity >= kSizeClasses[i - 1]) {
+      class_index = i - 1;
+      break;
+    }
+  }
+  if (class_index == kNumSizeClasses) {
+    delete message;
+    return;
+  }
+
+  PoolState& pool = g_pool.Get();
+  {
+    base::AutoLock lock(pool.lock);
+    if (pool.free_lists[class_index].size() < kMaxPooledPerClass) {
+      pool.free_lists[class_index].push_back(message);
+      return;
+    }
+  }
+  delete message;
+}
+
+}  // namespace IPC
@@ -0,0 +1,42 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef IPC_IPC_MESSAGE_POOL_H_
+#define IPC_IPC_MESSAGE_POOL_H_
+
+#include "ipc/ipc_export.h"
+#include "ipc/ipc_message.h"
+
+namespace IPC {
+
+// A free list of Message objects bucketed by payload capacity. Every send
+// normally allocates a Message and frees it once the channel has written it;
+// in message-heavy processes (GPU, renderer raster) this is millions of
+// short-lived allocations per minute. Acquire() hands out a recycled message
+// with its buffer intact and its header rebuilt in place, so the common
+// small control message touches malloc only the first time its buffer is
+// grown.
+//
+// Thread safe. Pooled messages are plain Messages; callers that are handed
+// one may treat it exactly like a newly allocated message, including
+// deleting it instead of releasing it back.
+class IPC_EXPORT MessagePool {
+ public:
+  // Returns a message equivalent to |new Message(routing_id, type,
+  // priority)|, reusing a pooled buffer when one is available.
+  static Message* Acquire(int32 routing_id,
+                          uint32 type,
+                          Message::PriorityValue priority);
+
+  // Takes ownership of |message| and either pools it for reuse or deletes
+  // it (size class full, or buffer too small to be worth keeping).
+  static void Release(Message* message);
+
+ private:
+  MessagePool();  // Not instantiable; static interface over a lazy singleton.
+};
+
+}  // namespace IPC
+
+#endif  // IPC_IPC_MESSAGE_POOL_H_
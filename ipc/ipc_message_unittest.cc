@@ -3,6 +3,7 @@
 // found in the LICENSE file.
 
 #include "ipc/ipc_message.h"
+#include "ipc/ipc_message_pool.h"
 
 #include <string.h>
 
@@ -150,3 +151,25 @@ TEST_F(IPCMessageParameterTest, Sync) {
 }*/
 
 }  // namespace
+
+TEST(IPCMessageTest, MessagePoolRecycle) {
+  // Grow a message past the smallest pool size class so it gets pooled.
+  IPC::Message* message = IPC::MessagePool::Acquire(
+      1, 2, IPC::Message::PRIORITY_NORMAL);
+  message->WriteString(std::string(512, 'a'));
+  IPC::MessagePool::Release(message);
+
+  // The recycled message must look freshly constructed.
+  IPC::Message* recycled = IPC::MessagePool::Acquire(
+      3, 4, IPC::Message::PRIORITY_NORMAL);
+  EXPECT_EQ(3, recycled->routing_id());
+  EXPECT_EQ(4u, recycled->type());
+  EXPECT_EQ(sizeof(IPC::Message::Header), recycled->size());
+
+  recycled->WriteInt(42);
+  PickleIterator iter(*recycled);
+  int value = 0;
+  EXPECT_TRUE(recycled->ReadInt(&iter, &value));
+  EXPECT_EQ(42, value);
+  delete recycled;
+}
@@ -339,6 +339,16 @@ void ParamTraits<std::string>::Log(const param_type& p, std::string* l) {
   l->append(p);
 }
 
+void ParamTraits<base::StringPiece>::Log(const param_type& p,
+                                         std::string* l) {
+  p.AppendToString(l);
+}
+
+void ParamTraits<base::StringPiece16>::Log(const param_type& p,
+                                           std::string* l) {
+  l->append(base::UTF16ToUTF8(p.as_string()));
+}
+
 void ParamTraits<std::wstring>::Log(const param_type& p, std::string* l) {
   l->append(base::WideToUTF8(p));
 }
@@ -17,6 +17,7 @@
 #include "base/memory/scoped_ptr.h"
 #include "base/memory/scoped_vector.h"
 #include "base/strings/string16.h"
+#include "base/strings/string_piece.h"
 #include "base/strings/string_util.h"
 #include "base/strings/stringprintf.h"
 #include "base/tuple.h"
@@ -250,6 +251,24 @@ struct ParamTraits<std::string> {
   IPC_EXPORT static void Log(const param_type& p, std::string* l);
 };
 
+// Reading a StringPiece aliases the message payload: the result is valid
+// only while the Message is alive and must be copied if it needs to outlive
+// dispatch. The wire format matches ParamTraits<std::string>, so switching
+// the receiving side of a message to StringPiece skips the deserialization
+// copy without changing the sender.
+template <>
+struct ParamTraits<base::StringPiece> {
+  typedef base::StringPiece param_type;
+  static void Write(Message* m, const param_type& p) {
+    m->WriteData(p.data(), static_cast<int>(p.size()));
+  }
+  static bool Read(const Message* m, PickleIterator* iter,
+                   param_type* r) {
+    return m->ReadStringPiece(iter, r);
+  }
+  IPC_EXPORT static void Log(const param_type& p, std::string* l);
+};
+
 template <>
 struct ParamTraits<std::wstring> {
   typedef std::wstring param_type;
@@ -265,6 +284,21 @@ struct ParamTraits<std::wstring> {
 
 // If WCHAR_T_IS_UTF16 is defined, then string16 is a std::wstring so we don't
 // need this trait.
+template <>
+struct ParamTraits<base::StringPiece16> {
+  typedef base::StringPiece16 param_type;
+  static void Write(Message* m, const param_type& p) {
+    // Matches the WriteString16 wire format: length in characters.
+    m->WriteInt(static_cast<int>(p.size()));
+    m->WriteBytes(p.data(), static_cast<int>(p.size() * sizeof(base::char16)));
+  }
+  static bool Read(const Message* m, PickleIterator* iter,
+                   param_type* r) {
+    return m->ReadStringPiece16(iter, r);
+  }
+  IPC_EXPORT static void Log(const param_type& p, std::string* l);
+};
+
 #if !defined(WCHAR_T_IS_UTF16)
 template <>
 struct ParamTraits<base::string16> {
@@ -10,6 +10,7 @@
 #include "base/strings/string_number_conversions.h"
 #include "build/build_config.h"
 #include "media/audio/audio_output_dispatcher_impl.h"
+#include "media/audio/audio_output_mixer.h"
 #include "media/audio/audio_output_proxy.h"
 #include "media/audio/audio_output_resampler.h"
 #include "media/audio/fake_audio_input_stream.h"
@@ -277,9 +278,16 @@ AudioOutputStream* AudioManagerBase::MakeAudioOutputStreamProxy(
       base::TimeDelta::FromSeconds(kStreamCloseDelaySeconds);
   scoped_refptr<AudioOutputDispatcher> dispatcher;
   if (output_params.format() != AudioParameters::AUDIO_FAKE) {
-    dispatcher = new AudioOutputResampler(this, params, output_params,
-                                          output_device_id,
-                                          kCloseDelay);
+    if (CommandLine::ForCurrentProcess()->HasSwitch(
+            switches::kEnableAudioOutputMixer)) {
+      dispatcher = new AudioOutputMixer(this, params, output_params,
+                                        output_device_id,
+                                        kCloseDelay);
+    } else {
+      dispatcher = new AudioOutputResampler(this, params, output_params,
+                                            output_device_id,
+                                            kCloseDelay);
+    }
   } else {
     dispatcher = new AudioOutputDispatcherImpl(this, output_params,
                                                output_device_id,
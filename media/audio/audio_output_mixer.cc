@@ -0,0 +1,236 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "media/audio/audio_output_mixer.h"
+
+#include <vector>
+
+#include "base/logging.h"
+#include "base/single_thread_task_runner.h"
+#include "media/audio/audio_output_proxy.h"
+#include "media/base/audio_bus.h"
+
+namespace media {
+
+class AudioOutputMixer::MixerInput : public AudioConverter::InputCallback {
+ public:
+  MixerInput(AudioOutputMixer* mixer,
+             AudioOutputStream::AudioSourceCallback* source,
+             double volume)
+      : mixer_(mixer), source_(source), volume_(volume) {}
+  virtual ~MixerInput() {}
+
+  // Must be called with the mixer lock held.
+  void set_volume(double volume) { volume_ = volume; }
+
+  AudioOutputStream::AudioSourceCallback* source() const { return source_; }
+
+  // AudioConverter::InputCallback implementation. Called on the device
+  // thread during Convert(), with the mixer lock held.
+  virtual double ProvideInput(AudioBus* dest,
+                              base::TimeDelta buffer_delay) OVERRIDE {
+    // Adjust playback delay to include |buffer_delay|, expressed in input
+    // terms; mirrors OnMoreDataConverter in AudioOutputResampler.
+    AudioBuffersState new_buffers_state;
+    new_buffers_state.pending_bytes =
+        mixer_->io_ratio_ *
+        (mixer_->current_buffers_state_.total_bytes() +
+         buffer_delay.InSecondsF() * mixer_->input_bytes_per_second_);
+
+    const int frames = source_->OnMoreData(dest, new_buffers_state);
+
+    // Zero any unfilled frames if anything was filled, otherwise return a
+    // volume of zero and let AudioConverter drop the output.
+    if (frames > 0 && frames < dest->frames())
+      dest->ZeroFramesPartial(frames, dest->frames() - frames);
+    return frames > 0 ? volume_ : 0;
+  }
+
+ private:
+  AudioOutputMixer* const mixer_;
+  AudioOutputStream::AudioSourceCallback* const source_;
+  double volume_;
+
+  DISALLOW_COPY_AND_ASSIGN(MixerInput);
+};
+
+AudioOutputMixer::AudioOutputMixer(AudioManager* audio_manager,
+                                   const AudioParameters& input_params,
+                                   const AudioParameters& output_params,
+                                   const std::string& output_device_id,
+                                   const base::TimeDelta& close_delay)
+    : AudioOutputDispatcher(audio_manager, input_params, output_device_id),
+      output_params_(output_params),
+      io_ratio_(input_params.GetBytesPerSecond() /
+                static_cast<double>(output_params.GetBytesPerSecond())),
+      input_bytes_per_second_(input_params.GetBytesPerSecond()),
+      physical_stream_(NULL),
+      open_proxies_(0),
+      playing_proxies_(0),
+      close_timer_(FROM_HERE,
+                   close_delay,
+                   this,
+                   &AudioOutputMixer::ClosePhysicalStream),
+      mixer_(input_params, output_params, false) {
+  DCHECK(input_params.IsValid());
+  DCHECK(output_params.IsValid());
+}
+
+AudioOutputMixer::~AudioOutputMixer() {
+  DCHECK(!physical_stream_);
+  DCHECK(inputs_.empty());
+}
+
+bool AudioOutputMixer::OpenStream() {
+  DCHECK(task_runner_->BelongsToCurrentThread());
+
+  if (!physical_stream_ && !CreateAndOpenPhysicalStream())
+    return false;
+
+  ++open_proxies_;
+  close_timer_.Reset();
+  return true;
+}
+
+bool AudioOutputMixer::StartStream(
+    AudioOutputStream::AudioSourceCallback* callback,
+    AudioOutputProxy* stream_proxy) {
+  DCHECK(task_runner_->BelongsToCurrentThread());
+  DCHECK(inputs_.find(stream_proxy) == inputs_.end());
+
+  // The physical stream may have been closed by the idle timer.
+  if (!physical_stream_ && !CreateAndOpenPhysicalStream())
+    return false;
+
+  double volume = 0;
+  stream_proxy->GetVolume(&volume);
+  MixerInput* input = new MixerInput(this, callback, volume);
+  {
+    base::AutoLock lock(lock_);
+    inputs_[stream_proxy] = input;
+    mixer_.AddInput(input);
+  }
+
+  if (++playing_proxies_ == 1)
+    physical_stream_->Start(this);
+
+  close_timer_.Reset();
+  return true;
+}
+
+void AudioOutputMixer::StopStream(AudioOutputProxy* stream_proxy) {
+  DCHECK(task_runner_->BelongsToCurrentThread());
+
+  MixerInput* input = NULL;
+  {
+    base::AutoLock lock(lock_);
+    InputMap::iterator it = inputs_.find(stream_proxy);
+    if (it == inputs_.end())
+      return;
+    input = it->second;
+    mixer_.RemoveInput(input);
+    inputs_.erase(it);
+  }
+  delete input;
+
+  DCHECK_GT(playing_proxies_, 0u);
+  if (--playing_proxies_ == 0 && physical_stream_)
+    physical_stream_->Stop();
+
+  close_timer_.Reset();
+}
+
+void AudioOutputMixer::StreamVolumeSet(AudioOutputProxy* stream_proxy,
+                                       double volume) {
+  DCHECK(task_runner_->BelongsToCurrentThread());
+
+  base::AutoLock lock(lock_);
+  InputMap::iterator it = inputs_.find(stream_proxy);
+  if (it != inputs_.end())
+    it->second->set_volume(volume);
+}
+
+void AudioOutputMixer::CloseStream(AudioOutputProxy* stream_proxy) {
+  DCHECK(task_runner_->BelongsToCurrentThread());
+
+  // A proxy in an error state may be closed while it still has an input.
+  StopStream(stream_proxy);
+
+  DCHECK_GT(open_proxies_, 0u);
+  --open_proxies_;
+  close_timer_.Reset();
+}
+
+void AudioOutputMixer::Shutdown() {
+  DCHECK(task_runner_->BelongsToCurrentThread());
+
+  if (physical_stream_) {
+    if (playing_proxies_ > 0)
+      physical_stream_->Stop();
+    physical_stream_->Close();
+    physical_stream_ = NULL;
+  }
+
+  // All proxies should have been closed by this point; drop any stragglers
+  // so the destructor's invariants hold.
+  base::AutoLock lock(lock_);
+  for (InputMap::iterator it = inputs_.begin(); it != inputs_.end(); ++it) {
+    mixer_.RemoveInput(it->second);
+    delete it->second;
+  }
+  inputs_.clear();
+}
+
+int AudioOutputMixer::OnMoreData(AudioBus* dest,
+                                 AudioBuffersState buffers_state) {
+  base::AutoLock lock(lock_);
+  current_buffers_state_ = buffers_state;
+  mixer_.Convert(dest);
+
+  // Always return the full number of frames requested; the inputs pad with
+  // silence when their sources run dry.
+  return dest->frames();
+}
+
+void AudioOutputMixer::OnError(AudioOutputStream* stream) {
+  std::vector<AudioOutputStream::AudioSourceCallback*> sources;
+  {
+    base::AutoLock lock(lock_);
+    for (InputMap::iterator it = inputs_.begin(); it != inputs_.end(); ++it)
+      sources.push_back(it->second->source());
+  }
+  for (size_t i = 0; i < sources.size(); ++i)
+    sources[i]->OnError(stream);
+}
+
+bool AudioOutputMixer::CreateAndOpenPhysicalStream() {
+  DCHECK(task_runner_->BelongsToCurrentThread());
+  DCHECK(!physical_stream_);
+
+  AudioOutputStream* stream =
+      audio_manager_->MakeAudioOutputStream(output_params_, device_id_);
+  if (!stream)
+    return false;
+
+  if (!stream->Open()) {
+    stream->Close();
+    return false;
+  }
+
+  // Per-proxy volume is applied while mixing.
+  stream->SetVolume(1.0);
+  physical_stream_ = stream;
+  return true;
+}
+
+void AudioOutputMixer::ClosePhysicalStream() {
+  DCHECK(task_runner_->BelongsToCurrentThread());
+
+  if (playing_proxies_ == 0 && physical_stream_) {
+    physical_stream_->Close();
+    physical_stream_ = NULL;
+  }
+}
+
+}  // namespace media
@@ -0,0 +1,109 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef MEDIA_AUDIO_AUDIO_OUTPUT_MIXER_H_
+#define MEDIA_AUDIO_AUDIO_OUTPUT_MIXER_H_
+
+#include <map>
+
+#include "base/basictypes.h"
+#include "base/memory/ref_counted.h"
+#include "base/synchronization/lock.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+#include "media/audio/audio_io.h"
+#include "media/audio/audio_manager.h"
+#include "media/audio/audio_output_dispatcher.h"
+#include "media/audio/audio_parameters.h"
+#include "media/base/audio_converter.h"
+
+namespace media {
+
+class AudioOutputProxy;
+
+// AudioOutputMixer is a browser-side mixing solution which funnels every
+// proxy of a dispatcher into a single physical output stream, instead of
+// opening one physical stream per playing proxy. The streams are mixed (and
+// converted to the hardware parameters) with an AudioConverter on the device
+// callback thread; per-stream volume is applied during mixing, so the
+// physical stream's own volume stays at 1.0. The physical stream is opened
+// on demand and closed again once it has been idle for |close_delay|.
+class MEDIA_EXPORT AudioOutputMixer
+    : public AudioOutputDispatcher,
+      public AudioOutputStream::AudioSourceCallback {
+ public:
+  AudioOutputMixer(AudioManager* audio_manager,
+                   const AudioParameters& input_params,
+                   const AudioParameters& output_params,
+                   const std::string& output_device_id,
+                   const base::TimeDelta& close_delay);
+
+  // AudioOutputDispatcher interface.
+  virtual bool OpenStream() OVERRIDE;
+  virtual bool StartStream(AudioOutputStream::AudioSourceCallback* callback,
+                           AudioOutputProxy* stream_proxy) OVERRIDE;
+  virtual void StopStream(AudioOutputProxy* stream_proxy) OVERRIDE;
+  virtual void StreamVolumeSet(AudioOutputProxy* stream_proxy,
+                               double volume) OVERRIDE;
+  virtual void CloseStream(AudioOutputProxy* stream_proxy) OVERRIDE;
+  virtual void Shutdown() OVERRIDE;
+
+  // AudioOutputStream::AudioSourceCallback interface, invoked on the device
+  // thread of the physical stream.
+  virtual int OnMoreData(AudioBus* dest,
+                         AudioBuffersState buffers_state) OVERRIDE;
+  virtual void OnError(AudioOutputStream* stream) OVERRIDE;
+
+ private:
+  friend class base::RefCountedThreadSafe<AudioOutputMixer>;
+  virtual ~AudioOutputMixer();
+
+  // Adapts the AudioSourceCallback of one proxy to an AudioConverter input,
+  // applying the proxy's volume.
+  class MixerInput;
+
+  // Opens the physical output stream, returning false on failure.
+  bool CreateAndOpenPhysicalStream();
+
+  // Closes the physical stream if no proxy has played for |close_delay|;
+  // invoked by |close_timer_|. A later StartStream() reopens it.
+  void ClosePhysicalStream();
+
+  // AudioParameters of the physical output stream.
+  const AudioParameters output_params_;
+
+  // Ratio of input bytes per second to output bytes per second, used to
+  // translate the physical stream's delay into input terms.
+  const double io_ratio_;
+  const int input_bytes_per_second_;
+
+  // The single physical stream all proxies are mixed into. NULL when closed.
+  AudioOutputStream* physical_stream_;
+
+  size_t open_proxies_;
+  size_t playing_proxies_;
+
+  // Fires ClosePhysicalStream() after the stream has been idle for a while;
+  // reset on every proxy start, stop and close.
+  base::DelayTimer<AudioOutputMixer> close_timer_;
+
+  // Guards |mixer_|, |current_buffers_state_|, |inputs_| and the volume of
+  // each input against the device thread.
+  base::Lock lock_;
+
+  AudioConverter mixer_;
+
+  // Last AudioBuffersState received from the physical stream, used by the
+  // inputs to report playback delay to their sources.
+  AudioBuffersState current_buffers_state_;
+
+  typedef std::map<AudioOutputProxy*, MixerInput*> InputMap;
+  InputMap inputs_;
+
+  DISALLOW_COPY_AND_ASSIGN(AudioOutputMixer);
+};
+
+}  // namespace media
+
+#endif  // MEDIA_AUDIO_AUDIO_OUTPUT_MIXER_H_
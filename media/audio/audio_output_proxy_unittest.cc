@@ -9,6 +9,7 @@
 #include "media/audio/audio_manager.h"
 #include "media/audio/audio_manager_base.h"
 #include "media/audio/audio_output_dispatcher_impl.h"
+#include "media/audio/audio_output_mixer.h"
 #include "media/audio/audio_output_proxy.h"
 #include "media/audio/audio_output_resampler.h"
 #include "media/audio/fake_audio_log_factory.h"
@@ -444,6 +445,27 @@ class AudioOutputResamplerTest : public AudioOutputProxyTest {
   scoped_refptr<AudioOutputResampler> resampler_;
 };
 
+class AudioOutputMixerTest : public AudioOutputProxyTest {
+ public:
+  virtual void InitDispatcher(base::TimeDelta close_delay) OVERRIDE {
+    mixer_ = new AudioOutputMixer(
+        &manager(), params_, params_, std::string(), close_delay);
+  }
+
+  virtual void OnStart() OVERRIDE {
+    // Let Start() run for a bit so a few mixed OnMoreData callbacks occur.
+    base::RunLoop run_loop;
+    message_loop_.PostDelayedTask(
+        FROM_HERE,
+        run_loop.QuitClosure(),
+        base::TimeDelta::FromMilliseconds(kStartRunTimeMs));
+    run_loop.Run();
+  }
+
+ protected:
+  scoped_refptr<AudioOutputMixer> mixer_;
+};
+
 TEST_F(AudioOutputProxyTest, CreateAndClose) {
   AudioOutputProxy* proxy = new AudioOutputProxy(dispatcher_impl_);
   proxy->Close();
@@ -454,6 +476,11 @@ TEST_F(AudioOutputResamplerTest, CreateAndClose) {
   proxy->Close();
 }
 
+TEST_F(AudioOutputMixerTest, CreateAndClose) {
+  AudioOutputProxy* proxy = new AudioOutputProxy(mixer_);
+  proxy->Close();
+}
+
 TEST_F(AudioOutputProxyTest, OpenAndClose) {
   OpenAndClose(dispatcher_impl_);
 }
@@ -462,6 +489,10 @@ TEST_F(AudioOutputResamplerTest, OpenAndClose) {
   OpenAndClose(resampler_);
 }
 
+TEST_F(AudioOutputMixerTest, OpenAndClose) {
+  OpenAndClose(mixer_);
+}
+
 // Create a stream, and verify that it is closed after kTestCloseDelayMs.
 // if it doesn't start playing.
 TEST_F(AudioOutputProxyTest, CreateAndWait) {
@@ -482,6 +513,10 @@ TEST_F(AudioOutputResamplerTest, StartAndStop) {
   StartAndStop(resampler_);
 }
 
+TEST_F(AudioOutputMixerTest, StartAndStop) {
+  StartAndStop(mixer_);
+}
+
 TEST_F(AudioOutputProxyTest, CloseAfterStop) {
   CloseAfterStop(dispatcher_impl_);
 }
@@ -490,10 +525,16 @@ TEST_F(AudioOutputResamplerTest, CloseAfterStop) {
   CloseAfterStop(resampler_);
 }
 
+TEST_F(AudioOutputMixerTest, CloseAfterStop) {
+  CloseAfterStop(mixer_);
+}
+
 TEST_F(AudioOutputProxyTest, TwoStreams) { TwoStreams(dispatcher_impl_); }
 
 TEST_F(AudioOutputResamplerTest, TwoStreams) { TwoStreams(resampler_); }
 
+TEST_F(AudioOutputMixerTest, TwoStreams) { TwoStreams(mixer_); }
+
 // Two streams: verify that second stream is allocated when the first
 // starts playing.
 TEST_F(AudioOutputProxyTest, OneStream_TwoPlays) {
@@ -513,6 +554,35 @@ TEST_F(AudioOutputResamplerTest, TwoStreams_BothPlaying) {
   TwoStreams_BothPlaying(resampler_);
 }
 
+// Two streams, both are playing. The mixer must keep funneling both into the
+// single physical stream instead of opening a second one.
+TEST_F(AudioOutputMixerTest, TwoStreams_BothPlaying) {
+  MockAudioOutputStream stream(&manager_, params_);
+
+  EXPECT_CALL(manager(), MakeAudioOutputStream(_, _))
+      .WillOnce(Return(&stream));
+  EXPECT_CALL(stream, Open())
+      .WillOnce(Return(true));
+  EXPECT_CALL(stream, SetVolume(_))
+      .Times(1);
+
+  AudioOutputProxy* proxy1 = new AudioOutputProxy(mixer_);
+  AudioOutputProxy* proxy2 = new AudioOutputProxy(mixer_);
+  EXPECT_TRUE(proxy1->Open());
+  EXPECT_TRUE(proxy2->Open());
+
+  proxy1->Start(&callback_);
+  proxy2->Start(&callback_);
+  OnStart();
+  proxy1->Stop();
+  proxy2->Stop();
+
+  proxy1->Close();
+  CloseAndWaitForCloseTimer(proxy2, &stream);
+  EXPECT_TRUE(stream.stop_called());
+  EXPECT_TRUE(stream.start_called());
+}
+
 TEST_F(AudioOutputProxyTest, OpenFailed) { OpenFailed(dispatcher_impl_); }
 
 // Start() method failed.
@@ -522,6 +592,8 @@ TEST_F(AudioOutputProxyTest, StartFailed) {
 
 TEST_F(AudioOutputResamplerTest, StartFailed) { StartFailed(resampler_); }
 
+TEST_F(AudioOutputMixerTest, StartFailed) { StartFailed(mixer_); }
+
 // Simulate AudioOutputStream::Create() failure with a low latency stream and
 // ensure AudioOutputResampler falls back to the high latency path.
 TEST_F(AudioOutputResamplerTest, LowLatencyCreateFailedFallback) {
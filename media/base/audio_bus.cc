@@ -6,10 +6,20 @@
 
 #include "base/logging.h"
 #include "base/numerics/safe_conversions.h"
+#include "build/build_config.h"
 #include "media/audio/audio_parameters.h"
 #include "media/base/limits.h"
 #include "media/base/vector_math.h"
 
+// NaCl does not allow intrinsics.
+#if defined(ARCH_CPU_X86_FAMILY) && !defined(OS_NACL)
+#include <emmintrin.h>
+#define INTERLEAVE_SIMD_ENABLED
+#elif defined(ARCH_CPU_ARM_FAMILY) && defined(USE_NEON)
+#include <arm_neon.h>
+#define INTERLEAVE_SIMD_ENABLED
+#endif
+
 namespace media {
 
 static const uint8 kUint8Bias = 128;
@@ -83,6 +93,116 @@ static void ToInterleavedInternal(const AudioBus* source, int start_frame,
   }
 }
 
+// SIMD variants of the stereo int16 conversions, the hot path for low latency
+// output and capture.  Each processes four frames per pass and returns how
+// many frames were handled; callers must convert the remainder with the
+// scalar templates above.  Results match the templates exactly: negative
+// samples are scaled by -kint16min and positive ones by kint16max, with
+// truncation toward zero and inputs clamped to [-1, 1].
+#if defined(ARCH_CPU_X86_FAMILY) && !defined(OS_NACL)
+static int ToInterleavedInt16Stereo_SIMD(const float* left,
+                                         const float* right,
+                                         int frames,
+                                         int16* dest) {
+  const int simd_frames = frames & ~3;
+  const __m128 one = _mm_set_ps1(1.0f);
+  const __m128 neg_one = _mm_set_ps1(-1.0f);
+  const __m128 zero = _mm_setzero_ps();
+  const __m128 neg_scale = _mm_set_ps1(-static_cast<float>(kint16min));
+  const __m128 pos_scale = _mm_set_ps1(static_cast<float>(kint16max));
+  for (int i = 0; i < simd_frames; i += 4) {
+    __m128 l = _mm_max_ps(_mm_min_ps(_mm_loadu_ps(left + i), one), neg_one);
+    __m128 r = _mm_max_ps(_mm_min_ps(_mm_loadu_ps(right + i), one), neg_one);
+    const __m128 l_mask = _mm_cmplt_ps(l, zero);
+    const __m128 r_mask = _mm_cmplt_ps(r, zero);
+    l = _mm_mul_ps(l, _mm_or_ps(_mm_and_ps(l_mask, neg_scale),
+                                _mm_andnot_ps(l_mask, pos_scale)));
+    r = _mm_mul_ps(r, _mm_or_ps(_mm_and_ps(r_mask, neg_scale),
+                                _mm_andnot_ps(r_mask, pos_scale)));
+    const __m128i l_int = _mm_cvttps_epi32(l);
+    const __m128i r_int = _mm_cvttps_epi32(r);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + 2 * i),
+                     _mm_unpacklo_epi16(_mm_packs_epi32(l_int, l_int),
+                                        _mm_packs_epi32(r_int, r_int)));
+  }
+  return simd_frames;
+}
+
+static int FromInterleavedInt16Stereo_SIMD(const int16* source,
+                                           int frames,
+                                           float* left,
+                                           float* right) {
+  const int simd_frames = frames & ~3;
+  const __m128 zero = _mm_setzero_ps();
+  const __m128 neg_scale = _mm_set_ps1(-1.0f / kint16min);
+  const __m128 pos_scale = _mm_set_ps1(1.0f / kint16max);
+  for (int i = 0; i < simd_frames; i += 4) {
+    const __m128i in = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(source + 2 * i));
+    // Sign extend the 16 bit samples to 32 bits.
+    const __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(in, in), 16);
+    const __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(in, in), 16);
+    // |f_lo| is now l0 r0 l1 r1 and |f_hi| is l2 r2 l3 r3.
+    const __m128 f_lo = _mm_cvtepi32_ps(lo);
+    const __m128 f_hi = _mm_cvtepi32_ps(hi);
+    __m128 l = _mm_shuffle_ps(f_lo, f_hi, _MM_SHUFFLE(2, 0, 2, 0));
+    __m128 r = _mm_shuffle_ps(f_lo, f_hi, _MM_SHUFFLE(3, 1, 3, 1));
+    const __m128 l_mask = _mm_cmplt_ps(l, zero);
+    const __m128 r_mask = _mm_cmplt_ps(r, zero);
+    l = _mm_mul_ps(l, _mm_or_ps(_mm_and_ps(l_mask, neg_scale),
+                                _mm_andnot_ps(l_mask, pos_scale)));
+    r = _mm_mul_ps(r, _mm_or_ps(_mm_and_ps(r_mask, neg_scale),
+                                _mm_andnot_ps(r_mask, pos_scale)));
+    _mm_storeu_ps(left + i, l);
+    _mm_storeu_ps(right + i, r);
+  }
+  return simd_frames;
+}
+#elif defined(ARCH_CPU_ARM_FAMILY) && defined(USE_NEON)
+static int ToInterleavedInt16Stereo_SIMD(const float* left,
+                                         const float* right,
+                                         int frames,
+                                         int16* dest) {
+  const int simd_frames = frames & ~3;
+  const float32x4_t one = vdupq_n_f32(1.0f);
+  const float32x4_t neg_one = vdupq_n_f32(-1.0f);
+  const float32x4_t zero = vdupq_n_f32(0.0f);
+  const float32x4_t neg_scale = vdupq_n_f32(-static_cast<float>(kint16min));
+  const float32x4_t pos_scale = vdupq_n_f32(static_cast<float>(kint16max));
+  for (int i = 0; i < simd_frames; i += 4) {
+    float32x4_t l = vmaxq_f32(vminq_f32(vld1q_f32(left + i), one), neg_one);
+    float32x4_t r = vmaxq_f32(vminq_f32(vld1q_f32(right + i), one), neg_one);
+    l = vmulq_f32(l, vbslq_f32(vcltq_f32(l, zero), neg_scale, pos_scale));
+    r = vmulq_f32(r, vbslq_f32(vcltq_f32(r, zero), neg_scale, pos_scale));
+    int16x4x2_t result;
+    result.val[0] = vqmovn_s32(vcvtq_s32_f32(l));
+    result.val[1] = vqmovn_s32(vcvtq_s32_f32(r));
+    vst2_s16(dest + 2 * i, result);
+  }
+  return simd_frames;
+}
+
+static int FromInterleavedInt16Stereo_SIMD(const int16* source,
+                                           int frames,
+                                           float* left,
+                                           float* right) {
+  const int simd_frames = frames & ~3;
+  const float32x4_t zero = vdupq_n_f32(0.0f);
+  const float32x4_t neg_scale = vdupq_n_f32(-1.0f / kint16min);
+  const float32x4_t pos_scale = vdupq_n_f32(1.0f / kint16max);
+  for (int i = 0; i < simd_frames; i += 4) {
+    const int16x4x2_t in = vld2_s16(source + 2 * i);
+    float32x4_t l = vcvtq_f32_s32(vmovl_s16(in.val[0]));
+    float32x4_t r = vcvtq_f32_s32(vmovl_s16(in.val[1]));
+    l = vmulq_f32(l, vbslq_f32(vcltq_f32(l, zero), neg_scale, pos_scale));
+    r = vmulq_f32(r, vbslq_f32(vcltq_f32(r, zero), neg_scale, pos_scale));
+    vst1q_f32(left + i, l);
+    vst1q_f32(right + i, r);
+  }
+  return simd_frames;
+}
+#endif
+
 static void ValidateConfig(int channels, int frames) {
   CHECK_GT(frames, 0);
   CHECK_GT(channels, 0);
@@ -236,10 +356,21 @@ void AudioBus::BuildChannelData(int channels, int aligned_frames, float* data) {
     channel_data_.push_back(data + i * aligned_frames);
 }
 
-// TODO(dalecurtis): See if intrinsic optimizations help any here.
 void AudioBus::FromInterleavedPartial(const void* source, int start_frame,
                                       int frames, int bytes_per_sample) {
   CheckOverflow(start_frame, frames, frames_);
+
+  // Bulk convert stereo int16 data with SIMD when available; the scalar
+  // template below picks up any leftover frames.
+  int simd_frames = 0;
+#if defined(INTERLEAVE_SIMD_ENABLED)
+  if (bytes_per_sample == 2 && channels() == 2) {
+    simd_frames = FromInterleavedInt16Stereo_SIMD(
+        static_cast<const int16*>(source), frames, channel(0) + start_frame,
+        channel(1) + start_frame);
+  }
+#endif
+
   switch (bytes_per_sample) {
     case 1:
       FromInterleavedInternal<uint8, int16, kUint8Bias>(
@@ -248,7 +379,8 @@ void AudioBus::FromInterleavedPartial(const void* source, int start_frame,
       break;
     case 2:
       FromInterleavedInternal<int16, int16, 0>(
-          source, start_frame, frames, this,
+          static_cast<const int16*>(source) + simd_frames * channels(),
+          start_frame + simd_frames, frames - simd_frames, this,
           1.0f / kint16min, 1.0f / kint16max);
       break;
     case 4:
@@ -279,10 +411,21 @@ void AudioBus::ToInterleaved(int frames, int bytes_per_sample,
   ToInterleavedPartial(0, frames, bytes_per_sample, dest);
 }
 
-// TODO(dalecurtis): See if intrinsic optimizations help any here.
 void AudioBus::ToInterleavedPartial(int start_frame, int frames,
                                     int bytes_per_sample, void* dest) const {
   CheckOverflow(start_frame, frames, frames_);
+
+  // Bulk convert stereo int16 data with SIMD when available; the scalar
+  // template below picks up any leftover frames.
+  int simd_frames = 0;
+#if defined(INTERLEAVE_SIMD_ENABLED)
+  if (bytes_per_sample == 2 && channels() == 2) {
+    simd_frames = ToInterleavedInt16Stereo_SIMD(
+        channel(0) + start_frame, channel(1) + start_frame, frames,
+        static_cast<int16*>(dest));
+  }
+#endif
+
   switch (bytes_per_sample) {
     case 1:
       ToInterleavedInternal<uint8, int16, kUint8Bias>(
@@ -290,7 +433,9 @@ void AudioBus::ToInterleavedPartial(int start_frame, int frames,
       break;
     case 2:
       ToInterleavedInternal<int16, int16, 0>(
-          this, start_frame, frames, dest, kint16min, kint16max);
+          this, start_frame + simd_frames, frames - simd_frames,
+          static_cast<int16*>(dest) + simd_frames * channels(),
+          kint16min, kint16max);
       break;
     case 4:
       ToInterleavedInternal<int32, int32, 0>(
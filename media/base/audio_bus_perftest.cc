@@ -4,6 +4,7 @@
 
 #include "base/time/time.h"
 #include "media/base/audio_bus.h"
+#include "media/base/channel_mixer.h"
 #include "media/base/fake_audio_render_callback.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "testing/perf/perf_test.h"
@@ -50,4 +51,34 @@ TEST(AudioBusPerfTest, Interleave) {
   RunInterleaveBench<int32>(bus.get(), "int32");
 }
 
+void RunChannelMixerBench(ChannelLayout input_layout,
+                          ChannelLayout output_layout,
+                          const std::string& trace_name) {
+  const int kFrames = 48000 * 120;
+  scoped_ptr<AudioBus> input = AudioBus::Create(
+      ChannelLayoutToChannelCount(input_layout), kFrames);
+  scoped_ptr<AudioBus> output = AudioBus::Create(
+      ChannelLayoutToChannelCount(output_layout), kFrames);
+  FakeAudioRenderCallback callback(0.2);
+  callback.Render(input.get(), 0);
+
+  ChannelMixer mixer(input_layout, output_layout);
+  base::TimeTicks start = base::TimeTicks::HighResNow();
+  for (int i = 0; i < kBenchmarkIterations; ++i)
+    mixer.Transform(input.get(), output.get());
+  double total_time_milliseconds =
+      (base::TimeTicks::HighResNow() - start).InMillisecondsF();
+  perf_test::PrintResult(
+      "audio_bus_channel_mixer", "", trace_name,
+      total_time_milliseconds / kBenchmarkIterations, "ms", true);
+}
+
+// Benchmark the channel matrix multiply in ChannelMixer::Transform().
+TEST(AudioBusPerfTest, ChannelMixer) {
+  RunChannelMixerBench(CHANNEL_LAYOUT_5_1, CHANNEL_LAYOUT_STEREO,
+                       "5_1_to_stereo");
+  RunChannelMixerBench(CHANNEL_LAYOUT_STEREO, CHANNEL_LAYOUT_MONO,
+                       "stereo_to_mono");
+}
+
 } // namespace media
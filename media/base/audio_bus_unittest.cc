@@ -382,6 +382,37 @@ TEST_F(AudioBusTest, ToInterleavedPartial) {
       kPartialFrames * sizeof(*kTestVectorInt16) * kTestVectorChannels), 0);
 }
 
+// Verify that bulk stereo int16 conversion (which may use SIMD) produces the
+// same samples as converting one frame at a time (which never does).
+TEST_F(AudioBusTest, Int16StereoBulkMatchesSingleFrames) {
+  // Not a multiple of the SIMD width, so a scalar remainder is exercised too.
+  static const int kFrames = 67;
+  scoped_ptr<AudioBus> bus = AudioBus::Create(2, kFrames);
+
+  // Fill with a deterministic pattern spanning [-1.2, 1.2] so both clipped
+  // and in-range values are covered.
+  for (int ch = 0; ch < bus->channels(); ++ch) {
+    for (int i = 0; i < kFrames; ++i)
+      bus->channel(ch)[i] = ((i * 5 + ch * 3) % 13 - 6) / 5.0f;
+  }
+
+  int16 bulk[kFrames * 2];
+  bus->ToInterleaved(kFrames, sizeof(*bulk), bulk);
+
+  int16 single[kFrames * 2];
+  for (int i = 0; i < kFrames; ++i)
+    bus->ToInterleavedPartial(i, 1, sizeof(*single), single + i * 2);
+  ASSERT_EQ(0, memcmp(bulk, single, sizeof(bulk)));
+
+  scoped_ptr<AudioBus> bulk_bus = AudioBus::Create(2, kFrames);
+  scoped_ptr<AudioBus> single_bus = AudioBus::Create(2, kFrames);
+  bulk_bus->FromInterleaved(bulk, kFrames, sizeof(*bulk));
+  single_bus->Zero();
+  for (int i = 0; i < kFrames; ++i)
+    single_bus->FromInterleavedPartial(bulk + i * 2, i, 1, sizeof(*bulk));
+  VerifyBus(bulk_bus.get(), single_bus.get());
+}
+
 TEST_F(AudioBusTest, Scale) {
   scoped_ptr<AudioBus> bus = AudioBus::Create(kChannels, kFrameCount);
 
@@ -0,0 +1,123 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "media/base/lock_free_audio_fifo.h"
+
+#include "base/logging.h"
+
+namespace media {
+
+// Given current position in the FIFO, the total number of slots and the size
+// of the input, computes the sizes of the two memcpy segments needed to copy
+// to or from the ring buffer.  |wrap_size| is zero unless the copy crosses
+// the end of the buffer.  Mirrors the helper in audio_fifo.cc.
+static void GetSizes(
+    int pos, int max_size, int in_size, int* size, int* wrap_size) {
+  if (pos + in_size > max_size) {
+    *size = max_size - pos;
+    *wrap_size = in_size - *size;
+  } else {
+    *size = in_size;
+    *wrap_size = 0;
+  }
+}
+
+LockFreeAudioFifo::LockFreeAudioFifo(int channels, int frames)
+    : audio_bus_(AudioBus::Create(channels, frames)),
+      size_(frames),
+      read_pos_(0),
+      write_pos_(0) {
+  CHECK_GT(frames, 1);
+}
+
+LockFreeAudioFifo::~LockFreeAudioFifo() {}
+
+int LockFreeAudioFifo::frames() const {
+  const int write_pos = base::subtle::Acquire_Load(&write_pos_);
+  const int read_pos = base::subtle::Acquire_Load(&read_pos_);
+  return (write_pos - read_pos + size_) % size_;
+}
+
+int LockFreeAudioFifo::unfilled_frames() const {
+  return max_frames() - frames();
+}
+
+bool LockFreeAudioFifo::Push(const AudioBus* source) {
+  DCHECK(source);
+  DCHECK_EQ(source->channels(), audio_bus_->channels());
+
+  // |write_pos_| is only written by this thread, so a plain load suffices.
+  // The acquire load of |read_pos_| pairs with the consumer's release store
+  // and guarantees the consumer is done reading the frames we may overwrite.
+  const int source_size = source->frames();
+  const int write_pos = base::subtle::NoBarrier_Load(&write_pos_);
+  const int read_pos = base::subtle::Acquire_Load(&read_pos_);
+  const int unfilled = (read_pos - write_pos - 1 + size_) % size_;
+  if (source_size > unfilled)
+    return false;
+
+  int append_size = 0;
+  int wrap_size = 0;
+  GetSizes(write_pos, size_, source_size, &append_size, &wrap_size);
+
+  // Copy all channels from the source to the FIFO.  Wrap around if needed.
+  for (int ch = 0; ch < source->channels(); ++ch) {
+    float* dest = audio_bus_->channel(ch);
+    const float* src = source->channel(ch);
+    memcpy(&dest[write_pos], &src[0], append_size * sizeof(src[0]));
+    if (wrap_size > 0)
+      memcpy(&dest[0], &src[append_size], wrap_size * sizeof(src[0]));
+  }
+
+  // Publish the new frames only after they have been fully copied.
+  base::subtle::Release_Store(&write_pos_, (write_pos + source_size) % size_);
+  return true;
+}
+
+bool LockFreeAudioFifo::Consume(AudioBus* destination,
+                                int start_frame,
+                                int frames_to_consume) {
+  DCHECK(destination);
+  DCHECK_EQ(destination->channels(), audio_bus_->channels());
+  DCHECK_LE(frames_to_consume + start_frame, destination->frames());
+
+  // |read_pos_| is only written by this thread, so a plain load suffices.
+  // The acquire load of |write_pos_| pairs with the producer's release store
+  // and guarantees the frames we are about to read are fully written.
+  const int read_pos = base::subtle::NoBarrier_Load(&read_pos_);
+  const int write_pos = base::subtle::Acquire_Load(&write_pos_);
+  const int available = (write_pos - read_pos + size_) % size_;
+  if (frames_to_consume > available)
+    return false;
+
+  int consume_size = 0;
+  int wrap_size = 0;
+  GetSizes(read_pos, size_, frames_to_consume, &consume_size, &wrap_size);
+
+  // Copy the requested amount of data from the FIFO to the destination for
+  // all channels.  Wrap around if needed.
+  for (int ch = 0; ch < destination->channels(); ++ch) {
+    float* dest = destination->channel(ch);
+    const float* src = audio_bus_->channel(ch);
+    memcpy(&dest[start_frame], &src[read_pos], consume_size * sizeof(src[0]));
+    if (wrap_size > 0) {
+      memcpy(&dest[consume_size + start_frame], &src[0],
+             wrap_size * sizeof(src[0]));
+    }
+  }
+
+  // Release the consumed slots only after they have been fully read.
+  base::subtle::Release_Store(&read_pos_,
+                              (read_pos + frames_to_consume) % size_);
+  return true;
+}
+
+void LockFreeAudioFifo::Clear() {
+  // Dropping everything currently in the FIFO is a consume of all available
+  // frames, so it is only safe on the consumer thread.
+  base::subtle::Release_Store(&read_pos_,
+                              base::subtle::Acquire_Load(&write_pos_));
+}
+
+}  // namespace media
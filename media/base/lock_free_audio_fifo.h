@@ -0,0 +1,80 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef MEDIA_BASE_LOCK_FREE_AUDIO_FIFO_H_
+#define MEDIA_BASE_LOCK_FREE_AUDIO_FIFO_H_
+
+#include "base/atomicops.h"
+#include "media/base/audio_bus.h"
+#include "media/base/media_export.h"
+
+namespace media {
+
+// A wait-free single-producer single-consumer FIFO for AudioBus data.
+//
+// Unlike AudioFifo, which requires external locking when shared between
+// threads, this FIFO may be used concurrently by exactly one producer thread
+// (calling Push()) and one consumer thread (calling Consume()) without any
+// locks, so the consumer may live on a realtime OS audio callback which must
+// never block.  Each side owns its position index and publishes it with a
+// release store only after the audio data has been copied; the two indices
+// are kept on separate cache lines to avoid false sharing between the
+// threads.
+//
+// One frame of capacity is sacrificed to distinguish a full FIFO from an
+// empty one, so a FIFO created with |frames| can hold |frames| - 1 frames.
+class MEDIA_EXPORT LockFreeAudioFifo {
+ public:
+  // Creates a new FIFO with |channels| channels and room for |frames| - 1
+  // audio frames.
+  LockFreeAudioFifo(int channels, int frames);
+  ~LockFreeAudioFifo();
+
+  // Pushes all audio channel data from |source| to the FIFO.  Returns false
+  // without copying anything if there is insufficient space.  Must only be
+  // called from the producer thread.
+  bool Push(const AudioBus* source);
+
+  // Consumes |frames_to_consume| audio frames from the FIFO and copies them
+  // to |destination| starting at position |start_frame|.  Returns false
+  // without copying anything if the FIFO does not contain enough frames.
+  // Must only be called from the consumer thread.
+  bool Consume(AudioBus* destination, int start_frame, int frames_to_consume);
+
+  // Empties the FIFO without deallocating any memory.  Must only be called
+  // from the consumer thread.
+  void Clear();
+
+  // Number of frames available to Consume().  Exact on the consumer thread;
+  // a lower bound when called from the producer thread.
+  int frames() const;
+
+  // Number of frames Push() can currently accept.  Exact on the producer
+  // thread; a lower bound when called from the consumer thread.
+  int unfilled_frames() const;
+
+  int max_frames() const { return size_ - 1; }
+
+ private:
+  // The actual FIFO is an audio bus implemented as a ring buffer.
+  scoped_ptr<AudioBus> audio_bus_;
+
+  // Number of slots in the ring buffer; one more than the capacity.
+  const int size_;
+
+  // Index of the next frame to read.  Written by the consumer, read by the
+  // producer.  The padding keeps each index on its own cache line.
+  base::subtle::Atomic32 read_pos_;
+  char padding_[64 - sizeof(base::subtle::Atomic32)];
+
+  // Index of the next frame to write.  Written by the producer, read by the
+  // consumer.
+  base::subtle::Atomic32 write_pos_;
+
+  DISALLOW_COPY_AND_ASSIGN(LockFreeAudioFifo);
+};
+
+}  // namespace media
+
+#endif  // MEDIA_BASE_LOCK_FREE_AUDIO_FIFO_H_
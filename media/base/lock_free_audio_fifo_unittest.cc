@@ -0,0 +1,172 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "media/base/lock_free_audio_fifo.h"
+
+#include "base/threading/platform_thread.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace media {
+
+namespace {
+
+// Fills every channel of |bus| with a ramp starting at |start_value|.
+void FillWithRamp(AudioBus* bus, float start_value) {
+  for (int ch = 0; ch < bus->channels(); ++ch) {
+    for (int i = 0; i < bus->frames(); ++i)
+      bus->channel(ch)[i] = start_value + i;
+  }
+}
+
+// Producer side of the threaded test: pushes |total_frames| frames of a
+// monotonically increasing ramp in small chunks, retrying when the FIFO is
+// full.
+class RampProducer : public base::PlatformThread::Delegate {
+ public:
+  RampProducer(LockFreeAudioFifo* fifo, int chunk_frames, int total_frames)
+      : fifo_(fifo),
+        chunk_frames_(chunk_frames),
+        total_frames_(total_frames) {}
+  virtual ~RampProducer() {}
+
+  virtual void ThreadMain() OVERRIDE {
+    scoped_ptr<AudioBus> bus = AudioBus::Create(1, chunk_frames_);
+    int pushed = 0;
+    while (pushed < total_frames_) {
+      FillWithRamp(bus.get(), pushed);
+      while (!fifo_->Push(bus.get()))
+        base::PlatformThread::YieldCurrentThread();
+      pushed += chunk_frames_;
+    }
+  }
+
+ private:
+  LockFreeAudioFifo* fifo_;
+  const int chunk_frames_;
+  const int total_frames_;
+
+  DISALLOW_COPY_AND_ASSIGN(RampProducer);
+};
+
+}  // namespace
+
+TEST(LockFreeAudioFifoTest, Construct) {
+  static const int kChannels = 6;
+  static const int kFrameCount = 128;
+  LockFreeAudioFifo fifo(kChannels, kFrameCount);
+  EXPECT_EQ(0, fifo.frames());
+  EXPECT_EQ(kFrameCount - 1, fifo.max_frames());
+  EXPECT_EQ(kFrameCount - 1, fifo.unfilled_frames());
+}
+
+TEST(LockFreeAudioFifoTest, PushAndConsume) {
+  static const int kChannels = 2;
+  static const int kFrameCount = 128;
+  LockFreeAudioFifo fifo(kChannels, kFrameCount);
+
+  scoped_ptr<AudioBus> source = AudioBus::Create(kChannels, 64);
+  FillWithRamp(source.get(), 0);
+  EXPECT_TRUE(fifo.Push(source.get()));
+  EXPECT_EQ(64, fifo.frames());
+
+  scoped_ptr<AudioBus> sink = AudioBus::Create(kChannels, 64);
+  EXPECT_TRUE(fifo.Consume(sink.get(), 0, 64));
+  EXPECT_EQ(0, fifo.frames());
+  for (int ch = 0; ch < kChannels; ++ch) {
+    for (int i = 0; i < 64; ++i)
+      ASSERT_FLOAT_EQ(static_cast<float>(i), sink->channel(ch)[i]);
+  }
+}
+
+TEST(LockFreeAudioFifoTest, OverflowAndUnderflow) {
+  static const int kChannels = 1;
+  static const int kFrameCount = 64;
+  LockFreeAudioFifo fifo(kChannels, kFrameCount);
+
+  // The FIFO holds one frame less than its allocation.
+  scoped_ptr<AudioBus> full = AudioBus::Create(kChannels, kFrameCount);
+  EXPECT_FALSE(fifo.Push(full.get()));
+  EXPECT_EQ(0, fifo.frames());
+
+  scoped_ptr<AudioBus> almost_full =
+      AudioBus::Create(kChannels, kFrameCount - 1);
+  FillWithRamp(almost_full.get(), 0);
+  EXPECT_TRUE(fifo.Push(almost_full.get()));
+  EXPECT_EQ(0, fifo.unfilled_frames());
+
+  // A full FIFO rejects even a single frame.
+  scoped_ptr<AudioBus> one = AudioBus::Create(kChannels, 1);
+  EXPECT_FALSE(fifo.Push(one.get()));
+
+  // Underflow must not touch the destination.
+  scoped_ptr<AudioBus> sink = AudioBus::Create(kChannels, kFrameCount);
+  EXPECT_FALSE(fifo.Consume(sink.get(), 0, kFrameCount));
+  EXPECT_TRUE(fifo.Consume(sink.get(), 0, kFrameCount - 1));
+  EXPECT_EQ(0, fifo.frames());
+}
+
+TEST(LockFreeAudioFifoTest, WrapAround) {
+  static const int kChannels = 2;
+  static const int kFrameCount = 65;
+  LockFreeAudioFifo fifo(kChannels, kFrameCount);
+
+  // Advance the ring positions so the next push wraps.
+  scoped_ptr<AudioBus> chunk = AudioBus::Create(kChannels, 48);
+  scoped_ptr<AudioBus> sink = AudioBus::Create(kChannels, 48);
+  FillWithRamp(chunk.get(), 0);
+  EXPECT_TRUE(fifo.Push(chunk.get()));
+  EXPECT_TRUE(fifo.Consume(sink.get(), 0, 48));
+
+  FillWithRamp(chunk.get(), 100);
+  EXPECT_TRUE(fifo.Push(chunk.get()));
+  EXPECT_EQ(48, fifo.frames());
+  EXPECT_TRUE(fifo.Consume(sink.get(), 0, 48));
+  for (int ch = 0; ch < kChannels; ++ch) {
+    for (int i = 0; i < 48; ++i)
+      ASSERT_FLOAT_EQ(100.0f + i, sink->channel(ch)[i]);
+  }
+}
+
+TEST(LockFreeAudioFifoTest, Clear) {
+  static const int kChannels = 2;
+  static const int kFrameCount = 128;
+  LockFreeAudioFifo fifo(kChannels, kFrameCount);
+
+  scoped_ptr<AudioBus> bus = AudioBus::Create(kChannels, 64);
+  EXPECT_TRUE(fifo.Push(bus.get()));
+  fifo.Clear();
+  EXPECT_EQ(0, fifo.frames());
+  EXPECT_TRUE(fifo.Push(bus.get()));
+  EXPECT_EQ(64, fifo.frames());
+}
+
+// Streams a long ramp through the FIFO with a real producer thread and
+// verifies the consumer sees every frame exactly once, in order.
+TEST(LockFreeAudioFifoTest, ThreadedStress) {
+  static const int kFrameCount = 127;  // Odd size to exercise wrapping.
+  static const int kChunkFrames = 16;
+  static const int kTotalFrames = kChunkFrames * 4096;
+  LockFreeAudioFifo fifo(1, kFrameCount);
+
+  RampProducer producer(&fifo, kChunkFrames, kTotalFrames);
+  base::PlatformThreadHandle thread_handle;
+  ASSERT_TRUE(base::PlatformThread::Create(0, &producer, &thread_handle));
+
+  scoped_ptr<AudioBus> sink = AudioBus::Create(1, kChunkFrames);
+  int consumed = 0;
+  while (consumed < kTotalFrames) {
+    if (!fifo.Consume(sink.get(), 0, kChunkFrames)) {
+      base::PlatformThread::YieldCurrentThread();
+      continue;
+    }
+    for (int i = 0; i < kChunkFrames; ++i)
+      ASSERT_FLOAT_EQ(static_cast<float>(consumed + i), sink->channel(0)[i]);
+    consumed += kChunkFrames;
+  }
+
+  base::PlatformThread::Join(thread_handle);
+  EXPECT_EQ(0, fifo.frames());
+}
+
+}  // namespace media
@@ -9,6 +9,11 @@ namespace switches {
 // Allow users to specify a custom buffer size for debugging purpose.
 const char kAudioBufferSize[] = "audio-buffer-size";
 
+// Mix all audio output streams for a device into a single physical stream in
+// the browser process, rather than opening one physical stream per playing
+// stream.
+const char kEnableAudioOutputMixer[] = "enable-audio-output-mixer";
+
 // Set number of threads to use for video decoding.
 const char kVideoThreads[] = "video-threads";
 
@@ -31,6 +31,8 @@ class VideoFramePool::PoolImpl
   // |frames_|.
   void Shutdown();
 
+  Stats GetStats() const;
+
   size_t GetPoolSizeForTesting() const { return frames_.size(); }
 
  private:
@@ -42,13 +44,17 @@ class VideoFramePool::PoolImpl
   // in |frames_| by this function so it can be reused.
   void FrameReleased(const scoped_refptr<VideoFrame>& frame);
 
-  base::Lock lock_;
+  mutable base::Lock lock_;
   bool is_shutdown_;
   std::list<scoped_refptr<VideoFrame> > frames_;
+  Stats stats_;
 
   DISALLOW_COPY_AND_ASSIGN(PoolImpl);
 };
 
+VideoFramePool::Stats::Stats()
+    : frames_created(0), frames_reused(0), frames_dropped(0) {}
+
 VideoFramePool::PoolImpl::PoolImpl() : is_shutdown_(false) {}
 
 VideoFramePool::PoolImpl::~PoolImpl() {
@@ -63,6 +69,7 @@ scoped_refptr<VideoFrame> VideoFramePool::PoolImpl::CreateFrame(
     base::TimeDelta timestamp) {
   base::AutoLock auto_lock(lock_);
   DCHECK(!is_shutdown_);
+  DCHECK(gfx::Rect(coded_size).Contains(visible_rect));
 
   scoped_refptr<VideoFrame> frame;
 
@@ -70,26 +77,38 @@ scoped_refptr<VideoFrame> VideoFramePool::PoolImpl::CreateFrame(
       scoped_refptr<VideoFrame> pool_frame = frames_.front();
       frames_.pop_front();
 
+      // Only the format and coded size have to match; the visible rect and
+      // natural size belong to the wrapper created below, so pooled memory
+      // survives crop and display size changes.
       if (pool_frame->format() == format &&
-          pool_frame->coded_size() == coded_size &&
-          pool_frame->visible_rect() == visible_rect &&
-          pool_frame->natural_size() == natural_size) {
+          pool_frame->coded_size() == coded_size) {
         frame = pool_frame;
         frame->set_timestamp(timestamp);
+        ++stats_.frames_reused;
         break;
       }
+      ++stats_.frames_dropped;
   }
 
   if (!frame) {
+    // Allocate the backing frame with the full coded area visible so that
+    // any later visible rect within the same coded size can be vended from
+    // it.
     frame = VideoFrame::CreateFrame(
-        format, coded_size, visible_rect, natural_size, timestamp);
+        format, coded_size, gfx::Rect(coded_size), natural_size, timestamp);
+    ++stats_.frames_created;
   }
 
   return VideoFrame::WrapVideoFrame(
-      frame, frame->visible_rect(), frame->natural_size(),
+      frame, visible_rect, natural_size,
       base::Bind(&VideoFramePool::PoolImpl::FrameReleased, this, frame));
 }
 
+VideoFramePool::Stats VideoFramePool::PoolImpl::GetStats() const {
+  base::AutoLock auto_lock(lock_);
+  return stats_;
+}
+
 void VideoFramePool::PoolImpl::Shutdown() {
   base::AutoLock auto_lock(lock_);
   is_shutdown_ = true;
@@ -122,6 +141,10 @@ scoped_refptr<VideoFrame> VideoFramePool::CreateFrame(
                             timestamp);
 }
 
+VideoFramePool::Stats VideoFramePool::GetStats() const {
+  return pool_->GetStats();
+}
+
 size_t VideoFramePool::GetPoolSizeForTesting() const {
   return pool_->GetPoolSizeForTesting();
 }
@@ -15,11 +15,29 @@ namespace media {
 // returned by CreateFrame(). When one of these VideoFrames is destroyed,
 // the memory is returned to the pool for use by a subsequent CreateFrame()
 // call. The memory in the pool is retained for the life of the
-// VideoFramePool object. If the parameters passed to CreateFrame() change
-// during the life of this object, then the memory used by frames with the old
-// parameter values will be purged from the pool.
+// VideoFramePool object. Pooled memory is recycled whenever the format and
+// coded size of a request match; the visible rect and natural size are
+// properties of the returned wrapper, so crop or display size changes do not
+// cause reallocation. If the format or coded size passed to CreateFrame()
+// changes during the life of this object, then the memory used by frames
+// with the old parameter values will be purged from the pool.
 class MEDIA_EXPORT VideoFramePool {
  public:
+  // Counters describing how effectively the pool recycles frame memory.
+  struct MEDIA_EXPORT Stats {
+    Stats();
+
+    // Number of frames handed out which required a fresh allocation.
+    int frames_created;
+
+    // Number of frames handed out backed by recycled pool memory.
+    int frames_reused;
+
+    // Number of pooled frames dropped because their format or coded size no
+    // longer matched a request.
+    int frames_dropped;
+  };
+
   VideoFramePool();
   ~VideoFramePool();
 
@@ -32,6 +50,10 @@ class MEDIA_EXPORT VideoFramePool {
                                         const gfx::Size& natural_size,
                                         base::TimeDelta timestamp);
 
+  // Returns a snapshot of the allocation counters, e.g. for diagnosing
+  // allocation churn during playback.
+  Stats GetStats() const;
+
 protected:
   friend class VideoFramePoolTest;
 
@@ -51,6 +51,46 @@ TEST_F(VideoFramePoolTest, SimpleFrameReuse) {
   EXPECT_EQ(old_y_data, new_frame->data(VideoFrame::kYPlane));
 }
 
+TEST_F(VideoFramePoolTest, VisibleRectChangeReusesMemory) {
+  scoped_refptr<VideoFrame> frame = CreateFrame(VideoFrame::YV12, 10);
+  const uint8* old_y_data = frame->data(VideoFrame::kYPlane);
+
+  // Clear frame reference to return the frame to the pool.
+  frame = NULL;
+
+  // A request with a different visible rect and natural size but the same
+  // format and coded size must reuse the pooled memory.
+  gfx::Size coded_size(320, 240);
+  gfx::Rect visible_rect(2, 2, 300, 200);
+  gfx::Size natural_size(600, 400);
+  scoped_refptr<VideoFrame> new_frame =
+      pool_->CreateFrame(VideoFrame::YV12, coded_size, visible_rect,
+                         natural_size, base::TimeDelta::FromMilliseconds(20));
+  EXPECT_EQ(old_y_data, new_frame->data(VideoFrame::kYPlane));
+  EXPECT_EQ(visible_rect, new_frame->visible_rect());
+  EXPECT_EQ(natural_size, new_frame->natural_size());
+}
+
+TEST_F(VideoFramePoolTest, Stats) {
+  scoped_refptr<VideoFrame> frame = CreateFrame(VideoFrame::YV12, 10);
+  EXPECT_EQ(1, pool_->GetStats().frames_created);
+  EXPECT_EQ(0, pool_->GetStats().frames_reused);
+
+  // Return the frame and take it out again.
+  frame = NULL;
+  frame = CreateFrame(VideoFrame::YV12, 20);
+  EXPECT_EQ(1, pool_->GetStats().frames_created);
+  EXPECT_EQ(1, pool_->GetStats().frames_reused);
+
+  // A format change drops the pooled frame and allocates a new one.
+  frame = NULL;
+  frame = CreateFrame(VideoFrame::YV12A, 30);
+  VideoFramePool::Stats stats = pool_->GetStats();
+  EXPECT_EQ(2, stats.frames_created);
+  EXPECT_EQ(1, stats.frames_reused);
+  EXPECT_EQ(1, stats.frames_dropped);
+}
+
 TEST_F(VideoFramePoolTest, SimpleFormatChange) {
   scoped_refptr<VideoFrame> frame_a = CreateFrame(VideoFrame::YV12, 10);
   scoped_refptr<VideoFrame> frame_b = CreateFrame(VideoFrame::YV12, 10);
@@ -0,0 +1,142 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "media/base/video_frame_processor.h"
+
+#include <algorithm>
+
+#include "base/atomic_ref_count.h"
+#include "base/bind.h"
+#include "base/location.h"
+#include "base/logging.h"
+#include "base/synchronization/waitable_event.h"
+#include "base/sys_info.h"
+#include "base/threading/worker_pool.h"
+#include "media/base/yuv_convert.h"
+
+namespace media {
+namespace {
+
+// State shared by all bands of one conversion.  Lives on the calling thread's
+// stack; valid until |done| has been signalled by the last band.
+struct ConvertJob {
+  ConvertJob() : done(false, false) {}
+
+  const uint8* yplane;
+  const uint8* uplane;
+  const uint8* vplane;
+  uint8* rgbframe;
+  int width;
+  int height;
+  int ystride;
+  int uvstride;
+  int rgbstride;
+  int y_shift;
+  int rows_per_band;
+  YUVType yuv_type;
+  base::AtomicRefCount remaining_bands;
+  base::WaitableEvent done;
+};
+
+// Converts one band of rows and signals |job->done| once all bands have
+// finished.
+void ConvertBand(ConvertJob* job, int band) {
+  const int start_row = band * job->rows_per_band;
+  const int band_height =
+      std::min(job->rows_per_band, job->height - start_row);
+  ConvertYUVToRGB32(job->yplane + job->ystride * start_row,
+                    job->uplane + job->uvstride * (start_row >> job->y_shift),
+                    job->vplane + job->uvstride * (start_row >> job->y_shift),
+                    job->rgbframe + job->rgbstride * start_row,
+                    job->width,
+                    band_height,
+                    job->ystride,
+                    job->uvstride,
+                    job->rgbstride,
+                    job->yuv_type);
+  if (!base::AtomicRefCountDec(&job->remaining_bands))
+    job->done.Signal();
+}
+
+YUVType GetYUVTypeForFrame(const VideoFrame* video_frame) {
+  switch (video_frame->format()) {
+    case VideoFrame::YV16:
+      return YV16;
+    case VideoFrame::YV12J:
+      return YV12J;
+    case VideoFrame::YV12:
+    case VideoFrame::I420:
+      return YV12;
+    default:
+      NOTREACHED() << "Unsupported format: " << video_frame->format();
+      return YV12;
+  }
+}
+
+}  // namespace
+
+VideoFrameProcessor::VideoFrameProcessor()
+    : target_bands_(
+          std::min(base::SysInfo::NumberOfProcessors(), kMaxBands)) {
+}
+
+VideoFrameProcessor::~VideoFrameProcessor() {}
+
+void VideoFrameProcessor::ConvertToRGB32(const VideoFrame* video_frame,
+                                         uint8* rgbframe,
+                                         int rgbstride) {
+  ConvertJob job;
+  job.yuv_type = GetYUVTypeForFrame(video_frame);
+  job.y_shift = GetVerticalShift(job.yuv_type);
+  job.width = video_frame->visible_rect().width();
+  job.height = video_frame->visible_rect().height();
+  job.ystride = video_frame->stride(VideoFrame::kYPlane);
+  job.uvstride = video_frame->stride(VideoFrame::kUPlane);
+  DCHECK_EQ(job.uvstride, video_frame->stride(VideoFrame::kVPlane));
+
+  // Use the "left" and "top" of the visible rect to locate the offset in the
+  // Y, U and V planes, as the painting code does.
+  job.yplane = video_frame->data(VideoFrame::kYPlane) +
+      job.ystride * video_frame->visible_rect().y() +
+      video_frame->visible_rect().x();
+  const size_t uv_offset =
+      job.uvstride * (video_frame->visible_rect().y() >> job.y_shift) +
+      (video_frame->visible_rect().x() >> 1);
+  job.uplane = video_frame->data(VideoFrame::kUPlane) + uv_offset;
+  job.vplane = video_frame->data(VideoFrame::kVPlane) + uv_offset;
+  job.rgbframe = rgbframe;
+  job.rgbstride = rgbstride;
+
+  // Round the band height up to the chroma block height so every band starts
+  // on its own chroma rows, then see how many bands that actually yields.
+  int bands =
+      std::max(1, std::min(target_bands_, job.height / kMinRowsPerBand));
+  const int uv_block_height = 1 << job.y_shift;
+  job.rows_per_band =
+      ((job.height + bands - 1) / bands + uv_block_height - 1) &
+      ~(uv_block_height - 1);
+  bands = (job.height + job.rows_per_band - 1) / job.rows_per_band;
+
+  if (bands == 1) {
+    ConvertYUVToRGB32(job.yplane, job.uplane, job.vplane, job.rgbframe,
+                      job.width, job.height, job.ystride, job.uvstride,
+                      job.rgbstride, job.yuv_type);
+    return;
+  }
+
+  // Post every band but the first to the worker pool; the first band is
+  // converted on the calling thread while the others run.  The raw |job|
+  // pointer is safe since this thread blocks until the last band signals
+  // |job.done|.
+  job.remaining_bands = bands;
+  for (int band = 1; band < bands; ++band) {
+    base::Closure task = base::Bind(&ConvertBand, &job, band);
+    if (!base::WorkerPool::PostTask(FROM_HERE, task, true))
+      task.Run();
+  }
+  ConvertBand(&job, 0);
+  job.done.Wait();
+}
+
+}  // namespace media
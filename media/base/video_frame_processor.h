@@ -0,0 +1,55 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef MEDIA_BASE_VIDEO_FRAME_PROCESSOR_H_
+#define MEDIA_BASE_VIDEO_FRAME_PROCESSOR_H_
+
+#include "base/basictypes.h"
+#include "media/base/media_export.h"
+#include "media/base/video_frame.h"
+
+namespace media {
+
+// Converts YUV video frames to RGB using every core instead of one.
+//
+// The SIMD converters in media/base/yuv_convert.h process rows
+// independently, so a frame can be split into bands of rows which are
+// converted in parallel on the worker pool while the calling thread handles
+// the first band itself.  At 4K a single core cannot color convert at full
+// frame rate; slicing keeps each band within a core's cache and scales the
+// conversion across the machine.
+//
+// The number of bands is chosen from the number of processors at
+// construction time, and small frames are converted inline since the
+// worker-pool round trip would cost more than it saves.
+class MEDIA_EXPORT VideoFrameProcessor {
+ public:
+  VideoFrameProcessor();
+  ~VideoFrameProcessor();
+
+  // Converts the visible region of |video_frame| to 32 bit RGB, writing
+  // |rgbstride| bytes per row to |rgbframe|.  |video_frame| must be YV12,
+  // I420, YV12J or YV16.  Blocks until the whole frame is converted;
+  // |rgbframe| must be large enough for the visible height.
+  void ConvertToRGB32(const VideoFrame* video_frame,
+                      uint8* rgbframe,
+                      int rgbstride);
+
+ private:
+  // Maximum number of bands a frame is split into.
+  static const int kMaxBands = 8;
+
+  // Minimum rows per band; below this the parallel split is not worth the
+  // task overhead.
+  static const int kMinRowsPerBand = 64;
+
+  // Number of bands to aim for, derived from the processor count.
+  const int target_bands_;
+
+  DISALLOW_COPY_AND_ASSIGN(VideoFrameProcessor);
+};
+
+}  // namespace media
+
+#endif  // MEDIA_BASE_VIDEO_FRAME_PROCESSOR_H_
@@ -0,0 +1,117 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <string.h>
+
+#include "base/memory/scoped_ptr.h"
+#include "media/base/video_frame.h"
+#include "media/base/video_frame_processor.h"
+#include "media/base/yuv_convert.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace media {
+
+static const int kBpp = 4;
+
+// Fills the YUV planes of |frame| with a deterministic pattern.
+static void FillFrame(const scoped_refptr<VideoFrame>& frame) {
+  for (size_t plane = VideoFrame::kYPlane; plane <= VideoFrame::kVPlane;
+       ++plane) {
+    uint8* data = frame->data(plane);
+    const int rows = frame->rows(plane);
+    const int stride = frame->stride(plane);
+    for (int row = 0; row < rows; ++row) {
+      for (int i = 0; i < stride; ++i)
+        data[row * stride + i] = (row * 31 + i * 7 + plane * 3) & 0xff;
+    }
+  }
+}
+
+// Converts |frame| twice, once banded through VideoFrameProcessor and once in
+// a single ConvertYUVToRGB32() call, and expects bit identical output.  The
+// row converters have no state across rows so slicing must not change the
+// result.
+static void VerifyBandedConversionMatches(
+    const scoped_refptr<VideoFrame>& frame, YUVType yuv_type) {
+  const int width = frame->visible_rect().width();
+  const int height = frame->visible_rect().height();
+  const int rgbstride = width * kBpp;
+  scoped_ptr<uint8[]> banded_rgb(new uint8[rgbstride * height]);
+  scoped_ptr<uint8[]> reference_rgb(new uint8[rgbstride * height]);
+
+  VideoFrameProcessor processor;
+  processor.ConvertToRGB32(frame.get(), banded_rgb.get(), rgbstride);
+
+  const int y_shift = GetVerticalShift(yuv_type);
+  const uint8* yplane = frame->data(VideoFrame::kYPlane) +
+      frame->stride(VideoFrame::kYPlane) * frame->visible_rect().y() +
+      frame->visible_rect().x();
+  const size_t uv_offset =
+      frame->stride(VideoFrame::kUPlane) *
+          (frame->visible_rect().y() >> y_shift) +
+      (frame->visible_rect().x() >> 1);
+  ConvertYUVToRGB32(yplane,
+                    frame->data(VideoFrame::kUPlane) + uv_offset,
+                    frame->data(VideoFrame::kVPlane) + uv_offset,
+                    reference_rgb.get(),
+                    width,
+                    height,
+                    frame->stride(VideoFrame::kYPlane),
+                    frame->stride(VideoFrame::kUPlane),
+                    rgbstride,
+                    yuv_type);
+
+  EXPECT_EQ(0,
+            memcmp(banded_rgb.get(), reference_rgb.get(), rgbstride * height));
+}
+
+TEST(VideoFrameProcessorTest, YV12) {
+  gfx::Size size(640, 360);
+  scoped_refptr<VideoFrame> frame = VideoFrame::CreateFrame(
+      VideoFrame::YV12, size, gfx::Rect(size), size, base::TimeDelta());
+  FillFrame(frame);
+  VerifyBandedConversionMatches(frame, YV12);
+}
+
+TEST(VideoFrameProcessorTest, YV16) {
+  gfx::Size size(640, 360);
+  scoped_refptr<VideoFrame> frame = VideoFrame::CreateFrame(
+      VideoFrame::YV16, size, gfx::Rect(size), size, base::TimeDelta());
+  FillFrame(frame);
+  VerifyBandedConversionMatches(frame, YV16);
+}
+
+TEST(VideoFrameProcessorTest, OddHeight) {
+  // An odd visible height exercises the rounding of band heights to chroma
+  // block boundaries and the short final band.
+  gfx::Size coded_size(640, 360);
+  gfx::Rect visible_rect(0, 0, 640, 359);
+  scoped_refptr<VideoFrame> frame =
+      VideoFrame::CreateFrame(VideoFrame::YV12, coded_size, visible_rect,
+                              coded_size, base::TimeDelta());
+  FillFrame(frame);
+  VerifyBandedConversionMatches(frame, YV12);
+}
+
+TEST(VideoFrameProcessorTest, OffsetVisibleRect) {
+  gfx::Size coded_size(640, 360);
+  gfx::Rect visible_rect(16, 8, 600, 336);
+  scoped_refptr<VideoFrame> frame =
+      VideoFrame::CreateFrame(VideoFrame::YV12, coded_size, visible_rect,
+                              coded_size, base::TimeDelta());
+  FillFrame(frame);
+  VerifyBandedConversionMatches(frame, YV12);
+}
+
+TEST(VideoFrameProcessorTest, SmallFrameConvertsInline) {
+  // Frames below the banding threshold take the single threaded path; the
+  // output must still match.
+  gfx::Size size(64, 48);
+  scoped_refptr<VideoFrame> frame = VideoFrame::CreateFrame(
+      VideoFrame::YV12, size, gfx::Rect(size), size, base::TimeDelta());
+  FillFrame(frame);
+  VerifyBandedConversionMatches(frame, YV12);
+}
+
+}  // namespace media
@@ -7,6 +7,7 @@
 
 #include "base/basictypes.h"
 #include "base/callback.h"
+#include "base/memory/scoped_ptr.h"
 #include "base/synchronization/waitable_event.h"
 #include "media/filters/ffmpeg_glue.h"
 
@@ -42,6 +43,11 @@ class MEDIA_EXPORT BlockingUrlProtocol : public FFmpegURLProtocol {
   // has completed.
   void SignalReadCompleted(int size);
 
+  // Copies up to |size| bytes at |read_position_| from the readahead cache
+  // into |data|.  Returns the number of bytes copied, which is zero if the
+  // position is not cached.
+  int ReadFromCache(int size, uint8* data);
+
   DataSource* data_source_;
   base::Closure error_cb_;
 
@@ -55,6 +61,16 @@ class MEDIA_EXPORT BlockingUrlProtocol : public FFmpegURLProtocol {
   // Cached position within the data source.
   int64 read_position_;
 
+  // Readahead cache holding one contiguous range of the source starting at
+  // |cache_start_position_|.  Reads for local (non-streaming) sources are
+  // issued at cache granularity, so sequential demuxing and nearby seeks are
+  // served from memory instead of blocking on the data source for every
+  // avio buffer refill.  NULL for streaming sources, where a large blocking
+  // read could stall for as long as the network takes to deliver it.
+  scoped_ptr<uint8[]> cache_;
+  int64 cache_start_position_;
+  int cache_size_;
+
   DISALLOW_IMPLICIT_CONSTRUCTORS(BlockingUrlProtocol);
 };
 
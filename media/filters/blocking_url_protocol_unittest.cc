@@ -75,6 +75,24 @@ TEST_F(BlockingUrlProtocolTest, Read) {
   EXPECT_EQ(size, position);
 }
 
+TEST_F(BlockingUrlProtocolTest, ReadaheadCache) {
+  // Prime the readahead cache with the start of the file.
+  uint8 buffer[64];
+  EXPECT_TRUE(url_protocol_.SetPosition(0));
+  EXPECT_EQ(64, url_protocol_.Read(64, buffer));
+
+  // Once primed, reads and seeks within the cached range are served from
+  // memory and never reach the data source.
+  data_source_.force_read_errors_for_testing();
+  EXPECT_EQ(64, url_protocol_.Read(64, buffer));
+
+  int64 position = 0;
+  EXPECT_TRUE(url_protocol_.SetPosition(16));
+  EXPECT_EQ(64, url_protocol_.Read(64, buffer));
+  EXPECT_TRUE(url_protocol_.GetPosition(&position));
+  EXPECT_EQ(80, position);
+}
+
 TEST_F(BlockingUrlProtocolTest, ReadError) {
   data_source_.force_read_errors_for_testing();
 
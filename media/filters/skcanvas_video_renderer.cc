@@ -4,8 +4,10 @@
 
 #include "media/filters/skcanvas_video_renderer.h"
 
+#include "base/lazy_instance.h"
 #include "base/logging.h"
 #include "media/base/video_frame.h"
+#include "media/base/video_frame_processor.h"
 #include "media/base/yuv_convert.h"
 #include "third_party/libyuv/include/libyuv.h"
 #include "third_party/skia/include/core/SkCanvas.h"
@@ -39,6 +41,11 @@ static bool IsYUVOrNative(media::VideoFrame::Format format) {
   return IsYUV(format) || format == media::VideoFrame::NATIVE_TEXTURE;
 }
 
+// Shared processor for the formats converted by media::ConvertYUVToRGB32(),
+// which splits large frames into bands converted on the worker pool.
+static base::LazyInstance<media::VideoFrameProcessor>::Leaky
+    g_video_frame_processor = LAZY_INSTANCE_INITIALIZER;
+
 // Converts a VideoFrame containing YUV data to a SkBitmap containing RGB data.
 //
 // |bitmap| will be (re)allocated to match the dimensions of |video_frame|.
@@ -96,17 +103,10 @@ static void ConvertVideoFrameToBitmap(
       break;
 
     case media::VideoFrame::YV12J:
-      media::ConvertYUVToRGB32(
-          video_frame->data(media::VideoFrame::kYPlane) + y_offset,
-          video_frame->data(media::VideoFrame::kUPlane) + uv_offset,
-          video_frame->data(media::VideoFrame::kVPlane) + uv_offset,
+      g_video_frame_processor.Get().ConvertToRGB32(
+          video_frame.get(),
           static_cast<uint8*>(bitmap->getPixels()),
-          video_frame->visible_rect().width(),
-          video_frame->visible_rect().height(),
-          video_frame->stride(media::VideoFrame::kYPlane),
-          video_frame->stride(media::VideoFrame::kUPlane),
-          bitmap->rowBytes(),
-          media::YV12J);
+          bitmap->rowBytes());
       break;
 
     case media::VideoFrame::YV16:
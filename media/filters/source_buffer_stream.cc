@@ -414,6 +414,7 @@ SourceBufferStream::SourceBufferStream(const TextTrackConfig& text_config,
       splice_frames_enabled_(splice_frames_enabled) {}
 
 SourceBufferStream::~SourceBufferStream() {
+  range_start_index_.clear();
   while (!ranges_.empty()) {
     delete ranges_.front();
     ranges_.pop_front();
@@ -627,7 +628,7 @@ void SourceBufferStream::RemoveInternal(
     // Split off any remaining end piece and add it to |ranges_|.
     SourceBufferRange* new_range = range->SplitRange(end, is_exclusive);
     if (new_range) {
-      itr = ranges_.insert(++itr, new_range);
+      itr = AddToRanges(new_range);
       --itr;
 
       // Update the selected range if the next buffer position was transferred
@@ -850,13 +851,11 @@ int SourceBufferStream::GetRemovalRange(
   int bytes_to_free = total_bytes_to_free;
   int bytes_freed = 0;
 
-  for (RangeList::iterator itr = ranges_.begin();
+  for (RangeList::iterator itr = FindRangeEndingAtOrAfter(start_timestamp);
        itr != ranges_.end() && bytes_to_free > 0; ++itr) {
     SourceBufferRange* range = *itr;
     if (range->GetStartTimestamp() >= end_timestamp)
       break;
-    if (range->GetEndTimestamp() < start_timestamp)
-      continue;
 
     int bytes_removed = range->GetRemovalGOP(
         start_timestamp, end_timestamp, bytes_to_free, removal_end_timestamp);
@@ -885,12 +884,14 @@ int SourceBufferStream::FreeBuffers(int total_bytes_to_free,
     BufferQueue buffers;
     int bytes_deleted = 0;
 
+    base::TimeDelta range_start_timestamp;
     if (reverse_direction) {
       current_range = ranges_.back();
       if (current_range->LastGOPContainsNextBufferPosition()) {
         DCHECK_EQ(current_range, selected_range_);
         break;
       }
+      range_start_timestamp = current_range->GetStartTimestamp();
       bytes_deleted = current_range->DeleteGOPFromBack(&buffers);
     } else {
       current_range = ranges_.front();
@@ -898,6 +899,7 @@ int SourceBufferStream::FreeBuffers(int total_bytes_to_free,
         DCHECK_EQ(current_range, selected_range_);
         break;
       }
+      range_start_timestamp = current_range->GetStartTimestamp();
       bytes_deleted = current_range->DeleteGOPFromFront(&buffers);
     }
 
@@ -921,8 +923,19 @@ int SourceBufferStream::FreeBuffers(int total_bytes_to_free,
       DCHECK_NE(current_range, selected_range_);
       DCHECK(range_for_next_append_ == ranges_.end() ||
              *range_for_next_append_ != current_range);
+      size_t erased = range_start_index_.erase(range_start_timestamp);
+      DCHECK_EQ(1u, erased);
       delete current_range;
       reverse_direction ? ranges_.pop_back() : ranges_.pop_front();
+    } else if (!reverse_direction) {
+      // Deleting a GOP from the front moved the range's start timestamp, so
+      // it must be re-keyed in |range_start_index_|.
+      RangeStartIndex::iterator index_itr =
+          range_start_index_.find(range_start_timestamp);
+      DCHECK(index_itr != range_start_index_.end());
+      RangeList::iterator range_itr = index_itr->second;
+      range_start_index_.erase(index_itr);
+      range_start_index_[current_range->GetStartTimestamp()] = range_itr;
     }
   }
 
@@ -1084,10 +1097,25 @@ void SourceBufferStream::Seek(base::TimeDelta timestamp) {
   seek_buffer_timestamp_ = timestamp;
   seek_pending_ = true;
 
+  // A range is seekable if |timestamp| lands at most a fudge room before its
+  // start and before its buffered end, so only ranges in that window around
+  // |timestamp| need to be considered. Any range ending before the window
+  // cannot contain it, so stepping back one entry from the first range
+  // starting inside the window covers all candidates; they are tested in
+  // list order to match what a linear scan would find.
+  base::TimeDelta fudge_room = ComputeFudgeRoom(GetMaxInterbufferDistance());
+  RangeStartIndex::iterator index_itr =
+      range_start_index_.upper_bound(timestamp - fudge_room);
+  if (index_itr != range_start_index_.begin())
+    --index_itr;
   RangeList::iterator itr = ranges_.end();
-  for (itr = ranges_.begin(); itr != ranges_.end(); ++itr) {
-    if ((*itr)->CanSeekTo(timestamp))
+  for (; index_itr != range_start_index_.end() &&
+         (*index_itr->second)->GetStartTimestamp() <= timestamp + fudge_room;
+       ++index_itr) {
+    if ((*index_itr->second)->CanSeekTo(timestamp)) {
+      itr = index_itr->second;
       break;
+    }
   }
 
   if (itr == ranges_.end())
@@ -1281,22 +1309,71 @@ base::TimeDelta SourceBufferStream::GetEndBufferTimestamp() {
 
 SourceBufferStream::RangeList::iterator
 SourceBufferStream::FindExistingRangeFor(base::TimeDelta start_timestamp) {
-  for (RangeList::iterator itr = ranges_.begin(); itr != ranges_.end(); ++itr) {
-    if ((*itr)->BelongsToRange(start_timestamp))
-      return itr;
+  if (ranges_.empty())
+    return ranges_.end();
+
+  // Text streams treat any timestamp after a range's end as belonging to that
+  // range, so the first match may be arbitrarily far back; fall back to a
+  // linear scan for them.
+  if (GetType() == kText) {
+    for (RangeList::iterator itr = ranges_.begin(); itr != ranges_.end();
+         ++itr) {
+      if ((*itr)->BelongsToRange(start_timestamp))
+        return itr;
+    }
+    return ranges_.end();
+  }
+
+  // Only ranges starting at or before |start_timestamp| can match, and a
+  // range whose end is more than the fudge room before |start_timestamp|
+  // cannot. Any earlier range ends before the start of the range at
+  // |index_itr|, so stepping back one entry covers the entire window.
+  // Candidates are tested in list order so the same range is returned as a
+  // linear scan would find.
+  base::TimeDelta window_start =
+      start_timestamp - ComputeFudgeRoom(GetMaxInterbufferDistance());
+  RangeStartIndex::iterator index_itr =
+      range_start_index_.upper_bound(window_start);
+  if (index_itr != range_start_index_.begin())
+    --index_itr;
+  for (; index_itr != range_start_index_.end() &&
+         (*index_itr->second)->GetStartTimestamp() <= start_timestamp;
+       ++index_itr) {
+    if ((*index_itr->second)->BelongsToRange(start_timestamp))
+      return index_itr->second;
   }
   return ranges_.end();
 }
 
+SourceBufferStream::RangeList::iterator
+SourceBufferStream::FindRangeEndingAtOrAfter(base::TimeDelta timestamp) {
+  // Every range after |index_itr| starts, and therefore ends, after
+  // |timestamp|; the only earlier candidate is the range just before it.
+  RangeStartIndex::iterator index_itr =
+      range_start_index_.upper_bound(timestamp);
+  RangeList::iterator itr = index_itr == range_start_index_.end() ?
+      ranges_.end() : index_itr->second;
+  if (index_itr != range_start_index_.begin()) {
+    --index_itr;
+    if ((*index_itr->second)->GetEndTimestamp() >= timestamp)
+      itr = index_itr->second;
+  }
+  return itr;
+}
+
 SourceBufferStream::RangeList::iterator
 SourceBufferStream::AddToRanges(SourceBufferRange* new_range) {
   base::TimeDelta start_timestamp = new_range->GetStartTimestamp();
-  RangeList::iterator itr = ranges_.end();
-  for (itr = ranges_.begin(); itr != ranges_.end(); ++itr) {
-    if ((*itr)->GetStartTimestamp() > start_timestamp)
-      break;
-  }
-  return ranges_.insert(itr, new_range);
+  RangeStartIndex::iterator index_itr =
+      range_start_index_.upper_bound(start_timestamp);
+  RangeList::iterator next_range_itr = index_itr == range_start_index_.end() ?
+      ranges_.end() : index_itr->second;
+  RangeList::iterator new_range_itr =
+      ranges_.insert(next_range_itr, new_range);
+  bool inserted = range_start_index_.insert(
+      std::make_pair(start_timestamp, new_range_itr)).second;
+  DCHECK(inserted);
+  return new_range_itr;
 }
 
 SourceBufferStream::RangeList::iterator
@@ -1507,13 +1584,7 @@ base::TimeDelta SourceBufferStream::FindNewSelectedRangeSeekTimestamp(
   DCHECK(start_timestamp != kNoTimestamp());
   DCHECK(start_timestamp >= base::TimeDelta());
 
-  RangeList::iterator itr = ranges_.begin();
-
-  for (; itr != ranges_.end(); ++itr) {
-    if ((*itr)->GetEndTimestamp() >= start_timestamp) {
-      break;
-    }
-  }
+  RangeList::iterator itr = FindRangeEndingAtOrAfter(start_timestamp);
 
   if (itr == ranges_.end())
     return kNoTimestamp();
@@ -1623,6 +1694,23 @@ void SourceBufferStream::DeleteAndRemoveRange(RangeList::iterator* itr) {
     last_appended_buffer_is_keyframe_ = false;
   }
 
+  // The range's own start timestamp may no longer be valid (it may have had
+  // all of its buffers removed), so locate its entry in |range_start_index_|
+  // through its predecessor: both containers hold the ranges in the same
+  // order, so the entry is the first one past the predecessor's key.
+  RangeStartIndex::iterator index_itr;
+  if (*itr == ranges_.begin()) {
+    index_itr = range_start_index_.begin();
+  } else {
+    RangeList::iterator previous_range_itr = *itr;
+    --previous_range_itr;
+    index_itr = range_start_index_.upper_bound(
+        (*previous_range_itr)->GetStartTimestamp());
+  }
+  DCHECK(index_itr != range_start_index_.end());
+  DCHECK(index_itr->second == *itr);
+  range_start_index_.erase(index_itr);
+
   delete **itr;
   *itr = ranges_.erase(*itr);
 }
@@ -12,6 +12,7 @@
 
 #include <deque>
 #include <list>
+#include <map>
 #include <string>
 #include <utility>
 #include <vector>
@@ -147,6 +148,7 @@ class MEDIA_EXPORT SourceBufferStream {
   friend class SourceBufferStreamTest;
 
   typedef std::list<SourceBufferRange*> RangeList;
+  typedef std::map<base::TimeDelta, RangeList::iterator> RangeStartIndex;
 
   // Frees up space if the SourceBufferStream is taking up too much memory.
   void GarbageCollectIfNeeded();
@@ -207,8 +209,14 @@ class MEDIA_EXPORT SourceBufferStream {
   // |ranges_.end()| if there's no such existing range.
   RangeList::iterator FindExistingRangeFor(base::TimeDelta start_timestamp);
 
-  // Inserts |new_range| into |ranges_| preserving sorted order. Returns an
-  // iterator in |ranges_| that points to |new_range|.
+  // Returns an iterator pointing to the first range in |ranges_| whose end
+  // timestamp is at or after |timestamp|, or |ranges_.end()| if there is no
+  // such range.
+  RangeList::iterator FindRangeEndingAtOrAfter(base::TimeDelta timestamp);
+
+  // Inserts |new_range| into |ranges_| preserving sorted order, and adds it
+  // to |range_start_index_|. Returns an iterator in |ranges_| that points to
+  // |new_range|.
   RangeList::iterator AddToRanges(SourceBufferRange* new_range);
 
   // Returns an iterator that points to the place in |ranges_| where
@@ -282,7 +290,8 @@ class MEDIA_EXPORT SourceBufferStream {
   // or there is a pending seek beyond any existing ranges.
   bool IsEndSelected() const;
 
-  // Deletes the range pointed to by |*itr| and removes it from |ranges_|.
+  // Deletes the range pointed to by |*itr| and removes it from |ranges_| and
+  // |range_start_index_|.
   // If |*itr| points to |selected_range_|, then |selected_range_| is set to
   // NULL. After the range is removed, |*itr| is to the range after the one that
   // was removed or to |ranges_.end()| if the last range was removed.
@@ -334,6 +343,12 @@ class MEDIA_EXPORT SourceBufferStream {
   // List of disjoint buffered ranges, ordered by start time.
   RangeList ranges_;
 
+  // Maps each range's start timestamp to its position in |ranges_| so lookups
+  // by timestamp are logarithmic in the number of ranges. Kept in sync with
+  // |ranges_| whenever a range is added, removed, or has buffers deleted from
+  // its front.
+  RangeStartIndex range_start_index_;
+
   // Indicates which decoder config is being used by the decoder.
   // GetNextBuffer() is only allows to return buffers that have a
   // config ID that matches this index. If there is a mismatch then
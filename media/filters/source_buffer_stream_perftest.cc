@@ -0,0 +1,131 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "media/filters/source_buffer_stream.h"
+
+#include <algorithm>
+
+#include "base/time/time.h"
+#include "media/base/media_log.h"
+#include "media/base/stream_parser_buffer.h"
+#include "media/base/test_helpers.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace media {
+
+// Simulated stream parameters. Segments are two seconds of 30fps video with
+// a keyframe every half second; every other segment is followed by a gap so
+// buffered ranges pile up the way they do for long-running live streams.
+static const int kFramesPerSecond = 30;
+static const int kKeyframeInterval = 15;
+static const int kSegmentDurationInSeconds = 2;
+static const int kSimulatedHours = 24;
+static const int kDataSize = 16;
+
+static void AppendSegment(SourceBufferStream* stream,
+                          base::TimeDelta start_timestamp,
+                          base::TimeDelta frame_duration) {
+  static const uint8 kData[kDataSize] = {0};
+  stream->OnNewMediaSegment(start_timestamp);
+
+  StreamParser::BufferQueue queue;
+  const int frame_count = kFramesPerSecond * kSegmentDurationInSeconds;
+  for (int i = 0; i < frame_count; ++i) {
+    bool is_keyframe = i % kKeyframeInterval == 0;
+    scoped_refptr<StreamParserBuffer> buffer = StreamParserBuffer::CopyFrom(
+        kData, kDataSize, is_keyframe, DemuxerStream::VIDEO, 0);
+    base::TimeDelta timestamp = start_timestamp + i * frame_duration;
+    buffer->SetDecodeTimestamp(timestamp);
+    buffer->set_timestamp(timestamp);
+    buffer->set_duration(frame_duration);
+    queue.push_back(buffer);
+  }
+  ASSERT_TRUE(stream->Append(queue));
+}
+
+// Appends 24 hours worth of segments, leaving a gap after every other segment
+// so the range count keeps growing, and reports the worst append time seen in
+// each simulated hour. Append cost must stay flat as ranges accumulate.
+TEST(SourceBufferStreamPerfTest, LongevityAppend) {
+  SourceBufferStream stream(TestVideoConfig::Normal(), LogCB(), true);
+
+  // Keep garbage collection from capping the number of ranges.
+  stream.set_memory_limit_for_testing(kint32max);
+
+  const base::TimeDelta frame_duration =
+      base::TimeDelta::FromSeconds(1) / kFramesPerSecond;
+  const base::TimeDelta segment_duration =
+      base::TimeDelta::FromSeconds(kSegmentDurationInSeconds);
+  const int segments_per_hour =
+      3600 / (2 * kSegmentDurationInSeconds + kSegmentDurationInSeconds);
+
+  base::TimeDelta next_segment_start;
+  base::TimeDelta total_append_time;
+  base::TimeDelta worst_hour_append_time;
+  for (int hour = 0; hour < kSimulatedHours; ++hour) {
+    base::TimeDelta worst_append_time;
+    for (int segment = 0; segment < segments_per_hour; ++segment) {
+      // Two adjacent segments forming one range, then a gap.
+      for (int part = 0; part < 2; ++part) {
+        base::TimeTicks start = base::TimeTicks::HighResNow();
+        AppendSegment(&stream, next_segment_start, frame_duration);
+        base::TimeDelta append_time = base::TimeTicks::HighResNow() - start;
+        total_append_time += append_time;
+        worst_append_time = std::max(worst_append_time, append_time);
+        next_segment_start += segment_duration;
+      }
+      next_segment_start += segment_duration;
+    }
+    worst_hour_append_time =
+        std::max(worst_hour_append_time, worst_append_time);
+  }
+
+  perf_test::PrintResult("source_buffer_stream_longevity",
+                         "",
+                         "append_total",
+                         total_append_time.InMillisecondsF(),
+                         "ms",
+                         true);
+  perf_test::PrintResult("source_buffer_stream_longevity",
+                         "",
+                         "append_worst",
+                         worst_hour_append_time.InMillisecondsF() * 1000,
+                         "us",
+                         true);
+}
+
+// Seeks across a stream with thousands of buffered ranges.
+TEST(SourceBufferStreamPerfTest, LongevitySeek) {
+  SourceBufferStream stream(TestVideoConfig::Normal(), LogCB(), true);
+  stream.set_memory_limit_for_testing(kint32max);
+
+  const base::TimeDelta frame_duration =
+      base::TimeDelta::FromSeconds(1) / kFramesPerSecond;
+  const base::TimeDelta segment_duration =
+      base::TimeDelta::FromSeconds(kSegmentDurationInSeconds);
+
+  // One range per segment, with a segment sized gap in between.
+  static const int kRangeCount = 4000;
+  for (int i = 0; i < kRangeCount; ++i) {
+    AppendSegment(&stream, 2 * i * segment_duration, frame_duration);
+  }
+
+  static const int kSeekCount = 10000;
+  base::TimeTicks start = base::TimeTicks::HighResNow();
+  for (int i = 0; i < kSeekCount; ++i) {
+    int range = (i * 7919) % kRangeCount;
+    stream.Seek(2 * range * segment_duration + frame_duration);
+  }
+  base::TimeDelta elapsed = base::TimeTicks::HighResNow() - start;
+
+  perf_test::PrintResult("source_buffer_stream_longevity",
+                         "",
+                         "seek",
+                         elapsed.InMillisecondsF() * 1000 / kSeekCount,
+                         "us",
+                         true);
+}
+
+}  // namespace media
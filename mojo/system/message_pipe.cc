@@ -97,6 +97,62 @@ MojoResult MessagePipe::ReadMessage(unsigned port,
                                        num_dispatchers, flags);
 }
 
+// TODO(vtl): Handle flags.
+MojoResult MessagePipe::WriteMessages(unsigned port,
+                                      const MessageToWrite* messages,
+                                      uint32_t num_messages,
+                                      MojoWriteMessageFlags /*flags*/) {
+  DCHECK(port == 0 || port == 1);
+  DCHECK(messages);
+
+  unsigned destination_port = GetPeerPort(port);
+
+  base::AutoLock locker(lock_);
+  DCHECK(endpoints_[port]);
+
+  // The destination port need not be open, unlike the source port.
+  if (!endpoints_[destination_port])
+    return MOJO_RESULT_FAILED_PRECONDITION;
+
+  // With no transports to attach, the endpoint's |EnqueueMessage()| may not
+  // report failure, so the whole batch goes in atomically.
+  for (uint32_t i = 0; i < num_messages; i++) {
+    endpoints_[destination_port]->EnqueueMessage(
+        make_scoped_ptr(new MessageInTransit(
+            MessageInTransit::kTypeMessagePipeEndpoint,
+            MessageInTransit::kSubtypeMessagePipeEndpointData,
+            messages[i].num_bytes,
+            messages[i].bytes)));
+  }
+  return MOJO_RESULT_OK;
+}
+
+MojoResult MessagePipe::ReadMessages(unsigned port,
+                                     MessageToRead* messages,
+                                     uint32_t* num_messages,
+                                     MojoReadMessageFlags flags) {
+  DCHECK(port == 0 || port == 1);
+  DCHECK(messages);
+  DCHECK(num_messages);
+
+  base::AutoLock locker(lock_);
+  DCHECK(endpoints_[port]);
+
+  uint32_t capacity = *num_messages;
+  uint32_t num_read = 0;
+  MojoResult result = MOJO_RESULT_OK;
+  while (num_read < capacity) {
+    result = endpoints_[port]->ReadMessage(messages[num_read].bytes,
+                                           &messages[num_read].num_bytes,
+                                           NULL, NULL, flags);
+    if (result != MOJO_RESULT_OK)
+      break;
+    num_read++;
+  }
+  *num_messages = num_read;
+  return num_read > 0 ? MOJO_RESULT_OK : result;
+}
+
 MojoResult MessagePipe::AddWaiter(unsigned port,
                                   Waiter* waiter,
                                   MojoHandleSignals signals,
@@ -64,6 +64,41 @@ class MOJO_SYSTEM_IMPL_EXPORT MessagePipe :
                          DispatcherVector* dispatchers,
                          uint32_t* num_dispatchers,
                          MojoReadMessageFlags flags);
+
+  // A single element of the batch given to |WriteMessages()|.
+  struct MessageToWrite {
+    const void* bytes;
+    uint32_t num_bytes;
+  };
+  // Like calling |WriteMessage()| once per element of |messages|, but the
+  // endpoint lock is only acquired once, so high-rate writers don't pay
+  // per-message locking costs. Messages written in a batch cannot have
+  // dispatchers attached. Either the whole batch is enqueued or, on failure,
+  // none of it is.
+  MojoResult WriteMessages(unsigned port,
+                           const MessageToWrite* messages,
+                           uint32_t num_messages,
+                           MojoWriteMessageFlags flags);
+
+  // A single element of the batch given to |ReadMessages()|. |num_bytes| is
+  // the capacity of |bytes| on input and the size of the message read into it
+  // on output.
+  struct MessageToRead {
+    void* bytes;
+    uint32_t num_bytes;
+  };
+  // Drains queued messages into |messages| under a single lock acquisition.
+  // On input |*num_messages| is the capacity of |messages|; on output it is
+  // the number of messages read. Returns |MOJO_RESULT_OK| if at least one
+  // message was read; otherwise returns the reason the first read failed
+  // (e.g., |MOJO_RESULT_SHOULD_WAIT| if the queue is empty). The drain stops
+  // early at a message that doesn't fit its buffer or that has dispatchers
+  // attached; such a message is left queued (the failure is only reported
+  // once nothing has been read) and must be read with |ReadMessage()|.
+  MojoResult ReadMessages(unsigned port,
+                          MessageToRead* messages,
+                          uint32_t* num_messages,
+                          MojoReadMessageFlags flags);
   MojoResult AddWaiter(unsigned port,
                        Waiter* waiter,
                        MojoHandleSignals signals,
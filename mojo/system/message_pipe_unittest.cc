@@ -206,6 +206,109 @@ TEST(MessagePipeTest, Basic) {
   mp->Close(1);
 }
 
+// Tests:
+//  - writing a batch of messages in one call
+//  - draining queued messages into a caller array
+//    - when the queue is empty
+//    - when the array is smaller than the queue
+//    - when a message doesn't fit its buffer (drain stops early)
+//  - batched writing to a port whose peer has been closed
+TEST(MessagePipeTest, BatchedWriteAndRead) {
+  scoped_refptr<MessagePipe> mp(new MessagePipe());
+
+  int32_t elements[3] = { 123456789, 234567890, 345678901 };
+  MessagePipe::MessageToWrite to_write[3];
+  for (size_t i = 0; i < 3; i++) {
+    to_write[i].bytes = &elements[i];
+    to_write[i].num_bytes = static_cast<uint32_t>(sizeof(elements[i]));
+  }
+
+  int32_t read_buffers[3] = { 0, 0, 0 };
+  MessagePipe::MessageToRead to_read[3];
+  uint32_t num_messages;
+
+  // Nothing to read yet on port 1.
+  for (size_t i = 0; i < 3; i++) {
+    to_read[i].bytes = &read_buffers[i];
+    to_read[i].num_bytes = static_cast<uint32_t>(sizeof(read_buffers[i]));
+  }
+  num_messages = 3;
+  EXPECT_EQ(MOJO_RESULT_SHOULD_WAIT,
+            mp->ReadMessages(1, to_read, &num_messages,
+                             MOJO_READ_MESSAGE_FLAG_NONE));
+  EXPECT_EQ(0u, num_messages);
+
+  // Write a batch of three from port 0 and read them all back from port 1.
+  EXPECT_EQ(MOJO_RESULT_OK,
+            mp->WriteMessages(0, to_write, 3, MOJO_WRITE_MESSAGE_FLAG_NONE));
+  num_messages = 3;
+  EXPECT_EQ(MOJO_RESULT_OK,
+            mp->ReadMessages(1, to_read, &num_messages,
+                             MOJO_READ_MESSAGE_FLAG_NONE));
+  EXPECT_EQ(3u, num_messages);
+  for (size_t i = 0; i < 3; i++) {
+    EXPECT_EQ(static_cast<uint32_t>(sizeof(elements[i])),
+              to_read[i].num_bytes);
+    EXPECT_EQ(elements[i], read_buffers[i]);
+  }
+
+  // The queue should now be drained.
+  num_messages = 3;
+  EXPECT_EQ(MOJO_RESULT_SHOULD_WAIT,
+            mp->ReadMessages(1, to_read, &num_messages,
+                             MOJO_READ_MESSAGE_FLAG_NONE));
+  EXPECT_EQ(0u, num_messages);
+
+  // With only room for one message, the others stay queued.
+  EXPECT_EQ(MOJO_RESULT_OK,
+            mp->WriteMessages(0, to_write, 3, MOJO_WRITE_MESSAGE_FLAG_NONE));
+  to_read[0].bytes = &read_buffers[0];
+  to_read[0].num_bytes = static_cast<uint32_t>(sizeof(read_buffers[0]));
+  read_buffers[0] = 0;
+  num_messages = 1;
+  EXPECT_EQ(MOJO_RESULT_OK,
+            mp->ReadMessages(1, to_read, &num_messages,
+                             MOJO_READ_MESSAGE_FLAG_NONE));
+  EXPECT_EQ(1u, num_messages);
+  EXPECT_EQ(elements[0], read_buffers[0]);
+
+  // A too-small buffer stops the drain after the messages before it; the
+  // too-big message stays queued and is reported by the next call.
+  for (size_t i = 0; i < 3; i++) {
+    to_read[i].bytes = &read_buffers[i];
+    to_read[i].num_bytes = static_cast<uint32_t>(sizeof(read_buffers[i]));
+    read_buffers[i] = 0;
+  }
+  to_read[1].num_bytes = 1;
+  num_messages = 3;
+  EXPECT_EQ(MOJO_RESULT_OK,
+            mp->ReadMessages(1, to_read, &num_messages,
+                             MOJO_READ_MESSAGE_FLAG_NONE));
+  EXPECT_EQ(1u, num_messages);
+  EXPECT_EQ(elements[1], read_buffers[0]);
+  to_read[0].num_bytes = 1;
+  num_messages = 1;
+  EXPECT_EQ(MOJO_RESULT_RESOURCE_EXHAUSTED,
+            mp->ReadMessages(1, to_read, &num_messages,
+                             MOJO_READ_MESSAGE_FLAG_NONE));
+  EXPECT_EQ(0u, num_messages);
+  EXPECT_EQ(static_cast<uint32_t>(sizeof(elements[2])), to_read[0].num_bytes);
+  to_read[0].bytes = &read_buffers[0];
+  num_messages = 1;
+  EXPECT_EQ(MOJO_RESULT_OK,
+            mp->ReadMessages(1, to_read, &num_messages,
+                             MOJO_READ_MESSAGE_FLAG_NONE));
+  EXPECT_EQ(1u, num_messages);
+  EXPECT_EQ(elements[2], read_buffers[0]);
+
+  // Batched writes to a port whose peer is closed should fail.
+  mp->Close(1);
+  EXPECT_EQ(MOJO_RESULT_FAILED_PRECONDITION,
+            mp->WriteMessages(0, to_write, 3, MOJO_WRITE_MESSAGE_FLAG_NONE));
+
+  mp->Close(0);
+}
+
 TEST(MessagePipeTest, CloseWithQueuedIncomingMessages) {
   scoped_refptr<MessagePipe> mp(new MessagePipe());
 
@@ -4,10 +4,143 @@
 
 #include "net/base/io_buffer.h"
 
+#include <vector>
+
+#include "base/lazy_instance.h"
 #include "base/logging.h"
+#include "base/threading/thread_local_storage.h"
 
 namespace net {
 
+namespace {
+
+// IOBufferPool recycles the underlying allocations of pooled IOBuffers (see
+// IOBufferWithSize::TakeFromPool) through per-thread free lists, so that the
+// transfer buffers repeatedly allocated and released on the network thread do
+// not go through the general allocator. Requests are rounded up to
+// power-of-two size classes between kMinPooledSizeLog2 and
+// kMaxPooledSizeLog2; anything larger falls back to a plain allocation.
+//
+// Each thread only ever touches its own free lists, so no locking is needed.
+// A pooled buffer released on a different thread than the one it was taken
+// from simply lands on the releasing thread's free list; the blocks are
+// plain new[] arrays, so this is safe.
+
+const int kMinPooledSizeLog2 = 12;  // 4KB
+const int kMaxPooledSizeLog2 = 18;  // 256KB
+const int kNumSizeClasses = kMaxPooledSizeLog2 - kMinPooledSizeLog2 + 1;
+
+// The maximum number of free blocks retained per thread and size class.
+// Blocks released beyond this limit are freed rather than cached.
+const size_t kMaxRetainedBlocksPerClass = 8;
+
+class IOBufferPool {
+ public:
+  // The free lists of one thread. Stored in TLS and reclaimed via
+  // SlotReturnFunction() when the thread exits.
+  struct FreeLists {
+    FreeLists() {}
+    ~FreeLists() {
+      for (int i = 0; i < kNumSizeClasses; ++i) {
+        for (size_t j = 0; j < lists[i].size(); ++j)
+          delete[] lists[i][j];
+      }
+    }
+    std::vector<char*> lists[kNumSizeClasses];
+  };
+
+  // Returns the index of the smallest size class that fits |size|, or -1 if
+  // |size| is too large to pool.
+  static int SizeClassForSize(int size) {
+    for (int i = 0; i < kNumSizeClasses; ++i) {
+      if (size <= SizeClassBytes(i))
+        return i;
+    }
+    return -1;
+  }
+
+  static int SizeClassBytes(int size_class) {
+    return 1 << (kMinPooledSizeLog2 + size_class);
+  }
+
+  char* Take(int size_class) {
+    std::vector<char*>* list = &GetFreeLists()->lists[size_class];
+    if (list->empty())
+      return new char[SizeClassBytes(size_class)];
+    char* block = list->back();
+    list->pop_back();
+    return block;
+  }
+
+  void Return(char* block, int size_class) {
+    std::vector<char*>* list = &GetFreeLists()->lists[size_class];
+    if (list->size() >= kMaxRetainedBlocksPerClass) {
+      delete[] block;
+      return;
+    }
+    list->push_back(block);
+  }
+
+  // Frees the exiting thread's retained blocks.
+  static void SlotReturnFunction(void* data) {
+    delete static_cast<FreeLists*>(data);
+  }
+
+ private:
+  IOBufferPool() {
+    tls_index_.Initialize(SlotReturnFunction);
+  }
+
+  ~IOBufferPool() {
+    NOTREACHED();  // LeakyLazyInstance is not destructed.
+  }
+
+  FreeLists* GetFreeLists() {
+    FreeLists* free_lists = static_cast<FreeLists*>(tls_index_.Get());
+    if (!free_lists) {
+      free_lists = new FreeLists();
+      tls_index_.Set(free_lists);
+    }
+    return free_lists;
+  }
+
+  friend struct base::DefaultLazyInstanceTraits<IOBufferPool>;
+
+  // Holds the calling thread's FreeLists.
+  static base::ThreadLocalStorage::StaticSlot tls_index_;
+
+  DISALLOW_COPY_AND_ASSIGN(IOBufferPool);
+};
+
+// static
+base::ThreadLocalStorage::StaticSlot IOBufferPool::tls_index_ =
+    TLS_INITIALIZER;
+
+base::LazyInstance<IOBufferPool>::Leaky g_io_buffer_pool =
+    LAZY_INSTANCE_INITIALIZER;
+
+// An IOBufferWithSize whose underlying allocation was drawn from the pool
+// and goes back to it (onto the releasing thread's free list) when the
+// buffer is destroyed.
+class PooledIOBuffer : public IOBufferWithSize {
+ public:
+  PooledIOBuffer(char* data, int size, int size_class)
+      : IOBufferWithSize(data, size),
+        size_class_(size_class) {}
+
+ private:
+  virtual ~PooledIOBuffer() {
+    g_io_buffer_pool.Get().Return(data_, size_class_);
+    // The pool owns the allocation now; keep the base class destructor from
+    // deleting it.
+    data_ = NULL;
+  }
+
+  const int size_class_;
+};
+
+}  // namespace
+
 IOBuffer::IOBuffer()
     : data_(NULL) {
 }
@@ -31,6 +164,17 @@ IOBufferWithSize::IOBufferWithSize(int size)
       size_(size) {
 }
 
+// static
+IOBufferWithSize* IOBufferWithSize::TakeFromPool(int size) {
+  CHECK_GE(size, 0);
+  int size_class = IOBufferPool::SizeClassForSize(size);
+  if (size_class < 0)
+    return new IOBufferWithSize(size);
+  return new PooledIOBuffer(g_io_buffer_pool.Get().Take(size_class),
+                            size,
+                            size_class);
+}
+
 IOBufferWithSize::IOBufferWithSize(char* data, int size)
     : IOBuffer(data),
       size_(size) {
@@ -11,6 +11,7 @@
 #include "base/memory/scoped_ptr.h"
 #include "base/pickle.h"
 #include "net/base/net_export.h"
+#include "net/base/object_pool.h"
 
 namespace net {
 
@@ -72,6 +73,10 @@ namespace net {
 // it is not destroyed until after the synchronous operation has completed.
 class NET_EXPORT IOBuffer : public base::RefCountedThreadSafe<IOBuffer> {
  public:
+  // IOBuffer headers are created and released once per read or write; draw
+  // them (and all subclasses) from the thread-affine object pool.
+  NET_OBJECT_POOL_ALLOCATED();
+
   IOBuffer();
   explicit IOBuffer(int buffer_size);
 
@@ -97,6 +102,15 @@ class NET_EXPORT IOBufferWithSize : public IOBuffer {
  public:
   explicit IOBufferWithSize(int size);
 
+  // Returns a buffer of at least |size| bytes, drawn from a pool of
+  // previously released buffers when one is available and freshly allocated
+  // otherwise. This is intended for high-frequency transfer buffers, such as
+  // socket read buffers, whose constant allocation and release would
+  // otherwise churn the allocator. The buffer is returned to the pool when
+  // its last reference is dropped. size() reports |size|, although the
+  // underlying allocation may be larger.
+  static IOBufferWithSize* TakeFromPool(int size);
+
   int size() const { return size_; }
 
  protected:
@@ -0,0 +1,75 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/base/io_buffer.h"
+
+#include <string.h>
+
+#include "base/memory/ref_counted.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace net {
+
+namespace {
+
+TEST(IOBufferTest, TakeFromPoolReusesBuffers) {
+  scoped_refptr<IOBufferWithSize> buffer(IOBufferWithSize::TakeFromPool(4096));
+  ASSERT_TRUE(buffer->data());
+  EXPECT_EQ(4096, buffer->size());
+  char* data = buffer->data();
+
+  // Releasing the buffer puts its allocation on this thread's free list, so
+  // the next request of the same size gets the same allocation back.
+  buffer = NULL;
+  buffer = IOBufferWithSize::TakeFromPool(4096);
+  EXPECT_EQ(data, buffer->data());
+}
+
+TEST(IOBufferTest, TakeFromPoolSizeClassesDoNotMix) {
+  scoped_refptr<IOBufferWithSize> small(IOBufferWithSize::TakeFromPool(4096));
+  char* small_data = small->data();
+  small = NULL;
+
+  // |small_data| is now retained by the pool, so a request from a larger
+  // size class cannot be satisfied by it.
+  scoped_refptr<IOBufferWithSize> large(IOBufferWithSize::TakeFromPool(10000));
+  EXPECT_NE(small_data, large->data());
+  EXPECT_EQ(10000, large->size());
+
+  // The retained allocation is still handed out for a matching request.
+  scoped_refptr<IOBufferWithSize> small2(IOBufferWithSize::TakeFromPool(100));
+  EXPECT_EQ(small_data, small2->data());
+}
+
+TEST(IOBufferTest, TakeFromPoolRoundsUpWithinClass) {
+  // A request smaller than the allocation it gets back still reports the
+  // requested size, and the full requested size is writable.
+  scoped_refptr<IOBufferWithSize> buffer(IOBufferWithSize::TakeFromPool(5000));
+  EXPECT_EQ(5000, buffer->size());
+  memset(buffer->data(), 0xAB, buffer->size());
+}
+
+TEST(IOBufferTest, HeadersComeFromObjectPool) {
+  // The IOBuffer object itself is pool-allocated: releasing one and creating
+  // another of the same type reuses the header allocation.
+  scoped_refptr<IOBuffer> buffer(new IOBuffer(16));
+  IOBuffer* header = buffer.get();
+  buffer = NULL;
+  buffer = new IOBuffer(16);
+  EXPECT_EQ(header, buffer.get());
+}
+
+TEST(IOBufferTest, TakeFromPoolOversizedFallsBack) {
+  // Requests too large for any size class come from a plain allocation.
+  const int kBigSize = 1024 * 1024;
+  scoped_refptr<IOBufferWithSize> buffer(
+      IOBufferWithSize::TakeFromPool(kBigSize));
+  ASSERT_TRUE(buffer->data());
+  EXPECT_EQ(kBigSize, buffer->size());
+  memset(buffer->data(), 0xAB, buffer->size());
+}
+
+}  // namespace
+
+}  // namespace net
@@ -128,3 +128,9 @@ LOAD_FLAG(DO_NOT_USE_EMBEDDED_IDENTITY, 1 << 28)
 // reduction proxy.
 // TODO(rcs): Remove this flag as soon as http://crbug.com/339237 is resolved.
 LOAD_FLAG(BYPASS_DATA_REDUCTION_PROXY, 1 << 29)
+
+// Indicates that the caller will perform asynchronous revalidation if the
+// cache entry is stale but usable under "stale-while-revalidate". If set,
+// such an entry is served immediately and async_revalidation_required is set
+// on the response.
+LOAD_FLAG(SUPPORT_ASYNC_REVALIDATION, 1 << 30)
@@ -843,6 +843,7 @@ EVENT_TYPE(HTTP_CACHE_WRITE_DATA)
 //   }
 EVENT_TYPE(DISK_CACHE_ENTRY_IMPL)
 EVENT_TYPE(DISK_CACHE_MEM_ENTRY_IMPL)
+EVENT_TYPE(DISK_CACHE_LOG_STORE_ENTRY_IMPL)
 
 // Logs the time required to read/write data from/to a cache entry.
 //
@@ -0,0 +1,104 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/base/net_log_ring_buffer.h"
+
+#include "base/json/json_reader.h"
+#include "base/json/json_writer.h"
+#include "base/logging.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/values.h"
+
+namespace net {
+
+NetLogRingBuffer::CompactEntry::CompactEntry()
+    : type(0), source_type(0), source_id(0), phase(0), time(0) {}
+
+NetLogRingBuffer::CompactEntry::~CompactEntry() {}
+
+NetLogRingBuffer::NetLogRingBuffer(size_t capacity)
+    : log_level_(NetLog::LOG_ALL_BUT_BYTES),
+      capacity_(capacity),
+      entries_(capacity),
+      next_(0),
+      size_(0) {
+  DCHECK_LT(0u, capacity);
+}
+
+NetLogRingBuffer::~NetLogRingBuffer() {}
+
+void NetLogRingBuffer::set_log_level(NetLog::LogLevel log_level) {
+  DCHECK(!net_log());
+  log_level_ = log_level;
+}
+
+void NetLogRingBuffer::StartObserving(NetLog* net_log) {
+  net_log->AddThreadSafeObserver(this, log_level_);
+}
+
+void NetLogRingBuffer::StopObserving() {
+  net_log()->RemoveThreadSafeObserver(this);
+}
+
+size_t NetLogRingBuffer::GetSize() const {
+  base::AutoLock lock(lock_);
+  return size_;
+}
+
+base::ListValue* NetLogRingBuffer::GetEntriesAsListValue() const {
+  base::AutoLock lock(lock_);
+  base::ListValue* list = new base::ListValue();
+  size_t oldest = size_ < capacity_ ? 0 : next_;
+  for (size_t i = 0; i < size_; ++i) {
+    const CompactEntry& entry = entries_[(oldest + i) % capacity_];
+    base::DictionaryValue* entry_dict = new base::DictionaryValue();
+    entry_dict->SetString(
+        "time",
+        NetLog::TickCountToString(base::TimeTicks::FromInternalValue(
+            entry.time)));
+    base::DictionaryValue* source_dict = new base::DictionaryValue();
+    source_dict->SetInteger("id", entry.source_id);
+    source_dict->SetInteger("type", entry.source_type);
+    entry_dict->Set("source", source_dict);
+    entry_dict->SetInteger("type", entry.type);
+    entry_dict->SetInteger("phase", entry.phase);
+    if (!entry.params_json.empty()) {
+      base::Value* params = base::JSONReader::Read(entry.params_json);
+      DCHECK(params);
+      if (params)
+        entry_dict->Set("params", params);
+    }
+    list->Append(entry_dict);
+  }
+  return list;
+}
+
+void NetLogRingBuffer::Clear() {
+  base::AutoLock lock(lock_);
+  next_ = 0;
+  size_ = 0;
+}
+
+void NetLogRingBuffer::OnAddEntry(const NetLog::Entry& entry) {
+  // Serialize the parameters outside the lock; the callback backing them is
+  // only valid for the duration of this call.
+  std::string params_json;
+  scoped_ptr<base::Value> params(entry.ParametersToValue());
+  if (params)
+    base::JSONWriter::Write(params.get(), &params_json);
+
+  base::AutoLock lock(lock_);
+  CompactEntry* slot = &entries_[next_];
+  slot->type = static_cast<uint32>(entry.type());
+  slot->source_type = static_cast<uint32>(entry.source().type);
+  slot->source_id = entry.source().id;
+  slot->phase = static_cast<uint32>(entry.phase());
+  slot->time = entry.time().ToInternalValue();
+  slot->params_json.swap(params_json);
+  next_ = (next_ + 1) % capacity_;
+  if (size_ < capacity_)
+    ++size_;
+}
+
+}  // namespace net
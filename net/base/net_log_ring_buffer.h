@@ -0,0 +1,94 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_BASE_NET_LOG_RING_BUFFER_H_
+#define NET_BASE_NET_LOG_RING_BUFFER_H_
+
+#include <string>
+#include <vector>
+
+#include "base/basictypes.h"
+#include "base/compiler_specific.h"
+#include "base/synchronization/lock.h"
+#include "net/base/net_export.h"
+#include "net/base/net_log.h"
+
+namespace base {
+class ListValue;
+}
+
+namespace net {
+
+// NetLogRingBuffer watches the NetLog event stream and retains only the most
+// recent events, overwriting the oldest once |capacity| is reached. Events
+// are stored in a compact fixed-layout record whose only heap allocation is
+// the parameter JSON (serialized once at capture time), rather than as a
+// Value tree, making the observer cheap enough to leave attached
+// continuously and dump after the fact.
+class NET_EXPORT NetLogRingBuffer : public NetLog::ThreadSafeObserver {
+ public:
+  // Retains at most |capacity| events. |capacity| must be non-zero.
+  explicit NetLogRingBuffer(size_t capacity);
+  virtual ~NetLogRingBuffer();
+
+  // Sets the log level to observe at. Must be called before StartObserving.
+  void set_log_level(NetLog::LogLevel log_level);
+
+  // Starts observing specified NetLog.  Must not already be watching a NetLog.
+  void StartObserving(NetLog* net_log);
+
+  // Stops observing net_log().  Must already be watching.
+  void StopObserving();
+
+  size_t capacity() const { return capacity_; }
+
+  // Returns the number of retained events, at most |capacity()|.
+  size_t GetSize() const;
+
+  // Serializes the retained events, oldest first, each in the same form as
+  // NetLog::Entry::ToValue().  Caller takes ownership of the returned value.
+  base::ListValue* GetEntriesAsListValue() const;
+
+  // Discards all retained events.
+  void Clear();
+
+  // NetLog::ThreadSafeObserver implementation:
+  virtual void OnAddEntry(const NetLog::Entry& entry) OVERRIDE;
+
+ private:
+  // A compact record of a single event. Matches the information content of
+  // NetLog::Entry::ToValue() while storing only integral fields and the
+  // pre-serialized parameter JSON.
+  struct CompactEntry {
+    CompactEntry();
+    ~CompactEntry();
+
+    uint32 type;
+    uint32 source_type;
+    uint32 source_id;
+    uint32 phase;
+    int64 time;  // base::TimeTicks::ToInternalValue().
+    std::string params_json;  // Empty if the event carried no parameters.
+  };
+
+  // The LogLevel to observe at.
+  NetLog::LogLevel log_level_;
+
+  const size_t capacity_;
+
+  mutable base::Lock lock_;
+
+  // Circular buffer of the last |size_| events; |next_| is the slot the next
+  // event will be written to, which holds the oldest event once the buffer
+  // has wrapped.
+  std::vector<CompactEntry> entries_;
+  size_t next_;
+  size_t size_;
+
+  DISALLOW_COPY_AND_ASSIGN(NetLogRingBuffer);
+};
+
+}  // namespace net
+
+#endif  // NET_BASE_NET_LOG_RING_BUFFER_H_
@@ -0,0 +1,114 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/base/net_log_ring_buffer.h"
+
+#include "base/bind.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/values.h"
+#include "net/base/net_log.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace net {
+
+namespace {
+
+base::Value* ParamsCallback(int value, NetLog::LogLevel /* log_level */) {
+  base::DictionaryValue* dict = new base::DictionaryValue();
+  dict->SetInteger("value", value);
+  return dict;
+}
+
+void AddEventWithValue(NetLog* net_log, int value) {
+  net_log->AddGlobalEntry(NetLog::TYPE_CANCELLED,
+                          base::Bind(&ParamsCallback, value));
+}
+
+// Returns the integer "params.value" field of the |index|th entry of |list|,
+// or -1 if absent.
+int GetEntryValue(const base::ListValue& list, size_t index) {
+  const base::DictionaryValue* dict = NULL;
+  if (!list.GetDictionary(index, &dict))
+    return -1;
+  int value = -1;
+  if (!dict->GetInteger("params.value", &value))
+    return -1;
+  return value;
+}
+
+TEST(NetLogRingBufferTest, RetainsEventsUpToCapacity) {
+  NetLog net_log;
+  NetLogRingBuffer buffer(10);
+  buffer.StartObserving(&net_log);
+
+  EXPECT_EQ(10u, buffer.capacity());
+  EXPECT_EQ(0u, buffer.GetSize());
+
+  for (int i = 0; i < 3; ++i)
+    AddEventWithValue(&net_log, i);
+  EXPECT_EQ(3u, buffer.GetSize());
+
+  scoped_ptr<base::ListValue> list(buffer.GetEntriesAsListValue());
+  ASSERT_EQ(3u, list->GetSize());
+  for (size_t i = 0; i < 3; ++i) {
+    EXPECT_EQ(static_cast<int>(i), GetEntryValue(*list, i));
+
+    const base::DictionaryValue* dict = NULL;
+    ASSERT_TRUE(list->GetDictionary(i, &dict));
+    int type = -1;
+    EXPECT_TRUE(dict->GetInteger("type", &type));
+    EXPECT_EQ(static_cast<int>(NetLog::TYPE_CANCELLED), type);
+    std::string time;
+    EXPECT_TRUE(dict->GetString("time", &time));
+    EXPECT_FALSE(time.empty());
+  }
+
+  buffer.StopObserving();
+}
+
+TEST(NetLogRingBufferTest, OldestEventsAreOverwritten) {
+  NetLog net_log;
+  NetLogRingBuffer buffer(4);
+  buffer.StartObserving(&net_log);
+
+  for (int i = 0; i < 10; ++i)
+    AddEventWithValue(&net_log, i);
+
+  // Only the last four events should remain, oldest first.
+  EXPECT_EQ(4u, buffer.GetSize());
+  scoped_ptr<base::ListValue> list(buffer.GetEntriesAsListValue());
+  ASSERT_EQ(4u, list->GetSize());
+  for (size_t i = 0; i < 4; ++i)
+    EXPECT_EQ(static_cast<int>(6 + i), GetEntryValue(*list, i));
+
+  buffer.StopObserving();
+}
+
+TEST(NetLogRingBufferTest, Clear) {
+  NetLog net_log;
+  NetLogRingBuffer buffer(4);
+  buffer.StartObserving(&net_log);
+
+  for (int i = 0; i < 6; ++i)
+    AddEventWithValue(&net_log, i);
+  EXPECT_EQ(4u, buffer.GetSize());
+
+  buffer.Clear();
+  EXPECT_EQ(0u, buffer.GetSize());
+  scoped_ptr<base::ListValue> list(buffer.GetEntriesAsListValue());
+  EXPECT_EQ(0u, list->GetSize());
+
+  // The buffer remains usable after a Clear().
+  AddEventWithValue(&net_log, 6);
+  EXPECT_EQ(1u, buffer.GetSize());
+  list.reset(buffer.GetEntriesAsListValue());
+  ASSERT_EQ(1u, list->GetSize());
+  EXPECT_EQ(6, GetEntryValue(*list, 0));
+
+  buffer.StopObserving();
+}
+
+}  // namespace
+
+}  // namespace net
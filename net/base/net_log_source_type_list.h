@@ -19,6 +19,7 @@ SOURCE_TYPE(HOST_RESOLVER_IMPL_REQUEST)
 SOURCE_TYPE(HOST_RESOLVER_IMPL_JOB)
 SOURCE_TYPE(DISK_CACHE_ENTRY)
 SOURCE_TYPE(MEMORY_CACHE_ENTRY)
+SOURCE_TYPE(LOG_STORE_CACHE_ENTRY)
 SOURCE_TYPE(HTTP_STREAM_JOB)
 SOURCE_TYPE(EXPONENTIAL_BACKOFF_THROTTLING)
 SOURCE_TYPE(UDP_SOCKET)
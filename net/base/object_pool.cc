@@ -0,0 +1,130 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/base/object_pool.h"
+
+#include <stdlib.h>
+
+#include <vector>
+
+#include "base/lazy_instance.h"
+#include "base/logging.h"
+#include "base/threading/thread_local_storage.h"
+
+namespace net {
+
+namespace {
+
+// Chunks are grouped into size classes of kGranularity bytes up to
+// kMaxPooledSize; larger requests go straight to the general allocator.
+// kGranularity also guarantees the alignment malloc() provided for the
+// original allocation is suitable for any object in the class.
+const size_t kGranularity = 16;
+const size_t kMaxPooledSize = 256;
+const size_t kNumSizeClasses = kMaxPooledSize / kGranularity;
+
+// The maximum number of free chunks retained per thread and size class.
+// Chunks released beyond this limit are freed rather than cached.
+const size_t kMaxRetainedChunksPerClass = 32;
+
+class PoolImpl {
+ public:
+  // The free lists of one thread. Stored in TLS and reclaimed via
+  // SlotReturnFunction() when the thread exits.
+  struct FreeLists {
+    FreeLists() {}
+    ~FreeLists() {
+      for (size_t i = 0; i < kNumSizeClasses; ++i) {
+        for (size_t j = 0; j < lists[i].size(); ++j)
+          free(lists[i][j]);
+      }
+    }
+    std::vector<void*> lists[kNumSizeClasses];
+  };
+
+  // Returns the size class for |size|; the caller has checked that |size| is
+  // pooled.
+  static size_t SizeClassForSize(size_t size) {
+    DCHECK_GT(size, 0u);
+    DCHECK_LE(size, kMaxPooledSize);
+    return (size - 1) / kGranularity;
+  }
+
+  static size_t SizeClassBytes(size_t size_class) {
+    return (size_class + 1) * kGranularity;
+  }
+
+  void* Take(size_t size_class) {
+    std::vector<void*>* list = &GetFreeLists()->lists[size_class];
+    if (list->empty())
+      return malloc(SizeClassBytes(size_class));
+    void* chunk = list->back();
+    list->pop_back();
+    return chunk;
+  }
+
+  void Return(void* chunk, size_t size_class) {
+    std::vector<void*>* list = &GetFreeLists()->lists[size_class];
+    if (list->size() >= kMaxRetainedChunksPerClass) {
+      free(chunk);
+      return;
+    }
+    list->push_back(chunk);
+  }
+
+  // Frees the exiting thread's retained chunks.
+  static void SlotReturnFunction(void* data) {
+    delete static_cast<FreeLists*>(data);
+  }
+
+ private:
+  PoolImpl() {
+    tls_index_.Initialize(SlotReturnFunction);
+  }
+
+  ~PoolImpl() {
+    NOTREACHED();  // LeakyLazyInstance is not destructed.
+  }
+
+  FreeLists* GetFreeLists() {
+    FreeLists* free_lists = static_cast<FreeLists*>(tls_index_.Get());
+    if (!free_lists) {
+      free_lists = new FreeLists();
+      tls_index_.Set(free_lists);
+    }
+    return free_lists;
+  }
+
+  friend struct base::DefaultLazyInstanceTraits<PoolImpl>;
+
+  // Holds the calling thread's FreeLists.
+  static base::ThreadLocalStorage::StaticSlot tls_index_;
+
+  DISALLOW_COPY_AND_ASSIGN(PoolImpl);
+};
+
+// static
+base::ThreadLocalStorage::StaticSlot PoolImpl::tls_index_ = TLS_INITIALIZER;
+
+base::LazyInstance<PoolImpl>::Leaky g_object_pool = LAZY_INSTANCE_INITIALIZER;
+
+}  // namespace
+
+// static
+void* ObjectPool::Allocate(size_t size) {
+  if (size == 0 || size > kMaxPooledSize)
+    return malloc(size);
+  return g_object_pool.Get().Take(PoolImpl::SizeClassForSize(size));
+}
+
+// static
+void ObjectPool::Free(void* ptr, size_t size) {
+  if (size == 0 || size > kMaxPooledSize) {
+    free(ptr);
+    return;
+  }
+  g_object_pool.Get().Return(ptr, PoolImpl::SizeClassForSize(size));
+}
+
+}  // namespace net
@@ -0,0 +1,57 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_BASE_OBJECT_POOL_H_
+#define NET_BASE_OBJECT_POOL_H_
+
+#include <stddef.h>
+
+#include "net/base/net_export.h"
+
+namespace net {
+
+// ObjectPool is a thread-affine slab allocator for the small, short-lived
+// objects the network stack churns through on its main thread, most notably
+// the ref-counted IOBuffer headers created per read and write. It recycles
+// fixed-size chunks through per-thread free lists grouped into size classes,
+// so allocation and release on the hot path never take a lock or reach the
+// general allocator. Objects released on a different thread than the one
+// that allocated them simply land on the releasing thread's free list; the
+// chunks are plain heap blocks, so this is safe.
+//
+// Classes opt in with NET_OBJECT_POOL_ALLOCATED() in their public section:
+//
+//   class Foo {
+//    public:
+//     NET_OBJECT_POOL_ALLOCATED();
+//     ...
+//   };
+//
+// The sized operator delete keeps this correct for class hierarchies with
+// virtual destructors: the most-derived size is passed on destruction, and
+// sizes above the pooled limit fall through to the general allocator.
+class NET_EXPORT ObjectPool {
+ public:
+  // Returns a chunk of at least |size| bytes. Never returns NULL.
+  static void* Allocate(size_t size);
+
+  // Releases a chunk previously returned by Allocate() for |size| bytes.
+  static void Free(void* ptr, size_t size);
+
+ private:
+  ObjectPool();
+  ~ObjectPool();
+};
+
+}  // namespace net
+
+#define NET_OBJECT_POOL_ALLOCATED()                    \
+  void* operator new(size_t size) {                    \
+    return net::ObjectPool::Allocate(size);            \
+  }                                                    \
+  void operator delete(void* ptr, size_t size) {       \
+    net::ObjectPool::Free(ptr, size);                  \
+  }
+
+#endif  // NET_BASE_OBJECT_POOL_H_
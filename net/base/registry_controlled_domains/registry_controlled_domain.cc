@@ -46,6 +46,7 @@
 #include "net/base/registry_controlled_domains/registry_controlled_domain.h"
 
 #include "base/logging.h"
+#include "base/strings/string_piece.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
 #include "net/base/net_module.h"
@@ -199,15 +200,18 @@ int LookupString(const unsigned char* graph, size_t length, const char* key,
   return kNotFound;  // No match
 }
 
+// Accepts the host as a StringPiece so that callers which already hold the
+// canonicalized spec (e.g. the GURL overloads) can do lookups without copying
+// the host into a temporary string first.
 size_t GetRegistryLengthImpl(
-    const std::string& host,
+    const base::StringPiece& host,
     UnknownRegistryFilter unknown_filter,
     PrivateRegistryFilter private_filter) {
   DCHECK(!host.empty());
 
   // Skip leading dots.
   const size_t host_check_begin = host.find_first_not_of('.');
-  if (host_check_begin == std::string::npos)
+  if (host_check_begin == base::StringPiece::npos)
     return 0;  // Host is only dots.
 
   // A single trailing dot isn't relevant in this determination, but does need
@@ -223,10 +227,10 @@ size_t GetRegistryLengthImpl(
 
   // Walk up the domain tree, most specific to least specific,
   // looking for matches at each level.
-  size_t prev_start = std::string::npos;
+  size_t prev_start = base::StringPiece::npos;
   size_t curr_start = host_check_begin;
   size_t next_dot = host.find('.', curr_start);
-  if (next_dot >= host_check_len)  // Catches std::string::npos as well.
+  if (next_dot >= host_check_len)  // Catches base::StringPiece::npos as well.
     return 0;  // This can't have a registry + domain.
   while (1) {
     const char* domain_str = host.data() + curr_start;
@@ -241,7 +245,7 @@ size_t GetRegistryLengthImpl(
     if (do_check) {
       // Exception rules override wildcard rules when the domain is an exact
       // match, but wildcards take precedence when there's a subdomain.
-      if (type & kWildcardRule && (prev_start != std::string::npos)) {
+      if (type & kWildcardRule && (prev_start != base::StringPiece::npos)) {
         // If prev_start == host_check_begin, then the host is the registry
         // itself, so return 0.
         return (prev_start == host_check_begin) ? 0
@@ -249,7 +253,7 @@ size_t GetRegistryLengthImpl(
       }
 
       if (type & kExceptionRule) {
-        if (next_dot == std::string::npos) {
+        if (next_dot == base::StringPiece::npos) {
           // If we get here, we had an exception rule with no dots (e.g.
           // "!foo").  This would only be valid if we had a corresponding
           // wildcard rule, which would have to be "*".  But we explicitly
@@ -266,7 +270,7 @@ size_t GetRegistryLengthImpl(
                                               : (host.length() - curr_start);
     }
 
-    if (next_dot >= host_check_len)  // Catches std::string::npos as well.
+    if (next_dot >= host_check_len)  // Catches base::StringPiece::npos as well.
       break;
 
     prev_start = curr_start;
@@ -282,13 +286,13 @@ size_t GetRegistryLengthImpl(
 }
 
 std::string GetDomainAndRegistryImpl(
-    const std::string& host, PrivateRegistryFilter private_filter) {
+    const base::StringPiece& host, PrivateRegistryFilter private_filter) {
   DCHECK(!host.empty());
 
   // Find the length of the registry for this host.
   const size_t registry_length =
       GetRegistryLengthImpl(host, INCLUDE_UNKNOWN_REGISTRIES, private_filter);
-  if ((registry_length == std::string::npos) || (registry_length == 0))
+  if ((registry_length == base::StringPiece::npos) || (registry_length == 0))
     return std::string();  // No registry.
   // The "2" in this next line is 1 for the dot, plus a 1-char minimum preceding
   // subcomponent length.
@@ -303,9 +307,9 @@ std::string GetDomainAndRegistryImpl(
   // dot.  Return the host from after that dot, or the whole host when there is
   // no dot.
   const size_t dot = host.rfind('.', host.length() - registry_length - 2);
-  if (dot == std::string::npos)
-    return host;
-  return host.substr(dot + 1);
+  if (dot == base::StringPiece::npos)
+    return host.as_string();
+  return host.substr(dot + 1).as_string();
 }
 
 }  // namespace
@@ -316,7 +320,7 @@ std::string GetDomainAndRegistry(
   const url::Component host = gurl.parsed_for_possibly_invalid_spec().host;
   if ((host.len <= 0) || gurl.HostIsIPAddress())
     return std::string();
-  return GetDomainAndRegistryImpl(std::string(
+  return GetDomainAndRegistryImpl(base::StringPiece(
       gurl.possibly_invalid_spec().data() + host.begin, host.len), filter);
 }
 
@@ -361,7 +365,8 @@ size_t GetRegistryLength(
   if (gurl.HostIsIPAddress())
     return 0;
   return GetRegistryLengthImpl(
-      std::string(gurl.possibly_invalid_spec().data() + host.begin, host.len),
+      base::StringPiece(gurl.possibly_invalid_spec().data() + host.begin,
+                        host.len),
       unknown_filter,
       private_filter);
 }
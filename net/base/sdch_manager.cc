@@ -5,6 +5,7 @@
 #include "net/base/sdch_manager.h"
 
 #include "base/base64.h"
+#include "base/lazy_instance.h"
 #include "base/logging.h"
 #include "base/metrics/histogram.h"
 #include "base/strings/string_number_conversions.h"
@@ -15,6 +16,18 @@
 
 namespace net {
 
+namespace {
+
+// Process-wide index of live shared dictionary texts, keyed by server hash.
+// Entries are added by DictionaryText::GetOrCreate() and removed by the
+// DictionaryText destructor, so the bare pointers never dangle.  Since every
+// SdchManager runs on the IO thread, the index needs no locking.
+typedef std::map<std::string, SdchManager::DictionaryText*> DictionaryTextMap;
+base::LazyInstance<DictionaryTextMap>::Leaky g_dictionary_texts =
+    LAZY_INSTANCE_INITIALIZER;
+
+}  // namespace
+
 //------------------------------------------------------------------------------
 // static
 
@@ -35,16 +48,44 @@ bool SdchManager::g_sdch_enabled_ = true;
 // static
 bool SdchManager::g_secure_scheme_supported_ = false;
 
+//------------------------------------------------------------------------------
+// static
+scoped_refptr<SdchManager::DictionaryText>
+SdchManager::DictionaryText::GetOrCreate(const std::string& server_hash,
+                                         const std::string& dictionary_text,
+                                         size_t offset) {
+  DictionaryTextMap* texts = g_dictionary_texts.Pointer();
+  DictionaryTextMap::iterator it = texts->find(server_hash);
+  if (it != texts->end())
+    return make_scoped_refptr(it->second);
+  return make_scoped_refptr(
+      new DictionaryText(server_hash, dictionary_text, offset));
+}
+
+SdchManager::DictionaryText::DictionaryText(
+    const std::string& server_hash,
+    const std::string& dictionary_text,
+    size_t offset)
+    : server_hash_(server_hash),
+      text_(dictionary_text, offset) {
+  (*g_dictionary_texts.Pointer())[server_hash_] = this;
+}
+
+SdchManager::DictionaryText::~DictionaryText() {
+  g_dictionary_texts.Pointer()->erase(server_hash_);
+}
+
 //------------------------------------------------------------------------------
 SdchManager::Dictionary::Dictionary(const std::string& dictionary_text,
                                     size_t offset,
                                     const std::string& client_hash,
+                                    const std::string& server_hash,
                                     const GURL& gurl,
                                     const std::string& domain,
                                     const std::string& path,
                                     const base::Time& expiration,
                                     const std::set<int>& ports)
-    : text_(dictionary_text, offset),
+    : text_(DictionaryText::GetOrCreate(server_hash, dictionary_text, offset)),
       client_hash_(client_hash),
       url_(gurl),
       domain_(domain),
@@ -475,7 +516,7 @@ bool SdchManager::AddSdchDictionary(const std::string& dictionary_text,
   DVLOG(1) << "Loaded dictionary with client hash " << client_hash
            << " and server hash " << server_hash;
   Dictionary* dictionary =
-      new Dictionary(dictionary_text, header_end + 2, client_hash,
+      new Dictionary(dictionary_text, header_end + 2, client_hash, server_hash,
                      dictionary_url, domain, path, expiration, ports);
   dictionaries_[server_hash] = dictionary;
   return true;
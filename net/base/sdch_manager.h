@@ -165,12 +165,46 @@ class NET_EXPORT SdchManager : public NON_EXPORTED_BASE(base::NonThreadSafe) {
   static const size_t kMaxDictionarySize;
   static const size_t kMaxDictionaryCount;
 
+  // The raw text of one SDCH dictionary.  The text is reference counted and
+  // shared across the SdchManager instances of every profile that has loaded
+  // the dictionary (keyed by its server hash), so a multi-megabyte dictionary
+  // used by several profiles is kept in memory only once per process.
+  // All profiles load dictionaries on the IO thread, so no locking is needed.
+  class NET_EXPORT_PRIVATE DictionaryText
+      : public base::RefCounted<DictionaryText> {
+   public:
+    // Return the shared text of the dictionary with the given |server_hash|,
+    // reusing the copy held by another profile when one exists, and otherwise
+    // creating it from |dictionary_text| starting at |offset|.
+    static scoped_refptr<DictionaryText> GetOrCreate(
+        const std::string& server_hash,
+        const std::string& dictionary_text,
+        size_t offset);
+
+    const std::string& text() const { return text_; }
+
+   private:
+    friend class base::RefCounted<DictionaryText>;
+
+    DictionaryText(const std::string& server_hash,
+                   const std::string& dictionary_text,
+                   size_t offset);
+    ~DictionaryText();
+
+    // Key under which this text is registered for sharing.
+    const std::string server_hash_;
+
+    const std::string text_;
+
+    DISALLOW_COPY_AND_ASSIGN(DictionaryText);
+  };
+
   // There is one instance of |Dictionary| for each memory-cached SDCH
   // dictionary.
   class NET_EXPORT_PRIVATE Dictionary : public base::RefCounted<Dictionary> {
    public:
     // Sdch filters can get our text to use in decoding compressed data.
-    const std::string& text() const { return text_; }
+    const std::string& text() const { return text_->text(); }
 
    private:
     friend class base::RefCounted<Dictionary>;
@@ -180,9 +214,12 @@ class NET_EXPORT SdchManager : public NON_EXPORTED_BASE(base::NonThreadSafe) {
     // Construct a vc-diff usable dictionary from the dictionary_text starting
     // at the given offset.  The supplied client_hash should be used to
     // advertise the dictionary's availability relative to the suppplied URL.
+    // The |server_hash| identifies the text, so that profiles loading the
+    // same dictionary share a single copy of it.
     Dictionary(const std::string& dictionary_text,
                size_t offset,
                const std::string& client_hash,
+               const std::string& server_hash,
                const GURL& url,
                const std::string& domain,
                const std::string& path,
@@ -214,8 +251,9 @@ class NET_EXPORT SdchManager : public NON_EXPORTED_BASE(base::NonThreadSafe) {
     static bool DomainMatch(const GURL& url, const std::string& restriction);
 
 
-    // The actual text of the dictionary.
-    std::string text_;
+    // The actual text of the dictionary, shared across profiles that have
+    // loaded the same dictionary.
+    scoped_refptr<DictionaryText> text_;
 
     // Part of the hash of text_ that the client uses to advertise the fact that
     // it has a specific dictionary pre-cached.
@@ -452,6 +452,35 @@ TEST_F(SdchManagerTest, CanUseMultipleManagers) {
   EXPECT_FALSE(dictionary);
 }
 
+TEST_F(SdchManagerTest, SharedDictionaryTextAcrossManagers) {
+  SdchManager second_manager;
+
+  std::string dictionary_domain("x.y.z.google.com");
+  std::string dictionary_text(NewSdchDictionary(dictionary_domain));
+
+  std::string tmp_hash;
+  std::string server_hash;
+  SdchManager::GenerateHash(dictionary_text, &tmp_hash, &server_hash);
+
+  GURL dictionary_url("http://" + dictionary_domain);
+  EXPECT_TRUE(sdch_manager()->AddSdchDictionary(dictionary_text,
+                                                dictionary_url));
+  EXPECT_TRUE(second_manager.AddSdchDictionary(dictionary_text,
+                                               dictionary_url));
+
+  GURL target_url("http://" + dictionary_domain + "/random_url");
+  scoped_refptr<SdchManager::Dictionary> dictionary1;
+  sdch_manager()->GetVcdiffDictionary(server_hash, target_url, &dictionary1);
+  ASSERT_TRUE(dictionary1);
+  scoped_refptr<SdchManager::Dictionary> dictionary2;
+  second_manager.GetVcdiffDictionary(server_hash, target_url, &dictionary2);
+  ASSERT_TRUE(dictionary2);
+
+  // Both managers loaded the same dictionary, so they should be backed by a
+  // single shared copy of the dictionary text.
+  EXPECT_EQ(dictionary1->text().data(), dictionary2->text().data());
+}
+
 TEST_F(SdchManagerTest, HttpsCorrectlySupported) {
   GURL url("http://www.google.com");
   GURL secure_url("https://www.google.com");
@@ -181,7 +181,14 @@ int UploadDataStream::ReadInternal(scoped_refptr<DrainableIOBuffer> buf,
     UploadElementReader* reader = element_readers_[element_index_];
 
     if (reader->BytesRemaining() == 0) {
-      ++element_index_;
+      if (is_chunked_) {
+        // Chunk readers keep their data in memory until they are consumed.
+        // Drop them as soon as they are, so that a long-lived chunked upload
+        // does not accumulate every chunk it has ever sent.
+        element_readers_.erase(element_readers_.begin() + element_index_);
+      } else {
+        ++element_index_;
+      }
       continue;
     }
 
@@ -383,6 +383,25 @@ TEST_F(UploadDataStreamTest, Chunk) {
   ASSERT_TRUE(stream.IsEOF());
 }
 
+// Reading a chunked stream should release the chunks it has consumed.
+TEST_F(UploadDataStreamTest, ChunkReleasedAfterRead) {
+  UploadDataStream stream(UploadDataStream::CHUNKED, 0);
+  stream.AppendChunk(kTestData, kTestDataSize, false);
+
+  ASSERT_EQ(OK, stream.Init(CompletionCallback()));
+  scoped_refptr<IOBuffer> buf = new IOBuffer(kTestBufferSize);
+  ASSERT_EQ(static_cast<int>(kTestDataSize),
+            stream.Read(buf.get(), kTestBufferSize, CompletionCallback()));
+  EXPECT_TRUE(stream.element_readers().empty());
+  EXPECT_FALSE(stream.IsEOF());
+
+  stream.AppendChunk(kTestData, kTestDataSize, true);
+  ASSERT_EQ(static_cast<int>(kTestDataSize),
+            stream.Read(buf.get(), kTestBufferSize, CompletionCallback()));
+  EXPECT_TRUE(stream.element_readers().empty());
+  EXPECT_TRUE(stream.IsEOF());
+}
+
 // Init() with on-memory and not-on-memory readers.
 TEST_F(UploadDataStreamTest, InitAsync) {
   // Create UploadDataStream with mock readers.
@@ -19,6 +19,8 @@
 #include "net/base/hash_value.h"
 #include "net/base/net_errors.h"
 #include "net/base/net_log.h"
+#include "net/base/net_util.h"
+#include "net/cert/cert_status_flags.h"
 #include "net/cert/cert_trust_anchor_provider.h"
 #include "net/cert/cert_verify_proc.h"
 #include "net/cert/crl_set.h"
@@ -168,9 +170,11 @@ bool MultiThreadedCertVerifier::CacheExpirationFunctor::operator()(
 class CertVerifierRequest {
  public:
   CertVerifierRequest(const CompletionCallback& callback,
+                      const std::string& hostname,
                       CertVerifyResult* verify_result,
                       const BoundNetLog& net_log)
       : callback_(callback),
+        hostname_(hostname),
         verify_result_(verify_result),
         net_log_(net_log) {
     net_log_.BeginEvent(NetLog::TYPE_CERT_VERIFIER_REQUEST);
@@ -200,10 +204,13 @@ class CertVerifierRequest {
 
   bool canceled() const { return callback_.is_null(); }
 
+  const std::string& hostname() const { return hostname_; }
+
   const BoundNetLog& net_log() const { return net_log_; }
 
  private:
   CompletionCallback callback_;
+  const std::string hostname_;
   CertVerifyResult* verify_result_;
   const BoundNetLog net_log_;
 };
@@ -351,9 +358,11 @@ class CertVerifierWorker {
 class CertVerifierJob {
  public:
   CertVerifierJob(CertVerifierWorker* worker,
+                  const std::string& hostname,
                   const BoundNetLog& net_log)
       : start_time_(base::TimeTicks::Now()),
         worker_(worker),
+        hostname_(hostname),
         net_log_(net_log) {
     net_log_.BeginEvent(
         NetLog::TYPE_CERT_VERIFIER_JOB,
@@ -408,7 +417,16 @@ class CertVerifierJob {
 
     for (std::vector<CertVerifierRequest*>::iterator
          i = requests.begin(); i != requests.end(); i++) {
-      (*i)->Post(verify_result);
+      if ((*i)->hostname() == hostname_) {
+        (*i)->Post(verify_result);
+      } else {
+        // The request joined this job for another hostname covered by the
+        // same certificate chain; redo only the name check for it.
+        MultiThreadedCertVerifier::CachedResult adjusted_result = verify_result;
+        MultiThreadedCertVerifier::CheckHostnameMatch((*i)->hostname(),
+                                                      &adjusted_result);
+        (*i)->Post(adjusted_result);
+      }
       // Post() causes the CertVerifierRequest to delete itself.
     }
   }
@@ -427,12 +445,16 @@ class CertVerifierJob {
   const base::TimeTicks start_time_;
   std::vector<CertVerifierRequest*> requests_;
   CertVerifierWorker* worker_;
+  // The hostname the worker is verifying against; requests for other
+  // hostnames get the name check redone in PostAll().
+  const std::string hostname_;
   const BoundNetLog net_log_;
 };
 
 MultiThreadedCertVerifier::MultiThreadedCertVerifier(
     CertVerifyProc* verify_proc)
     : cache_(kMaxCacheEntries),
+      chain_cache_(kMaxCacheEntries),
       first_job_(NULL),
       requests_(0),
       cache_hits_(0),
@@ -486,13 +508,33 @@ int MultiThreadedCertVerifier::Verify(X509Certificate* cert,
     return cached_entry->error;
   }
 
-  // No cache hit. See if an identical request is currently in flight.
+  // Building and checking the chain does not depend on the hostname, so a
+  // result computed for another hostname presenting the same chain can be
+  // reused after redoing the (cheap) name check. Chain-level entries are
+  // keyed with an empty hostname, which real requests can never use.
+  const RequestParams chain_key(cert->fingerprint(), cert->ca_fingerprint(),
+                                std::string(), flags,
+                                additional_trust_anchors);
+  const CertVerifierCache::value_type* cached_chain_entry =
+      chain_cache_.Get(chain_key, CacheValidityPeriod(base::Time::Now()));
+  if (cached_chain_entry) {
+    ++cache_hits_;
+    *out_req = NULL;
+    CachedResult adjusted_result = *cached_chain_entry;
+    CheckHostnameMatch(hostname, &adjusted_result);
+    *verify_result = adjusted_result.result;
+    return adjusted_result.error;
+  }
+
+  // No cache hit. See if a request for the same chain is currently in
+  // flight; the hostname need not match, since the name check is applied
+  // per-request when the job completes.
   CertVerifierJob* job;
   std::map<RequestParams, CertVerifierJob*>::const_iterator j;
-  j = inflight_.find(key);
+  j = inflight_.find(chain_key);
   if (j != inflight_.end()) {
-    // An identical request is in flight already. We'll just attach our
-    // callback.
+    // A request for the same chain is in flight already. We'll just attach
+    // our callback.
     inflight_joins_++;
     job = j->second;
   } else {
@@ -507,6 +549,7 @@ int MultiThreadedCertVerifier::Verify(X509Certificate* cert,
                                this);
     job = new CertVerifierJob(
         worker,
+        hostname,
         BoundNetLog::Make(net_log.net_log(), NetLog::SOURCE_CERT_VERIFIER_JOB));
     if (!worker->Start()) {
       delete job;
@@ -516,7 +559,7 @@ int MultiThreadedCertVerifier::Verify(X509Certificate* cert,
       LOG(ERROR) << "CertVerifierWorker couldn't be started.";
       return ERR_INSUFFICIENT_RESOURCES;  // Just a guess.
     }
-    inflight_.insert(std::make_pair(key, job));
+    inflight_.insert(std::make_pair(chain_key, job));
     if (requests_ == 1) {
       // Cleared in HandleResult.
       first_job_ = job;
@@ -524,7 +567,7 @@ int MultiThreadedCertVerifier::Verify(X509Certificate* cert,
   }
 
   CertVerifierRequest* request =
-      new CertVerifierRequest(callback, verify_result, net_log);
+      new CertVerifierRequest(callback, hostname, verify_result, net_log);
   job->AddRequest(request);
   *out_req = request;
   return ERR_IO_PENDING;
@@ -568,6 +611,36 @@ bool MultiThreadedCertVerifier::RequestParams::operator<(
       net::SHA1HashValueLessThan());
 }
 
+// static
+void MultiThreadedCertVerifier::CheckHostnameMatch(const std::string& hostname,
+                                                   CachedResult* cached_result) {
+  CertVerifyResult* result = &cached_result->result;
+  if (!result->verified_cert.get())
+    return;
+  result->cert_status &= ~CERT_STATUS_COMMON_NAME_INVALID;
+  result->common_name_fallback_used = false;
+  if (!result->verified_cert->VerifyNameMatch(
+          hostname, &result->common_name_fallback_used)) {
+    result->cert_status |= CERT_STATUS_COMMON_NAME_INVALID;
+  }
+  // CERT_STATUS_NON_UNIQUE_NAME is also hostname-dependent: it marks
+  // publicly-trusted certificates served for intranet names. Recompute it
+  // from the chain-level is_issued_by_known_root, mirroring
+  // CertVerifyProc::Verify. It is a warning, not an error, so it does not
+  // feed into the error recomputation below.
+  result->cert_status &= ~CERT_STATUS_NON_UNIQUE_NAME;
+  if (result->is_issued_by_known_root && IsHostnameNonUnique(hostname))
+    result->cert_status |= CERT_STATUS_NON_UNIQUE_NAME;
+  // The name check is the only hostname-dependent input to the error, so the
+  // error is recomputed only when it reflected the name check (or success);
+  // other errors, such as ERR_CERT_REVOKED, stand as-is.
+  if (cached_result->error == OK ||
+      cached_result->error == ERR_CERT_COMMON_NAME_INVALID) {
+    cached_result->error = IsCertStatusError(result->cert_status) ?
+        MapCertStatusToNetError(result->cert_status) : OK;
+  }
+}
+
 // HandleResult is called by CertVerifierWorker on the origin message loop.
 // It deletes CertVerifierJob.
 void MultiThreadedCertVerifier::HandleResult(
@@ -581,6 +654,9 @@ void MultiThreadedCertVerifier::HandleResult(
 
   const RequestParams key(cert->fingerprint(), cert->ca_fingerprint(),
                           hostname, flags, additional_trust_anchors);
+  const RequestParams chain_key(cert->fingerprint(), cert->ca_fingerprint(),
+                                std::string(), flags,
+                                additional_trust_anchors);
 
   CachedResult cached_result;
   cached_result.error = error;
@@ -589,9 +665,17 @@ void MultiThreadedCertVerifier::HandleResult(
   cache_.Put(
       key, cached_result, CacheValidityPeriod(now),
       CacheValidityPeriod(now, now + base::TimeDelta::FromSeconds(kTTLSecs)));
+  // Memoize the chain-level work for other hostnames covered by the same
+  // certificate. Results without a verified chain cannot have the name check
+  // redone against them and are only cached per-hostname above.
+  if (verify_result.verified_cert.get()) {
+    chain_cache_.Put(
+        chain_key, cached_result, CacheValidityPeriod(now),
+        CacheValidityPeriod(now, now + base::TimeDelta::FromSeconds(kTTLSecs)));
+  }
 
   std::map<RequestParams, CertVerifierJob*>::iterator j;
-  j = inflight_.find(key);
+  j = inflight_.find(chain_key);
   if (j == inflight_.end()) {
     NOTREACHED();
     return;
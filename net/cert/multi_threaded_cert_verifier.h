@@ -71,13 +71,17 @@ class NET_EXPORT_PRIVATE MultiThreadedCertVerifier
   friend class CertVerifierJob;
   friend class MultiThreadedCertVerifierTest;
   FRIEND_TEST_ALL_PREFIXES(MultiThreadedCertVerifierTest, CacheHit);
+  FRIEND_TEST_ALL_PREFIXES(MultiThreadedCertVerifierTest, ChainCacheHit);
   FRIEND_TEST_ALL_PREFIXES(MultiThreadedCertVerifierTest, DifferentCACerts);
   FRIEND_TEST_ALL_PREFIXES(MultiThreadedCertVerifierTest, InflightJoin);
+  FRIEND_TEST_ALL_PREFIXES(MultiThreadedCertVerifierTest, CrossHostInflightJoin);
   FRIEND_TEST_ALL_PREFIXES(MultiThreadedCertVerifierTest, CancelRequest);
   FRIEND_TEST_ALL_PREFIXES(MultiThreadedCertVerifierTest,
                            RequestParamsComparators);
   FRIEND_TEST_ALL_PREFIXES(MultiThreadedCertVerifierTest,
                            CertTrustAnchorProvider);
+  FRIEND_TEST_ALL_PREFIXES(MultiThreadedCertVerifierTest,
+                           CheckHostnameMatchNonUniqueName);
 
   // Input parameters of a certificate verification request.
   struct NET_EXPORT_PRIVATE RequestParams {
@@ -129,6 +133,15 @@ class NET_EXPORT_PRIVATE MultiThreadedCertVerifier
   typedef ExpiringCache<RequestParams, CachedResult, CacheValidityPeriod,
                         CacheExpirationFunctor> CertVerifierCache;
 
+  // Recomputes the hostname-dependent portion of |cached_result| - the name
+  // match against the verified certificate and the non-unique-name flag -
+  // for |hostname|. Building and checking the chain is independent of the
+  // hostname, so a result obtained for one hostname can be reused for
+  // another after this cheap step, e.g. when many subdomains share one
+  // wildcard certificate.
+  static void CheckHostnameMatch(const std::string& hostname,
+                                 CachedResult* cached_result);
+
   void HandleResult(X509Certificate* cert,
                     const std::string& hostname,
                     int flags,
@@ -140,8 +153,12 @@ class NET_EXPORT_PRIVATE MultiThreadedCertVerifier
   virtual void OnCACertChanged(const X509Certificate* cert) OVERRIDE;
 
   // For unit testing.
-  void ClearCache() { cache_.Clear(); }
+  void ClearCache() {
+    cache_.Clear();
+    chain_cache_.Clear();
+  }
   size_t GetCacheSize() const { return cache_.size(); }
+  size_t GetChainCacheSize() const { return chain_cache_.size(); }
   uint64 cache_hits() const { return cache_hits_; }
   uint64 requests() const { return requests_; }
   uint64 inflight_joins() const { return inflight_joins_; }
@@ -149,8 +166,15 @@ class NET_EXPORT_PRIVATE MultiThreadedCertVerifier
   // cache_ maps from a request to a cached result.
   CertVerifierCache cache_;
 
-  // inflight_ maps from a request to an active verification which is taking
-  // place.
+  // chain_cache_ maps from the hostname-independent portion of a request (the
+  // key uses an empty hostname) to a cached result for the certificate chain.
+  // Requests for other hostnames presenting an already-verified chain are
+  // answered from here after redoing only the name check.
+  CertVerifierCache chain_cache_;
+
+  // inflight_ maps from the hostname-independent portion of a request to an
+  // active verification which is taking place, so that concurrent requests
+  // for many hostnames covered by one certificate share a single worker.
   std::map<RequestParams, CertVerifierJob*> inflight_;
 
   // A non-owning pointer to the first job for histogramming.
@@ -121,6 +121,83 @@ TEST_F(MultiThreadedCertVerifierTest, CacheHit) {
   ASSERT_EQ(1u, verifier_.GetCacheSize());
 }
 
+// Tests that a request for a different hostname presenting an
+// already-verified chain completes synchronously from the chain-level cache,
+// with only the name check redone.
+TEST_F(MultiThreadedCertVerifierTest, ChainCacheHit) {
+  base::FilePath certs_dir = GetTestCertsDirectory();
+  scoped_refptr<X509Certificate> test_cert(
+      ImportCertFromFile(certs_dir, "ok_cert.pem"));
+  ASSERT_NE(static_cast<X509Certificate*>(NULL), test_cert);
+
+  int error;
+  CertVerifyResult verify_result;
+  TestCompletionCallback callback;
+  CertVerifier::RequestHandle request_handle;
+
+  error = verifier_.Verify(test_cert.get(),
+                           "www.example.com",
+                           0,
+                           NULL,
+                           &verify_result,
+                           callback.callback(),
+                           &request_handle,
+                           BoundNetLog());
+  ASSERT_EQ(ERR_IO_PENDING, error);
+  EXPECT_TRUE(request_handle);
+  error = callback.WaitForResult();
+  ASSERT_TRUE(IsCertificateError(error));
+  ASSERT_EQ(1u, verifier_.requests());
+  ASSERT_EQ(0u, verifier_.cache_hits());
+  ASSERT_EQ(1u, verifier_.GetCacheSize());
+  ASSERT_EQ(1u, verifier_.GetChainCacheSize());
+
+  error = verifier_.Verify(test_cert.get(),
+                           "mail.example.com",
+                           0,
+                           NULL,
+                           &verify_result,
+                           callback.callback(),
+                           &request_handle,
+                           BoundNetLog());
+  // Synchronous completion from the chain-level cache; the per-hostname
+  // cache has no entry for this hostname.
+  ASSERT_NE(ERR_IO_PENDING, error);
+  ASSERT_EQ(ERR_CERT_COMMON_NAME_INVALID, error);
+  ASSERT_TRUE(request_handle == NULL);
+  ASSERT_EQ(2u, verifier_.requests());
+  ASSERT_EQ(1u, verifier_.cache_hits());
+  ASSERT_EQ(0u, verifier_.inflight_joins());
+  ASSERT_EQ(1u, verifier_.GetCacheSize());
+}
+
+// Tests that the hostname-dependent CERT_STATUS_NON_UNIQUE_NAME flag is
+// recomputed when a chain-level cached result is reused for a new hostname.
+TEST_F(MultiThreadedCertVerifierTest, CheckHostnameMatchNonUniqueName) {
+  base::FilePath certs_dir = GetTestCertsDirectory();
+  scoped_refptr<X509Certificate> test_cert(
+      ImportCertFromFile(certs_dir, "ok_cert.pem"));
+  ASSERT_NE(static_cast<X509Certificate*>(NULL), test_cert);
+
+  MultiThreadedCertVerifier::CachedResult cached_result;
+  cached_result.error = OK;
+  cached_result.result.verified_cert = test_cert;
+  cached_result.result.is_issued_by_known_root = true;
+  cached_result.result.cert_status = CERT_STATUS_NON_UNIQUE_NAME;
+
+  // A unique (public) hostname must not inherit the flag from a result
+  // cached for a non-unique one.
+  MultiThreadedCertVerifier::CheckHostnameMatch("www.example.com",
+                                                &cached_result);
+  EXPECT_FALSE(cached_result.result.cert_status &
+               CERT_STATUS_NON_UNIQUE_NAME);
+
+  // And a non-unique (intranet) hostname must gain it.
+  MultiThreadedCertVerifier::CheckHostnameMatch("intranet", &cached_result);
+  EXPECT_TRUE(cached_result.result.cert_status &
+              CERT_STATUS_NON_UNIQUE_NAME);
+}
+
 // Tests the same server certificate with different intermediate CA
 // certificates.  These should be treated as different certificate chains even
 // though the two X509Certificate objects contain the same server certificate.
@@ -235,6 +312,51 @@ TEST_F(MultiThreadedCertVerifierTest, InflightJoin) {
   ASSERT_EQ(1u, verifier_.inflight_joins());
 }
 
+// Tests that concurrent requests for different hostnames presenting the same
+// certificate chain are coalesced into one verification.
+TEST_F(MultiThreadedCertVerifierTest, CrossHostInflightJoin) {
+  base::FilePath certs_dir = GetTestCertsDirectory();
+  scoped_refptr<X509Certificate> test_cert(
+      ImportCertFromFile(certs_dir, "ok_cert.pem"));
+  ASSERT_NE(static_cast<X509Certificate*>(NULL), test_cert);
+
+  int error;
+  CertVerifyResult verify_result;
+  TestCompletionCallback callback;
+  CertVerifier::RequestHandle request_handle;
+  CertVerifyResult verify_result2;
+  TestCompletionCallback callback2;
+  CertVerifier::RequestHandle request_handle2;
+
+  error = verifier_.Verify(test_cert.get(),
+                           "www.example.com",
+                           0,
+                           NULL,
+                           &verify_result,
+                           callback.callback(),
+                           &request_handle,
+                           BoundNetLog());
+  ASSERT_EQ(ERR_IO_PENDING, error);
+  EXPECT_TRUE(request_handle);
+  error = verifier_.Verify(test_cert.get(),
+                           "mail.example.com",
+                           0,
+                           NULL,
+                           &verify_result2,
+                           callback2.callback(),
+                           &request_handle2,
+                           BoundNetLog());
+  EXPECT_EQ(ERR_IO_PENDING, error);
+  EXPECT_TRUE(request_handle2 != NULL);
+  error = callback.WaitForResult();
+  EXPECT_TRUE(IsCertificateError(error));
+  error = callback2.WaitForResult();
+  EXPECT_EQ(ERR_CERT_COMMON_NAME_INVALID, error);
+  ASSERT_EQ(2u, verifier_.requests());
+  ASSERT_EQ(0u, verifier_.cache_hits());
+  ASSERT_EQ(1u, verifier_.inflight_joins());
+}
+
 // Tests that the callback of a canceled request is never made.
 TEST_F(MultiThreadedCertVerifierTest, CancelRequest) {
   base::FilePath certs_dir = GetTestCertsDirectory();
@@ -51,6 +51,7 @@
 #include "base/basictypes.h"
 #include "base/bind.h"
 #include "base/callback.h"
+#include "base/hash.h"
 #include "base/logging.h"
 #include "base/memory/scoped_ptr.h"
 #include "base/memory/scoped_vector.h"
@@ -340,6 +341,28 @@ CookieMonster::CookieMonster(PersistentCookieStore* store,
   SetDefaultCookieableSchemes();
 }
 
+CookieMonster::CookieShard::CookieShard() {}
+
+CookieMonster::CookieShard::~CookieShard() {}
+
+CookieMonster::CookieShard& CookieMonster::ShardForKey(
+    const std::string& key) {
+  COMPILE_ASSERT((kNumCookieShards & (kNumCookieShards - 1)) == 0,
+                 kNumCookieShards_must_be_a_power_of_two);
+  return shards_[base::Hash(key) & (kNumCookieShards - 1)];
+}
+
+CookieMonster::AutoLockAllShards::AutoLockAllShards(CookieMonster* monster)
+    : monster_(monster) {
+  for (size_t i = 0; i < kNumCookieShards; ++i)
+    monster_->shards_[i].lock.Acquire();
+}
+
+CookieMonster::AutoLockAllShards::~AutoLockAllShards() {
+  for (size_t i = kNumCookieShards; i > 0; --i)
+    monster_->shards_[i - 1].lock.Release();
+}
+
 
 // Task classes for queueing the coming request.
 
@@ -1080,13 +1103,16 @@ bool CookieMonster::SetCookieWithDetails(const GURL& url,
                                          bool secure,
                                          bool http_only,
                                          CookiePriority priority) {
-  base::AutoLock autolock(lock_);
+  Time creation_time;
+  {
+    base::AutoLock autolock(lock_);
 
-  if (!HasCookieableScheme(url))
-    return false;
+    if (!HasCookieableScheme(url))
+      return false;
 
-  Time creation_time = CurrentTime();
-  last_time_seen_ = creation_time;
+    creation_time = CurrentTime();
+    last_time_seen_ = creation_time;
+  }
 
   scoped_ptr<CanonicalCookie> cc;
   cc.reset(CanonicalCookie::Create(url, name, value, domain, path,
@@ -1102,8 +1128,10 @@ bool CookieMonster::SetCookieWithDetails(const GURL& url,
 }
 
 bool CookieMonster::InitializeFrom(const CookieList& list) {
-  base::AutoLock autolock(lock_);
-  InitIfNecessary();
+  {
+    base::AutoLock autolock(lock_);
+    InitIfNecessary();
+  }
   for (net::CookieList::const_iterator iter = list.begin();
            iter != list.end(); ++iter) {
     scoped_ptr<CanonicalCookie> cookie(new CanonicalCookie(*iter));
@@ -1116,7 +1144,7 @@ bool CookieMonster::InitializeFrom(const CookieList& list) {
 }
 
 CookieList CookieMonster::GetAllCookies() {
-  base::AutoLock autolock(lock_);
+  AutoLockAllShards all_shards(this);
 
   // This function is being called to scrape the cookie list for management UI
   // or similar.  We shouldn't show expired cookies in this list since it will
@@ -1126,16 +1154,22 @@ CookieList CookieMonster::GetAllCookies() {
   //
   // Note that this does not prune cookies to be below our limits (if we've
   // exceeded them) the way that calling GarbageCollect() would.
-  GarbageCollectExpired(Time::Now(),
-                        CookieMapItPair(cookies_.begin(), cookies_.end()),
-                        NULL);
+  const Time now(Time::Now());
+  for (size_t i = 0; i < kNumCookieShards; ++i) {
+    GarbageCollectExpired(now,
+                          CookieMapItPair(shards_[i].cookies.begin(),
+                                          shards_[i].cookies.end()),
+                          NULL);
+  }
 
-  // Copy the CanonicalCookie pointers from the map so that we can use the same
-  // sorter as elsewhere, then copy the result out.
+  // Copy the CanonicalCookie pointers from the maps so that we can use the
+  // same sorter as elsewhere, then copy the result out.
   std::vector<CanonicalCookie*> cookie_ptrs;
-  cookie_ptrs.reserve(cookies_.size());
-  for (CookieMap::iterator it = cookies_.begin(); it != cookies_.end(); ++it)
-    cookie_ptrs.push_back(it->second);
+  for (size_t i = 0; i < kNumCookieShards; ++i) {
+    CookieMap& cookies = shards_[i].cookies;
+    for (CookieMap::iterator it = cookies.begin(); it != cookies.end(); ++it)
+      cookie_ptrs.push_back(it->second);
+  }
   std::sort(cookie_ptrs.begin(), cookie_ptrs.end(), CookieSorter);
 
   CookieList cookie_list;
@@ -1150,10 +1184,19 @@ CookieList CookieMonster::GetAllCookies() {
 CookieList CookieMonster::GetAllCookiesForURLWithOptions(
     const GURL& url,
     const CookieOptions& options) {
-  base::AutoLock autolock(lock_);
+  Time current_time;
+  {
+    base::AutoLock autolock(lock_);
+    current_time = CurrentTime();
+  }
+  RecordPeriodicStats(current_time);
+
+  const std::string key(GetKey(url.host()));
+  CookieShard& shard = ShardForKey(key);
+  base::AutoLock shard_lock(shard.lock);
 
   std::vector<CanonicalCookie*> cookie_ptrs;
-  FindCookiesForHostAndDomain(url, options, false, &cookie_ptrs);
+  FindCookiesForKey(key, url, options, current_time, false, &cookie_ptrs);
   std::sort(cookie_ptrs.begin(), cookie_ptrs.end(), CookieSorter);
 
   CookieList cookies;
@@ -1172,16 +1215,19 @@ CookieList CookieMonster::GetAllCookiesForURL(const GURL& url) {
 }
 
 int CookieMonster::DeleteAll(bool sync_to_store) {
-  base::AutoLock autolock(lock_);
+  AutoLockAllShards all_shards(this);
 
   int num_deleted = 0;
-  for (CookieMap::iterator it = cookies_.begin(); it != cookies_.end();) {
-    CookieMap::iterator curit = it;
-    ++it;
-    InternalDeleteCookie(curit, sync_to_store,
-                         sync_to_store ? DELETE_COOKIE_EXPLICIT :
-                             DELETE_COOKIE_DONT_RECORD /* Destruction. */);
-    ++num_deleted;
+  for (size_t i = 0; i < kNumCookieShards; ++i) {
+    CookieMap& cookies = shards_[i].cookies;
+    for (CookieMap::iterator it = cookies.begin(); it != cookies.end();) {
+      CookieMap::iterator curit = it;
+      ++it;
+      InternalDeleteCookie(curit, sync_to_store,
+                           sync_to_store ? DELETE_COOKIE_EXPLICIT :
+                               DELETE_COOKIE_DONT_RECORD /* Destruction. */);
+      ++num_deleted;
+    }
   }
 
   return num_deleted;
@@ -1189,20 +1235,23 @@ int CookieMonster::DeleteAll(bool sync_to_store) {
 
 int CookieMonster::DeleteAllCreatedBetween(const Time& delete_begin,
                                            const Time& delete_end) {
-  base::AutoLock autolock(lock_);
+  AutoLockAllShards all_shards(this);
 
   int num_deleted = 0;
-  for (CookieMap::iterator it = cookies_.begin(); it != cookies_.end();) {
-    CookieMap::iterator curit = it;
-    CanonicalCookie* cc = curit->second;
-    ++it;
-
-    if (cc->CreationDate() >= delete_begin &&
-        (delete_end.is_null() || cc->CreationDate() < delete_end)) {
-      InternalDeleteCookie(curit,
-                           true,  /*sync_to_store*/
-                           DELETE_COOKIE_EXPLICIT);
-      ++num_deleted;
+  for (size_t i = 0; i < kNumCookieShards; ++i) {
+    CookieMap& cookies = shards_[i].cookies;
+    for (CookieMap::iterator it = cookies.begin(); it != cookies.end();) {
+      CookieMap::iterator curit = it;
+      CanonicalCookie* cc = curit->second;
+      ++it;
+
+      if (cc->CreationDate() >= delete_begin &&
+          (delete_end.is_null() || cc->CreationDate() < delete_end)) {
+        InternalDeleteCookie(curit,
+                             true,  /*sync_to_store*/
+                             DELETE_COOKIE_EXPLICIT);
+        ++num_deleted;
+      }
     }
   }
 
@@ -1212,18 +1261,21 @@ int CookieMonster::DeleteAllCreatedBetween(const Time& delete_begin,
 int CookieMonster::DeleteAllCreatedBetweenForHost(const Time delete_begin,
                                                   const Time delete_end,
                                                   const GURL& url) {
-  base::AutoLock autolock(lock_);
-
-  if (!HasCookieableScheme(url))
-    return 0;
+  {
+    base::AutoLock autolock(lock_);
+    if (!HasCookieableScheme(url))
+      return 0;
+  }
 
   const std::string host(url.host());
+  CookieShard& shard = ShardForKey(GetKey(host));
+  base::AutoLock shard_lock(shard.lock);
 
   // We store host cookies in the store by their canonical host name;
   // domain cookies are stored with a leading ".".  So this is a pretty
   // simple lookup and per-cookie delete.
   int num_deleted = 0;
-  for (CookieMapItPair its = cookies_.equal_range(GetKey(host));
+  for (CookieMapItPair its = shard.cookies.equal_range(GetKey(host));
        its.first != its.second;) {
     CookieMap::iterator curit = its.first;
     ++its.first;
@@ -1250,9 +1302,11 @@ int CookieMonster::DeleteAllForHost(const GURL& url) {
 
 
 bool CookieMonster::DeleteCanonicalCookie(const CanonicalCookie& cookie) {
-  base::AutoLock autolock(lock_);
+  const std::string key(GetKey(cookie.Domain()));
+  CookieShard& shard = ShardForKey(key);
+  base::AutoLock shard_lock(shard.lock);
 
-  for (CookieMapItPair its = cookies_.equal_range(GetKey(cookie.Domain()));
+  for (CookieMapItPair its = shard.cookies.equal_range(key);
        its.first != its.second; ++its.first) {
     // The creation date acts as our unique index...
     if (its.first->second->CreationDate() == cookie.CreationDate()) {
@@ -1298,10 +1352,11 @@ void CookieMonster::FlushStore(const base::Closure& callback) {
 bool CookieMonster::SetCookieWithOptions(const GURL& url,
                                          const std::string& cookie_line,
                                          const CookieOptions& options) {
-  base::AutoLock autolock(lock_);
-
-  if (!HasCookieableScheme(url)) {
-    return false;
+  {
+    base::AutoLock autolock(lock_);
+    if (!HasCookieableScheme(url)) {
+      return false;
+    }
   }
 
   return SetCookieWithCreationTimeAndOptions(url, cookie_line, Time(), options);
@@ -1309,15 +1364,27 @@ bool CookieMonster::SetCookieWithOptions(const GURL& url,
 
 std::string CookieMonster::GetCookiesWithOptions(const GURL& url,
                                                  const CookieOptions& options) {
-  base::AutoLock autolock(lock_);
-
-  if (!HasCookieableScheme(url))
-    return std::string();
+  Time current_time;
+  {
+    base::AutoLock autolock(lock_);
+    if (!HasCookieableScheme(url))
+      return std::string();
+    current_time = CurrentTime();
+  }
 
   TimeTicks start_time(TimeTicks::Now());
 
+  // Probe to save statistics relatively frequently.  We do it here rather
+  // than in the set path as many websites won't set cookies, and we
+  // want to collect statistics whenever the browser's being used.
+  RecordPeriodicStats(current_time);
+
+  const std::string key(GetKey(url.host()));
+  CookieShard& shard = ShardForKey(key);
+  base::AutoLock shard_lock(shard.lock);
+
   std::vector<CanonicalCookie*> cookies;
-  FindCookiesForHostAndDomain(url, options, true, &cookies);
+  FindCookiesForKey(key, url, options, current_time, true, &cookies);
   std::sort(cookies.begin(), cookies.end(), CookieSorter);
 
   std::string cookie_line = BuildCookieLine(cookies);
@@ -1331,16 +1398,24 @@ std::string CookieMonster::GetCookiesWithOptions(const GURL& url,
 
 void CookieMonster::DeleteCookie(const GURL& url,
                                  const std::string& cookie_name) {
-  base::AutoLock autolock(lock_);
-
-  if (!HasCookieableScheme(url))
-    return;
+  Time current_time;
+  {
+    base::AutoLock autolock(lock_);
+    if (!HasCookieableScheme(url))
+      return;
+    current_time = CurrentTime();
+  }
 
   CookieOptions options;
   options.set_include_httponly();
+
+  const std::string key(GetKey(url.host()));
+  CookieShard& shard = ShardForKey(key);
+  base::AutoLock shard_lock(shard.lock);
+
   // Get the cookies for this host and its domain(s).
   std::vector<CanonicalCookie*> cookies;
-  FindCookiesForHostAndDomain(url, options, true, &cookies);
+  FindCookiesForKey(key, url, options, current_time, true, &cookies);
   std::set<CanonicalCookie*> matching_cookies;
 
   for (std::vector<CanonicalCookie*>::const_iterator it = cookies.begin();
@@ -1352,9 +1427,12 @@ void CookieMonster::DeleteCookie(const GURL& url,
     matching_cookies.insert(*it);
   }
 
-  for (CookieMap::iterator it = cookies_.begin(); it != cookies_.end();) {
-    CookieMap::iterator curit = it;
-    ++it;
+  // All candidates share the same eTLD+1, so only this shard's range for
+  // |key| needs to be walked.
+  for (CookieMapItPair its = shard.cookies.equal_range(key);
+       its.first != its.second;) {
+    CookieMap::iterator curit = its.first;
+    ++its.first;
     if (matching_cookies.find(curit->second) != matching_cookies.end()) {
       InternalDeleteCookie(curit, true, DELETE_COOKIE_EXPLICIT);
     }
@@ -1362,19 +1440,22 @@ void CookieMonster::DeleteCookie(const GURL& url,
 }
 
 int CookieMonster::DeleteSessionCookies() {
-  base::AutoLock autolock(lock_);
+  AutoLockAllShards all_shards(this);
 
   int num_deleted = 0;
-  for (CookieMap::iterator it = cookies_.begin(); it != cookies_.end();) {
-    CookieMap::iterator curit = it;
-    CanonicalCookie* cc = curit->second;
-    ++it;
+  for (size_t i = 0; i < kNumCookieShards; ++i) {
+    CookieMap& cookies = shards_[i].cookies;
+    for (CookieMap::iterator it = cookies.begin(); it != cookies.end();) {
+      CookieMap::iterator curit = it;
+      CanonicalCookie* cc = curit->second;
+      ++it;
 
-    if (!cc->IsPersistent()) {
-      InternalDeleteCookie(curit,
-                           true,  /*sync_to_store*/
-                           DELETE_COOKIE_EXPIRED);
-      ++num_deleted;
+      if (!cc->IsPersistent()) {
+        InternalDeleteCookie(curit,
+                             true,  /*sync_to_store*/
+                             DELETE_COOKIE_EXPIRED);
+        ++num_deleted;
+      }
     }
   }
 
@@ -1382,11 +1463,11 @@ int CookieMonster::DeleteSessionCookies() {
 }
 
 bool CookieMonster::HasCookiesForETLDP1(const std::string& etldp1) {
-  base::AutoLock autolock(lock_);
-
   const std::string key(GetKey(etldp1));
+  CookieShard& shard = ShardForKey(key);
+  base::AutoLock shard_lock(shard.lock);
 
-  CookieMapItPair its = cookies_.equal_range(key);
+  CookieMapItPair its = shard.cookies.equal_range(key);
   return its.first != its.second;
 }
 
@@ -1414,13 +1495,15 @@ bool CookieMonster::SetCookieWithCreationTime(const GURL& url,
                                               const std::string& cookie_line,
                                               const base::Time& creation_time) {
   DCHECK(!store_.get()) << "This method is only to be used by unit-tests.";
-  base::AutoLock autolock(lock_);
+  {
+    base::AutoLock autolock(lock_);
 
-  if (!HasCookieableScheme(url)) {
-    return false;
-  }
+    if (!HasCookieableScheme(url)) {
+      return false;
+    }
 
-  InitIfNecessary();
+    InitIfNecessary();
+  }
   return SetCookieWithCreationTimeAndOptions(url, cookie_line, creation_time,
                                              CookieOptions());
 }
@@ -1488,21 +1571,29 @@ void CookieMonster::StoreLoadedCookies(
   // Initialize the store and sync in any saved persistent cookies.  We don't
   // care if it's expired, insert it so it can be garbage collected, removed,
   // and sync'd.
-  base::AutoLock autolock(lock_);
-
   CookieItVector cookies_with_control_chars;
 
   for (std::vector<CanonicalCookie*>::const_iterator it = cookies.begin();
        it != cookies.end(); ++it) {
     int64 cookie_creation_time = (*it)->CreationDate().ToInternalValue();
 
-    if (creation_times_.insert(cookie_creation_time).second) {
-      CookieMap::iterator inserted =
-          InternalInsertCookie(GetKey((*it)->Domain()), *it, false);
-      const Time cookie_access_time((*it)->LastAccessDate());
-      if (earliest_access_time_.is_null() ||
-          cookie_access_time < earliest_access_time_)
-        earliest_access_time_ = cookie_access_time;
+    bool is_new_creation_time;
+    {
+      base::AutoLock autolock(lock_);
+      is_new_creation_time = creation_times_.insert(cookie_creation_time).second;
+      if (is_new_creation_time) {
+        const Time cookie_access_time((*it)->LastAccessDate());
+        if (earliest_access_time_.is_null() ||
+            cookie_access_time < earliest_access_time_)
+          earliest_access_time_ = cookie_access_time;
+      }
+    }
+
+    if (is_new_creation_time) {
+      const std::string key(GetKey((*it)->Domain()));
+      CookieShard& shard = ShardForKey(key);
+      base::AutoLock shard_lock(shard.lock);
+      CookieMap::iterator inserted = InternalInsertCookie(key, *it, false);
 
       if (ContainsControlCharacter((*it)->Name()) ||
           ContainsControlCharacter((*it)->Value())) {
@@ -1528,6 +1619,8 @@ void CookieMonster::StoreLoadedCookies(
     CookieItVector::iterator curit = it;
     ++it;
 
+    CookieShard& shard = ShardForKey((*curit)->first);
+    base::AutoLock shard_lock(shard.lock);
     InternalDeleteCookie(*curit, true, DELETE_COOKIE_CONTROL_CHAR);
   }
 
@@ -1560,21 +1653,24 @@ void CookieMonster::InvokeQueue() {
 }
 
 void CookieMonster::EnsureCookiesMapIsValid() {
-  lock_.AssertAcquired();
+  AutoLockAllShards all_shards(this);
 
   int num_duplicates_trimmed = 0;
 
   // Iterate through all the of the cookies, grouped by host.
-  CookieMap::iterator prev_range_end = cookies_.begin();
-  while (prev_range_end != cookies_.end()) {
-    CookieMap::iterator cur_range_begin = prev_range_end;
-    const std::string key = cur_range_begin->first;  // Keep a copy.
-    CookieMap::iterator cur_range_end = cookies_.upper_bound(key);
-    prev_range_end = cur_range_end;
-
-    // Ensure no equivalent cookies for this host.
-    num_duplicates_trimmed +=
-        TrimDuplicateCookiesForKey(key, cur_range_begin, cur_range_end);
+  for (size_t i = 0; i < kNumCookieShards; ++i) {
+    CookieMap& cookies = shards_[i].cookies;
+    CookieMap::iterator prev_range_end = cookies.begin();
+    while (prev_range_end != cookies.end()) {
+      CookieMap::iterator cur_range_begin = prev_range_end;
+      const std::string key = cur_range_begin->first;  // Keep a copy.
+      CookieMap::iterator cur_range_end = cookies.upper_bound(key);
+      prev_range_end = cur_range_end;
+
+      // Ensure no equivalent cookies for this host.
+      num_duplicates_trimmed +=
+          TrimDuplicateCookiesForKey(key, cur_range_begin, cur_range_end);
+    }
   }
 
   // Record how many duplicates were found in the database.
@@ -1586,7 +1682,7 @@ int CookieMonster::TrimDuplicateCookiesForKey(
     const std::string& key,
     CookieMap::iterator begin,
     CookieMap::iterator end) {
-  lock_.AssertAcquired();
+  ShardForKey(key).lock.AssertAcquired();
 
   // Set of cookies ordered by creation time.
   typedef std::set<CookieMap::iterator, OrderByCreationTimeDesc> CookieSet;
@@ -1612,7 +1708,7 @@ int CookieMonster::TrimDuplicateCookiesForKey(
     if (!set.empty())
       num_duplicates++;
 
-    // We save the iterator into |cookies_| rather than the actual cookie
+    // We save the iterator into the cookie map rather than the actual cookie
     // pointer, since we may need to delete it later.
     bool insert_success = set.insert(it).second;
     DCHECK(insert_success) <<
@@ -1652,7 +1748,7 @@ int CookieMonster::TrimDuplicateCookiesForKey(
         signature.path.c_str());
 
     // Remove all the cookies identified by |dupes|. It is valid to delete our
-    // list of iterators one at a time, since |cookies_| is a multimap (they
+    // list of iterators one at a time, since the cookie map is a multimap (they
     // don't invalidate existing iterators following deletion).
     for (CookieSet::iterator dupes_it = dupes.begin();
          dupes_it != dupes.end();
@@ -1678,35 +1774,16 @@ void CookieMonster::SetDefaultCookieableSchemes() {
                        kDefaultCookieableSchemesCount - 1);
 }
 
-void CookieMonster::FindCookiesForHostAndDomain(
-    const GURL& url,
-    const CookieOptions& options,
-    bool update_access_time,
-    std::vector<CanonicalCookie*>* cookies) {
-  lock_.AssertAcquired();
-
-  const Time current_time(CurrentTime());
-
-  // Probe to save statistics relatively frequently.  We do it here rather
-  // than in the set path as many websites won't set cookies, and we
-  // want to collect statistics whenever the browser's being used.
-  RecordPeriodicStats(current_time);
-
-  // Can just dispatch to FindCookiesForKey
-  const std::string key(GetKey(url.host()));
-  FindCookiesForKey(key, url, options, current_time,
-                    update_access_time, cookies);
-}
-
 void CookieMonster::FindCookiesForKey(const std::string& key,
                                       const GURL& url,
                                       const CookieOptions& options,
                                       const Time& current,
                                       bool update_access_time,
                                       std::vector<CanonicalCookie*>* cookies) {
-  lock_.AssertAcquired();
+  CookieShard& shard = ShardForKey(key);
+  shard.lock.AssertAcquired();
 
-  for (CookieMapItPair its = cookies_.equal_range(key);
+  for (CookieMapItPair its = shard.cookies.equal_range(key);
        its.first != its.second; ) {
     CookieMap::iterator curit = its.first;
     CanonicalCookie* cc = curit->second;
@@ -1737,11 +1814,12 @@ bool CookieMonster::DeleteAnyEquivalentCookie(const std::string& key,
                                               const CanonicalCookie& ecc,
                                               bool skip_httponly,
                                               bool already_expired) {
-  lock_.AssertAcquired();
+  CookieShard& shard = ShardForKey(key);
+  shard.lock.AssertAcquired();
 
   bool found_equivalent_cookie = false;
   bool skipped_httponly = false;
-  for (CookieMapItPair its = cookies_.equal_range(key);
+  for (CookieMapItPair its = shard.cookies.equal_range(key);
        its.first != its.second; ) {
     CookieMap::iterator curit = its.first;
     CanonicalCookie* cc = curit->second;
@@ -1768,13 +1846,14 @@ CookieMonster::CookieMap::iterator CookieMonster::InternalInsertCookie(
     const std::string& key,
     CanonicalCookie* cc,
     bool sync_to_store) {
-  lock_.AssertAcquired();
+  CookieShard& shard = ShardForKey(key);
+  shard.lock.AssertAcquired();
 
   if ((cc->IsPersistent() || persist_session_cookies_) && store_.get() &&
       sync_to_store)
     store_->AddCookie(*cc);
   CookieMap::iterator inserted =
-      cookies_.insert(CookieMap::value_type(key, cc));
+      shard.cookies.insert(CookieMap::value_type(key, cc));
   if (delegate_.get()) {
     delegate_->OnCookieChanged(
         *cc, false, CookieMonsterDelegate::CHANGE_COOKIE_EXPLICIT);
@@ -1788,12 +1867,11 @@ bool CookieMonster::SetCookieWithCreationTimeAndOptions(
     const std::string& cookie_line,
     const Time& creation_time_or_null,
     const CookieOptions& options) {
-  lock_.AssertAcquired();
-
   VLOG(kVlogSetCookies) << "SetCookie() line: " << cookie_line;
 
   Time creation_time = creation_time_or_null;
   if (creation_time.is_null()) {
+    base::AutoLock autolock(lock_);
     creation_time = CurrentTime();
     last_time_seen_ = creation_time;
   }
@@ -1813,42 +1891,52 @@ bool CookieMonster::SetCanonicalCookie(scoped_ptr<CanonicalCookie>* cc,
                                        const CookieOptions& options) {
   const std::string key(GetKey((*cc)->Domain()));
   bool already_expired = (*cc)->IsExpired(creation_time);
-  if (DeleteAnyEquivalentCookie(key, **cc, options.exclude_httponly(),
-                                already_expired)) {
-    VLOG(kVlogSetCookies) << "SetCookie() not clobbering httponly cookie";
-    return false;
-  }
+  {
+    CookieShard& shard = ShardForKey(key);
+    base::AutoLock shard_lock(shard.lock);
 
-  VLOG(kVlogSetCookies) << "SetCookie() key: " << key << " cc: "
-                        << (*cc)->DebugString();
+    if (DeleteAnyEquivalentCookie(key, **cc, options.exclude_httponly(),
+                                  already_expired)) {
+      VLOG(kVlogSetCookies) << "SetCookie() not clobbering httponly cookie";
+      return false;
+    }
+
+    VLOG(kVlogSetCookies) << "SetCookie() key: " << key << " cc: "
+                          << (*cc)->DebugString();
 
-  // Realize that we might be setting an expired cookie, and the only point
-  // was to delete the cookie which we've already done.
-  if (!already_expired || keep_expired_cookies_) {
-    // See InitializeHistograms() for details.
-    if ((*cc)->IsPersistent()) {
-      histogram_expiration_duration_minutes_->Add(
-          ((*cc)->ExpiryDate() - creation_time).InMinutes());
+    // Realize that we might be setting an expired cookie, and the only point
+    // was to delete the cookie which we've already done.
+    if (!already_expired || keep_expired_cookies_) {
+      // See InitializeHistograms() for details.
+      if ((*cc)->IsPersistent()) {
+        histogram_expiration_duration_minutes_->Add(
+            ((*cc)->ExpiryDate() - creation_time).InMinutes());
+      }
+
+      InternalInsertCookie(key, cc->release(), true);
+    } else {
+      VLOG(kVlogSetCookies)
+          << "SetCookie() not storing already expired cookie.";
     }
 
-    InternalInsertCookie(key, cc->release(), true);
-  } else {
-    VLOG(kVlogSetCookies) << "SetCookie() not storing already expired cookie.";
+    // We assume that hopefully setting a cookie will be less common than
+    // querying a cookie.  Since setting a cookie can put us over our limits,
+    // make sure that we garbage collect...  We can also make the assumption
+    // that if a cookie was set, in the common case it will be used soon after,
+    // and we will purge the expired cookies in GetCookies().
+    GarbageCollect(creation_time, key);
   }
 
-  // We assume that hopefully setting a cookie will be less common than
-  // querying a cookie.  Since setting a cookie can put us over our limits,
-  // make sure that we garbage collect...  We can also make the assumption that
-  // if a cookie was set, in the common case it will be used soon after,
-  // and we will purge the expired cookies in GetCookies().
-  GarbageCollect(creation_time, key);
+  // The global pass acquires all shard locks itself, so it must run after the
+  // shard lock above has been released.
+  GarbageCollectGlobal(creation_time);
 
   return true;
 }
 
 void CookieMonster::InternalUpdateCookieAccessTime(CanonicalCookie* cc,
                                                    const Time& current) {
-  lock_.AssertAcquired();
+  // The caller holds the lock of the shard that owns |cc|.
 
   // Based off the Mozilla code.  When a cookie has been accessed recently,
   // don't bother updating its access time again.  This reduces the number of
@@ -1871,7 +1959,8 @@ void CookieMonster::InternalUpdateCookieAccessTime(CanonicalCookie* cc,
 void CookieMonster::InternalDeleteCookie(CookieMap::iterator it,
                                          bool sync_to_store,
                                          DeletionCause deletion_cause) {
-  lock_.AssertAcquired();
+  CookieShard& shard = ShardForKey(it->first);
+  shard.lock.AssertAcquired();
 
   // Ideally, this would be asserted up where we define ChangeCauseMapping,
   // but DeletionCause's visibility (or lack thereof) forces us to make
@@ -1895,7 +1984,7 @@ void CookieMonster::InternalDeleteCookie(CookieMap::iterator it,
     if (mapping.notify)
       delegate_->OnCookieChanged(*cc, true, mapping.cause);
   }
-  cookies_.erase(it);
+  shard.cookies.erase(it);
   delete cc;
 }
 
@@ -1903,19 +1992,20 @@ void CookieMonster::InternalDeleteCookie(CookieMap::iterator it,
 // meaning of the key is different, but that's not visible to this routine).
 int CookieMonster::GarbageCollect(const Time& current,
                                   const std::string& key) {
-  lock_.AssertAcquired();
+  CookieShard& shard = ShardForKey(key);
+  shard.lock.AssertAcquired();
 
   int num_deleted = 0;
   Time safe_date(
       Time::Now() - TimeDelta::FromDays(kSafeFromGlobalPurgeDays));
 
   // Collect garbage for this key, minding cookie priorities.
-  if (cookies_.count(key) > kDomainMaxCookies) {
+  if (shard.cookies.count(key) > kDomainMaxCookies) {
     VLOG(kVlogGarbageCollection) << "GarbageCollect() key: " << key;
 
     CookieItVector cookie_its;
     num_deleted += GarbageCollectExpired(
-        current, cookies_.equal_range(key), &cookie_its);
+        current, shard.cookies.equal_range(key), &cookie_its);
     if (cookie_its.size() > kDomainMaxCookies) {
       VLOG(kVlogGarbageCollection) << "Deep Garbage Collect domain.";
       size_t purge_goal =
@@ -1982,15 +2072,39 @@ int CookieMonster::GarbageCollect(const Time& current,
     }
   }
 
+  return num_deleted;
+}
+
+int CookieMonster::GarbageCollectGlobal(const Time& current) {
+  int num_deleted = 0;
+  Time safe_date(
+      Time::Now() - TimeDelta::FromDays(kSafeFromGlobalPurgeDays));
+
+  Time earliest_access_time;
+  {
+    base::AutoLock autolock(lock_);
+    earliest_access_time = earliest_access_time_;
+  }
+
+  AutoLockAllShards all_shards(this);
+
+  size_t num_cookies = 0;
+  for (size_t i = 0; i < kNumCookieShards; ++i)
+    num_cookies += shards_[i].cookies.size();
+
   // Collect garbage for everything. With firefox style we want to preserve
   // cookies accessed in kSafeFromGlobalPurgeDays, otherwise evict.
-  if (cookies_.size() > kMaxCookies &&
-      earliest_access_time_ < safe_date) {
+  if (num_cookies > kMaxCookies &&
+      earliest_access_time < safe_date) {
     VLOG(kVlogGarbageCollection) << "GarbageCollect() everything";
     CookieItVector cookie_its;
-    num_deleted += GarbageCollectExpired(
-        current, CookieMapItPair(cookies_.begin(), cookies_.end()),
-        &cookie_its);
+    for (size_t i = 0; i < kNumCookieShards; ++i) {
+      num_deleted += GarbageCollectExpired(
+          current,
+          CookieMapItPair(shards_[i].cookies.begin(),
+                          shards_[i].cookies.end()),
+          &cookie_its);
+    }
     if (cookie_its.size() > kMaxCookies) {
       VLOG(kVlogGarbageCollection) << "Deep Garbage Collect everything.";
       size_t purge_goal = cookie_its.size() - (kMaxCookies - kPurgeCookies);
@@ -2012,6 +2126,7 @@ int CookieMonster::GarbageCollect(const Time& current,
           cookie_its.begin(),
           global_purge_it);
       // Set access day to the oldest cookie that wasn't deleted.
+      base::AutoLock autolock(lock_);
       earliest_access_time_ = (*global_purge_it)->second->LastAccessDate();
     }
   }
@@ -2026,7 +2141,7 @@ int CookieMonster::GarbageCollectExpired(
   if (keep_expired_cookies_)
     return 0;
 
-  lock_.AssertAcquired();
+  // The caller holds the locks of the shards covered by |itpair|.
 
   int num_deleted = 0;
   for (CookieMap::iterator it = itpair.first, end = itpair.second; it != end;) {
@@ -2059,7 +2174,7 @@ int CookieMonster::GarbageCollectDeleteRange(
 
 // A wrapper around registry_controlled_domains::GetDomainAndRegistry
 // to make clear we're creating a key for our local map.  Here and
-// in FindCookiesForHostAndDomain() are the only two places where
+// in FindCookiesForKey() are the only two places where
 // we need to conditionalize based on key type.
 //
 // Note that this key algorithm explicitly ignores the scheme.  This is
@@ -2129,47 +2244,58 @@ void CookieMonster::RecordPeriodicStats(const base::Time& current_time) {
   const base::TimeDelta kRecordStatisticsIntervalTime(
       base::TimeDelta::FromSeconds(kRecordStatisticsIntervalSeconds));
 
-  // If we've taken statistics recently, return.
-  if (current_time - last_statistic_record_time_ <=
-      kRecordStatisticsIntervalTime) {
-    return;
+  {
+    base::AutoLock autolock(lock_);
+    // If we've taken statistics recently, return.
+    if (current_time - last_statistic_record_time_ <=
+        kRecordStatisticsIntervalTime) {
+      return;
+    }
+    last_statistic_record_time_ = current_time;
   }
 
+  AutoLockAllShards all_shards(this);
+
+  size_t num_cookies = 0;
+  for (size_t i = 0; i < kNumCookieShards; ++i)
+    num_cookies += shards_[i].cookies.size();
+
   // See InitializeHistograms() for details.
-  histogram_count_->Add(cookies_.size());
+  histogram_count_->Add(num_cookies);
 
   // More detailed statistics on cookie counts at different granularities.
   TimeTicks beginning_of_time(TimeTicks::Now());
 
-  for (CookieMap::const_iterator it_key = cookies_.begin();
-       it_key != cookies_.end(); ) {
-    const std::string& key(it_key->first);
-
-    int key_count = 0;
-    typedef std::map<std::string, unsigned int> DomainMap;
-    DomainMap domain_map;
-    CookieMapItPair its_cookies = cookies_.equal_range(key);
-    while (its_cookies.first != its_cookies.second) {
-      key_count++;
-      const std::string& cookie_domain(its_cookies.first->second->Domain());
-      domain_map[cookie_domain]++;
+  for (size_t i = 0; i < kNumCookieShards; ++i) {
+    CookieMap& cookies = shards_[i].cookies;
+    for (CookieMap::const_iterator it_key = cookies.begin();
+         it_key != cookies.end(); ) {
+      const std::string& key(it_key->first);
+
+      int key_count = 0;
+      typedef std::map<std::string, unsigned int> DomainMap;
+      DomainMap domain_map;
+      CookieMapItPair its_cookies = cookies.equal_range(key);
+      while (its_cookies.first != its_cookies.second) {
+        key_count++;
+        const std::string& cookie_domain(its_cookies.first->second->Domain());
+        domain_map[cookie_domain]++;
+
+        its_cookies.first++;
+      }
+      histogram_etldp1_count_->Add(key_count);
+      histogram_domain_per_etldp1_count_->Add(domain_map.size());
+      for (DomainMap::const_iterator domain_map_it = domain_map.begin();
+           domain_map_it != domain_map.end(); domain_map_it++)
+        histogram_domain_count_->Add(domain_map_it->second);
 
-      its_cookies.first++;
+      it_key = its_cookies.second;
     }
-    histogram_etldp1_count_->Add(key_count);
-    histogram_domain_per_etldp1_count_->Add(domain_map.size());
-    for (DomainMap::const_iterator domain_map_it = domain_map.begin();
-         domain_map_it != domain_map.end(); domain_map_it++)
-      histogram_domain_count_->Add(domain_map_it->second);
-
-    it_key = its_cookies.second;
   }
 
   VLOG(kVlogPeriodic)
       << "Time for recording cookie stats (us): "
       << (TimeTicks::Now() - beginning_of_time).InMicroseconds();
-
-  last_statistic_record_time_ = current_time;
 }
 
 // Initialize all histogram counter variables used in this class.
@@ -2257,13 +2383,18 @@ bool CookieMonster::CopyCookiesForKeyToOtherCookieMonster(
     CookieMonster* other) {
   ScopedVector<CanonicalCookie> duplicated_cookies;
 
+  DCHECK(other);
   {
     base::AutoLock autolock(lock_);
-    DCHECK(other);
     if (!loaded_)
       return false;
+  }
 
-    for (CookieMapItPair its = cookies_.equal_range(key);
+  {
+    CookieShard& shard = ShardForKey(key);
+    base::AutoLock shard_lock(shard.lock);
+
+    for (CookieMapItPair its = shard.cookies.equal_range(key);
          its.first != its.second;
          ++its.first) {
       CookieMap::iterator curit = its.first;
@@ -2277,9 +2408,14 @@ bool CookieMonster::CopyCookiesForKeyToOtherCookieMonster(
     base::AutoLock autolock(other->lock_);
     if (!other->loaded_)
       return false;
+  }
+
+  {
+    CookieShard& other_shard = other->ShardForKey(key);
+    base::AutoLock other_shard_lock(other_shard.lock);
 
     // There must not exist any entries for the key to be copied in |other|.
-    CookieMapItPair its = other->cookies_.equal_range(key);
+    CookieMapItPair its = other_shard.cookies.equal_range(key);
     if (its.first != its.second)
       return false;
 
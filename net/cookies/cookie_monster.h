@@ -314,7 +314,7 @@ class NET_EXPORT CookieMonster : public CookieStore {
   bool CopyCookiesForKeyToOtherCookieMonster(std::string key,
                                              CookieMonster* other);
 
-  // Find the key (for lookup in cookies_) based on the given domain.
+  // Find the key (for shard and map lookup) based on the given domain.
   // See comment on keys before the CookieMap typedef.
   std::string GetKey(const std::string& domain) const;
 
@@ -361,6 +361,38 @@ class NET_EXPORT CookieMonster : public CookieStore {
   // For FindCookiesForKey.
   FRIEND_TEST_ALL_PREFIXES(CookieMonsterTest, ShortLivedSessionCookies);
 
+  // Number of independent shards the cookie map is split into. Every eTLD+1
+  // key maps to exactly one shard, so cookie operations on unrelated domains
+  // never contend on a lock. Must be a power of two.
+  static const size_t kNumCookieShards = 16;
+
+  // One shard of the cookie store: a slice of the multimap plus the lock
+  // that guards it.
+  struct CookieShard {
+    CookieShard();
+    ~CookieShard();
+
+    base::Lock lock;
+    CookieMap cookies;
+
+   private:
+    DISALLOW_COPY_AND_ASSIGN(CookieShard);
+  };
+
+  // Scoper that acquires every shard lock, in index order, for operations
+  // that span domains (enumeration, bulk deletion, global garbage
+  // collection).
+  class AutoLockAllShards {
+   public:
+    explicit AutoLockAllShards(CookieMonster* monster);
+    ~AutoLockAllShards();
+
+   private:
+    CookieMonster* monster_;
+
+    DISALLOW_COPY_AND_ASSIGN(AutoLockAllShards);
+  };
+
   // Internal reasons for deletion, used to populate informative histograms
   // and to provide a public cause for onCookieChange notifications.
   //
@@ -503,24 +535,28 @@ class NET_EXPORT CookieMonster : public CookieStore {
   // Invokes deferred calls.
   void InvokeQueue();
 
-  // Checks that |cookies_| matches our invariants, and tries to repair any
-  // inconsistencies. (In other words, it does not have duplicate cookies).
+  // Returns the shard that stores cookies for |key| (an eTLD+1; see
+  // GetKey()).
+  CookieShard& ShardForKey(const std::string& key);
+
+  // Checks that the cookie shards match our invariants, and tries to repair
+  // any inconsistencies. (In other words, they have no duplicate cookies).
+  // Acquires all shard locks.
   void EnsureCookiesMapIsValid();
 
   // Checks for any duplicate cookies for CookieMap key |key| which lie between
   // |begin| and |end|. If any are found, all but the most recent are deleted.
   // Returns the number of duplicate cookies that were deleted.
+  // The caller must hold the lock of the shard owning |key|.
   int TrimDuplicateCookiesForKey(const std::string& key,
                                  CookieMap::iterator begin,
                                  CookieMap::iterator end);
 
   void SetDefaultCookieableSchemes();
 
-  void FindCookiesForHostAndDomain(const GURL& url,
-                                   const CookieOptions& options,
-                                   bool update_access_time,
-                                   std::vector<CanonicalCookie*>* cookies);
-
+  // Finds cookies under |key| matching |url| and |options|. The caller must
+  // hold the lock of the shard owning |key|, and may only use the returned
+  // pointers while it does.
   void FindCookiesForKey(const std::string& key,
                          const GURL& url,
                          const CookieOptions& options,
@@ -531,8 +567,9 @@ class NET_EXPORT CookieMonster : public CookieStore {
   // Delete any cookies that are equivalent to |ecc| (same path, domain, etc).
   // If |skip_httponly| is true, httponly cookies will not be deleted.  The
   // return value with be true if |skip_httponly| skipped an httponly cookie.
-  // |key| is the key to find the cookie in cookies_; see the comment before
-  // the CookieMap typedef for details.
+  // |key| is the key to find the cookie under; see the comment before
+  // the CookieMap typedef for details. The caller must hold the lock of the
+  // shard owning |key|.
   // NOTE: There should never be more than a single matching equivalent cookie.
   bool DeleteAnyEquivalentCookie(const std::string& key,
                                  const CanonicalCookie& ecc,
@@ -540,7 +577,8 @@ class NET_EXPORT CookieMonster : public CookieStore {
                                  bool already_expired);
 
   // Takes ownership of *cc. Returns an iterator that points to the inserted
-  // cookie in cookies_. Guarantee: all iterators to cookies_ remain valid.
+  // cookie in the shard owning |key|, whose lock the caller must hold.
+  // Guarantee: all existing iterators remain valid.
   CookieMap::iterator InternalInsertCookie(const std::string& key,
                                            CanonicalCookie* cc,
                                            bool sync_to_store);
@@ -564,19 +602,25 @@ class NET_EXPORT CookieMonster : public CookieStore {
 
   // |deletion_cause| argument is used for collecting statistics and choosing
   // the correct CookieMonsterDelegate::ChangeCause for OnCookieChanged
-  // notifications.  Guarantee: All iterators to cookies_ except to the
-  // deleted entry remain vaild.
+  // notifications.  The caller must hold the lock of the shard owning
+  // |it->first|.  Guarantee: All iterators except to the deleted entry
+  // remain vaild.
   void InternalDeleteCookie(CookieMap::iterator it, bool sync_to_store,
                             DeletionCause deletion_cause);
 
-  // If the number of cookies for CookieMap key |key|, or globally, are
-  // over the preset maximums above, garbage collect, first for the host and
-  // then globally.  See comments above garbage collection threshold
-  // constants for details.
+  // If the number of cookies for CookieMap key |key| is over the preset
+  // maximum above, garbage collect for the host.  The caller must hold the
+  // lock of the shard owning |key|.  See comments above garbage collection
+  // threshold constants for details.
   //
   // Returns the number of cookies deleted (useful for debugging).
   int GarbageCollect(const base::Time& current, const std::string& key);
 
+  // If the total number of cookies across all shards is over kMaxCookies,
+  // garbage collect globally.  Acquires all shard locks; the caller must
+  // hold no shard lock.
+  int GarbageCollectGlobal(const base::Time& current);
+
   // Helper for GarbageCollect(); can be called directly as well.  Deletes
   // all expired cookies in |itpair|.  If |cookie_its| is non-NULL, it is
   // populated with all the non-expired cookies from |itpair|.
@@ -633,7 +677,9 @@ class NET_EXPORT CookieMonster : public CookieStore {
   base::HistogramBase* histogram_time_mac_;
   base::HistogramBase* histogram_time_blocked_on_load_;
 
-  CookieMap cookies_;
+  // The cookie store proper, split into independently locked shards; see
+  // ShardForKey().
+  CookieShard shards_[kNumCookieShards];
 
   // Indicates whether the cookie store has been initialized. This happens
   // lazily in InitStoreIfNecessary().
@@ -664,8 +710,8 @@ class NET_EXPORT CookieMonster : public CookieStore {
   // update it again.
   const base::TimeDelta last_access_threshold_;
 
-  // Approximate date of access time of least recently accessed cookie
-  // in |cookies_|.  Note that this is not guaranteed to be accurate, only a)
+  // Approximate date of access time of the least recently accessed cookie
+  // in the store.  Note that this is not guaranteed to be accurate, only a)
   // to be before or equal to the actual time, and b) to be accurate
   // immediately after a garbage collection that scans through all the cookies.
   // This value is used to determine whether global garbage collection might
@@ -685,7 +731,11 @@ class NET_EXPORT CookieMonster : public CookieStore {
 
   scoped_refptr<CookieMonsterDelegate> delegate_;
 
-  // Lock for thread-safety
+  // Lock for initialization/load bookkeeping and time state. The cookie
+  // maps themselves are guarded by the per-shard locks. Lock ordering:
+  // shard locks may be held while acquiring |lock_|, never the reverse;
+  // multiple shard locks are only acquired together, in index order, via
+  // AutoLockAllShards.
   base::Lock lock_;
 
   base::Time last_statistic_record_time_;
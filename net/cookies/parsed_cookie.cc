@@ -45,6 +45,7 @@
 #include "net/cookies/parsed_cookie.h"
 
 #include "base/logging.h"
+#include "base/strings/string_piece.h"
 #include "base/strings/string_util.h"
 
 namespace {
@@ -93,18 +94,18 @@ inline bool SeekBackPast(std::string::const_iterator* it,
 
 // Validate whether |value| is a valid token according to [RFC2616],
 // Section 2.2.
-bool IsValidToken(const std::string& value) {
+bool IsValidToken(const base::StringPiece& value) {
   if (value.empty())
     return false;
 
   // Check that |value| has no separators.
-  std::string separators = "()<>@,;:\\\"/[]?={} \t";
-  if (value.find_first_of(separators) != std::string::npos)
+  static const char kSeparators[] = "()<>@,;:\\\"/[]?={} \t";
+  if (value.find_first_of(kSeparators) != base::StringPiece::npos)
     return false;
 
   // Check that |value| has no CTLs.
-  for (std::string::const_iterator i = value.begin(); i != value.end(); ++i) {
-    if ((*i >= 0 && *i <= 31) || *i >= 127)
+  for (size_t i = 0; i < value.size(); ++i) {
+    if ((value[i] >= 0 && value[i] <= 31) || value[i] >= 127)
       return false;
   }
 
@@ -140,11 +141,11 @@ bool IsControlCharacter(unsigned char c) {
     return (c >= 0) && (c <= 31);
 }
 
-bool IsValidCookieAttributeValue(const std::string& value) {
+bool IsValidCookieAttributeValue(const base::StringPiece& value) {
   // The greatest common denominator of cookie attribute values is
   // <any CHAR except CTLs or ";"> according to RFC 6265.
-  for (std::string::const_iterator i = value.begin(); i != value.end(); ++i) {
-    if (IsControlCharacter(*i) || *i == ';')
+  for (size_t i = 0; i < value.size(); ++i) {
+    if (IsControlCharacter(value[i]) || value[i] == ';')
       return false;
   }
   return true;
@@ -249,8 +250,7 @@ std::string ParsedCookie::ToCookieLine() const {
 std::string::const_iterator ParsedCookie::FindFirstTerminator(
     const std::string& s) {
   std::string::const_iterator end = s.end();
-  size_t term_pos =
-      s.find_first_of(std::string(kTerminator, kTerminatorLen));
+  size_t term_pos = s.find_first_of(kTerminator, 0, kTerminatorLen);
   if (term_pos != std::string::npos) {
     // We found a character we should treat as an end of string.
     end = s.begin() + term_pos;
@@ -24,6 +24,7 @@
 #include "net/disk_cache/disk_cache_test_base.h"
 #include "net/disk_cache/disk_cache_test_util.h"
 #include "net/disk_cache/memory/mem_backend_impl.h"
+#include "net/disk_cache/memory/sharded_mem_backend_impl.h"
 #include "net/disk_cache/simple/simple_backend_impl.h"
 #include "net/disk_cache/simple/simple_entry_format.h"
 #include "net/disk_cache/simple/simple_test_util.h"
@@ -3507,3 +3508,118 @@ TEST_F(DiskCacheBackendTest, SimpleCacheEnumerationCorruption) {
 }
 
 #endif  // defined(OS_POSIX)
+
+// Tests basic operation of the sharded in-memory backend: entries land in
+// the shard owning their key and all Backend operations span the shards.
+TEST_F(DiskCacheTest, ShardedMemoryBackendBasics) {
+  scoped_ptr<disk_cache::Backend> cache(
+      disk_cache::ShardedMemBackendImpl::CreateBackend(16 * 1024 * 1024, 4,
+                                                       NULL));
+  ASSERT_TRUE(cache.get());
+  EXPECT_EQ(net::MEMORY_CACHE, cache->GetCacheType());
+  EXPECT_EQ(0, cache->GetEntryCount());
+
+  const int kNumEntries = 100;
+  std::set<std::string> keys;
+  for (int i = 0; i < kNumEntries; i++) {
+    std::string key = GenerateKey(true);
+    keys.insert(key);
+    disk_cache::Entry* entry;
+    net::TestCompletionCallback cb;
+    int rv = cache->CreateEntry(key, &entry, cb.callback());
+    ASSERT_EQ(net::OK, cb.GetResult(rv));
+    entry->Close();
+  }
+  EXPECT_EQ(kNumEntries, cache->GetEntryCount());
+
+  // Every key must be found again, and a second create must fail.
+  for (std::set<std::string>::iterator it = keys.begin(); it != keys.end();
+       ++it) {
+    disk_cache::Entry* entry;
+    net::TestCompletionCallback cb;
+    int rv = cache->OpenEntry(*it, &entry, cb.callback());
+    ASSERT_EQ(net::OK, cb.GetResult(rv));
+    entry->Close();
+
+    net::TestCompletionCallback cb2;
+    rv = cache->CreateEntry(*it, &entry, cb2.callback());
+    EXPECT_NE(net::OK, cb2.GetResult(rv));
+  }
+
+  // Enumeration visits each entry exactly once across all shards.
+  std::set<std::string> keys_to_match(keys);
+  void* iter = NULL;
+  disk_cache::Entry* entry;
+  net::TestCompletionCallback cb;
+  while (cache->OpenNextEntry(&iter, &entry, cb.callback()) == net::OK) {
+    EXPECT_EQ(1u, keys_to_match.erase(entry->GetKey()));
+    entry->Close();
+  }
+  cache->EndEnumeration(&iter);
+  EXPECT_TRUE(keys_to_match.empty());
+
+  // Dooming a key removes it from its shard only.
+  std::string doomed_key = *keys.begin();
+  net::TestCompletionCallback doom_cb;
+  int rv = cache->DoomEntry(doomed_key, doom_cb.callback());
+  EXPECT_EQ(net::OK, doom_cb.GetResult(rv));
+  EXPECT_EQ(kNumEntries - 1, cache->GetEntryCount());
+
+  net::TestCompletionCallback doom_all_cb;
+  rv = cache->DoomAllEntries(doom_all_cb.callback());
+  EXPECT_EQ(net::OK, doom_all_cb.GetResult(rv));
+  EXPECT_EQ(0, cache->GetEntryCount());
+}
+
+// Tests that the sharded backend evicts entries once a shard exceeds its
+// slice of the budget, and that recently hit entries survive eviction.
+TEST_F(DiskCacheTest, ShardedMemoryBackendEviction) {
+  const int kMaxSize = 1024 * 1024;
+  scoped_ptr<disk_cache::Backend> cache(
+      disk_cache::ShardedMemBackendImpl::CreateBackend(kMaxSize, 4, NULL));
+  ASSERT_TRUE(cache.get());
+
+  const int kDataSize = 16 * 1024;
+  scoped_refptr<net::IOBuffer> buffer(new net::IOBuffer(kDataSize));
+  CacheTestFillBuffer(buffer->data(), kDataSize, false);
+
+  // The first entry is touched after every insertion, so the second-chance
+  // scan must keep recycling it while strictly older entries get evicted.
+  std::string hot_key = GenerateKey(true);
+  disk_cache::Entry* entry;
+  net::TestCompletionCallback cb;
+  int rv = cache->CreateEntry(hot_key, &entry, cb.callback());
+  ASSERT_EQ(net::OK, cb.GetResult(rv));
+  EXPECT_EQ(kDataSize, entry->WriteData(0, 0, buffer.get(), kDataSize,
+                                        net::CompletionCallback(), false));
+  entry->Close();
+
+  // Write several times the total budget.
+  for (int i = 0; i < 4 * kMaxSize / kDataSize; i++) {
+    std::string key = GenerateKey(true);
+    net::TestCompletionCallback create_cb;
+    rv = cache->CreateEntry(key, &entry, create_cb.callback());
+    ASSERT_EQ(net::OK, create_cb.GetResult(rv));
+    EXPECT_EQ(kDataSize, entry->WriteData(0, 0, buffer.get(), kDataSize,
+                                          net::CompletionCallback(), false));
+    entry->Close();
+
+    net::TestCompletionCallback open_cb;
+    rv = cache->OpenEntry(hot_key, &entry, open_cb.callback());
+    ASSERT_EQ(net::OK, open_cb.GetResult(rv));
+    // Reading is what marks the entry as referenced.
+    EXPECT_EQ(kDataSize, entry->ReadData(0, 0, buffer.get(), kDataSize,
+                                         net::CompletionCallback()));
+    entry->Close();
+  }
+
+  // Far fewer entries than were written must remain resident, and the
+  // frequently read entry must be among the survivors.
+  EXPECT_LT(cache->GetEntryCount(), 4 * kMaxSize / kDataSize);
+  EXPECT_GT(cache->GetEntryCount(), 0);
+
+  net::TestCompletionCallback final_cb;
+  rv = cache->OpenEntry(hot_key, &entry, final_cb.callback());
+  ASSERT_EQ(net::OK, final_cb.GetResult(rv));
+  entry->Close();
+}
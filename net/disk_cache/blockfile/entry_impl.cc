@@ -1205,12 +1205,11 @@ void EntryImpl::DeleteData(Addr address, int index) {
   if (!address.is_initialized())
     return;
   if (address.is_separate_file()) {
-    int failure = !DeleteCacheFile(backend_->GetFileName(address));
-    CACHE_UMA(COUNTS, "DeleteFailed", 0, failure);
-    if (failure) {
-      LOG(ERROR) << "Failed to delete " <<
-          backend_->GetFileName(address).value() << " from the cache.";
-    }
+    // Unlinking the file can block for a long time on some filesystems, so do
+    // it on a worker thread and let the eviction sweep continue in parallel.
+    // External file numbers are never reused, so the deferred deletion cannot
+    // race with a new file created at this address.
+    DeleteCacheFileInBackground(backend_->GetFileName(address));
     if (files_[index].get())
       files_[index] = NULL;  // Releases the object.
   } else {
@@ -4,6 +4,8 @@
 
 #include "net/disk_cache/blockfile/file.h"
 
+#include "net/base/net_errors.h"
+
 namespace disk_cache {
 
 // Cross platform constructors. Platform specific code is in
@@ -13,4 +15,16 @@ File::File() : init_(false), mixed_(false) {}
 
 File::File(bool mixed_mode) : init_(false), mixed_(mixed_mode) {}
 
+// Runs on a worker thread when posted by the asynchronous ReadBatch() path,
+// and on the caller's thread otherwise.
+int File::DoReadBatch(const std::vector<ReadRequest>& requests) {
+  int total = 0;
+  for (size_t i = 0; i < requests.size(); ++i) {
+    if (!Read(requests[i].buffer, requests[i].buffer_len, requests[i].offset))
+      return net::ERR_CACHE_READ_FAILURE;
+    total += static_cast<int>(requests[i].buffer_len);
+  }
+  return total;
+}
+
 }  // namespace disk_cache
@@ -7,6 +7,8 @@
 #ifndef NET_DISK_CACHE_BLOCKFILE_FILE_H_
 #define NET_DISK_CACHE_BLOCKFILE_FILE_H_
 
+#include <vector>
+
 #include "base/files/file.h"
 #include "base/memory/ref_counted.h"
 #include "net/base/net_export.h"
@@ -59,6 +61,23 @@ class NET_EXPORT_PRIVATE File : public base::RefCounted<File> {
   bool Write(const void* buffer, size_t buffer_len, size_t offset,
              FileIOCallback* callback, bool* completed);
 
+  // One range of a scatter-gather read: |buffer_len| bytes at file |offset|,
+  // read into |buffer|.
+  struct ReadRequest {
+    void* buffer;
+    size_t buffer_len;
+    size_t offset;
+  };
+
+  // Reads every range in |requests|, invoking |callback| once with the total
+  // number of bytes read, or with a net error if any range fails. Where
+  // asynchronous operations run on a worker pool this issues a single pool
+  // task for the whole batch instead of one per range. Like Read(), the
+  // operation may complete synchronously, in which case |completed| is set
+  // to true and |callback| is not invoked.
+  bool ReadBatch(const std::vector<ReadRequest>& requests,
+                 FileIOCallback* callback, bool* completed);
+
   // Sets the file's length. The file is truncated or extended with zeros to
   // the new length.
   bool SetLength(size_t length);
@@ -85,6 +104,7 @@ class NET_EXPORT_PRIVATE File : public base::RefCounted<File> {
   // Infrastructure for async IO.
   int DoRead(void* buffer, size_t buffer_len, size_t offset);
   int DoWrite(const void* buffer, size_t buffer_len, size_t offset);
+  int DoReadBatch(const std::vector<ReadRequest>& requests);
   void OnOperationComplete(FileIOCallback* callback, int result);
 
   bool init_;
@@ -242,6 +242,16 @@ bool File::Write(const void* buffer, size_t buffer_len, size_t offset,
   return AsyncWrite(buffer, buffer_len, offset, callback, completed);
 }
 
+bool File::ReadBatch(const std::vector<ReadRequest>& requests,
+                     FileIOCallback* callback, bool* completed) {
+  DCHECK(base_file_.IsValid());
+  // There is no worker-pool task to batch onto here; run the batch
+  // synchronously and report synchronous completion.
+  if (completed)
+    *completed = true;
+  return DoReadBatch(requests) >= 0;
+}
+
 bool File::SetLength(size_t length) {
   DCHECK(base_file_.IsValid());
   if (length > kuint32max)
@@ -91,6 +91,10 @@ bool File::Read(void* buffer, size_t buffer_len, size_t offset,
     return false;
   }
 
+  // Queue the kernel readahead now, so that the data may already be in the
+  // page cache by the time the worker pool gets to the pread.
+  base_file_.Prefetch(offset, buffer_len);
+
   base::PostTaskAndReplyWithResult(
       s_worker_pool.Pointer(), FROM_HERE,
       base::Bind(&File::DoRead, this, buffer, buffer_len, offset),
@@ -123,6 +127,27 @@ bool File::Write(const void* buffer, size_t buffer_len, size_t offset,
   return true;
 }
 
+bool File::ReadBatch(const std::vector<ReadRequest>& requests,
+                     FileIOCallback* callback, bool* completed) {
+  DCHECK(base_file_.IsValid());
+  if (!callback) {
+    if (completed)
+      *completed = true;
+    return DoReadBatch(requests) >= 0;
+  }
+
+  for (size_t i = 0; i < requests.size(); ++i)
+    base_file_.Prefetch(requests[i].offset, requests[i].buffer_len);
+
+  base::PostTaskAndReplyWithResult(
+      s_worker_pool.Pointer(), FROM_HERE,
+      base::Bind(&File::DoReadBatch, this, requests),
+      base::Bind(&File::OnOperationComplete, this, callback));
+
+  *completed = false;
+  return true;
+}
+
 bool File::SetLength(size_t length) {
   DCHECK(base_file_.IsValid());
   if (length > kuint32max)
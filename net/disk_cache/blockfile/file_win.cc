@@ -215,6 +215,17 @@ bool File::AsyncWrite(const void* buffer, size_t buffer_len, size_t offset,
   return *completed;
 }
 
+bool File::ReadBatch(const std::vector<ReadRequest>& requests,
+                     FileIOCallback* callback, bool* completed) {
+  DCHECK(init_);
+  // Asynchronous operations here are issued per range against the completion
+  // port, so there is no single task to batch onto; run the batch
+  // synchronously and report synchronous completion.
+  if (completed)
+    *completed = true;
+  return DoReadBatch(requests) >= 0;
+}
+
 bool File::SetLength(size_t length) {
   DCHECK(init_);
   if (length > ULONG_MAX)
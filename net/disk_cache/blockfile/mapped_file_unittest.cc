@@ -107,6 +107,46 @@ TEST_F(DiskCacheTest, MappedFile_AsyncIO) {
   EXPECT_STREQ(buffer1, buffer2);
 }
 
+TEST_F(DiskCacheTest, MappedFile_ReadBatch) {
+  base::FilePath filename = cache_path_.AppendASCII("a_test");
+  scoped_refptr<disk_cache::MappedFile> file(new disk_cache::MappedFile);
+  ASSERT_TRUE(CreateCacheTestFile(filename));
+  ASSERT_TRUE(file->Init(filename, 8192));
+
+  char buffer1[20];
+  char buffer2[20];
+  CacheTestFillBuffer(buffer1, sizeof(buffer1), false);
+  base::strlcpy(buffer1, "the data", arraysize(buffer1));
+  CacheTestFillBuffer(buffer2, sizeof(buffer2), false);
+  base::strlcpy(buffer2, "other data", arraysize(buffer2));
+  EXPECT_TRUE(file->Write(buffer1, sizeof(buffer1), 8192));
+  EXPECT_TRUE(file->Write(buffer2, sizeof(buffer2), 12288));
+
+  // Both ranges come back with a single batched operation.
+  char read1[20];
+  char read2[20];
+  std::vector<disk_cache::File::ReadRequest> requests(2);
+  requests[0].buffer = read1;
+  requests[0].buffer_len = sizeof(read1);
+  requests[0].offset = 8192;
+  requests[1].buffer = read2;
+  requests[1].buffer_len = sizeof(read2);
+  requests[1].offset = 12288;
+
+  int max_id = 0;
+  MessageLoopHelper helper;
+  FileCallbackTest callback(1, &helper, &max_id);
+  bool completed;
+  EXPECT_TRUE(file->ReadBatch(requests, &callback, &completed));
+  if (!completed) {
+    max_id = 1;
+    helper.WaitUntilCacheIoFinished(1);
+  }
+
+  EXPECT_STREQ(buffer1, read1);
+  EXPECT_STREQ(buffer2, read2);
+}
+
 TEST_F(DiskCacheTest, MappedFile_AsyncLoadStore) {
   base::FilePath filename = cache_path_.AppendASCII("a_test");
   scoped_refptr<disk_cache::MappedFile> file(new disk_cache::MappedFile);
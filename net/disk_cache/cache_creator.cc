@@ -10,6 +10,7 @@
 #include "net/disk_cache/blockfile/backend_impl.h"
 #include "net/disk_cache/cache_util.h"
 #include "net/disk_cache/disk_cache.h"
+#include "net/disk_cache/logstore/log_store_backend_impl.h"
 #include "net/disk_cache/memory/mem_backend_impl.h"
 #include "net/disk_cache/simple/simple_backend_impl.h"
 
@@ -95,6 +96,15 @@ int CacheCreator::Run() {
         base::Bind(&CacheCreator::OnIOComplete, base::Unretained(this)));
   }
 
+  if (backend_type_ == net::CACHE_BACKEND_LOG_STORE) {
+    disk_cache::LogStoreBackendImpl* log_store =
+        new disk_cache::LogStoreBackendImpl(path_, max_bytes_, type_,
+                                            thread_.get(), net_log_);
+    created_cache_.reset(log_store);
+    return log_store->Init(
+        base::Bind(&CacheCreator::OnIOComplete, base::Unretained(this)));
+  }
+
   // Avoid references to blockfile functions on Android to reduce binary size.
 #if defined(OS_ANDROID)
   return net::ERR_FAILED;
@@ -36,6 +36,12 @@ void CleanupCallback(const base::FilePath& path, const std::string& name) {
   }
 }
 
+// Deletes a single cache file from a worker thread.
+void DeleteCacheFileCallback(const base::FilePath& name) {
+  if (!disk_cache::DeleteCacheFile(name))
+    LOG(ERROR) << "Failed to delete " << name.value() << " from the cache.";
+}
+
 // Returns a full path to rename the current cache, in order to delete it. path
 // is the current folder location, and name is the current folder name.
 base::FilePath GetTempCacheName(const base::FilePath& path,
@@ -100,6 +106,11 @@ void DeleteCache(const base::FilePath& path, bool remove_folder) {
   }
 }
 
+void DeleteCacheFileInBackground(const base::FilePath& name) {
+  base::WorkerPool::PostTask(
+      FROM_HERE, base::Bind(&DeleteCacheFileCallback, name), true);
+}
+
 // In order to process a potentially large number of files, we'll rename the
 // cache directory to old_ + original_name + number, (located on the same parent
 // directory), and use a worker thread to delete all the files on all the stale
@@ -32,6 +32,11 @@ NET_EXPORT_PRIVATE void DeleteCache(const base::FilePath& path,
 // Deletes a cache file.
 NET_EXPORT_PRIVATE bool DeleteCacheFile(const base::FilePath& name);
 
+// Posts the deletion of a cache file to a worker thread, so that the cache
+// thread is not blocked by the operation. Failures are logged by the posted
+// task. Used when evicting entries backed by external files.
+NET_EXPORT_PRIVATE void DeleteCacheFileInBackground(const base::FilePath& name);
+
 // Renames cache directory synchronously and fires off a background cleanup
 // task. Used by cache creator itself or by backends for self-restart on error.
 bool DelayedCacheCleanup(const base::FilePath& full_path);
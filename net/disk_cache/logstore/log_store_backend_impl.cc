@@ -0,0 +1,594 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/disk_cache/logstore/log_store_backend_impl.h"
+
+#include <algorithm>
+#include <map>
+
+#include "base/bind.h"
+#include "base/file_util.h"
+#include "base/files/file.h"
+#include "base/location.h"
+#include "base/logging.h"
+#include "base/single_thread_task_runner.h"
+#include "net/base/net_errors.h"
+#include "net/disk_cache/logstore/log_store_entry_impl.h"
+#include "third_party/zlib/zlib.h"
+
+using base::Time;
+
+namespace {
+
+const char kLogFileName[] = "data-log";
+
+const int kDefaultLogStoreCacheSize = 20 * 1024 * 1024;
+const int kCleanUpMargin = 1024 * 1024;
+
+// The log is not compacted before it reaches this size, no matter how much of
+// it is dead, to avoid rewriting a tiny file over and over.
+const int64 kCompactionMinLogSize = 1024 * 1024;
+
+// Bounds used to reject obviously damaged record headers while scanning.
+const uint32 kMaxKeyLength = 64 * 1024;
+const int64 kMaxRecordPayloadSize = 64 * 1024 * 1024;
+
+int LowWaterAdjust(int high_water) {
+  if (high_water < kCleanUpMargin)
+    return 0;
+
+  return high_water - kCleanUpMargin;
+}
+
+// Appends |record| to the log. Runs on the cache thread. Failures are
+// ignored: the affected entries simply will not survive a restart.
+void AppendToLogBlocking(const base::FilePath& log_path,
+                         scoped_ptr<std::string> record) {
+  base::File file(log_path, base::File::FLAG_OPEN | base::File::FLAG_APPEND);
+  if (!file.IsValid())
+    return;
+  file.WriteAtCurrentPos(record->data(),
+                         static_cast<int>(record->size()));
+}
+
+// Replaces the log with |contents|, written to a temporary file first so a
+// crash mid-rewrite leaves the old log in place. Runs on the cache thread.
+void RewriteLogBlocking(const base::FilePath& log_path,
+                        scoped_ptr<std::string> contents) {
+  base::FilePath temp_path = log_path.AddExtension(FILE_PATH_LITERAL("new"));
+  {
+    base::File file(temp_path,
+                    base::File::FLAG_CREATE_ALWAYS | base::File::FLAG_WRITE);
+    if (!file.IsValid())
+      return;
+    const int size = static_cast<int>(contents->size());
+    if (file.WriteAtCurrentPos(contents->data(), size) != size)
+      return;
+  }
+  base::ReplaceFile(temp_path, log_path, NULL);
+}
+
+}  // namespace
+
+namespace disk_cache {
+
+LogStoreBackendImpl::LoadedEntry::LoadedEntry()
+    : last_used(0), last_modified(0) {}
+
+LogStoreBackendImpl::LoadedEntry::~LoadedEntry() {}
+
+LogStoreBackendImpl::LoadResult::LoadResult() : ok(false), log_size(0) {}
+
+LogStoreBackendImpl::LoadResult::~LoadResult() {}
+
+LogStoreBackendImpl::LogStoreBackendImpl(
+    const base::FilePath& path,
+    int max_bytes,
+    net::CacheType cache_type,
+    base::SingleThreadTaskRunner* cache_thread,
+    net::NetLog* net_log)
+    : path_(path),
+      cache_type_(cache_type),
+      cache_thread_(cache_thread),
+      rankings_head_(NULL),
+      rankings_tail_(NULL),
+      max_size_(max_bytes > 0 ? max_bytes : kDefaultLogStoreCacheSize),
+      current_size_(0),
+      log_size_(0),
+      initialized_(false),
+      net_log_(net_log),
+      ptr_factory_(this) {}
+
+LogStoreBackendImpl::~LogStoreBackendImpl() {
+  // Entries were appended to the log as they were closed, so dropping the
+  // in-memory state does not lose data. No tombstones are recorded here.
+  while (!entries_.empty())
+    EvictEntry(entries_.begin()->second);
+  DCHECK(!current_size_);
+}
+
+int LogStoreBackendImpl::Init(const CompletionCallback& completion_callback) {
+  DCHECK(!initialized_);
+  LoadResult* result = new LoadResult();
+  cache_thread_->PostTaskAndReply(
+      FROM_HERE,
+      base::Bind(&LogStoreBackendImpl::LoadLog, GetLogFilePath(), result),
+      base::Bind(&LogStoreBackendImpl::InitializeFromLoad,
+                 ptr_factory_.GetWeakPtr(),
+                 completion_callback,
+                 base::Owned(result)));
+  return net::ERR_IO_PENDING;
+}
+
+void LogStoreBackendImpl::InternalDoomEntry(LogStoreEntryImpl* entry) {
+  // A tombstone is only needed when the log still contains a record that
+  // would resurrect the key on the next startup.
+  if (entry->persisted()) {
+    LogStoreRecordHeader header;
+    header.record_magic_number = kLogStoreRecordMagicNumber;
+    header.flags = LogStoreRecordHeader::FLAG_TOMBSTONE;
+    const std::string key = entry->GetKey();
+    header.key_length = key.size();
+    header.data_crc32 = crc32(crc32(0L, Z_NULL, 0),
+                              reinterpret_cast<const Bytef*>(key.data()),
+                              key.size());
+    scoped_ptr<std::string> record(new std::string);
+    record->append(reinterpret_cast<const char*>(&header), sizeof(header));
+    record->append(key);
+    log_size_ += record->size();
+    PostAppend(record.Pass());
+  }
+
+  RemoveFromRankingList(entry);
+  EntryMap::iterator it = entries_.find(entry->GetKey());
+  if (it != entries_.end())
+    entries_.erase(it);
+  else
+    NOTREACHED();
+
+  entry->InternalDoom();
+  MaybeCompact();
+}
+
+void LogStoreBackendImpl::OnEntryModified(LogStoreEntryImpl* entry) {
+  scoped_ptr<std::string> record(new std::string);
+  entry->SerializeRecord(record.get());
+  log_size_ += record->size();
+  entry->set_persisted(true);
+  PostAppend(record.Pass());
+  MaybeCompact();
+}
+
+void LogStoreBackendImpl::UpdateRank(LogStoreEntryImpl* entry) {
+  RemoveFromRankingList(entry);
+  InsertIntoRankingList(entry);
+}
+
+void LogStoreBackendImpl::ModifyStorageSize(int32 old_size, int32 new_size) {
+  if (old_size >= new_size)
+    SubstractStorageSize(old_size - new_size);
+  else
+    AddStorageSize(new_size - old_size);
+}
+
+int LogStoreBackendImpl::MaxFileSize() const {
+  return max_size_ / 8;
+}
+
+net::CacheType LogStoreBackendImpl::GetCacheType() const {
+  return cache_type_;
+}
+
+int32 LogStoreBackendImpl::GetEntryCount() const {
+  return static_cast<int32>(entries_.size());
+}
+
+int LogStoreBackendImpl::OpenEntry(const std::string& key, Entry** entry,
+                                   const CompletionCallback& callback) {
+  if (OpenEntry(key, entry))
+    return net::OK;
+
+  return net::ERR_FAILED;
+}
+
+int LogStoreBackendImpl::CreateEntry(const std::string& key, Entry** entry,
+                                     const CompletionCallback& callback) {
+  if (CreateEntry(key, entry))
+    return net::OK;
+
+  return net::ERR_FAILED;
+}
+
+int LogStoreBackendImpl::DoomEntry(const std::string& key,
+                                   const CompletionCallback& callback) {
+  if (DoomEntry(key))
+    return net::OK;
+
+  return net::ERR_FAILED;
+}
+
+int LogStoreBackendImpl::DoomAllEntries(const CompletionCallback& callback) {
+  TrimCache(true);
+  // Rewriting the log is cheaper than appending one tombstone per entry, and
+  // shrinks the file right away.
+  Compact();
+  return net::OK;
+}
+
+int LogStoreBackendImpl::DoomEntriesBetween(
+    const base::Time initial_time,
+    const base::Time end_time,
+    const CompletionCallback& callback) {
+  if (end_time.is_null())
+    return DoomEntriesSince(initial_time, callback);
+
+  DCHECK(end_time >= initial_time);
+
+  LogStoreEntryImpl* node = GetNextFromRankingList(NULL);
+  // Last valid entry before |node|.
+  LogStoreEntryImpl* last_valid = NULL;
+
+  // The ranking list is ordered by last used time, so this will descend
+  // through the cache and start dooming items before the end_time, and will
+  // stop once it reaches an item used before the initial time.
+  while (node) {
+    if (node->GetLastUsed() < initial_time)
+      break;
+
+    if (node->GetLastUsed() < end_time)
+      node->Doom();
+    else
+      last_valid = node;
+    node = GetNextFromRankingList(last_valid);
+  }
+
+  return net::OK;
+}
+
+int LogStoreBackendImpl::DoomEntriesSince(const base::Time initial_time,
+                                          const CompletionCallback& callback) {
+  for (;;) {
+    // Get the entry in the front.
+    LogStoreEntryImpl* entry = GetNextFromRankingList(NULL);
+
+    // Break the loop when there are no more entries or the entry is too old.
+    if (!entry || entry->GetLastUsed() < initial_time)
+      return net::OK;
+    entry->Doom();
+  }
+}
+
+int LogStoreBackendImpl::OpenNextEntry(void** iter, Entry** next_entry,
+                                       const CompletionCallback& callback) {
+  if (OpenNextEntry(iter, next_entry))
+    return net::OK;
+
+  return net::ERR_FAILED;
+}
+
+void LogStoreBackendImpl::EndEnumeration(void** iter) {
+  *iter = NULL;
+}
+
+void LogStoreBackendImpl::OnExternalCacheHit(const std::string& key) {
+  EntryMap::iterator it = entries_.find(key);
+  if (it != entries_.end())
+    UpdateRank(it->second);
+}
+
+// static
+void LogStoreBackendImpl::LoadLog(const base::FilePath& log_path,
+                                  LoadResult* result) {
+  result->ok = false;
+  base::File file(log_path,
+                  base::File::FLAG_OPEN_ALWAYS | base::File::FLAG_READ |
+                      base::File::FLAG_WRITE);
+  if (!file.IsValid())
+    return;
+
+  const int64 length = file.GetLength();
+  LogStoreFileHeader file_header;
+  bool start_over = length < static_cast<int64>(sizeof(file_header));
+  if (!start_over) {
+    if (file.Read(0, reinterpret_cast<char*>(&file_header),
+                  sizeof(file_header)) != sizeof(file_header))
+      return;
+    start_over =
+        file_header.initial_magic_number != kLogStoreInitialMagicNumber ||
+        file_header.version != kLogStoreVersion;
+  }
+  if (start_over) {
+    // The log is new, from another implementation, or torn mid-header. Cache
+    // contents are expendable; write a fresh header and start empty.
+    LogStoreFileHeader new_header;
+    new_header.initial_magic_number = kLogStoreInitialMagicNumber;
+    new_header.version = kLogStoreVersion;
+    if (!file.SetLength(0) ||
+        file.Write(0, reinterpret_cast<const char*>(&new_header),
+                   sizeof(new_header)) != sizeof(new_header))
+      return;
+    result->log_size = sizeof(new_header);
+    result->ok = true;
+    return;
+  }
+
+  typedef std::map<std::string, LoadedEntry*> LoadedEntryMap;
+  LoadedEntryMap loaded;
+  int64 offset = sizeof(file_header);
+  while (offset < length) {
+    LogStoreRecordHeader header;
+    if (file.Read(offset, reinterpret_cast<char*>(&header), sizeof(header)) !=
+            static_cast<int>(sizeof(header)) ||
+        header.record_magic_number != kLogStoreRecordMagicNumber) {
+      break;
+    }
+    bool sane = header.key_length > 0 && header.key_length <= kMaxKeyLength;
+    int64 payload_size = header.key_length;
+    for (int i = 0; i < kLogStoreStreamCount; i++) {
+      sane = sane && header.data_size[i] >= 0;
+      payload_size += header.data_size[i];
+    }
+    if (!sane || payload_size > kMaxRecordPayloadSize ||
+        offset + static_cast<int64>(sizeof(header)) + payload_size > length)
+      break;
+
+    scoped_ptr<char[]> payload(new char[payload_size]);
+    const int payload_read_size = static_cast<int>(payload_size);
+    if (file.Read(offset + sizeof(header), payload.get(),
+                  payload_read_size) != payload_read_size)
+      break;
+
+    const std::string key(payload.get(), header.key_length);
+    const uint32 crc = crc32(crc32(0L, Z_NULL, 0),
+                             reinterpret_cast<const Bytef*>(payload.get()),
+                             payload_read_size);
+    LoadedEntryMap::iterator it = loaded.find(key);
+    if (crc != header.data_crc32 ||
+        (header.flags & LogStoreRecordHeader::FLAG_TOMBSTONE)) {
+      // Either an explicit deletion or a record damaged in place; in both
+      // cases the key must not come back.
+      if (it != loaded.end()) {
+        delete it->second;
+        loaded.erase(it);
+      }
+    } else {
+      LoadedEntry* entry;
+      if (it != loaded.end()) {
+        entry = it->second;
+      } else {
+        entry = new LoadedEntry();
+        entry->key = key;
+        loaded[key] = entry;
+      }
+      const char* data = payload.get() + header.key_length;
+      for (int i = 0; i < kLogStoreStreamCount; i++) {
+        entry->data[i].assign(data, header.data_size[i]);
+        data += header.data_size[i];
+      }
+      entry->last_used = header.last_used;
+      entry->last_modified = header.last_modified;
+    }
+    offset += sizeof(header) + payload_size;
+  }
+
+  if (offset < length) {
+    // Drop the unparseable tail, usually the result of a torn append.
+    file.SetLength(offset);
+  }
+
+  result->log_size = offset;
+  for (LoadedEntryMap::iterator it = loaded.begin(); it != loaded.end(); ++it)
+    result->entries.push_back(it->second);
+  loaded.clear();
+  result->ok = true;
+}
+
+// static
+bool LogStoreBackendImpl::LoadedEntryLessRecentlyUsed(const LoadedEntry* a,
+                                                      const LoadedEntry* b) {
+  return a->last_used < b->last_used;
+}
+
+void LogStoreBackendImpl::InitializeFromLoad(
+    const CompletionCallback& callback,
+    LoadResult* result) {
+  if (!result->ok) {
+    LOG(ERROR) << "Unable to load log store cache.";
+    callback.Run(net::ERR_FAILED);
+    return;
+  }
+
+  log_size_ = result->log_size;
+  // Insert in least recently used order so that the head of the ranking list
+  // ends up being the most recently used entry.
+  std::sort(result->entries.begin(), result->entries.end(),
+            &LogStoreBackendImpl::LoadedEntryLessRecentlyUsed);
+  for (size_t i = 0; i < result->entries.size(); ++i) {
+    LoadedEntry* loaded = result->entries[i];
+    LogStoreEntryImpl* entry = new LogStoreEntryImpl(this);
+    entry->LoadEntry(loaded->key, loaded->data,
+                     Time::FromInternalValue(loaded->last_used),
+                     Time::FromInternalValue(loaded->last_modified),
+                     net_log_);
+    entries_[loaded->key] = entry;
+    InsertIntoRankingList(entry);
+  }
+
+  initialized_ = true;
+  TrimCache(false);
+  MaybeCompact();
+  callback.Run(net::OK);
+}
+
+bool LogStoreBackendImpl::OpenEntry(const std::string& key, Entry** entry) {
+  EntryMap::iterator it = entries_.find(key);
+  if (it == entries_.end())
+    return false;
+
+  it->second->Open();
+
+  *entry = it->second;
+  return true;
+}
+
+bool LogStoreBackendImpl::CreateEntry(const std::string& key, Entry** entry) {
+  EntryMap::iterator it = entries_.find(key);
+  if (it != entries_.end())
+    return false;
+
+  LogStoreEntryImpl* cache_entry = new LogStoreEntryImpl(this);
+  if (!cache_entry->CreateEntry(key, net_log_)) {
+    delete cache_entry;
+    return false;
+  }
+
+  InsertIntoRankingList(cache_entry);
+  entries_[key] = cache_entry;
+
+  *entry = cache_entry;
+  return true;
+}
+
+bool LogStoreBackendImpl::DoomEntry(const std::string& key) {
+  Entry* entry;
+  if (!OpenEntry(key, &entry))
+    return false;
+
+  entry->Doom();
+  entry->Close();
+  return true;
+}
+
+bool LogStoreBackendImpl::OpenNextEntry(void** iter, Entry** next_entry) {
+  LogStoreEntryImpl* current = reinterpret_cast<LogStoreEntryImpl*>(*iter);
+  LogStoreEntryImpl* node = GetNextFromRankingList(current);
+  *next_entry = node;
+  *iter = node;
+
+  if (node)
+    node->Open();
+
+  return NULL != node;
+}
+
+void LogStoreBackendImpl::InsertIntoRankingList(LogStoreEntryImpl* entry) {
+  if (rankings_head_)
+    rankings_head_->set_prev(entry);
+
+  if (!rankings_tail_)
+    rankings_tail_ = entry;
+
+  entry->set_prev(NULL);
+  entry->set_next(rankings_head_);
+  rankings_head_ = entry;
+}
+
+void LogStoreBackendImpl::RemoveFromRankingList(LogStoreEntryImpl* entry) {
+  LogStoreEntryImpl* prev = entry->prev();
+  LogStoreEntryImpl* next = entry->next();
+
+  if (rankings_head_ == entry)
+    rankings_head_ = next;
+
+  if (rankings_tail_ == entry)
+    rankings_tail_ = prev;
+
+  if (prev)
+    prev->set_next(next);
+
+  if (next)
+    next->set_prev(prev);
+
+  entry->set_next(NULL);
+  entry->set_prev(NULL);
+}
+
+LogStoreEntryImpl* LogStoreBackendImpl::GetNextFromRankingList(
+    LogStoreEntryImpl* entry) {
+  return entry ? entry->next() : rankings_head_;
+}
+
+LogStoreEntryImpl* LogStoreBackendImpl::GetPrevFromRankingList(
+    LogStoreEntryImpl* entry) {
+  return entry ? entry->prev() : rankings_tail_;
+}
+
+void LogStoreBackendImpl::EvictEntry(LogStoreEntryImpl* entry) {
+  RemoveFromRankingList(entry);
+  entries_.erase(entry->GetKey());
+  entry->InternalDoom();
+}
+
+void LogStoreBackendImpl::TrimCache(bool empty) {
+  LogStoreEntryImpl* next = GetPrevFromRankingList(NULL);
+  if (!next)
+    return;
+
+  int target_size = empty ? 0 : LowWaterAdjust(max_size_);
+  while (current_size_ > target_size && next) {
+    LogStoreEntryImpl* node = next;
+    next = GetPrevFromRankingList(next);
+    if (!node->InUse() || empty) {
+      // No tombstone: the next compaction reclaims the stale record, and
+      // resurrecting an evicted entry on restart is harmless for a cache.
+      EvictEntry(node);
+    }
+  }
+}
+
+void LogStoreBackendImpl::PostAppend(scoped_ptr<std::string> record) {
+  cache_thread_->PostTask(
+      FROM_HERE,
+      base::Bind(&AppendToLogBlocking, GetLogFilePath(),
+                 base::Passed(&record)));
+}
+
+void LogStoreBackendImpl::MaybeCompact() {
+  if (!initialized_)
+    return;
+  if (log_size_ < kCompactionMinLogSize)
+    return;
+  // |current_size_| does not count the per-record headers, but those are
+  // small compared to the payloads this store is built for.
+  if (log_size_ <= 2 * static_cast<int64>(current_size_))
+    return;
+  Compact();
+}
+
+void LogStoreBackendImpl::Compact() {
+  scoped_ptr<std::string> contents(new std::string);
+  LogStoreFileHeader file_header;
+  file_header.initial_magic_number = kLogStoreInitialMagicNumber;
+  file_header.version = kLogStoreVersion;
+  contents->append(reinterpret_cast<const char*>(&file_header),
+                   sizeof(file_header));
+  for (EntryMap::iterator it = entries_.begin(); it != entries_.end(); ++it) {
+    it->second->SerializeRecord(contents.get());
+    it->second->set_persisted(true);
+  }
+  log_size_ = contents->size();
+  cache_thread_->PostTask(
+      FROM_HERE,
+      base::Bind(&RewriteLogBlocking, GetLogFilePath(),
+                 base::Passed(&contents)));
+}
+
+void LogStoreBackendImpl::AddStorageSize(int32 bytes) {
+  current_size_ += bytes;
+  DCHECK_GE(current_size_, 0);
+
+  if (current_size_ > max_size_)
+    TrimCache(false);
+}
+
+void LogStoreBackendImpl::SubstractStorageSize(int32 bytes) {
+  current_size_ -= bytes;
+  DCHECK_GE(current_size_, 0);
+}
+
+base::FilePath LogStoreBackendImpl::GetLogFilePath() const {
+  return path_.AppendASCII(kLogFileName);
+}
+
+}  // namespace disk_cache
@@ -0,0 +1,191 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// See net/disk_cache/disk_cache.h for the public interface of the cache.
+
+#ifndef NET_DISK_CACHE_LOGSTORE_LOG_STORE_BACKEND_IMPL_H_
+#define NET_DISK_CACHE_LOGSTORE_LOG_STORE_BACKEND_IMPL_H_
+
+#include <string>
+#include <vector>
+
+#include "base/compiler_specific.h"
+#include "base/containers/hash_tables.h"
+#include "base/files/file_path.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/memory/scoped_vector.h"
+#include "base/memory/weak_ptr.h"
+#include "net/disk_cache/disk_cache.h"
+#include "net/disk_cache/logstore/log_store_format.h"
+
+namespace base {
+class SingleThreadTaskRunner;
+}  // namespace base
+
+namespace net {
+class NetLog;
+}  // namespace net
+
+namespace disk_cache {
+
+class LogStoreEntryImpl;
+
+// This class implements the Backend interface on top of a single append-only
+// log file. It is meant for caches that consist of many small entries: the
+// contents of all live entries are kept in memory, reads are serviced without
+// disk IO, and closing a modified entry costs one append to the log instead
+// of the file creation and several writes the other backends require.
+//
+// Superseded records accumulate in the log until it grows past twice the live
+// data size, at which point the live records are rewritten to a fresh log
+// ("compaction"). All file IO, including compaction, happens on the cache
+// thread; the in-memory state on the IO thread is never blocked on it.
+class NET_EXPORT_PRIVATE LogStoreBackendImpl : public Backend {
+ public:
+  LogStoreBackendImpl(const base::FilePath& path,
+                      int max_bytes,
+                      net::CacheType cache_type,
+                      base::SingleThreadTaskRunner* cache_thread,
+                      net::NetLog* net_log);
+  virtual ~LogStoreBackendImpl();
+
+  // Scans the log file on the cache thread and builds the in-memory state.
+  // Returns a net error code; on ERR_IO_PENDING, |completion_callback| will
+  // be run when the backend is ready.
+  int Init(const CompletionCallback& completion_callback);
+
+  // Permanently deletes an entry, recording a tombstone in the log.
+  void InternalDoomEntry(LogStoreEntryImpl* entry);
+
+  // Called when a modified entry is closed; appends the entry to the log.
+  void OnEntryModified(LogStoreEntryImpl* entry);
+
+  // Updates the ranking information for an entry.
+  void UpdateRank(LogStoreEntryImpl* entry);
+
+  // A user data block is being created, extended or truncated.
+  void ModifyStorageSize(int32 old_size, int32 new_size);
+
+  // Returns the maximum size for a single stream to reside on the cache.
+  int MaxFileSize() const;
+
+  // Backend interface.
+  virtual net::CacheType GetCacheType() const OVERRIDE;
+  virtual int32 GetEntryCount() const OVERRIDE;
+  virtual int OpenEntry(const std::string& key, Entry** entry,
+                        const CompletionCallback& callback) OVERRIDE;
+  virtual int CreateEntry(const std::string& key, Entry** entry,
+                          const CompletionCallback& callback) OVERRIDE;
+  virtual int DoomEntry(const std::string& key,
+                        const CompletionCallback& callback) OVERRIDE;
+  virtual int DoomAllEntries(const CompletionCallback& callback) OVERRIDE;
+  virtual int DoomEntriesBetween(base::Time initial_time,
+                                 base::Time end_time,
+                                 const CompletionCallback& callback) OVERRIDE;
+  virtual int DoomEntriesSince(base::Time initial_time,
+                               const CompletionCallback& callback) OVERRIDE;
+  virtual int OpenNextEntry(void** iter, Entry** next_entry,
+                            const CompletionCallback& callback) OVERRIDE;
+  virtual void EndEnumeration(void** iter) OVERRIDE;
+  virtual void GetStats(
+      std::vector<std::pair<std::string, std::string> >* stats) OVERRIDE {}
+  virtual void OnExternalCacheHit(const std::string& key) OVERRIDE;
+
+ private:
+  typedef base::hash_map<std::string, LogStoreEntryImpl*> EntryMap;
+
+  // An entry as it was restored from the log during Init().
+  struct LoadedEntry {
+    LoadedEntry();
+    ~LoadedEntry();
+
+    std::string key;
+    std::string data[kLogStoreStreamCount];
+    int64 last_used;
+    int64 last_modified;
+  };
+
+  // Everything the log scan produces, handed back to the IO thread.
+  struct LoadResult {
+    LoadResult();
+    ~LoadResult();
+
+    bool ok;
+    int64 log_size;
+    ScopedVector<LoadedEntry> entries;
+  };
+
+  // Reads the whole log sequentially, keeping the last record for each key.
+  // Truncates the log at the first torn or unparseable record. Runs on the
+  // cache thread.
+  static void LoadLog(const base::FilePath& log_path, LoadResult* result);
+
+  // Orders loaded entries from least to most recently used.
+  static bool LoadedEntryLessRecentlyUsed(const LoadedEntry* a,
+                                          const LoadedEntry* b);
+
+  // Builds the in-memory entries from |result| and runs |callback|. Runs on
+  // the IO thread.
+  void InitializeFromLoad(const CompletionCallback& callback,
+                          LoadResult* result);
+
+  // Old Backend interface.
+  bool OpenEntry(const std::string& key, Entry** entry);
+  bool CreateEntry(const std::string& key, Entry** entry);
+  bool DoomEntry(const std::string& key);
+  bool OpenNextEntry(void** iter, Entry** next_entry);
+
+  // LRU list management, modeled on MemRankings.
+  void InsertIntoRankingList(LogStoreEntryImpl* entry);
+  void RemoveFromRankingList(LogStoreEntryImpl* entry);
+  LogStoreEntryImpl* GetNextFromRankingList(LogStoreEntryImpl* entry);
+  LogStoreEntryImpl* GetPrevFromRankingList(LogStoreEntryImpl* entry);
+
+  // Removes an entry from the in-memory state without recording a tombstone.
+  // Used for evictions: the stale record is reclaimed by compaction instead.
+  void EvictEntry(LogStoreEntryImpl* entry);
+
+  // Deletes entries from the cache until the current size is below the limit.
+  // If empty is true, the whole cache will be trimmed, regardless of being in
+  // use.
+  void TrimCache(bool empty);
+
+  // Posts an append of |record| to the log on the cache thread.
+  void PostAppend(scoped_ptr<std::string> record);
+
+  // Rewrites the log with only the live records if enough of it is dead.
+  void MaybeCompact();
+  void Compact();
+
+  // Handles the used storage count.
+  void AddStorageSize(int32 bytes);
+  void SubstractStorageSize(int32 bytes);
+
+  base::FilePath GetLogFilePath() const;
+
+  const base::FilePath path_;
+  const net::CacheType cache_type_;
+  scoped_refptr<base::SingleThreadTaskRunner> cache_thread_;
+
+  EntryMap entries_;
+  LogStoreEntryImpl* rankings_head_;  // LRU list, most recently used first.
+  LogStoreEntryImpl* rankings_tail_;
+
+  int32 max_size_;      // Maximum data size for this instance.
+  int32 current_size_;  // Size of the live entries in memory.
+  int64 log_size_;      // Size of the log file, including dead records.
+
+  bool initialized_;
+
+  net::NetLog* net_log_;
+
+  base::WeakPtrFactory<LogStoreBackendImpl> ptr_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(LogStoreBackendImpl);
+};
+
+}  // namespace disk_cache
+
+#endif  // NET_DISK_CACHE_LOGSTORE_LOG_STORE_BACKEND_IMPL_H_
@@ -0,0 +1,326 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/disk_cache/logstore/log_store_entry_impl.h"
+
+#include <cstring>
+
+#include "base/logging.h"
+#include "net/base/io_buffer.h"
+#include "net/base/net_errors.h"
+#include "net/disk_cache/logstore/log_store_backend_impl.h"
+#include "net/disk_cache/net_log_parameters.h"
+#include "third_party/zlib/zlib.h"
+
+using base::Time;
+
+namespace disk_cache {
+
+LogStoreEntryImpl::LogStoreEntryImpl(LogStoreBackendImpl* backend) {
+  backend_ = backend;
+  ref_count_ = 0;
+  next_ = NULL;
+  prev_ = NULL;
+  doomed_ = false;
+  modified_ = false;
+  persisted_ = false;
+  for (int i = 0; i < kLogStoreStreamCount; i++)
+    data_size_[i] = 0;
+}
+
+// ------------------------------------------------------------------------
+
+bool LogStoreEntryImpl::CreateEntry(const std::string& key,
+                                    net::NetLog* net_log) {
+  key_ = key;
+  Time current = Time::Now();
+  last_modified_ = current;
+  last_used_ = current;
+  // A new entry is appended to the log when it is closed, even if nothing
+  // was written, so that it survives a restart.
+  modified_ = true;
+
+  net_log_ = net::BoundNetLog::Make(net_log,
+                                    net::NetLog::SOURCE_LOG_STORE_CACHE_ENTRY);
+  // Must be called after |key_| is set, so GetKey() works.
+  net_log_.BeginEvent(
+      net::NetLog::TYPE_DISK_CACHE_LOG_STORE_ENTRY_IMPL,
+      CreateNetLogEntryCreationCallback(this, true));
+
+  Open();
+  backend_->ModifyStorageSize(0, static_cast<int32>(key.size()));
+  return true;
+}
+
+bool LogStoreEntryImpl::LoadEntry(const std::string& key,
+                                  const std::string data[kLogStoreStreamCount],
+                                  Time last_used,
+                                  Time last_modified,
+                                  net::NetLog* net_log) {
+  key_ = key;
+  last_used_ = last_used;
+  last_modified_ = last_modified;
+  persisted_ = true;
+
+  int32 total_size = static_cast<int32>(key.size());
+  for (int i = 0; i < kLogStoreStreamCount; i++) {
+    data_size_[i] = static_cast<int32>(data[i].size());
+    data_[i].assign(data[i].begin(), data[i].end());
+    total_size += data_size_[i];
+  }
+
+  net_log_ = net::BoundNetLog::Make(net_log,
+                                    net::NetLog::SOURCE_LOG_STORE_CACHE_ENTRY);
+  net_log_.BeginEvent(
+      net::NetLog::TYPE_DISK_CACHE_LOG_STORE_ENTRY_IMPL,
+      CreateNetLogEntryCreationCallback(this, false));
+
+  backend_->ModifyStorageSize(0, total_size);
+  return true;
+}
+
+void LogStoreEntryImpl::InternalDoom() {
+  net_log_.AddEvent(net::NetLog::TYPE_ENTRY_DOOM);
+  doomed_ = true;
+  if (!ref_count_)
+    delete this;
+}
+
+void LogStoreEntryImpl::SerializeRecord(std::string* out) const {
+  LogStoreRecordHeader header;
+  header.record_magic_number = kLogStoreRecordMagicNumber;
+  header.flags = 0;
+  header.key_length = key_.size();
+  header.last_used = last_used_.ToInternalValue();
+  header.last_modified = last_modified_.ToInternalValue();
+
+  uint32 crc = crc32(0L, Z_NULL, 0);
+  crc = crc32(crc, reinterpret_cast<const Bytef*>(key_.data()), key_.size());
+  for (int i = 0; i < kLogStoreStreamCount; i++) {
+    header.data_size[i] = data_size_[i];
+    if (data_size_[i] > 0) {
+      crc = crc32(crc, reinterpret_cast<const Bytef*>(&data_[i][0]),
+                  data_size_[i]);
+    }
+  }
+  header.data_crc32 = crc;
+
+  out->append(reinterpret_cast<const char*>(&header), sizeof(header));
+  out->append(key_);
+  for (int i = 0; i < kLogStoreStreamCount; i++) {
+    if (data_size_[i] > 0)
+      out->append(&data_[i][0], data_size_[i]);
+  }
+}
+
+void LogStoreEntryImpl::Open() {
+  ref_count_++;
+  DCHECK_GE(ref_count_, 0);
+  DCHECK(!doomed_);
+}
+
+bool LogStoreEntryImpl::InUse() const {
+  return ref_count_ > 0;
+}
+
+// ------------------------------------------------------------------------
+
+void LogStoreEntryImpl::Doom() {
+  if (doomed_)
+    return;
+  backend_->InternalDoomEntry(this);
+}
+
+void LogStoreEntryImpl::Close() {
+  DCHECK_GT(ref_count_, 0);
+  if (modified_ && !doomed_) {
+    backend_->OnEntryModified(this);
+    modified_ = false;
+  }
+  ref_count_--;
+  if (!ref_count_ && doomed_)
+    InternalDoom();
+}
+
+std::string LogStoreEntryImpl::GetKey() const {
+  return key_;
+}
+
+Time LogStoreEntryImpl::GetLastUsed() const {
+  return last_used_;
+}
+
+Time LogStoreEntryImpl::GetLastModified() const {
+  return last_modified_;
+}
+
+int32 LogStoreEntryImpl::GetDataSize(int index) const {
+  if (index < 0 || index >= kLogStoreStreamCount)
+    return 0;
+  return data_size_[index];
+}
+
+int LogStoreEntryImpl::ReadData(int index, int offset, IOBuffer* buf,
+                                int buf_len,
+                                const CompletionCallback& callback) {
+  if (net_log_.IsLogging()) {
+    net_log_.BeginEvent(
+        net::NetLog::TYPE_ENTRY_READ_DATA,
+        CreateNetLogReadWriteDataCallback(index, offset, buf_len, false));
+  }
+
+  int result = InternalReadData(index, offset, buf, buf_len);
+
+  if (net_log_.IsLogging()) {
+    net_log_.EndEvent(
+        net::NetLog::TYPE_ENTRY_READ_DATA,
+        CreateNetLogReadWriteCompleteCallback(result));
+  }
+  return result;
+}
+
+int LogStoreEntryImpl::WriteData(int index, int offset, IOBuffer* buf,
+                                 int buf_len,
+                                 const CompletionCallback& callback,
+                                 bool truncate) {
+  if (net_log_.IsLogging()) {
+    net_log_.BeginEvent(
+        net::NetLog::TYPE_ENTRY_WRITE_DATA,
+        CreateNetLogReadWriteDataCallback(index, offset, buf_len, truncate));
+  }
+
+  int result = InternalWriteData(index, offset, buf, buf_len, truncate);
+
+  if (net_log_.IsLogging()) {
+    net_log_.EndEvent(
+        net::NetLog::TYPE_ENTRY_WRITE_DATA,
+        CreateNetLogReadWriteCompleteCallback(result));
+  }
+  return result;
+}
+
+int LogStoreEntryImpl::ReadSparseData(int64 offset, IOBuffer* buf, int buf_len,
+                                      const CompletionCallback& callback) {
+  return net::ERR_CACHE_OPERATION_NOT_SUPPORTED;
+}
+
+int LogStoreEntryImpl::WriteSparseData(int64 offset, IOBuffer* buf,
+                                       int buf_len,
+                                       const CompletionCallback& callback) {
+  return net::ERR_CACHE_OPERATION_NOT_SUPPORTED;
+}
+
+int LogStoreEntryImpl::GetAvailableRange(int64 offset, int len, int64* start,
+                                         const CompletionCallback& callback) {
+  return net::ERR_CACHE_OPERATION_NOT_SUPPORTED;
+}
+
+bool LogStoreEntryImpl::CouldBeSparse() const {
+  return false;
+}
+
+int LogStoreEntryImpl::ReadyForSparseIO(const CompletionCallback& callback) {
+  return net::ERR_CACHE_OPERATION_NOT_SUPPORTED;
+}
+
+// ------------------------------------------------------------------------
+
+LogStoreEntryImpl::~LogStoreEntryImpl() {
+  for (int i = 0; i < kLogStoreStreamCount; i++)
+    backend_->ModifyStorageSize(data_size_[i], 0);
+  backend_->ModifyStorageSize(static_cast<int32>(key_.size()), 0);
+  net_log_.EndEvent(net::NetLog::TYPE_DISK_CACHE_LOG_STORE_ENTRY_IMPL);
+}
+
+int LogStoreEntryImpl::InternalReadData(int index, int offset, IOBuffer* buf,
+                                        int buf_len) {
+  if (index < 0 || index >= kLogStoreStreamCount)
+    return net::ERR_INVALID_ARGUMENT;
+
+  int entry_size = GetDataSize(index);
+  if (offset >= entry_size || offset < 0 || !buf_len)
+    return 0;
+
+  if (buf_len < 0)
+    return net::ERR_INVALID_ARGUMENT;
+
+  if (offset + buf_len > entry_size)
+    buf_len = entry_size - offset;
+
+  UpdateRank(false);
+
+  memcpy(buf->data(), &(data_[index])[offset], buf_len);
+  return buf_len;
+}
+
+int LogStoreEntryImpl::InternalWriteData(int index, int offset, IOBuffer* buf,
+                                         int buf_len, bool truncate) {
+  if (index < 0 || index >= kLogStoreStreamCount)
+    return net::ERR_INVALID_ARGUMENT;
+
+  if (offset < 0 || buf_len < 0)
+    return net::ERR_INVALID_ARGUMENT;
+
+  int max_file_size = backend_->MaxFileSize();
+
+  // offset or buf_len could be negative numbers.
+  if (offset > max_file_size || buf_len > max_file_size ||
+      offset + buf_len > max_file_size) {
+    return net::ERR_FAILED;
+  }
+
+  // Read the size at this point.
+  int entry_size = GetDataSize(index);
+
+  PrepareTarget(index, offset, buf_len);
+
+  if (entry_size < offset + buf_len) {
+    backend_->ModifyStorageSize(entry_size, offset + buf_len);
+    data_size_[index] = offset + buf_len;
+  } else if (truncate) {
+    if (entry_size > offset + buf_len) {
+      backend_->ModifyStorageSize(entry_size, offset + buf_len);
+      data_size_[index] = offset + buf_len;
+    }
+  }
+
+  modified_ = true;
+  UpdateRank(true);
+
+  if (!buf_len)
+    return 0;
+
+  memcpy(&(data_[index])[offset], buf->data(), buf_len);
+  return buf_len;
+}
+
+void LogStoreEntryImpl::PrepareTarget(int index, int offset, int buf_len) {
+  int entry_size = GetDataSize(index);
+
+  if (entry_size >= offset + buf_len)
+    return;  // Not growing the stored data.
+
+  if (static_cast<int>(data_[index].size()) < offset + buf_len)
+    data_[index].resize(offset + buf_len);
+
+  if (offset <= entry_size)
+    return;  // There is no "hole" on the stored data.
+
+  // Cleanup the hole not written by the user. The point is to avoid returning
+  // random stuff later on.
+  memset(&(data_[index])[entry_size], 0, offset - entry_size);
+}
+
+void LogStoreEntryImpl::UpdateRank(bool modified) {
+  Time current = Time::Now();
+  last_used_ = current;
+
+  if (modified)
+    last_modified_ = current;
+
+  if (!doomed_)
+    backend_->UpdateRank(this);
+}
+
+}  // namespace disk_cache
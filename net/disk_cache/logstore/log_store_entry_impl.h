@@ -0,0 +1,125 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_DISK_CACHE_LOGSTORE_LOG_STORE_ENTRY_IMPL_H_
+#define NET_DISK_CACHE_LOGSTORE_LOG_STORE_ENTRY_IMPL_H_
+
+#include <string>
+#include <vector>
+
+#include "net/base/net_log.h"
+#include "net/disk_cache/disk_cache.h"
+#include "net/disk_cache/logstore/log_store_format.h"
+
+namespace disk_cache {
+
+class LogStoreBackendImpl;
+
+// This class implements the Entry interface for the log-structured store. The
+// contents of an entry are kept entirely in memory while the backend is
+// running; the log file on disk is only used to persist them across restarts.
+// Reads therefore never touch the disk, and a modified entry is appended to
+// the log as a single record when it is closed.
+//
+// Sparse operations are not supported: the store is meant for many small
+// entries, and sparse data is better served by the other backends.
+class LogStoreEntryImpl : public Entry {
+ public:
+  explicit LogStoreEntryImpl(LogStoreBackendImpl* backend);
+
+  // Performs the initialization of an entry that is being newly created.
+  bool CreateEntry(const std::string& key, net::NetLog* net_log);
+
+  // Performs the initialization of an entry restored from a log record.
+  bool LoadEntry(const std::string& key,
+                 const std::string data[kLogStoreStreamCount],
+                 base::Time last_used,
+                 base::Time last_modified,
+                 net::NetLog* net_log);
+
+  // Permanently destroys this entry.
+  void InternalDoom();
+
+  // Appends a log record with the current contents of this entry to |out|.
+  void SerializeRecord(std::string* out) const;
+
+  void Open();
+  bool InUse() const;
+
+  // True once the current contents of the entry have been handed to the
+  // backend for appending to the log.
+  bool persisted() const { return persisted_; }
+  void set_persisted(bool persisted) { persisted_ = persisted; }
+
+  LogStoreEntryImpl* next() const { return next_; }
+  LogStoreEntryImpl* prev() const { return prev_; }
+  void set_next(LogStoreEntryImpl* next) { next_ = next; }
+  void set_prev(LogStoreEntryImpl* prev) { prev_ = prev; }
+
+  // Entry interface.
+  virtual void Doom() OVERRIDE;
+  virtual void Close() OVERRIDE;
+  virtual std::string GetKey() const OVERRIDE;
+  virtual base::Time GetLastUsed() const OVERRIDE;
+  virtual base::Time GetLastModified() const OVERRIDE;
+  virtual int32 GetDataSize(int index) const OVERRIDE;
+  virtual int ReadData(int index, int offset, IOBuffer* buf, int buf_len,
+                       const CompletionCallback& callback) OVERRIDE;
+  virtual int WriteData(int index, int offset, IOBuffer* buf, int buf_len,
+                        const CompletionCallback& callback,
+                        bool truncate) OVERRIDE;
+  virtual int ReadSparseData(int64 offset, IOBuffer* buf, int buf_len,
+                             const CompletionCallback& callback) OVERRIDE;
+  virtual int WriteSparseData(int64 offset, IOBuffer* buf, int buf_len,
+                              const CompletionCallback& callback) OVERRIDE;
+  virtual int GetAvailableRange(int64 offset, int len, int64* start,
+                                const CompletionCallback& callback) OVERRIDE;
+  virtual bool CouldBeSparse() const OVERRIDE;
+  virtual void CancelSparseIO() OVERRIDE {}
+  virtual int ReadyForSparseIO(const CompletionCallback& callback) OVERRIDE;
+
+ private:
+  // The backend deletes entries that fail initialization before they are
+  // handed out and thus never acquire a reference.
+  friend class LogStoreBackendImpl;
+
+  virtual ~LogStoreEntryImpl();
+
+  // Do all the work for the corresponding public functions. Implemented as
+  // separate functions to make logging of results simpler.
+  int InternalReadData(int index, int offset, IOBuffer* buf, int buf_len);
+  int InternalWriteData(int index, int offset, IOBuffer* buf, int buf_len,
+                        bool truncate);
+
+  // Grows and cleans up the data buffer.
+  void PrepareTarget(int index, int offset, int buf_len);
+
+  // Updates ranking information.
+  void UpdateRank(bool modified);
+
+  std::string key_;
+  std::vector<char> data_[kLogStoreStreamCount];  // User data.
+  int32 data_size_[kLogStoreStreamCount];
+  int ref_count_;
+
+  LogStoreEntryImpl* next_;   // Pointers for the LRU list.
+  LogStoreEntryImpl* prev_;
+
+  base::Time last_modified_;  // LRU information.
+  base::Time last_used_;
+  LogStoreBackendImpl* backend_;  // Back pointer to the cache.
+  bool doomed_;               // True if this entry was removed from the cache.
+  bool modified_;             // True if the entry has changed since it was
+                              // last appended to the log.
+  bool persisted_;            // True if the log contains a record for this
+                              // entry.
+
+  net::BoundNetLog net_log_;
+
+  DISALLOW_COPY_AND_ASSIGN(LogStoreEntryImpl);
+};
+
+}  // namespace disk_cache
+
+#endif  // NET_DISK_CACHE_LOGSTORE_LOG_STORE_ENTRY_IMPL_H_
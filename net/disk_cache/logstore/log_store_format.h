@@ -0,0 +1,60 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_DISK_CACHE_LOGSTORE_LOG_STORE_FORMAT_H_
+#define NET_DISK_CACHE_LOGSTORE_LOG_STORE_FORMAT_H_
+
+#include "base/basictypes.h"
+#include "base/port.h"
+#include "net/base/net_export.h"
+
+namespace disk_cache {
+
+const uint64 kLogStoreInitialMagicNumber = GG_UINT64_C(0x5bf1896275c2f186);
+const uint64 kLogStoreRecordMagicNumber = GG_UINT64_C(0x8257cbbe10cd57a4);
+
+const uint32 kLogStoreVersion = 1;
+
+static const int kLogStoreStreamCount = 3;
+
+// The log file of the log-structured store consists of:
+//   - a LogStoreFileHeader.
+//   - a sequence of records, each of which is:
+//     - a LogStoreRecordHeader.
+//     - the key.
+//     - the data from each stream, in stream order.
+//
+// Records are only ever appended. A record supersedes every earlier record
+// with the same key; a record with the tombstone flag set deletes the key.
+// The store periodically rewrites the log with only the live records to
+// reclaim the space occupied by superseded ones.
+
+struct NET_EXPORT_PRIVATE LogStoreFileHeader {
+  LogStoreFileHeader();
+
+  uint64 initial_magic_number;
+  uint32 version;
+  uint32 unused_must_be_zero;
+};
+
+struct NET_EXPORT_PRIVATE LogStoreRecordHeader {
+  enum Flags {
+    FLAG_TOMBSTONE = (1U << 0),
+  };
+
+  LogStoreRecordHeader();
+
+  uint64 record_magic_number;
+  uint32 flags;
+  uint32 key_length;
+  int32 data_size[kLogStoreStreamCount];
+  // CRC-32 of the key followed by the stream data.
+  uint32 data_crc32;
+  int64 last_used;      // Serialized by base::Time::ToInternalValue().
+  int64 last_modified;  // Serialized by base::Time::ToInternalValue().
+};
+
+}  // namespace disk_cache
+
+#endif  // NET_DISK_CACHE_LOGSTORE_LOG_STORE_FORMAT_H_
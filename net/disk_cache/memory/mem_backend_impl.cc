@@ -29,7 +29,10 @@ int LowWaterAdjust(int high_water) {
 namespace disk_cache {
 
 MemBackendImpl::MemBackendImpl(net::NetLog* net_log)
-    : max_size_(0), current_size_(0), net_log_(net_log) {}
+    : max_size_(0),
+      current_size_(0),
+      second_chance_ranking_(false),
+      net_log_(net_log) {}
 
 MemBackendImpl::~MemBackendImpl() {
   EntryMap::iterator it = entries_.begin();
@@ -102,6 +105,11 @@ void MemBackendImpl::InternalDoomEntry(MemEntryImpl* entry) {
 }
 
 void MemBackendImpl::UpdateRank(MemEntryImpl* node) {
+  if (second_chance_ranking_) {
+    // A hit only marks the entry; TrimCacheSecondChance() consumes the mark.
+    node->SetReferenced(true);
+    return;
+  }
   rankings_.UpdateRank(node);
 }
 
@@ -258,6 +266,20 @@ bool MemBackendImpl::DoomEntriesBetween(const Time initial_time,
   // InternalReadSparseData and InternalWriteSparseData).
   MemEntryImpl* last_valid = NULL;
 
+  if (second_chance_ranking_) {
+    // The ranking list is only approximately ordered by last use in this
+    // mode, so every entry has to be examined.
+    while (node) {
+      if (node->GetLastUsed() >= initial_time &&
+          node->GetLastUsed() < end_time)
+        node->Doom();
+      else
+        last_valid = node;
+      node = rankings_.GetNext(last_valid);
+    }
+    return true;
+  }
+
   // rankings_ is ordered by last used, this will descend through the cache
   // and start dooming items before the end_time, and will stop once it reaches
   // an item used before the initial time.
@@ -276,6 +298,21 @@ bool MemBackendImpl::DoomEntriesBetween(const Time initial_time,
 }
 
 bool MemBackendImpl::DoomEntriesSince(const Time initial_time) {
+  if (second_chance_ranking_) {
+    // See DoomEntriesBetween() for why this examines every entry and how
+    // |last_valid| guards against dooming invalidated child entries.
+    MemEntryImpl* node = rankings_.GetNext(NULL);
+    MemEntryImpl* last_valid = NULL;
+    while (node) {
+      if (node->GetLastUsed() >= initial_time)
+        node->Doom();
+      else
+        last_valid = node;
+      node = rankings_.GetNext(last_valid);
+    }
+    return true;
+  }
+
   for (;;) {
     // Get the entry in the front.
     Entry* entry = rankings_.GetNext(NULL);
@@ -305,6 +342,11 @@ bool MemBackendImpl::OpenNextEntry(void** iter, Entry** next_entry) {
 }
 
 void MemBackendImpl::TrimCache(bool empty) {
+  if (second_chance_ranking_) {
+    TrimCacheSecondChance(empty);
+    return;
+  }
+
   MemEntryImpl* next = rankings_.GetPrev(NULL);
   if (!next)
     return;
@@ -321,6 +363,37 @@ void MemBackendImpl::TrimCache(bool empty) {
   return;
 }
 
+void MemBackendImpl::TrimCacheSecondChance(bool empty) {
+  int target_size = empty ? 0 : LowWaterAdjust(max_size_);
+
+  int node_count = 0;
+  for (MemEntryImpl* node = rankings_.GetNext(NULL); node;
+       node = rankings_.GetNext(node))
+    node_count++;
+
+  // Walk from the tail giving each referenced entry one reprieve: its mark
+  // is cleared and it moves back to the head of the list. A node is thus
+  // examined at most twice, which bounds the loop even when every entry is
+  // in use.
+  int examined = 0;
+  MemEntryImpl* node = rankings_.GetPrev(NULL);
+  while (current_size_ > target_size && node && examined < 2 * node_count) {
+    examined++;
+    MemEntryImpl* prev = rankings_.GetPrev(node);
+    if (node->InUse() && !empty) {
+      // Never evict entries with open handles.
+    } else if (node->WasReferenced() && !empty) {
+      node->SetReferenced(false);
+      rankings_.UpdateRank(node);
+    } else {
+      node->Doom();
+    }
+    node = prev;
+    if (!node && current_size_ > target_size)
+      node = rankings_.GetPrev(NULL);  // Wrap around for another pass.
+  }
+}
+
 void MemBackendImpl::AddStorageSize(int32 bytes) {
   current_size_ += bytes;
   DCHECK_GE(current_size_, 0);
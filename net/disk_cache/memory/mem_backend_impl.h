@@ -40,6 +40,15 @@ class NET_EXPORT_PRIVATE MemBackendImpl : public Backend {
   // Sets the maximum size for the total amount of data stored by this instance.
   bool SetMaxSize(int max_bytes);
 
+  // Selects second-chance ("clock") eviction instead of strict LRU: a cache
+  // hit marks the entry referenced instead of moving it in the ranking list,
+  // and TrimCache() recycles marked entries once before evicting them. Must
+  // be set before the cache is used. ShardedMemBackendImpl enables this for
+  // its shards.
+  void set_second_chance_ranking(bool enabled) {
+    second_chance_ranking_ = enabled;
+  }
+
   // Permanently deletes an entry.
   void InternalDoomEntry(MemEntryImpl* entry);
 
@@ -101,6 +110,11 @@ class NET_EXPORT_PRIVATE MemBackendImpl : public Backend {
   // use.
   void TrimCache(bool empty);
 
+  // TrimCache() for second-chance ranking mode: entries marked as referenced
+  // get their mark cleared and move back to the head of the list once before
+  // they become eviction candidates again.
+  void TrimCacheSecondChance(bool empty);
+
   // Handles the used storage count.
   void AddStorageSize(int32 bytes);
   void SubstractStorageSize(int32 bytes);
@@ -109,6 +123,7 @@ class NET_EXPORT_PRIVATE MemBackendImpl : public Backend {
   MemRankings rankings_;  // Rankings to be able to trim the cache.
   int32 max_size_;        // Maximum data size for this instance.
   int32 current_size_;
+  bool second_chance_ranking_;  // True when using clock-style eviction.
 
   net::NetLog* net_log_;
 
@@ -0,0 +1,107 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <string>
+#include <vector>
+
+#include "base/test/perf_time_logger.h"
+#include "net/base/io_buffer.h"
+#include "net/base/net_errors.h"
+#include "net/base/test_completion_callback.h"
+#include "net/disk_cache/disk_cache.h"
+#include "net/disk_cache/disk_cache_test_base.h"
+#include "net/disk_cache/disk_cache_test_util.h"
+#include "net/disk_cache/memory/mem_backend_impl.h"
+#include "net/disk_cache/memory/sharded_mem_backend_impl.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+const int kNumEntries = 1000;
+const int kNumHits = 200000;
+const int kDataSize = 1024;
+const int kMaxSize = 32 * 1024 * 1024;
+
+// Populates |cache| with kNumEntries entries of kDataSize bytes each and
+// returns their keys. The memory backends complete synchronously.
+bool PopulateCache(disk_cache::Backend* cache,
+                   std::vector<std::string>* keys) {
+  scoped_refptr<net::IOBuffer> buffer(new net::IOBuffer(kDataSize));
+  CacheTestFillBuffer(buffer->data(), kDataSize, false);
+
+  for (int i = 0; i < kNumEntries; i++) {
+    std::string key = GenerateKey(true);
+
+    disk_cache::Entry* entry;
+    net::TestCompletionCallback cb;
+    int rv = cache->CreateEntry(key, &entry, cb.callback());
+    if (cb.GetResult(rv) != net::OK)
+      return false;
+    if (entry->WriteData(0, 0, buffer.get(), kDataSize,
+                         net::CompletionCallback(), false) != kDataSize) {
+      entry->Close();
+      return false;
+    }
+    entry->Close();
+    keys->push_back(key);
+  }
+  return true;
+}
+
+// Opens kNumHits entries chosen from |keys|, reads a small slice of each
+// (reads are what update the ranking information) and logs the elapsed time
+// under |message|.
+bool TimeHits(disk_cache::Backend* cache,
+              const std::vector<std::string>& keys,
+              const char* message) {
+  const int kReadSize = 256;
+  scoped_refptr<net::IOBuffer> buffer(new net::IOBuffer(kReadSize));
+
+  base::PerfTimeLogger timer(message);
+
+  for (int i = 0; i < kNumHits; i++) {
+    const std::string& key = keys[rand() % keys.size()];
+
+    disk_cache::Entry* entry;
+    net::TestCompletionCallback cb;
+    int rv = cache->OpenEntry(key, &entry, cb.callback());
+    if (cb.GetResult(rv) != net::OK)
+      return false;
+    if (entry->ReadData(0, 0, buffer.get(), kReadSize,
+                        net::CompletionCallback()) != kReadSize) {
+      entry->Close();
+      return false;
+    }
+    entry->Close();
+  }
+
+  timer.Done();
+  return true;
+}
+
+}  // namespace
+
+// Compares cache hit throughput of the single-list memory backend against
+// the sharded second-chance variant.
+TEST_F(DiskCacheTest, MemBackendHitPerformance) {
+  srand(100);
+  scoped_ptr<disk_cache::Backend> cache(
+      disk_cache::MemBackendImpl::CreateBackend(kMaxSize, NULL));
+  ASSERT_TRUE(cache.get());
+
+  std::vector<std::string> keys;
+  ASSERT_TRUE(PopulateCache(cache.get(), &keys));
+  EXPECT_TRUE(TimeHits(cache.get(), keys, "Memory cache hits (LRU list)"));
+}
+
+TEST_F(DiskCacheTest, ShardedMemBackendHitPerformance) {
+  srand(100);
+  scoped_ptr<disk_cache::Backend> cache(
+      disk_cache::ShardedMemBackendImpl::CreateBackend(kMaxSize, 8, NULL));
+  ASSERT_TRUE(cache.get());
+
+  std::vector<std::string> keys;
+  ASSERT_TRUE(PopulateCache(cache.get(), &keys));
+  EXPECT_TRUE(TimeHits(cache.get(), keys, "Memory cache hits (sharded)"));
+}
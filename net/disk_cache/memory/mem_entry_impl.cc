@@ -68,6 +68,7 @@ MemEntryImpl::MemEntryImpl(MemBackendImpl* backend) {
   child_first_pos_ = 0;
   next_ = NULL;
   prev_ = NULL;
+  referenced_ = 0;
   for (int i = 0; i < NUM_STREAMS; i++)
     data_size_[i] = 0;
 }
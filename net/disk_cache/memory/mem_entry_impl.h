@@ -5,6 +5,7 @@
 #ifndef NET_DISK_CACHE_MEMORY_MEM_ENTRY_IMPL_H_
 #define NET_DISK_CACHE_MEMORY_MEM_ENTRY_IMPL_H_
 
+#include "base/atomicops.h"
 #include "base/containers/hash_tables.h"
 #include "base/gtest_prod_util.h"
 #include "base/memory/scoped_ptr.h"
@@ -62,6 +63,16 @@ class MemEntryImpl : public Entry {
   void Open();
   bool InUse();
 
+  // Marks this entry as recently used, or clears the mark. When the backend
+  // runs in second-chance ranking mode, a cache hit only sets this flag
+  // instead of resplicing the ranking list; TrimCache() consumes it.
+  void SetReferenced(bool referenced) {
+    base::subtle::NoBarrier_Store(&referenced_, referenced ? 1 : 0);
+  }
+  bool WasReferenced() const {
+    return base::subtle::NoBarrier_Load(&referenced_) != 0;
+  }
+
   MemEntryImpl* next() const {
     return next_;
   }
@@ -167,6 +178,7 @@ class MemEntryImpl : public Entry {
                               // entry.
   MemEntryImpl* next_;        // Pointers for the LRU list.
   MemEntryImpl* prev_;
+  base::subtle::Atomic32 referenced_;  // Second-chance eviction mark.
   MemEntryImpl* parent_;      // Pointer to the parent entry.
   scoped_ptr<EntryMap> children_;
 
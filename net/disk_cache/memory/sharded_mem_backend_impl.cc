@@ -0,0 +1,183 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/disk_cache/memory/sharded_mem_backend_impl.h"
+
+#include "base/hash.h"
+#include "base/logging.h"
+#include "base/sys_info.h"
+#include "net/base/net_errors.h"
+#include "net/disk_cache/memory/mem_backend_impl.h"
+
+namespace {
+
+const int kDefaultNumShards = 8;
+
+// Mirrors the sizing policy in MemBackendImpl::Init().
+const int kDefaultInMemoryCacheSize = 10 * 1024 * 1024;
+
+int DefaultCacheSize() {
+  int64 total_memory = base::SysInfo::AmountOfPhysicalMemory();
+  if (total_memory <= 0)
+    return kDefaultInMemoryCacheSize;
+
+  // Use up to 2% of the computer's memory, with a limit of 50 MB.
+  total_memory = total_memory * 2 / 100;
+  if (total_memory > kDefaultInMemoryCacheSize * 5)
+    return kDefaultInMemoryCacheSize * 5;
+  return static_cast<int>(total_memory);
+}
+
+}  // namespace
+
+namespace disk_cache {
+
+// Enumeration state: the shard currently being walked and the inner
+// MemBackendImpl iterator position within it.
+struct ShardedMemBackendImpl::ShardedIterator {
+  ShardedIterator() : shard(0), inner(NULL) {}
+
+  size_t shard;
+  void* inner;
+};
+
+ShardedMemBackendImpl::ShardedMemBackendImpl(net::NetLog* net_log,
+                                             int num_shards)
+    : net_log_(net_log) {
+  if (num_shards <= 0)
+    num_shards = kDefaultNumShards;
+  for (int i = 0; i < num_shards; i++) {
+    MemBackendImpl* shard = new MemBackendImpl(net_log);
+    shard->set_second_chance_ranking(true);
+    shards_.push_back(shard);
+  }
+}
+
+ShardedMemBackendImpl::~ShardedMemBackendImpl() {}
+
+// Static.
+scoped_ptr<Backend> ShardedMemBackendImpl::CreateBackend(
+    int max_bytes, int num_shards, net::NetLog* net_log) {
+  scoped_ptr<ShardedMemBackendImpl> cache(
+      new ShardedMemBackendImpl(net_log, num_shards));
+  if (cache->Init(max_bytes))
+    return cache.PassAs<Backend>();
+
+  LOG(ERROR) << "Unable to create sharded memory cache";
+  return scoped_ptr<Backend>();
+}
+
+bool ShardedMemBackendImpl::Init(int max_bytes) {
+  if (max_bytes < 0)
+    return false;
+  if (!max_bytes)
+    max_bytes = DefaultCacheSize();
+
+  // Each shard manages an equal slice of the budget independently; a shard
+  // that exceeds its slice trims only itself.
+  int per_shard = max_bytes / static_cast<int>(shards_.size());
+  if (per_shard < 1)
+    per_shard = 1;
+  for (size_t i = 0; i < shards_.size(); i++) {
+    if (!shards_[i]->SetMaxSize(per_shard) || !shards_[i]->Init())
+      return false;
+  }
+  return true;
+}
+
+net::CacheType ShardedMemBackendImpl::GetCacheType() const {
+  return net::MEMORY_CACHE;
+}
+
+int32 ShardedMemBackendImpl::GetEntryCount() const {
+  int32 count = 0;
+  for (size_t i = 0; i < shards_.size(); i++)
+    count += shards_[i]->GetEntryCount();
+  return count;
+}
+
+int ShardedMemBackendImpl::OpenEntry(const std::string& key, Entry** entry,
+                                     const CompletionCallback& callback) {
+  return ShardForKey(key)->OpenEntry(key, entry, callback);
+}
+
+int ShardedMemBackendImpl::CreateEntry(const std::string& key, Entry** entry,
+                                       const CompletionCallback& callback) {
+  return ShardForKey(key)->CreateEntry(key, entry, callback);
+}
+
+int ShardedMemBackendImpl::DoomEntry(const std::string& key,
+                                     const CompletionCallback& callback) {
+  return ShardForKey(key)->DoomEntry(key, callback);
+}
+
+int ShardedMemBackendImpl::DoomAllEntries(const CompletionCallback& callback) {
+  for (size_t i = 0; i < shards_.size(); i++) {
+    if (shards_[i]->DoomAllEntries(callback) != net::OK)
+      return net::ERR_FAILED;
+  }
+  return net::OK;
+}
+
+int ShardedMemBackendImpl::DoomEntriesBetween(
+    base::Time initial_time,
+    base::Time end_time,
+    const CompletionCallback& callback) {
+  for (size_t i = 0; i < shards_.size(); i++) {
+    if (shards_[i]->DoomEntriesBetween(initial_time, end_time, callback) !=
+        net::OK)
+      return net::ERR_FAILED;
+  }
+  return net::OK;
+}
+
+int ShardedMemBackendImpl::DoomEntriesSince(
+    base::Time initial_time, const CompletionCallback& callback) {
+  for (size_t i = 0; i < shards_.size(); i++) {
+    if (shards_[i]->DoomEntriesSince(initial_time, callback) != net::OK)
+      return net::ERR_FAILED;
+  }
+  return net::OK;
+}
+
+int ShardedMemBackendImpl::OpenNextEntry(void** iter, Entry** next_entry,
+                                         const CompletionCallback& callback) {
+  ShardedIterator* iterator = static_cast<ShardedIterator*>(*iter);
+  if (!iterator) {
+    iterator = new ShardedIterator();
+    *iter = iterator;
+  }
+
+  while (iterator->shard < shards_.size()) {
+    if (shards_[iterator->shard]->OpenNextEntry(&iterator->inner, next_entry,
+                                                callback) == net::OK)
+      return net::OK;
+    shards_[iterator->shard]->EndEnumeration(&iterator->inner);
+    iterator->shard++;
+  }
+
+  EndEnumeration(iter);
+  *next_entry = NULL;
+  return net::ERR_FAILED;
+}
+
+void ShardedMemBackendImpl::EndEnumeration(void** iter) {
+  ShardedIterator* iterator = static_cast<ShardedIterator*>(*iter);
+  if (iterator) {
+    if (iterator->shard < shards_.size())
+      shards_[iterator->shard]->EndEnumeration(&iterator->inner);
+    delete iterator;
+  }
+  *iter = NULL;
+}
+
+void ShardedMemBackendImpl::OnExternalCacheHit(const std::string& key) {
+  ShardForKey(key)->OnExternalCacheHit(key);
+}
+
+MemBackendImpl* ShardedMemBackendImpl::ShardForKey(const std::string& key) {
+  return shards_[base::Hash(key) % shards_.size()];
+}
+
+}  // namespace disk_cache
@@ -0,0 +1,82 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// See net/disk_cache/disk_cache.h for the public interface of the cache.
+
+#ifndef NET_DISK_CACHE_MEMORY_SHARDED_MEM_BACKEND_IMPL_H_
+#define NET_DISK_CACHE_MEMORY_SHARDED_MEM_BACKEND_IMPL_H_
+
+#include "base/compiler_specific.h"
+#include "base/memory/scoped_vector.h"
+#include "net/disk_cache/disk_cache.h"
+
+namespace net {
+class NetLog;
+}  // namespace net
+
+namespace disk_cache {
+
+class MemBackendImpl;
+
+// A memory-only backend that splits the key space over several independent
+// MemBackendImpl shards. Each shard has its own entry map and ranking list
+// and runs in second-chance ranking mode, so a cache hit sets a single flag
+// on the entry instead of resplicing a global LRU list, and no operation
+// walks state shared with unrelated keys. Enumeration proceeds shard by
+// shard, so entries are not returned in global most-recently-used order.
+class NET_EXPORT_PRIVATE ShardedMemBackendImpl : public Backend {
+ public:
+  // A |num_shards| of zero or less selects the default shard count.
+  ShardedMemBackendImpl(net::NetLog* net_log, int num_shards);
+  virtual ~ShardedMemBackendImpl();
+
+  // Returns a sharded in-memory backend whose shards share a total budget of
+  // |max_bytes| (zero means determine the size from the available memory, as
+  // MemBackendImpl does). The returned pointer can be NULL if a fatal error
+  // is found.
+  static scoped_ptr<Backend> CreateBackend(int max_bytes,
+                                           int num_shards,
+                                           net::NetLog* net_log);
+
+  // Performs general initialization for this current instance of the cache.
+  bool Init(int max_bytes);
+
+  // Backend interface.
+  virtual net::CacheType GetCacheType() const OVERRIDE;
+  virtual int32 GetEntryCount() const OVERRIDE;
+  virtual int OpenEntry(const std::string& key, Entry** entry,
+                        const CompletionCallback& callback) OVERRIDE;
+  virtual int CreateEntry(const std::string& key, Entry** entry,
+                          const CompletionCallback& callback) OVERRIDE;
+  virtual int DoomEntry(const std::string& key,
+                        const CompletionCallback& callback) OVERRIDE;
+  virtual int DoomAllEntries(const CompletionCallback& callback) OVERRIDE;
+  virtual int DoomEntriesBetween(base::Time initial_time,
+                                 base::Time end_time,
+                                 const CompletionCallback& callback) OVERRIDE;
+  virtual int DoomEntriesSince(base::Time initial_time,
+                               const CompletionCallback& callback) OVERRIDE;
+  virtual int OpenNextEntry(void** iter, Entry** next_entry,
+                            const CompletionCallback& callback) OVERRIDE;
+  virtual void EndEnumeration(void** iter) OVERRIDE;
+  virtual void GetStats(
+      std::vector<std::pair<std::string, std::string> >* stats) OVERRIDE {}
+  virtual void OnExternalCacheHit(const std::string& key) OVERRIDE;
+
+ private:
+  struct ShardedIterator;
+
+  // Returns the shard responsible for |key|.
+  MemBackendImpl* ShardForKey(const std::string& key);
+
+  ScopedVector<MemBackendImpl> shards_;
+
+  net::NetLog* net_log_;
+
+  DISALLOW_COPY_AND_ASSIGN(ShardedMemBackendImpl);
+};
+
+}  // namespace disk_cache
+
+#endif  // NET_DISK_CACHE_MEMORY_SHARDED_MEM_BACKEND_IMPL_H_
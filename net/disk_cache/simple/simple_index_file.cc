@@ -4,6 +4,7 @@
 
 #include "net/disk_cache/simple/simple_index_file.h"
 
+#include <cstring>
 #include <vector>
 
 #include "base/file_util.h"
@@ -30,6 +31,18 @@ const int kEntryFilesSuffixLength = 2;
 
 const uint64 kMaxEntiresInIndex = 100000000;
 
+// Fixed-layout on-disk record for one cache entry.  The entry table is
+// written as one contiguous array of these, so loading validates a single
+// length and then walks packed records straight out of the mapped index
+// file.  All fields are 8-byte sized or padded below to keep the layout
+// free of implicit (and uninitialized) padding bytes.
+struct FlatIndexRecord {
+  uint64 hash_key;
+  int64 last_used_time;  // base::Time internal value.
+  int64 entry_size;
+};
+COMPILE_ASSERT(sizeof(FlatIndexRecord) == 24, flat_index_record_has_padding);
+
 uint32 CalculatePickleCRC(const Pickle& pickle) {
   return crc32(crc32(0, Z_NULL, 0),
                reinterpret_cast<const Bytef*>(pickle.payload()),
@@ -356,11 +369,20 @@ scoped_ptr<Pickle> SimpleIndexFile::Serialize(
   scoped_ptr<Pickle> pickle(new Pickle(sizeof(SimpleIndexFile::PickleHeader)));
 
   index_metadata.Serialize(pickle.get());
+
+  std::vector<FlatIndexRecord> records;
+  records.reserve(entries.size());
   for (SimpleIndex::EntrySet::const_iterator it = entries.begin();
        it != entries.end(); ++it) {
-    pickle->WriteUInt64(it->first);
-    it->second.Serialize(pickle.get());
+    FlatIndexRecord record;
+    record.hash_key = it->first;
+    record.last_used_time = it->second.GetLastUsedTime().ToInternalValue();
+    record.entry_size = it->second.GetEntrySize();
+    records.push_back(record);
   }
+  pickle->WriteData(
+      records.empty() ? "" : reinterpret_cast<const char*>(&records[0]),
+      records.size() * sizeof(FlatIndexRecord));
   return pickle.Pass();
 }
 
@@ -401,20 +423,28 @@ void SimpleIndexFile::Deserialize(const char* data, int data_len,
     return;
   }
 
+  const char* record_data = NULL;
+  int record_data_len = 0;
+  if (!pickle_it.ReadData(&record_data, &record_data_len) ||
+      static_cast<uint64>(record_data_len) !=
+          index_metadata.GetNumberOfEntries() * sizeof(FlatIndexRecord)) {
+    LOG(WARNING) << "Invalid entry table in Simple Index file.";
+    return;
+  }
+
 #if !defined(OS_WIN)
   // TODO(gavinp): Consider using std::unordered_map.
   entries->resize(index_metadata.GetNumberOfEntries() + kExtraSizeForMerge);
 #endif
-  while (entries->size() < index_metadata.GetNumberOfEntries()) {
-    uint64 hash_key;
-    EntryMetadata entry_metadata;
-    if (!pickle_it.ReadUInt64(&hash_key) ||
-        !entry_metadata.Deserialize(&pickle_it)) {
-      LOG(WARNING) << "Invalid EntryMetadata in Simple Index file.";
-      entries->clear();
-      return;
-    }
-    SimpleIndex::InsertInEntrySet(hash_key, entry_metadata, entries);
+  for (uint64 i = 0; i < index_metadata.GetNumberOfEntries(); ++i) {
+    // The mapped data is only guaranteed to be 4-byte aligned, so copy each
+    // record out rather than aliasing uint64 fields in place.
+    FlatIndexRecord record;
+    memcpy(&record, record_data + i * sizeof(record), sizeof(record));
+    EntryMetadata entry_metadata(
+        base::Time::FromInternalValue(record.last_used_time),
+        static_cast<int>(record.entry_size));
+    SimpleIndex::InsertInEntrySet(record.hash_key, entry_metadata, entries);
   }
 
   int64 cache_last_modified;
@@ -39,12 +39,13 @@ struct NET_EXPORT_PRIVATE SimpleIndexLoadResult {
   bool flush_required;
 };
 
-// Simple Index File format is a pickle serialized data of IndexMetadata and
-// EntryMetadata objects. The file format is as follows: one instance of
-// serialized |IndexMetadata| followed serialized |EntryMetadata| entries
-// repeated |number_of_entries| amount of times. To know more about the format,
-// see SimpleIndexFile::Serialize() and SeeSimpleIndexFile::LoadFromDisk()
-// methods.
+// Simple Index File format is a pickle serialized data of IndexMetadata
+// followed by the entry table: a single contiguous array of fixed-layout
+// records, one per entry, holding the key hash and the entry metadata.  The
+// flat table lets the loader validate one length and walk packed records
+// straight out of the memory-mapped file instead of performing several
+// pickle reads per entry. To know more about the format, see
+// SimpleIndexFile::Serialize() and SimpleIndexFile::LoadFromDisk() methods.
 //
 // The non-static methods must run on the IO thread. All the real
 // work is done in the static methods, which are run on the cache thread
@@ -109,6 +109,11 @@ bool CanOmitEmptyFile(int file_index) {
   return file_index == disk_cache::simple_util::GetFileIndexFromStreamIndex(2);
 }
 
+// Entries whose stream 1 is at most this large have the stream read into
+// memory while the entry is opened, so that the first reads do not have to go
+// back to disk.
+const int kStream1PrefetchSize = 16 * 1024;
+
 }  // namespace
 
 namespace disk_cache {
@@ -286,6 +291,21 @@ void SimpleSynchronousEntry::ReadData(const EntryOperationData& in_entry_op,
   // be handled in the SimpleEntryImpl.
   DCHECK_LT(0, in_entry_op.buf_len);
   DCHECK(!empty_file_omitted_[file_index]);
+  // Stream 1 may have been prefetched while opening the entry; if the copy is
+  // still current, service the read from memory.
+  if (in_entry_op.index == 1 && stream_1_prefetch_data_ &&
+      in_entry_op.offset + in_entry_op.buf_len <=
+          stream_1_prefetch_data_->capacity()) {
+    memcpy(out_buf->data(),
+           stream_1_prefetch_data_->data() + in_entry_op.offset,
+           in_entry_op.buf_len);
+    entry_stat->set_last_used(Time::Now());
+    *out_crc32 = crc32(crc32(0L, Z_NULL, 0),
+                       reinterpret_cast<const Bytef*>(out_buf->data()),
+                       in_entry_op.buf_len);
+    *out_result = in_entry_op.buf_len;
+    return;
+  }
   File* file = const_cast<File*>(&files_[file_index]);
   int bytes_read =
       file->Read(file_offset, out_buf->data(), in_entry_op.buf_len);
@@ -315,6 +335,10 @@ void SimpleSynchronousEntry::WriteData(const EntryOperationData& in_entry_op,
   int buf_len = in_entry_op.buf_len;
   bool truncate = in_entry_op.truncate;
   bool doomed = in_entry_op.doomed;
+  // Once the stream is written to, the prefetched copy of stream 1 no longer
+  // matches the bytes on disk; drop it and fall back to reading from disk.
+  if (index == 1)
+    stream_1_prefetch_data_ = NULL;
   const int64 file_offset = out_entry_stat->GetOffsetInFile(
       key_, in_entry_op.offset, in_entry_op.index);
   bool extending_by_write = offset + buf_len > out_entry_stat->data_size(index);
@@ -950,6 +974,9 @@ int SimpleSynchronousEntry::InitializeForOpen(
           total_data_size, out_entry_stat, stream_0_data, out_stream_0_crc32);
       if (ret_value_stream_0 != net::OK)
         return ret_value_stream_0;
+      if (out_entry_stat->data_size(1) > 0 &&
+          out_entry_stat->data_size(1) <= kStream1PrefetchSize)
+        PrefetchStream1(*out_entry_stat);
     } else {
       out_entry_stat->set_data_size(
           2, GetDataSizeFromKeyAndFileSize(key_, out_entry_stat->data_size(2)));
@@ -989,6 +1016,8 @@ int SimpleSynchronousEntry::InitializeForOpen(
 
   SIMPLE_CACHE_UMA(BOOLEAN, "EntryOpenedAndStream2Removed", cache_type_,
                    removed_stream2);
+  SIMPLE_CACHE_UMA(BOOLEAN, "EntryOpenedAndStream1Prefetched", cache_type_,
+                   stream_1_prefetch_data_ != NULL);
 
   RecordSyncOpenResult(cache_type_, OPEN_ENTRY_SUCCESS, had_index);
   initialized_ = true;
@@ -1098,6 +1127,20 @@ int SimpleSynchronousEntry::ReadAndValidateStream0(
   return net::OK;
 }
 
+void SimpleSynchronousEntry::PrefetchStream1(
+    const SimpleEntryStat& entry_stat) {
+  const int stream_1_size = entry_stat.data_size(1);
+  DCHECK_LT(0, stream_1_size);
+  scoped_refptr<net::GrowableIOBuffer> buffer(new net::GrowableIOBuffer());
+  buffer->SetCapacity(stream_1_size);
+  const int file_offset = entry_stat.GetOffsetInFile(key_, 0, 1);
+  const int bytes_read =
+      files_[0].Read(file_offset, buffer->data(), stream_1_size);
+  if (bytes_read != stream_1_size)
+    return;
+  stream_1_prefetch_data_ = buffer;
+}
+
 int SimpleSynchronousEntry::GetEOFRecordData(int index,
                                              const SimpleEntryStat& entry_stat,
                                              bool* out_has_crc32,
@@ -254,6 +254,12 @@ class SimpleSynchronousEntry {
       scoped_refptr<net::GrowableIOBuffer>* stream_0_data,
       uint32* out_stream_0_crc32) const;
 
+  // Reads the contents of stream 1 into |stream_1_prefetch_data_|. Stream 1
+  // is adjacent to stream 0 in the file, so small streams can be picked up
+  // in the same sequential pass over the file that the open operation already
+  // makes. Failure to prefetch is not an error; readers fall back to disk.
+  void PrefetchStream1(const SimpleEntryStat& entry_stat);
+
   int GetEOFRecordData(int index,
                        const SimpleEntryStat& entry_stat,
                        bool* out_has_crc32,
@@ -322,6 +328,11 @@ class SimpleSynchronousEntry {
   // was created to store it.
   bool empty_file_omitted_[kSimpleEntryFileCount];
 
+  // Holds the contents of stream 1 when they were small enough to be read
+  // while opening the entry. Reads are then serviced from memory rather than
+  // from disk, until the first write to stream 1 invalidates the copy.
+  scoped_refptr<net::GrowableIOBuffer> stream_1_prefetch_data_;
+
   typedef std::map<int64, SparseRange> SparseRangeOffsetMap;
   typedef SparseRangeOffsetMap::iterator SparseRangeIterator;
   SparseRangeOffsetMap sparse_ranges_;
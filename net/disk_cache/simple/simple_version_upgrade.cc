@@ -24,6 +24,7 @@ const uint32 kMinVersionAbleToUpgrade = 5;
 
 const char kFakeIndexFileName[] = "index";
 const char kIndexFileName[] = "the-real-index";
+const char kIndexDirectoryName[] = "index-dir";
 
 void LogMessageFailedUpgradeFromVersion(int version) {
   LOG(ERROR) << "Failed to upgrade Simple Cache from version: " << version;
@@ -107,6 +108,30 @@ bool UpgradeIndexV5V6(const base::FilePath& cache_directory) {
   return true;
 }
 
+// Migrates the cache directory from version 6 to version 7.
+// Returns true iff it succeeds.
+//
+// The V7 index replaces the per-entry pickle fields with one contiguous
+// table of fixed-layout records:
+//   <v7-index> ::= <v6-index-metadata>
+//                  Data(<entry-record>*)
+//                  Int64(<cache-dir-mtime>)
+//   <entry-record> ::= UInt64(<hash-of-the-key>)
+//                      Int64(<entry-last-used-time>)
+//                      Int64(<entry-size-in-bytes>)
+//
+// The entry files are unchanged. As with the V5 -> V6 move, the upgrade
+// simply deletes the old index; the backend then rebuilds it with a one-time
+// directory scan and writes it back in the new format.
+bool UpgradeIndexV6V7(const base::FilePath& cache_directory) {
+  const base::FilePath old_index_file =
+      cache_directory.AppendASCII(kIndexDirectoryName)
+          .AppendASCII(kIndexFileName);
+  if (!base::DeleteFile(old_index_file, /* recursive = */ false))
+    return false;
+  return true;
+}
+
 // Some points about the Upgrade process are still not clear:
 // 1. if the upgrade path requires dropping cache it would be faster to just
 //    return an initialization error here and proceed with asynchronous cache
@@ -170,6 +195,14 @@ bool UpgradeSimpleCacheOnDisk(const base::FilePath& path) {
     }
     version_from++;
   }
+  if (version_from == 6) {
+    // Upgrade only the index for V6 -> V7 move.
+    if (!UpgradeIndexV6V7(path)) {
+      LogMessageFailedUpgradeFromVersion(file_header.version);
+      return false;
+    }
+    version_from++;
+  }
   if (version_from == kSimpleVersion) {
     if (!upgrade_needed) {
       return true;
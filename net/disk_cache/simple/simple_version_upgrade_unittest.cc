@@ -135,6 +135,37 @@ TEST(SimpleVersionUpgradeTest, UpgradeV5V6IndexMustDisappear) {
   }
 }
 
+TEST(SimpleVersionUpgradeTest, UpgradeV6V7IndexMustDisappear) {
+  base::ScopedTempDir cache_dir;
+  ASSERT_TRUE(cache_dir.CreateUniqueTempDir());
+  const base::FilePath cache_path = cache_dir.path();
+
+  // The V6 index lives in a subdirectory.
+  const base::FilePath index_dir = cache_path.AppendASCII("index-dir");
+  ASSERT_TRUE(base::CreateDirectory(index_dir));
+  const std::string file_contents("incorrectly serialized data");
+  const base::FilePath index_file = index_dir.AppendASCII(kIndexFileName);
+  ASSERT_EQ(implicit_cast<int>(file_contents.size()),
+            base::WriteFile(
+                index_file, file_contents.data(), file_contents.size()));
+
+  const std::string entry_contents("entry file data");
+  const base::FilePath entry_file =
+      cache_path.AppendASCII("0000000000000000_0");
+  ASSERT_EQ(implicit_cast<int>(entry_contents.size()),
+            base::WriteFile(
+                entry_file, entry_contents.data(), entry_contents.size()));
+
+  // Upgrade.
+  ASSERT_TRUE(disk_cache::UpgradeIndexV6V7(cache_path));
+
+  // Check that the old index disappeared but the entry file remains.
+  EXPECT_FALSE(base::PathExists(index_file));
+  std::string real_contents;
+  EXPECT_TRUE(base::ReadFileToString(entry_file, &real_contents));
+  EXPECT_EQ(entry_contents, real_contents);
+}
+
 }  // namespace
 
 #endif  // defined(OS_POSIX)
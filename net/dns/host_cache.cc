@@ -7,11 +7,21 @@
 #include "base/logging.h"
 #include "base/metrics/field_trial.h"
 #include "base/metrics/histogram.h"
+#include "base/pickle.h"
 #include "base/strings/string_number_conversions.h"
+#include "net/base/ip_endpoint.h"
 #include "net/base/net_errors.h"
 
 namespace net {
 
+namespace {
+
+// Identifies the on-disk format produced by HostCache::Persist(). Bump when
+// the layout below changes; Restore() rejects anything else.
+const uint32 kPersistMagic = 0x48435031;  // "HCP1"
+
+}  // namespace
+
 //-----------------------------------------------------------------------------
 
 HostCache::Entry::Entry(int error, const AddressList& addrlist,
@@ -81,6 +91,105 @@ const HostCache::EntryMap& HostCache::entries() const {
   return entries_;
 }
 
+void HostCache::Persist(Pickle* pickle, base::TimeTicks now) const {
+  DCHECK(CalledOnValidThread());
+  pickle->WriteUInt32(kPersistMagic);
+
+  uint32 count = 0;
+  for (EntryMap::Iterator it(entries_); it.HasNext(); it.Advance()) {
+    if (it.expiration() > now)
+      ++count;
+  }
+  pickle->WriteUInt32(count);
+
+  // TimeTicks values do not survive a restart, so expirations are stored as
+  // wall-clock times and converted back to a TTL on restore.
+  base::Time wall_now = base::Time::Now();
+  for (EntryMap::Iterator it(entries_); it.HasNext(); it.Advance()) {
+    if (it.expiration() <= now)
+      continue;
+    const Key& key = it.key();
+    pickle->WriteString(key.hostname);
+    pickle->WriteInt(key.address_family);
+    pickle->WriteInt(key.host_resolver_flags);
+    const Entry& entry = it.value();
+    pickle->WriteInt(entry.error);
+    pickle->WriteInt64((wall_now + (it.expiration() - now)).ToInternalValue());
+    pickle->WriteString(entry.addrlist.canonical_name());
+    pickle->WriteUInt32(entry.addrlist.size());
+    for (size_t i = 0; i < entry.addrlist.size(); ++i) {
+      const IPEndPoint& endpoint = entry.addrlist[i];
+      pickle->WriteUInt16(static_cast<uint16>(endpoint.port()));
+      pickle->WriteString(std::string(endpoint.address().begin(),
+                                      endpoint.address().end()));
+    }
+  }
+}
+
+size_t HostCache::Restore(const Pickle& pickle, base::TimeTicks now) {
+  DCHECK(CalledOnValidThread());
+  if (caching_is_disabled())
+    return 0;
+
+  PickleIterator iter(pickle);
+  uint32 magic = 0;
+  uint32 count = 0;
+  if (!pickle.ReadUInt32(&iter, &magic) || magic != kPersistMagic ||
+      !pickle.ReadUInt32(&iter, &count)) {
+    return 0;
+  }
+
+  base::Time wall_now = base::Time::Now();
+  size_t restored = 0;
+  for (uint32 i = 0; i < count; ++i) {
+    std::string hostname;
+    int address_family = 0;
+    int host_resolver_flags = 0;
+    int error = 0;
+    int64 expiration = 0;
+    std::string canonical_name;
+    uint32 num_addresses = 0;
+    if (!pickle.ReadString(&iter, &hostname) ||
+        !pickle.ReadInt(&iter, &address_family) ||
+        !pickle.ReadInt(&iter, &host_resolver_flags) ||
+        !pickle.ReadInt(&iter, &error) ||
+        !pickle.ReadInt64(&iter, &expiration) ||
+        !pickle.ReadString(&iter, &canonical_name) ||
+        !pickle.ReadUInt32(&iter, &num_addresses)) {
+      return restored;  // Truncated or corrupt; keep what we have so far.
+    }
+    AddressList addrlist;
+    addrlist.set_canonical_name(canonical_name);
+    bool addresses_ok = true;
+    for (uint32 j = 0; j < num_addresses; ++j) {
+      uint16 port = 0;
+      std::string address;
+      if (!pickle.ReadUInt16(&iter, &port) ||
+          !pickle.ReadString(&iter, &address)) {
+        return restored;
+      }
+      if (address.size() != kIPv4AddressSize &&
+          address.size() != kIPv6AddressSize) {
+        addresses_ok = false;
+        continue;
+      }
+      addrlist.push_back(
+          IPEndPoint(IPAddressNumber(address.begin(), address.end()), port));
+    }
+    base::TimeDelta ttl = base::Time::FromInternalValue(expiration) - wall_now;
+    if (!addresses_ok || ttl <= base::TimeDelta())
+      continue;
+    Key key(hostname, static_cast<AddressFamily>(address_family),
+            host_resolver_flags);
+    // Entries resolved in this session win over persisted ones.
+    if (entries_.Get(key, now))
+      continue;
+    Set(key, Entry(error, addrlist, ttl), now, ttl);
+    ++restored;
+  }
+  return restored;
+}
+
 // static
 scoped_ptr<HostCache> HostCache::CreateDefaultCache() {
   // Cache capacity is determined by the field trial.
@@ -17,6 +17,8 @@
 #include "net/base/expiring_cache.h"
 #include "net/base/net_export.h"
 
+class Pickle;
+
 namespace net {
 
 // Cache used by HostResolver to map hostnames to their resolved result.
@@ -101,6 +103,16 @@ class NET_EXPORT HostCache : NON_EXPORTED_BASE(public base::NonThreadSafe) {
 
   const EntryMap& entries() const;
 
+  // Serializes all entries still valid at |now| into |pickle|. Expiration
+  // times are converted to wall-clock time so that the result survives a
+  // restart; see Restore().
+  void Persist(Pickle* pickle, base::TimeTicks now) const;
+
+  // Restores entries previously written by Persist(). Entries whose
+  // wall-clock expiration has passed, and keys already present in the cache,
+  // are skipped. Returns the number of entries restored.
+  size_t Restore(const Pickle& pickle, base::TimeTicks now);
+
   // Creates a default cache.
   static scoped_ptr<HostCache> CreateDefaultCache();
 
@@ -0,0 +1,40 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/dns/host_cache_persister.h"
+
+#include <string>
+
+#include "base/files/file_path.h"
+#include "base/files/important_file_writer.h"
+#include "base/files/memory_mapped_file.h"
+#include "base/pickle.h"
+#include "base/time/time.h"
+#include "net/dns/host_cache.h"
+
+namespace net {
+
+// static
+bool HostCachePersister::SaveToFile(const base::FilePath& path,
+                                    const HostCache& cache) {
+  Pickle pickle;
+  cache.Persist(&pickle, base::TimeTicks::Now());
+  return base::ImportantFileWriter::WriteFileAtomically(
+      path,
+      std::string(static_cast<const char*>(pickle.data()), pickle.size()));
+}
+
+// static
+bool HostCachePersister::LoadFromFile(const base::FilePath& path,
+                                      HostCache* cache) {
+  base::MemoryMappedFile file;
+  if (!file.Initialize(path) || !file.IsValid())
+    return false;
+  Pickle pickle(reinterpret_cast<const char*>(file.data()),
+                static_cast<int>(file.length()));
+  cache->Restore(pickle, base::TimeTicks::Now());
+  return true;
+}
+
+}  // namespace net
@@ -0,0 +1,40 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_DNS_HOST_CACHE_PERSISTER_H_
+#define NET_DNS_HOST_CACHE_PERSISTER_H_
+
+#include "net/base/net_export.h"
+
+namespace base {
+class FilePath;
+}
+
+namespace net {
+
+class HostCache;
+
+// Checkpoints a HostCache to disk and restores it after a restart, so that
+// the first navigations of a session can skip resolution for hosts whose
+// entries are still within their TTL. The on-disk format is the compact
+// pickle produced by HostCache::Persist(); loading maps the file read-only
+// rather than streaming it in.
+class NET_EXPORT HostCachePersister {
+ public:
+  // Writes all unexpired entries of |cache| to |path| atomically. Returns
+  // false if serialization or the write failed.
+  static bool SaveToFile(const base::FilePath& path, const HostCache& cache);
+
+  // Restores entries from |path| into |cache|, skipping expired entries and
+  // keys the cache already holds. Returns false if the file is missing or
+  // unreadable; a readable file that yields no entries still returns true.
+  static bool LoadFromFile(const base::FilePath& path, HostCache* cache);
+
+ private:
+  HostCachePersister();  // Not instantiable.
+};
+
+}  // namespace net
+
+#endif  // NET_DNS_HOST_CACHE_PERSISTER_H_
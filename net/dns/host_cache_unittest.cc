@@ -5,6 +5,7 @@
 #include "net/dns/host_cache.h"
 
 #include "base/format_macros.h"
+#include "base/pickle.h"
 #include "base/stl_util.h"
 #include "base/strings/string_util.h"
 #include "base/strings/stringprintf.h"
@@ -385,4 +386,50 @@ TEST(HostCacheTest, KeyComparators) {
   }
 }
 
+TEST(HostCacheTest, PersistRestoreRoundtrip) {
+  const base::TimeDelta kTTL = base::TimeDelta::FromSeconds(10);
+
+  base::TimeTicks now;
+  HostCache cache(kMaxCacheEntries);
+
+  IPAddressNumber address(kIPv4AddressSize, 0);
+  address[0] = 127;
+  address[3] = 1;
+  AddressList addrlist;
+  addrlist.push_back(IPEndPoint(address, 80));
+
+  cache.Set(Key("live.com"), HostCache::Entry(OK, addrlist), now, kTTL);
+  // Expired entries must not be persisted.
+  cache.Set(Key("dead.com"), HostCache::Entry(OK, addrlist), now,
+            base::TimeDelta());
+
+  now += base::TimeDelta::FromSeconds(1);
+
+  Pickle pickle;
+  cache.Persist(&pickle, now);
+
+  HostCache restored(kMaxCacheEntries);
+  EXPECT_EQ(1u, restored.Restore(pickle, now));
+  EXPECT_EQ(1U, restored.size());
+
+  const HostCache::Entry* entry = restored.Lookup(Key("live.com"), now);
+  ASSERT_TRUE(entry);
+  EXPECT_EQ(OK, entry->error);
+  ASSERT_EQ(1U, entry->addrlist.size());
+  EXPECT_EQ(address, entry->addrlist[0].address());
+  EXPECT_EQ(80, entry->addrlist[0].port());
+  EXPECT_FALSE(restored.Lookup(Key("dead.com"), now));
+
+  // Restoring on top of an existing entry must not overwrite it.
+  HostCache occupied(kMaxCacheEntries);
+  occupied.Set(Key("live.com"), HostCache::Entry(OK, AddressList()), now,
+               kTTL);
+  EXPECT_EQ(0u, occupied.Restore(pickle, now));
+
+  // Garbage input is rejected without crashing.
+  Pickle garbage;
+  garbage.WriteString("not a host cache");
+  EXPECT_EQ(0u, restored.Restore(garbage, now));
+}
+
 }  // namespace net
@@ -7,6 +7,7 @@
 
 #include <string>
 
+#include "base/files/file_path.h"
 #include "base/memory/scoped_ptr.h"
 #include "net/base/address_family.h"
 #include "net/base/completion_callback.h"
@@ -54,6 +55,17 @@ class NET_EXPORT HostResolver {
     size_t max_concurrent_resolves;
     size_t max_retry_attempts;
     bool enable_caching;
+
+    // When true, same-priority proc jobs are fanned out across a dedicated
+    // resolver thread pool sized to the core count, and the dispatcher limit
+    // is raised accordingly, instead of trickling through the shared worker
+    // pool. Improves fan-out-heavy page loads at the cost of extra threads.
+    bool enable_batched_resolution;
+
+    // If non-empty and caching is enabled, still-valid entries persisted at
+    // this path are restored into the cache at construction time. See
+    // HostCachePersister.
+    base::FilePath cache_persistence_path;
   };
 
   // The parameters for doing a Resolve(). A hostname and port are
@@ -10,6 +10,7 @@
 #include <netdb.h>
 #endif
 
+#include <algorithm>
 #include <cmath>
 #include <utility>
 #include <vector>
@@ -27,6 +28,8 @@
 #include "base/stl_util.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/sys_info.h"
+#include "base/threading/sequenced_worker_pool.h"
 #include "base/threading/worker_pool.h"
 #include "base/time/time.h"
 #include "base/values.h"
@@ -44,6 +47,7 @@
 #include "net/dns/dns_protocol.h"
 #include "net/dns/dns_response.h"
 #include "net/dns/dns_transaction.h"
+#include "net/dns/host_cache_persister.h"
 #include "net/dns/host_resolver_proc.h"
 #include "net/socket/client_socket_factory.h"
 #include "net/udp/datagram_client_socket.h"
@@ -69,6 +73,26 @@ const unsigned kNegativeCacheEntryTTLSeconds = 0;
 // Minimum TTL for successful resolutions with DnsTask.
 const unsigned kMinimumTTLSeconds = kCacheEntryTTLSeconds;
 
+// Completion callback for PrewarmHostCache() resolutions; the results are
+// only interesting as cache side effects.
+void OnPrewarmResolveComplete(AddressList* addresses, int error) {
+}
+
+// Worker pool used for lookup attempts when batched resolution is enabled.
+// Sized to the core count so that a fan-out of same-priority jobs resolves
+// in parallel rather than queuing behind the shared WorkerPool. Created on
+// first use, on the origin loop only, and intentionally leaked.
+base::SequencedWorkerPool* GetDedicatedResolverPool() {
+  static base::SequencedWorkerPool* pool = NULL;
+  if (!pool) {
+    size_t max_threads = static_cast<size_t>(
+        std::max(2, base::SysInfo::NumberOfProcessors()));
+    pool = new base::SequencedWorkerPool(max_threads, "HostResolver");
+    pool->AddRef();  // Leaked.
+  }
+  return pool;
+}
+
 // We use a separate histogram name for each platform to facilitate the
 // display of error codes by their symbolic name (since each platform has
 // different mappings).
@@ -628,10 +652,14 @@ class HostResolverImpl::ProcTask
     base::TimeTicks start_time = base::TimeTicks::Now();
     ++attempt_number_;
     // Dispatch the lookup attempt to a worker thread.
-    if (!base::WorkerPool::PostTask(
-            FROM_HERE,
-            base::Bind(&ProcTask::DoLookup, this, start_time, attempt_number_),
-            true)) {
+    base::Closure attempt =
+        base::Bind(&ProcTask::DoLookup, this, start_time, attempt_number_);
+    bool posted = params_.use_dedicated_pool
+        ? GetDedicatedResolverPool()->PostWorkerTaskWithShutdownBehavior(
+              FROM_HERE, attempt,
+              base::SequencedWorkerPool::CONTINUE_ON_SHUTDOWN)
+        : base::WorkerPool::PostTask(FROM_HERE, attempt, true);
+    if (!posted) {
       NOTREACHED();
 
       // Since we could be running within Resolve() right now, we can't just
@@ -1782,7 +1810,8 @@ HostResolverImpl::ProcTaskParams::ProcTaskParams(
     : resolver_proc(resolver_proc),
       max_retry_attempts(max_retry_attempts),
       unresponsive_delay(base::TimeDelta::FromMilliseconds(6000)),
-      retry_factor(2) {
+      retry_factor(2),
+      use_dedicated_pool(false) {
   // Maximum of 4 retry attempts for host resolution.
   static const size_t kDefaultMaxRetryAttempts = 4u;
   if (max_retry_attempts == HostResolver::kDefaultRetryAttempts)
@@ -1805,10 +1834,22 @@ HostResolverImpl::HostResolverImpl(const Options& options, NetLog* net_log)
       fallback_to_proctask_(true),
       weak_ptr_factory_(this),
       probe_weak_ptr_factory_(this) {
-  if (options.enable_caching)
+  if (options.enable_caching) {
     cache_ = HostCache::CreateDefaultCache();
+    cache_persistence_path_ = options.cache_persistence_path;
+    if (!cache_persistence_path_.empty())
+      HostCachePersister::LoadFromFile(cache_persistence_path_, cache_.get());
+  }
 
   PrioritizedDispatcher::Limits job_limits = options.GetDispatcherLimits();
+  if (options.enable_batched_resolution) {
+    proc_params_.use_dedicated_pool = true;
+    // The dedicated pool can run one attempt per core; let the dispatcher
+    // hand it that many jobs at once.
+    job_limits.total_jobs = std::max(
+        job_limits.total_jobs,
+        static_cast<size_t>(base::SysInfo::NumberOfProcessors()));
+  }
   dispatcher_.reset(new PrioritizedDispatcher(job_limits));
   max_queued_jobs_ = job_limits.total_jobs * 100u;
 
@@ -2004,6 +2045,30 @@ HostCache* HostResolverImpl::GetHostCache() {
   return cache_.get();
 }
 
+void HostResolverImpl::PersistHostCacheToDisk() {
+  DCHECK(CalledOnValidThread());
+  if (!cache_.get() || cache_persistence_path_.empty())
+    return;
+  HostCachePersister::SaveToFile(cache_persistence_path_, *cache_);
+}
+
+void HostResolverImpl::PrewarmHostCache(
+    const std::vector<std::string>& hostnames) {
+  DCHECK(CalledOnValidThread());
+  for (size_t i = 0; i < hostnames.size(); ++i) {
+    RequestInfo info(HostPortPair(hostnames[i], 80));
+    info.set_is_speculative(true);
+    // The callback owns the result so an asynchronous completion has
+    // somewhere to write; the addresses themselves are only wanted in the
+    // cache. Synchronous results (cached or IP literals) destroy the unrun
+    // callback, which frees the list.
+    AddressList* addresses = new AddressList;
+    Resolve(info, IDLE, addresses,
+            base::Bind(&OnPrewarmResolveComplete, base::Owned(addresses)),
+            NULL, BoundNetLog());
+  }
+}
+
 base::Value* HostResolverImpl::GetDnsConfigAsValue() const {
   // Check if async DNS is disabled.
   if (!dns_client_.get())
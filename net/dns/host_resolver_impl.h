@@ -6,8 +6,11 @@
 #define NET_DNS_HOST_RESOLVER_IMPL_H_
 
 #include <map>
+#include <string>
+#include <vector>
 
 #include "base/basictypes.h"
+#include "base/files/file_path.h"
 #include "base/gtest_prod_util.h"
 #include "base/memory/scoped_ptr.h"
 #include "base/memory/scoped_vector.h"
@@ -94,6 +97,12 @@ class NET_EXPORT HostResolverImpl
 
     // Factor to grow |unresponsive_delay| when we re-re-try.
     uint32 retry_factor;
+
+    // When true, lookup attempts run on a dedicated resolver pool sized to
+    // the number of cores instead of the shared WorkerPool, so that a page
+    // fanning out to many hosts resolves them in parallel. The attempt and
+    // retry machinery above is unchanged.
+    bool use_dedicated_pool;
   };
 
   // Creates a HostResolver as specified by |options|.
@@ -140,6 +149,17 @@ class NET_EXPORT HostResolverImpl
   virtual HostCache* GetHostCache() OVERRIDE;
   virtual base::Value* GetDnsConfigAsValue() const OVERRIDE;
 
+  // Writes the current cache contents to Options.cache_persistence_path.
+  // No-op when caching is disabled or no path was configured. Typically
+  // called at shutdown and periodically by the embedder.
+  void PersistHostCacheToDisk();
+
+  // Issues low-priority speculative resolutions for |hostnames| so that the
+  // cache is warm before the first real navigation. Results (and failures)
+  // land in the cache through the normal job machinery; completions are
+  // ignored.
+  void PrewarmHostCache(const std::vector<std::string>& hostnames);
+
   void set_proc_params_for_test(const ProcTaskParams& proc_params) {
     proc_params_ = proc_params;
   }
@@ -242,6 +262,10 @@ class NET_EXPORT HostResolverImpl
   // Cache of host resolution results.
   scoped_ptr<HostCache> cache_;
 
+  // Where PersistHostCacheToDisk() checkpoints |cache_|; empty if
+  // persistence is disabled.
+  base::FilePath cache_persistence_path_;
+
   // Map from HostCache::Key to a Job.
   JobMap jobs_;
 
@@ -0,0 +1,129 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/dns/host_resolver_impl.h"
+
+#include <string>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/format_macros.h"
+#include "base/message_loop/message_loop.h"
+#include "base/strings/stringprintf.h"
+#include "base/test/perf_time_logger.h"
+#include "base/threading/platform_thread.h"
+#include "base/time/time.h"
+#include "net/base/address_list.h"
+#include "net/base/host_port_pair.h"
+#include "net/base/net_errors.h"
+#include "net/base/net_log.h"
+#include "net/base/net_util.h"
+#include "net/base/request_priority.h"
+#include "net/dns/host_resolver_proc.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace net {
+
+namespace {
+
+// Number of hostnames resolved per trial; matches a fan-out-heavy page load.
+const size_t kNumHostnames = 64;
+
+// Simulated getaddrinfo latency, so that parallelism rather than loop
+// overhead dominates the measurement.
+const int kFakeLookupLatencyMs = 2;
+
+class FakeHostResolverProc : public HostResolverProc {
+ public:
+  FakeHostResolverProc() : HostResolverProc(NULL) {}
+
+  virtual int Resolve(const std::string& host,
+                      AddressFamily address_family,
+                      HostResolverFlags host_resolver_flags,
+                      AddressList* addrlist,
+                      int* os_error) OVERRIDE {
+    base::PlatformThread::Sleep(
+        base::TimeDelta::FromMilliseconds(kFakeLookupLatencyMs));
+    IPAddressNumber address(kIPv4AddressSize, 0);
+    address[0] = 127;
+    address[3] = 1;
+    *addrlist = AddressList::CreateFromIPAddress(address, 80);
+    return OK;
+  }
+
+ private:
+  virtual ~FakeHostResolverProc() {}
+};
+
+// Counts completions and quits the loop once all resolutions are done.
+class ResolutionWaiter {
+ public:
+  explicit ResolutionWaiter(size_t expected)
+      : expected_(expected), completed_(0) {}
+
+  CompletionCallback MakeCallback() {
+    return base::Bind(&ResolutionWaiter::OnComplete, base::Unretained(this));
+  }
+
+  void OnComplete(int error) {
+    if (++completed_ == expected_)
+      base::MessageLoop::current()->Quit();
+  }
+
+  void Wait() {
+    if (completed_ < expected_)
+      base::MessageLoop::current()->Run();
+  }
+
+ private:
+  size_t expected_;
+  size_t completed_;
+};
+
+void RunFanOutTrial(bool batched, const char* trial_name) {
+  HostResolver::Options options;
+  options.enable_caching = false;
+  options.enable_batched_resolution = batched;
+  HostResolverImpl resolver(options, NULL);
+
+  HostResolverImpl::ProcTaskParams params(new FakeHostResolverProc(),
+                                          HostResolver::kDefaultRetryAttempts);
+  params.use_dedicated_pool = batched;
+  resolver.set_proc_params_for_test(params);
+
+  std::vector<AddressList> addresses(kNumHostnames);
+  ResolutionWaiter waiter(kNumHostnames);
+
+  base::TimeTicks start = base::TimeTicks::Now();
+  base::PerfTimeLogger timer(trial_name);
+  for (size_t i = 0; i < kNumHostnames; ++i) {
+    HostResolver::RequestInfo info(
+        HostPortPair(base::StringPrintf("host%" PRIuS ".example", i), 80));
+    int rv = resolver.Resolve(info, MEDIUM, &addresses[i],
+                              waiter.MakeCallback(), NULL, BoundNetLog());
+    if (rv != ERR_IO_PENDING)
+      waiter.OnComplete(rv);
+  }
+  waiter.Wait();
+  timer.Done();
+
+  double elapsed = (base::TimeTicks::Now() - start).InSecondsF();
+  LOG(INFO) << trial_name << ": "
+            << static_cast<int>(kNumHostnames / elapsed)
+            << " resolutions/sec";
+}
+
+TEST(HostResolverImplPerfTest, FanOutDefault) {
+  base::MessageLoopForIO message_loop;
+  RunFanOutTrial(false, "host_resolve_fanout_default");
+}
+
+TEST(HostResolverImplPerfTest, FanOutBatched) {
+  base::MessageLoopForIO message_loop;
+  RunFanOutTrial(true, "host_resolve_fanout_batched");
+}
+
+}  // namespace
+
+}  // namespace net
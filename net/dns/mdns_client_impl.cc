@@ -216,7 +216,9 @@ void MDnsClientImpl::Core::HandlePacket(DnsResponse* response,
 
   for (unsigned i = 0; i < answer_count; i++) {
     offset = parser.GetOffset();
-    scoped_ptr<const RecordParsed> record = RecordParsed::CreateFrom(
+    // Parse in view mode first: records rejected by the cheap checks below
+    // then never pay for parsing their rdata into a data structure.
+    scoped_ptr<const RecordParsed> record = RecordParsed::CreateViewFrom(
         &parser, base::Time::Now());
 
     if (!record) {
@@ -236,6 +238,14 @@ void MDnsClientImpl::Core::HandlePacket(DnsResponse* response,
       continue;  // Ignore all records not in the IN class.
     }
 
+    // The record is about to be retained in the cache, so parse its rdata
+    // into owned storage, detaching it from the response buffer.
+    record = record->Materialize();
+    if (!record) {
+      DVLOG(1) << "Could not understand an mDNS record.";
+      continue;  // We may be able to extract other records from the packet.
+    }
+
     MDnsCache::Key update_key = MDnsCache::Key::CreateFor(record.get());
     MDnsCache::UpdateType update = cache_.UpdateDnsRecord(record.Pass());
 
@@ -17,6 +17,14 @@ RecordParsed::RecordParsed(const std::string& name, uint16 type, uint16 klass,
       time_created_(time_created) {
 }
 
+RecordParsed::RecordParsed(const std::string& name, uint16 type, uint16 klass,
+                           uint32 ttl, const base::StringPiece& rdata,
+                           const DnsRecordParser& parser,
+                           base::Time time_created)
+    : name_(name), type_(type), klass_(klass), ttl_(ttl), raw_rdata_(rdata),
+      parser_(parser), time_created_(time_created) {
+}
+
 RecordParsed::~RecordParsed() {
 }
 
@@ -25,38 +33,12 @@ scoped_ptr<const RecordParsed> RecordParsed::CreateFrom(
     DnsRecordParser* parser,
     base::Time time_created) {
   DnsResourceRecord record;
-  scoped_ptr<const RecordRdata> rdata;
 
   if (!parser->ReadRecord(&record))
     return scoped_ptr<const RecordParsed>();
 
-  switch (record.type) {
-    case ARecordRdata::kType:
-      rdata = ARecordRdata::Create(record.rdata, *parser);
-      break;
-    case AAAARecordRdata::kType:
-      rdata = AAAARecordRdata::Create(record.rdata, *parser);
-      break;
-    case CnameRecordRdata::kType:
-      rdata = CnameRecordRdata::Create(record.rdata, *parser);
-      break;
-    case PtrRecordRdata::kType:
-      rdata = PtrRecordRdata::Create(record.rdata, *parser);
-      break;
-    case SrvRecordRdata::kType:
-      rdata = SrvRecordRdata::Create(record.rdata, *parser);
-      break;
-    case TxtRecordRdata::kType:
-      rdata = TxtRecordRdata::Create(record.rdata, *parser);
-      break;
-    case NsecRecordRdata::kType:
-      rdata = NsecRecordRdata::Create(record.rdata, *parser);
-      break;
-    default:
-      DVLOG(1) << "Unknown RData type for received record: " << record.type;
-      return scoped_ptr<const RecordParsed>();
-  }
-
+  scoped_ptr<const RecordRdata> rdata =
+      ParseRdata(record.type, record.rdata, *parser);
   if (!rdata.get())
     return scoped_ptr<const RecordParsed>();
 
@@ -68,8 +50,70 @@ scoped_ptr<const RecordParsed> RecordParsed::CreateFrom(
                                                          time_created));
 }
 
+// static
+scoped_ptr<const RecordParsed> RecordParsed::CreateViewFrom(
+    DnsRecordParser* parser,
+    base::Time time_created) {
+  DnsResourceRecord record;
+
+  if (!parser->ReadRecord(&record))
+    return scoped_ptr<const RecordParsed>();
+
+  return scoped_ptr<const RecordParsed>(new RecordParsed(record.name,
+                                                         record.type,
+                                                         record.klass,
+                                                         record.ttl,
+                                                         record.rdata,
+                                                         *parser,
+                                                         time_created));
+}
+
+scoped_ptr<const RecordParsed> RecordParsed::Materialize() const {
+  DCHECK(!IsMaterialized());
+
+  scoped_ptr<const RecordRdata> rdata = ParseRdata(type_, raw_rdata_, parser_);
+  if (!rdata.get())
+    return scoped_ptr<const RecordParsed>();
+
+  return scoped_ptr<const RecordParsed>(new RecordParsed(name_,
+                                                         type_,
+                                                         klass_,
+                                                         ttl_,
+                                                         rdata.Pass(),
+                                                         time_created_));
+}
+
+// static
+scoped_ptr<const RecordRdata> RecordParsed::ParseRdata(
+    uint16 type,
+    const base::StringPiece& rdata,
+    const DnsRecordParser& parser) {
+  switch (type) {
+    case ARecordRdata::kType:
+      return ARecordRdata::Create(rdata, parser).PassAs<const RecordRdata>();
+    case AAAARecordRdata::kType:
+      return AAAARecordRdata::Create(rdata, parser).PassAs<const RecordRdata>();
+    case CnameRecordRdata::kType:
+      return CnameRecordRdata::Create(rdata, parser)
+          .PassAs<const RecordRdata>();
+    case PtrRecordRdata::kType:
+      return PtrRecordRdata::Create(rdata, parser).PassAs<const RecordRdata>();
+    case SrvRecordRdata::kType:
+      return SrvRecordRdata::Create(rdata, parser).PassAs<const RecordRdata>();
+    case TxtRecordRdata::kType:
+      return TxtRecordRdata::Create(rdata, parser).PassAs<const RecordRdata>();
+    case NsecRecordRdata::kType:
+      return NsecRecordRdata::Create(rdata, parser).PassAs<const RecordRdata>();
+    default:
+      DVLOG(1) << "Unknown RData type for received record: " << type;
+      return scoped_ptr<const RecordRdata>();
+  }
+}
+
 bool RecordParsed::IsEqual(const RecordParsed* other, bool is_mdns) const {
   DCHECK(other);
+  DCHECK(rdata_.get());
+  DCHECK(other->rdata_.get());
   uint16 klass = klass_;
   uint16 other_klass = other->klass_;
 
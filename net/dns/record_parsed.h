@@ -8,12 +8,13 @@
 #include <string>
 
 #include "base/memory/scoped_ptr.h"
+#include "base/strings/string_piece.h"
 #include "base/time/time.h"
 #include "net/base/net_export.h"
+#include "net/dns/dns_response.h"
 
 namespace net {
 
-class DnsRecordParser;
 class RecordRdata;
 
 // Parsed record. This is a form of DnsResourceRecord where the rdata section
@@ -26,6 +27,16 @@ class NET_EXPORT_PRIVATE RecordParsed {
   static scoped_ptr<const RecordParsed> CreateFrom(DnsRecordParser* parser,
                                                    base::Time time_created);
 
+  // Like CreateFrom, but leaves the rdata section unparsed: the raw rdata is
+  // kept as a StringPiece aliasing the response buffer instead of being
+  // copied into a data structure, so no rdata allocations are made. The
+  // returned record is only usable while the response buffer is alive, and
+  // rdata<T>() returns NULL for it. Consumers that want to examine the rdata
+  // or retain the record must call Materialize() first.
+  static scoped_ptr<const RecordParsed> CreateViewFrom(
+      DnsRecordParser* parser,
+      base::Time time_created);
+
   const std::string& name() const { return name_; }
   uint16 type() const { return type_; }
   uint16 klass() const { return klass_; }
@@ -33,6 +44,15 @@ class NET_EXPORT_PRIVATE RecordParsed {
 
   base::Time time_created() const { return time_created_; }
 
+  // Whether the rdata has been parsed into an owned data structure. Only
+  // false for records created with CreateViewFrom.
+  bool IsMaterialized() const { return rdata_.get() != NULL; }
+
+  // For a record created with CreateViewFrom, parses the rdata into an owned
+  // data structure, detaching the result from the response buffer. Returns
+  // NULL if the rdata is malformed or of an unknown type.
+  scoped_ptr<const RecordParsed> Materialize() const;
+
   template <class T> const T* rdata() const {
     if (T::kType != type_)
       return NULL;
@@ -42,6 +62,7 @@ class NET_EXPORT_PRIVATE RecordParsed {
   // Check if two records have the same data. Ignores time_created and ttl.
   // If |is_mdns| is true, ignore the top bit of the class
   // (the cache flush bit).
+  // Both records must be materialized.
   bool IsEqual(const RecordParsed* other, bool is_mdns) const;
 
  private:
@@ -49,6 +70,21 @@ class NET_EXPORT_PRIVATE RecordParsed {
                uint32 ttl, scoped_ptr<const RecordRdata> rdata,
                base::Time time_created);
 
+  // View form (see CreateViewFrom). Keeps the raw |rdata| aliasing the
+  // response buffer, along with a copy of |parser| so the rdata can be
+  // materialized later (names within it may be compressed and point
+  // elsewhere in the packet).
+  RecordParsed(const std::string& name, uint16 type, uint16 klass,
+               uint32 ttl, const base::StringPiece& rdata,
+               const DnsRecordParser& parser, base::Time time_created);
+
+  // Parses |rdata| into a data structure according to |type|. Returns NULL
+  // if the rdata is malformed or |type| is unknown.
+  static scoped_ptr<const RecordRdata> ParseRdata(
+      uint16 type,
+      const base::StringPiece& rdata,
+      const DnsRecordParser& parser);
+
   std::string name_;  // in dotted form
   const uint16 type_;
   const uint16 klass_;
@@ -56,6 +92,10 @@ class NET_EXPORT_PRIVATE RecordParsed {
 
   const scoped_ptr<const RecordRdata> rdata_;
 
+  // Only set for records created with CreateViewFrom.
+  const base::StringPiece raw_rdata_;
+  const DnsRecordParser parser_;
+
   const base::Time time_created_;
 };
 
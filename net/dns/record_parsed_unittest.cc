@@ -52,6 +52,38 @@ TEST(RecordParsedTest, ParseSingleRecord) {
   ASSERT_TRUE(record->IsEqual(record.get(), true));
 }
 
+TEST(RecordParsedTest, ViewParseAndMaterialize) {
+  DnsRecordParser parser(kT1ResponseDatagram, sizeof(kT1ResponseDatagram),
+                         sizeof(dns_protocol::Header));
+  parser.SkipQuestion();
+
+  scoped_ptr<const RecordParsed> view =
+      RecordParsed::CreateViewFrom(&parser, base::Time());
+  ASSERT_TRUE(view != NULL);
+
+  // The generic fields are available, but the rdata is left unparsed.
+  EXPECT_EQ("codereview.chromium.org", view->name());
+  EXPECT_EQ(dns_protocol::kTypeCNAME, view->type());
+  EXPECT_EQ(dns_protocol::kClassIN, view->klass());
+  EXPECT_FALSE(view->IsMaterialized());
+  EXPECT_FALSE(view->rdata<CnameRecordRdata>());
+
+  scoped_ptr<const RecordParsed> record = view->Materialize();
+  ASSERT_TRUE(record != NULL);
+  EXPECT_TRUE(record->IsMaterialized());
+
+  const CnameRecordRdata* rdata = record->rdata<CnameRecordRdata>();
+  ASSERT_TRUE(rdata != NULL);
+  EXPECT_EQ(kT1CanonName, rdata->cname());
+
+  DnsRecordParser parser2(kT1ResponseDatagram, sizeof(kT1ResponseDatagram),
+                          sizeof(dns_protocol::Header));
+  parser2.SkipQuestion();
+  scoped_ptr<const RecordParsed> expected =
+      RecordParsed::CreateFrom(&parser2, base::Time());
+  EXPECT_TRUE(record->IsEqual(expected.get(), true));
+}
+
 TEST(RecordParsedTest, CacheFlushBitCompare) {
   DnsRecordParser parser1(kT1ResponseDatagram, sizeof(kT1ResponseDatagram),
                          sizeof(dns_protocol::Header));
@@ -394,7 +394,7 @@ Filter* Filter::PrependNewFilter(FilterType type_id,
 void Filter::InitBuffer(int buffer_size) {
   DCHECK(!stream_buffer());
   DCHECK_GT(buffer_size, 0);
-  stream_buffer_ = new IOBuffer(buffer_size);
+  stream_buffer_ = IOBufferWithSize::TakeFromPool(buffer_size);
   stream_buffer_size_ = buffer_size;
 }
 
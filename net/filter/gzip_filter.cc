@@ -4,18 +4,33 @@
 
 #include "net/filter/gzip_filter.h"
 
+#include <algorithm>
+
 #include "base/logging.h"
 #include "net/filter/gzip_header.h"
 #include "third_party/zlib/zlib.h"
 
 namespace net {
 
+namespace {
+
+// Size of each buffer in the readahead queue.
+const int kReadaheadBufferSize = 32 * 1024;
+
+// Maximum number of buffers in the readahead queue. Together with the buffer
+// size this bounds how far decompression may run ahead of consumption.
+const size_t kMaxReadaheadBuffers = 4;
+
+}  // namespace
+
 GZipFilter::GZipFilter()
     : decoding_status_(DECODING_UNINITIALIZED),
       decoding_mode_(DECODE_MODE_UNKNOWN),
       gzip_header_status_(GZIP_CHECK_HEADER_IN_PROGRESS),
       zlib_header_added_(false),
       gzip_footer_bytes_(0),
+      readahead_front_offset_(0),
+      readahead_back_filled_(0),
       possible_sdch_pass_through_(false) {
 }
 
@@ -70,6 +85,13 @@ Filter::FilterStatus GZipFilter::ReadFilteredData(char* dest_buffer,
     return Filter::FILTER_ERROR;
 
   if (decoding_status_ == DECODING_DONE) {
+    if (!readahead_queue_.empty()) {
+      // Decompressed output produced ahead of consumption is still queued;
+      // keep handing it out.
+      DrainReadaheadQueue(dest_buffer, dest_len);
+      return readahead_queue_.empty() ? Filter::FILTER_DONE
+                                      : Filter::FILTER_OK;
+    }
     if (GZIP_GET_INVALID_HEADER != gzip_header_status_)
       SkipGZipFooter();
     // Some server might send extra data after the gzip footer. We just copy
@@ -123,27 +145,108 @@ Filter::FilterStatus GZipFilter::ReadFilteredData(char* dest_buffer,
     }
   }
 
-  int dest_orig_size = *dest_len;
-  status = DoInflate(dest_buffer, dest_len);
-
-  if (decoding_mode_ == DECODE_MODE_DEFLATE && status == Filter::FILTER_ERROR) {
-    // As noted in Mozilla implementation, some servers such as Apache with
-    // mod_deflate don't generate zlib headers.
-    // See 677409 for instances where this work around is needed.
-    // Insert a dummy zlib header and try again.
-    if (InsertZlibHeader()) {
-      *dest_len = dest_orig_size;
-      status = DoInflate(dest_buffer, dest_len);
+  // Inflate the whole input chunk ahead of consumption into the bounded
+  // readahead queue, then serve the caller from the front of the queue. This
+  // way zlib always runs with full-sized output buffers, regardless of how
+  // small the caller's reads are, and subsequent reads are plain copies.
+  if (!FillReadaheadQueue()) {
+    DCHECK_EQ(DECODING_ERROR, decoding_status_);
+    *dest_len = 0;
+    return Filter::FILTER_ERROR;
+  }
+
+  DrainReadaheadQueue(dest_buffer, dest_len);
+
+  if (ReadaheadBytesAvailable() > 0)
+    return Filter::FILTER_OK;
+  if (decoding_status_ == DECODING_DONE)
+    return Filter::FILTER_DONE;
+  return Filter::FILTER_NEED_MORE_DATA;
+}
+
+bool GZipFilter::FillReadaheadQueue() {
+  while (decoding_status_ == DECODING_IN_PROGRESS && stream_data_len_ > 0) {
+    if (readahead_queue_.empty() ||
+        readahead_back_filled_ == readahead_queue_.back()->size()) {
+      if (readahead_queue_.size() >= kMaxReadaheadBuffers)
+        return true;  // The queue is full; resume once it drains.
+      readahead_queue_.push_back(make_scoped_refptr(
+          IOBufferWithSize::TakeFromPool(kReadaheadBufferSize)));
+      readahead_back_filled_ = 0;
     }
+
+    IOBufferWithSize* back = readahead_queue_.back().get();
+    int out_len = back->size() - readahead_back_filled_;
+    Filter::FilterStatus status =
+        DoInflate(back->data() + readahead_back_filled_, &out_len);
+
+    if (decoding_mode_ == DECODE_MODE_DEFLATE &&
+        status == Filter::FILTER_ERROR) {
+      // As noted in Mozilla implementation, some servers such as Apache with
+      // mod_deflate don't generate zlib headers.
+      // See 677409 for instances where this work around is needed.
+      // Insert a dummy zlib header and try again.
+      if (InsertZlibHeader()) {
+        out_len = back->size() - readahead_back_filled_;
+        status = DoInflate(back->data() + readahead_back_filled_, &out_len);
+      }
+    }
+
+    if (status == Filter::FILTER_ERROR) {
+      decoding_status_ = DECODING_ERROR;
+      return false;
+    }
+
+    readahead_back_filled_ += out_len;
+
+    if (status == Filter::FILTER_DONE) {
+      decoding_status_ = DECODING_DONE;
+      return true;
+    }
+    if (status == Filter::FILTER_NEED_MORE_DATA)
+      return true;
+    // FILTER_OK: the output buffer filled up with input remaining; loop
+    // around to continue in a fresh buffer.
   }
+  return true;
+}
 
-  if (status == Filter::FILTER_DONE) {
-    decoding_status_ = DECODING_DONE;
-  } else if (status == Filter::FILTER_ERROR) {
-    decoding_status_ = DECODING_ERROR;
+void GZipFilter::DrainReadaheadQueue(char* dest_buffer, int* dest_len) {
+  int copied = 0;
+  while (!readahead_queue_.empty() && copied < *dest_len) {
+    IOBufferWithSize* front = readahead_queue_.front().get();
+    int filled = (readahead_queue_.size() == 1) ? readahead_back_filled_
+                                                : front->size();
+    int len = std::min(filled - readahead_front_offset_, *dest_len - copied);
+    memcpy(dest_buffer + copied, front->data() + readahead_front_offset_, len);
+    copied += len;
+    readahead_front_offset_ += len;
+
+    if (readahead_front_offset_ < filled)
+      continue;  // The caller's buffer is full.
+
+    if (filled < front->size() && decoding_status_ == DECODING_IN_PROGRESS) {
+      // The last buffer is drained up to its fill point but may still be
+      // appended to when more input arrives; keep it.
+      break;
+    }
+    readahead_queue_.pop_front();
+    readahead_front_offset_ = 0;
+    if (readahead_queue_.empty())
+      readahead_back_filled_ = 0;
   }
+  *dest_len = copied;
+}
 
-  return status;
+int GZipFilter::ReadaheadBytesAvailable() const {
+  if (readahead_queue_.empty())
+    return 0;
+  int total = readahead_back_filled_;
+  if (readahead_queue_.size() > 1) {
+    total += static_cast<int>(readahead_queue_.size() - 1) *
+        readahead_queue_.front()->size();
+  }
+  return total - readahead_front_offset_;
 }
 
 Filter::FilterStatus GZipFilter::CheckGZipHeader() {
@@ -15,8 +15,12 @@
 #ifndef NET_FILTER_GZIP_FILTER_H_
 #define NET_FILTER_GZIP_FILTER_H_
 
+#include <deque>
+
 #include "base/basictypes.h"
+#include "base/memory/ref_counted.h"
 #include "base/memory/scoped_ptr.h"
+#include "net/base/io_buffer.h"
 #include "net/filter/filter.h"
 
 typedef struct z_stream_s z_stream;
@@ -96,6 +100,21 @@ class GZipFilter : public Filter {
   // comments for the use of function.
   FilterStatus DoInflate(char* dest_buffer, int* dest_len);
 
+  // Inflates as much of the buffered input as possible into the readahead
+  // queue, stopping when the queue bound is reached, the input is exhausted,
+  // or the stream ends. Updates decoding_status_ and returns false if
+  // decoding failed.
+  bool FillReadaheadQueue();
+
+  // Copies up to |*dest_len| queued chars into |dest_buffer| and pops
+  // exhausted buffers off the queue. On return, |*dest_len| is the number of
+  // chars copied.
+  void DrainReadaheadQueue(char* dest_buffer, int* dest_len);
+
+  // Returns the number of decompressed chars queued but not yet returned to
+  // the caller.
+  int ReadaheadBytesAvailable() const;
+
   // Inserts a zlib header to the data stream before calling zlib inflate.
   // This is used to work around server bugs. See more comments at the place
   // it is called in gzip_filter.cc.
@@ -134,6 +153,14 @@ class GZipFilter : public Filter {
   // DoInflate, with InsertZlibHeader being the exception as a workaround.
   scoped_ptr<z_stream> zlib_stream_;
 
+  // Decompressed output produced ahead of consumption, in decoding order.
+  // All buffers except the last are completely filled; readahead_back_filled_
+  // tracks how much of the last buffer is filled and readahead_front_offset_
+  // how much of the first has already been returned to the caller.
+  std::deque<scoped_refptr<IOBufferWithSize> > readahead_queue_;
+  int readahead_front_offset_;
+  int readahead_back_filled_;
+
   // For robustness, when we see the solo sdch filter, we chain in a gzip filter
   // in front of it, with this flag to indicate that the gzip decoding might not
   // be needed.  This handles a strange case where "Content-Encoding: sdch,gzip"
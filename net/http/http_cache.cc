@@ -299,6 +299,7 @@ HttpCache::HttpCache(const net::HttpNetworkSession::Params& params,
       bypass_lock_for_test_(false),
       mode_(NORMAL),
       network_layer_(new HttpNetworkLayer(new HttpNetworkSession(params))),
+      last_active_entry_(NULL),
       weak_factory_(this) {
   SetupQuicServerInfoFactory(network_layer_->GetSession());
 }
@@ -314,6 +315,7 @@ HttpCache::HttpCache(HttpNetworkSession* session,
       bypass_lock_for_test_(false),
       mode_(NORMAL),
       network_layer_(new HttpNetworkLayer(session)),
+      last_active_entry_(NULL),
       weak_factory_(this) {
 }
 
@@ -326,6 +328,7 @@ HttpCache::HttpCache(HttpTransactionFactory* network_layer,
       bypass_lock_for_test_(false),
       mode_(NORMAL),
       network_layer_(network_layer),
+      last_active_entry_(NULL),
       weak_factory_(this) {
   SetupQuicServerInfoFactory(network_layer_->GetSession());
 }
@@ -604,6 +607,8 @@ int HttpCache::DoomEntry(const std::string& key, Transaction* trans) {
 
   ActiveEntry* entry = it->second;
   active_entries_.erase(it);
+  if (last_active_entry_ == entry)
+    last_active_entry_ = NULL;
 
   // We keep track of doomed entries so that we can ensure that they are
   // cleaned up properly when the cache is destroyed.
@@ -670,8 +675,16 @@ void HttpCache::FinalizeDoomedEntry(ActiveEntry* entry) {
 }
 
 HttpCache::ActiveEntry* HttpCache::FindActiveEntry(const std::string& key) {
+  if (last_active_entry_ && last_active_key_ == key)
+    return last_active_entry_;
+
   ActiveEntriesMap::const_iterator it = active_entries_.find(key);
-  return it != active_entries_.end() ? it->second : NULL;
+  if (it == active_entries_.end())
+    return NULL;
+
+  last_active_key_ = key;
+  last_active_entry_ = it->second;
+  return it->second;
 }
 
 HttpCache::ActiveEntry* HttpCache::ActivateEntry(
@@ -679,6 +692,8 @@ HttpCache::ActiveEntry* HttpCache::ActivateEntry(
   DCHECK(!FindActiveEntry(disk_entry->GetKey()));
   ActiveEntry* entry = new ActiveEntry(disk_entry);
   active_entries_[disk_entry->GetKey()] = entry;
+  last_active_key_ = disk_entry->GetKey();
+  last_active_entry_ = entry;
   return entry;
 }
 
@@ -699,6 +714,8 @@ void HttpCache::DeactivateEntry(ActiveEntry* entry) {
   DCHECK(it->second == entry);
 
   active_entries_.erase(it);
+  if (last_active_entry_ == entry)
+    last_active_entry_ = NULL;
   delete entry;
 }
 
@@ -708,6 +725,8 @@ void HttpCache::SlowDeactivateEntry(ActiveEntry* entry) {
        it != active_entries_.end(); ++it) {
     if (it->second == entry) {
       active_entries_.erase(it);
+      if (last_active_entry_ == entry)
+        last_active_entry_ = NULL;
       delete entry;
       break;
     }
@@ -413,6 +413,15 @@ class NET_EXPORT HttpCache : public HttpTransactionFactory,
   // The set of active entries indexed by cache key.
   ActiveEntriesMap active_entries_;
 
+  // One-entry cache in front of |active_entries_|. A transaction looks up its
+  // entry several times while moving through its state machine, almost always
+  // with the key it used last, so remembering the last successful lookup
+  // avoids re-hashing the key each time. |last_active_entry_| is NULL
+  // whenever the memo is invalid; it is cleared every time an entry leaves
+  // |active_entries_|.
+  std::string last_active_key_;
+  ActiveEntry* last_active_entry_;
+
   // The set of doomed entries.
   ActiveEntriesSet doomed_entries_;
 
@@ -10,6 +10,8 @@
 #include <unistd.h>
 #endif
 
+#include <string.h>
+
 #include <algorithm>
 #include <string>
 
@@ -48,6 +50,11 @@ using base::TimeTicks;
 
 namespace {
 
+// Upper bound on the response data buffered while waiting for background
+// cache writes to land.  If the disk falls this far behind the network we
+// give up on caching the response instead of throttling the consumer.
+const int kMaxPendingCacheWriteBytes = 1024 * 1024;
+
 // Stores data relevant to the statistics of writing and reading entire
 // certificate chains using DiskBasedCertCache. |num_pending_ops| is the number
 // of certificates in the chain that have pending operations in the
@@ -323,9 +330,16 @@ HttpCache::Transaction::Transaction(
       read_offset_(0),
       effective_load_flags_(0),
       write_len_(0),
+      pending_cache_write_bytes_(0),
+      cache_write_in_flight_(false),
+      waiting_for_cache_drain_(false),
+      done_writing_deferred_(false),
       weak_factory_(this),
       io_callback_(base::Bind(&Transaction::OnIOComplete,
                               weak_factory_.GetWeakPtr())),
+      cache_write_callback_(
+          base::Bind(&Transaction::OnBackgroundCacheWriteComplete,
+                     weak_factory_.GetWeakPtr())),
       transaction_pattern_(PATTERN_UNDEFINED),
       total_received_bytes_(0),
       websocket_handshake_stream_base_create_helper_(NULL) {
@@ -591,7 +605,12 @@ void HttpCache::Transaction::DoneReading() {
   if (cache_.get() && entry_) {
     DCHECK_NE(mode_, UPDATE);
     if (mode_ & WRITE) {
-      DoneWritingToEntry(true);
+      if (HasPendingBackgroundCacheWrites()) {
+        // Close the entry only once the queued writes have landed.
+        done_writing_deferred_ = true;
+      } else {
+        DoneWritingToEntry(true);
+      }
     } else if (mode_ & READ) {
       // It is necessary to check mode_ & READ because it is possible
       // for mode_ to be NONE and entry_ non-NULL with a write entry
@@ -1769,6 +1788,17 @@ int HttpCache::Transaction::DoCacheWriteData(int num_bytes) {
       net_log_.BeginEvent(NetLog::TYPE_HTTP_CACHE_WRITE_DATA);
   }
 
+  if (CanWriteToEntryInBackground()) {
+    if (num_bytes > 0)
+      return BufferResponseDataForEntry(read_buf_.get(), num_bytes);
+    if (HasPendingBackgroundCacheWrites()) {
+      // End of the response; park here until the queued writes land, then
+      // resume with the usual end-of-stream bookkeeping.
+      waiting_for_cache_drain_ = true;
+      return ERR_IO_PENDING;
+    }
+  }
+
   return AppendResponseDataToEntry(read_buf_.get(), num_bytes, io_callback_);
 }
 
@@ -2030,7 +2060,9 @@ int HttpCache::Transaction::BeginCacheRead() {
 int HttpCache::Transaction::BeginCacheValidation() {
   DCHECK(mode_ == READ_WRITE);
 
-  bool skip_validation = !RequiresValidation();
+  ValidationType required_validation = RequiresValidation();
+
+  bool skip_validation = (required_validation == VALIDATION_NONE);
 
   if (truncated_) {
     // Truncated entries can cause partial gets, so we shouldn't record this
@@ -2047,6 +2079,16 @@ int HttpCache::Transaction::BeginCacheValidation() {
     skip_validation = false;
   }
 
+  if (!skip_validation && required_validation == VALIDATION_ASYNCHRONOUS &&
+      request_->method == "GET" && !truncated_ && !partial_.get() &&
+      (effective_load_flags_ & LOAD_SUPPORT_ASYNC_REVALIDATION)) {
+    // The entry is stale but within its stale-while-revalidate window, and
+    // the caller has promised to revalidate it asynchronously. Serve the
+    // stale response now and record that the revalidation is needed.
+    skip_validation = true;
+    response_.async_revalidation_required = true;
+  }
+
   if (skip_validation) {
     UpdateTransactionPattern(PATTERN_ENTRY_USED);
     RecordOfflineStatus(effective_load_flags_, OFFLINE_STATUS_FRESH_CACHE);
@@ -2182,37 +2224,33 @@ int HttpCache::Transaction::RestartNetworkRequestWithAuth(
   return rv;
 }
 
-bool HttpCache::Transaction::RequiresValidation() {
+ValidationType HttpCache::Transaction::RequiresValidation() {
   // TODO(darin): need to do more work here:
   //  - make sure we have a matching request method
   //  - watch out for cached responses that depend on authentication
 
   // In playback mode, nothing requires validation.
   if (cache_->mode() == net::HttpCache::PLAYBACK)
-    return false;
+    return VALIDATION_NONE;
 
   if (response_.vary_data.is_valid() &&
       !response_.vary_data.MatchesRequest(*request_,
                                           *response_.headers.get())) {
     vary_mismatch_ = true;
-    return true;
+    return VALIDATION_SYNCHRONOUS;
   }
 
   if (effective_load_flags_ & LOAD_PREFERRING_CACHE)
-    return false;
+    return VALIDATION_NONE;
 
   if (effective_load_flags_ & LOAD_VALIDATE_CACHE)
-    return true;
+    return VALIDATION_SYNCHRONOUS;
 
   if (request_->method == "PUT" || request_->method == "DELETE")
-    return true;
-
-  if (response_.headers->RequiresValidation(
-          response_.request_time, response_.response_time, Time::Now())) {
-    return true;
-  }
+    return VALIDATION_SYNCHRONOUS;
 
-  return false;
+  return response_.headers->RequiresValidation(
+      response_.request_time, response_.response_time, Time::Now());
 }
 
 bool HttpCache::Transaction::ConditionalizeRequest() {
@@ -2523,6 +2561,106 @@ int HttpCache::Transaction::AppendResponseDataToEntry(
                       callback);
 }
 
+bool HttpCache::Transaction::CanWriteToEntryInBackground() const {
+  // Range requests interleave cache reads and sparse writes whose ordering
+  // the PartialData machinery depends on, so they keep the synchronous path.
+  return entry_ && !partial_.get();
+}
+
+bool HttpCache::Transaction::HasPendingBackgroundCacheWrites() const {
+  return cache_write_in_flight_ || !pending_cache_writes_.empty();
+}
+
+int HttpCache::Transaction::BufferResponseDataForEntry(IOBuffer* data,
+                                                       int data_len) {
+  DCHECK_GT(data_len, 0);
+  if (pending_cache_write_bytes_ + data_len > kMaxPendingCacheWriteBytes) {
+    // The disk is not keeping up with the network. Give up on caching this
+    // response rather than making the consumer wait; the entry is doomed
+    // since it is incomplete.
+    DLOG(WARNING) << "cache write queue overflowed; not caching response";
+    AbortBackgroundCacheWrites();
+    DoneWritingToEntry(false);
+    return data_len;
+  }
+
+  scoped_refptr<IOBufferWithSize> copy(
+      IOBufferWithSize::TakeFromPool(data_len));
+  memcpy(copy->data(), data->data(), data_len);
+  pending_cache_writes_.push_back(copy);
+  pending_cache_write_bytes_ += data_len;
+  if (!cache_write_in_flight_)
+    StartNextBackgroundCacheWrite();
+  return data_len;
+}
+
+void HttpCache::Transaction::StartNextBackgroundCacheWrite() {
+  DCHECK(!cache_write_in_flight_);
+  while (!pending_cache_writes_.empty()) {
+    if (!entry_) {
+      // The entry went away (e.g. the cache gave up on this response);
+      // there is nothing left to write to.
+      AbortBackgroundCacheWrites();
+      return;
+    }
+    IOBufferWithSize* buf = pending_cache_writes_.front().get();
+    int current_size = entry_->disk_entry->GetDataSize(kResponseContentIndex);
+    int rv = WriteToEntry(kResponseContentIndex, current_size, buf,
+                          buf->size(), cache_write_callback_);
+    if (rv == ERR_IO_PENDING) {
+      cache_write_in_flight_ = true;
+      return;
+    }
+    if (rv != buf->size()) {
+      DLOG(ERROR) << "failed to write response data to cache";
+      AbortBackgroundCacheWrites();
+      DoneWritingToEntry(false);
+      return;
+    }
+    pending_cache_write_bytes_ -= buf->size();
+    pending_cache_writes_.pop_front();
+  }
+}
+
+void HttpCache::Transaction::AbortBackgroundCacheWrites() {
+  pending_cache_writes_.clear();
+  pending_cache_write_bytes_ = 0;
+}
+
+void HttpCache::Transaction::OnBackgroundCacheWriteComplete(int result) {
+  DCHECK(cache_write_in_flight_);
+  cache_write_in_flight_ = false;
+
+  // The queue is empty if the writes were aborted while this one was in
+  // flight; in that case there is no bookkeeping left to do for it.
+  if (!pending_cache_writes_.empty()) {
+    IOBufferWithSize* buf = pending_cache_writes_.front().get();
+    if (result == buf->size()) {
+      pending_cache_write_bytes_ -= buf->size();
+      pending_cache_writes_.pop_front();
+      StartNextBackgroundCacheWrite();
+    } else {
+      DLOG(ERROR) << "failed to write response data to cache";
+      AbortBackgroundCacheWrites();
+      DoneWritingToEntry(false);
+    }
+  }
+
+  if (HasPendingBackgroundCacheWrites())
+    return;
+
+  // The queue drained; run whatever was waiting on it.
+  if (done_writing_deferred_) {
+    done_writing_deferred_ = false;
+    DoneWritingToEntry(true);
+  }
+  if (waiting_for_cache_drain_) {
+    waiting_for_cache_drain_ = false;
+    // Resume the state machine parked in STATE_CACHE_WRITE_DATA_COMPLETE.
+    OnIOComplete(0);
+  }
+}
+
 void HttpCache::Transaction::DoneWritingToEntry(bool success) {
   if (!entry_)
     return;
@@ -8,6 +8,7 @@
 #ifndef NET_HTTP_HTTP_CACHE_TRANSACTION_H_
 #define NET_HTTP_HTTP_CACHE_TRANSACTION_H_
 
+#include <list>
 #include <string>
 
 #include "base/time/time.h"
@@ -16,11 +17,13 @@
 #include "net/base/request_priority.h"
 #include "net/http/http_cache.h"
 #include "net/http/http_request_headers.h"
+#include "net/http/http_response_headers.h"
 #include "net/http/http_response_info.h"
 #include "net/http/http_transaction.h"
 
 namespace net {
 
+class IOBufferWithSize;
 class PartialData;
 struct HttpRequestInfo;
 struct LoadTimingInfo;
@@ -312,7 +315,7 @@ class HttpCache::Transaction : public HttpTransaction {
   int RestartNetworkRequestWithAuth(const AuthCredentials& credentials);
 
   // Called to determine if we need to validate the cache entry before using it.
-  bool RequiresValidation();
+  ValidationType RequiresValidation();
 
   // Called to make the request conditional (to ask the server if the cached
   // copy is valid).  Returns true if able to make the request conditional.
@@ -354,6 +357,29 @@ class HttpCache::Transaction : public HttpTransaction {
   int AppendResponseDataToEntry(IOBuffer* data, int data_len,
                                 const CompletionCallback& callback);
 
+  // Returns true if response data can be copied aside and appended to the
+  // cache entry in the background, off the consumer's read path.
+  bool CanWriteToEntryInBackground() const;
+
+  // Returns true if background cache writes are queued or in flight.
+  bool HasPendingBackgroundCacheWrites() const;
+
+  // Copies |data_len| bytes of |data| onto the background cache write queue
+  // and starts the queue draining if it is idle.  Returns |data_len|.  If the
+  // queue bound would be exceeded, gives up on caching this response instead
+  // of throttling the consumer.
+  int BufferResponseDataForEntry(IOBuffer* data, int data_len);
+
+  // Issues cache writes for the front of the background write queue until one
+  // goes asynchronous or the queue is empty.
+  void StartNextBackgroundCacheWrite();
+
+  // Drops any queued background cache writes.
+  void AbortBackgroundCacheWrites();
+
+  // Called when an asynchronous background cache write completes.
+  void OnBackgroundCacheWriteComplete(int result);
+
   // Called when we are done writing to the cache entry.
   void DoneWritingToEntry(bool success);
 
@@ -433,10 +459,27 @@ class HttpCache::Transaction : public HttpTransaction {
   int read_offset_;
   int effective_load_flags_;
   int write_len_;
+
+  // Copies of response data waiting to be appended to the cache entry.  Data
+  // is delivered to the consumer as soon as it arrives from the network; the
+  // copies queued here are written to the entry in the background so cache
+  // write latency never stalls the consumer's reads.  At most one disk write
+  // is in flight at a time.
+  std::list<scoped_refptr<IOBufferWithSize> > pending_cache_writes_;
+  int pending_cache_write_bytes_;  // Total bytes queued.
+  bool cache_write_in_flight_;
+  // The response ended while writes were still queued; the state machine is
+  // parked in STATE_CACHE_WRITE_DATA_COMPLETE until the queue drains.
+  bool waiting_for_cache_drain_;
+  // DoneReading() was called while writes were still queued; close the entry
+  // once they land.
+  bool done_writing_deferred_;
+
   scoped_ptr<PartialData> partial_;  // We are dealing with range requests.
   UploadProgress final_upload_progress_;
   base::WeakPtrFactory<Transaction> weak_factory_;
   CompletionCallback io_callback_;
+  CompletionCallback cache_write_callback_;
 
   // Members used to track data for histograms.
   TransactionPattern transaction_pattern_;
@@ -1053,6 +1053,65 @@ TEST(HttpCache, SimpleGET_CacheSignal_Failure) {
   RemoveMockTransaction(&transaction);
 }
 
+// Tests that a stale entry within its stale-while-revalidate window is served
+// from the cache when the caller promises to revalidate it asynchronously.
+TEST(HttpCache, SimpleGET_StaleWhileRevalidate) {
+  MockHttpCache cache;
+
+  MockTransaction transaction(kSimpleGET_Transaction);
+  transaction.load_flags |= net::LOAD_SUPPORT_ASYNC_REVALIDATION;
+  transaction.response_headers =
+      "Cache-Control: max-age=5,stale-while-revalidate=86400\n"
+      "Age: 3600\n";
+  AddMockTransaction(&transaction);
+
+  // Write to the cache.
+  RunTransactionTest(cache.http_cache(), transaction);
+  EXPECT_EQ(1, cache.network_layer()->transaction_count());
+  EXPECT_EQ(1, cache.disk_cache()->create_count());
+
+  // The entry is stale, but it is within the stale-while-revalidate window,
+  // so it should be served without a network request.
+  net::HttpResponseInfo response_info;
+  RunTransactionTestWithResponseInfo(cache.http_cache(), transaction,
+                                     &response_info);
+
+  EXPECT_EQ(1, cache.network_layer()->transaction_count());
+  EXPECT_TRUE(response_info.was_cached);
+  EXPECT_FALSE(response_info.network_accessed);
+  EXPECT_TRUE(response_info.async_revalidation_required);
+
+  RemoveMockTransaction(&transaction);
+}
+
+// Tests that the stale-while-revalidate serving mode is not used when the
+// caller has not set LOAD_SUPPORT_ASYNC_REVALIDATION.
+TEST(HttpCache, SimpleGET_StaleWhileRevalidate_NoLoadFlag) {
+  MockHttpCache cache;
+
+  MockTransaction transaction(kSimpleGET_Transaction);
+  transaction.response_headers =
+      "Cache-Control: max-age=5,stale-while-revalidate=86400\n"
+      "Age: 3600\n";
+  AddMockTransaction(&transaction);
+
+  // Write to the cache.
+  RunTransactionTest(cache.http_cache(), transaction);
+  EXPECT_EQ(1, cache.network_layer()->transaction_count());
+  EXPECT_EQ(1, cache.disk_cache()->create_count());
+
+  // The stale entry must be validated over the network.
+  net::HttpResponseInfo response_info;
+  RunTransactionTestWithResponseInfo(cache.http_cache(), transaction,
+                                     &response_info);
+
+  EXPECT_EQ(2, cache.network_layer()->transaction_count());
+  EXPECT_TRUE(response_info.network_accessed);
+  EXPECT_FALSE(response_info.async_revalidation_required);
+
+  RemoveMockTransaction(&transaction);
+}
+
 // Confirm if we have an empty cache, a read is marked as network verified.
 TEST(HttpCache, SimpleGET_NetworkAccessed_Network) {
   MockHttpCache cache;
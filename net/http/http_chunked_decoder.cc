@@ -67,6 +67,13 @@ HttpChunkedDecoder::HttpChunkedDecoder()
 }
 
 int HttpChunkedDecoder::FilterBuf(char* buf, int buf_len) {
+  // Consume the buffer with separate read and write cursors, compacting the
+  // chunk data towards the front as the chunk metadata between the chunks is
+  // parsed out. This moves each data byte at most once; shifting the whole
+  // remaining buffer after every metadata line would be quadratic when the
+  // buffer holds many small chunks.
+  const char* read = buf;
+  char* write = buf;
   int result = 0;
 
   while (buf_len) {
@@ -76,8 +83,11 @@ int HttpChunkedDecoder::FilterBuf(char* buf, int buf_len) {
       buf_len -= num;
       chunk_remaining_ -= num;
 
+      if (write != read)
+        memmove(write, read, num);
+      write += num;
+      read += num;
       result += num;
-      buf += num;
 
       // After each chunk's data there should be a CRLF
       if (!chunk_remaining_)
@@ -88,13 +98,12 @@ int HttpChunkedDecoder::FilterBuf(char* buf, int buf_len) {
       break;  // Done!
     }
 
-    int bytes_consumed = ScanForChunkRemaining(buf, buf_len);
+    int bytes_consumed = ScanForChunkRemaining(read, buf_len);
     if (bytes_consumed < 0)
       return bytes_consumed; // Error
 
     buf_len -= bytes_consumed;
-    if (buf_len)
-      memmove(buf, buf + bytes_consumed, buf_len);
+    read += bytes_consumed;
   }
 
   return result;
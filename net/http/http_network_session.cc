@@ -132,6 +132,7 @@ HttpNetworkSession::HttpNetworkSession(const Params& params)
                            params.quic_connection_options),
       spdy_session_pool_(params.host_resolver,
                          params.ssl_config_service,
+                         params.transport_security_state,
                          params.http_server_properties,
                          params.force_spdy_single_domain,
                          params.enable_spdy_compression,
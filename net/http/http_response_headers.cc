@@ -72,18 +72,25 @@ const char* const kSecurityStateHeaders[] = {
 
 // These response headers are not copied from a 304/206 response to the cached
 // response headers.  This list is based on Mozilla's nsHttpResponseHead.cpp.
-const char* const kNonUpdatedHeaders[] = {
-  "connection",
-  "proxy-connection",
-  "keep-alive",
-  "www-authenticate",
-  "proxy-authenticate",
-  "trailer",
-  "transfer-encoding",
-  "upgrade",
-  "etag",
-  "x-frame-options",
-  "x-xss-protection",
+// The hashes are pre-computed HttpUtil::HeaderNameHash() values, letting
+// ShouldUpdateHeader() reject most names with integer compares; they are
+// verified by HttpUtilTest.HeaderNameHash.
+struct HeaderHashEntry {
+  uint32 hash;
+  const char* name;
+};
+const HeaderHashEntry kNonUpdatedHeaders[] = {
+  { 0x38b99ed9, "connection" },
+  { 0x32c09da6, "proxy-connection" },
+  { 0xe18edb80, "keep-alive" },
+  { 0x2e7bcf02, "www-authenticate" },
+  { 0xa17edaef, "proxy-authenticate" },
+  { 0x816fede0, "trailer" },
+  { 0xddb4744c, "transfer-encoding" },
+  { 0xdc97cc77, "upgrade" },
+  { 0x06c857c0, "etag" },
+  { 0xee0d1548, "x-frame-options" },
+  { 0x95132148, "x-xss-protection" },
 };
 
 // Some header prefixes mean "Don't copy this header from a 304 response.".
@@ -97,8 +104,10 @@ const char* const kNonUpdatedHeaderPrefixes[] = {
 
 bool ShouldUpdateHeader(const std::string::const_iterator& name_begin,
                         const std::string::const_iterator& name_end) {
+  const uint32 name_hash = HttpUtil::HeaderNameHash(name_begin, name_end);
   for (size_t i = 0; i < arraysize(kNonUpdatedHeaders); ++i) {
-    if (LowerCaseEqualsASCII(name_begin, name_end, kNonUpdatedHeaders[i]))
+    if (name_hash == kNonUpdatedHeaders[i].hash &&
+        LowerCaseEqualsASCII(name_begin, name_end, kNonUpdatedHeaders[i].name))
       return false;
   }
   for (size_t i = 0; i < arraysize(kNonUpdatedHeaderPrefixes); ++i) {
@@ -129,6 +138,10 @@ struct HttpResponseHeaders::ParsedHeader {
   std::string::const_iterator name_end;
   std::string::const_iterator value_begin;
   std::string::const_iterator value_end;
+
+  // Case-folded hash of the header name, filled in by AddToParsed() so that
+  // FindHeader() can skip most entries without comparing characters.
+  uint32 name_hash;
 };
 
 //-----------------------------------------------------------------------------
@@ -739,8 +752,9 @@ void HttpResponseHeaders::ParseStatusLine(
 
 size_t HttpResponseHeaders::FindHeader(size_t from,
                                        const base::StringPiece& search) const {
+  const uint32 search_hash = HttpUtil::HeaderNameHash(search.begin(), search.end());
   for (size_t i = from; i < parsed_.size(); ++i) {
-    if (parsed_[i].is_continuation())
+    if (parsed_[i].is_continuation() || parsed_[i].name_hash != search_hash)
       continue;
     const std::string::const_iterator& name_begin = parsed_[i].name_begin;
     const std::string::const_iterator& name_end = parsed_[i].name_end;
@@ -780,6 +794,7 @@ void HttpResponseHeaders::AddToParsed(std::string::const_iterator name_begin,
   header.name_end = name_end;
   header.value_begin = value_begin;
   header.value_end = value_end;
+  header.name_hash = HttpUtil::HeaderNameHash(name_begin, name_end);
   parsed_.push_back(header);
 }
 
@@ -930,15 +945,29 @@ bool HttpResponseHeaders::IsRedirectResponseCode(int response_code) {
 // Of course, there are other factors that can force a response to always be
 // validated or re-fetched.
 //
-bool HttpResponseHeaders::RequiresValidation(const Time& request_time,
-                                             const Time& response_time,
-                                             const Time& current_time) const {
+ValidationType HttpResponseHeaders::RequiresValidation(
+    const Time& request_time,
+    const Time& response_time,
+    const Time& current_time) const {
   TimeDelta lifetime =
       GetFreshnessLifetime(response_time);
   if (lifetime == TimeDelta())
-    return true;
+    return VALIDATION_SYNCHRONOUS;
+
+  TimeDelta age = GetCurrentAge(request_time, response_time, current_time);
+  if (lifetime > age)
+    return VALIDATION_NONE;
+
+  // The response is stale, but the "stale-while-revalidate" directive allows
+  // it to be served for a while longer provided it is revalidated in the
+  // background.  See RFC 5861 section 3.
+  TimeDelta stale_while_revalidate;
+  if (GetStaleWhileRevalidateValue(&stale_while_revalidate) &&
+      age < lifetime + stale_while_revalidate) {
+    return VALIDATION_ASYNCHRONOUS;
+  }
 
-  return lifetime <= GetCurrentAge(request_time, response_time, current_time);
+  return VALIDATION_SYNCHRONOUS;
 }
 
 // From RFC 2616 section 13.2.4:
@@ -1092,20 +1121,31 @@ TimeDelta HttpResponseHeaders::GetCurrentAge(const Time& request_time,
 }
 
 bool HttpResponseHeaders::GetMaxAgeValue(TimeDelta* result) const {
+  return GetCacheControlDirective("max-age", result);
+}
+
+bool HttpResponseHeaders::GetStaleWhileRevalidateValue(
+    TimeDelta* result) const {
+  return GetCacheControlDirective("stale-while-revalidate", result);
+}
+
+bool HttpResponseHeaders::GetCacheControlDirective(
+    const std::string& directive,
+    TimeDelta* result) const {
   std::string name = "cache-control";
   std::string value;
 
-  const char kMaxAgePrefix[] = "max-age=";
-  const size_t kMaxAgePrefixLen = arraysize(kMaxAgePrefix) - 1;
+  const std::string prefix = directive + "=";
+  const size_t prefix_len = prefix.size();
 
   void* iter = NULL;
   while (EnumerateHeader(&iter, name, &value)) {
-    if (value.size() > kMaxAgePrefixLen) {
+    if (value.size() > prefix_len) {
       if (LowerCaseEqualsASCII(value.begin(),
-                               value.begin() + kMaxAgePrefixLen,
-                               kMaxAgePrefix)) {
+                               value.begin() + prefix_len,
+                               prefix.c_str())) {
         int64 seconds;
-        base::StringToInt64(StringPiece(value.begin() + kMaxAgePrefixLen,
+        base::StringToInt64(StringPiece(value.begin() + prefix_len,
                                         value.end()),
                             &seconds);
         *result = TimeDelta::FromSeconds(seconds);
@@ -28,6 +28,15 @@ namespace net {
 
 class HttpByteRange;
 
+enum ValidationType {
+  VALIDATION_NONE,          // The response can be reused without validation.
+  VALIDATION_ASYNCHRONOUS,  // The response can be reused, but asynchronous
+                            // revalidation must be performed
+                            // (stale-while-revalidate).
+  VALIDATION_SYNCHRONOUS,   // The response cannot be reused without
+                            // validation.
+};
+
 // HttpResponseHeaders: parses and holds HTTP response headers.
 class NET_EXPORT HttpResponseHeaders
     : public base::RefCountedThreadSafe<HttpResponseHeaders> {
@@ -201,14 +210,14 @@ class NET_EXPORT HttpResponseHeaders
   // redirect.
   static bool IsRedirectResponseCode(int response_code);
 
-  // Returns true if the response cannot be reused without validation.  The
-  // result is relative to the current_time parameter, which is a parameter to
-  // support unit testing.  The request_time parameter indicates the time at
-  // which the request was made that resulted in this response, which was
-  // received at response_time.
-  bool RequiresValidation(const base::Time& request_time,
-                          const base::Time& response_time,
-                          const base::Time& current_time) const;
+  // Returns the type of validation required by the response.  The result is
+  // relative to the current_time parameter, which is a parameter to support
+  // unit testing.  The request_time parameter indicates the time at which the
+  // request was made that resulted in this response, which was received at
+  // response_time.
+  ValidationType RequiresValidation(const base::Time& request_time,
+                                    const base::Time& response_time,
+                                    const base::Time& current_time) const;
 
   // Returns the amount of time the server claims the response is fresh from
   // the time the response was generated.  See section 13.2.4 of RFC 2616.  See
@@ -226,6 +235,7 @@ class NET_EXPORT HttpResponseHeaders
   // and the out param is assigned to the corresponding value.
   bool GetMaxAgeValue(base::TimeDelta* value) const;
   bool GetAgeValue(base::TimeDelta* value) const;
+  bool GetStaleWhileRevalidateValue(base::TimeDelta* value) const;
   bool GetDateValue(base::Time* value) const;
   bool GetLastModifiedValue(base::Time* value) const;
   bool GetExpiresValue(base::Time* value) const;
@@ -320,6 +330,12 @@ class NET_EXPORT HttpResponseHeaders
   // index |from|.  Returns string::npos if not found.
   size_t FindHeader(size_t from, const base::StringPiece& name) const;
 
+  // Search the Cache-Control header for a directive of the form
+  // "<directive>=<seconds>".  Returns true and fills in |result| if it is
+  // found.
+  bool GetCacheControlDirective(const std::string& directive,
+                                base::TimeDelta* result) const;
+
   // Add a header->value pair to our list.  If we already have header in our
   // list, append the value to it.
   void AddHeader(std::string::const_iterator name_begin,
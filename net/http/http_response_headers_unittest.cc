@@ -730,32 +730,32 @@ TEST(HttpResponseHeadersTest, GetMimeType) {
 TEST(HttpResponseHeadersTest, RequiresValidation) {
   const struct {
     const char* headers;
-    bool requires_validation;
+    net::ValidationType validation_type;
   } tests[] = {
     // no expiry info: expires immediately
     { "HTTP/1.1 200 OK\n"
       "\n",
-      true
+      net::VALIDATION_SYNCHRONOUS
     },
     // valid for a little while
     { "HTTP/1.1 200 OK\n"
       "cache-control: max-age=10000\n"
       "\n",
-      false
+      net::VALIDATION_NONE
     },
     // expires in the future
     { "HTTP/1.1 200 OK\n"
       "date: Wed, 28 Nov 2007 00:40:11 GMT\n"
       "expires: Wed, 28 Nov 2007 01:00:00 GMT\n"
       "\n",
-      false
+      net::VALIDATION_NONE
     },
     // expired already
     { "HTTP/1.1 200 OK\n"
       "date: Wed, 28 Nov 2007 00:40:11 GMT\n"
       "expires: Wed, 28 Nov 2007 00:00:00 GMT\n"
       "\n",
-      true
+      net::VALIDATION_SYNCHRONOUS
     },
     // max-age trumps expires
     { "HTTP/1.1 200 OK\n"
@@ -763,77 +763,77 @@ TEST(HttpResponseHeadersTest, RequiresValidation) {
       "expires: Wed, 28 Nov 2007 00:00:00 GMT\n"
       "cache-control: max-age=10000\n"
       "\n",
-      false
+      net::VALIDATION_NONE
     },
     // last-modified heuristic: modified a while ago
     { "HTTP/1.1 200 OK\n"
       "date: Wed, 28 Nov 2007 00:40:11 GMT\n"
       "last-modified: Wed, 27 Nov 2007 08:00:00 GMT\n"
       "\n",
-      false
+      net::VALIDATION_NONE
     },
     { "HTTP/1.1 203 Non-Authoritative Information\n"
       "date: Wed, 28 Nov 2007 00:40:11 GMT\n"
       "last-modified: Wed, 27 Nov 2007 08:00:00 GMT\n"
       "\n",
-      false
+      net::VALIDATION_NONE
     },
     { "HTTP/1.1 206 Partial Content\n"
       "date: Wed, 28 Nov 2007 00:40:11 GMT\n"
       "last-modified: Wed, 27 Nov 2007 08:00:00 GMT\n"
       "\n",
-      false
+      net::VALIDATION_NONE
     },
     // last-modified heuristic: modified recently
     { "HTTP/1.1 200 OK\n"
       "date: Wed, 28 Nov 2007 00:40:11 GMT\n"
       "last-modified: Wed, 28 Nov 2007 00:40:10 GMT\n"
       "\n",
-      true
+      net::VALIDATION_SYNCHRONOUS
     },
     { "HTTP/1.1 203 Non-Authoritative Information\n"
       "date: Wed, 28 Nov 2007 00:40:11 GMT\n"
       "last-modified: Wed, 28 Nov 2007 00:40:10 GMT\n"
       "\n",
-      true
+      net::VALIDATION_SYNCHRONOUS
     },
     { "HTTP/1.1 206 Partial Content\n"
       "date: Wed, 28 Nov 2007 00:40:11 GMT\n"
       "last-modified: Wed, 28 Nov 2007 00:40:10 GMT\n"
       "\n",
-      true
+      net::VALIDATION_SYNCHRONOUS
     },
     // cached permanent redirect
     { "HTTP/1.1 301 Moved Permanently\n"
       "\n",
-      false
+      net::VALIDATION_NONE
     },
     // another cached permanent redirect
     { "HTTP/1.1 308 Permanent Redirect\n"
       "\n",
-      false
+      net::VALIDATION_NONE
     },
     // cached redirect: not reusable even though by default it would be
     { "HTTP/1.1 300 Multiple Choices\n"
       "Cache-Control: no-cache\n"
       "\n",
-      true
+      net::VALIDATION_SYNCHRONOUS
     },
     // cached forever by default
     { "HTTP/1.1 410 Gone\n"
       "\n",
-      false
+      net::VALIDATION_NONE
     },
     // cached temporary redirect: not reusable
     { "HTTP/1.1 302 Found\n"
       "\n",
-      true
+      net::VALIDATION_SYNCHRONOUS
     },
     // cached temporary redirect: reusable
     { "HTTP/1.1 302 Found\n"
       "cache-control: max-age=10000\n"
       "\n",
-      false
+      net::VALIDATION_NONE
     },
     // cache-control: max-age=N overrides expires: date in the past
     { "HTTP/1.1 200 OK\n"
@@ -841,7 +841,7 @@ TEST(HttpResponseHeadersTest, RequiresValidation) {
       "expires: Wed, 28 Nov 2007 00:20:11 GMT\n"
       "cache-control: max-age=10000\n"
       "\n",
-      false
+      net::VALIDATION_NONE
     },
     // cache-control: no-store overrides expires: in the future
     { "HTTP/1.1 200 OK\n"
@@ -849,7 +849,7 @@ TEST(HttpResponseHeadersTest, RequiresValidation) {
       "expires: Wed, 29 Nov 2007 00:40:11 GMT\n"
       "cache-control: no-store,private,no-cache=\"foo\"\n"
       "\n",
-      true
+      net::VALIDATION_SYNCHRONOUS
     },
     // pragma: no-cache overrides last-modified heuristic
     { "HTTP/1.1 200 OK\n"
@@ -857,7 +857,28 @@ TEST(HttpResponseHeadersTest, RequiresValidation) {
       "last-modified: Wed, 27 Nov 2007 08:00:00 GMT\n"
       "pragma: no-cache\n"
       "\n",
-      true
+      net::VALIDATION_SYNCHRONOUS
+    },
+    // stale-while-revalidate: stale but within the revalidation window
+    { "HTTP/1.1 200 OK\n"
+      "date: Wed, 28 Nov 2007 00:40:11 GMT\n"
+      "cache-control: max-age=120,stale-while-revalidate=600\n"
+      "\n",
+      net::VALIDATION_ASYNCHRONOUS
+    },
+    // stale-while-revalidate: stale and the window has passed
+    { "HTTP/1.1 200 OK\n"
+      "date: Wed, 28 Nov 2007 00:40:11 GMT\n"
+      "cache-control: max-age=120,stale-while-revalidate=60\n"
+      "\n",
+      net::VALIDATION_SYNCHRONOUS
+    },
+    // stale-while-revalidate: not consulted while the response is fresh
+    { "HTTP/1.1 200 OK\n"
+      "date: Wed, 28 Nov 2007 00:40:11 GMT\n"
+      "cache-control: max-age=10000,stale-while-revalidate=600\n"
+      "\n",
+      net::VALIDATION_NONE
     },
     // TODO(darin): add many many more tests here
   };
@@ -872,9 +893,9 @@ TEST(HttpResponseHeadersTest, RequiresValidation) {
     scoped_refptr<net::HttpResponseHeaders> parsed(
         new net::HttpResponseHeaders(headers));
 
-    bool requires_validation =
+    net::ValidationType validation_type =
         parsed->RequiresValidation(request_time, response_time, current_time);
-    EXPECT_EQ(tests[i].requires_validation, requires_validation);
+    EXPECT_EQ(tests[i].validation_type, validation_type);
   }
 }
 
@@ -99,6 +99,7 @@ HttpResponseInfo::HttpResponseInfo()
     : was_cached(false),
       server_data_unavailable(false),
       network_accessed(false),
+      async_revalidation_required(false),
       was_fetched_via_spdy(false),
       was_npn_negotiated(false),
       was_fetched_via_proxy(false),
@@ -110,6 +111,7 @@ HttpResponseInfo::HttpResponseInfo(const HttpResponseInfo& rhs)
     : was_cached(rhs.was_cached),
       server_data_unavailable(rhs.server_data_unavailable),
       network_accessed(rhs.network_accessed),
+      async_revalidation_required(rhs.async_revalidation_required),
       was_fetched_via_spdy(rhs.was_fetched_via_spdy),
       was_npn_negotiated(rhs.was_npn_negotiated),
       was_fetched_via_proxy(rhs.was_fetched_via_proxy),
@@ -135,6 +137,7 @@ HttpResponseInfo& HttpResponseInfo::operator=(const HttpResponseInfo& rhs) {
   was_cached = rhs.was_cached;
   server_data_unavailable = rhs.server_data_unavailable;
   network_accessed = rhs.network_accessed;
+  async_revalidation_required = rhs.async_revalidation_required;
   was_fetched_via_spdy = rhs.was_fetched_via_spdy;
   proxy_server = rhs.proxy_server;
   was_npn_negotiated = rhs.was_npn_negotiated;
@@ -77,6 +77,12 @@ class NET_EXPORT HttpResponseInfo {
   // data.
   bool network_accessed;
 
+  // True if the response was served from a stale cache entry under
+  // "stale-while-revalidate" and the caller promised, by setting
+  // LOAD_SUPPORT_ASYNC_REVALIDATION, to revalidate the entry in the
+  // background.  This flag is not persisted to the cache.
+  bool async_revalidation_required;
+
   // True if the request was fetched over a SPDY channel.
   bool was_fetched_via_spdy;
 
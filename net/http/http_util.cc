@@ -13,6 +13,7 @@
 #include "base/logging.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/string_piece.h"
+#include "base/strings/string_split.h"
 #include "base/strings/string_tokenizer.h"
 #include "base/strings/string_util.h"
 #include "base/strings/stringprintf.h"
@@ -235,7 +236,7 @@ bool HttpUtil::ParseRangeHeader(const std::string& ranges_specifier,
     std::string::const_iterator first_byte_pos_end =
         first_byte_pos_begin +  minus_char_offset;
     TrimLWS(&first_byte_pos_begin, &first_byte_pos_end);
-    std::string first_byte_pos(first_byte_pos_begin, first_byte_pos_end);
+    base::StringPiece first_byte_pos(first_byte_pos_begin, first_byte_pos_end);
 
     HttpByteRange range;
     // Try to obtain first-byte-pos.
@@ -251,7 +252,7 @@ bool HttpUtil::ParseRangeHeader(const std::string& ranges_specifier,
     std::string::const_iterator last_byte_pos_end =
         byte_range_set_iterator.value_end();
     TrimLWS(&last_byte_pos_begin, &last_byte_pos_end);
-    std::string last_byte_pos(last_byte_pos_begin, last_byte_pos_end);
+    base::StringPiece last_byte_pos(last_byte_pos_begin, last_byte_pos_end);
 
     // We have last-byte-pos or suffix-byte-range-spec in this case.
     if (!last_byte_pos.empty()) {
@@ -364,31 +365,55 @@ std::string HttpUtil::StripHeaders(const std::string& headers,
   return stripped_headers;
 }
 
+namespace {
+
+// Pre-computed HttpUtil::HeaderNameHash() values, so a name can be matched
+// against the whole table with integer compares; the string comparison runs
+// only on a hash hit, to guard against collisions. HttpUtilTest.HeaderNameHash
+// verifies the constants.
+struct HeaderHashEntry {
+  uint32 hash;
+  const char* name;
+};
+
+bool HashedHeaderMatch(const HeaderHashEntry* table, size_t table_len,
+                       uint32 name_hash,
+                       std::string::const_iterator name_begin,
+                       std::string::const_iterator name_end) {
+  for (size_t i = 0; i < table_len; ++i) {
+    if (table[i].hash == name_hash &&
+        LowerCaseEqualsASCII(name_begin, name_end, table[i].name))
+      return true;
+  }
+  return false;
+}
+
+}  // namespace
+
 // static
 bool HttpUtil::IsNonCoalescingHeader(std::string::const_iterator name_begin,
                                      std::string::const_iterator name_end) {
   // NOTE: "set-cookie2" headers do not support expires attributes, so we don't
   // have to list them here.
-  const char* kNonCoalescingHeaders[] = {
-    "date",
-    "expires",
-    "last-modified",
-    "location",  // See bug 1050541 for details
-    "retry-after",
-    "set-cookie",
+  static const HeaderHashEntry kNonCoalescingHeaders[] = {
+    { 0xd472dc59, "date" },
+    { 0x3e8ec783, "expires" },
+    { 0xc0575a6b, "last-modified" },
+    { 0x0bf5a9a6, "location" },  // See bug 1050541 for details
+    { 0xc6da1376, "retry-after" },
+    { 0x6e2be738, "set-cookie" },
     // The format of auth-challenges mixes both space separated tokens and
     // comma separated properties, so coalescing on comma won't work.
-    "www-authenticate",
-    "proxy-authenticate",
+    { 0x2e7bcf02, "www-authenticate" },
+    { 0xa17edaef, "proxy-authenticate" },
     // STS specifies that UAs must not process any STS headers after the first
     // one.
-    "strict-transport-security"
+    { 0xf6a71e21, "strict-transport-security" }
   };
-  for (size_t i = 0; i < arraysize(kNonCoalescingHeaders); ++i) {
-    if (LowerCaseEqualsASCII(name_begin, name_end, kNonCoalescingHeaders[i]))
-      return true;
-  }
-  return false;
+  return HashedHeaderMatch(kNonCoalescingHeaders,
+                           arraysize(kNonCoalescingHeaders),
+                           HeaderNameHash(name_begin, name_end),
+                           name_begin, name_end);
 }
 
 bool HttpUtil::IsLWS(char c) {
@@ -651,16 +676,20 @@ std::string HttpUtil::GenerateAcceptLanguageHeader(
   // two floating point numbers.
   const unsigned int kQvalueDecrement10 = 2;
   unsigned int qvalue10 = 10;
-  base::StringTokenizer t(raw_language_list, ",");
+  base::StringPieceSplitter t(raw_language_list, ',');
   std::string lang_list_with_q;
   while (t.GetNext()) {
-    std::string language = t.token();
+    const base::StringPiece& language = t.piece();
+    // The tokenizer this replaced skipped empty entries; keep doing so.
+    if (language.empty())
+      continue;
     if (qvalue10 == 10) {
       // q=1.0 is implicit.
-      lang_list_with_q = language;
+      language.CopyToString(&lang_list_with_q);
     } else {
       DCHECK_LT(qvalue10, 10U);
-      base::StringAppendF(&lang_list_with_q, ",%s;q=0.%d", language.c_str(),
+      base::StringAppendF(&lang_list_with_q, ",%.*s;q=0.%d",
+                          static_cast<int>(language.size()), language.data(),
                           qvalue10);
     }
     // It does not make sense to have 'q=0'.
@@ -8,7 +8,9 @@
 #include <string>
 #include <vector>
 
+#include "base/basictypes.h"
 #include "base/memory/ref_counted.h"
+#include "base/strings/string_util.h"
 #include "base/strings/string_tokenizer.h"
 #include "net/base/net_export.h"
 #include "net/http/http_byte_range.h"
@@ -83,6 +85,22 @@ class NET_EXPORT HttpUtil {
                                   const char* const headers_to_remove[],
                                   size_t headers_to_remove_len);
 
+  // Case-folded FNV-1a hash of a header name. Fixed tables of header names
+  // embed these hashes so a lookup can reject non-matching entries with an
+  // integer compare, and HttpResponseHeaders caches them per parsed header.
+  template <typename Iterator>
+  static uint32 HeaderNameHash(Iterator name_begin, Iterator name_end) {
+    uint32 hash = 2166136261u;
+    for (Iterator it = name_begin; it != name_end; ++it) {
+      hash ^= static_cast<uint8>(base::ToLowerASCII(*it));
+      hash *= 16777619u;
+    }
+    return hash;
+  }
+  static uint32 HeaderNameHash(const std::string& name) {
+    return HeaderNameHash(name.begin(), name.end());
+  }
+
   // Multiple occurances of some headers cannot be coalesced into a comma-
   // separated list since their values are (or contain) unquoted HTTP-date
   // values, which may contain a comma (see RFC 2616 section 3.3.1).
@@ -100,6 +100,53 @@ TEST(HttpUtilTest, IsSafeHeader) {
   }
 }
 
+TEST(HttpUtilTest, HeaderNameHash) {
+  // The constants here must stay in sync with the pre-computed hashes
+  // embedded in the header tables in http_util.cc and
+  // http_response_headers.cc.
+  static const struct {
+    uint32 hash;
+    const char* name;
+  } tests[] = {
+    { 0xd472dc59, "date" },
+    { 0x3e8ec783, "expires" },
+    { 0xc0575a6b, "last-modified" },
+    { 0x0bf5a9a6, "location" },
+    { 0xc6da1376, "retry-after" },
+    { 0x6e2be738, "set-cookie" },
+    { 0x2e7bcf02, "www-authenticate" },
+    { 0xa17edaef, "proxy-authenticate" },
+    { 0xf6a71e21, "strict-transport-security" },
+    { 0x38b99ed9, "connection" },
+    { 0x32c09da6, "proxy-connection" },
+    { 0xe18edb80, "keep-alive" },
+    { 0x816fede0, "trailer" },
+    { 0xddb4744c, "transfer-encoding" },
+    { 0xdc97cc77, "upgrade" },
+    { 0x06c857c0, "etag" },
+    { 0xee0d1548, "x-frame-options" },
+    { 0x95132148, "x-xss-protection" },
+  };
+  for (size_t i = 0; i < ARRAYSIZE_UNSAFE(tests); ++i) {
+    EXPECT_EQ(tests[i].hash,
+              HttpUtil::HeaderNameHash(std::string(tests[i].name)))
+        << tests[i].name;
+    // The hash is case-folded.
+    EXPECT_EQ(tests[i].hash, HttpUtil::HeaderNameHash(
+        StringToUpperASCII(std::string(tests[i].name)))) << tests[i].name;
+  }
+}
+
+TEST(HttpUtilTest, IsNonCoalescingHeader) {
+  EXPECT_TRUE(HttpUtil::IsNonCoalescingHeader("date"));
+  EXPECT_TRUE(HttpUtil::IsNonCoalescingHeader("Set-Cookie"));
+  EXPECT_TRUE(HttpUtil::IsNonCoalescingHeader("WWW-Authenticate"));
+  EXPECT_TRUE(HttpUtil::IsNonCoalescingHeader("Strict-Transport-Security"));
+  EXPECT_FALSE(HttpUtil::IsNonCoalescingHeader("content-type"));
+  EXPECT_FALSE(HttpUtil::IsNonCoalescingHeader("cache-control"));
+  EXPECT_FALSE(HttpUtil::IsNonCoalescingHeader(""));
+}
+
 TEST(HttpUtilTest, HasHeader) {
   static const struct {
     const char* headers;
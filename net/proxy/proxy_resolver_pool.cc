@@ -0,0 +1,333 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/proxy/proxy_resolver_pool.h"
+
+#include <algorithm>
+
+#include "base/bind.h"
+#include "base/logging.h"
+#include "net/base/net_errors.h"
+
+namespace net {
+
+namespace {
+
+// Maximum number of entries in the memo cache of resolved URLs.
+const size_t kMaxCacheEntries = 256;
+
+// How long a successful resolution may be re-used for requests to the same
+// URL. PAC results can legitimately change over time (scripts may consult
+// DNS or the clock), so this is kept short.
+const unsigned kCacheEntryTTLSeconds = 60;
+
+}  // namespace
+
+// ProxyResolverPool::Entry ---------------------------------------------------
+
+// An Entry owns one underlying resolver, along with the bookkeeping needed
+// to dispatch requests to it.
+class ProxyResolverPool::Entry {
+ public:
+  explicit Entry(ProxyResolver* resolver)
+      : resolver_(resolver),
+        ready_(false),
+        provisioning_(false),
+        outstanding_jobs_(0) {}
+
+  ~Entry() {
+    // If the script was still being loaded into this resolver, the load must
+    // be cancelled before the resolver is destroyed.
+    if (provisioning_)
+      resolver_->CancelSetPacScript();
+  }
+
+  ProxyResolver* resolver() { return resolver_.get(); }
+
+  // True once the PAC script has been successfully loaded into the resolver.
+  bool ready() const { return ready_; }
+  void set_ready() { ready_ = true; }
+
+  // True while a SetPacScript() call on the resolver is outstanding.
+  void set_provisioning() { provisioning_ = true; }
+  void clear_provisioning() { provisioning_ = false; }
+
+  int outstanding_jobs() const { return outstanding_jobs_; }
+  void add_outstanding_job() { outstanding_jobs_++; }
+  void remove_outstanding_job() {
+    DCHECK_GT(outstanding_jobs_, 0);
+    outstanding_jobs_--;
+  }
+
+ private:
+  const scoped_ptr<ProxyResolver> resolver_;
+  bool ready_;
+  bool provisioning_;
+  int outstanding_jobs_;
+
+  DISALLOW_COPY_AND_ASSIGN(Entry);
+};
+
+// ProxyResolverPool::GetProxyForURLJob ---------------------------------------
+
+// Tracks one user request while it is outstanding on an underlying resolver.
+class ProxyResolverPool::GetProxyForURLJob {
+ public:
+  GetProxyForURLJob(ProxyResolverPool* pool,
+                    Entry* entry,
+                    const GURL& url,
+                    ProxyInfo* results,
+                    const CompletionCallback& callback)
+      : pool_(pool),
+        entry_(entry),
+        url_(url),
+        results_(results),
+        callback_(callback),
+        request_handle_(NULL) {}
+
+  Entry* entry() const { return entry_; }
+  const GURL& url() const { return url_; }
+  const ProxyInfo* results() const { return results_; }
+  const CompletionCallback& callback() const { return callback_; }
+
+  RequestHandle request_handle() const { return request_handle_; }
+  RequestHandle* request_handle_ptr() { return &request_handle_; }
+
+  void OnComplete(int result) { pool_->OnJobComplete(this, result); }
+
+ private:
+  ProxyResolverPool* const pool_;
+  Entry* const entry_;
+  const GURL url_;
+  ProxyInfo* const results_;
+  const CompletionCallback callback_;
+  RequestHandle request_handle_;
+
+  DISALLOW_COPY_AND_ASSIGN(GetProxyForURLJob);
+};
+
+// ProxyResolverPool ----------------------------------------------------------
+
+ProxyResolverPool::ProxyResolverPool(ProxyResolverFactory* resolver_factory,
+                                     size_t max_num_resolvers)
+    : ProxyResolver(resolver_factory->resolvers_expect_pac_bytes()),
+      resolver_factory_(resolver_factory),
+      max_num_resolvers_(max_num_resolvers),
+      result_cache_(kMaxCacheEntries) {
+  DCHECK_GE(max_num_resolvers, 1u);
+}
+
+ProxyResolverPool::~ProxyResolverPool() {
+  DCHECK(CalledOnValidThread());
+  // All user-initiated requests should have been cancelled by this point.
+  for (size_t i = 0; i < entries_.size(); ++i)
+    DCHECK_EQ(0, entries_[i]->outstanding_jobs());
+}
+
+int ProxyResolverPool::GetProxyForURL(const GURL& url,
+                                      ProxyInfo* results,
+                                      const CompletionCallback& callback,
+                                      RequestHandle* request,
+                                      const BoundNetLog& net_log) {
+  DCHECK(CalledOnValidThread());
+  DCHECK(!callback.is_null());
+  DCHECK(init_callback_.is_null());
+  DCHECK(current_script_data_.get())
+      << "Resolver is un-initialized. Must call SetPacScript() first!";
+
+  const ProxyInfo* cached =
+      result_cache_.Get(url.spec(), base::TimeTicks::Now());
+  if (cached) {
+    results->Use(*cached);
+    return OK;
+  }
+
+  // If every ready resolver is occupied and there is still room, provision
+  // another resolver in the background so the pool grows with demand.
+  Entry* entry = FindBestReadyEntry();
+  DCHECK(entry);
+  if (entry->outstanding_jobs() > 0 && entries_.size() < max_num_resolvers_) {
+    AddNewEntry();
+    // The new resolver may have become ready synchronously.
+    entry = FindBestReadyEntry();
+  }
+
+  GetProxyForURLJob* job =
+      new GetProxyForURLJob(this, entry, url, results, callback);
+  int rv = entry->resolver()->GetProxyForURL(
+      url,
+      results,
+      base::Bind(&GetProxyForURLJob::OnComplete, base::Unretained(job)),
+      job->request_handle_ptr(),
+      net_log);
+  if (rv != ERR_IO_PENDING) {
+    if (rv == OK)
+      AddCacheEntry(url, *results);
+    delete job;
+    return rv;
+  }
+
+  entry->add_outstanding_job();
+  *request = reinterpret_cast<RequestHandle>(job);
+  return ERR_IO_PENDING;
+}
+
+void ProxyResolverPool::CancelRequest(RequestHandle request) {
+  DCHECK(CalledOnValidThread());
+  DCHECK(request);
+
+  GetProxyForURLJob* job = reinterpret_cast<GetProxyForURLJob*>(request);
+  job->entry()->resolver()->CancelRequest(job->request_handle());
+  job->entry()->remove_outstanding_job();
+  delete job;
+}
+
+LoadState ProxyResolverPool::GetLoadState(RequestHandle request) const {
+  DCHECK(CalledOnValidThread());
+  DCHECK(request);
+
+  GetProxyForURLJob* job = reinterpret_cast<GetProxyForURLJob*>(request);
+  return job->entry()->resolver()->GetLoadState(job->request_handle());
+}
+
+void ProxyResolverPool::CancelSetPacScript() {
+  DCHECK(CalledOnValidThread());
+  DCHECK(!init_callback_.is_null());
+
+  init_callback_.Reset();
+  current_script_data_ = NULL;
+  // The Entry destructor cancels the outstanding script load.
+  entries_.clear();
+}
+
+int ProxyResolverPool::SetPacScript(
+    const scoped_refptr<ProxyResolverScriptData>& script_data,
+    const CompletionCallback& callback) {
+  DCHECK(CalledOnValidThread());
+  DCHECK(!callback.is_null());
+  for (size_t i = 0; i < entries_.size(); ++i)
+    DCHECK_EQ(0, entries_[i]->outstanding_jobs());
+
+  // The new script invalidates both the memoized results and any resolvers
+  // loaded with the previous script.
+  result_cache_.Clear();
+  entries_.clear();
+  current_script_data_ = script_data;
+
+  // Provision a single resolver to test the script. Additional resolvers are
+  // lazily provisioned from GetProxyForURL() once this has succeeded.
+  Entry* entry = new Entry(resolver_factory_->CreateProxyResolver());
+  entries_.push_back(entry);
+  int rv = entry->resolver()->SetPacScript(
+      script_data,
+      base::Bind(&ProxyResolverPool::OnInitialEntryReady,
+                 base::Unretained(this),
+                 entry));
+  if (rv == ERR_IO_PENDING) {
+    entry->set_provisioning();
+    init_callback_ = callback;
+    return rv;
+  }
+
+  // Synchronous completion.
+  if (rv == OK) {
+    entry->set_ready();
+  } else {
+    current_script_data_ = NULL;
+    entries_.clear();
+  }
+  return rv;
+}
+
+ProxyResolverPool::Entry* ProxyResolverPool::FindBestReadyEntry() {
+  Entry* best = NULL;
+  for (size_t i = 0; i < entries_.size(); ++i) {
+    Entry* entry = entries_[i];
+    if (!entry->ready())
+      continue;
+    if (!best || entry->outstanding_jobs() < best->outstanding_jobs())
+      best = entry;
+  }
+  return best;
+}
+
+ProxyResolverPool::Entry* ProxyResolverPool::AddNewEntry() {
+  Entry* entry = new Entry(resolver_factory_->CreateProxyResolver());
+  entries_.push_back(entry);
+  int rv = entry->resolver()->SetPacScript(
+      current_script_data_,
+      base::Bind(&ProxyResolverPool::OnBackgroundEntryReady,
+                 base::Unretained(this),
+                 entry));
+  if (rv == ERR_IO_PENDING) {
+    entry->set_provisioning();
+  } else if (rv == OK) {
+    entry->set_ready();
+  } else {
+    RemoveEntry(entry);
+    return NULL;
+  }
+  return entry;
+}
+
+void ProxyResolverPool::RemoveEntry(Entry* entry) {
+  ScopedVector<Entry>::iterator it =
+      std::find(entries_.begin(), entries_.end(), entry);
+  DCHECK(it != entries_.end());
+  entries_.erase(it);
+}
+
+void ProxyResolverPool::OnBackgroundEntryReady(Entry* entry, int result) {
+  DCHECK(CalledOnValidThread());
+  entry->clear_provisioning();
+  if (result == OK) {
+    entry->set_ready();
+  } else {
+    // The script was accepted by the initial resolver, so a failure here is
+    // unexpected; continue with the resolvers that loaded successfully.
+    LOG(WARNING) << "Failed provisioning extra PAC resolver: " << result;
+    RemoveEntry(entry);
+  }
+}
+
+void ProxyResolverPool::OnInitialEntryReady(Entry* entry, int result) {
+  DCHECK(CalledOnValidThread());
+  DCHECK(!init_callback_.is_null());
+
+  entry->clear_provisioning();
+  if (result == OK) {
+    entry->set_ready();
+  } else {
+    current_script_data_ = NULL;
+    RemoveEntry(entry);
+  }
+
+  CompletionCallback callback = init_callback_;
+  init_callback_.Reset();
+  callback.Run(result);
+}
+
+void ProxyResolverPool::OnJobComplete(GetProxyForURLJob* job, int result) {
+  DCHECK(CalledOnValidThread());
+
+  job->entry()->remove_outstanding_job();
+  if (result == OK)
+    AddCacheEntry(job->url(), *job->results());
+
+  // Run the callback last, since it may delete |this| or start new requests.
+  CompletionCallback callback = job->callback();
+  delete job;
+  callback.Run(result);
+}
+
+void ProxyResolverPool::AddCacheEntry(const GURL& url,
+                                      const ProxyInfo& results) {
+  base::TimeTicks now = base::TimeTicks::Now();
+  result_cache_.Put(url.spec(),
+                    results,
+                    now,
+                    now + base::TimeDelta::FromSeconds(kCacheEntryTTLSeconds));
+}
+
+}  // namespace net
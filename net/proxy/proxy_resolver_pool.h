@@ -0,0 +1,118 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_PROXY_PROXY_RESOLVER_POOL_H_
+#define NET_PROXY_PROXY_RESOLVER_POOL_H_
+
+#include <string>
+
+#include "base/basictypes.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/memory/scoped_vector.h"
+#include "base/threading/non_thread_safe.h"
+#include "base/time/time.h"
+#include "net/base/expiring_cache.h"
+#include "net/base/net_export.h"
+#include "net/proxy/multi_threaded_proxy_resolver.h"
+#include "net/proxy/proxy_info.h"
+#include "net/proxy/proxy_resolver.h"
+
+namespace net {
+
+// ProxyResolverPool is a ProxyResolver implementation that fans
+// GetProxyForURL() requests out over a set of ProxyResolver instances which
+// are themselves asynchronous (for example ProxyResolverV8Tracing, which
+// runs on a thread of its own). Each request is dispatched to the least
+// busy resolver, so resolutions proceed in parallel instead of queueing
+// behind a single evaluation context.
+//
+// During initialization (SetPacScript), a single resolver is provisioned to
+// test the script. If this succeeds, the input script is cached and re-used
+// to lazily provision additional resolvers as load demands, up to a maximum
+// total.
+//
+// Successful resolutions are additionally memoized per URL for a short time,
+// so a burst of requests for the same URL costs one script evaluation.
+//
+// Because multiple resolver instances are created, script contexts are
+// duplicated for what is ordinarily seen as being a single script. The same
+// compatibility caveats apply as for MultiThreadedProxyResolver; see the
+// comments there.
+class NET_EXPORT_PRIVATE ProxyResolverPool
+    : public ProxyResolver,
+      NON_EXPORTED_BASE(public base::NonThreadSafe) {
+ public:
+  // Creates an asynchronous ProxyResolver that distributes requests over up
+  // to |max_num_resolvers| resolvers provisioned using |resolver_factory|.
+  //
+  // All methods on the provisioned ProxyResolvers are called on the origin
+  // thread, so the factory must create resolvers which complete their work
+  // asynchronously (without blocking the caller).
+  //
+  // The constructor takes ownership of |resolver_factory|.
+  ProxyResolverPool(ProxyResolverFactory* resolver_factory,
+                    size_t max_num_resolvers);
+
+  virtual ~ProxyResolverPool();
+
+  // ProxyResolver implementation:
+  virtual int GetProxyForURL(const GURL& url,
+                             ProxyInfo* results,
+                             const CompletionCallback& callback,
+                             RequestHandle* request,
+                             const BoundNetLog& net_log) OVERRIDE;
+  virtual void CancelRequest(RequestHandle request) OVERRIDE;
+  virtual LoadState GetLoadState(RequestHandle request) const OVERRIDE;
+  virtual void CancelSetPacScript() OVERRIDE;
+  virtual int SetPacScript(
+      const scoped_refptr<ProxyResolverScriptData>& script_data,
+      const CompletionCallback& callback) OVERRIDE;
+
+ private:
+  class Entry;
+  class GetProxyForURLJob;
+
+  typedef ExpiringCache<std::string, ProxyInfo, base::TimeTicks,
+                        std::less<base::TimeTicks> > ResultCache;
+
+  // Returns the ready entry with the fewest outstanding requests, or NULL if
+  // no entry has finished loading the script yet.
+  Entry* FindBestReadyEntry();
+
+  // Creates a new resolver and starts loading |current_script_data_| into
+  // it. The entry becomes ready once the load completes.
+  Entry* AddNewEntry();
+
+  // Deletes |entry| and removes it from |entries_|.
+  void RemoveEntry(Entry* entry);
+
+  // Callback for the script load of a lazily provisioned entry.
+  void OnBackgroundEntryReady(Entry* entry, int result);
+
+  // Callback for the script load of the initial entry, which completes the
+  // user's SetPacScript() call.
+  void OnInitialEntryReady(Entry* entry, int result);
+
+  // Called by GetProxyForURLJob when the underlying resolver completes.
+  void OnJobComplete(GetProxyForURLJob* job, int result);
+
+  // Memoizes a successful resolution of |url|.
+  void AddCacheEntry(const GURL& url, const ProxyInfo& results);
+
+  const scoped_ptr<ProxyResolverFactory> resolver_factory_;
+  const size_t max_num_resolvers_;
+  ScopedVector<Entry> entries_;
+  scoped_refptr<ProxyResolverScriptData> current_script_data_;
+  ResultCache result_cache_;
+
+  // The callback of the in-progress SetPacScript() call, if any.
+  CompletionCallback init_callback_;
+
+  DISALLOW_COPY_AND_ASSIGN(ProxyResolverPool);
+};
+
+}  // namespace net
+
+#endif  // NET_PROXY_PROXY_RESOLVER_POOL_H_
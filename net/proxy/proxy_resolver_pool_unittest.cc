@@ -0,0 +1,225 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/proxy/proxy_resolver_pool.h"
+
+#include <vector>
+
+#include "net/base/net_errors.h"
+#include "net/base/net_log.h"
+#include "net/base/test_completion_callback.h"
+#include "net/proxy/mock_proxy_resolver.h"
+#include "net/proxy/proxy_info.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace net {
+
+namespace {
+
+// A factory that hands out MockAsyncProxyResolverExpectsBytes instances and
+// remembers (but does not own) what it created, so tests can drive the
+// underlying resolvers directly.
+class TrackingProxyResolverFactory : public ProxyResolverFactory {
+ public:
+  TrackingProxyResolverFactory()
+      : ProxyResolverFactory(true /*expects_pac_bytes*/) {}
+
+  virtual ProxyResolver* CreateProxyResolver() OVERRIDE {
+    MockAsyncProxyResolverExpectsBytes* resolver =
+        new MockAsyncProxyResolverExpectsBytes;
+    resolvers_.push_back(resolver);
+    return resolver;
+  }
+
+  // Note that the pool owns the resolvers; entries here dangle once the
+  // pool has released the corresponding resolver.
+  std::vector<MockAsyncProxyResolverBase*> resolvers_;
+};
+
+class ProxyResolverPoolTest : public testing::Test {
+ protected:
+  ProxyResolverPoolTest()
+      : factory_(new TrackingProxyResolverFactory),
+        pool_(factory_, 3 /*max_num_resolvers*/) {}
+
+  // Loads a PAC script into the pool, completing the load on the underlying
+  // resolver with |rv|.
+  void InitPool(int rv) {
+    TestCompletionCallback callback;
+    ASSERT_EQ(ERR_IO_PENDING,
+              pool_.SetPacScript(ProxyResolverScriptData::FromUTF8("pac"),
+                                 callback.callback()));
+    ASSERT_EQ(1u, factory_->resolvers_.size());
+    resolver(0)->pending_set_pac_script_request()->CompleteNow(rv);
+    EXPECT_EQ(rv, callback.WaitForResult());
+  }
+
+  MockAsyncProxyResolverBase* resolver(size_t i) {
+    return factory_->resolvers_[i];
+  }
+
+  TrackingProxyResolverFactory* factory_;  // Owned by |pool_|.
+  ProxyResolverPool pool_;
+};
+
+TEST_F(ProxyResolverPoolTest, SingleRequest) {
+  InitPool(OK);
+
+  ProxyInfo results;
+  TestCompletionCallback callback;
+  ProxyResolver::RequestHandle request;
+  int rv = pool_.GetProxyForURL(GURL("http://request/"), &results,
+                                callback.callback(), &request, BoundNetLog());
+  EXPECT_EQ(ERR_IO_PENDING, rv);
+  ASSERT_EQ(1u, resolver(0)->pending_requests().size());
+
+  resolver(0)->pending_requests()[0]->results()->UseNamedProxy("foopy:80");
+  resolver(0)->pending_requests()[0]->CompleteNow(OK);
+
+  EXPECT_EQ(OK, callback.WaitForResult());
+  EXPECT_EQ("foopy:80", results.proxy_server().ToURI());
+}
+
+TEST_F(ProxyResolverPoolTest, GrowsWithConcurrentRequests) {
+  InitPool(OK);
+
+  // The first request occupies the sole ready resolver, so the pool should
+  // start provisioning a second one in the background.
+  ProxyInfo results1;
+  TestCompletionCallback callback1;
+  ProxyResolver::RequestHandle request1;
+  EXPECT_EQ(ERR_IO_PENDING,
+            pool_.GetProxyForURL(GURL("http://request1/"), &results1,
+                                 callback1.callback(), &request1,
+                                 BoundNetLog()));
+  ASSERT_EQ(2u, factory_->resolvers_.size());
+  EXPECT_TRUE(resolver(1)->has_pending_set_pac_script_request());
+
+  // Until the new resolver has loaded the script, concurrent requests keep
+  // going to the ready resolver.
+  ProxyInfo results2;
+  TestCompletionCallback callback2;
+  ProxyResolver::RequestHandle request2;
+  EXPECT_EQ(ERR_IO_PENDING,
+            pool_.GetProxyForURL(GURL("http://request2/"), &results2,
+                                 callback2.callback(), &request2,
+                                 BoundNetLog()));
+  EXPECT_EQ(2u, resolver(0)->pending_requests().size());
+
+  // Once ready, the new resolver is the least busy one and receives the next
+  // request.
+  resolver(1)->pending_set_pac_script_request()->CompleteNow(OK);
+  ProxyInfo results3;
+  TestCompletionCallback callback3;
+  ProxyResolver::RequestHandle request3;
+  EXPECT_EQ(ERR_IO_PENDING,
+            pool_.GetProxyForURL(GURL("http://request3/"), &results3,
+                                 callback3.callback(), &request3,
+                                 BoundNetLog()));
+  ASSERT_EQ(1u, resolver(1)->pending_requests().size());
+
+  resolver(0)->pending_requests()[0]->CompleteNow(OK);
+  resolver(0)->pending_requests()[0]->CompleteNow(OK);
+  resolver(1)->pending_requests()[0]->CompleteNow(OK);
+  EXPECT_EQ(OK, callback1.WaitForResult());
+  EXPECT_EQ(OK, callback2.WaitForResult());
+  EXPECT_EQ(OK, callback3.WaitForResult());
+}
+
+TEST_F(ProxyResolverPoolTest, MemoizesSameURLResults) {
+  InitPool(OK);
+
+  ProxyInfo results1;
+  TestCompletionCallback callback1;
+  ProxyResolver::RequestHandle request1;
+  EXPECT_EQ(ERR_IO_PENDING,
+            pool_.GetProxyForURL(GURL("http://request/"), &results1,
+                                 callback1.callback(), &request1,
+                                 BoundNetLog()));
+  resolver(0)->pending_requests()[0]->results()->UseNamedProxy("foopy:80");
+  resolver(0)->pending_requests()[0]->CompleteNow(OK);
+  EXPECT_EQ(OK, callback1.WaitForResult());
+
+  // A repeat request for the same URL completes synchronously from the memo
+  // cache, without reaching any resolver.
+  ProxyInfo results2;
+  TestCompletionCallback callback2;
+  ProxyResolver::RequestHandle request2;
+  EXPECT_EQ(OK,
+            pool_.GetProxyForURL(GURL("http://request/"), &results2,
+                                 callback2.callback(), &request2,
+                                 BoundNetLog()));
+  EXPECT_EQ("foopy:80", results2.proxy_server().ToURI());
+  EXPECT_TRUE(resolver(0)->pending_requests().empty());
+
+  // A different URL misses the cache.
+  ProxyInfo results3;
+  TestCompletionCallback callback3;
+  ProxyResolver::RequestHandle request3;
+  EXPECT_EQ(ERR_IO_PENDING,
+            pool_.GetProxyForURL(GURL("http://other/"), &results3,
+                                 callback3.callback(), &request3,
+                                 BoundNetLog()));
+  resolver(0)->pending_requests()[0]->CompleteNow(OK);
+  EXPECT_EQ(OK, callback3.WaitForResult());
+}
+
+TEST_F(ProxyResolverPoolTest, NewScriptInvalidatesMemoizedResults) {
+  InitPool(OK);
+
+  ProxyInfo results1;
+  TestCompletionCallback callback1;
+  ProxyResolver::RequestHandle request1;
+  EXPECT_EQ(ERR_IO_PENDING,
+            pool_.GetProxyForURL(GURL("http://request/"), &results1,
+                                 callback1.callback(), &request1,
+                                 BoundNetLog()));
+  resolver(0)->pending_requests()[0]->results()->UseNamedProxy("foopy:80");
+  resolver(0)->pending_requests()[0]->CompleteNow(OK);
+  EXPECT_EQ(OK, callback1.WaitForResult());
+
+  // Load a new script. The previously provisioned resolver is released and
+  // a fresh one is created.
+  TestCompletionCallback script_callback;
+  ASSERT_EQ(ERR_IO_PENDING,
+            pool_.SetPacScript(ProxyResolverScriptData::FromUTF8("pac2"),
+                               script_callback.callback()));
+  ASSERT_EQ(2u, factory_->resolvers_.size());
+  resolver(1)->pending_set_pac_script_request()->CompleteNow(OK);
+  EXPECT_EQ(OK, script_callback.WaitForResult());
+
+  // The memoized result from the old script must not be served.
+  ProxyInfo results2;
+  TestCompletionCallback callback2;
+  ProxyResolver::RequestHandle request2;
+  EXPECT_EQ(ERR_IO_PENDING,
+            pool_.GetProxyForURL(GURL("http://request/"), &results2,
+                                 callback2.callback(), &request2,
+                                 BoundNetLog()));
+  resolver(1)->pending_requests()[0]->CompleteNow(OK);
+  EXPECT_EQ(OK, callback2.WaitForResult());
+}
+
+TEST_F(ProxyResolverPoolTest, CancelRequest) {
+  InitPool(OK);
+
+  ProxyInfo results;
+  TestCompletionCallback callback;
+  ProxyResolver::RequestHandle request;
+  EXPECT_EQ(ERR_IO_PENDING,
+            pool_.GetProxyForURL(GURL("http://request/"), &results,
+                                 callback.callback(), &request,
+                                 BoundNetLog()));
+  ASSERT_EQ(1u, resolver(0)->pending_requests().size());
+
+  pool_.CancelRequest(request);
+  EXPECT_TRUE(resolver(0)->pending_requests().empty());
+  ASSERT_EQ(1u, resolver(0)->cancelled_requests().size());
+  EXPECT_FALSE(callback.have_result());
+}
+
+}  // namespace
+
+}  // namespace net
@@ -6,11 +6,14 @@
 
 #include <algorithm>
 #include <cstdio>
+#include <map>
 
 #include "base/basictypes.h"
 #include "base/compiler_specific.h"
 #include "base/debug/leak_annotations.h"
+#include "base/lazy_instance.h"
 #include "base/logging.h"
+#include "base/memory/linked_ptr.h"
 #include "base/strings/string_tokenizer.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
@@ -337,6 +340,60 @@ bool IsInNetEx(const std::string& ip_address, const std::string& ip_prefix) {
   return IPNumberMatchesPrefix(address, prefix, prefix_length_in_bits);
 }
 
+// Caches compiled-but-unbound scripts for the shared proxy resolver
+// isolate. SetPacScript() compiles both the constant PAC utility library
+// and the user's script every time a context is initialized, even though
+// the script text rarely changes: the resolver is re-initialized whenever
+// the PAC configuration is re-fetched, and each thread of a multi-threaded
+// resolver sets the same script. v8::UnboundScript is context independent,
+// so one compile can serve every context in the isolate. Entries are only
+// added for the default isolate, which lives for the remainder of the
+// process; private isolates are torn down with their resolver, which would
+// leave disposed scripts behind. Calls are serialized by the isolate's
+// v8::Locker.
+class UnboundScriptCache {
+ public:
+  UnboundScriptCache() {}
+
+  // Returns the cached script whose source is |key| bound to the current
+  // context, or an empty handle on a miss.
+  v8::Local<v8::Script> Lookup(v8::Isolate* isolate,
+                               const base::string16& key) {
+    EntryMap::iterator it = entries_.find(key);
+    if (it == entries_.end())
+      return v8::Local<v8::Script>();
+    return v8::Local<v8::UnboundScript>::New(isolate, *it->second)
+        ->BindToCurrentContext();
+  }
+
+  void Store(v8::Isolate* isolate,
+             const base::string16& key,
+             v8::Handle<v8::UnboundScript> script) {
+    // A handful of entries covers the utility library and the scripts in
+    // active use; toss everything rather than let stale scripts accumulate.
+    if (entries_.size() >= kMaxEntries)
+      entries_.clear();
+    linked_ptr<v8::UniquePersistent<v8::UnboundScript> > entry(
+        new v8::UniquePersistent<v8::UnboundScript>());
+    entry->Reset(isolate, script);
+    entries_[key] = entry;
+  }
+
+ private:
+  static const size_t kMaxEntries = 4;
+
+  typedef std::map<base::string16,
+                   linked_ptr<v8::UniquePersistent<v8::UnboundScript> > >
+      EntryMap;
+
+  EntryMap entries_;
+
+  DISALLOW_COPY_AND_ASSIGN(UnboundScriptCache);
+};
+
+base::LazyInstance<UnboundScriptCache>::Leaky g_script_cache =
+    LAZY_INSTANCE_INITIALIZER;
+
 }  // namespace
 
 // ProxyResolverV8::Context ---------------------------------------------------
@@ -533,10 +590,27 @@ class ProxyResolverV8::Context {
   int RunScript(v8::Handle<v8::String> script, const char* script_name) {
     v8::TryCatch try_catch;
 
-    // Compile the script.
-    v8::ScriptOrigin origin =
-        v8::ScriptOrigin(ASCIILiteralToV8String(isolate_, script_name));
-    v8::Local<v8::Script> code = v8::Script::Compile(script, &origin);
+    // Compile the script, preferring a previously compiled copy when this
+    // context runs in the shared isolate.
+    v8::Local<v8::Script> code;
+    const bool use_cache = !parent_->use_private_isolate_;
+    base::string16 cache_key;
+    if (use_cache) {
+      cache_key = V8StringToUTF16(script);
+      code = g_script_cache.Get().Lookup(isolate_, cache_key);
+    }
+    if (code.IsEmpty()) {
+      v8::ScriptOrigin origin =
+          v8::ScriptOrigin(ASCIILiteralToV8String(isolate_, script_name));
+      v8::ScriptCompiler::Source source(script, origin);
+      v8::Local<v8::UnboundScript> unbound_script =
+          v8::ScriptCompiler::CompileUnbound(isolate_, &source);
+      if (!unbound_script.IsEmpty()) {
+        if (use_cache)
+          g_script_cache.Get().Store(isolate_, cache_key, unbound_script);
+        code = unbound_script->BindToCurrentContext();
+      }
+    }
 
     // Execute.
     if (!code.IsEmpty())
@@ -709,6 +783,13 @@ class ProxyResolverV8::Context {
 
 ProxyResolverV8::ProxyResolverV8()
     : ProxyResolver(true /*expects_pac_bytes*/),
+      use_private_isolate_(false),
+      js_bindings_(NULL) {
+}
+
+ProxyResolverV8::ProxyResolverV8(bool use_private_isolate)
+    : ProxyResolver(true /*expects_pac_bytes*/),
+      use_private_isolate_(use_private_isolate),
       js_bindings_(NULL) {
 }
 
@@ -757,13 +838,23 @@ int ProxyResolverV8::SetPacScript(
     return ERR_PAC_SCRIPT_FAILED;
 
   // Try parsing the PAC script.
-  scoped_ptr<Context> context(new Context(this, GetDefaultIsolate()));
+  scoped_ptr<Context> context(new Context(this, GetIsolate()));
   int rv = context->InitV8(script_data);
   if (rv == OK)
     context_.reset(context.release());
   return rv;
 }
 
+v8::Isolate* ProxyResolverV8::GetIsolate() {
+  if (!use_private_isolate_)
+    return GetDefaultIsolate();
+  if (!private_isolate_) {
+    private_isolate_.reset(
+        new gin::IsolateHolder(gin::IsolateHolder::kNonStrictMode));
+  }
+  return private_isolate_->isolate();
+}
+
 // static
 void ProxyResolverV8::EnsureIsolateCreated() {
   if (g_proxy_resolver_isolate_)
@@ -39,6 +39,10 @@ namespace net {
 // This is the case with the V8 instance used by chromium's renderer -- it runs
 // on a different thread from ProxyResolver (renderer thread vs PAC thread),
 // and does not use locking since it expects to be alone.
+//
+// Note that the v8::Locker is per-isolate: instances constructed with
+// |use_private_isolate| set to true each run in their own isolate, and hence
+// can execute concurrently with each other on different threads.
 class NET_EXPORT_PRIVATE ProxyResolverV8 : public ProxyResolver {
  public:
   // Interface for the javascript bindings.
@@ -73,9 +77,16 @@ class NET_EXPORT_PRIVATE ProxyResolverV8 : public ProxyResolver {
     virtual ~JSBindings() {}
   };
 
-  // Constructs a ProxyResolverV8.
+  // Constructs a ProxyResolverV8 that runs in the process-wide default
+  // isolate (see EnsureIsolateCreated()).
   ProxyResolverV8();
 
+  // Constructs a ProxyResolverV8. If |use_private_isolate| is true, the
+  // resolver lazily creates a v8::Isolate of its own rather than using the
+  // process-wide default isolate, so its script executions do not serialize
+  // against other ProxyResolverV8 instances running on other threads.
+  explicit ProxyResolverV8(bool use_private_isolate);
+
   virtual ~ProxyResolverV8();
 
   JSBindings* js_bindings() const { return js_bindings_; }
@@ -114,6 +125,17 @@ class NET_EXPORT_PRIVATE ProxyResolverV8 : public ProxyResolver {
   // SetPacScript().
   class Context;
 
+  // Returns the isolate new contexts should run in, creating the private
+  // isolate on first use if this resolver was configured with one.
+  v8::Isolate* GetIsolate();
+
+  const bool use_private_isolate_;
+
+  // The private isolate, if |use_private_isolate_| is true; NULL until the
+  // first call to SetPacScript(). Declared before |context_| so that the
+  // context is destroyed before the isolate it lives in.
+  scoped_ptr<gin::IsolateHolder> private_isolate_;
+
   scoped_ptr<Context> context_;
 
   JSBindings* js_bindings_;
@@ -1103,14 +1103,31 @@ ProxyResolverV8Tracing::ProxyResolverV8Tracing(
       error_observer_(error_observer),
       net_log_(net_log),
       num_outstanding_callbacks_(0) {
-  DCHECK(host_resolver);
+  Init(false /*use_private_v8_isolate*/);
+}
+
+ProxyResolverV8Tracing::ProxyResolverV8Tracing(
+    HostResolver* host_resolver,
+    ProxyResolverErrorObserver* error_observer,
+    NetLog* net_log,
+    bool use_private_v8_isolate)
+    : ProxyResolver(true /*expects_pac_bytes*/),
+      host_resolver_(host_resolver),
+      error_observer_(error_observer),
+      net_log_(net_log),
+      num_outstanding_callbacks_(0) {
+  Init(use_private_v8_isolate);
+}
+
+void ProxyResolverV8Tracing::Init(bool use_private_v8_isolate) {
+  DCHECK(host_resolver_);
   // Start up the thread.
   thread_.reset(new base::Thread("Proxy resolver"));
   base::Thread::Options options;
   options.timer_slack = base::TIMER_SLACK_MAXIMUM;
   CHECK(thread_->StartWithOptions(options));
 
-  v8_resolver_.reset(new ProxyResolverV8);
+  v8_resolver_.reset(new ProxyResolverV8(use_private_v8_isolate));
 }
 
 ProxyResolverV8Tracing::~ProxyResolverV8Tracing() {
@@ -42,6 +42,15 @@ class NET_EXPORT_PRIVATE ProxyResolverV8Tracing
                          ProxyResolverErrorObserver* error_observer,
                          NetLog* net_log);
 
+  // Same as above, but if |use_private_v8_isolate| is true the underlying
+  // ProxyResolverV8 runs in a v8::Isolate of its own, so executions do not
+  // serialize against other V8 proxy resolvers in the process. See the
+  // threading notes in net/proxy/proxy_resolver_v8.h.
+  ProxyResolverV8Tracing(HostResolver* host_resolver,
+                         ProxyResolverErrorObserver* error_observer,
+                         NetLog* net_log,
+                         bool use_private_v8_isolate);
+
   virtual ~ProxyResolverV8Tracing();
 
   // ProxyResolver implementation:
@@ -60,6 +69,10 @@ class NET_EXPORT_PRIVATE ProxyResolverV8Tracing
  private:
   class Job;
 
+  // Shared constructor guts: starts the worker thread and creates the
+  // ProxyResolverV8.
+  void Init(bool use_private_v8_isolate);
+
   // The worker thread on which the ProxyResolverV8 will be run.
   scoped_ptr<base::Thread> thread_;
   scoped_ptr<ProxyResolverV8> v8_resolver_;
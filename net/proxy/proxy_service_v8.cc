@@ -5,13 +5,53 @@
 #include "net/proxy/proxy_service_v8.h"
 
 #include "base/logging.h"
+#include "base/message_loop/message_loop_proxy.h"
 #include "net/proxy/network_delegate_error_observer.h"
 #include "net/proxy/proxy_resolver.h"
+#include "net/proxy/proxy_resolver_pool.h"
 #include "net/proxy/proxy_resolver_v8_tracing.h"
 #include "net/proxy/proxy_service.h"
 
 namespace net {
 
+namespace {
+
+// The maximum number of parallel V8 evaluation contexts to provision. Each
+// context runs in its own isolate on its own thread, so with a slow PAC
+// script resolutions scale across cores rather than queueing behind a
+// single evaluation.
+const size_t kMaxNumV8Resolvers = 4;
+
+// Creates ProxyResolverV8Tracing instances for ProxyResolverPool, each with
+// a private v8::Isolate and its own error observer.
+class ProxyResolverFactoryForV8Tracing : public ProxyResolverFactory {
+ public:
+  ProxyResolverFactoryForV8Tracing(HostResolver* host_resolver,
+                                   NetLog* net_log,
+                                   NetworkDelegate* network_delegate)
+      : ProxyResolverFactory(true /*expects_pac_bytes*/),
+        host_resolver_(host_resolver),
+        net_log_(net_log),
+        network_delegate_(network_delegate) {}
+
+  // ProxyResolverFactory override.
+  virtual ProxyResolver* CreateProxyResolver() OVERRIDE {
+    return new ProxyResolverV8Tracing(
+        host_resolver_,
+        new NetworkDelegateErrorObserver(
+            network_delegate_, base::MessageLoopProxy::current().get()),
+        net_log_,
+        true /*use_private_v8_isolate*/);
+  }
+
+ private:
+  HostResolver* const host_resolver_;
+  NetLog* const net_log_;
+  NetworkDelegate* const network_delegate_;
+};
+
+}  // namespace
+
 // static
 ProxyService* CreateProxyServiceUsingV8ProxyResolver(
     ProxyConfigService* proxy_config_service,
@@ -25,11 +65,10 @@ ProxyService* CreateProxyServiceUsingV8ProxyResolver(
   DCHECK(dhcp_proxy_script_fetcher);
   DCHECK(host_resolver);
 
-  ProxyResolverErrorObserver* error_observer = new NetworkDelegateErrorObserver(
-      network_delegate, base::MessageLoopProxy::current().get());
-
-  ProxyResolver* proxy_resolver =
-      new ProxyResolverV8Tracing(host_resolver, error_observer, net_log);
+  ProxyResolver* proxy_resolver = new ProxyResolverPool(
+      new ProxyResolverFactoryForV8Tracing(host_resolver, net_log,
+                                           network_delegate),
+      kMaxNumV8Resolvers);
 
   ProxyService* proxy_service =
       new ProxyService(proxy_config_service, proxy_resolver, net_log);
@@ -33,6 +33,10 @@ namespace {
 // before allowing the requests to possibly proceed over TCP.
 const int k0RttHandshakeTimeoutMs = 300;
 
+// The maximum number of datagrams pulled off the socket and processed as one
+// batch before yielding to the message loop.
+const size_t kPacketReadBatchSize = 32;
+
 // Histograms for tracking down the crashes from http://crbug.com/354669
 // Note: these values must be kept in sync with the corresponding values in:
 // tools/metrics/histograms/histograms.xml
@@ -151,16 +155,19 @@ QuicClientSession::QuicClientSession(
       stream_factory_(stream_factory),
       socket_(socket.Pass()),
       writer_(writer.Pass()),
-      read_buffer_(new IOBufferWithSize(kMaxPacketSize)),
+      read_buffers_(kPacketReadBatchSize),
+      read_buffer_lengths_(kPacketReadBatchSize),
+      num_buffered_packets_(0),
       server_info_(server_info.Pass()),
       read_pending_(false),
       num_total_streams_(0),
       task_runner_(task_runner),
       net_log_(BoundNetLog::Make(net_log, NetLog::SOURCE_QUIC_SESSION)),
       logger_(net_log_),
-      num_packets_read_(0),
       going_away_(false),
       weak_factory_(this) {
+  for (size_t i = 0; i < read_buffers_.size(); ++i)
+    read_buffers_[i] = new IOBufferWithSize(kMaxPacketSize);
   crypto_stream_.reset(
       crypto_client_stream_factory ?
           crypto_client_stream_factory->CreateQuicCryptoClientStream(
@@ -674,28 +681,44 @@ void QuicClientSession::StartReading() {
   if (read_pending_) {
     return;
   }
-  read_pending_ = true;
-  int rv = socket_->Read(read_buffer_.get(),
-                         read_buffer_->size(),
-                         base::Bind(&QuicClientSession::OnReadComplete,
-                                    weak_factory_.GetWeakPtr()));
-  if (rv == ERR_IO_PENDING) {
-    num_packets_read_ = 0;
-    return;
-  }
 
-  if (++num_packets_read_ > 32) {
-    num_packets_read_ = 0;
-    // Data was read, process it.
-    // Schedule the work through the message loop to 1) prevent infinite
-    // recursion and 2) avoid blocking the thread for too long.
-    base::MessageLoop::current()->PostTask(
-        FROM_HERE,
-        base::Bind(&QuicClientSession::OnReadComplete,
-                   weak_factory_.GetWeakPtr(), rv));
-  } else {
-    OnReadComplete(rv);
+  // Pull datagrams off the socket while reads complete synchronously,
+  // buffering them so that a whole batch is decrypted and processed in one
+  // pass instead of paying a read callback per packet.
+  while (num_buffered_packets_ < read_buffers_.size()) {
+    read_pending_ = true;
+    int rv = socket_->Read(read_buffers_[num_buffered_packets_].get(),
+                           read_buffers_[num_buffered_packets_]->size(),
+                           base::Bind(&QuicClientSession::OnReadComplete,
+                                      weak_factory_.GetWeakPtr()));
+    if (rv == ERR_IO_PENDING) {
+      // The socket is drained. Process what was batched; OnReadComplete will
+      // deliver the packet that completes asynchronously.
+      ProcessBufferedPackets();
+      return;
+    }
+    read_pending_ = false;
+
+    if (rv <= 0) {
+      // Deliver the packets that arrived ahead of the error before letting
+      // the error close the session.
+      if (!ProcessBufferedPackets())
+        return;
+      OnReadComplete(rv);
+      return;
+    }
+    read_buffer_lengths_[num_buffered_packets_++] = rv;
   }
+
+  // A full batch was read without draining the socket. Process it, then
+  // schedule the next batch through the message loop to avoid blocking the
+  // thread for too long.
+  if (!ProcessBufferedPackets())
+    return;
+  base::MessageLoop::current()->PostTask(
+      FROM_HERE,
+      base::Bind(&QuicClientSession::StartReading,
+                 weak_factory_.GetWeakPtr()));
 }
 
 void QuicClientSession::CloseSessionOnError(int error) {
@@ -791,19 +814,44 @@ void QuicClientSession::OnReadComplete(int result) {
     return;
   }
 
-  QuicEncryptedPacket packet(read_buffer_->data(), result);
+  // Any earlier batch was processed before this read went asynchronous, so
+  // the packet it delivered is the first of a new batch.
+  DCHECK_EQ(0u, num_buffered_packets_);
+  read_buffer_lengths_[0] = result;
+  num_buffered_packets_ = 1;
+  StartReading();
+}
+
+bool QuicClientSession::ProcessBufferedPackets() {
+  if (num_buffered_packets_ == 0)
+    return true;
+
   IPEndPoint local_address;
   IPEndPoint peer_address;
   socket_->GetLocalAddress(&local_address);
   socket_->GetPeerAddress(&peer_address);
   // ProcessUdpPacket might result in |this| being deleted, so we
   // use a weak pointer to be safe.
-  connection()->ProcessUdpPacket(local_address, peer_address, packet);
-  if (!connection()->connected()) {
-    NotifyFactoryOfSessionClosedLater();
-    return;
+  base::WeakPtr<QuicClientSession> weak_this = weak_factory_.GetWeakPtr();
+  for (size_t i = 0; i < num_buffered_packets_; ++i) {
+    QuicEncryptedPacket packet(read_buffers_[i]->data(),
+                               read_buffer_lengths_[i]);
+    connection()->ProcessUdpPacket(local_address, peer_address, packet);
+    if (!weak_this)
+      return false;
+    if (!connection()->connected()) {
+      num_buffered_packets_ = 0;
+      NotifyFactoryOfSessionClosedLater();
+      return false;
+    }
   }
-  StartReading();
+
+  // If a read is still outstanding it targets the buffer just past the batch;
+  // move that buffer to the front so OnReadComplete finds its packet there.
+  if (read_pending_)
+    read_buffers_[0].swap(read_buffers_[num_buffered_packets_]);
+  num_buffered_packets_ = 0;
+  return true;
 }
 
 void QuicClientSession::NotifyFactoryOfSessionGoingAway() {
@@ -11,6 +11,7 @@
 #define NET_QUIC_QUIC_CLIENT_SESSION_H_
 
 #include <string>
+#include <vector>
 
 #include "base/basictypes.h"
 #include "base/containers/hash_tables.h"
@@ -191,6 +192,12 @@ class NET_EXPORT_PRIVATE QuicClientSession : public QuicClientSessionBase {
   // A completion callback invoked when a read completes.
   void OnReadComplete(int result);
 
+  // Hands the batch of packets accumulated by StartReading() to the
+  // connection, one ProcessUdpPacket() call per packet but with a single
+  // address lookup for the whole batch. Returns false if processing a packet
+  // closed (and possibly deleted) the session.
+  bool ProcessBufferedPackets();
+
   void OnClosedStream();
 
   // A Session may be closed via any of three methods:
@@ -225,7 +232,14 @@ class NET_EXPORT_PRIVATE QuicClientSession : public QuicClientSessionBase {
   QuicStreamFactory* stream_factory_;
   scoped_ptr<DatagramClientSocket> socket_;
   scoped_ptr<QuicDefaultPacketWriter> writer_;
-  scoped_refptr<IOBufferWithSize> read_buffer_;
+  // Packets are read from the socket in batches: reads that complete
+  // synchronously fill consecutive buffers, and the whole batch is processed
+  // before yielding to the message loop. |read_buffer_lengths_[i]| holds the
+  // length of the datagram in |read_buffers_[i]| for the buffered packets.
+  std::vector<scoped_refptr<IOBufferWithSize> > read_buffers_;
+  std::vector<int> read_buffer_lengths_;
+  // Number of packets buffered and not yet processed.
+  size_t num_buffered_packets_;
   scoped_ptr<QuicServerInfo> server_info_;
   scoped_ptr<CertVerifyResult> cert_verify_result_;
   ObserverSet observers_;
@@ -237,8 +251,6 @@ class NET_EXPORT_PRIVATE QuicClientSession : public QuicClientSessionBase {
   BoundNetLog net_log_;
   base::TimeTicks handshake_start_;  // Time the handshake was started.
   QuicConnectionLogger logger_;
-  // Number of packets read in the current read loop.
-  size_t num_packets_read_;
   // True when the session is going away, and streams may no longer be created
   // on this session. Existing stream will continue to be processed.
   bool going_away_;
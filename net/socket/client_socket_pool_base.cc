@@ -4,6 +4,8 @@
 
 #include "net/socket/client_socket_pool_base.h"
 
+#include <iterator>
+
 #include "base/compiler_specific.h"
 #include "base/format_macros.h"
 #include "base/logging.h"
@@ -440,41 +442,33 @@ int ClientSocketPoolBaseHelper::RequestSocketInternal(
 bool ClientSocketPoolBaseHelper::AssignIdleSocketToRequest(
     const Request& request, Group* group) {
   std::list<IdleSocket>* idle_sockets = group->mutable_idle_sockets();
-  std::list<IdleSocket>::iterator idle_socket_it = idle_sockets->end();
-
-  // Iterate through the idle sockets forwards (oldest to newest)
-  //   * Delete any disconnected ones.
-  //   * If we find a used idle socket, assign to |idle_socket|.  At the end,
-  //   the |idle_socket_it| will be set to the newest used idle socket.
-  for (std::list<IdleSocket>::iterator it = idle_sockets->begin();
-       it != idle_sockets->end();) {
-    if (!it->IsUsable()) {
+
+  // The idle list is kept partitioned by Group::AddIdleSocket(): never-used
+  // sockets at the front in FIFO order, used sockets behind them with the
+  // newest at the back.  The preferred socket -- the newest used one, or the
+  // oldest never-used one when no used socket is idle -- is therefore at one
+  // end of the list, so a claim only inspects candidates instead of walking
+  // the whole list.  Unusable sockets elsewhere in the list are left for the
+  // cleanup timer (or a later claim) to collect.
+  while (!idle_sockets->empty()) {
+    bool has_used_sockets =
+        group->unused_idle_socket_count() < idle_sockets->size();
+    std::list<IdleSocket>::iterator idle_socket_it =
+        has_used_sockets ? --idle_sockets->end() : idle_sockets->begin();
+
+    if (!idle_socket_it->IsUsable()) {
+      StreamSocket* socket = idle_socket_it->socket;
+      group->EraseIdleSocket(idle_socket_it);
+      delete socket;
       DecrementIdleCount();
-      delete it->socket;
-      it = idle_sockets->erase(it);
       continue;
     }
 
-    if (it->socket->WasEverUsed()) {
-      // We found one we can reuse!
-      idle_socket_it = it;
-    }
-
-    ++it;
-  }
-
-  // If we haven't found an idle socket, that means there are no used idle
-  // sockets.  Pick the oldest (first) idle socket (FIFO).
-
-  if (idle_socket_it == idle_sockets->end() && !idle_sockets->empty())
-    idle_socket_it = idle_sockets->begin();
-
-  if (idle_socket_it != idle_sockets->end()) {
     DecrementIdleCount();
     base::TimeDelta idle_time =
         base::TimeTicks::Now() - idle_socket_it->start_time;
     IdleSocket idle_socket = *idle_socket_it;
-    idle_sockets->erase(idle_socket_it);
+    group->EraseIdleSocket(idle_socket_it);
     // TODO(davidben): If |idle_time| is under some low watermark, consider
     // treating as UNUSED rather than UNUSED_IDLE. This will avoid
     // HttpNetworkTransaction retrying on some errors.
@@ -681,8 +675,9 @@ void ClientSocketPoolBaseHelper::CleanupIdleSockets(bool force) {
           j->socket->WasEverUsed() ?
           used_idle_socket_timeout_ : unused_idle_socket_timeout_;
       if (force || j->ShouldCleanup(now, timeout)) {
-        delete j->socket;
-        j = group->mutable_idle_sockets()->erase(j);
+        StreamSocket* socket = j->socket;
+        j = group->EraseIdleSocket(j);
+        delete socket;
         DecrementIdleCount();
       } else {
         ++j;
@@ -1009,7 +1004,7 @@ void ClientSocketPoolBaseHelper::AddIdleSocket(
   idle_socket.socket = socket.release();
   idle_socket.start_time = base::TimeTicks::Now();
 
-  group->mutable_idle_sockets()->push_back(idle_socket);
+  group->AddIdleSocket(idle_socket);
   IncrementIdleCount();
 }
 
@@ -1083,8 +1078,9 @@ bool ClientSocketPoolBaseHelper::CloseOneIdleSocketExceptInGroup(
     std::list<IdleSocket>* idle_sockets = group->mutable_idle_sockets();
 
     if (!idle_sockets->empty()) {
-      delete idle_sockets->front().socket;
-      idle_sockets->pop_front();
+      StreamSocket* socket = idle_sockets->front().socket;
+      group->EraseIdleSocket(idle_sockets->begin());
+      delete socket;
       DecrementIdleCount();
       if (group->IsEmpty())
         RemoveGroup(i);
@@ -1144,6 +1140,7 @@ void ClientSocketPoolBaseHelper::TryToCloseSocketsInLayeredPools() {
 
 ClientSocketPoolBaseHelper::Group::Group()
     : unassigned_job_count_(0),
+      unused_idle_socket_count_(0),
       pending_requests_(NUM_PRIORITIES),
       active_socket_count_(0) {}
 
@@ -1247,6 +1244,32 @@ void ClientSocketPoolBaseHelper::Group::SanityCheck() {
   DCHECK_LE(unassigned_job_count_, jobs_.size());
 }
 
+void ClientSocketPoolBaseHelper::Group::AddIdleSocket(
+    const IdleSocket& idle_socket) {
+  if (idle_socket.socket->WasEverUsed()) {
+    idle_sockets_.push_back(idle_socket);
+    return;
+  }
+
+  // Never-used sockets go behind the other never-used sockets, ahead of any
+  // used ones.  Sockets only become used when handed out, so membership in
+  // the front partition never goes stale while a socket sits on the list.
+  std::list<IdleSocket>::iterator position = idle_sockets_.begin();
+  std::advance(position, unused_idle_socket_count_);
+  idle_sockets_.insert(position, idle_socket);
+  ++unused_idle_socket_count_;
+}
+
+std::list<ClientSocketPoolBaseHelper::IdleSocket>::iterator
+ClientSocketPoolBaseHelper::Group::EraseIdleSocket(
+    std::list<IdleSocket>::iterator it) {
+  if (!it->socket->WasEverUsed()) {
+    DCHECK_GT(unused_idle_socket_count_, 0u);
+    --unused_idle_socket_count_;
+  }
+  return idle_sockets_.erase(it);
+}
+
 void ClientSocketPoolBaseHelper::Group::RemoveAllJobs() {
   SanityCheck();
 
@@ -444,6 +444,20 @@ class NET_EXPORT_PRIVATE ClientSocketPoolBaseHelper
     scoped_ptr<const Request> FindAndRemovePendingRequest(
         ClientSocketHandle* handle);
 
+    // Adds |idle_socket| to the idle list, keeping it partitioned: sockets
+    // that have never been used stay at the front in FIFO order, used
+    // sockets follow in release order with the newest at the back.  The
+    // partition keeps the preferred socket for reuse at one end of the
+    // list, so claiming one is O(1) instead of a walk of the list.
+    void AddIdleSocket(const IdleSocket& idle_socket);
+
+    // Removes the idle socket at |it|, without deleting its StreamSocket.
+    // All idle list removals must go through here to keep
+    // |unused_idle_socket_count_| accurate.  Returns the iterator following
+    // the removed entry.
+    std::list<IdleSocket>::iterator EraseIdleSocket(
+        std::list<IdleSocket>::iterator it);
+
     void IncrementActiveSocketCount() { active_socket_count_++; }
     void DecrementActiveSocketCount() { active_socket_count_--; }
 
@@ -452,6 +466,9 @@ class NET_EXPORT_PRIVATE ClientSocketPoolBaseHelper
     const std::list<IdleSocket>& idle_sockets() const { return idle_sockets_; }
     int active_socket_count() const { return active_socket_count_; }
     std::list<IdleSocket>* mutable_idle_sockets() { return &idle_sockets_; }
+    size_t unused_idle_socket_count() const {
+      return unused_idle_socket_count_;
+    }
 
    private:
     // Returns the iterator's pending request after removing it from
@@ -477,6 +494,11 @@ class NET_EXPORT_PRIVATE ClientSocketPoolBaseHelper
     size_t unassigned_job_count_;
 
     std::list<IdleSocket> idle_sockets_;
+
+    // Number of sockets in |idle_sockets_| that have never been used; these
+    // occupy the front of the list per the partition kept by AddIdleSocket().
+    size_t unused_idle_socket_count_;
+
     std::set<ConnectJob*> jobs_;
     RequestQueue pending_requests_;
     int active_socket_count_;  // number of active sockets used by clients
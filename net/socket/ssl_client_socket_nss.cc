@@ -2076,7 +2076,7 @@ int SSLClientSocketNSS::Core::BufferRecv() {
     // buffer too full to read into, so no I/O possible at moment
     rv = ERR_IO_PENDING;
   } else {
-    scoped_refptr<IOBuffer> read_buffer(new IOBuffer(nb));
+    scoped_refptr<IOBuffer> read_buffer(IOBufferWithSize::TakeFromPool(nb));
     if (OnNetworkTaskRunner()) {
       rv = DoBufferRecv(read_buffer.get(), nb);
     } else {
@@ -2123,7 +2123,7 @@ int SSLClientSocketNSS::Core::BufferSend() {
 
   int rv = 0;
   if (len) {
-    scoped_refptr<IOBuffer> send_buffer(new IOBuffer(len));
+    scoped_refptr<IOBuffer> send_buffer(IOBufferWithSize::TakeFromPool(len));
     memcpy(send_buffer->data(), buf1, len1);
     memcpy(send_buffer->data() + len1, buf2, len2);
 
@@ -4,8 +4,12 @@
 
 #include "net/socket/ssl_session_cache_openssl.h"
 
+#include <string.h>
+
+#include <algorithm>
 #include <list>
 #include <map>
+#include <vector>
 
 #include <openssl/rand.h>
 #include <openssl/ssl.h>
@@ -13,6 +17,7 @@
 #include "base/containers/hash_tables.h"
 #include "base/lazy_instance.h"
 #include "base/logging.h"
+#include "base/memory/scoped_ptr.h"
 #include "base/synchronization/lock.h"
 
 namespace net {
@@ -93,6 +98,33 @@ struct SessionId {
   }
 };
 
+// Serialized session cache format: a SerializedCacheHeader followed by
+// |entry_count| records, each a SerializedRecordHeader followed by the cache
+// key and the DER-encoded SSL_SESSION, zero-padded so that every record
+// header stays 4-byte aligned. Fixed-width headers let a reader walk the
+// records without parsing the payloads.
+const uint32 kSerializedCacheMagic = 0x53534c43;  // "SSLC"
+const uint32 kSerializedCacheVersion = 1;
+
+struct SerializedCacheHeader {
+  uint32 magic;
+  uint32 version;
+  uint32 entry_count;
+  uint32 padding_must_be_zero;
+};
+
+struct SerializedRecordHeader {
+  uint32 key_length;
+  uint32 session_length;
+  uint32 use_count;
+  uint32 padding_must_be_zero;
+};
+
+// Rounds a record payload size up to the next record header boundary.
+size_t AlignSerializedSize(size_t size) {
+  return (size + 3) & ~static_cast<size_t>(3);
+}
+
 }  // namespace
 
 }  // namespace net
@@ -233,6 +265,8 @@ class SSLSessionCacheOpenSSLImpl {
     ordering_.erase(it->second);
     it->second = ordering_.begin();
 
+    ++use_counts_[cache_key];
+
     return SSL_set_session(ssl, session) == 1;
   }
 
@@ -251,6 +285,7 @@ class SSLSessionCacheOpenSSLImpl {
     base::AutoLock lock(lock_);
     id_index_.clear();
     key_index_.clear();
+    use_counts_.clear();
     while (!ordering_.empty()) {
       SSL_SESSION* session = ordering_.front();
       ordering_.pop_front();
@@ -258,6 +293,136 @@ class SSLSessionCacheOpenSSLImpl {
     }
   }
 
+  // See SSLSessionCacheOpenSSL::Serialize() for a description.
+  void Serialize(std::string* output) {
+    base::AutoLock locked(lock_);
+    output->clear();
+
+    // Order keys from most to least frequently used, so that a restore into
+    // a smaller cache (or a truncated read) keeps the hottest origins.
+    std::vector<std::pair<uint32, KeyIndex::iterator> > ranked;
+    ranked.reserve(key_index_.size());
+    for (KeyIndex::iterator it = key_index_.begin(); it != key_index_.end();
+         ++it) {
+      ranked.push_back(std::make_pair(use_counts_[it->first], it));
+    }
+    std::sort(ranked.begin(), ranked.end(), RankedEntryMoreUsed);
+
+    std::string records;
+    uint32 entry_count = 0;
+    for (size_t n = 0; n < ranked.size(); ++n) {
+      const std::string& cache_key = ranked[n].second->first;
+      SSL_SESSION* session = *ranked[n].second->second;
+
+      // Only sessions that were validated are worth resuming.
+      if (!SSL_SESSION_get_ex_data(session, GetSSLSessionExIndex()))
+        continue;
+
+      int der_size = i2d_SSL_SESSION(session, NULL);
+      if (der_size <= 0)
+        continue;
+      scoped_ptr<unsigned char[]> der(new unsigned char[der_size]);
+      unsigned char* der_ptr = der.get();
+      if (i2d_SSL_SESSION(session, &der_ptr) != der_size)
+        continue;
+
+      SerializedRecordHeader record;
+      memset(&record, 0, sizeof(record));
+      record.key_length = cache_key.size();
+      record.session_length = der_size;
+      record.use_count = ranked[n].first;
+      records.append(reinterpret_cast<const char*>(&record), sizeof(record));
+      records.append(cache_key);
+      records.append(reinterpret_cast<const char*>(der.get()), der_size);
+      records.append(
+          AlignSerializedSize(cache_key.size() + der_size) -
+              (cache_key.size() + der_size),
+          '\0');
+      ++entry_count;
+    }
+
+    SerializedCacheHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = kSerializedCacheMagic;
+    header.version = kSerializedCacheVersion;
+    header.entry_count = entry_count;
+    output->reserve(sizeof(header) + records.size());
+    output->append(reinterpret_cast<const char*>(&header), sizeof(header));
+    output->append(records);
+  }
+
+  // See SSLSessionCacheOpenSSL::RestoreSerializedSessions() for a
+  // description.
+  size_t RestoreSerializedSessions(const std::string& serialized) {
+    base::AutoLock locked(lock_);
+
+    SerializedCacheHeader header;
+    if (serialized.size() < sizeof(header))
+      return 0;
+    memcpy(&header, serialized.data(), sizeof(header));
+    if (header.magic != kSerializedCacheMagic ||
+        header.version != kSerializedCacheVersion) {
+      return 0;
+    }
+
+    const long now_secs = static_cast<long>(::time(NULL));
+    size_t restored = 0;
+    size_t offset = sizeof(header);
+    for (uint32 n = 0; n < header.entry_count; ++n) {
+      SerializedRecordHeader record;
+      if (serialized.size() - offset < sizeof(record))
+        break;
+      memcpy(&record, serialized.data() + offset, sizeof(record));
+      offset += sizeof(record);
+
+      size_t payload_size =
+          AlignSerializedSize(record.key_length + record.session_length);
+      if (record.key_length == 0 || record.session_length == 0 ||
+          payload_size < record.key_length ||  // Overflow check.
+          serialized.size() - offset < payload_size) {
+        break;
+      }
+      std::string cache_key(serialized.data() + offset, record.key_length);
+      const unsigned char* der_ptr = reinterpret_cast<const unsigned char*>(
+          serialized.data() + offset + record.key_length);
+      offset += payload_size;
+
+      SSL_SESSION* session =
+          d2i_SSL_SESSION(NULL, &der_ptr, record.session_length);
+      if (!session)
+        continue;
+      if (session->session_id_length == 0 ||
+          session->time + session->timeout <= now_secs ||
+          key_index_.find(cache_key) != key_index_.end() ||
+          id_index_.find(SessionId(session)) != id_index_.end()) {
+        SSL_SESSION_free(session);
+        continue;
+      }
+
+      // Records are ordered from most to least used, so appending keeps the
+      // MRU list (and therefore the eviction order) ranked by frequency.
+      ordering_.push_back(session);
+      MRUSessionList::iterator pos = ordering_.end();
+      --pos;
+      std::pair<KeyIndex::iterator, bool> ret =
+          key_index_.insert(std::make_pair(cache_key, pos));
+      DCHECK(ret.second);
+      id_index_[SessionId(session)] = ret.first;
+      use_counts_[cache_key] = record.use_count;
+
+      // The session was validated before it was serialized.
+      SSL_SESSION_set_ex_data(
+          session, GetSSLSessionExIndex(), reinterpret_cast<void*>(1));
+      ++restored;
+    }
+
+    if (key_index_.size() > config_.max_entries)
+      ShrinkCacheLocked();
+
+    DCHECK_EQ(key_index_.size(), id_index_.size());
+    return restored;
+  }
+
  private:
   // Type for list of SSL_SESSION handles, ordered in MRU order.
   typedef std::list<SSL_SESSION*> MRUSessionList;
@@ -265,6 +430,15 @@ class SSLSessionCacheOpenSSLImpl {
   typedef base::hash_map<std::string, MRUSessionList::iterator> KeyIndex;
   // Type for a dictionary from SessionId values to key index nodes.
   typedef base::hash_map<SessionId, KeyIndex::iterator> SessionIdIndex;
+  // Type for a dictionary counting how often each cache key was used.
+  typedef base::hash_map<std::string, uint32> UseCountMap;
+
+  // Orders serialization candidates from most to least frequently used.
+  static bool RankedEntryMoreUsed(
+      const std::pair<uint32, KeyIndex::iterator>& a,
+      const std::pair<uint32, KeyIndex::iterator>& b) {
+    return a.first > b.first;
+  }
 
   // Return the key associated with a given session, or the empty string if
   // none exist. This shall only be used for debugging.
@@ -297,6 +471,7 @@ class SSLSessionCacheOpenSSLImpl {
     DCHECK(key_it != key_index_.end());
     DCHECK_EQ(session, *key_it->second);
 
+    use_counts_.erase(key_it->first);
     id_index_.erase(session_id);
     ordering_.erase(key_it->second);
     key_index_.erase(key_it);
@@ -409,6 +584,7 @@ class SSLSessionCacheOpenSSLImpl {
     }
 
     id_index_[SessionId(session)] = it;
+    ++use_counts_[cache_key];
 
     if (key_index_.size() > config_.max_entries)
       ShrinkCacheLocked();
@@ -474,6 +650,7 @@ class SSLSessionCacheOpenSSLImpl {
   MRUSessionList ordering_;
   KeyIndex key_index_;
   SessionIdIndex id_index_;
+  UseCountMap use_counts_;
 
   size_t expiration_check_;
 };
@@ -505,4 +682,13 @@ void SSLSessionCacheOpenSSL::MarkSSLSessionAsGood(SSL* ssl) {
 
 void SSLSessionCacheOpenSSL::Flush() { impl_->Flush(); }
 
+void SSLSessionCacheOpenSSL::Serialize(std::string* output) {
+  impl_->Serialize(output);
+}
+
+size_t SSLSessionCacheOpenSSL::RestoreSerializedSessions(
+    const std::string& serialized) {
+  return impl_->RestoreSerializedSessions(serialized);
+}
+
 }  // namespace net
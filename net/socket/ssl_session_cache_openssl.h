@@ -44,6 +44,11 @@ class SSLSessionCacheOpenSSLImpl;
 //  - Clients can call Flush() to remove all sessions from the cache, this is
 //    useful when the system's certificate store has changed.
 //
+//  - Clients that want session resumption to survive a restart can call
+//    Serialize() at shutdown and RestoreSerializedSessions() at startup.
+//    Reading and writing the blob to storage is the caller's business;
+//    this class never touches the disk itself.
+//
 // This class is thread-safe. There shouldn't be any issue with multiple
 // SSL connections being performed in parallel in multiple threads.
 class NET_EXPORT SSLSessionCacheOpenSSL {
@@ -125,6 +130,19 @@ class NET_EXPORT SSLSessionCacheOpenSSL {
   // the system's certificate store has changed.
   void Flush();
 
+  // Serializes every validated, unexpired session into |output| so that it
+  // can be written to storage and restored after a restart. Records are
+  // fixed-width-header-aligned and ordered from most to least frequently
+  // used key, so a restore into a smaller cache keeps the hottest origins.
+  // The output contains session secrets; callers are responsible for
+  // storing it as carefully as other credential data.
+  void Serialize(std::string* output);
+
+  // Restores sessions previously produced by Serialize() into the cache.
+  // Expired records, damaged records, and records whose key is already
+  // present are skipped. Returns the number of sessions restored.
+  size_t RestoreSerializedSessions(const std::string& serialized);
+
   // TODO(digit): Move to client code.
   static const int kDefaultTimeoutSeconds = 60 * 60;
   static const size_t kMaxEntries = 1024;
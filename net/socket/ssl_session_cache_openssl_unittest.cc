@@ -239,6 +239,48 @@ TEST_F(SSLSessionCacheOpenSSLTest, SetSSLSessionWithKey) {
   EXPECT_TRUE(cache_.SetSSLSessionWithKey(ssl2.get(), key));
 }
 
+TEST_F(SSLSessionCacheOpenSSLTest, SerializeAndRestore) {
+  const std::string key("hello");
+  ScopedSSL ssl(NewSSL(key));
+  AddToCache(ssl.get());
+  cache_.MarkSSLSessionAsGood(ssl.get());
+  ssl.reset(NULL);
+
+  std::string serialized;
+  cache_.Serialize(&serialized);
+  EXPECT_FALSE(serialized.empty());
+
+  // Restore into a fresh cache and context, as after a restart.
+  ScopedSSL_CTX ctx2(SSL_CTX_new(SSLv23_client_method()));
+  SSLSessionCacheOpenSSL cache2(ctx2.get(), kDefaultConfig);
+  EXPECT_EQ(1U, cache2.RestoreSerializedSessions(serialized));
+  EXPECT_EQ(1U, cache2.size());
+
+  // The restored session must be resumable without being marked good again.
+  ScopedSSL ssl2(SSL_new(ctx2.get()));
+  SSLKeyHelper::Set(ssl2.get(), key);
+  EXPECT_TRUE(cache2.SetSSLSessionWithKey(ssl2.get(), key));
+}
+
+TEST_F(SSLSessionCacheOpenSSLTest, SerializeSkipsUnvalidatedSessions) {
+  ScopedSSL ssl(NewSSL("hello"));
+  AddToCache(ssl.get());  // Never marked good.
+  ssl.reset(NULL);
+
+  std::string serialized;
+  cache_.Serialize(&serialized);
+
+  cache_.Flush();
+  EXPECT_EQ(0U, cache_.RestoreSerializedSessions(serialized));
+  EXPECT_EQ(0U, cache_.size());
+}
+
+TEST_F(SSLSessionCacheOpenSSLTest, RestoreRejectsGarbage) {
+  EXPECT_EQ(0U, cache_.RestoreSerializedSessions(std::string()));
+  EXPECT_EQ(0U, cache_.RestoreSerializedSessions("not a session cache"));
+  EXPECT_EQ(0U, cache_.size());
+}
+
 TEST_F(SSLSessionCacheOpenSSLTest, CheckSessionReplacement) {
   // Check that if two SSL connections have the same key, only one
   // corresponding session can be stored in the cache.
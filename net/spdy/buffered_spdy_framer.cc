@@ -368,6 +368,17 @@ SpdyFrame* BufferedSpdyFramer::CreateDataFrame(SpdyStreamId stream_id,
   return spdy_framer_.SerializeData(data_ir);
 }
 
+SpdyFrame* BufferedSpdyFramer::CreateDataFrameHeader(SpdyStreamId stream_id,
+                                                     uint32 len,
+                                                     SpdyDataFlags flags) {
+  // The IR only needs the payload length to fill in the header; the
+  // data pointer is never dereferenced.
+  SpdyDataIR data_ir(stream_id,
+                     base::StringPiece(static_cast<const char*>(NULL), len));
+  data_ir.set_fin((flags & DATA_FLAG_FIN) != 0);
+  return spdy_framer_.SerializeDataFrameHeaderWithPaddingLengthField(data_ir);
+}
+
 // TODO(jgraettinger): Eliminate uses of this method (prefer SpdyPushPromiseIR).
 SpdyFrame* BufferedSpdyFramer::CreatePushPromise(
     SpdyStreamId stream_id,
@@ -197,6 +197,12 @@ class NET_EXPORT_PRIVATE BufferedSpdyFramer
                              const char* data,
                              uint32 len,
                              SpdyDataFlags flags);
+  // Serializes only the header of a data frame whose payload is |len|
+  // bytes long. The payload itself is not copied; callers send it
+  // separately (see the SpdyBuffer header/payload constructor).
+  SpdyFrame* CreateDataFrameHeader(SpdyStreamId stream_id,
+                                   uint32 len,
+                                   SpdyDataFlags flags);
   SpdyFrame* CreatePushPromise(SpdyStreamId stream_id,
                                SpdyStreamId promised_stream_id,
                                const SpdyHeaderBlock* headers);
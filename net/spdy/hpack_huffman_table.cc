@@ -217,35 +217,42 @@ bool HpackHuffmanTable::IsInitialized() const {
 
 void HpackHuffmanTable::EncodeString(StringPiece in,
                                      HpackOutputStream* out) const {
-  size_t bit_remnant = 0;
+  // Huffman-encoded strings always follow a length prefix, which leaves the
+  // output stream on a byte boundary. This lets us gather codes into a 64-bit
+  // accumulator and emit whole bytes, rather than appending each code to the
+  // stream bit-by-bit.
+  string buffer;
+  buffer.reserve(in.size());
+
+  // Pending output, aligned to the most-significant bit of |accumulator|.
+  uint64 accumulator = 0;
+  size_t accumulated_bits = 0;
+
   for (size_t i = 0; i != in.size(); i++) {
     uint16 symbol_id = static_cast<uint8>(in[i]);
     CHECK_GT(code_by_id_.size(), symbol_id);
 
-    // Load, and shift code to low bits.
-    unsigned length = length_by_id_[symbol_id];
-    uint32 code = code_by_id_[symbol_id] >> (32 - length);
-
-    bit_remnant = (bit_remnant + length) % 8;
-
-    if (length > 24) {
-      out->AppendBits(static_cast<uint8>(code >> 24), length - 24);
-      length = 24;
-    }
-    if (length > 16) {
-      out->AppendBits(static_cast<uint8>(code >> 16), length - 16);
-      length = 16;
-    }
-    if (length > 8) {
-      out->AppendBits(static_cast<uint8>(code >> 8), length - 8);
-      length = 8;
+    // Codes are stored aligned to the most-significant bit of a uint32.
+    // A code is at most 32 bits and |accumulated_bits| is less than 8
+    // here, so the accumulator cannot overflow.
+    DCHECK_LT(accumulated_bits, 8u);
+    accumulator |=
+        static_cast<uint64>(code_by_id_[symbol_id])
+        << (32 - accumulated_bits);
+    accumulated_bits += length_by_id_[symbol_id];
+
+    while (accumulated_bits >= 8) {
+      buffer.push_back(static_cast<char>(accumulator >> 56));
+      accumulator <<= 8;
+      accumulated_bits -= 8;
     }
-    out->AppendBits(static_cast<uint8>(code), length);
   }
-  if (bit_remnant != 0) {
-    // Pad current byte as required.
-    out->AppendBits(pad_bits_ >> bit_remnant, 8 - bit_remnant);
+  if (accumulated_bits != 0) {
+    // Pad the final byte as required.
+    buffer.push_back(static_cast<char>(
+        (accumulator >> 56) | (pad_bits_ >> accumulated_bits)));
   }
+  out->AppendBytes(buffer);
 }
 
 size_t HpackHuffmanTable::EncodedSize(StringPiece in) const {
@@ -273,8 +280,8 @@ bool HpackHuffmanTable::DecodeString(HpackInputStream* in,
 
   // Current input, stored in the high |bits_available| bits of |bits|.
   uint32 bits = 0;
-  size_t bits_available = 0;
-  bool peeked_success = in->PeekBits(&bits_available, &bits);
+  size_t bits_available = in->InitializePeekBits(&bits);
+  bool peeked_success = bits_available != 0;
 
   while (true) {
     const DecodeTable* table = &decode_tables_[0];
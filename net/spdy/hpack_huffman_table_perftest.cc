@@ -0,0 +1,105 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/spdy/hpack_huffman_table.h"
+
+#include <string>
+#include <vector>
+
+#include "base/rand_util.h"
+#include "base/test/perf_time_logger.h"
+#include "net/spdy/hpack_constants.h"
+#include "net/spdy/hpack_input_stream.h"
+#include "net/spdy/hpack_output_stream.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace net {
+
+namespace {
+
+const int kIterations = 10000;
+
+// Limit on the decoded size of any one string, well above the size of
+// the inputs used here.
+const uint32 kMaxStringLiteralSize = 16 * 1024;
+
+// A cookie-sized header value, exercising the common case of mostly
+// lowercase alphanumeric input.
+const char kCookieValue[] =
+    "PREF=ID=1cb2be85617c0e0e:U=52d680fa5bbd6ba9:FF=0:TM=1391658611:"
+    "LM=1391658611:S=lPNDC5SGOmqQdpNk; "
+    "NID=67=IBOXKgquBBwrvU71baSP1JCfFKD4_-TS9Y5O0oOcVdzKB8DkH0447N87o"
+    "ZA_Ar1e2_8gD5UWdSPpKt1rEmcfVtD0KhZP1xDaIBEw6YVp-aWcYwlBNLOcDMKf_PJV";
+
+class HpackHuffmanTablePerfTest : public ::testing::Test {
+ protected:
+  HpackHuffmanTablePerfTest() : table_(ObtainHpackHuffmanTable()) {}
+
+  const HpackHuffmanTable& table_;
+};
+
+TEST_F(HpackHuffmanTablePerfTest, EncodeString) {
+  const std::string input(kCookieValue);
+
+  std::string encoded;
+  base::PerfTimeLogger timer("Huffman_encode_cookie");
+  for (int i = 0; i != kIterations; ++i) {
+    HpackOutputStream output_stream;
+    table_.EncodeString(input, &output_stream);
+    output_stream.TakeString(&encoded);
+  }
+  timer.Done();
+
+  EXPECT_EQ(table_.EncodedSize(input), encoded.size());
+}
+
+TEST_F(HpackHuffmanTablePerfTest, DecodeString) {
+  const std::string input(kCookieValue);
+
+  HpackOutputStream output_stream;
+  table_.EncodeString(input, &output_stream);
+  std::string encoded;
+  output_stream.TakeString(&encoded);
+
+  std::string decoded;
+  base::PerfTimeLogger timer("Huffman_decode_cookie");
+  for (int i = 0; i != kIterations; ++i) {
+    HpackInputStream input_stream(kMaxStringLiteralSize, encoded);
+    EXPECT_TRUE(
+        table_.DecodeString(&input_stream, kMaxStringLiteralSize, &decoded));
+  }
+  timer.Done();
+
+  EXPECT_EQ(input, decoded);
+}
+
+TEST_F(HpackHuffmanTablePerfTest, RoundTripRandomStrings) {
+  // Random bytes hit the longer codes and the multi-level decode
+  // tables, unlike the mostly-alphanumeric cookie value.
+  std::vector<std::string> inputs;
+  for (int i = 0; i != 64; ++i) {
+    inputs.push_back(base::RandBytesAsString(512));
+  }
+
+  std::string encoded;
+  std::string decoded;
+  base::PerfTimeLogger timer("Huffman_round_trip_random");
+  for (int i = 0; i != kIterations / 64; ++i) {
+    for (size_t j = 0; j != inputs.size(); ++j) {
+      HpackOutputStream output_stream;
+      table_.EncodeString(inputs[j], &output_stream);
+      output_stream.TakeString(&encoded);
+
+      HpackInputStream input_stream(kMaxStringLiteralSize, encoded);
+      EXPECT_TRUE(
+          table_.DecodeString(&input_stream, kMaxStringLiteralSize, &decoded));
+      EXPECT_EQ(inputs[j], decoded);
+    }
+  }
+  timer.Done();
+}
+
+}  // namespace
+
+}  // namespace net
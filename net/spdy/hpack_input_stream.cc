@@ -153,6 +153,21 @@ bool HpackInputStream::PeekBits(size_t* peeked_count, uint32* out) {
   return true;
 }
 
+size_t HpackInputStream::InitializePeekBits(uint32* out) {
+  DCHECK_EQ(bit_offset_, 0u);
+  size_t byte_count = std::min<size_t>(4, buffer_.size());
+  if (byte_count == 0)
+    return 0;
+  uint32 bits = 0;
+  for (size_t i = 0; i != byte_count; i++) {
+    bits = (bits << 8) | static_cast<uint8>(buffer_[i]);
+  }
+  // Left-align a short read with the most-significant bits of |bits|.
+  bits <<= 8 * (4 - byte_count);
+  *out = bits;
+  return byte_count * 8;
+}
+
 void HpackInputStream::ConsumeBits(size_t bit_count) {
   size_t byte_count = (bit_offset_ + bit_count) / 8;
   bit_offset_ = (bit_offset_ + bit_count) % 8;
@@ -50,6 +50,12 @@ class NET_EXPORT_PRIVATE HpackInputStream {
   // or more additional bits could be peeked, and false otherwise.
   bool PeekBits(size_t* peeked_count, uint32* out);
 
+  // Fast path for the initial peek of a decode: loads up to four whole input
+  // bytes into |out| in one step, rather than one fragment per PeekBits()
+  // call. Requires that the stream is on a byte boundary and that nothing has
+  // been peeked. Returns the number of bits stored in |out|.
+  size_t InitializePeekBits(uint32* out);
+
   // Consumes |count| bits of input. Generally paired with PeekBits().
   void ConsumeBits(size_t count);
 
@@ -608,6 +608,46 @@ TEST_F(HpackInputStreamTest, PeekBitsAndConsume) {
   EXPECT_FALSE(input_stream.HasMoreData());
 }
 
+TEST_F(HpackInputStreamTest, InitializePeekBits) {
+  // A full four bytes are loaded at once.
+  {
+    HpackInputStream input_stream(kLiteralBound, "\xad\xab\xad\xab\xad");
+    uint32 bits = 0;
+    EXPECT_EQ(32u, input_stream.InitializePeekBits(&bits));
+    EXPECT_EQ(bits32("10101101101010111010110110101011"), bits);
+  }
+  // A short input is left-aligned.
+  {
+    HpackInputStream input_stream(kLiteralBound, "\xad\xab");
+    uint32 bits = 0;
+    EXPECT_EQ(16u, input_stream.InitializePeekBits(&bits));
+    EXPECT_EQ(bits32("10101101101010110000000000000000"), bits);
+  }
+  // An empty input peeks nothing.
+  {
+    HpackInputStream input_stream(kLiteralBound, "");
+    uint32 bits = 0;
+    EXPECT_EQ(0u, input_stream.InitializePeekBits(&bits));
+    EXPECT_EQ(0u, bits);
+  }
+  // PeekBits() picks up where InitializePeekBits() left off.
+  {
+    HpackInputStream input_stream(kLiteralBound, "\xad\xab\xad\xab\xad");
+    uint32 bits = 0;
+    size_t peeked_count = input_stream.InitializePeekBits(&bits);
+    EXPECT_EQ(32u, peeked_count);
+
+    input_stream.ConsumeBits(5);
+    bits = bits << 5;
+    peeked_count -= 5;
+    EXPECT_EQ(27u, peeked_count);
+
+    EXPECT_TRUE(input_stream.PeekBits(&peeked_count, &bits));
+    EXPECT_EQ(32u, peeked_count);
+    EXPECT_EQ(bits32("10110101011101011011010101110101"), bits);
+  }
+}
+
 TEST_F(HpackInputStreamTest, ConsumeByteRemainder) {
   HpackInputStream input_stream(kLiteralBound, "\xad\xab");
   // Does nothing.
@@ -56,8 +56,30 @@ class SpdyBuffer::SharedFrameIOBuffer : public IOBuffer {
   DISALLOW_COPY_AND_ASSIGN(SharedFrameIOBuffer);
 };
 
+// Like SharedFrameIOBuffer, but pointing into the caller-owned
+// payload of a buffer constructed with a separate payload.
+class SpdyBuffer::SharedPayloadIOBuffer : public IOBuffer {
+ public:
+  SharedPayloadIOBuffer(const scoped_refptr<IOBuffer>& payload, size_t offset)
+      : IOBuffer(payload->data() + offset),
+        payload_(payload),
+        offset_(offset) {}
+
+ private:
+  virtual ~SharedPayloadIOBuffer() {
+    // Prevent ~IOBuffer() from trying to delete |data_|.
+    data_ = NULL;
+  }
+
+  const scoped_refptr<IOBuffer> payload_;
+  const size_t offset_;
+
+  DISALLOW_COPY_AND_ASSIGN(SharedPayloadIOBuffer);
+};
+
 SpdyBuffer::SpdyBuffer(scoped_ptr<SpdyFrame> frame)
     : shared_frame_(new SharedFrame()),
+      payload_size_(0),
       offset_(0) {
   shared_frame_->data = frame.Pass();
 }
@@ -66,23 +88,45 @@ SpdyBuffer::SpdyBuffer(scoped_ptr<SpdyFrame> frame)
 // |frame_| just as a container.
 SpdyBuffer::SpdyBuffer(const char* data, size_t size) :
     shared_frame_(new SharedFrame()),
+    payload_size_(0),
     offset_(0) {
   CHECK_GT(size, 0u);
   CHECK_LE(size, kMaxSpdyFrameSize);
   shared_frame_->data = MakeSpdyFrame(data, size);
 }
 
+SpdyBuffer::SpdyBuffer(scoped_ptr<SpdyFrame> header_frame,
+                       const scoped_refptr<IOBuffer>& payload,
+                       size_t payload_size)
+    : shared_frame_(new SharedFrame()),
+      payload_(payload),
+      payload_size_(payload_size),
+      offset_(0) {
+  CHECK(payload.get());
+  CHECK_GT(payload_size, 0u);
+  CHECK_LE(payload_size, kMaxSpdyFrameSize);
+  shared_frame_->data = header_frame.Pass();
+}
+
 SpdyBuffer::~SpdyBuffer() {
   if (GetRemainingSize() > 0)
     ConsumeHelper(GetRemainingSize(), DISCARD);
 }
 
 const char* SpdyBuffer::GetRemainingData() const {
+  if (offset_ >= frame_size())
+    return payload_->data() + (offset_ - frame_size());
   return shared_frame_->data->data() + offset_;
 }
 
 size_t SpdyBuffer::GetRemainingSize() const {
-  return shared_frame_->data->size() - offset_;
+  return frame_size() + payload_size_ - offset_;
+}
+
+size_t SpdyBuffer::GetContiguousRemainingSize() const {
+  if (offset_ >= frame_size())
+    return GetRemainingSize();
+  return frame_size() - offset_;
 }
 
 void SpdyBuffer::AddConsumeCallback(const ConsumeCallback& consume_callback) {
@@ -94,6 +138,8 @@ void SpdyBuffer::Consume(size_t consume_size) {
 };
 
 IOBuffer* SpdyBuffer::GetIOBufferForRemainingData() {
+  if (offset_ >= frame_size())
+    return new SharedPayloadIOBuffer(payload_, offset_ - frame_size());
   return new SharedFrameIOBuffer(shared_frame_, offset_);
 }
 
@@ -108,4 +154,8 @@ void SpdyBuffer::ConsumeHelper(size_t consume_size,
   }
 };
 
+size_t SpdyBuffer::frame_size() const {
+  return shared_frame_->data->size();
+}
+
 }  // namespace net
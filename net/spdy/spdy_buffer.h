@@ -53,16 +53,35 @@ class NET_EXPORT_PRIVATE SpdyBuffer {
   // non-NULL and |size| must be non-zero.
   SpdyBuffer(const char* data, size_t size);
 
+  // Construct with a serialized frame header in |header_frame| and a
+  // payload referencing |payload_size| bytes of the caller-owned
+  // |payload|, without copying the payload. The two segments are not
+  // contiguous in memory: callers writing the buffer out must use
+  // GetContiguousRemainingSize() (rather than GetRemainingSize()) as
+  // the number of bytes readable from GetRemainingData().
+  SpdyBuffer(scoped_ptr<SpdyFrame> header_frame,
+             const scoped_refptr<IOBuffer>& payload,
+             size_t payload_size);
+
   // If there are bytes remaining in the buffer, triggers a call to
   // any consume callbacks with a DISCARD source.
   ~SpdyBuffer();
 
-  // Returns the remaining (unconsumed) data.
+  // Returns the remaining (unconsumed) data. Only the next
+  // GetContiguousRemainingSize() bytes are readable from the returned
+  // pointer.
   const char* GetRemainingData() const;
 
   // Returns the number of remaining (unconsumed) bytes.
   size_t GetRemainingSize() const;
 
+  // Returns the number of remaining bytes that are contiguous in
+  // memory starting at GetRemainingData(). Equal to
+  // GetRemainingSize() unless the buffer was constructed with a
+  // separate payload and the frame header has not been fully consumed
+  // yet.
+  size_t GetContiguousRemainingSize() const;
+
   // Add a callback to be called when bytes are consumed. The
   // ConsumeCallback should not do anything complicated; ideally it
   // should only update a counter. In particular, it must *not* cause
@@ -91,8 +110,15 @@ class NET_EXPORT_PRIVATE SpdyBuffer {
   typedef base::RefCountedData<scoped_ptr<SpdyFrame> > SharedFrame;
 
   class SharedFrameIOBuffer;
+  class SharedPayloadIOBuffer;
+
+  size_t frame_size() const;
 
   const scoped_refptr<SharedFrame> shared_frame_;
+  // Caller-owned payload following the frame data, if any. Not
+  // consulted when |payload_size_| is zero.
+  const scoped_refptr<IOBuffer> payload_;
+  const size_t payload_size_;
   std::vector<ConsumeCallback> consume_callbacks_;
   size_t offset_;
 
@@ -55,6 +55,37 @@ TEST_F(SpdyBufferTest, DataConstructor) {
   EXPECT_EQ(std::string(kData, kDataSize), BufferToString(buffer));
 }
 
+// Construct a SpdyBuffer from a header frame and a separate payload
+// IOBuffer and make sure the two segments are exposed in order,
+// without copying the payload.
+TEST_F(SpdyBufferTest, HeaderAndPayloadConstructor) {
+  const char kHeader[] = "HDR";
+  const size_t kHeaderSize = arraysize(kHeader) - 1;
+  scoped_refptr<IOBuffer> payload(new IOBuffer(kDataSize));
+  std::memcpy(payload->data(), kData, kDataSize);
+
+  SpdyBuffer buffer(
+      scoped_ptr<SpdyFrame>(
+          new SpdyFrame(const_cast<char*>(kHeader), kHeaderSize,
+                        false /* owns_buffer */)),
+      payload, kDataSize);
+
+  EXPECT_EQ(kHeaderSize + kDataSize, buffer.GetRemainingSize());
+  EXPECT_EQ(kHeaderSize, buffer.GetContiguousRemainingSize());
+  EXPECT_EQ(kHeader, buffer.GetRemainingData());
+
+  buffer.Consume(kHeaderSize);
+  EXPECT_EQ(kDataSize, buffer.GetRemainingSize());
+  EXPECT_EQ(kDataSize, buffer.GetContiguousRemainingSize());
+  // The payload must be referenced, not copied.
+  EXPECT_EQ(payload->data(), buffer.GetRemainingData());
+
+  buffer.Consume(5);
+  scoped_refptr<IOBuffer> io_buffer = buffer.GetIOBufferForRemainingData();
+  EXPECT_EQ(std::string(kData + 5, kDataSize - 5),
+            std::string(io_buffer->data(), buffer.GetRemainingSize()));
+}
+
 void IncrementBy(size_t* x,
                  SpdyBuffer::ConsumeSource expected_consume_source,
                  size_t delta,
@@ -547,7 +547,7 @@ SpdySession::SpdySession(
       spdy_session_key_(spdy_session_key),
       pool_(NULL),
       http_server_properties_(http_server_properties),
-      read_buffer_(new IOBuffer(kReadBufferSize)),
+      read_buffer_(IOBufferWithSize::TakeFromPool(kReadBufferSize)),
       stream_hi_water_mark_(kFirstStreamId),
       num_pushed_streams_(0u),
       num_active_pushed_streams_(0u),
@@ -1137,14 +1137,24 @@ scoped_ptr<SpdyBuffer> SpdySession::CreateDataBuffer(SpdyStreamId stream_id,
   if (effective_len > 0)
     SendPrefacePingIfNoneInFlight();
 
-  // TODO(mbelshe): reduce memory copies here.
   DCHECK(buffered_spdy_framer_.get());
-  scoped_ptr<SpdyFrame> frame(
-      buffered_spdy_framer_->CreateDataFrame(
-          stream_id, data->data(),
-          static_cast<uint32>(effective_len), flags));
-
-  scoped_ptr<SpdyBuffer> data_buffer(new SpdyBuffer(frame.Pass()));
+  scoped_ptr<SpdyBuffer> data_buffer;
+  if (effective_len > 0) {
+    // Serialize only the frame header and reference the caller-owned
+    // payload directly, so the data is not copied again on its way to
+    // the socket.
+    scoped_ptr<SpdyFrame> header_frame(
+        buffered_spdy_framer_->CreateDataFrameHeader(
+            stream_id, static_cast<uint32>(effective_len), flags));
+    data_buffer.reset(new SpdyBuffer(header_frame.Pass(), data,
+                                     static_cast<size_t>(effective_len)));
+  } else {
+    scoped_ptr<SpdyFrame> frame(
+        buffered_spdy_framer_->CreateDataFrame(
+            stream_id, data->data(),
+            static_cast<uint32>(effective_len), flags));
+    data_buffer.reset(new SpdyBuffer(frame.Pass()));
+  }
 
   if (flow_control_state_ == FLOW_CONTROL_STREAM_AND_SESSION) {
     DecreaseSendWindowSize(static_cast<int32>(effective_len));
@@ -1496,9 +1506,12 @@ int SpdySession::DoWrite() {
   // argument in a scoped_refptr<IOBuffer> (see crbug.com/232345).
   scoped_refptr<IOBuffer> write_io_buffer =
       in_flight_write_->GetIOBufferForRemainingData();
+  // Only the contiguous span of the buffer may be handed to the
+  // socket: a data frame's header and payload can live in separate
+  // allocations, in which case they are written back to back.
   return connection_->socket()->Write(
       write_io_buffer.get(),
-      in_flight_write_->GetRemainingSize(),
+      in_flight_write_->GetContiguousRemainingSize(),
       base::Bind(&SpdySession::PumpWriteLoop,
                  weak_factory_.GetWeakPtr(), WRITE_STATE_DO_WRITE_COMPLETE));
 }
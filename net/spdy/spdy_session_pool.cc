@@ -10,7 +10,9 @@
 #include "net/base/address_list.h"
 #include "net/http/http_network_session.h"
 #include "net/http/http_server_properties.h"
+#include "net/http/transport_security_state.h"
 #include "net/spdy/spdy_session.h"
+#include "net/ssl/ssl_info.h"
 
 
 namespace net {
@@ -30,6 +32,7 @@ enum SpdySessionGetTypes {
 SpdySessionPool::SpdySessionPool(
     HostResolver* resolver,
     SSLConfigService* ssl_config_service,
+    TransportSecurityState* transport_security_state,
     const base::WeakPtr<HttpServerProperties>& http_server_properties,
     bool force_single_domain,
     bool enable_compression,
@@ -42,6 +45,7 @@ SpdySessionPool::SpdySessionPool(
     const std::string& trusted_spdy_proxy)
     : http_server_properties_(http_server_properties),
       ssl_config_service_(ssl_config_service),
+      transport_security_state_(transport_security_state),
       resolver_(resolver),
       verify_domain_authentication_(true),
       enable_sending_initial_data_(true),
@@ -191,6 +195,27 @@ base::WeakPtr<SpdySession> SpdySessionPool::FindAvailableSession(
       continue;
     }
 
+    // The new host must also satisfy its own public key pins, checked
+    // against the certificate chain the existing session presented.
+    SSLInfo ssl_info;
+    bool was_npn_negotiated = false;
+    NextProto protocol_negotiated = kProtoUnknown;
+    if (transport_security_state_ &&
+        available_session->GetSSLInfo(
+            &ssl_info, &was_npn_negotiated, &protocol_negotiated)) {
+      std::string pinning_failure_log;
+      if (transport_security_state_->HasPublicKeyPins(
+              key.host_port_pair().host(), true /* sni_enabled */) &&
+          !transport_security_state_->CheckPublicKeyPins(
+              key.host_port_pair().host(),
+              true /* sni_enabled */,
+              ssl_info.public_key_hashes,
+              &pinning_failure_log)) {
+        UMA_HISTOGRAM_ENUMERATION("Net.SpdyIPPoolDomainMatch", 0, 2);
+        continue;
+      }
+    }
+
     UMA_HISTOGRAM_ENUMERATION("Net.SpdyIPPoolDomainMatch", 1, 2);
     UMA_HISTOGRAM_ENUMERATION("Net.SpdySessionGet",
                               FOUND_EXISTING_FROM_IP_POOL,
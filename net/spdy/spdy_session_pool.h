@@ -34,6 +34,7 @@ class ClientSocketHandle;
 class HostResolver;
 class HttpServerProperties;
 class SpdySession;
+class TransportSecurityState;
 
 // This is a very simple pool for open SpdySessions.
 class NET_EXPORT SpdySessionPool
@@ -49,6 +50,7 @@ class NET_EXPORT SpdySessionPool
   SpdySessionPool(
       HostResolver* host_resolver,
       SSLConfigService* ssl_config_service,
+      TransportSecurityState* transport_security_state,
       const base::WeakPtr<HttpServerProperties>& http_server_properties,
       bool force_single_domain,
       bool enable_compression,
@@ -207,6 +209,8 @@ class NET_EXPORT SpdySessionPool
   static bool g_force_single_domain;
 
   const scoped_refptr<SSLConfigService> ssl_config_service_;
+  // May be NULL in tests.
+  TransportSecurityState* const transport_security_state_;
   HostResolver* const resolver_;
 
   // Defaults to true. May be controlled via SpdySessionPoolPeer for tests.
@@ -21,7 +21,9 @@
 
 #include "base/bind.h"
 #include "base/compiler_specific.h"
+#include "base/debug/alias.h"
 #include "base/file_util.h"
+#include "base/files/memory_mapped_file.h"
 #include "base/message_loop/message_loop.h"
 #include "base/strings/string_util.h"
 #include "base/synchronization/lock.h"
@@ -44,6 +46,16 @@
 #include "base/win/shortcut.h"
 #endif
 
+namespace {
+
+// Files no larger than this are memory-mapped and served straight from the
+// mapping instead of going through FileStream, which bounces every read
+// through the worker pool. The limit keeps the address space cost bounded
+// when many file requests are in flight.
+const int64 kMaxMappedFileSize = 1 << 20;
+
+}  // namespace
+
 namespace net {
 
 URLRequestFileJob::FileMetaInfo::FileMetaInfo()
@@ -62,6 +74,7 @@ URLRequestFileJob::URLRequestFileJob(
       file_path_(file_path),
       stream_(new FileStream(file_task_runner)),
       file_task_runner_(file_task_runner),
+      mapped_offset_(0),
       remaining_bytes_(0),
       weak_ptr_factory_(this) {}
 
@@ -78,6 +91,7 @@ void URLRequestFileJob::Start() {
 
 void URLRequestFileJob::Kill() {
   stream_.reset();
+  mapped_file_.reset();
   weak_ptr_factory_.InvalidateWeakPtrs();
 
   URLRequestJob::Kill();
@@ -100,6 +114,21 @@ bool URLRequestFileJob::ReadRawData(IOBuffer* dest,
     return true;
   }
 
+  if (mapped_file_) {
+    // The file is mapped and its pages were touched while still on the
+    // background thread, so this copy does not block on disk.
+    memcpy(dest->data(), mapped_file_->data() + mapped_offset_, dest_size);
+    mapped_offset_ += dest_size;
+    remaining_bytes_ -= dest_size;
+    DCHECK_GE(remaining_bytes_, 0);
+    *bytes_read = dest_size;
+    // The FileStream path reports reads that complete asynchronously through
+    // OnReadComplete(); do the same here so that subclasses observe every
+    // chunk of data served from the mapping.
+    OnReadComplete(dest, dest_size);
+    return true;
+  }
+
   int rv = stream_->Read(dest,
                          dest_size,
                          base::Bind(&URLRequestFileJob::DidRead,
@@ -218,6 +247,25 @@ void URLRequestFileJob::FetchMetaInfo(const base::FilePath& file_path,
                                                     &meta_info->mime_type);
 }
 
+void URLRequestFileJob::MapFile(const base::FilePath& file_path,
+                                base::MemoryMappedFile* mapped_file) {
+  if (!mapped_file->Initialize(file_path))
+    return;
+
+  // Touch every page while still on the background thread so that serving
+  // the data later does not fault on the network thread. This matters for
+  // files on slow media such as network filesystems.
+  const size_t kPageSize = 4096;
+  const uint8* data = mapped_file->data();
+  size_t length = mapped_file->length();
+  uint8 dummy = 0;
+  for (size_t offset = 0; offset < length; offset += kPageSize)
+    dummy ^= data[offset];
+  if (length)
+    dummy ^= data[length - 1];
+  base::debug::Alias(&dummy);
+}
+
 void URLRequestFileJob::DidFetchMetaInfo(const FileMetaInfo* meta_info) {
   meta_info_ = *meta_info;
 
@@ -238,6 +286,43 @@ void URLRequestFileJob::DidFetchMetaInfo(const FileMetaInfo* meta_info) {
     return;
   }
 
+  // Serve small files directly out of a memory mapping; larger files go
+  // through FileStream as before. Mapping happens on |file_task_runner_| so
+  // that the initial page faults stay off this thread.
+  if (meta_info_.file_size > 0 && meta_info_.file_size <= kMaxMappedFileSize) {
+    base::MemoryMappedFile* mapped_file = new base::MemoryMappedFile();
+    file_task_runner_->PostTaskAndReply(
+        FROM_HERE,
+        base::Bind(&URLRequestFileJob::MapFile, file_path_,
+                   base::Unretained(mapped_file)),
+        base::Bind(&URLRequestFileJob::DidMapFile,
+                   weak_ptr_factory_.GetWeakPtr(),
+                   base::Passed(scoped_ptr<base::MemoryMappedFile>(
+                       mapped_file))));
+    return;
+  }
+
+  int flags = base::File::FLAG_OPEN |
+              base::File::FLAG_READ |
+              base::File::FLAG_ASYNC;
+  int rv = stream_->Open(file_path_, flags,
+                         base::Bind(&URLRequestFileJob::DidOpen,
+                                    weak_ptr_factory_.GetWeakPtr()));
+  if (rv != ERR_IO_PENDING)
+    DidOpen(rv);
+}
+
+void URLRequestFileJob::DidMapFile(
+    scoped_ptr<base::MemoryMappedFile> mapped_file) {
+  if (mapped_file->IsValid() &&
+      mapped_file->length() == static_cast<size_t>(meta_info_.file_size)) {
+    mapped_file_ = mapped_file.Pass();
+    DidOpen(OK);
+    return;
+  }
+
+  // Mapping can fail (or observe a size that no longer matches the metadata)
+  // if the file changed underneath us; fall back to the FileStream path.
   int flags = base::File::FLAG_OPEN |
               base::File::FLAG_READ |
               base::File::FLAG_ASYNC;
@@ -264,6 +349,14 @@ void URLRequestFileJob::DidOpen(int result) {
                      byte_range_.first_byte_position() + 1;
   DCHECK_GE(remaining_bytes_, 0);
 
+  if (mapped_file_) {
+    // No seek is necessary with a mapping; just start serving from the
+    // requested position.
+    mapped_offset_ = byte_range_.first_byte_position();
+    DidSeek(byte_range_.first_byte_position());
+    return;
+  }
+
   if (remaining_bytes_ > 0 && byte_range_.first_byte_position() != 0) {
     int rv = stream_->Seek(base::File::FROM_BEGIN,
                            byte_range_.first_byte_position(),
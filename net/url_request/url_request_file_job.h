@@ -17,6 +17,7 @@
 #include "net/url_request/url_request_job.h"
 
 namespace base {
+class MemoryMappedFile;
 class TaskRunner;
 }
 namespace file_util {
@@ -84,9 +85,17 @@ class NET_EXPORT URLRequestFileJob : public URLRequestJob {
   static void FetchMetaInfo(const base::FilePath& file_path,
                             FileMetaInfo* meta_info);
 
+  // Maps |file_path| into memory and touches every page so the data is
+  // resident before it is served. Runs on a background thread.
+  static void MapFile(const base::FilePath& file_path,
+                      base::MemoryMappedFile* mapped_file);
+
   // Callback after fetching file info on a background thread.
   void DidFetchMetaInfo(const FileMetaInfo* meta_info);
 
+  // Callback after mapping the file on a background thread.
+  void DidMapFile(scoped_ptr<base::MemoryMappedFile> mapped_file);
+
   // Callback after opening file on a background thread.
   void DidOpen(int result);
 
@@ -101,6 +110,13 @@ class NET_EXPORT URLRequestFileJob : public URLRequestJob {
   FileMetaInfo meta_info_;
   const scoped_refptr<base::TaskRunner> file_task_runner_;
 
+  // For small files the whole file is memory-mapped up front and reads are
+  // served directly from the mapping with no further I/O hops; |stream_| is
+  // not opened in that case. |mapped_offset_| is the position of the next
+  // byte to serve, honoring any byte range.
+  scoped_ptr<base::MemoryMappedFile> mapped_file_;
+  int64 mapped_offset_;
+
   HttpByteRange byte_range_;
   int64 remaining_bytes_;
 
@@ -33,6 +33,8 @@ URLRequestFtpJob::URLRequestFtpJob(
       proxy_service_(request_->context()->proxy_service()),
       pac_request_(NULL),
       http_response_info_(NULL),
+      read_callback_(base::Bind(&URLRequestFtpJob::OnReadCompleted,
+                                base::Unretained(this))),
       read_in_progress_(false),
       ftp_transaction_factory_(ftp_transaction_factory),
       ftp_auth_cache_(ftp_auth_cache),
@@ -353,15 +355,13 @@ bool URLRequestFtpJob::ReadRawData(IOBuffer* buf,
   DCHECK(bytes_read);
   DCHECK(!read_in_progress_);
 
+  // Use the callback bound at construction so that each read does not
+  // allocate a new BindState.
   int rv;
   if (proxy_info_.is_direct()) {
-    rv = ftp_transaction_->Read(buf, buf_size,
-                                base::Bind(&URLRequestFtpJob::OnReadCompleted,
-                                           base::Unretained(this)));
+    rv = ftp_transaction_->Read(buf, buf_size, read_callback_);
   } else {
-    rv = http_transaction_->Read(buf, buf_size,
-                                 base::Bind(&URLRequestFtpJob::OnReadCompleted,
-                                            base::Unretained(this)));
+    rv = http_transaction_->Read(buf, buf_size, read_callback_);
   }
 
   if (rv >= 0) {
@@ -9,6 +9,7 @@
 
 #include "base/memory/weak_ptr.h"
 #include "net/base/auth.h"
+#include "net/base/completion_callback.h"
 #include "net/base/net_export.h"
 #include "net/ftp/ftp_request_info.h"
 #include "net/ftp/ftp_transaction.h"
@@ -90,6 +91,8 @@ class NET_EXPORT_PRIVATE URLRequestFtpJob : public URLRequestJob {
   scoped_ptr<HttpTransaction> http_transaction_;
   const HttpResponseInfo* http_response_info_;
 
+  CompletionCallback read_callback_;
+
   bool read_in_progress_;
 
   scoped_refptr<AuthData> auth_data_;
@@ -187,6 +187,8 @@ URLRequestHttpJob::URLRequestHttpJob(
       notify_before_headers_sent_callback_(
           base::Bind(&URLRequestHttpJob::NotifyBeforeSendHeadersCallback,
                      base::Unretained(this))),
+      read_callback_(base::Bind(&URLRequestHttpJob::OnReadCompleted,
+                                base::Unretained(this))),
       read_in_progress_(false),
       throttling_entry_(NULL),
       sdch_dictionary_advertised_(false),
@@ -1246,9 +1248,10 @@ bool URLRequestHttpJob::ReadRawData(IOBuffer* buf, int buf_size,
   DCHECK(bytes_read);
   DCHECK(!read_in_progress_);
 
-  int rv = transaction_->Read(
-      buf, buf_size,
-      base::Bind(&URLRequestHttpJob::OnReadCompleted, base::Unretained(this)));
+  // Use the callback bound at construction so that each read does not
+  // allocate a new BindState; ReadRawData runs once per chunk of the
+  // response body.
+  int rv = transaction_->Read(buf, buf_size, read_callback_);
 
   if (ShouldFixMismatchedContentLength(rv))
     rv = 0;
@@ -192,6 +192,7 @@ class NET_EXPORT_PRIVATE URLRequestHttpJob : public URLRequestJob {
 
   CompletionCallback start_callback_;
   CompletionCallback notify_before_headers_sent_callback_;
+  CompletionCallback read_callback_;
 
   bool read_in_progress_;
 
@@ -430,14 +430,22 @@ void WebSocketChannel::SendFlowControl(int64 quota) {
     const size_t bytes_to_send =
         std::min(base::checked_cast<size_t>(quota), data_size);
     const bool final = front.final() && data_size == bytes_to_send;
-    const char* data = front.data() ?
-        front.data()->data() + front.offset() : NULL;
-    DCHECK(!bytes_to_send || data) << "Non empty data should not be null.";
-    const std::vector<char> data_vector(data, data + bytes_to_send);
+    DCHECK(!bytes_to_send || front.data())
+        << "Non empty data should not be null.";
+    scoped_refptr<IOBuffer> buffer_to_pass = front.data();
+    if (front.offset() != 0) {
+      // A DrainableIOBuffer is used to pass the unconsumed tail of the frame
+      // without copying it into a fresh buffer.
+      scoped_refptr<DrainableIOBuffer> drainable_buffer(new DrainableIOBuffer(
+          front.data(), front.offset() + bytes_to_send));
+      drainable_buffer->SetOffset(front.offset());
+      buffer_to_pass = drainable_buffer;
+    }
     DVLOG(3) << "Sending frame previously split due to quota to the "
              << "renderer: quota=" << quota << " data_size=" << data_size
              << " bytes_to_send=" << bytes_to_send;
-    if (event_interface_->OnDataFrame(final, front.opcode(), data_vector) ==
+    if (event_interface_->OnDataFrame(
+            final, front.opcode(), buffer_to_pass, bytes_to_send) ==
         CHANNEL_DELETED)
       return;
     if (bytes_to_send < data_size) {
@@ -942,15 +950,14 @@ ChannelState WebSocketChannel::HandleDataFrame(
     final = false;
   }
 
-  // TODO(ricea): Can this copy be eliminated?
-  const char* const data_begin = size ? data_buffer->data() : NULL;
-  const char* const data_end = data_begin + size;
-  const std::vector<char> data(data_begin, data_end);
   current_receive_quota_ -= size;
   DCHECK_GE(current_receive_quota_, 0);
 
-  // Sends the received frame to the renderer process.
-  return event_interface_->OnDataFrame(final, opcode_to_send, data);
+  // Sends the received frame to the renderer process. The IOBuffer is handed
+  // off as-is; the payload is not copied again on this side of the IPC
+  // boundary.
+  return event_interface_->OnDataFrame(final, opcode_to_send, data_buffer,
+                                       size);
 }
 
 ChannelState WebSocketChannel::SendFrameFromIOBuffer(
@@ -20,6 +20,7 @@
 #include "base/memory/weak_ptr.h"
 #include "base/message_loop/message_loop.h"
 #include "base/strings/string_piece.h"
+#include "net/base/io_buffer.h"
 #include "net/base/net_errors.h"
 #include "net/base/test_completion_callback.h"
 #include "net/http/http_response_headers.h"
@@ -151,10 +152,22 @@ class MockWebSocketEventInterface : public WebSocketEventInterface {
                ChannelState(bool,
                             const std::string&,
                             const std::string&));  // NOLINT
-  MOCK_METHOD3(OnDataFrame,
+  MOCK_METHOD3(OnDataFrameVector,
                ChannelState(bool,
                             WebSocketMessageType,
                             const std::vector<char>&));  // NOLINT
+
+  // GMock cannot usefully compare IOBuffer contents, so tests set their
+  // expectations on OnDataFrameVector() instead.
+  virtual ChannelState OnDataFrame(bool fin,
+                                   WebSocketMessageType type,
+                                   scoped_refptr<IOBuffer> buffer,
+                                   size_t buffer_size) OVERRIDE {
+    const char* data = buffer ? buffer->data() : NULL;
+    return OnDataFrameVector(
+        fin, type, std::vector<char>(data, data + buffer_size));
+  }
+
   MOCK_METHOD1(OnFlowControl, ChannelState(int64));  // NOLINT
   MOCK_METHOD0(OnClosingHandshake, ChannelState(void));  // NOLINT
   MOCK_METHOD1(OnFailChannel, ChannelState(const std::string&));  // NOLINT
@@ -200,7 +213,8 @@ class FakeWebSocketEventInterface : public WebSocketEventInterface {
   }
   virtual ChannelState OnDataFrame(bool fin,
                                    WebSocketMessageType type,
-                                   const std::vector<char>& data) OVERRIDE {
+                                   scoped_refptr<IOBuffer> buffer,
+                                   size_t buffer_size) OVERRIDE {
     return CHANNEL_ALIVE;
   }
   virtual ChannelState OnFlowControl(int64 quota) OVERRIDE {
@@ -876,7 +890,8 @@ class ChannelDeletingFakeWebSocketEventInterface
 
   virtual ChannelState OnDataFrame(bool fin,
                                    WebSocketMessageType type,
-                                   const std::vector<char>& data) OVERRIDE {
+                                   scoped_refptr<IOBuffer> buffer,
+                                   size_t buffer_size) OVERRIDE {
     return fixture_->DeleteIfDeleting(EVENT_ON_DATA_FRAME);
   }
 
@@ -1394,7 +1409,7 @@ TEST_F(WebSocketChannelEventInterfaceTest, DataLeftFromHandshake) {
     EXPECT_CALL(*event_interface_, OnFlowControl(_));
     EXPECT_CALL(
         *event_interface_,
-        OnDataFrame(
+        OnDataFrameVector(
             true, WebSocketFrameHeader::kOpCodeText, AsVector("HELLO")));
   }
 
@@ -1463,7 +1478,7 @@ TEST_F(WebSocketChannelEventInterfaceTest, NormalAsyncRead) {
     EXPECT_CALL(checkpoint, Call(1));
     EXPECT_CALL(
         *event_interface_,
-        OnDataFrame(
+        OnDataFrameVector(
             true, WebSocketFrameHeader::kOpCodeText, AsVector("HELLO")));
     EXPECT_CALL(checkpoint, Call(2));
   }
@@ -1492,11 +1507,11 @@ TEST_F(WebSocketChannelEventInterfaceTest, AsyncThenSyncRead) {
     EXPECT_CALL(*event_interface_, OnFlowControl(_));
     EXPECT_CALL(
         *event_interface_,
-        OnDataFrame(
+        OnDataFrameVector(
             true, WebSocketFrameHeader::kOpCodeText, AsVector("HELLO")));
     EXPECT_CALL(
         *event_interface_,
-        OnDataFrame(
+        OnDataFrameVector(
             true, WebSocketFrameHeader::kOpCodeText, AsVector("WORLD")));
   }
 
@@ -1534,22 +1549,22 @@ TEST_F(WebSocketChannelEventInterfaceTest, FragmentedMessage) {
     EXPECT_CALL(*event_interface_, OnFlowControl(_));
     EXPECT_CALL(
         *event_interface_,
-        OnDataFrame(
+        OnDataFrameVector(
             false, WebSocketFrameHeader::kOpCodeText, AsVector("THREE")));
     EXPECT_CALL(
         *event_interface_,
-        OnDataFrame(
+        OnDataFrameVector(
             false, WebSocketFrameHeader::kOpCodeContinuation, AsVector(" ")));
     EXPECT_CALL(*event_interface_,
-                OnDataFrame(false,
+                OnDataFrameVector(false,
                             WebSocketFrameHeader::kOpCodeContinuation,
                             AsVector("SMALL")));
     EXPECT_CALL(
         *event_interface_,
-        OnDataFrame(
+        OnDataFrameVector(
             false, WebSocketFrameHeader::kOpCodeContinuation, AsVector(" ")));
     EXPECT_CALL(*event_interface_,
-                OnDataFrame(true,
+                OnDataFrameVector(true,
                             WebSocketFrameHeader::kOpCodeContinuation,
                             AsVector("FRAMES")));
   }
@@ -1570,7 +1585,7 @@ TEST_F(WebSocketChannelEventInterfaceTest, NullMessage) {
   EXPECT_CALL(*event_interface_, OnFlowControl(_));
   EXPECT_CALL(
       *event_interface_,
-      OnDataFrame(true, WebSocketFrameHeader::kOpCodeText, AsVector("")));
+      OnDataFrameVector(true, WebSocketFrameHeader::kOpCodeText, AsVector("")));
   CreateChannelAndConnectSuccessfully();
 }
 
@@ -1681,10 +1696,10 @@ TEST_F(WebSocketChannelEventInterfaceTest, ControlFrameInDataMessage) {
     EXPECT_CALL(*event_interface_, OnFlowControl(_));
     EXPECT_CALL(
         *event_interface_,
-        OnDataFrame(
+        OnDataFrameVector(
             false, WebSocketFrameHeader::kOpCodeText, AsVector("SPLIT ")));
     EXPECT_CALL(*event_interface_,
-                OnDataFrame(true,
+                OnDataFrameVector(true,
                             WebSocketFrameHeader::kOpCodeContinuation,
                             AsVector("MESSAGE")));
   }
@@ -2331,14 +2346,14 @@ TEST_F(WebSocketChannelFlowControlTest, SingleFrameMessageSplitSync) {
     EXPECT_CALL(*event_interface_, OnFlowControl(_));
     EXPECT_CALL(
         *event_interface_,
-        OnDataFrame(false, WebSocketFrameHeader::kOpCodeText, AsVector("FO")));
+        OnDataFrameVector(false, WebSocketFrameHeader::kOpCodeText, AsVector("FO")));
     EXPECT_CALL(
         *event_interface_,
-        OnDataFrame(
+        OnDataFrameVector(
             false, WebSocketFrameHeader::kOpCodeContinuation, AsVector("U")));
     EXPECT_CALL(
         *event_interface_,
-        OnDataFrame(
+        OnDataFrameVector(
             true, WebSocketFrameHeader::kOpCodeContinuation, AsVector("R")));
   }
 
@@ -2364,16 +2379,16 @@ TEST_F(WebSocketChannelFlowControlTest, SingleFrameMessageSplitAsync) {
     EXPECT_CALL(checkpoint, Call(1));
     EXPECT_CALL(
         *event_interface_,
-        OnDataFrame(false, WebSocketFrameHeader::kOpCodeText, AsVector("FO")));
+        OnDataFrameVector(false, WebSocketFrameHeader::kOpCodeText, AsVector("FO")));
     EXPECT_CALL(checkpoint, Call(2));
     EXPECT_CALL(
         *event_interface_,
-        OnDataFrame(
+        OnDataFrameVector(
             false, WebSocketFrameHeader::kOpCodeContinuation, AsVector("U")));
     EXPECT_CALL(checkpoint, Call(3));
     EXPECT_CALL(
         *event_interface_,
-        OnDataFrame(
+        OnDataFrameVector(
             true, WebSocketFrameHeader::kOpCodeContinuation, AsVector("R")));
   }
 
@@ -2408,23 +2423,23 @@ TEST_F(WebSocketChannelFlowControlTest, MultipleFrameSplit) {
     EXPECT_CALL(*event_interface_, OnAddChannelResponse(false, _, _));
     EXPECT_CALL(*event_interface_, OnFlowControl(_));
     EXPECT_CALL(*event_interface_,
-                OnDataFrame(false,
+                OnDataFrameVector(false,
                             WebSocketFrameHeader::kOpCodeText,
                             AsVector("FIRST FRAME IS")));
     EXPECT_CALL(*event_interface_,
-                OnDataFrame(false,
+                OnDataFrameVector(false,
                             WebSocketFrameHeader::kOpCodeContinuation,
                             AsVector(" 25 BYTES. ")));
     EXPECT_CALL(*event_interface_,
-                OnDataFrame(false,
+                OnDataFrameVector(false,
                             WebSocketFrameHeader::kOpCodeContinuation,
                             AsVector("SECOND FRAME IS 26 BYTES. ")));
     EXPECT_CALL(*event_interface_,
-                OnDataFrame(false,
+                OnDataFrameVector(false,
                             WebSocketFrameHeader::kOpCodeContinuation,
                             AsVector("FINAL ")));
     EXPECT_CALL(*event_interface_,
-                OnDataFrame(true,
+                OnDataFrameVector(true,
                             WebSocketFrameHeader::kOpCodeContinuation,
                             AsVector("FRAME IS 24 BYTES.")));
   }
@@ -2452,19 +2467,19 @@ TEST_F(WebSocketChannelFlowControlTest, EmptyMessageNoQuota) {
     EXPECT_CALL(*event_interface_, OnAddChannelResponse(false, _, _));
     EXPECT_CALL(*event_interface_, OnFlowControl(_));
     EXPECT_CALL(*event_interface_,
-                OnDataFrame(false,
+                OnDataFrameVector(false,
                             WebSocketFrameHeader::kOpCodeText,
                             AsVector("FIRST ")));
     EXPECT_CALL(*event_interface_,
-                OnDataFrame(true,
+                OnDataFrameVector(true,
                             WebSocketFrameHeader::kOpCodeContinuation,
                             AsVector("MESSAGE")));
     EXPECT_CALL(*event_interface_,
-                OnDataFrame(true,
+                OnDataFrameVector(true,
                             WebSocketFrameHeader::kOpCodeText,
                             AsVector("")));
     EXPECT_CALL(*event_interface_,
-                OnDataFrame(true,
+                OnDataFrameVector(true,
                             WebSocketFrameHeader::kOpCodeText,
                             AsVector("THIRD MESSAGE")));
   }
@@ -2885,7 +2900,7 @@ TEST_F(WebSocketChannelEventInterfaceTest, ReadBinaryFramesAre8BitClean) {
   EXPECT_CALL(*event_interface_, OnAddChannelResponse(false, _, _));
   EXPECT_CALL(*event_interface_, OnFlowControl(_));
   EXPECT_CALL(*event_interface_,
-              OnDataFrame(true,
+              OnDataFrameVector(true,
                           WebSocketFrameHeader::kOpCodeBinary,
                           std::vector<char>(kBinaryBlob,
                                             kBinaryBlob + kBinaryBlobSize)));
@@ -3195,7 +3210,7 @@ TEST_F(WebSocketChannelEventInterfaceTest, BogusContinuation) {
   EXPECT_CALL(*event_interface_, OnFlowControl(kDefaultInitialQuota));
   EXPECT_CALL(
       *event_interface_,
-      OnDataFrame(
+      OnDataFrameVector(
           false, WebSocketFrameHeader::kOpCodeBinary, AsVector("frame1")));
   EXPECT_CALL(
       *event_interface_,
@@ -3240,7 +3255,7 @@ TEST_F(WebSocketChannelEventInterfaceTest, DataFramesNonEmptyOrFinal) {
   EXPECT_CALL(*event_interface_, OnFlowControl(kDefaultInitialQuota));
   EXPECT_CALL(
       *event_interface_,
-      OnDataFrame(true, WebSocketFrameHeader::kOpCodeText, AsVector("")));
+      OnDataFrameVector(true, WebSocketFrameHeader::kOpCodeText, AsVector("")));
 
   CreateChannelAndConnectSuccessfully();
 }
@@ -10,12 +10,14 @@
 
 #include "base/basictypes.h"
 #include "base/compiler_specific.h"  // for WARN_UNUSED_RESULT
+#include "base/memory/ref_counted.h"
 #include "net/base/net_export.h"
 
 class GURL;
 
 namespace net {
 
+class IOBuffer;
 class SSLInfo;
 struct WebSocketHandshakeRequestInfo;
 struct WebSocketHandshakeResponseInfo;
@@ -46,11 +48,14 @@ class NET_EXPORT WebSocketEventInterface {
       const std::string& extensions) WARN_UNUSED_RESULT = 0;
 
   // Called when a data frame has been received from the remote host and needs
-  // to be forwarded to the renderer process.
-  virtual ChannelState OnDataFrame(
-      bool fin,
-      WebSocketMessageType type,
-      const std::vector<char>& data) WARN_UNUSED_RESULT = 0;
+  // to be forwarded to the renderer process. The payload is passed as the
+  // IOBuffer it was read into, rather than being copied into a new container;
+  // |buffer| may be NULL when |buffer_size| is zero, and implementations must
+  // not assume the data is NUL-terminated.
+  virtual ChannelState OnDataFrame(bool fin,
+                                   WebSocketMessageType type,
+                                   scoped_refptr<IOBuffer> buffer,
+                                   size_t buffer_size) WARN_UNUSED_RESULT = 0;
 
   // Called to provide more send quota for this channel to the renderer
   // process. Currently the quota units are always bytes of message body
@@ -27,11 +27,18 @@ const uint32 kThumbnailBackgroundColor = 0xFF000000;
 const uint32 kSlidingTimeoutMs = 50;
 const int32 kSlidingShift = 50;
 
+// Delay before pre-rasterizing thumbnails for pages near the visible range,
+// and between consecutive pre-rasterized pages. Rasterization happens on the
+// plugin thread, so pages are spread out over separate timer callbacks to
+// avoid blocking input handling for too long.
+const uint32 kPrefetchTimeoutMs = 100;
+
 const double kNonSelectedThumbnailAlpha = 0.91;
 
 ThumbnailControl::ThumbnailControl()
     : engine_(NULL), sliding_width_(0), sliding_shift_(kSlidingShift),
-      sliding_timeout_(kSlidingTimeoutMs), sliding_timer_id_(0) {
+      sliding_timeout_(kSlidingTimeoutMs), sliding_timer_id_(0),
+      prefetch_timer_id_(0) {
 }
 
 ThumbnailControl::~ThumbnailControl() {
@@ -52,6 +59,7 @@ bool ThumbnailControl::CreateThumbnailControl(
 void ThumbnailControl::SetPosition(int position, int total, bool invalidate) {
   visible_rect_ = pp::Rect();
   visible_pages_.clear();
+  prefetch_pages_.clear();
 
   if (rect().width() < kLeftBorderSize + kBorderSize) {
     return;  // control is too narrow to show thumbnails.
@@ -97,16 +105,24 @@ void ThumbnailControl::SetPosition(int position, int total, bool invalidate) {
   }
   visible_rect_ = pp::Rect(0, visible_y, max_thumbnail_width, rect().height());
 
+  // Pages within half a control height of the visible range are likely to
+  // scroll into view soon; pre-rasterize their thumbnails in the background.
+  pp::Rect prefetch_rect = visible_rect_;
+  prefetch_rect.Inset(0, -rect().height() / 2);
+
   for (int i = 0; i < num_pages; ++i) {
-    if (page_sizes[i].Intersects(visible_rect_)) {
-      PageInfo page_info;
-      page_info.index = i;
-      page_info.rect = page_sizes[i];
-      page_info.rect.Offset(kLeftBorderSize, -visible_rect_.y());
+    PageInfo page_info;
+    page_info.index = i;
+    page_info.rect = page_sizes[i];
+    page_info.rect.Offset(kLeftBorderSize, -visible_rect_.y());
+    if (page_sizes[i].Intersects(visible_rect_))
       visible_pages_.push_back(page_info);
-    }
+    else if (page_sizes[i].Intersects(prefetch_rect))
+      prefetch_pages_.push_back(page_info);
   }
 
+  SchedulePrefetch();
+
   if (invalidate)
     owner()->Invalidate(id(), rect());
 }
@@ -116,6 +132,8 @@ void ThumbnailControl::Show(bool visible, bool invalidate) {
     ClearCache();
   sliding_width_ = rect().width();
   Control::Show(visible, invalidate);
+  if (visible)
+    SchedulePrefetch();
 }
 
 void ThumbnailControl::SlideIn() {
@@ -182,39 +200,8 @@ void ThumbnailControl::Paint(pp::ImageData* image_data, const pp::Rect& rc) {
     if (draw_page_rc.IsEmpty())
       continue;
 
-    // First search page image in the cache.
-    pp::ImageData* thumbnail = NULL;
-    std::map<int, pp::ImageData*>::iterator it =
-        image_cache_.find(visible_pages_[i].index);
-    if (it != image_cache_.end()) {
-      if (it->second->size() == page_rc.size())
-        thumbnail = image_cache_[visible_pages_[i].index];
-      else
-        image_cache_.erase(it);
-    }
-
-    // If page is not found in the cache, create new one.
-    if (thumbnail == NULL) {
-      thumbnail = new pp::ImageData(owner()->GetInstance(),
-                                    PP_IMAGEDATAFORMAT_BGRA_PREMUL,
-                                    page_rc.size(),
-                                    false);
-      engine_->PaintThumbnail(thumbnail, visible_pages_[i].index);
-
-      pp::ImageData page_number;
-      number_image_generator_->GenerateImage(
-          visible_pages_[i].index + 1, &page_number);
-      pp::Point origin(
-          (thumbnail->size().width() - page_number.size().width()) / 2,
-          (thumbnail->size().height() - page_number.size().height()) / 2);
-
-      if (origin.x() > 0 && origin.y() > 0) {
-        AlphaBlend(page_number, pp::Rect(pp::Point(), page_number.size()),
-                   thumbnail, origin, kOpaqueAlpha);
-      }
-
-      image_cache_[visible_pages_[i].index] = thumbnail;
-    }
+    pp::ImageData* thumbnail =
+        GetPageImage(visible_pages_[i].index, page_rc.size());
 
     uint8 alpha = transparency();
     if (visible_pages_[i].index != selected_page)
@@ -226,6 +213,45 @@ void ThumbnailControl::Paint(pp::ImageData* image_data, const pp::Rect& rc) {
   }
 }
 
+pp::ImageData* ThumbnailControl::GetPageImage(int index,
+                                              const pp::Size& size) {
+  // First search page image in the cache.
+  std::map<int, pp::ImageData*>::iterator it = image_cache_.find(index);
+  if (it != image_cache_.end()) {
+    if (it->second->size() == size)
+      return it->second;
+    delete it->second;
+    image_cache_.erase(it);
+  }
+
+  // If page is not found in the cache, create new one.
+  pp::ImageData* thumbnail = new pp::ImageData(owner()->GetInstance(),
+                                               PP_IMAGEDATAFORMAT_BGRA_PREMUL,
+                                               size,
+                                               false);
+  engine_->PaintThumbnail(thumbnail, index);
+
+  pp::ImageData page_number;
+  number_image_generator_->GenerateImage(index + 1, &page_number);
+  pp::Point origin(
+      (thumbnail->size().width() - page_number.size().width()) / 2,
+      (thumbnail->size().height() - page_number.size().height()) / 2);
+
+  if (origin.x() > 0 && origin.y() > 0) {
+    AlphaBlend(page_number, pp::Rect(pp::Point(), page_number.size()),
+               thumbnail, origin, kOpaqueAlpha);
+  }
+
+  image_cache_[index] = thumbnail;
+  return thumbnail;
+}
+
+void ThumbnailControl::SchedulePrefetch() {
+  if (!visible() || prefetch_pages_.empty() || prefetch_timer_id_)
+    return;
+  prefetch_timer_id_ = owner()->ScheduleTimer(id(), kPrefetchTimeoutMs);
+}
+
 bool ThumbnailControl::HandleEvent(const pp::InputEvent& event) {
   if (!visible())
     return false;
@@ -269,6 +295,26 @@ bool ThumbnailControl::HandleEvent(const pp::InputEvent& event) {
 }
 
 void ThumbnailControl::OnTimerFired(uint32 timer_id) {
+  if (timer_id == prefetch_timer_id_) {
+    prefetch_timer_id_ = 0;
+    if (!visible())
+      return;
+    // Rasterize at most one page per callback, rescheduling until all nearby
+    // pages are in the cache; a single page keeps each callback short.
+    for (size_t i = 0; i < prefetch_pages_.size(); ++i) {
+      const PageInfo& page_info = prefetch_pages_[i];
+      std::map<int, pp::ImageData*>::iterator it =
+          image_cache_.find(page_info.index);
+      if (it != image_cache_.end() &&
+          it->second->size() == page_info.rect.size()) {
+        continue;
+      }
+      GetPageImage(page_info.index, page_info.rect.size());
+      SchedulePrefetch();
+      break;
+    }
+    return;
+  }
   if (timer_id == sliding_timer_id_) {
     sliding_width_ += sliding_shift_;
     if (sliding_width_ <= 0) {
@@ -51,14 +51,25 @@ class ThumbnailControl : public Control {
     pp::Rect rect;
   };
 
+  // Returns the cached thumbnail image for the given page, rasterizing it
+  // and adding it to the cache first if necessary.
+  pp::ImageData* GetPageImage(int index, const pp::Size& size);
+
+  // Schedules a timer to rasterize thumbnails for the pages just outside the
+  // visible range, so they are already in the cache when the user scrolls.
+  void SchedulePrefetch();
+
   PDFEngine* engine_;
   pp::Rect visible_rect_;
   std::vector<PageInfo> visible_pages_;
+  // Pages adjacent to the visible range, candidates for pre-rasterization.
+  std::vector<PageInfo> prefetch_pages_;
   std::map<int, pp::ImageData*> image_cache_;
   int sliding_width_;
   int sliding_shift_;
   int sliding_timeout_;
   uint32 sliding_timer_id_;
+  uint32 prefetch_timer_id_;
   NumberImageGenerator* number_image_generator_;
 };
 
@@ -4,6 +4,8 @@
 
 #include "remoting/codec/video_encoder_vpx.h"
 
+#include <algorithm>
+
 #include "base/bind.h"
 #include "base/command_line.h"
 #include "base/logging.h"
@@ -39,6 +41,23 @@ const int kMacroBlockSize = 16;
 const int kVp9I420ProfileNumber = 0;
 const int kVp9I444ProfileNumber = 1;
 
+// Scales the number of encode threads with the area of the desktop being
+// encoded, so large (e.g. 1080p) screens are sliced across several cores while
+// small ones keep the near single-threaded setup that low-end machines need:
+// http://crbug.com/99179
+int GetEncoderThreadCount(const webrtc::DesktopSize& size) {
+  int thread_count = 1;
+  if (size.width() * size.height() >= 1920 * 1080) {
+    thread_count = 4;
+  } else if (size.width() * size.height() >= 1280 * 720) {
+    thread_count = 2;
+  }
+
+  // Leave at least one processor free to service capture and the network.
+  int processors = base::SysInfo::NumberOfProcessors();
+  return std::min(thread_count, std::max(processors - 1, 1));
+}
+
 void SetCommonCodecParameters(const webrtc::DesktopSize& size,
                               vpx_codec_enc_cfg_t* config) {
   // Use millisecond granularity time base.
@@ -56,11 +75,7 @@ void SetCommonCodecParameters(const webrtc::DesktopSize& size,
   // Start emitting packets immediately.
   config->g_lag_in_frames = 0;
 
-  // Using 2 threads gives a great boost in performance for most systems with
-  // adequate processing power. NB: Going to multiple threads on low end
-  // windows systems can really hurt performance.
-  // http://crbug.com/99179
-  config->g_threads = (base::SysInfo::NumberOfProcessors() > 2) ? 2 : 1;
+  config->g_threads = GetEncoderThreadCount(size);
 }
 
 ScopedVpxCodec CreateVP8Codec(const webrtc::DesktopSize& size) {
@@ -98,6 +113,19 @@ ScopedVpxCodec CreateVP8Codec(const webrtc::DesktopSize& size) {
   if (vpx_codec_control(codec.get(), VP8E_SET_NOISE_SENSITIVITY, 0))
     return ScopedVpxCodec();
 
+  // Split the bitstream into one token partition per encode thread, so that
+  // the slices can be encoded, and later decoded, in parallel.
+  vp8e_token_partitions token_partitions = VP8_ONE_TOKENPARTITION;
+  if (config.g_threads >= 4) {
+    token_partitions = VP8_FOUR_TOKENPARTITION;
+  } else if (config.g_threads >= 2) {
+    token_partitions = VP8_TWO_TOKENPARTITION;
+  }
+  if (vpx_codec_control(codec.get(), VP8E_SET_TOKEN_PARTITIONS,
+                        token_partitions)) {
+    return ScopedVpxCodec();
+  }
+
   return codec.Pass();
 }
 
@@ -144,6 +172,17 @@ ScopedVpxCodec CreateVP9Codec(const webrtc::DesktopSize& size,
   if (vpx_codec_control(codec.get(), VP8E_SET_NOISE_SENSITIVITY, 0))
     return ScopedVpxCodec();
 
+  // Tile the frame into one column per encode thread, so that the tiles can
+  // be encoded in parallel. VP9 requires tiles to be at least 256 pixels
+  // wide, so clamp the tile count for narrow desktops.
+  int tile_columns_log2 = 0;
+  while ((1 << (tile_columns_log2 + 1)) <= static_cast<int>(config.g_threads)
+         && (size.width() >> (tile_columns_log2 + 1)) >= 256) {
+    ++tile_columns_log2;
+  }
+  if (vpx_codec_control(codec.get(), VP9E_SET_TILE_COLUMNS, tile_columns_log2))
+    return ScopedVpxCodec();
+
   return codec.Pass();
 }
 
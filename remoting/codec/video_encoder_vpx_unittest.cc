@@ -95,6 +95,23 @@ TEST(VideoEncoderVpxTest, TestVp9VideoEncoderLossyColor) {
   EXPECT_LT(lossy_packet->data().size(), lossless_packet->data().size());
 }
 
+// 1080p frames engage the multi-threaded slice (VP8) and tile (VP9) encoder
+// configurations; verify that both encoders still produce output for them.
+TEST(VideoEncoderVpxTest, TestMultiThreadedFrameEncode) {
+  webrtc::DesktopSize frame_size(1920, 1080);
+  scoped_ptr<webrtc::DesktopFrame> frame(CreateTestFrame(frame_size));
+  frame->mutable_updated_region()->SetRect(
+      webrtc::DesktopRect::MakeSize(frame_size));
+
+  scoped_ptr<VideoEncoderVpx> vp8_encoder(VideoEncoderVpx::CreateForVP8());
+  scoped_ptr<VideoPacket> vp8_packet = vp8_encoder->Encode(*frame);
+  EXPECT_TRUE(vp8_packet->has_data());
+
+  scoped_ptr<VideoEncoderVpx> vp9_encoder(VideoEncoderVpx::CreateForVP9());
+  scoped_ptr<VideoPacket> vp9_packet = vp9_encoder->Encode(*frame);
+  EXPECT_TRUE(vp9_packet->has_data());
+}
+
 // Test that the VP8 encoder ignores lossless modes without crashing.
 TEST(VideoEncoderVpxTest, TestVp8VideoEncoderIgnoreLossy) {
   scoped_ptr<VideoEncoderVpx> encoder(VideoEncoderVpx::CreateForVP8());
@@ -0,0 +1,89 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "remoting/host/shared_memory_pool.h"
+
+#include "base/memory/shared_memory.h"
+#include "base/stl_util.h"
+#include "third_party/webrtc/modules/desktop_capture/shared_memory.h"
+
+namespace remoting {
+
+namespace {
+
+// Maximum number of buffers kept mapped while waiting for reuse. The capture
+// pipeline keeps at most two frames in flight, plus one for the frame being
+// written.
+const size_t kMaxFreeBuffers = 3;
+
+}  // namespace
+
+// webrtc::SharedMemory implementation that returns its memory to the creating
+// pool when deleted.
+class SharedMemoryPool::PooledBuffer : public webrtc::SharedMemory {
+ public:
+  PooledBuffer(scoped_refptr<SharedMemoryPool> pool,
+               scoped_ptr<base::SharedMemory> memory,
+               size_t size)
+      : SharedMemory(memory->memory(), size,
+#if defined(OS_WIN)
+                     memory->handle(),
+#else
+                     memory->handle().fd,
+#endif
+                     0),
+        pool_(pool),
+        shared_memory_(memory.Pass()) {
+  }
+
+  virtual ~PooledBuffer() {
+    pool_->ReleaseMemory(shared_memory_.Pass(), size());
+  }
+
+ private:
+  scoped_refptr<SharedMemoryPool> pool_;
+  scoped_ptr<base::SharedMemory> shared_memory_;
+
+  DISALLOW_COPY_AND_ASSIGN(PooledBuffer);
+};
+
+SharedMemoryPool::SharedMemoryPool() : buffer_size_(0) {}
+
+SharedMemoryPool::~SharedMemoryPool() {
+  STLDeleteElements(&free_buffers_);
+}
+
+webrtc::SharedMemory* SharedMemoryPool::AllocateBuffer(size_t size) {
+  scoped_ptr<base::SharedMemory> memory;
+  {
+    base::AutoLock auto_lock(lock_);
+    if (size != buffer_size_) {
+      // The buffer size has changed, e.g. because the screen was resized;
+      // pooled buffers of the old size are useless now.
+      STLDeleteElements(&free_buffers_);
+      buffer_size_ = size;
+    } else if (!free_buffers_.empty()) {
+      memory.reset(free_buffers_.front());
+      free_buffers_.pop_front();
+    }
+  }
+
+  if (!memory) {
+    memory.reset(new base::SharedMemory());
+    if (!memory->CreateAndMapAnonymous(size))
+      return NULL;
+  }
+
+  return new PooledBuffer(this, memory.Pass(), size);
+}
+
+void SharedMemoryPool::ReleaseMemory(scoped_ptr<base::SharedMemory> memory,
+                                     size_t size) {
+  base::AutoLock auto_lock(lock_);
+  if (size == buffer_size_ && free_buffers_.size() < kMaxFreeBuffers) {
+    free_buffers_.push_back(memory.release());
+  }
+}
+
+}  // namespace remoting
@@ -0,0 +1,70 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef REMOTING_HOST_SHARED_MEMORY_POOL_H_
+#define REMOTING_HOST_SHARED_MEMORY_POOL_H_
+
+#include <list>
+
+#include "base/basictypes.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/synchronization/lock.h"
+
+namespace base {
+class SharedMemory;
+}  // namespace base
+
+namespace webrtc {
+class SharedMemory;
+}  // namespace webrtc
+
+namespace remoting {
+
+// Pool of screen-sized webrtc::SharedMemory buffers for desktop capturers.
+// Deleting a buffer handed out by the pool returns its memory here instead of
+// unmapping it, so steady-state capture writes into a small set of warm,
+// already-mapped buffers that are passed by reference through the encode
+// pipeline, rather than allocating and faulting in a screen-sized buffer for
+// every frame.
+//
+// The pool is thread-safe and refcounted: buffers may be allocated on the
+// capture thread and deleted on the encode thread, and they keep the pool
+// alive until the last one is destroyed.
+class SharedMemoryPool : public base::RefCountedThreadSafe<SharedMemoryPool> {
+ public:
+  SharedMemoryPool();
+
+  // Returns a buffer of |size| bytes, reusing a pooled buffer of matching
+  // size when one is free. Returns NULL if allocation fails. The caller takes
+  // ownership; deleting the buffer returns its memory to this pool.
+  webrtc::SharedMemory* AllocateBuffer(size_t size);
+
+ private:
+  friend class base::RefCountedThreadSafe<SharedMemoryPool>;
+  class PooledBuffer;
+
+  ~SharedMemoryPool();
+
+  // Called by PooledBuffer's destructor to return |memory| to the pool. The
+  // memory is dropped if the pool is full or the buffer size has changed,
+  // e.g. after a screen resolution change.
+  void ReleaseMemory(scoped_ptr<base::SharedMemory> memory, size_t size);
+
+  // Protects the members below; buffers are allocated and released on
+  // different threads.
+  base::Lock lock_;
+
+  // Size of the buffers in |free_buffers_|.
+  size_t buffer_size_;
+
+  // Mapped buffers available for reuse, all |buffer_size_| bytes.
+  std::list<base::SharedMemory*> free_buffers_;
+
+  DISALLOW_COPY_AND_ASSIGN(SharedMemoryPool);
+};
+
+}  // namespace remoting
+
+#endif  // REMOTING_HOST_SHARED_MEMORY_POOL_H_
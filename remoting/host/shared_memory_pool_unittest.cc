@@ -0,0 +1,58 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "remoting/host/shared_memory_pool.h"
+
+#include "base/memory/scoped_ptr.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/webrtc/modules/desktop_capture/shared_memory.h"
+
+namespace remoting {
+
+namespace {
+const size_t kBufferSize = 1024;
+}  // namespace
+
+TEST(SharedMemoryPoolTest, ReusesReturnedBuffer) {
+  scoped_refptr<SharedMemoryPool> pool(new SharedMemoryPool());
+
+  scoped_ptr<webrtc::SharedMemory> buffer(pool->AllocateBuffer(kBufferSize));
+  ASSERT_TRUE(buffer.get());
+  void* data = buffer->data();
+
+  // Returning the buffer and asking for another of the same size must reuse
+  // the same mapping.
+  buffer.reset();
+  buffer.reset(pool->AllocateBuffer(kBufferSize));
+  ASSERT_TRUE(buffer.get());
+  EXPECT_EQ(data, buffer->data());
+}
+
+TEST(SharedMemoryPoolTest, SizeChangeDropsPooledBuffers) {
+  scoped_refptr<SharedMemoryPool> pool(new SharedMemoryPool());
+
+  scoped_ptr<webrtc::SharedMemory> buffer(pool->AllocateBuffer(kBufferSize));
+  ASSERT_TRUE(buffer.get());
+  buffer.reset();
+
+  // Simulate a screen resolution change; the new buffer must have the new
+  // size.
+  buffer.reset(pool->AllocateBuffer(2 * kBufferSize));
+  ASSERT_TRUE(buffer.get());
+  EXPECT_EQ(2 * kBufferSize, buffer->size());
+}
+
+TEST(SharedMemoryPoolTest, BufferOutlivesPool) {
+  scoped_refptr<SharedMemoryPool> pool(new SharedMemoryPool());
+
+  scoped_ptr<webrtc::SharedMemory> buffer(pool->AllocateBuffer(kBufferSize));
+  ASSERT_TRUE(buffer.get());
+
+  // Buffers keep the pool alive, so deleting one after dropping the last
+  // external reference must be safe.
+  pool = NULL;
+  buffer.reset();
+}
+
+}  // namespace remoting
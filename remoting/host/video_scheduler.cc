@@ -14,6 +14,7 @@
 #include "base/stl_util.h"
 #include "base/sys_info.h"
 #include "base/time/time.h"
+#include "remoting/host/shared_memory_pool.h"
 #include "remoting/proto/control.pb.h"
 #include "remoting/proto/internal.pb.h"
 #include "remoting/proto/video.pb.h"
@@ -48,6 +49,7 @@ VideoScheduler::VideoScheduler(
       encode_task_runner_(encode_task_runner),
       network_task_runner_(network_task_runner),
       capturer_(capturer.Pass()),
+      shared_memory_pool_(new SharedMemoryPool()),
       encoder_(encoder.Pass()),
       cursor_stub_(cursor_stub),
       video_stub_(video_stub),
@@ -66,7 +68,8 @@ VideoScheduler::VideoScheduler(
 // Public methods --------------------------------------------------------------
 
 webrtc::SharedMemory* VideoScheduler::CreateSharedMemory(size_t size) {
-  return NULL;
+  DCHECK(capture_task_runner_->BelongsToCurrentThread());
+  return shared_memory_pool_->AllocateBuffer(size);
 }
 
 void VideoScheduler::OnCaptureCompleted(webrtc::DesktopFrame* frame) {
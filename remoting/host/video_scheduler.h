@@ -28,6 +28,7 @@ class ScreenCapturer;
 namespace remoting {
 
 class CursorShapeInfo;
+class SharedMemoryPool;
 
 namespace protocol {
 class CursorShapeInfo;
@@ -173,6 +174,11 @@ class VideoScheduler : public base::RefCountedThreadSafe<VideoScheduler>,
   // Used to capture frames. Always accessed on the capture thread.
   scoped_ptr<webrtc::ScreenCapturer> capturer_;
 
+  // Pool of capture buffers handed to |capturer_|, so that frames are written
+  // directly into reused, already-mapped memory. Thread-safe; buffers are
+  // allocated on the capture thread and freed wherever the frame is deleted.
+  scoped_refptr<SharedMemoryPool> shared_memory_pool_;
+
   // Used to encode captured frames. Always accessed on the encode thread.
   scoped_ptr<VideoEncoder> encoder_;
 
@@ -0,0 +1,48 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sandbox/linux/seccomp-bpf/program_cache.h"
+
+#include <stdio.h>
+
+#include "sandbox/linux/seccomp-bpf/linux_seccomp.h"
+
+namespace sandbox {
+
+ProgramCache* ProgramCache::global_cache_ = NULL;
+
+ProgramCache::ProgramCache() {}
+
+ProgramCache* ProgramCache::GetInstance() {
+  if (!global_cache_) {
+    global_cache_ = new ProgramCache();
+  }
+  return global_cache_;
+}
+
+// static
+std::string ProgramCache::KeyForPolicy(const char* policy_key) {
+  char arch[16];
+  snprintf(arch, sizeof(arch), "/%08x", SECCOMP_ARCH);
+  return std::string(policy_key) + arch;
+}
+
+const SandboxBPF::Program* ProgramCache::Lookup(const std::string& key) const {
+  ProgramMap::const_iterator iter = programs_.find(key);
+  if (iter == programs_.end()) {
+    return NULL;
+  }
+  return &iter->second;
+}
+
+void ProgramCache::Insert(const std::string& key,
+                          const SandboxBPF::Program& program) {
+  programs_[key] = program;
+}
+
+void ProgramCache::Clear() {
+  programs_.clear();
+}
+
+}  // namespace sandbox
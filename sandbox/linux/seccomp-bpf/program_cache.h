@@ -0,0 +1,70 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SANDBOX_LINUX_SECCOMP_BPF_PROGRAM_CACHE_H_
+#define SANDBOX_LINUX_SECCOMP_BPF_PROGRAM_CACHE_H_
+
+#include <map>
+#include <string>
+
+#include "base/basictypes.h"
+#include "sandbox/linux/seccomp-bpf/sandbox_bpf.h"
+#include "sandbox/sandbox_export.h"
+
+namespace sandbox {
+
+// A per-process cache of compiled seccomp-BPF filter programs. Compiling a
+// policy evaluates every possible system call number and runs the BPF code
+// generator; for policies that opt in (see
+// SandboxBPFPolicy::GetProgramCacheKey()), the resulting program is compiled
+// and verified only once per process, and every subsequent sandbox instance
+// reuses it. A process that warms the cache before forking hands the
+// compiled program down to its children for free.
+// N.B.: Just like the Trap registry, this class does not perform any
+//   synchronization operations. Entries are added while engaging the
+//   sandbox, which requires the process to be single-threaded anyway.
+class SANDBOX_EXPORT ProgramCache {
+ public:
+  // Returns the shared per-process instance, creating it on first use. The
+  // instance is intentionally never destroyed; cached programs have to stay
+  // valid for as long as a sandbox instance might install them.
+  static ProgramCache* GetInstance();
+
+  // Builds the cache key for a policy key as returned by
+  // SandboxBPFPolicy::GetProgramCacheKey(). The audit architecture is mixed
+  // into the key, as the compiled program explicitly checks for it.
+  static std::string KeyForPolicy(const char* policy_key);
+
+  // Returns the cached program for "key", or NULL if no program has been
+  // inserted under this key. The returned pointer stays valid for the
+  // lifetime of the process.
+  const SandboxBPF::Program* Lookup(const std::string& key) const;
+
+  // Stores a copy of "program" under "key". Callers must only insert
+  // programs that have passed the verifier.
+  void Insert(const std::string& key, const SandboxBPF::Program& program);
+
+  // Drops all cached programs. Only used by tests.
+  void Clear();
+
+ private:
+  typedef std::map<std::string, SandboxBPF::Program> ProgramMap;
+
+  // Our constructor is private. A shared global instance is created
+  // automatically as needed.
+  ProgramCache();
+
+  // The destructor is unimplemented. The shared instance is never destroyed.
+  ~ProgramCache();
+
+  static ProgramCache* global_cache_;
+
+  ProgramMap programs_;
+
+  DISALLOW_COPY_AND_ASSIGN(ProgramCache);
+};
+
+}  // namespace sandbox
+
+#endif  // SANDBOX_LINUX_SECCOMP_BPF_PROGRAM_CACHE_H_
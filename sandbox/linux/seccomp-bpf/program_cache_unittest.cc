@@ -0,0 +1,114 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sandbox/linux/seccomp-bpf/program_cache.h"
+
+#include <errno.h>
+#include <string.h>
+
+#include <string>
+
+#include "base/memory/scoped_ptr.h"
+#include "sandbox/linux/seccomp-bpf/sandbox_bpf.h"
+#include "sandbox/linux/seccomp-bpf/sandbox_bpf_policy.h"
+#include "sandbox/linux/tests/unit_tests.h"
+
+namespace sandbox {
+
+namespace {
+
+bool ProgramsEqual(const SandboxBPF::Program& a, const SandboxBPF::Program& b) {
+  if (a.size() != b.size()) {
+    return false;
+  }
+  return memcmp(&a[0], &b[0], a.size() * sizeof(struct sock_filter)) == 0;
+}
+
+// A deterministic policy that opts into program caching. Its ErrorCodes
+// depend on nothing but the system call number, which is exactly the
+// contract that GetProgramCacheKey() demands.
+class CachingPolicy : public SandboxBPFPolicy {
+ public:
+  CachingPolicy() {}
+  virtual ErrorCode EvaluateSyscall(SandboxBPF*, int sysnum) const OVERRIDE {
+    if (sysnum % 2) {
+      return ErrorCode(EPERM);
+    }
+    return ErrorCode(ErrorCode::ERR_ALLOWED);
+  }
+  virtual const char* GetProgramCacheKey() const OVERRIDE {
+    return "caching-policy";
+  }
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(CachingPolicy);
+};
+
+SANDBOX_TEST(ProgramCache, LookupOnEmptyCache) {
+  ProgramCache* cache = ProgramCache::GetInstance();
+  cache->Clear();
+  SANDBOX_ASSERT(!cache->Lookup("no-such-key"));
+}
+
+SANDBOX_TEST(ProgramCache, InsertAndLookup) {
+  ProgramCache* cache = ProgramCache::GetInstance();
+  cache->Clear();
+
+  SandboxBPF::Program program;
+  struct sock_filter insn = BPF_STMT(BPF_RET + BPF_K, SECCOMP_RET_ALLOW);
+  program.push_back(insn);
+
+  cache->Insert("key", program);
+  const SandboxBPF::Program* cached = cache->Lookup("key");
+  SANDBOX_ASSERT(cached);
+  SANDBOX_ASSERT(ProgramsEqual(program, *cached));
+  SANDBOX_ASSERT(!cache->Lookup("other-key"));
+
+  cache->Clear();
+  SANDBOX_ASSERT(!cache->Lookup("key"));
+}
+
+SANDBOX_TEST(ProgramCache, KeyForPolicy) {
+  // Distinct policy keys must map to distinct cache keys; the same policy
+  // key must map to the same cache key.
+  SANDBOX_ASSERT(ProgramCache::KeyForPolicy("a") !=
+                 ProgramCache::KeyForPolicy("b"));
+  SANDBOX_ASSERT(ProgramCache::KeyForPolicy("a") ==
+                 ProgramCache::KeyForPolicy("a"));
+}
+
+SANDBOX_TEST(ProgramCache, CachedProgramMatchesFreshCompilation) {
+  ProgramCache* cache = ProgramCache::GetInstance();
+  cache->Clear();
+
+  // Emulate what InstallFilter() does for an opted-in policy: compile and
+  // verify the program, then publish it to the cache.
+  SandboxBPF first_sandbox;
+  scoped_ptr<CachingPolicy> policy(new CachingPolicy());
+  const std::string key = ProgramCache::KeyForPolicy(
+      policy->GetProgramCacheKey());
+  first_sandbox.SetSandboxPolicy(policy.release());
+  scoped_ptr<SandboxBPF::Program> first_program(
+      first_sandbox.AssembleFilter(true /* force_verification */));
+  cache->Insert(key, *first_program);
+
+  // A second sandbox instance with the same policy must find the cached
+  // program, and compiling from scratch must produce the identical program;
+  // the cache relies on this determinism.
+  SandboxBPF second_sandbox;
+  second_sandbox.SetSandboxPolicy(new CachingPolicy());
+  scoped_ptr<SandboxBPF::Program> second_program(
+      second_sandbox.AssembleFilter(true /* force_verification */));
+
+  const SandboxBPF::Program* cached = cache->Lookup(key);
+  SANDBOX_ASSERT(cached);
+  SANDBOX_ASSERT(ProgramsEqual(*first_program, *cached));
+  SANDBOX_ASSERT(ProgramsEqual(*second_program, *cached));
+
+  cache->Clear();
+}
+
+}  // namespace
+
+}  // namespace sandbox
@@ -26,6 +26,7 @@
 #include "base/memory/scoped_ptr.h"
 #include "base/posix/eintr_wrapper.h"
 #include "sandbox/linux/seccomp-bpf/codegen.h"
+#include "sandbox/linux/seccomp-bpf/program_cache.h"
 #include "sandbox/linux/seccomp-bpf/sandbox_bpf_policy.h"
 #include "sandbox/linux/seccomp-bpf/syscall.h"
 #include "sandbox/linux/seccomp-bpf/syscall_iterator.h"
@@ -512,13 +513,38 @@ void SandboxBPF::InstallFilter(SandboxThreadState thread_state) {
   // installed the BPF filter program in the kernel. Depending on the
   // system memory allocator that is in effect, these operators can result
   // in system calls to things like munmap() or brk().
-  Program* program = AssembleFilter(false /* force_verification */);
+  // Policies that opt into program caching (see
+  // SandboxBPFPolicy::GetProgramCacheKey()) share their compiled filter
+  // program process-wide, so that repeated sandbox instances -- and children
+  // forked after the cache was warmed -- skip compilation entirely. Programs
+  // are verified before they are published to the cache, so a cache hit
+  // installs a program that already passed the verifier. Programs with
+  // unsafe traps depend on the current address space layout and are never
+  // cached.
+  std::string cache_key;
+  const char* policy_key = policy_->GetProgramCacheKey();
+  if (policy_key) {
+    cache_key = ProgramCache::KeyForPolicy(policy_key);
+  }
+  const Program* program =
+      cache_key.empty() ? NULL : ProgramCache::GetInstance()->Lookup(cache_key);
+  Program* assembled = NULL;
+  if (!program) {
+    bool has_unsafe_traps = false;
+    assembled = AssembleFilter(!cache_key.empty() /* force_verification */,
+                               &has_unsafe_traps);
+    if (!cache_key.empty() && !has_unsafe_traps) {
+      ProgramCache::GetInstance()->Insert(cache_key, *assembled);
+    }
+    program = assembled;
+  }
 
   struct sock_filter bpf[program->size()];
   const struct sock_fprog prog = {static_cast<unsigned short>(program->size()),
                                   bpf};
   memcpy(bpf, &(*program)[0], sizeof(bpf));
-  delete program;
+  // A cached |program| is owned by the cache and must stay alive.
+  delete assembled;
 
   // Make an attempt to release memory that is no longer needed here, rather
   // than in the destructor. Try to avoid as much as possible to presume of
@@ -556,6 +582,11 @@ void SandboxBPF::InstallFilter(SandboxThreadState thread_state) {
 }
 
 SandboxBPF::Program* SandboxBPF::AssembleFilter(bool force_verification) {
+  return AssembleFilter(force_verification, NULL);
+}
+
+SandboxBPF::Program* SandboxBPF::AssembleFilter(bool force_verification,
+                                                bool* had_unsafe_traps) {
 #if !defined(NDEBUG)
   force_verification = true;
 #endif
@@ -724,6 +755,10 @@ SandboxBPF::Program* SandboxBPF::AssembleFilter(bool force_verification) {
     VerifyProgram(*program, has_unsafe_traps);
   }
 
+  if (had_unsafe_traps) {
+    *had_unsafe_traps = has_unsafe_traps;
+  }
+
   return program;
 }
 
@@ -181,6 +181,13 @@ class SANDBOX_EXPORT SandboxBPF {
   // verifier is run unconditionally. This is useful for unittests.
   Program* AssembleFilter(bool force_verification);
 
+  // Same as above, but additionally reports in "had_unsafe_traps" (which may
+  // be NULL) whether the assembled program contains unsafe traps. Programs
+  // with unsafe traps embed the address of the syscall entry point and must
+  // never outlive the current address space layout (e.g. by being cached
+  // and reused after execve()).
+  Program* AssembleFilter(bool force_verification, bool* had_unsafe_traps);
+
   // Returns the fatal ErrorCode that is used to indicate that somebody
   // attempted to pass a 64bit value in a 32bit system call argument.
   // This method is primarily needed for testing purposes.
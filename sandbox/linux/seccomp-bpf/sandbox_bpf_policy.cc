@@ -14,4 +14,8 @@ ErrorCode SandboxBPFPolicy::InvalidSyscall(SandboxBPF* sandbox_compiler) const {
   return ErrorCode(ENOSYS);
 }
 
+const char* SandboxBPFPolicy::GetProgramCacheKey() const {
+  return NULL;
+}
+
 }  // namespace sandbox
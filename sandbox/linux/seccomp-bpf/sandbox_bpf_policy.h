@@ -32,6 +32,19 @@ class SANDBOX_EXPORT SandboxBPFPolicy {
   // system calls.  The default implementation is to return ENOSYS.
   virtual ErrorCode InvalidSyscall(SandboxBPF* sandbox_compiler) const;
 
+  // Returns a key identifying the filter program that this policy compiles
+  // to, or NULL (the default) if the program must not be cached. A policy
+  // may only return a key if compiling it repeatedly in the same process
+  // always yields an identical program. In particular, the ErrorCodes it
+  // returns must not depend on per-instance or per-process state such as
+  // the current pid, and any Trap() handlers must be registered with "aux"
+  // pointers that remain valid and identical for the lifetime of the
+  // process. When a key is returned, SandboxBPF memoizes the verified
+  // program in the per-process ProgramCache, and later sandbox instances
+  // (including children forked after the cache was warmed) reuse it
+  // without invoking the compiler.
+  virtual const char* GetProgramCacheKey() const;
+
  private:
   DISALLOW_COPY_AND_ASSIGN(SandboxBPFPolicy);
 };
@@ -4,17 +4,94 @@
 
 #include "base/debug/trace_event.h"
 #include "base/logging.h"
+#include "build/build_config.h"
 #include "skia/ext/analysis_canvas.h"
 #include "third_party/skia/include/core/SkDraw.h"
 #include "third_party/skia/include/core/SkRRect.h"
 #include "third_party/skia/include/core/SkShader.h"
+#include "third_party/skia/include/core/SkUnPreMultiply.h"
 #include "third_party/skia/src/core/SkRasterClip.h"
 #include "ui/gfx/rect_conversions.h"
 
+#if defined(ARCH_CPU_X86_FAMILY) && !defined(OS_IOS)
+#define ANALYSIS_CANVAS_SIMD_SSE2 1
+#include <emmintrin.h>
+#endif
+
 namespace {
 
 const int kNoLayer = -1;
 
+// Upper bound on the number of pixels scanned when checking whether a bitmap
+// is of a single color. Tile-sized bitmaps stay well below this; anything
+// larger is unlikely to be a solid fill and not worth the memory traffic.
+const int kMaxSolidColorBitmapPixels = 512 * 512;
+
+#if defined(ANALYSIS_CANVAS_SIMD_SSE2)
+// Compares |count| 32-bit pixels against |color|, 32 pixels per iteration.
+bool PixelsAreUniform(const uint32_t* pixels, int count, uint32_t color) {
+  __m128i expected = _mm_set1_epi32(static_cast<int>(color));
+  __m128i diff = _mm_setzero_si128();
+  int i = 0;
+  for (; i + 32 <= count; i += 32) {
+    const __m128i* row = reinterpret_cast<const __m128i*>(pixels + i);
+    for (int j = 0; j < 8; ++j)
+      diff = _mm_or_si128(diff,
+                          _mm_xor_si128(_mm_loadu_si128(row + j), expected));
+    if (_mm_movemask_epi8(_mm_cmpeq_epi8(diff, _mm_setzero_si128())) != 0xffff)
+      return false;
+  }
+  for (; i < count; ++i) {
+    if (pixels[i] != color)
+      return false;
+  }
+  return true;
+}
+#else
+bool PixelsAreUniform(const uint32_t* pixels, int count, uint32_t color) {
+  for (int i = 0; i < count; ++i) {
+    if (pixels[i] != color)
+      return false;
+  }
+  return true;
+}
+#endif
+
+// Returns true if |bitmap| is small enough to scan and its pixels are
+// already in memory. Locking a lazily-decoded pixel ref here would trigger
+// an image decode on the analysis thread, which is exactly the kind of work
+// analysis exists to avoid.
+bool BitmapIsScannable(const SkBitmap& bitmap) {
+  if (bitmap.width() <= 0 || bitmap.height() <= 0)
+    return false;
+  if (bitmap.width() * bitmap.height() > kMaxSolidColorBitmapPixels)
+    return false;
+  if (bitmap.colorType() != kN32_SkColorType)
+    return false;
+  SkPixelRef* pixel_ref = bitmap.pixelRef();
+  return pixel_ref && pixel_ref->pixels();
+}
+
+// Returns true if every pixel of |bitmap| has the same opaque color, which
+// is then returned in |color|. Only call after BitmapIsScannable().
+bool BitmapIsSolidColor(const SkBitmap& bitmap, SkColor* color) {
+  SkAutoLockPixels lock(bitmap);
+  if (!bitmap.getPixels())
+    return false;
+
+  const SkPMColor first_pixel = *bitmap.getAddr32(0, 0);
+  if (SkGetPackedA32(first_pixel) != 255)
+    return false;
+
+  for (int y = 0; y < bitmap.height(); ++y) {
+    if (!PixelsAreUniform(bitmap.getAddr32(0, y), bitmap.width(), first_pixel))
+      return false;
+  }
+
+  *color = SkUnPreMultiply::PMColorToColor(first_pixel);
+  return true;
+}
+
 bool IsSolidColorPaint(const SkPaint& paint) {
   SkXfermode::Mode xfermode;
 
@@ -172,21 +249,55 @@ void AnalysisCanvas::drawPath(const SkPath& path, const SkPaint& paint) {
 void AnalysisCanvas::drawBitmap(const SkBitmap& bitmap,
                                 SkScalar left,
                                 SkScalar top,
-                                const SkPaint*) {
+                                const SkPaint* paint) {
+  SkPaint tmpPaint;
+  if (!paint)
+    paint = &tmpPaint;
+
+  // A bitmap that covers the full canvas and scans to a single opaque color
+  // draws exactly like a solid color rect, so treat it as one.
+  SkRect rect = SkRect::MakeXYWH(
+      left, top, SkIntToScalar(bitmap.width()), SkIntToScalar(bitmap.height()));
+  SkColor color;
+  if (!is_forced_not_solid_ && IsSolidColorPaint(*paint) &&
+      IsFullQuad(this, rect) && BitmapIsScannable(bitmap) &&
+      BitmapIsSolidColor(bitmap, &color)) {
+    is_solid_color_ = true;
+    color_ = color;
+    is_transparent_ = false;
+    has_text_ = false;
+    return;
+  }
+
   is_solid_color_ = false;
   is_transparent_ = false;
 }
 
-void AnalysisCanvas::drawBitmapRectToRect(const SkBitmap&,
+void AnalysisCanvas::drawBitmapRectToRect(const SkBitmap& bitmap,
                                           const SkRect* src,
                                           const SkRect& dst,
                                           const SkPaint* paint,
                                           DrawBitmapRectFlags flags) {
-  // Call drawRect to determine transparency,
-  // but reset solid color to false.
   SkPaint tmpPaint;
   if (!paint)
     paint = &tmpPaint;
+
+  // A scaled bitmap that covers the full canvas and scans to a single opaque
+  // color is still that color regardless of the source rect, so the same
+  // fast path as drawBitmap() applies.
+  SkColor color;
+  if (!is_forced_not_solid_ && IsSolidColorPaint(*paint) &&
+      IsFullQuad(this, dst) && BitmapIsScannable(bitmap) &&
+      BitmapIsSolidColor(bitmap, &color)) {
+    is_solid_color_ = true;
+    color_ = color;
+    is_transparent_ = false;
+    has_text_ = false;
+    return;
+  }
+
+  // Call drawRect to determine transparency,
+  // but reset solid color to false.
   drawRect(dst, *paint);
   is_solid_color_ = false;
 }
@@ -390,4 +390,59 @@ TEST(AnalysisCanvasTest, HasText) {
   }
 }
 
+TEST(AnalysisCanvasTest, SolidColorBitmap) {
+  SkColor outputColor;
+
+  SkBitmap uniformBitmap;
+  uniformBitmap.allocN32Pixels(255, 255);
+  uniformBitmap.eraseColor(SkColorSetARGB(255, 11, 22, 33));
+
+  {
+    // A full canvas bitmap of a single opaque color is solid.
+    skia::AnalysisCanvas canvas(255, 255);
+    canvas.drawBitmap(uniformBitmap, 0, 0);
+    EXPECT_TRUE(canvas.GetColorIfSolid(&outputColor));
+    EXPECT_EQ(SkColorSetARGB(255, 11, 22, 33), outputColor);
+  }
+  {
+    // Same bitmap stretched over the canvas through drawBitmapRectToRect.
+    skia::AnalysisCanvas canvas(512, 512);
+    canvas.drawBitmapRectToRect(uniformBitmap,
+                                NULL,
+                                SkRect::MakeWH(512, 512),
+                                NULL,
+                                SkCanvas::kNone_DrawBitmapRectFlag);
+    EXPECT_TRUE(canvas.GetColorIfSolid(&outputColor));
+    EXPECT_EQ(SkColorSetARGB(255, 11, 22, 33), outputColor);
+  }
+  {
+    // A bitmap that does not cover the full canvas is not solid.
+    skia::AnalysisCanvas canvas(255, 255);
+    canvas.drawBitmap(uniformBitmap, 10, 10);
+    EXPECT_FALSE(canvas.GetColorIfSolid(&outputColor));
+  }
+  {
+    // A translucent uniform bitmap is not solid.
+    SkBitmap translucentBitmap;
+    translucentBitmap.allocN32Pixels(255, 255);
+    translucentBitmap.eraseColor(SkColorSetARGB(128, 11, 22, 33));
+
+    skia::AnalysisCanvas canvas(255, 255);
+    canvas.drawBitmap(translucentBitmap, 0, 0);
+    EXPECT_FALSE(canvas.GetColorIfSolid(&outputColor));
+  }
+  {
+    // A single differing pixel breaks uniformity.
+    SkBitmap almostUniformBitmap;
+    almostUniformBitmap.allocN32Pixels(255, 255);
+    almostUniformBitmap.eraseColor(SkColorSetARGB(255, 11, 22, 33));
+    *almostUniformBitmap.getAddr32(200, 200) =
+        SkPreMultiplyColor(SkColorSetARGB(255, 11, 22, 34));
+
+    skia::AnalysisCanvas canvas(255, 255);
+    canvas.drawBitmap(almostUniformBitmap, 0, 0);
+    EXPECT_FALSE(canvas.GetColorIfSolid(&outputColor));
+  }
+}
+
 }  // namespace skia
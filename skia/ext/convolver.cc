@@ -6,6 +6,7 @@
 
 #include "base/logging.h"
 #include "skia/ext/convolver.h"
+#include "skia/ext/convolver_AVX2.h"
 #include "skia/ext/convolver_SSE2.h"
 #include "skia/ext/convolver_mips_dspr2.h"
 #include "third_party/skia/include/core/SkSize.h"
@@ -363,7 +364,14 @@ struct ConvolveProcs {
 void SetupSIMD(ConvolveProcs *procs) {
 #ifdef SIMD_SSE2
   base::CPU cpu;
-  if (cpu.has_sse2()) {
+  if (cpu.has_avx2()) {
+    // The AVX2 horizontal kernels consume eight pixels per iteration, so
+    // they may read up to seven pixels past the end of a row.
+    procs->extra_horizontal_reads = 7;
+    procs->convolve_vertically = &ConvolveVertically_AVX2;
+    procs->convolve_4rows_horizontally = &Convolve4RowsHorizontally_AVX2;
+    procs->convolve_horizontally = &ConvolveHorizontally_AVX2;
+  } else if (cpu.has_sse2()) {
     procs->extra_horizontal_reads = 3;
     procs->convolve_vertically = &ConvolveVertically_SSE2;
     procs->convolve_4rows_horizontally = &Convolve4RowsHorizontally_SSE2;
@@ -0,0 +1,536 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+
+#include "skia/ext/convolver.h"
+#include "skia/ext/convolver_AVX2.h"
+#include "third_party/skia/include/core/SkTypes.h"
+
+// Note: this file must be compiled with AVX2 support enabled (-mavx2 with
+// gcc/clang, /arch:AVX2 with MSVC). The functions are only called when
+// base::CPU reports AVX2 at run time.
+#include <immintrin.h>
+
+namespace skia {
+
+namespace {
+
+// Sums the four 32-bit channel accumulators of the two 128-bit lanes of
+// |accum|, brings the result back into fixed point range and packs it down
+// to one output pixel with unsigned saturation per channel.
+inline int SumAndPackPixel(__m256i accum) {
+  __m128i zero = _mm_setzero_si128();
+  __m128i sum = _mm_add_epi32(_mm256_castsi256_si128(accum),
+                              _mm256_extracti128_si256(accum, 1));
+  // Shift right for fixed point implementation.
+  sum = _mm_srai_epi32(sum, ConvolutionFilter1D::kShiftBits);
+  // Packing 32 bits |sum| to 16 bits per channel (signed saturation).
+  sum = _mm_packs_epi32(sum, zero);
+  // Packing 16 bits |sum| to 8 bits per channel (unsigned saturation).
+  sum = _mm_packus_epi16(sum, zero);
+  return _mm_cvtsi128_si32(sum);
+}
+
+}  // namespace
+
+// Convolves horizontally along a single row. The row data is given in
+// |src_data| and continues for the num_values() of the filter.
+// The algorithm is the same as |ConvolveHorizontally_SSE2| except that eight
+// filter taps (and thus eight source pixels) are consumed per iteration, with
+// each 128-bit lane processing four of them.
+void ConvolveHorizontally_AVX2(const unsigned char* src_data,
+                               const ConvolutionFilter1D& filter,
+                               unsigned char* out_row,
+                               bool /*has_alpha*/) {
+  int num_values = filter.num_values();
+
+  int filter_offset, filter_length;
+  __m256i zero = _mm256_setzero_si256();
+
+  // Shuffle controls distributing eight coefficients (broadcast to both
+  // lanes) so that each lane multiplies its own pixel pair:
+  // |coeff_lo_shuffle| yields
+  //   [16] c5 c5 c5 c5 c4 c4 c4 c4 | c1 c1 c1 c1 c0 c0 c0 c0
+  // |coeff_hi_shuffle| yields
+  //   [16] c7 c7 c7 c7 c6 c6 c6 c6 | c3 c3 c3 c3 c2 c2 c2 c2
+  const __m256i coeff_lo_shuffle = _mm256_set_epi8(
+      11, 10, 11, 10, 11, 10, 11, 10, 9, 8, 9, 8, 9, 8, 9, 8,
+      3, 2, 3, 2, 3, 2, 3, 2, 1, 0, 1, 0, 1, 0, 1, 0);
+  const __m256i coeff_hi_shuffle = _mm256_set_epi8(
+      15, 14, 15, 14, 15, 14, 15, 14, 13, 12, 13, 12, 13, 12, 13, 12,
+      7, 6, 7, 6, 7, 6, 7, 6, 5, 4, 5, 4, 5, 4, 5, 4);
+
+  __m128i mask[8];
+  // |mask| will be used to decimate all extra filter coefficients that are
+  // loaded by SIMD when |filter_length| is not divisible by 8.
+  // mask[0] is not used in following algorithm.
+  mask[1] = _mm_set_epi16(0, 0, 0, 0, 0, 0, 0, -1);
+  mask[2] = _mm_set_epi16(0, 0, 0, 0, 0, 0, -1, -1);
+  mask[3] = _mm_set_epi16(0, 0, 0, 0, 0, -1, -1, -1);
+  mask[4] = _mm_set_epi16(0, 0, 0, 0, -1, -1, -1, -1);
+  mask[5] = _mm_set_epi16(0, 0, 0, -1, -1, -1, -1, -1);
+  mask[6] = _mm_set_epi16(0, 0, -1, -1, -1, -1, -1, -1);
+  mask[7] = _mm_set_epi16(0, -1, -1, -1, -1, -1, -1, -1);
+
+  // Output one pixel each iteration, calculating all channels (RGBA) together.
+  for (int out_x = 0; out_x < num_values; out_x++) {
+    const ConvolutionFilter1D::Fixed* filter_values =
+        filter.FilterForValue(out_x, &filter_offset, &filter_length);
+
+    __m256i accum = zero;
+
+    // Compute the first pixel in this row that the filter affects. It will
+    // touch |filter_length| pixels (4 bytes each) after this.
+    const unsigned char* row_to_filter = &src_data[filter_offset << 2];
+
+    // We will load and accumulate with eight coefficients per iteration.
+    for (int filter_x = 0; filter_x < (filter_length >> 3); filter_x++) {
+      // [16] c7 c6 c5 c4 c3 c2 c1 c0
+      __m128i coeff = _mm_loadu_si128(
+          reinterpret_cast<const __m128i*>(filter_values));
+      __m256i coeff8 = _mm256_broadcastsi128_si256(coeff);
+      __m256i coeff16lo = _mm256_shuffle_epi8(coeff8, coeff_lo_shuffle);
+      __m256i coeff16hi = _mm256_shuffle_epi8(coeff8, coeff_hi_shuffle);
+
+      // Load eight pixels, four per 128-bit lane.
+      // [8] p7 p6 p5 p4 | p3 p2 p1 p0
+      __m256i src8 = _mm256_loadu_si256(
+          reinterpret_cast<const __m256i*>(row_to_filter));
+      // [16] p5 p4 | p1 p0
+      __m256i src16 = _mm256_unpacklo_epi8(src8, zero);
+      __m256i mul_hi = _mm256_mulhi_epi16(src16, coeff16lo);
+      __m256i mul_lo = _mm256_mullo_epi16(src16, coeff16lo);
+      // [32] p4*c4 | p0*c0
+      __m256i t = _mm256_unpacklo_epi16(mul_lo, mul_hi);
+      accum = _mm256_add_epi32(accum, t);
+      // [32] p5*c5 | p1*c1
+      t = _mm256_unpackhi_epi16(mul_lo, mul_hi);
+      accum = _mm256_add_epi32(accum, t);
+
+      // [16] p7 p6 | p3 p2
+      src16 = _mm256_unpackhi_epi8(src8, zero);
+      mul_hi = _mm256_mulhi_epi16(src16, coeff16hi);
+      mul_lo = _mm256_mullo_epi16(src16, coeff16hi);
+      // [32] p6*c6 | p2*c2
+      t = _mm256_unpacklo_epi16(mul_lo, mul_hi);
+      accum = _mm256_add_epi32(accum, t);
+      // [32] p7*c7 | p3*c3
+      t = _mm256_unpackhi_epi16(mul_lo, mul_hi);
+      accum = _mm256_add_epi32(accum, t);
+
+      // Advance the pixel and coefficients pointers.
+      row_to_filter += 32;
+      filter_values += 8;
+    }
+
+    // When |filter_length| is not divisible by 8, we need to decimate some of
+    // the filter coefficients that were loaded incorrectly to zero; other
+    // than that the algorithm is the same as above.
+    // Note: the filter coefficients must be padded (PaddingForSIMD) and the
+    // source row may be read up to seven pixels past the last one used; the
+    // caller falls back to the C version for rows where that would read past
+    // the end of the image.
+    int r = filter_length & 7;
+    if (r) {
+      __m128i coeff = _mm_loadu_si128(
+          reinterpret_cast<const __m128i*>(filter_values));
+      // Mask out extra filter taps.
+      coeff = _mm_and_si128(coeff, mask[r]);
+      __m256i coeff8 = _mm256_broadcastsi128_si256(coeff);
+      __m256i coeff16lo = _mm256_shuffle_epi8(coeff8, coeff_lo_shuffle);
+      __m256i coeff16hi = _mm256_shuffle_epi8(coeff8, coeff_hi_shuffle);
+
+      __m256i src8 = _mm256_loadu_si256(
+          reinterpret_cast<const __m256i*>(row_to_filter));
+      __m256i src16 = _mm256_unpacklo_epi8(src8, zero);
+      __m256i mul_hi = _mm256_mulhi_epi16(src16, coeff16lo);
+      __m256i mul_lo = _mm256_mullo_epi16(src16, coeff16lo);
+      __m256i t = _mm256_unpacklo_epi16(mul_lo, mul_hi);
+      accum = _mm256_add_epi32(accum, t);
+      t = _mm256_unpackhi_epi16(mul_lo, mul_hi);
+      accum = _mm256_add_epi32(accum, t);
+
+      src16 = _mm256_unpackhi_epi8(src8, zero);
+      mul_hi = _mm256_mulhi_epi16(src16, coeff16hi);
+      mul_lo = _mm256_mullo_epi16(src16, coeff16hi);
+      t = _mm256_unpacklo_epi16(mul_lo, mul_hi);
+      accum = _mm256_add_epi32(accum, t);
+      t = _mm256_unpackhi_epi16(mul_lo, mul_hi);
+      accum = _mm256_add_epi32(accum, t);
+    }
+
+    // Store the pixel value of 32 bits.
+    *(reinterpret_cast<int*>(out_row)) = SumAndPackPixel(accum);
+    out_row += 4;
+  }
+}
+
+// Convolves horizontally along four rows. The row data is given in
+// |src_data| and continues for the num_values() of the filter.
+// The algorithm is almost same as |ConvolveHorizontally_AVX2|. Please
+// refer to that function for detailed comments.
+void Convolve4RowsHorizontally_AVX2(const unsigned char* src_data[4],
+                                    const ConvolutionFilter1D& filter,
+                                    unsigned char* out_row[4]) {
+  int num_values = filter.num_values();
+
+  int filter_offset, filter_length;
+  __m256i zero = _mm256_setzero_si256();
+  const __m256i coeff_lo_shuffle = _mm256_set_epi8(
+      11, 10, 11, 10, 11, 10, 11, 10, 9, 8, 9, 8, 9, 8, 9, 8,
+      3, 2, 3, 2, 3, 2, 3, 2, 1, 0, 1, 0, 1, 0, 1, 0);
+  const __m256i coeff_hi_shuffle = _mm256_set_epi8(
+      15, 14, 15, 14, 15, 14, 15, 14, 13, 12, 13, 12, 13, 12, 13, 12,
+      7, 6, 7, 6, 7, 6, 7, 6, 5, 4, 5, 4, 5, 4, 5, 4);
+
+  __m128i mask[8];
+  // |mask| will be used to decimate all extra filter coefficients that are
+  // loaded by SIMD when |filter_length| is not divisible by 8.
+  // mask[0] is not used in following algorithm.
+  mask[1] = _mm_set_epi16(0, 0, 0, 0, 0, 0, 0, -1);
+  mask[2] = _mm_set_epi16(0, 0, 0, 0, 0, 0, -1, -1);
+  mask[3] = _mm_set_epi16(0, 0, 0, 0, 0, -1, -1, -1);
+  mask[4] = _mm_set_epi16(0, 0, 0, 0, -1, -1, -1, -1);
+  mask[5] = _mm_set_epi16(0, 0, 0, -1, -1, -1, -1, -1);
+  mask[6] = _mm_set_epi16(0, 0, -1, -1, -1, -1, -1, -1);
+  mask[7] = _mm_set_epi16(0, -1, -1, -1, -1, -1, -1, -1);
+
+  // Output one pixel each iteration, calculating all channels (RGBA) together.
+  for (int out_x = 0; out_x < num_values; out_x++) {
+    const ConvolutionFilter1D::Fixed* filter_values =
+        filter.FilterForValue(out_x, &filter_offset, &filter_length);
+
+    // four pixels in a column per iteration.
+    __m256i accum0 = zero;
+    __m256i accum1 = zero;
+    __m256i accum2 = zero;
+    __m256i accum3 = zero;
+    int start = (filter_offset << 2);
+    // We will load and accumulate with eight coefficients per iteration.
+    for (int filter_x = 0; filter_x < (filter_length >> 3); filter_x++) {
+      __m128i coeff = _mm_loadu_si128(
+          reinterpret_cast<const __m128i*>(filter_values));
+      __m256i coeff8 = _mm256_broadcastsi128_si256(coeff);
+      __m256i coeff16lo = _mm256_shuffle_epi8(coeff8, coeff_lo_shuffle);
+      __m256i coeff16hi = _mm256_shuffle_epi8(coeff8, coeff_hi_shuffle);
+
+      __m256i src8, src16, mul_hi, mul_lo, t;
+
+#define ITERATION(src, accum)                                           \
+      src8 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src)); \
+      src16 = _mm256_unpacklo_epi8(src8, zero);                         \
+      mul_hi = _mm256_mulhi_epi16(src16, coeff16lo);                    \
+      mul_lo = _mm256_mullo_epi16(src16, coeff16lo);                    \
+      t = _mm256_unpacklo_epi16(mul_lo, mul_hi);                        \
+      accum = _mm256_add_epi32(accum, t);                               \
+      t = _mm256_unpackhi_epi16(mul_lo, mul_hi);                        \
+      accum = _mm256_add_epi32(accum, t);                               \
+      src16 = _mm256_unpackhi_epi8(src8, zero);                         \
+      mul_hi = _mm256_mulhi_epi16(src16, coeff16hi);                    \
+      mul_lo = _mm256_mullo_epi16(src16, coeff16hi);                    \
+      t = _mm256_unpacklo_epi16(mul_lo, mul_hi);                        \
+      accum = _mm256_add_epi32(accum, t);                               \
+      t = _mm256_unpackhi_epi16(mul_lo, mul_hi);                        \
+      accum = _mm256_add_epi32(accum, t)
+
+      ITERATION(src_data[0] + start, accum0);
+      ITERATION(src_data[1] + start, accum1);
+      ITERATION(src_data[2] + start, accum2);
+      ITERATION(src_data[3] + start, accum3);
+
+      start += 32;
+      filter_values += 8;
+    }
+
+    int r = filter_length & 7;
+    if (r) {
+      // Note: the filter coefficients must be padded (PaddingForSIMD).
+      __m128i coeff = _mm_loadu_si128(
+          reinterpret_cast<const __m128i*>(filter_values));
+      // Mask out extra filter taps.
+      coeff = _mm_and_si128(coeff, mask[r]);
+      __m256i coeff8 = _mm256_broadcastsi128_si256(coeff);
+      __m256i coeff16lo = _mm256_shuffle_epi8(coeff8, coeff_lo_shuffle);
+      __m256i coeff16hi = _mm256_shuffle_epi8(coeff8, coeff_hi_shuffle);
+
+      __m256i src8, src16, mul_hi, mul_lo, t;
+
+      ITERATION(src_data[0] + start, accum0);
+      ITERATION(src_data[1] + start, accum1);
+      ITERATION(src_data[2] + start, accum2);
+      ITERATION(src_data[3] + start, accum3);
+    }
+
+    *(reinterpret_cast<int*>(out_row[0])) = SumAndPackPixel(accum0);
+    *(reinterpret_cast<int*>(out_row[1])) = SumAndPackPixel(accum1);
+    *(reinterpret_cast<int*>(out_row[2])) = SumAndPackPixel(accum2);
+    *(reinterpret_cast<int*>(out_row[3])) = SumAndPackPixel(accum3);
+
+    out_row[0] += 4;
+    out_row[1] += 4;
+    out_row[2] += 4;
+    out_row[3] += 4;
+  }
+}
+
+// Does vertical convolution to produce one output row. The filter values and
+// length are given in the first two parameters. These are applied to each
+// of the rows pointed to in the |source_data_rows| array, with each row
+// being |pixel_width| wide.
+//
+// The output must have room for |pixel_width * 4| bytes.
+template<bool has_alpha>
+void ConvolveVertically_AVX2(const ConvolutionFilter1D::Fixed* filter_values,
+                             int filter_length,
+                             unsigned char* const* source_data_rows,
+                             int pixel_width,
+                             unsigned char* out_row) {
+  int width = pixel_width & ~7;
+
+  __m256i zero = _mm256_setzero_si256();
+  // Output eight pixels per iteration (32 bytes), four per 128-bit lane.
+  for (int out_x = 0; out_x < width; out_x += 8) {
+    // Accumulated result for each pixel. 32 bits per RGBA channel.
+    __m256i accum0 = zero;
+    __m256i accum1 = zero;
+    __m256i accum2 = zero;
+    __m256i accum3 = zero;
+
+    // Convolve with one filter coefficient per iteration.
+    for (int filter_y = 0; filter_y < filter_length; filter_y++) {
+      // Duplicate the filter coefficient 16 times.
+      // [16] cj cj cj cj cj cj cj cj cj cj cj cj cj cj cj cj
+      __m256i coeff16 = _mm256_set1_epi16(filter_values[filter_y]);
+
+      // Load eight pixels (32 bytes) together.
+      // [8] p7 p6 p5 p4 | p3 p2 p1 p0
+      const __m256i* src = reinterpret_cast<const __m256i*>(
+          &source_data_rows[filter_y][out_x << 2]);
+      __m256i src8 = _mm256_loadu_si256(src);
+
+      // Unpack pixels from 8 bits to 16 bits for each channel => multiply
+      // with the current coefficient => accumulate the result.
+      // [16] p5 p4 | p1 p0
+      __m256i src16 = _mm256_unpacklo_epi8(src8, zero);
+      __m256i mul_hi = _mm256_mulhi_epi16(src16, coeff16);
+      __m256i mul_lo = _mm256_mullo_epi16(src16, coeff16);
+      // [32] p4 | p0
+      __m256i t = _mm256_unpacklo_epi16(mul_lo, mul_hi);
+      accum0 = _mm256_add_epi32(accum0, t);
+      // [32] p5 | p1
+      t = _mm256_unpackhi_epi16(mul_lo, mul_hi);
+      accum1 = _mm256_add_epi32(accum1, t);
+
+      // [16] p7 p6 | p3 p2
+      src16 = _mm256_unpackhi_epi8(src8, zero);
+      mul_hi = _mm256_mulhi_epi16(src16, coeff16);
+      mul_lo = _mm256_mullo_epi16(src16, coeff16);
+      // [32] p6 | p2
+      t = _mm256_unpacklo_epi16(mul_lo, mul_hi);
+      accum2 = _mm256_add_epi32(accum2, t);
+      // [32] p7 | p3
+      t = _mm256_unpackhi_epi16(mul_lo, mul_hi);
+      accum3 = _mm256_add_epi32(accum3, t);
+    }
+
+    // Shift right for fixed point implementation.
+    accum0 = _mm256_srai_epi32(accum0, ConvolutionFilter1D::kShiftBits);
+    accum1 = _mm256_srai_epi32(accum1, ConvolutionFilter1D::kShiftBits);
+    accum2 = _mm256_srai_epi32(accum2, ConvolutionFilter1D::kShiftBits);
+    accum3 = _mm256_srai_epi32(accum3, ConvolutionFilter1D::kShiftBits);
+
+    // Packing 32 bits |accum| to 16 bits per channel (signed saturation).
+    // [16] p5 p4 | p1 p0
+    accum0 = _mm256_packs_epi32(accum0, accum1);
+    // [16] p7 p6 | p3 p2
+    accum2 = _mm256_packs_epi32(accum2, accum3);
+
+    // Packing 16 bits |accum| to 8 bits per channel (unsigned saturation).
+    // The per-lane interleaving of the pack instructions cancels out here,
+    // leaving all eight pixels in order.
+    // [8] p7 p6 p5 p4 | p3 p2 p1 p0
+    accum0 = _mm256_packus_epi16(accum0, accum2);
+
+    if (has_alpha) {
+      // Compute the max(ri, gi, bi) for each pixel.
+      // [8] xx a7 b7 g7 ... xx a0 b0 g0
+      __m256i a = _mm256_srli_epi32(accum0, 8);
+      // [8] xx xx xx max7 ... xx xx xx max0
+      __m256i b = _mm256_max_epu8(a, accum0);  // Max of r and g.
+      // [8] xx xx a7 b7 ... xx xx a0 b0
+      a = _mm256_srli_epi32(accum0, 16);
+      // [8] xx xx xx max7 ... xx xx xx max0
+      b = _mm256_max_epu8(a, b);  // Max of r and g and b.
+      // [8] max7 00 00 00 ... max0 00 00 00
+      b = _mm256_slli_epi32(b, 24);
+
+      // Make sure the value of alpha channel is always larger than maximum
+      // value of color channels.
+      accum0 = _mm256_max_epu8(b, accum0);
+    } else {
+      // Set value of alpha channels to 0xFF.
+      __m256i alpha_mask = _mm256_set1_epi32(0xff000000);
+      accum0 = _mm256_or_si256(accum0, alpha_mask);
+    }
+
+    // Store the convolution result (32 bytes) and advance the pixel pointers.
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out_row), accum0);
+    out_row += 32;
+  }
+
+  // Process the tail (up to seven pixels) with 128-bit loads the same way
+  // the SSE2 version does: one group of four pixels, then one pixel (4 bytes)
+  // at a time. The row buffer is padded so the loads below stay in bounds.
+  if (pixel_width & 7) {
+    int width4 = pixel_width & ~3;
+    __m128i zero128 = _mm_setzero_si128();
+    __m128i accum0, accum1, accum2, accum3, coeff16;
+    const __m128i* src;
+
+    for (int out_x = width; out_x < width4; out_x += 4) {
+      accum0 = _mm_setzero_si128();
+      accum1 = _mm_setzero_si128();
+      accum2 = _mm_setzero_si128();
+      accum3 = _mm_setzero_si128();
+
+      for (int filter_y = 0; filter_y < filter_length; filter_y++) {
+        coeff16 = _mm_set1_epi16(filter_values[filter_y]);
+        // [8] a3 b3 g3 r3 a2 b2 g2 r2 a1 b1 g1 r1 a0 b0 g0 r0
+        src = reinterpret_cast<const __m128i*>(
+            &source_data_rows[filter_y][out_x << 2]);
+        __m128i src8 = _mm_loadu_si128(src);
+        // [16] a1 b1 g1 r1 a0 b0 g0 r0
+        __m128i src16 = _mm_unpacklo_epi8(src8, zero128);
+        __m128i mul_hi = _mm_mulhi_epi16(src16, coeff16);
+        __m128i mul_lo = _mm_mullo_epi16(src16, coeff16);
+        // [32] a0 b0 g0 r0
+        __m128i t = _mm_unpacklo_epi16(mul_lo, mul_hi);
+        accum0 = _mm_add_epi32(accum0, t);
+        // [32] a1 b1 g1 r1
+        t = _mm_unpackhi_epi16(mul_lo, mul_hi);
+        accum1 = _mm_add_epi32(accum1, t);
+        // [16] a3 b3 g3 r3 a2 b2 g2 r2
+        src16 = _mm_unpackhi_epi8(src8, zero128);
+        mul_hi = _mm_mulhi_epi16(src16, coeff16);
+        mul_lo = _mm_mullo_epi16(src16, coeff16);
+        // [32] a2 b2 g2 r2
+        t = _mm_unpacklo_epi16(mul_lo, mul_hi);
+        accum2 = _mm_add_epi32(accum2, t);
+        // [32] a3 b3 g3 r3
+        t = _mm_unpackhi_epi16(mul_lo, mul_hi);
+        accum3 = _mm_add_epi32(accum3, t);
+      }
+
+      accum0 = _mm_srai_epi32(accum0, ConvolutionFilter1D::kShiftBits);
+      accum1 = _mm_srai_epi32(accum1, ConvolutionFilter1D::kShiftBits);
+      accum2 = _mm_srai_epi32(accum2, ConvolutionFilter1D::kShiftBits);
+      accum3 = _mm_srai_epi32(accum3, ConvolutionFilter1D::kShiftBits);
+
+      // [16] a1 b1 g1 r1 a0 b0 g0 r0
+      accum0 = _mm_packs_epi32(accum0, accum1);
+      // [16] a3 b3 g3 r3 a2 b2 g2 r2
+      accum2 = _mm_packs_epi32(accum2, accum3);
+      // [8] a3 b3 g3 r3 a2 b2 g2 r2 a1 b1 g1 r1 a0 b0 g0 r0
+      accum0 = _mm_packus_epi16(accum0, accum2);
+
+      if (has_alpha) {
+        __m128i a = _mm_srli_epi32(accum0, 8);
+        __m128i b = _mm_max_epu8(a, accum0);  // Max of r and g.
+        a = _mm_srli_epi32(accum0, 16);
+        b = _mm_max_epu8(a, b);  // Max of r and g and b.
+        b = _mm_slli_epi32(b, 24);
+        accum0 = _mm_max_epu8(b, accum0);
+      } else {
+        __m128i alpha_mask = _mm_set1_epi32(0xff000000);
+        accum0 = _mm_or_si128(accum0, alpha_mask);
+      }
+
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(out_row), accum0);
+      out_row += 16;
+    }
+
+    // When the width of the output is not divisible by 4, we need to save one
+    // pixel (4 bytes) each time. And also the fourth pixel is always absent.
+    if (pixel_width & 3) {
+      accum0 = _mm_setzero_si128();
+      accum1 = _mm_setzero_si128();
+      accum2 = _mm_setzero_si128();
+      for (int filter_y = 0; filter_y < filter_length; ++filter_y) {
+        coeff16 = _mm_set1_epi16(filter_values[filter_y]);
+        // [8] a3 b3 g3 r3 a2 b2 g2 r2 a1 b1 g1 r1 a0 b0 g0 r0
+        src = reinterpret_cast<const __m128i*>(
+            &source_data_rows[filter_y][width4 << 2]);
+        __m128i src8 = _mm_loadu_si128(src);
+        // [16] a1 b1 g1 r1 a0 b0 g0 r0
+        __m128i src16 = _mm_unpacklo_epi8(src8, zero128);
+        __m128i mul_hi = _mm_mulhi_epi16(src16, coeff16);
+        __m128i mul_lo = _mm_mullo_epi16(src16, coeff16);
+        // [32] a0 b0 g0 r0
+        __m128i t = _mm_unpacklo_epi16(mul_lo, mul_hi);
+        accum0 = _mm_add_epi32(accum0, t);
+        // [32] a1 b1 g1 r1
+        t = _mm_unpackhi_epi16(mul_lo, mul_hi);
+        accum1 = _mm_add_epi32(accum1, t);
+        // [16] a3 b3 g3 r3 a2 b2 g2 r2
+        src16 = _mm_unpackhi_epi8(src8, zero128);
+        mul_hi = _mm_mulhi_epi16(src16, coeff16);
+        mul_lo = _mm_mullo_epi16(src16, coeff16);
+        // [32] a2 b2 g2 r2
+        t = _mm_unpacklo_epi16(mul_lo, mul_hi);
+        accum2 = _mm_add_epi32(accum2, t);
+      }
+
+      accum0 = _mm_srai_epi32(accum0, ConvolutionFilter1D::kShiftBits);
+      accum1 = _mm_srai_epi32(accum1, ConvolutionFilter1D::kShiftBits);
+      accum2 = _mm_srai_epi32(accum2, ConvolutionFilter1D::kShiftBits);
+      // [16] a1 b1 g1 r1 a0 b0 g0 r0
+      accum0 = _mm_packs_epi32(accum0, accum1);
+      // [16] a3 b3 g3 r3 a2 b2 g2 r2
+      accum2 = _mm_packs_epi32(accum2, zero128);
+      // [8] a3 b3 g3 r3 a2 b2 g2 r2 a1 b1 g1 r1 a0 b0 g0 r0
+      accum0 = _mm_packus_epi16(accum0, accum2);
+      if (has_alpha) {
+        __m128i a = _mm_srli_epi32(accum0, 8);
+        __m128i b = _mm_max_epu8(a, accum0);  // Max of r and g.
+        a = _mm_srli_epi32(accum0, 16);
+        b = _mm_max_epu8(a, b);  // Max of r and g and b.
+        b = _mm_slli_epi32(b, 24);
+        accum0 = _mm_max_epu8(b, accum0);
+      } else {
+        __m128i alpha_mask = _mm_set1_epi32(0xff000000);
+        accum0 = _mm_or_si128(accum0, alpha_mask);
+      }
+
+      for (int out_x = width4; out_x < pixel_width; out_x++) {
+        *(reinterpret_cast<int*>(out_row)) = _mm_cvtsi128_si32(accum0);
+        accum0 = _mm_srli_si128(accum0, 4);
+        out_row += 4;
+      }
+    }
+  }
+}
+
+void ConvolveVertically_AVX2(const ConvolutionFilter1D::Fixed* filter_values,
+                             int filter_length,
+                             unsigned char* const* source_data_rows,
+                             int pixel_width,
+                             unsigned char* out_row,
+                             bool has_alpha) {
+  if (has_alpha) {
+    ConvolveVertically_AVX2<true>(filter_values,
+                                  filter_length,
+                                  source_data_rows,
+                                  pixel_width,
+                                  out_row);
+  } else {
+    ConvolveVertically_AVX2<false>(filter_values,
+                                   filter_length,
+                                   source_data_rows,
+                                   pixel_width,
+                                   out_row);
+  }
+}
+
+}  // namespace skia
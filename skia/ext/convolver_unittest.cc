@@ -212,25 +212,26 @@ TEST(Convolver, AddFilter) {
   ASSERT_EQ(0, filter_length);
 }
 
-void VerifySIMD(unsigned int source_width,
-                unsigned int source_height,
-                unsigned int dest_width,
-                unsigned int dest_height) {
-  float filter[] = { 0.05f, -0.15f, 0.6f, 0.6f, -0.15f, 0.05f };
+void VerifySIMDWithKernel(unsigned int source_width,
+                          unsigned int source_height,
+                          unsigned int dest_width,
+                          unsigned int dest_height,
+                          const float* kernel,
+                          int kernel_size) {
   // Preparing convolve coefficients.
   ConvolutionFilter1D x_filter, y_filter;
   for (unsigned int p = 0; p < dest_width; ++p) {
     unsigned int offset = source_width * p / dest_width;
     EXPECT_LT(offset, source_width);
-    x_filter.AddFilter(offset, filter,
-                       std::min<int>(arraysize(filter),
+    x_filter.AddFilter(offset, kernel,
+                       std::min<int>(kernel_size,
                                      source_width - offset));
   }
   x_filter.PaddingForSIMD();
   for (unsigned int p = 0; p < dest_height; ++p) {
     unsigned int offset = source_height * p / dest_height;
-    y_filter.AddFilter(offset, filter,
-                       std::min<int>(arraysize(filter),
+    y_filter.AddFilter(offset, kernel,
+                       std::min<int>(kernel_size,
                                      source_height - offset));
   }
   y_filter.PaddingForSIMD();
@@ -298,6 +299,15 @@ void VerifySIMD(unsigned int source_width,
   }
 }
 
+void VerifySIMD(unsigned int source_width,
+                unsigned int source_height,
+                unsigned int dest_width,
+                unsigned int dest_height) {
+  static const float kFilter[] = { 0.05f, -0.15f, 0.6f, 0.6f, -0.15f, 0.05f };
+  VerifySIMDWithKernel(source_width, source_height, dest_width, dest_height,
+                       kFilter, arraysize(kFilter));
+}
+
 TEST(Convolver, VerifySIMDEdgeCases) {
   srand(static_cast<unsigned int>(time(0)));
   // Loop over all possible (small) image sizes
@@ -329,6 +339,84 @@ TEST(Convolver, VerifySIMDPrecision) {
   }
 }
 
+// The AVX2 horizontal path consumes eight filter taps per iteration, so
+// kernels longer than eight taps exercise both its main loop and its
+// remainder handling (the SSE2 path splits the same lengths at four taps).
+TEST(Convolver, VerifySIMDWideKernels) {
+  static const float kKernel13[] = { 0.02f, 0.03f, 0.05f, 0.08f, 0.11f,
+                                     0.13f, 0.16f, 0.13f, 0.11f, 0.08f,
+                                     0.05f, 0.03f, 0.02f };
+  static const float kKernel16[] = { 0.0625f, 0.0625f, 0.0625f, 0.0625f,
+                                     0.0625f, 0.0625f, 0.0625f, 0.0625f,
+                                     0.0625f, 0.0625f, 0.0625f, 0.0625f,
+                                     0.0625f, 0.0625f, 0.0625f, 0.0625f };
+
+  srand(static_cast<unsigned int>(time(0)));
+
+  VerifySIMDWithKernel(128, 96, 40, 30, kKernel13, arraysize(kKernel13));
+  VerifySIMDWithKernel(128, 96, 40, 30, kKernel16, arraysize(kKernel16));
+  VerifySIMDWithKernel(333, 283, 123, 77, kKernel13, arraysize(kKernel13));
+  VerifySIMDWithKernel(333, 283, 123, 77, kKernel16, arraysize(kKernel16));
+}
+
+// Measures resize throughput over a representative 4K source frame. The
+// numbers are only logged; see VerifySIMDWithKernel above for why no timing
+// assertions are made.
+TEST(Convolver, ResizeThroughput4K) {
+  static const int kSourceWidth = 3840;
+  static const int kSourceHeight = 2160;
+  static const int kDestWidth = 1280;
+  static const int kDestHeight = 720;
+  static const int kIterations = 3;
+  static const float kFilter[] = { 0.05f, -0.15f, 0.6f, 0.6f, -0.15f, 0.05f };
+
+  // Preparing convolve coefficients.
+  ConvolutionFilter1D x_filter, y_filter;
+  for (int p = 0; p < kDestWidth; ++p) {
+    int offset = kSourceWidth * p / kDestWidth;
+    x_filter.AddFilter(offset, kFilter,
+                       std::min<int>(arraysize(kFilter),
+                                     kSourceWidth - offset));
+  }
+  x_filter.PaddingForSIMD();
+  for (int p = 0; p < kDestHeight; ++p) {
+    int offset = kSourceHeight * p / kDestHeight;
+    y_filter.AddFilter(offset, kFilter,
+                       std::min<int>(arraysize(kFilter),
+                                     kSourceHeight - offset));
+  }
+  y_filter.PaddingForSIMD();
+
+  SkBitmap source, result;
+  source.allocN32Pixels(kSourceWidth, kSourceHeight);
+  result.allocN32Pixels(kDestWidth, kDestHeight);
+
+  // Randomize source bitmap for testing.
+  unsigned char* src_ptr = static_cast<unsigned char*>(source.getPixels());
+  for (int y = 0; y < source.height(); y++) {
+    for (unsigned int x = 0; x < source.rowBytes(); x++)
+      src_ptr[x] = rand() % 255;
+    src_ptr += source.rowBytes();
+  }
+
+  base::TimeTicks resize_start = base::TimeTicks::Now();
+  for (int i = 0; i < kIterations; ++i) {
+    BGRAConvolve2D(static_cast<const uint8*>(source.getPixels()),
+                   static_cast<int>(source.rowBytes()),
+                   true, x_filter, y_filter,
+                   static_cast<int>(result.rowBytes()),
+                   static_cast<unsigned char*>(result.getPixels()), true);
+  }
+  base::TimeDelta delta = base::TimeTicks::Now() - resize_start;
+
+  int64 us = delta.InMicroseconds();
+  double source_megapixels =
+      static_cast<double>(kSourceWidth) * kSourceHeight / 1000000.0;
+  VLOG(1) << "4K resize: " << us / kIterations << "us per frame, "
+          << source_megapixels * kIterations * 1000000.0 / us
+          << " source megapixels/s";
+}
+
 TEST(Convolver, SeparableSingleConvolution) {
   static const int kImgWidth = 1024;
   static const int kImgHeight = 1024;
@@ -10,10 +10,16 @@
 #include "skia/ext/image_operations.h"
 
 // TODO(pkasting): skia/ext should not depend on base/!
+#include "base/atomic_ref_count.h"
+#include "base/bind.h"
 #include "base/containers/stack_container.h"
 #include "base/debug/trace_event.h"
 #include "base/logging.h"
+#include "base/memory/scoped_vector.h"
 #include "base/metrics/histogram.h"
+#include "base/synchronization/waitable_event.h"
+#include "base/sys_info.h"
+#include "base/threading/worker_pool.h"
 #include "base/time/time.h"
 #include "build/build_config.h"
 #include "skia/ext/convolver.h"
@@ -303,6 +309,46 @@ void ResizeFilter::ComputeFilters(int src_size,
   output->PaddingForSIMD();
 }
 
+// Parallel resize support ----------------------------------------------------
+
+// One horizontal band of the destination of a parallel resize, together with
+// everything a worker needs to convolve it. Every band owns its own filters:
+// the x filters of all bands are identical, but recomputing them per band is
+// cheap compared to the convolution itself and keeps the bands free of shared
+// mutable state.
+struct ResizeBand {
+  ResizeBand(ImageOperations::ResizeMethod method,
+             int src_width, int src_height,
+             int dest_width, int dest_height,
+             const SkIRect& band_subset)
+      : filter(method, src_width, src_height,
+               dest_width, dest_height, band_subset) {}
+
+  ResizeFilter filter;
+  const uint8* source_data;
+  int source_byte_row_stride;
+  bool source_has_alpha;
+  unsigned char* output;
+  int output_byte_row_stride;
+};
+
+// Convolves one band, then signals |done_event| when the last outstanding
+// band has finished.
+void ConvolveBand(ResizeBand* band,
+                  base::AtomicRefCount* outstanding_bands,
+                  base::WaitableEvent* done_event) {
+  BGRAConvolve2D(band->source_data, band->source_byte_row_stride,
+                 band->source_has_alpha, band->filter.x_filter(),
+                 band->filter.y_filter(), band->output_byte_row_stride,
+                 band->output, true);
+  if (!base::AtomicRefCountDec(outstanding_bands))
+    done_event->Signal();
+}
+
+// Bands shorter than this are not worth the cost of computing a separate set
+// of filters and bouncing the work to another thread.
+const int kMinBandHeight = 64;
+
 ImageOperations::ResizeMethod ResizeMethodToAlgorithmMethod(
     ImageOperations::ResizeMethod method) {
   // Convert any "Quality Method" into an "Algorithm Method"
@@ -536,4 +582,91 @@ SkBitmap ImageOperations::Resize(const SkBitmap& source,
                 allocator);
 }
 
+// static
+SkBitmap ImageOperations::ResizeParallel(const SkBitmap& source,
+                                         ResizeMethod method,
+                                         int dest_width, int dest_height,
+                                         SkBitmap::Allocator* allocator) {
+  // The subpixel renderer post-processes its convolution output, so it does
+  // not fit the banded scheme below.
+  int num_bands = 1;
+  if (method != RESIZE_SUBPIXEL) {
+    num_bands = std::min(base::SysInfo::NumberOfProcessors(),
+                         dest_height / kMinBandHeight);
+  }
+  if (num_bands <= 1)
+    return Resize(source, method, dest_width, dest_height, allocator);
+
+  TRACE_EVENT2("skia", "ImageOperations::ResizeParallel",
+               "src_pixels", source.width()*source.height(),
+               "dst_pixels", dest_width*dest_height);
+
+  // Time how long this takes to see if it's a problem for users.
+  base::TimeTicks resize_start = base::TimeTicks::Now();
+
+  if (source.width() < 1 || source.height() < 1)
+    return SkBitmap();
+
+  method = ResizeMethodToAlgorithmMethod(method);
+  // Check that we deal with an "algorithm methods" from this point onward.
+  SkASSERT((ImageOperations::RESIZE_FIRST_ALGORITHM_METHOD <= method) &&
+           (method <= ImageOperations::RESIZE_LAST_ALGORITHM_METHOD));
+
+  SkAutoLockPixels locker(source);
+  if (!source.readyToDraw() || source.colorType() != kN32_SkColorType)
+    return SkBitmap();
+
+  SkBitmap result;
+  result.setInfo(
+      SkImageInfo::MakeN32(dest_width, dest_height, source.alphaType()));
+  result.allocPixels(allocator, NULL);
+  if (!result.readyToDraw())
+    return SkBitmap();
+
+  // Carve the destination into horizontal bands of roughly equal height.
+  // Each band's y filters are computed against the full source, so bands
+  // whose filter windows overlap the same source rows simply read them
+  // independently and the seams match the single-threaded output exactly.
+  ScopedVector<ResizeBand> bands;
+  for (int i = 0; i < num_bands; i++) {
+    int band_top = dest_height * i / num_bands;
+    int band_bottom = dest_height * (i + 1) / num_bands;
+    SkIRect band_subset = { 0, band_top, dest_width, band_bottom };
+    ResizeBand* band = new ResizeBand(method, source.width(), source.height(),
+                                      dest_width, dest_height, band_subset);
+    band->source_data = reinterpret_cast<const uint8*>(source.getPixels());
+    band->source_byte_row_stride = static_cast<int>(source.rowBytes());
+    band->source_has_alpha = !source.isOpaque();
+    band->output = static_cast<unsigned char*>(result.getPixels()) +
+                   band_top * result.rowBytes();
+    band->output_byte_row_stride = static_cast<int>(result.rowBytes());
+    bands.push_back(band);
+  }
+
+  // Hand all but the first band to the worker pool, convolve the first one
+  // on the calling thread, then wait for the stragglers. The bands and the
+  // event live on this stack frame, which stays alive until every band has
+  // signalled.
+  base::AtomicRefCount outstanding_bands = num_bands;
+  base::WaitableEvent done_event(true /* manual reset */,
+                                 false /* initially signaled */);
+  for (int i = 1; i < num_bands; i++) {
+    if (!base::WorkerPool::PostTask(
+            FROM_HERE,
+            base::Bind(&ConvolveBand, bands[i], &outstanding_bands,
+                       &done_event),
+            true /* task_is_slow */)) {
+      // The pool is unavailable (e.g. during shutdown); do the work here.
+      ConvolveBand(bands[i], &outstanding_bands, &done_event);
+    }
+  }
+  ConvolveBand(bands[0], &outstanding_bands, &done_event);
+  done_event.Wait();
+
+  base::TimeDelta delta = base::TimeTicks::Now() - resize_start;
+  UMA_HISTOGRAM_TIMES("Image.ResampleMS", delta);
+
+  return result;
+}
+
 }  // namespace skia
@@ -111,6 +111,17 @@ class SK_API ImageOperations {
                          int dest_width, int dest_height,
                          SkBitmap::Allocator* allocator = NULL);
 
+  // Like the version of Resize() above, but splits the destination into
+  // horizontal bands that are convolved in parallel on the worker pool. This
+  // pays off for large destinations such as screenshot thumbnails; small
+  // destinations automatically take the single-threaded path, so callers like
+  // favicon scaling can use this unconditionally. Blocks the calling thread
+  // until all bands are done.
+  static SkBitmap ResizeParallel(const SkBitmap& source,
+                                 ResizeMethod method,
+                                 int dest_width, int dest_height,
+                                 SkBitmap::Allocator* allocator = NULL);
+
  private:
   ImageOperations();  // Class for scoping only.
 
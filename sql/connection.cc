@@ -216,6 +216,10 @@ Connection::Connection()
       cache_size_(0),
       exclusive_locking_(false),
       restrict_to_user_(false),
+      use_wal_(false),
+      wal_checkpoint_pages_(0),
+      synchronous_mode_(SYNCHRONOUS_FULL),
+      synchronous_mode_set_(false),
       transaction_nesting_(0),
       needs_rollback_(false),
       in_memory_(false),
@@ -713,6 +717,18 @@ scoped_refptr<Connection::StatementRef> Connection::GetCachedStatement(
   return statement;
 }
 
+scoped_refptr<Connection::StatementRef> Connection::GetPrecompiledStatement(
+    const char* sql) {
+  // The SQL text doubles as the cache key, so precompiled statements can be
+  // fetched from any call site that shares the SQL constant.
+  return GetCachedStatement(StatementID(sql), sql);
+}
+
+void Connection::Precompile(const char* const statements[], size_t count) {
+  for (size_t i = 0; i < count; ++i)
+    GetPrecompiledStatement(statements[i]);
+}
+
 scoped_refptr<Connection::StatementRef> Connection::GetUniqueStatement(
     const char* sql) {
   AssertIOAllowed();
@@ -973,12 +989,28 @@ bool Connection::OpenInternal(const std::string& file_name,
   // DELETE (default) - delete -journal file to commit.
   // TRUNCATE - truncate -journal file to commit.
   // PERSIST - zero out header of -journal file to commit.
+  // WAL - append committed pages to -wal file, fold back on checkpoint.
   // journal_size_limit provides size to trim to in PERSIST.
   // TODO(shess): Figure out if PERSIST and journal_size_limit really
   // matter.  In theory, it keeps pages pre-allocated, so if
   // transactions usually fit, it should be faster.
-  ignore_result(Execute("PRAGMA journal_mode = PERSIST"));
-  ignore_result(Execute("PRAGMA journal_size_limit = 16384"));
+  if (use_wal_) {
+    ignore_result(Execute("PRAGMA journal_mode = WAL"));
+    if (wal_checkpoint_pages_ != 0) {
+      const std::string sql = base::StringPrintf(
+          "PRAGMA wal_autocheckpoint=%d", wal_checkpoint_pages_);
+      ignore_result(Execute(sql.c_str()));
+    }
+  } else {
+    ignore_result(Execute("PRAGMA journal_mode = PERSIST"));
+    ignore_result(Execute("PRAGMA journal_size_limit = 16384"));
+  }
+
+  if (synchronous_mode_set_) {
+    const std::string sql = base::StringPrintf(
+        "PRAGMA synchronous=%d", static_cast<int>(synchronous_mode_));
+    ignore_result(Execute(sql.c_str()));
+  }
 
   const base::TimeDelta kBusyTimeout =
     base::TimeDelta::FromSeconds(kBusyTimeoutSeconds);
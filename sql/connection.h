@@ -123,6 +123,41 @@ class SQL_EXPORT Connection {
   // other platforms.
   void set_restrict_to_user() { restrict_to_user_ = true; }
 
+  // Call to use write-ahead logging instead of the default rollback
+  // journal.  Commits append to the -wal file and issue a single fsync,
+  // rather than journaling the overwritten pages and syncing twice, so
+  // this is a good fit for databases with frequent small transactions.
+  // A crash can lose the most recent commits but cannot corrupt the
+  // database.
+  //
+  // This must be called before Open() to have an effect.
+  void set_use_wal() { use_wal_ = true; }
+
+  // Sets the number of log pages accumulated before sqlite folds the
+  // write-ahead log back into the main database file.  Larger values
+  // mean fewer checkpoint stalls at the cost of a bigger -wal file and
+  // slower reads.  Only meaningful together with set_use_wal(), and
+  // must be called before Open() to have an effect.  If never called,
+  // the sqlite default (1000 pages) applies.
+  void set_wal_checkpoint_pages(int pages) { wal_checkpoint_pages_ = pages; }
+
+  // How aggressively sqlite syncs commits to durable storage, from
+  // "PRAGMA synchronous".  SYNCHRONOUS_NORMAL syncs at critical moments
+  // only; in WAL mode it is safe against corruption and merely risks
+  // losing the latest commits on power failure.
+  enum SynchronousMode {
+    SYNCHRONOUS_OFF = 0,
+    SYNCHRONOUS_NORMAL = 1,
+    SYNCHRONOUS_FULL = 2,
+  };
+
+  // Overrides the sqlite default (SYNCHRONOUS_FULL) for this database.
+  // This must be called before Open() to have an effect.
+  void set_synchronous_mode(SynchronousMode mode) {
+    synchronous_mode_ = mode;
+    synchronous_mode_set_ = true;
+  }
+
   // Set an error-handling callback.  On errors, the error number (and
   // statement, if available) will be passed to the callback.
   //
@@ -348,6 +383,22 @@ class SQL_EXPORT Connection {
   scoped_refptr<StatementRef> GetCachedStatement(const StatementID& id,
                                                  const char* sql);
 
+  // Returns a statement for the given SQL using the statement cache, keyed
+  // by the SQL text itself rather than a call-site StatementID.  Use this
+  // (with a shared SQL constant) when the statement is declared up front
+  // via Precompile(), so hot paths fetch the already-compiled statement
+  // instead of paying sqlite3_prepare on first use.
+  //
+  // See GetCachedStatement above for error information.
+  scoped_refptr<StatementRef> GetPrecompiledStatement(const char* sql);
+
+  // Compiles each statement in |statements| and stores it in the statement
+  // cache so that later GetPrecompiledStatement() calls for the same SQL
+  // are cache hits.  Call on the database thread once the schema exists
+  // (compilation fails against missing tables), typically right after
+  // opening and migrating the database.
+  void Precompile(const char* const statements[], size_t count);
+
   // Used to check a |sql| statement for syntactic validity. If the statement is
   // valid SQL, returns true.
   bool IsSQLValid(const char* sql);
@@ -557,6 +608,10 @@ class SQL_EXPORT Connection {
   int cache_size_;
   bool exclusive_locking_;
   bool restrict_to_user_;
+  bool use_wal_;
+  int wal_checkpoint_pages_;
+  SynchronousMode synchronous_mode_;
+  bool synchronous_mode_set_;
 
   // All cached statements. Keeping a reference to these statements means that
   // they'll remain active.
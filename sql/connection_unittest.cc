@@ -867,4 +867,67 @@ TEST_F(SQLConnectionTest, Basic_FullIntegrityCheck) {
   // file that would pass the quick check and fail the full check.
 }
 
+TEST_F(SQLConnectionTest, Precompile) {
+  ASSERT_TRUE(db().Execute("CREATE TABLE foo (a, b)"));
+
+  static const char kInsertSql[] = "INSERT INTO foo (a, b) VALUES (?, ?)";
+  static const char kSelectSql[] = "SELECT b FROM foo WHERE a = ?";
+  const char* const kStatements[] = { kInsertSql, kSelectSql };
+  db().Precompile(kStatements, arraysize(kStatements));
+
+  // The precompiled statements are in the cache, keyed by their text.
+  EXPECT_TRUE(db().HasCachedStatement(sql::StatementID(kInsertSql)));
+  EXPECT_TRUE(db().HasCachedStatement(sql::StatementID(kSelectSql)));
+
+  {
+    sql::Statement insert(db().GetPrecompiledStatement(kInsertSql));
+    insert.BindInt(0, 12);
+    insert.BindInt(1, 13);
+    ASSERT_TRUE(insert.Run());
+  }
+  sql::Statement select(db().GetPrecompiledStatement(kSelectSql));
+  select.BindInt(0, 12);
+  ASSERT_TRUE(select.Step());
+  EXPECT_EQ(13, select.ColumnInt(0));
+}
+
+TEST_F(SQLConnectionTest, WalMode) {
+  // The fixture opens with the default rollback journal.
+  {
+    sql::Statement s(db().GetUniqueStatement("PRAGMA journal_mode"));
+    ASSERT_TRUE(s.Step());
+    EXPECT_EQ("persist", s.ColumnString(0));
+  }
+  db().Close();
+
+  sql::Connection wal_db;
+  wal_db.set_use_wal();
+  wal_db.set_wal_checkpoint_pages(500);
+  wal_db.set_synchronous_mode(sql::Connection::SYNCHRONOUS_NORMAL);
+  ASSERT_TRUE(wal_db.Open(db_path()));
+
+  {
+    sql::Statement s(wal_db.GetUniqueStatement("PRAGMA journal_mode"));
+    ASSERT_TRUE(s.Step());
+    EXPECT_EQ("wal", s.ColumnString(0));
+  }
+  {
+    sql::Statement s(wal_db.GetUniqueStatement("PRAGMA wal_autocheckpoint"));
+    ASSERT_TRUE(s.Step());
+    EXPECT_EQ(500, s.ColumnInt(0));
+  }
+  {
+    sql::Statement s(wal_db.GetUniqueStatement("PRAGMA synchronous"));
+    ASSERT_TRUE(s.Step());
+    EXPECT_EQ(sql::Connection::SYNCHRONOUS_NORMAL, s.ColumnInt(0));
+  }
+
+  // Writes commit normally in WAL mode.
+  ASSERT_TRUE(wal_db.Execute("CREATE TABLE foo (a, b)"));
+  ASSERT_TRUE(wal_db.Execute("INSERT INTO foo (a, b) VALUES (12, 13)"));
+  sql::Statement s(wal_db.GetUniqueStatement("SELECT b FROM foo WHERE a = 12"));
+  ASSERT_TRUE(s.Step());
+  EXPECT_EQ(13, s.ColumnInt(0));
+}
+
 }  // namespace
@@ -136,6 +136,12 @@ namespace {
 
 const int kDefaultSessionsCommitDelaySeconds = 10;
 
+// How far a pending nudge may be postponed by debouncing, as a multiple of
+// the nudge's original delay.  A burst of local changes keeps pushing the
+// nudge out so the whole burst is committed in one batch, but commits are
+// never delayed past this many times the type's own nudge delay.
+const int kMaxNudgeDebounceFactor = 4;
+
 bool IsConfigRelatedUpdateSourceValue(
     GetUpdatesCallerInfo::GetUpdatesSource source) {
   switch (source) {
@@ -367,7 +373,7 @@ void SyncSchedulerImpl::ScheduleLocalNudge(
       << ModelTypeSetToString(types);
   UpdateNudgeTimeRecords(types);
   nudge_tracker_.RecordLocalChange(types);
-  ScheduleNudgeImpl(desired_delay, nudge_location);
+  ScheduleNudgeImpl(desired_delay, true /* debounce */, nudge_location);
 }
 
 void SyncSchedulerImpl::ScheduleLocalRefreshRequest(
@@ -381,7 +387,7 @@ void SyncSchedulerImpl::ScheduleLocalRefreshRequest(
       << "Scheduling sync because of local refresh request for "
       << ModelTypeSetToString(types);
   nudge_tracker_.RecordLocalRefreshRequest(types);
-  ScheduleNudgeImpl(desired_delay, nudge_location);
+  ScheduleNudgeImpl(desired_delay, false /* debounce */, nudge_location);
 }
 
 void SyncSchedulerImpl::ScheduleInvalidationNudge(
@@ -395,13 +401,14 @@ void SyncSchedulerImpl::ScheduleInvalidationNudge(
       << "Scheduling sync because we received invalidation for "
       << ModelTypeToString(model_type);
   nudge_tracker_.RecordRemoteInvalidation(model_type, invalidation.Pass());
-  ScheduleNudgeImpl(desired_delay, nudge_location);
+  ScheduleNudgeImpl(desired_delay, false /* debounce */, nudge_location);
 }
 
 // TODO(zea): Consider adding separate throttling/backoff for datatype
 // refresh requests.
 void SyncSchedulerImpl::ScheduleNudgeImpl(
     const TimeDelta& delay,
+    bool debounce,
     const tracked_objects::Location& nudge_location) {
   DCHECK(CalledOnValidThread());
 
@@ -424,22 +431,48 @@ void SyncSchedulerImpl::ScheduleNudgeImpl(
     return;
 
   TimeTicks incoming_run_time = TimeTicks::Now() + delay;
-  if (!scheduled_nudge_time_.is_null() &&
-    (scheduled_nudge_time_ < incoming_run_time)) {
-    // Old job arrives sooner than this one.  Don't reschedule it.
+  if (scheduled_nudge_time_.is_null()) {
+    // No nudge in flight; this one establishes how far debouncing may later
+    // postpone it.  A nudge that must not be postponed pins the deadline to
+    // its own run time.
+    nudge_debounce_deadline_ = debounce ?
+        incoming_run_time + delay * (kMaxNudgeDebounceFactor - 1) :
+        incoming_run_time;
+  } else if (incoming_run_time < scheduled_nudge_time_) {
+    // The incoming nudge should be made to arrive first (preempt) the
+    // existing nudge.  If it must not be postponed, it also caps how far
+    // debouncing may push the job out afterwards.
+    if (!debounce) {
+      nudge_debounce_deadline_ =
+          std::min(nudge_debounce_deadline_, incoming_run_time);
+    }
+  } else if (!debounce) {
+    // Old job arrives sooner than this one.  Don't reschedule it, but don't
+    // let debouncing postpone the job past this nudge's run time either.
+    nudge_debounce_deadline_ =
+        std::min(nudge_debounce_deadline_, incoming_run_time);
     return;
+  } else {
+    // Local changes are still arriving.  Postpone the pending nudge so the
+    // whole burst is committed in one batch, but never past the debounce
+    // deadline established when the first nudge was scheduled.
+    incoming_run_time = std::min(incoming_run_time, nudge_debounce_deadline_);
+    if (incoming_run_time <= scheduled_nudge_time_)
+      return;  // The deadline has been reached; let the pending nudge run.
+    SDVLOG_LOC(nudge_location, 2)
+        << "Debouncing the pending nudge by "
+        << (incoming_run_time - scheduled_nudge_time_).InMilliseconds()
+        << " ms";
   }
 
-  // Either there is no existing nudge in flight or the incoming nudge should be
-  // made to arrive first (preempt) the existing nudge.  We reschedule in either
-  // case.
   SDVLOG_LOC(nudge_location, 2)
       << "Scheduling a nudge with "
-      << delay.InMilliseconds() << " ms delay";
+      << (incoming_run_time - TimeTicks::Now()).InMilliseconds()
+      << " ms delay";
   scheduled_nudge_time_ = incoming_run_time;
   pending_wakeup_timer_.Start(
       nudge_location,
-      delay,
+      incoming_run_time - TimeTicks::Now(),
       base::Bind(&SyncSchedulerImpl::PerformDelayedNudge,
                  weak_ptr_factory_.GetWeakPtr()));
 }
@@ -476,6 +509,7 @@ void SyncSchedulerImpl::DoNudgeSyncSessionJob(JobPriority priority) {
     SDVLOG(2) << "Nudge succeeded.";
     nudge_tracker_.RecordSuccessfulSyncCycle();
     scheduled_nudge_time_ = base::TimeTicks();
+    nudge_debounce_deadline_ = base::TimeTicks();
 
     // If we're here, then we successfully reached the server.  End all backoff.
     wait_interval_.reset();
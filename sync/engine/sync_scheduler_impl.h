@@ -181,9 +181,12 @@ class SYNC_EXPORT_PRIVATE SyncSchedulerImpl
   // If the scheduler's current state supports it, this will create a job based
   // on the passed in parameters and coalesce it with any other pending jobs,
   // then post a delayed task to run it.  It may also choose to drop the job or
-  // save it for later, depending on the scheduler's current state.
+  // save it for later, depending on the scheduler's current state.  If
+  // |debounce| is true, a pending nudge may be postponed (up to a bounded
+  // deadline) so that a burst of local changes is committed in one batch.
   void ScheduleNudgeImpl(
       const base::TimeDelta& delay,
+      bool debounce,
       const tracked_objects::Location& nudge_location);
 
   // Helper to signal listeners about changed retry time.
@@ -277,6 +280,10 @@ class SYNC_EXPORT_PRIVATE SyncSchedulerImpl
   // If we have a nudge pending to run soon, it will be listed here.
   base::TimeTicks scheduled_nudge_time_;
 
+  // The latest time the pending nudge may be postponed to by debouncing.
+  // Only meaningful while |scheduled_nudge_time_| is set.
+  base::TimeTicks nudge_debounce_deadline_;
+
   // Keeps track of work that the syncer needs to handle.
   sessions::NudgeTracker nudge_tracker_;
 
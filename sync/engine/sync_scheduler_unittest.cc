@@ -527,6 +527,33 @@ TEST_F(SyncSchedulerTest, NudgeCoalescingWithDifferentTimings) {
   EXPECT_LE(times[0], max_time);
 }
 
+// Test that a burst of local nudges is debounced into a single sync that
+// doesn't start before the last nudge's delay has elapsed.
+TEST_F(SyncSchedulerTest, NudgeDebouncing) {
+  StartSyncScheduler(SyncScheduler::NORMAL_MODE);
+
+  SyncShareTimes times;
+  EXPECT_CALL(*syncer(), NormalSyncShare(_,_,_))
+      .WillOnce(DoAll(Invoke(sessions::test_util::SimulateNormalSuccess),
+                      RecordSyncShare(&times)));
+  const ModelTypeSet types1(BOOKMARKS), types2(AUTOFILL);
+
+  const TimeDelta first_delay = TimeDelta::FromMilliseconds(50);
+  const TimeDelta second_delay = TimeDelta::FromMilliseconds(200);
+  TimeTicks first_schedule_time = TimeTicks::Now();
+  scheduler()->ScheduleLocalNudge(first_delay, types1, FROM_HERE);
+  scheduler()->ScheduleLocalNudge(second_delay, types2, FROM_HERE);
+
+  // The second nudge postpones the pending one, though never past the
+  // debounce deadline derived from the first nudge's delay.  Here the
+  // deadline (four times the 50 ms delay) is what limits the postponement.
+  TimeTicks min_time = first_schedule_time + second_delay;
+  RunLoop();
+
+  ASSERT_EQ(1U, times.size());
+  EXPECT_GE(times[0], min_time);
+}
+
 // Test nudge scheduling.
 TEST_F(SyncSchedulerTest, NudgeWithStates) {
   StartSyncScheduler(SyncScheduler::NORMAL_MODE);
@@ -96,6 +96,11 @@ bool DataPack::LoadFromFile(base::File file) {
   return LoadImpl();
 }
 
+void DataPack::Prefetch() {
+  if (mmap_.get())
+    mmap_->Prefetch();
+}
+
 bool DataPack::LoadImpl() {
   // Sanity check the header of the file.
   if (kHeaderLength > mmap_->length()) {
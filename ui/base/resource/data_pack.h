@@ -38,6 +38,12 @@ class UI_BASE_EXPORT DataPack : public ResourceHandle {
   // Loads a pack file from |file|, returning false on error.
   bool LoadFromFile(base::File file);
 
+  // Asks the OS to start reading the whole pack file into the page cache.
+  // Resources are fetched from all over the file in no particular order, so
+  // on a cold start this avoids blocking on a scattered page fault per
+  // resource. The readahead happens asynchronously; this returns immediately.
+  void Prefetch();
+
   // Writes a pack file containing |resources| to |path|. If there are any
   // text resources to be written, their encoding must already agree to the
   // |textEncodingType| specified. If no text resources are present, please
@@ -8,6 +8,7 @@
 #include <vector>
 
 #include "base/big_endian.h"
+#include "base/bind.h"
 #include "base/command_line.h"
 #include "base/file_util.h"
 #include "base/files/file.h"
@@ -19,6 +20,7 @@
 #include "base/strings/string_piece.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/synchronization/lock.h"
+#include "base/threading/worker_pool.h"
 #include "build/build_config.h"
 #include "grit/app_locale_settings.h"
 #include "skia/ext/image_operations.h"
@@ -154,6 +156,78 @@ class ResourceBundle::ResourceBundleImageSource : public gfx::ImageSkiaSource {
   DISALLOW_COPY_AND_ASSIGN(ResourceBundleImageSource);
 };
 
+// Holds the bitmaps decoded ahead of time by PreloadImages(). The cache is
+// shared between the bundle and the worker pool tasks doing the decoding,
+// so a task that finishes after the bundle has been destroyed (as happens
+// in tests) writes into a cache that is simply dropped.
+class ResourceBundle::PreloadedImageCache
+    : public base::RefCountedThreadSafe<PreloadedImageCache> {
+ public:
+  PreloadedImageCache() {}
+
+  // Decodes |memory| for |resource_id| and caches the result. Runs on a
+  // worker thread; undecodable data is skipped and will be reported by the
+  // on-demand load path.
+  void DecodeImage(int resource_id,
+                   ScaleFactor requested_scale_factor,
+                   ScaleFactor loaded_scale_factor,
+                   scoped_refptr<base::RefCountedMemory> memory) {
+    Entry entry;
+    entry.requested_scale_factor = requested_scale_factor;
+    entry.loaded_scale_factor = loaded_scale_factor;
+    if (!DecodeImageData(memory.get(), &entry.bitmap, &entry.fell_back_to_1x))
+      return;
+    entry.bitmap.setImmutable();
+    base::AutoLock lock_scope(lock_);
+    entries_[resource_id] = entry;
+  }
+
+  // Moves the decoded bitmap for |resource_id| at |*scale_factor| into the
+  // out parameters, with the same semantics as ResourceBundle::LoadBitmap().
+  // Returns false if no matching bitmap has been decoded.
+  bool TakeImage(int resource_id,
+                 ScaleFactor* scale_factor,
+                 SkBitmap* bitmap,
+                 bool* fell_back_to_1x) {
+    base::AutoLock lock_scope(lock_);
+    EntryMap::iterator it = entries_.find(resource_id);
+    if (it == entries_.end() ||
+        it->second.requested_scale_factor != *scale_factor)
+      return false;
+    *bitmap = it->second.bitmap;
+    *fell_back_to_1x = it->second.fell_back_to_1x;
+    *scale_factor = it->second.loaded_scale_factor;
+    entries_.erase(it);
+    return true;
+  }
+
+ private:
+  friend class base::RefCountedThreadSafe<PreloadedImageCache>;
+
+  struct Entry {
+    Entry()
+        : fell_back_to_1x(false),
+          requested_scale_factor(SCALE_FACTOR_NONE),
+          loaded_scale_factor(SCALE_FACTOR_NONE) {}
+
+    SkBitmap bitmap;
+    bool fell_back_to_1x;
+    // The scale factor the bitmap was requested for, and the one it was
+    // actually loaded from (SCALE_FACTOR_NONE for scale independent
+    // resources).
+    ScaleFactor requested_scale_factor;
+    ScaleFactor loaded_scale_factor;
+  };
+  typedef std::map<int, Entry> EntryMap;
+
+  ~PreloadedImageCache() {}
+
+  base::Lock lock_;
+  EntryMap entries_;
+
+  DISALLOW_COPY_AND_ASSIGN(PreloadedImageCache);
+};
+
 // static
 std::string ResourceBundle::InitSharedInstanceWithLocale(
     const std::string& pref_locale, Delegate* delegate) {
@@ -297,6 +371,7 @@ std::string ResourceBundle::LoadLocaleResources(
     return std::string();
   }
 
+  data_pack->Prefetch();
   locale_resources_data_.reset(data_pack.release());
   return app_locale;
 }
@@ -404,6 +479,53 @@ gfx::Image& ResourceBundle::GetNativeImageNamed(int resource_id) {
   return GetNativeImageNamed(resource_id, RTL_DISABLED);
 }
 
+void ResourceBundle::PreloadImages(const int* resource_ids, size_t count) {
+#if defined(OS_CHROMEOS) || defined(OS_WIN)
+  ScaleFactor scale_factor_to_load = GetMaxScaleFactor();
+#else
+  ScaleFactor scale_factor_to_load = ui::SCALE_FACTOR_100P;
+#endif
+
+  for (size_t i = 0; i < count; ++i) {
+    int resource_id = resource_ids[i];
+    {
+      base::AutoLock lock_scope(*images_and_fonts_lock_);
+      if (images_.count(resource_id))
+        continue;
+    }
+
+    // Select the pack the same way LoadBitmap() would, but defer the
+    // decode to the worker pool. The raw bytes point into the pack's
+    // memory, so the packs must stay alive until the tasks finish.
+    ScaleFactor loaded_scale_factor = scale_factor_to_load;
+    scoped_refptr<base::RefCountedMemory> memory;
+    for (size_t j = 0; j < data_packs_.size(); ++j) {
+      ResourceHandle* pack = data_packs_[j];
+      if (pack->GetScaleFactor() != ui::SCALE_FACTOR_NONE &&
+          pack->GetScaleFactor() != scale_factor_to_load)
+        continue;
+      memory = pack->GetStaticMemory(resource_id);
+      if (memory.get()) {
+        if (pack->GetScaleFactor() == ui::SCALE_FACTOR_NONE)
+          loaded_scale_factor = ui::SCALE_FACTOR_NONE;
+        break;
+      }
+    }
+    if (!memory.get())
+      continue;
+
+    base::WorkerPool::PostTask(
+        FROM_HERE,
+        base::Bind(&PreloadedImageCache::DecodeImage,
+                   preloaded_images_,
+                   resource_id,
+                   scale_factor_to_load,
+                   loaded_scale_factor,
+                   memory),
+        true /* task_is_slow */);
+  }
+}
+
 base::RefCountedStaticMemory* ResourceBundle::LoadDataResourceBytes(
     int resource_id) const {
   return LoadDataResourceBytesForScale(resource_id, ui::SCALE_FACTOR_NONE);
@@ -561,7 +683,8 @@ ResourceBundle::ResourceBundle(Delegate* delegate)
     : delegate_(delegate),
       images_and_fonts_lock_(new base::Lock),
       locale_resources_data_lock_(new base::Lock),
-      max_scale_factor_(SCALE_FACTOR_100P) {
+      max_scale_factor_(SCALE_FACTOR_100P),
+      preloaded_images_(new PreloadedImageCache) {
 }
 
 ResourceBundle::~ResourceBundle() {
@@ -649,6 +772,10 @@ void ResourceBundle::AddDataPackFromPathInternal(const base::FilePath& path,
   scoped_ptr<DataPack> data_pack(
       new DataPack(scale_factor));
   if (data_pack->LoadFromPath(pack_path)) {
+    // On a cold start the pack file is not in the page cache yet; start
+    // readahead now so that the first resource accesses don't stall on
+    // scattered disk reads.
+    data_pack->Prefetch();
     AddDataPack(data_pack.release());
   } else if (!optional) {
     LOG(ERROR) << "Failed to load " << pack_path.value()
@@ -744,20 +871,8 @@ bool ResourceBundle::LoadBitmap(const ResourceHandle& data_handle,
   if (!memory.get())
     return false;
 
-  if (DecodePNG(memory->front(), memory->size(), bitmap, fell_back_to_1x))
-    return true;
-
-#if !defined(OS_IOS)
-  // iOS does not compile or use the JPEG codec.  On other platforms,
-  // 99% of our assets are PNGs, however fallback to JPEG.
-  scoped_ptr<SkBitmap> jpeg_bitmap(
-      gfx::JPEGCodec::Decode(memory->front(), memory->size()));
-  if (jpeg_bitmap.get()) {
-    bitmap->swap(*jpeg_bitmap.get());
-    *fell_back_to_1x = false;
+  if (DecodeImageData(memory.get(), bitmap, fell_back_to_1x))
     return true;
-  }
-#endif
 
   NOTREACHED() << "Unable to decode theme image resource " << resource_id;
   return false;
@@ -768,6 +883,9 @@ bool ResourceBundle::LoadBitmap(int resource_id,
                                 SkBitmap* bitmap,
                                 bool* fell_back_to_1x) const {
   DCHECK(fell_back_to_1x);
+  if (preloaded_images_->TakeImage(resource_id, scale_factor, bitmap,
+                                   fell_back_to_1x))
+    return true;
   for (size_t i = 0; i < data_packs_.size(); ++i) {
     if (data_packs_[i]->GetScaleFactor() == ui::SCALE_FACTOR_NONE &&
         LoadBitmap(*data_packs_[i], resource_id, bitmap, fell_back_to_1x)) {
@@ -839,4 +957,26 @@ bool ResourceBundle::DecodePNG(const unsigned char* buf,
   return gfx::PNGCodec::Decode(buf, size, bitmap);
 }
 
+// static
+bool ResourceBundle::DecodeImageData(const base::RefCountedMemory* memory,
+                                     SkBitmap* bitmap,
+                                     bool* fell_back_to_1x) {
+  if (DecodePNG(memory->front(), memory->size(), bitmap, fell_back_to_1x))
+    return true;
+
+#if !defined(OS_IOS)
+  // iOS does not compile or use the JPEG codec.  On other platforms,
+  // 99% of our assets are PNGs, however fallback to JPEG.
+  scoped_ptr<SkBitmap> jpeg_bitmap(
+      gfx::JPEGCodec::Decode(memory->front(), memory->size()));
+  if (jpeg_bitmap.get()) {
+    bitmap->swap(*jpeg_bitmap.get());
+    *fell_back_to_1x = false;
+    return true;
+  }
+#endif
+
+  return false;
+}
+
 }  // namespace ui
@@ -12,6 +12,7 @@
 #include "base/containers/hash_tables.h"
 #include "base/files/file_path.h"
 #include "base/gtest_prod_util.h"
+#include "base/memory/ref_counted.h"
 #include "base/memory/scoped_ptr.h"
 #include "base/memory/scoped_vector.h"
 #include "base/strings/string16.h"
@@ -28,6 +29,7 @@ class SkBitmap;
 namespace base {
 class File;
 class Lock;
+class RefCountedMemory;
 class RefCountedStaticMemory;
 }
 
@@ -205,6 +207,14 @@ class UI_BASE_EXPORT ResourceBundle {
   // Same as GetNativeImageNamed() except that RTL is not enabled.
   gfx::Image& GetNativeImageNamed(int resource_id);
 
+  // Decodes the images for |resource_ids| on worker threads and keeps the
+  // resulting bitmaps until the first GetImageNamed() call for each id picks
+  // them up, moving the decode work off the calling thread. Preloading is
+  // opportunistic: an id whose decode has not finished by the time it is
+  // first requested is decoded on demand as usual. All data packs must have
+  // been added already and must outlive the decode tasks.
+  void PreloadImages(const int* resource_ids, size_t count);
+
   // Loads the raw bytes of a scale independent data resource.
   base::RefCountedStaticMemory* LoadDataResourceBytes(int resource_id) const;
 
@@ -278,6 +288,7 @@ class UI_BASE_EXPORT ResourceBundle {
   friend class ResourceBundleImageTest;
   friend class ResourceBundleTest;
 
+  class PreloadedImageCache;
   class ResourceBundleImageSource;
   friend class ResourceBundleImageSource;
 
@@ -363,6 +374,12 @@ class UI_BASE_EXPORT ResourceBundle {
                         SkBitmap* bitmap,
                         bool* fell_back_to_1x);
 
+  // Decodes |memory| as a PNG, falling back to JPEG, into |bitmap|. Safe to
+  // call from any thread. Returns false if the data is not decodable.
+  static bool DecodeImageData(const base::RefCountedMemory* memory,
+                              SkBitmap* bitmap,
+                              bool* fell_back_to_1x);
+
   // Returns an empty image for when a resource cannot be loaded. This is a
   // bright red bitmap.
   gfx::Image& GetEmptyImage();
@@ -391,6 +408,10 @@ class UI_BASE_EXPORT ResourceBundle {
   typedef std::map<int, gfx::Image> ImageMap;
   ImageMap images_;
 
+  // Bitmaps decoded ahead of time by PreloadImages(). Shared with the
+  // worker pool tasks doing the decoding.
+  scoped_refptr<PreloadedImageCache> preloaded_images_;
+
   gfx::Image empty_image_;
 
   // The various font lists used. Cached to avoid repeated GDI
@@ -527,6 +527,42 @@ TEST_F(ResourceBundleImageTest, GetImageNamed) {
   EXPECT_EQ(1.4f, image_skia->GetRepresentation(1.4f).scale());
 }
 
+// Test that images requested after PreloadImages() decode to the same reps
+// as images loaded on demand, regardless of whether the asynchronous decode
+// has finished by the time the image is requested.
+TEST_F(ResourceBundleImageTest, PreloadImages) {
+  std::vector<ScaleFactor> supported_factors;
+  supported_factors.push_back(SCALE_FACTOR_100P);
+  supported_factors.push_back(SCALE_FACTOR_200P);
+  test::ScopedSetSupportedScaleFactors scoped_supported(supported_factors);
+  base::FilePath data_1x_path = dir_path().AppendASCII("sample_1x.pak");
+  base::FilePath data_2x_path = dir_path().AppendASCII("sample_2x.pak");
+
+  // Create the pak files.
+  CreateDataPackWithSingleBitmap(data_1x_path, 10, base::StringPiece());
+  CreateDataPackWithSingleBitmap(data_2x_path, 20, base::StringPiece());
+
+  // Load the regular and 2x pak files.
+  ResourceBundle* resource_bundle = CreateResourceBundleWithEmptyLocalePak();
+  resource_bundle->AddDataPackFromPath(data_1x_path, SCALE_FACTOR_100P);
+  resource_bundle->AddDataPackFromPath(data_2x_path, SCALE_FACTOR_200P);
+
+  const int kResourceId = 3;
+  resource_bundle->PreloadImages(&kResourceId, 1);
+
+  // Whether the preloaded bitmap is picked up or the decode happens on
+  // demand, the resulting reps must be identical to the unpreloaded path.
+  gfx::ImageSkia* image_skia = resource_bundle->GetImageSkiaNamed(kResourceId);
+  gfx::ImageSkiaRep image_rep = image_skia->GetRepresentation(
+      GetScaleForScaleFactor(ui::SCALE_FACTOR_100P));
+  EXPECT_EQ(ui::SCALE_FACTOR_100P, GetSupportedScaleFactor(image_rep.scale()));
+  EXPECT_EQ(10, image_rep.pixel_width());
+  image_rep = image_skia->GetRepresentation(
+      GetScaleForScaleFactor(ui::SCALE_FACTOR_200P));
+  EXPECT_EQ(ui::SCALE_FACTOR_200P, GetSupportedScaleFactor(image_rep.scale()));
+  EXPECT_EQ(20, image_rep.pixel_width());
+}
+
 // Test that GetImageNamed() behaves properly for images which GRIT has
 // annotated as having fallen back to 1x.
 TEST_F(ResourceBundleImageTest, GetImageNamedFallback1x) {
@@ -206,6 +206,8 @@
         'gesture_detection/gesture_provider.cc',
         'gesture_detection/gesture_provider.h',
         'gesture_detection/motion_event.h',
+        'gesture_detection/motion_event_buffer.cc',
+        'gesture_detection/motion_event_buffer.h',
         'gesture_detection/scale_gesture_detector.cc',
         'gesture_detection/scale_gesture_detector.h',
         'gesture_detection/snap_scroll_controller.cc',
@@ -294,6 +296,7 @@
         'gestures/velocity_calculator_unittest.cc',
         'gesture_detection/bitset_32_unittest.cc',
         'gesture_detection/gesture_provider_unittest.cc',
+        'gesture_detection/motion_event_buffer_unittest.cc',
         'gesture_detection/velocity_tracker_unittest.cc',
         'gesture_detection/touch_disposition_gesture_filter_unittest.cc',
         'keycodes/dom4/keycode_converter_unittest.cc',
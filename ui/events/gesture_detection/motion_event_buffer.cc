@@ -0,0 +1,372 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ui/events/gesture_detection/motion_event_buffer.h"
+
+#include <algorithm>
+
+#include "base/logging.h"
+#include "ui/events/gesture_detection/motion_event.h"
+#include "ui/gfx/geometry/point_f.h"
+
+namespace ui {
+namespace {
+
+// Latency added during resampling. A few milliseconds doesn't hurt much but
+// allows the resampled coordinates to be generally interpolated rather than
+// extrapolated, yielding smoother results.
+const int kResampleLatencyMs = 5;
+
+// Minimum time difference between consecutive samples before attempting to
+// resample, below which the resampled velocity estimate is too noisy.
+const int kResampleMinDeltaMs = 2;
+
+// Maximum time to predict forward from the last received sample, to avoid
+// predicting too far into the future.
+const int kResampleMaxPredictionMs = 8;
+
+// A MotionEvent representing a single resampled pointer sample, exposing the
+// samples it was derived from as its history, oldest first.
+class ResampledMotionEvent : public MotionEvent {
+ public:
+  // |latest| is the most recent event consumed in forming the resampled
+  // event; it provides all non-positional pointer attributes. Pointer order
+  // follows that of |latest|, and all events in |earlier_events| (as well as
+  // their own historical samples) are flattened into the history.
+  ResampledMotionEvent(const MotionEvent& latest,
+                       base::TimeTicks time,
+                       const std::vector<gfx::PointF>& positions,
+                       const ScopedVector<MotionEvent>& earlier_events)
+      : action_(ACTION_MOVE),
+        id_(latest.GetId()),
+        button_state_(latest.GetButtonState()),
+        time_(time),
+        positions_(positions) {
+    DCHECK_EQ(latest.GetPointerCount(), positions.size());
+    const size_t pointer_count = latest.GetPointerCount();
+    for (size_t i = 0; i < pointer_count; ++i) {
+      pointer_ids_.push_back(latest.GetPointerId(i));
+      raw_offsets_.push_back(gfx::PointF(latest.GetRawX(i) - latest.GetX(i),
+                                         latest.GetRawY(i) - latest.GetY(i)));
+      touch_majors_.push_back(latest.GetTouchMajor(i));
+      pressures_.push_back(latest.GetPressure(i));
+      tool_types_.push_back(latest.GetToolType(i));
+    }
+
+    for (size_t e = 0; e < earlier_events.size(); ++e)
+      AppendEventToHistory(*earlier_events[e]);
+    AppendEventToHistory(latest);
+  }
+
+  virtual ~ResampledMotionEvent() {}
+
+  // MotionEvent implementation.
+  virtual int GetId() const OVERRIDE { return id_; }
+  virtual Action GetAction() const OVERRIDE { return action_; }
+  virtual int GetActionIndex() const OVERRIDE {
+    NOTREACHED();
+    return -1;
+  }
+  virtual size_t GetPointerCount() const OVERRIDE { return positions_.size(); }
+  virtual int GetPointerId(size_t pointer_index) const OVERRIDE {
+    DCHECK_LT(pointer_index, pointer_ids_.size());
+    return pointer_ids_[pointer_index];
+  }
+  virtual float GetX(size_t pointer_index) const OVERRIDE {
+    DCHECK_LT(pointer_index, positions_.size());
+    return positions_[pointer_index].x();
+  }
+  virtual float GetY(size_t pointer_index) const OVERRIDE {
+    DCHECK_LT(pointer_index, positions_.size());
+    return positions_[pointer_index].y();
+  }
+  virtual float GetRawX(size_t pointer_index) const OVERRIDE {
+    return GetX(pointer_index) + raw_offsets_[pointer_index].x();
+  }
+  virtual float GetRawY(size_t pointer_index) const OVERRIDE {
+    return GetY(pointer_index) + raw_offsets_[pointer_index].y();
+  }
+  virtual float GetTouchMajor(size_t pointer_index) const OVERRIDE {
+    DCHECK_LT(pointer_index, touch_majors_.size());
+    return touch_majors_[pointer_index];
+  }
+  virtual float GetPressure(size_t pointer_index) const OVERRIDE {
+    DCHECK_LT(pointer_index, pressures_.size());
+    return pressures_[pointer_index];
+  }
+  virtual base::TimeTicks GetEventTime() const OVERRIDE { return time_; }
+  virtual size_t GetHistorySize() const OVERRIDE {
+    return historical_times_.size();
+  }
+  virtual base::TimeTicks GetHistoricalEventTime(
+      size_t historical_index) const OVERRIDE {
+    DCHECK_LT(historical_index, historical_times_.size());
+    return historical_times_[historical_index];
+  }
+  virtual float GetHistoricalTouchMajor(size_t pointer_index,
+                                        size_t historical_index)
+      const OVERRIDE {
+    DCHECK_LT(historical_index, historical_touch_majors_.size());
+    DCHECK_LT(pointer_index, historical_touch_majors_[historical_index].size());
+    return historical_touch_majors_[historical_index][pointer_index];
+  }
+  virtual float GetHistoricalX(size_t pointer_index,
+                               size_t historical_index) const OVERRIDE {
+    DCHECK_LT(historical_index, historical_positions_.size());
+    DCHECK_LT(pointer_index, historical_positions_[historical_index].size());
+    return historical_positions_[historical_index][pointer_index].x();
+  }
+  virtual float GetHistoricalY(size_t pointer_index,
+                               size_t historical_index) const OVERRIDE {
+    DCHECK_LT(historical_index, historical_positions_.size());
+    DCHECK_LT(pointer_index, historical_positions_[historical_index].size());
+    return historical_positions_[historical_index][pointer_index].y();
+  }
+  virtual ToolType GetToolType(size_t pointer_index) const OVERRIDE {
+    DCHECK_LT(pointer_index, tool_types_.size());
+    return tool_types_[pointer_index];
+  }
+  virtual int GetButtonState() const OVERRIDE { return button_state_; }
+
+  virtual scoped_ptr<MotionEvent> Clone() const OVERRIDE {
+    return scoped_ptr<MotionEvent>(new ResampledMotionEvent(*this));
+  }
+  virtual scoped_ptr<MotionEvent> Cancel() const OVERRIDE {
+    scoped_ptr<ResampledMotionEvent> event(new ResampledMotionEvent(*this));
+    event->action_ = ACTION_CANCEL;
+    return event.PassAs<MotionEvent>();
+  }
+
+ private:
+  // Appends each sample of |event| (its own history first, then its current
+  // sample) to the history, remapping pointers to this event's pointer order.
+  void AppendEventToHistory(const MotionEvent& event) {
+    DCHECK_EQ(pointer_ids_.size(), event.GetPointerCount());
+    for (size_t h = 0; h <= event.GetHistorySize(); ++h) {
+      const bool is_current_sample = h == event.GetHistorySize();
+      historical_times_.push_back(is_current_sample
+                                      ? event.GetEventTime()
+                                      : event.GetHistoricalEventTime(h));
+      historical_positions_.push_back(std::vector<gfx::PointF>());
+      historical_touch_majors_.push_back(std::vector<float>());
+      for (size_t i = 0; i < pointer_ids_.size(); ++i) {
+        size_t source_index = FindPointerIndexOfId(event, pointer_ids_[i]);
+        if (is_current_sample) {
+          historical_positions_.back().push_back(gfx::PointF(
+              event.GetX(source_index), event.GetY(source_index)));
+          historical_touch_majors_.back().push_back(
+              event.GetTouchMajor(source_index));
+        } else {
+          historical_positions_.back().push_back(
+              gfx::PointF(event.GetHistoricalX(source_index, h),
+                          event.GetHistoricalY(source_index, h)));
+          historical_touch_majors_.back().push_back(
+              event.GetHistoricalTouchMajor(source_index, h));
+        }
+      }
+    }
+  }
+
+  static size_t FindPointerIndexOfId(const MotionEvent& event, int id) {
+    for (size_t i = 0; i < event.GetPointerCount(); ++i) {
+      if (event.GetPointerId(i) == id)
+        return i;
+    }
+    NOTREACHED() << "Pointer id not found.";
+    return 0;
+  }
+
+  Action action_;
+  const int id_;
+  const int button_state_;
+  const base::TimeTicks time_;
+  const std::vector<gfx::PointF> positions_;
+  std::vector<int> pointer_ids_;
+  std::vector<gfx::PointF> raw_offsets_;
+  std::vector<float> touch_majors_;
+  std::vector<float> pressures_;
+  std::vector<ToolType> tool_types_;
+
+  std::vector<base::TimeTicks> historical_times_;
+  std::vector<std::vector<gfx::PointF> > historical_positions_;
+  std::vector<std::vector<float> > historical_touch_majors_;
+};
+
+// Whether |event0| and |event1| carry the same set of pointers, a
+// precondition for treating them as consecutive samples of one gesture.
+bool HaveSamePointers(const MotionEvent& event0, const MotionEvent& event1) {
+  if (event0.GetPointerCount() != event1.GetPointerCount())
+    return false;
+  for (size_t i = 0; i < event0.GetPointerCount(); ++i) {
+    int pointer_id = event0.GetPointerId(i);
+    bool found = false;
+    for (size_t j = 0; j < event1.GetPointerCount(); ++j) {
+      if (event1.GetPointerId(j) == pointer_id) {
+        found = true;
+        break;
+      }
+    }
+    if (!found)
+      return false;
+  }
+  return true;
+}
+
+size_t FindPointerIndexOfIdIn(const MotionEvent& event, int id) {
+  for (size_t i = 0; i < event.GetPointerCount(); ++i) {
+    if (event.GetPointerId(i) == id)
+      return i;
+  }
+  NOTREACHED() << "Pointer id not found.";
+  return 0;
+}
+
+// Linearly interpolate (or extrapolate, for |alpha| outside [0, 1]) the
+// pointer positions of |event1| against those of |event0|.
+std::vector<gfx::PointF> ResamplePositions(const MotionEvent& event0,
+                                           const MotionEvent& event1,
+                                           float alpha) {
+  std::vector<gfx::PointF> positions;
+  for (size_t i = 0; i < event1.GetPointerCount(); ++i) {
+    size_t index0 = FindPointerIndexOfIdIn(event0, event1.GetPointerId(i));
+    float x = event0.GetX(index0) +
+              (event1.GetX(i) - event0.GetX(index0)) * alpha;
+    float y = event0.GetY(index0) +
+              (event1.GetY(i) - event0.GetY(index0)) * alpha;
+    positions.push_back(gfx::PointF(x, y));
+  }
+  return positions;
+}
+
+}  // namespace
+
+MotionEventBuffer::MotionEventBuffer(MotionEventBufferClient* client,
+                                     bool enable_resampling)
+    : client_(client), resample_(enable_resampling) {
+  DCHECK(client_);
+}
+
+MotionEventBuffer::~MotionEventBuffer() {}
+
+void MotionEventBuffer::OnMotionEvent(const MotionEvent& event) {
+  DCHECK_EQ(0U, event.GetHistorySize());
+  if (event.GetAction() != MotionEvent::ACTION_MOVE ||
+      event.GetToolType(0) != MotionEvent::TOOL_TYPE_FINGER) {
+    FlushWithoutResampling(buffered_events_.Pass());
+    client_->ForwardMotionEvent(event);
+    return;
+  }
+
+  // A change in the pointer set ends the previous sample sequence; resampling
+  // across such a change would blend unrelated pointers.
+  if (!buffered_events_.empty() &&
+      !HaveSamePointers(*buffered_events_.back(), event)) {
+    FlushWithoutResampling(buffered_events_.Pass());
+  }
+
+  buffered_events_.push_back(event.Clone().release());
+  if (buffered_events_.size() == 1)
+    client_->SetNeedsFlush();
+}
+
+void MotionEventBuffer::Flush(base::TimeTicks frame_time) {
+  if (buffered_events_.empty())
+    return;
+
+  if (!resample_) {
+    FlushWithoutResampling(buffered_events_.Pass());
+    return;
+  }
+
+  FlushWithResampling(
+      buffered_events_.Pass(),
+      frame_time - base::TimeDelta::FromMilliseconds(kResampleLatencyMs));
+}
+
+void MotionEventBuffer::FlushWithResampling(ScopedVector<MotionEvent> events,
+                                            base::TimeTicks resample_time) {
+  DCHECK(!events.empty());
+
+  const MotionEvent* event0 = NULL;
+  const MotionEvent* event1 = NULL;
+  size_t last_consumed_index = events.size() - 1;
+  if (events.back()->GetEventTime() <= resample_time) {
+    // The frame time is ahead of the last sample; extrapolate, but never too
+    // far beyond what the sample spacing justifies.
+    if (events.size() < 2) {
+      FlushWithoutResampling(events.Pass());
+      return;
+    }
+    event0 = events[events.size() - 2];
+    event1 = events.back();
+    base::TimeDelta sample_delta =
+        event1->GetEventTime() - event0->GetEventTime();
+    if (sample_delta <
+        base::TimeDelta::FromMilliseconds(kResampleMinDeltaMs)) {
+      FlushWithoutResampling(events.Pass());
+      return;
+    }
+    base::TimeDelta max_prediction = std::min(
+        base::TimeDelta::FromMilliseconds(kResampleMaxPredictionMs),
+        sample_delta / 2);
+    resample_time =
+        std::min(resample_time, event1->GetEventTime() + max_prediction);
+  } else {
+    // The frame time falls within the sample stream; interpolate between the
+    // two samples bracketing it. Samples newer than the resample time remain
+    // buffered for the next frame.
+    if (events.front()->GetEventTime() > resample_time) {
+      FlushWithoutResampling(events.Pass());
+      return;
+    }
+    size_t i = 0;
+    while (i + 1 < events.size() &&
+           events[i + 1]->GetEventTime() <= resample_time) {
+      ++i;
+    }
+    DCHECK_LT(i + 1, events.size());
+    event0 = events[i];
+    event1 = events[i + 1];
+    last_consumed_index = i;
+  }
+
+  DCHECK(event0);
+  DCHECK(event1);
+  const float alpha =
+      (resample_time - event0->GetEventTime()).InMillisecondsF() /
+      (event1->GetEventTime() - event0->GetEventTime()).InMillisecondsF();
+  std::vector<gfx::PointF> positions =
+      ResamplePositions(*event0, *event1, alpha);
+
+  // Consumed events (other than the attribute source) become the history of
+  // the forwarded event, preserving every received sample for the consumer.
+  const MotionEvent& latest = *events[last_consumed_index];
+  ScopedVector<MotionEvent> earlier_events;
+  for (size_t i = 0; i < last_consumed_index; ++i) {
+    earlier_events.push_back(events[i]);
+    events[i] = NULL;
+  }
+  ResampledMotionEvent resampled_event(
+      latest, resample_time, positions, earlier_events);
+  client_->ForwardMotionEvent(resampled_event);
+
+  // Retain any unconsumed events and schedule another flush for them.
+  ScopedVector<MotionEvent> remaining_events;
+  for (size_t i = last_consumed_index + 1; i < events.size(); ++i) {
+    remaining_events.push_back(events[i]);
+    events[i] = NULL;
+  }
+  DCHECK(buffered_events_.empty());
+  buffered_events_ = remaining_events.Pass();
+  if (!buffered_events_.empty())
+    client_->SetNeedsFlush();
+}
+
+void MotionEventBuffer::FlushWithoutResampling(
+    ScopedVector<MotionEvent> events) {
+  for (size_t i = 0; i < events.size(); ++i)
+    client_->ForwardMotionEvent(*events[i]);
+}
+
+}  // namespace ui
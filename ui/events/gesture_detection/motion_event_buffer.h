@@ -0,0 +1,70 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef UI_EVENTS_GESTURE_DETECTION_MOTION_EVENT_BUFFER_H_
+#define UI_EVENTS_GESTURE_DETECTION_MOTION_EVENT_BUFFER_H_
+
+#include "base/basictypes.h"
+#include "base/memory/scoped_vector.h"
+#include "base/time/time.h"
+#include "ui/events/gesture_detection/gesture_detection_export.h"
+
+namespace ui {
+
+class MotionEvent;
+
+// Allows event forwarding and flush requests from a |MotionEventBuffer|.
+class GESTURE_DETECTION_EXPORT MotionEventBufferClient {
+ public:
+  virtual ~MotionEventBufferClient() {}
+  virtual void ForwardMotionEvent(const MotionEvent& event) = 0;
+  virtual void SetNeedsFlush() = 0;
+};
+
+// Utility class for buffering streamed MotionEventVector until a given flush.
+// Events that can be combined will remain buffered, and depending on the flush
+// time and buffered events, a resampled event with history will be synthesized.
+// The synthesized event will never be older than the flush time, and will
+// never be extrapolated beyond a small, fixed window relative to the most
+// recently buffered event time. Events are never delayed by more than a frame,
+// as a buffering client is expected to Flush() once per begin-frame signal.
+class GESTURE_DETECTION_EXPORT MotionEventBuffer {
+ public:
+  // The provided |client| must not be null, and |enable_resampling| determines
+  // resampling behavior (see |resample_|).
+  MotionEventBuffer(MotionEventBufferClient* client, bool enable_resampling);
+  ~MotionEventBuffer();
+
+  // Should be called upon receipt of an event from the platform, prior to
+  // event dispatch to the consumer. Events that can be buffered, i.e., moves
+  // from a touchscreen, are buffered until the next |Flush()|; all other
+  // events flush the buffer and are forwarded immediately.
+  void OnMotionEvent(const MotionEvent& event);
+
+  // Forward any buffered events, resampling if necessary (see |resample_|)
+  // according to |frame_time|. This should be called in response to
+  // |SetNeedsFlush()| calls on the client. If the buffer is empty, no events
+  // will be forwarded.
+  void Flush(base::TimeTicks frame_time);
+
+ private:
+  void FlushWithResampling(ScopedVector<MotionEvent> events,
+                           base::TimeTicks resample_time);
+  void FlushWithoutResampling(ScopedVector<MotionEvent> events);
+
+  MotionEventBufferClient* const client_;
+  ScopedVector<MotionEvent> buffered_events_;
+
+  // Whether buffered events should be resampled upon |Flush()|. If true, the
+  // synthesized, flushed event will be resampled from the buffered events,
+  // mirroring the resampling behavior of Android's Choreographer-driven
+  // input pipeline.
+  const bool resample_;
+
+  DISALLOW_COPY_AND_ASSIGN(MotionEventBuffer);
+};
+
+}  // namespace ui
+
+#endif  // UI_EVENTS_GESTURE_DETECTION_MOTION_EVENT_BUFFER_H_
@@ -0,0 +1,201 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ui/events/gesture_detection/motion_event_buffer.h"
+
+#include "base/memory/scoped_vector.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "ui/events/gesture_detection/motion_event.h"
+#include "ui/events/test/mock_motion_event.h"
+
+using base::TimeDelta;
+using base::TimeTicks;
+using ui::test::MockMotionEvent;
+
+namespace ui {
+
+class MotionEventBufferTest : public testing::Test,
+                              public MotionEventBufferClient {
+ public:
+  MotionEventBufferTest() : needs_flush_count_(0) {}
+  virtual ~MotionEventBufferTest() {}
+
+  // MotionEventBufferClient implementation.
+  virtual void ForwardMotionEvent(const MotionEvent& event) OVERRIDE {
+    forwarded_events_.push_back(event.Clone().release());
+  }
+
+  virtual void SetNeedsFlush() OVERRIDE { ++needs_flush_count_; }
+
+ protected:
+  static MockMotionEvent MoveEvent(TimeTicks time, float x, float y) {
+    MockMotionEvent move(MotionEvent::ACTION_MOVE, time, x, y);
+    move.SetToolType(0, MotionEvent::TOOL_TYPE_FINGER);
+    return move;
+  }
+
+  size_t GetAndResetNeedsFlushCount() {
+    size_t count = needs_flush_count_;
+    needs_flush_count_ = 0;
+    return count;
+  }
+
+  ScopedVector<MotionEvent> GetAndResetForwardedEvents() {
+    return forwarded_events_.Pass();
+  }
+
+  ScopedVector<MotionEvent> forwarded_events_;
+  size_t needs_flush_count_;
+};
+
+TEST_F(MotionEventBufferTest, MovesBufferedUntilFlush) {
+  MotionEventBuffer buffer(this, true);
+  TimeTicks time = TimeTicks::Now();
+
+  buffer.OnMotionEvent(MoveEvent(time, 1.f, 1.f));
+  EXPECT_TRUE(forwarded_events_.empty());
+  EXPECT_EQ(1U, GetAndResetNeedsFlushCount());
+
+  // Subsequent moves should not request another flush.
+  buffer.OnMotionEvent(
+      MoveEvent(time + TimeDelta::FromMilliseconds(5), 2.f, 2.f));
+  EXPECT_TRUE(forwarded_events_.empty());
+  EXPECT_EQ(0U, GetAndResetNeedsFlushCount());
+
+  buffer.Flush(time + TimeDelta::FromMilliseconds(10));
+  ScopedVector<MotionEvent> events = GetAndResetForwardedEvents();
+  ASSERT_EQ(1U, events.size());
+  EXPECT_EQ(MotionEvent::ACTION_MOVE, events.front()->GetAction());
+}
+
+TEST_F(MotionEventBufferTest, NonMoveEventsFlushBufferAndForwardImmediately) {
+  MotionEventBuffer buffer(this, true);
+  TimeTicks time = TimeTicks::Now();
+
+  buffer.OnMotionEvent(MoveEvent(time, 1.f, 1.f));
+  EXPECT_TRUE(forwarded_events_.empty());
+
+  MockMotionEvent up(MotionEvent::ACTION_UP,
+                     time + TimeDelta::FromMilliseconds(5), 1.f, 1.f);
+  up.SetToolType(0, MotionEvent::TOOL_TYPE_FINGER);
+  buffer.OnMotionEvent(up);
+
+  // The buffered move is forwarded ahead of the up to preserve ordering.
+  ScopedVector<MotionEvent> events = GetAndResetForwardedEvents();
+  ASSERT_EQ(2U, events.size());
+  EXPECT_EQ(MotionEvent::ACTION_MOVE, events[0]->GetAction());
+  EXPECT_EQ(MotionEvent::ACTION_UP, events[1]->GetAction());
+
+  // A flush after the buffer was emptied forwards nothing.
+  buffer.Flush(time + TimeDelta::FromMilliseconds(10));
+  EXPECT_TRUE(forwarded_events_.empty());
+}
+
+TEST_F(MotionEventBufferTest, FlushInterpolatesBetweenSamples) {
+  MotionEventBuffer buffer(this, true);
+  TimeTicks time = TimeTicks::Now();
+
+  buffer.OnMotionEvent(MoveEvent(time, 0.f, 0.f));
+  buffer.OnMotionEvent(
+      MoveEvent(time + TimeDelta::FromMilliseconds(20), 20.f, 40.f));
+  GetAndResetNeedsFlushCount();
+
+  // The resample time (frame time less the resample latency) lands exactly
+  // between the two samples.
+  buffer.Flush(time + TimeDelta::FromMilliseconds(15));
+  ScopedVector<MotionEvent> events = GetAndResetForwardedEvents();
+  ASSERT_EQ(1U, events.size());
+  EXPECT_EQ(time + TimeDelta::FromMilliseconds(10),
+            events.front()->GetEventTime());
+  EXPECT_FLOAT_EQ(10.f, events.front()->GetX());
+  EXPECT_FLOAT_EQ(20.f, events.front()->GetY());
+
+  // The newer sample was not consumed; it remains buffered for the next
+  // frame, and another flush has been requested for it.
+  EXPECT_EQ(1U, GetAndResetNeedsFlushCount());
+  buffer.Flush(time + TimeDelta::FromMilliseconds(40));
+  events = GetAndResetForwardedEvents();
+  ASSERT_EQ(1U, events.size());
+  EXPECT_FLOAT_EQ(20.f, events.front()->GetX());
+  EXPECT_FLOAT_EQ(40.f, events.front()->GetY());
+}
+
+TEST_F(MotionEventBufferTest, FlushExtrapolatesBeyondLastSample) {
+  MotionEventBuffer buffer(this, true);
+  TimeTicks time = TimeTicks::Now();
+
+  buffer.OnMotionEvent(MoveEvent(time, 0.f, 0.f));
+  buffer.OnMotionEvent(
+      MoveEvent(time + TimeDelta::FromMilliseconds(10), 10.f, 10.f));
+  GetAndResetNeedsFlushCount();
+
+  // The resample time trails the frame time by the resample latency, here
+  // 20ms past the last sample; prediction is capped at half the sample
+  // delta (5ms), yielding a sample extrapolated to t+15ms.
+  buffer.Flush(time + TimeDelta::FromMilliseconds(35));
+  ScopedVector<MotionEvent> events = GetAndResetForwardedEvents();
+  ASSERT_EQ(1U, events.size());
+  EXPECT_EQ(time + TimeDelta::FromMilliseconds(15),
+            events.front()->GetEventTime());
+  EXPECT_FLOAT_EQ(15.f, events.front()->GetX());
+  EXPECT_FLOAT_EQ(15.f, events.front()->GetY());
+
+  // Both real samples are preserved as history on the resampled event.
+  ASSERT_EQ(2U, events.front()->GetHistorySize());
+  EXPECT_EQ(time, events.front()->GetHistoricalEventTime(0));
+  EXPECT_FLOAT_EQ(0.f, events.front()->GetHistoricalX(0, 0));
+  EXPECT_EQ(time + TimeDelta::FromMilliseconds(10),
+            events.front()->GetHistoricalEventTime(1));
+  EXPECT_FLOAT_EQ(10.f, events.front()->GetHistoricalX(0, 1));
+
+  EXPECT_EQ(0U, GetAndResetNeedsFlushCount());
+}
+
+TEST_F(MotionEventBufferTest, FlushWithoutResampling) {
+  MotionEventBuffer buffer(this, false);
+  TimeTicks time = TimeTicks::Now();
+
+  buffer.OnMotionEvent(MoveEvent(time, 1.f, 1.f));
+  buffer.OnMotionEvent(
+      MoveEvent(time + TimeDelta::FromMilliseconds(5), 2.f, 2.f));
+
+  // With resampling disabled the buffered events are forwarded untouched.
+  buffer.Flush(time + TimeDelta::FromMilliseconds(10));
+  ScopedVector<MotionEvent> events = GetAndResetForwardedEvents();
+  ASSERT_EQ(2U, events.size());
+  EXPECT_FLOAT_EQ(1.f, events[0]->GetX());
+  EXPECT_EQ(time, events[0]->GetEventTime());
+  EXPECT_FLOAT_EQ(2.f, events[1]->GetX());
+  EXPECT_EQ(time + TimeDelta::FromMilliseconds(5), events[1]->GetEventTime());
+}
+
+TEST_F(MotionEventBufferTest, PointerCountChangeFlushesBufferedMoves) {
+  MotionEventBuffer buffer(this, true);
+  TimeTicks time = TimeTicks::Now();
+
+  buffer.OnMotionEvent(MoveEvent(time, 1.f, 1.f));
+
+  MockMotionEvent two_finger_move(MotionEvent::ACTION_MOVE,
+                                  time + TimeDelta::FromMilliseconds(5),
+                                  2.f,
+                                  2.f,
+                                  3.f,
+                                  3.f);
+  two_finger_move.SetToolType(0, MotionEvent::TOOL_TYPE_FINGER);
+  two_finger_move.SetToolType(1, MotionEvent::TOOL_TYPE_FINGER);
+  buffer.OnMotionEvent(two_finger_move);
+
+  // The single-pointer move cannot be combined with the two-pointer move and
+  // is forwarded immediately; the two-pointer move remains buffered.
+  ScopedVector<MotionEvent> events = GetAndResetForwardedEvents();
+  ASSERT_EQ(1U, events.size());
+  EXPECT_EQ(1U, events.front()->GetPointerCount());
+
+  buffer.Flush(time + TimeDelta::FromMilliseconds(10));
+  events = GetAndResetForwardedEvents();
+  ASSERT_EQ(1U, events.size());
+  EXPECT_EQ(2U, events.front()->GetPointerCount());
+}
+
+}  // namespace ui
@@ -9,6 +9,7 @@
 
 #include "ui/gfx/text_elider.h"
 
+#include <map>
 #include <string>
 #include <vector>
 
@@ -525,6 +526,14 @@ class RectangleText {
   // Set the current position to the beginning of the next line.
   bool NewLine();
 
+  // Returns the width of |text|, consulting (and filling) |width_cache_|
+  // before measuring. Wrapping measures the same strings repeatedly - each
+  // word is measured once trimmed and once as-is, and words commonly recur
+  // within a block of text - while every measurement builds a full text
+  // layout, so caching widths for the duration of one elide operation saves
+  // most of that work.
+  float GetCachedStringWidth(const base::string16& text);
+
   // The font list used for measuring text width.
   const FontList& font_list_;
 
@@ -562,6 +571,10 @@ class RectangleText {
   // Indicates whether there were too many lines for the available height.
   bool insufficient_height_;
 
+  // Measured string widths, keyed by string. Only valid for the lifetime of
+  // this elide operation; see GetCachedStringWidth().
+  std::map<base::string16, float> width_cache_;
+
   DISALLOW_COPY_AND_ASSIGN(RectangleText);
 };
 
@@ -599,7 +612,7 @@ int RectangleText::Finalize() {
 }
 
 void RectangleText::AddLine(const base::string16& line) {
-  const float line_width = GetStringWidthF(line, font_list_);
+  const float line_width = GetCachedStringWidth(line);
   if (line_width <= available_pixel_width_) {
     AddToCurrentLineWithWidth(line, line_width);
   } else {
@@ -686,7 +699,7 @@ int RectangleText::AddWord(const base::string16& word) {
   int lines_added = 0;
   base::string16 trimmed;
   base::TrimWhitespace(word, base::TRIM_TRAILING, &trimmed);
-  const float trimmed_width = GetStringWidthF(trimmed, font_list_);
+  const float trimmed_width = GetCachedStringWidth(trimmed);
   if (trimmed_width <= available_pixel_width_) {
     // Word can be made to fit, no need to fragment it.
     if ((current_width_ + trimmed_width > available_pixel_width_) && NewLine())
@@ -701,7 +714,16 @@ int RectangleText::AddWord(const base::string16& word) {
 }
 
 void RectangleText::AddToCurrentLine(const base::string16& text) {
-  AddToCurrentLineWithWidth(text, GetStringWidthF(text, font_list_));
+  AddToCurrentLineWithWidth(text, GetCachedStringWidth(text));
+}
+
+float RectangleText::GetCachedStringWidth(const base::string16& text) {
+  std::map<base::string16, float>::const_iterator it = width_cache_.find(text);
+  if (it != width_cache_.end())
+    return it->second;
+  const float width = GetStringWidthF(text, font_list_);
+  width_cache_[text] = width;
+  return width;
 }
 
 void RectangleText::AddToCurrentLineWithWidth(const base::string16& text,
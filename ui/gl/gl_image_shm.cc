@@ -21,6 +21,7 @@ bool ValidFormat(unsigned internalformat) {
   switch (internalformat) {
     case GL_BGRA8_EXT:
     case GL_RGBA8_OES:
+    case GL_RGBA4:
       return true;
     default:
       return false;
@@ -32,6 +33,7 @@ GLenum TextureFormat(unsigned internalformat) {
     case GL_BGRA8_EXT:
       return GL_BGRA_EXT;
     case GL_RGBA8_OES:
+    case GL_RGBA4:
       return GL_RGBA;
     default:
       NOTREACHED();
@@ -48,6 +50,8 @@ GLenum DataType(unsigned internalformat) {
     case GL_BGRA8_EXT:
     case GL_RGBA8_OES:
       return GL_UNSIGNED_BYTE;
+    case GL_RGBA4:
+      return GL_UNSIGNED_SHORT_4_4_4_4;
     default:
       NOTREACHED();
       return 0;
@@ -59,6 +63,8 @@ GLenum BytesPerPixel(unsigned internalformat) {
     case GL_BGRA8_EXT:
     case GL_RGBA8_OES:
       return 4;
+    case GL_RGBA4:
+      return 2;
     default:
       NOTREACHED();
       return 0;
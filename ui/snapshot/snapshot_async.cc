@@ -27,11 +27,14 @@ void OnFrameScalingFinished(const GrabWindowSnapshotAsyncCallback& callback,
 
 SkBitmap ScaleBitmap(const SkBitmap& input_bitmap,
                      const gfx::Size& target_size) {
-  return skia::ImageOperations::Resize(input_bitmap,
-                                       skia::ImageOperations::RESIZE_GOOD,
-                                       target_size.width(),
-                                       target_size.height(),
-                                       static_cast<SkBitmap::Allocator*>(NULL));
+  // This runs on a background task runner, so it is fine to block on the
+  // banded parallel resize for large snapshots.
+  return skia::ImageOperations::ResizeParallel(
+      input_bitmap,
+      skia::ImageOperations::RESIZE_GOOD,
+      target_size.width(),
+      target_size.height(),
+      static_cast<SkBitmap::Allocator*>(NULL));
 }
 
 scoped_refptr<base::RefCountedBytes> EncodeBitmap(const SkBitmap& bitmap) {
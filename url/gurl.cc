@@ -14,6 +14,7 @@
 #include "url/gurl.h"
 
 #include "base/logging.h"
+#include "url/url_canon_cache.h"
 #include "url/url_canon_stdstring.h"
 #include "url/url_util.h"
 
@@ -75,7 +76,14 @@ GURL::GURL(const GURL& other)
 }
 
 GURL::GURL(const std::string& url_string) {
+  // Cached entries never include filesystem URLs, so a hit needs no
+  // inner_url_.
+  if (url::FindCachedCanonicalization(url_string, &spec_, &parsed_,
+                                      &is_valid_))
+    return;
   InitCanonical(url_string, true);
+  if (!inner_url_)
+    url::CacheCanonicalization(url_string, spec_, parsed_, is_valid_);
 }
 
 GURL::GURL(const base::string16& url_string) {
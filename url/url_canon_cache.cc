@@ -0,0 +1,99 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "url/url_canon_cache.h"
+
+#include "base/containers/hash_tables.h"
+#include "base/hash.h"
+#include "base/lazy_instance.h"
+#include "base/synchronization/lock.h"
+
+namespace url {
+
+namespace {
+
+// The cache is split into independently locked shards so that threads
+// resolving different URLs rarely contend on the same lock.
+const size_t kNumShards = 8;
+
+// When a shard fills up it is simply cleared. Entries are cheap to recompute,
+// so this is preferable to maintaining any eviction ordering.
+const size_t kMaxEntriesPerShard = 128;
+
+// Specs longer than this are not cached; they are rare and would make the
+// cache footprint unpredictable.
+const size_t kMaxCacheableSpecLength = 2048;
+
+struct CacheEntry {
+  std::string canonical_spec;
+  Parsed parsed;
+  bool is_valid;
+};
+
+typedef base::hash_map<std::string, CacheEntry> ShardMap;
+
+struct Shard {
+  base::Lock lock;
+  ShardMap entries;
+};
+
+struct CacheShards {
+  Shard shards[kNumShards];
+};
+
+base::LazyInstance<CacheShards>::Leaky g_canon_cache = LAZY_INSTANCE_INITIALIZER;
+
+Shard* ShardForSpec(const std::string& spec) {
+  return &g_canon_cache.Get().shards[base::Hash(spec) % kNumShards];
+}
+
+}  // namespace
+
+bool FindCachedCanonicalization(const std::string& spec,
+                                std::string* canonical_spec,
+                                Parsed* parsed,
+                                bool* is_valid) {
+  if (spec.length() > kMaxCacheableSpecLength)
+    return false;
+  Shard* shard = ShardForSpec(spec);
+  base::AutoLock lock(shard->lock);
+  ShardMap::const_iterator found = shard->entries.find(spec);
+  if (found == shard->entries.end())
+    return false;
+  canonical_spec->assign(found->second.canonical_spec);
+  *parsed = found->second.parsed;
+  *is_valid = found->second.is_valid;
+  return true;
+}
+
+void CacheCanonicalization(const std::string& spec,
+                           const std::string& canonical_spec,
+                           const Parsed& parsed,
+                           bool is_valid) {
+  if (spec.length() > kMaxCacheableSpecLength)
+    return;
+  // A Parsed with an inner parse owns heap state and callers build a nested
+  // GURL from it; keeping those out of the cache keeps hits trivially
+  // copyable.
+  if (parsed.inner_parsed())
+    return;
+  Shard* shard = ShardForSpec(spec);
+  base::AutoLock lock(shard->lock);
+  if (shard->entries.size() >= kMaxEntriesPerShard)
+    shard->entries.clear();
+  CacheEntry& entry = shard->entries[spec];
+  entry.canonical_spec = canonical_spec;
+  entry.parsed = parsed;
+  entry.is_valid = is_valid;
+}
+
+void ClearCanonicalizationCache() {
+  CacheShards& cache = g_canon_cache.Get();
+  for (size_t i = 0; i < kNumShards; ++i) {
+    base::AutoLock lock(cache.shards[i].lock);
+    cache.shards[i].entries.clear();
+  }
+}
+
+}  // namespace url
@@ -0,0 +1,40 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef URL_URL_CANON_CACHE_H_
+#define URL_URL_CANON_CACHE_H_
+
+#include <string>
+
+#include "url/url_export.h"
+#include "url/url_parse.h"
+
+namespace url {
+
+// A small, sharded, process-wide cache mapping URL strings to the result of
+// canonicalizing them. GURL construction consults the cache before running
+// the canonicalizer, so code that parses the same spec repeatedly (history,
+// bookmarks and the omnibox all do this) pays for a hash lookup and a string
+// copy instead of a full parse.
+
+// Looks up |spec|. On a hit, copies the cached canonical spec, parse
+// structure and validity into the out parameters and returns true.
+URL_EXPORT bool FindCachedCanonicalization(const std::string& spec,
+                                           std::string* canonical_spec,
+                                           Parsed* parsed,
+                                           bool* is_valid);
+
+// Records the canonicalization result for |spec|. Over-long specs and
+// results that carry an inner parse (filesystem URLs) are silently dropped.
+URL_EXPORT void CacheCanonicalization(const std::string& spec,
+                                      const std::string& canonical_spec,
+                                      const Parsed& parsed,
+                                      bool is_valid);
+
+// Removes all cached entries. Mainly for tests.
+URL_EXPORT void ClearCanonicalizationCache();
+
+}  // namespace url
+
+#endif  // URL_URL_CANON_CACHE_H_
@@ -0,0 +1,115 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+#include "url/url_canon_cache.h"
+#include "url/url_parse.h"
+
+namespace url {
+
+TEST(URLCanonCacheTest, MissThenHit) {
+  ClearCanonicalizationCache();
+
+  const std::string spec("HTTP://Example.Com/Path?q=1");
+  std::string canonical;
+  Parsed parsed;
+  bool is_valid = false;
+  EXPECT_FALSE(
+      FindCachedCanonicalization(spec, &canonical, &parsed, &is_valid));
+
+  Parsed stored_parsed;
+  stored_parsed.scheme = Component(0, 4);
+  stored_parsed.host = Component(7, 11);
+  CacheCanonicalization(spec, "http://example.com/Path?q=1", stored_parsed,
+                        true);
+
+  EXPECT_TRUE(
+      FindCachedCanonicalization(spec, &canonical, &parsed, &is_valid));
+  EXPECT_EQ("http://example.com/Path?q=1", canonical);
+  EXPECT_TRUE(parsed.scheme == Component(0, 4));
+  EXPECT_TRUE(parsed.host == Component(7, 11));
+  EXPECT_TRUE(is_valid);
+
+  ClearCanonicalizationCache();
+  EXPECT_FALSE(
+      FindCachedCanonicalization(spec, &canonical, &parsed, &is_valid));
+}
+
+TEST(URLCanonCacheTest, CachesInvalidResults) {
+  ClearCanonicalizationCache();
+
+  const std::string spec("http://%00/");
+  CacheCanonicalization(spec, "http://%00/", Parsed(), false);
+
+  std::string canonical;
+  Parsed parsed;
+  bool is_valid = true;
+  EXPECT_TRUE(
+      FindCachedCanonicalization(spec, &canonical, &parsed, &is_valid));
+  EXPECT_FALSE(is_valid);
+
+  ClearCanonicalizationCache();
+}
+
+TEST(URLCanonCacheTest, SkipsInnerParsedAndLongSpecs) {
+  ClearCanonicalizationCache();
+
+  // A result carrying an inner parse must not be stored.
+  Parsed with_inner;
+  with_inner.set_inner_parsed(Parsed());
+  CacheCanonicalization("filesystem:http://a/t/", "filesystem:http://a/t/",
+                        with_inner, true);
+
+  std::string canonical;
+  Parsed parsed;
+  bool is_valid = false;
+  EXPECT_FALSE(FindCachedCanonicalization("filesystem:http://a/t/",
+                                          &canonical, &parsed, &is_valid));
+
+  // Over-long specs are neither stored nor looked up.
+  std::string long_spec("http://example.com/");
+  long_spec.append(4096, 'a');
+  CacheCanonicalization(long_spec, long_spec, Parsed(), true);
+  EXPECT_FALSE(
+      FindCachedCanonicalization(long_spec, &canonical, &parsed, &is_valid));
+
+  ClearCanonicalizationCache();
+}
+
+TEST(URLCanonCacheTest, GURLHitMatchesUncachedConstruction) {
+  ClearCanonicalizationCache();
+
+  const std::string spec("HTTP://Example.Com:80/Some%20Path?q=1#ref");
+
+  // The first construction misses the cache and populates it; the second is
+  // served from the cache. Both must be identical.
+  GURL first(spec);
+  GURL second(spec);
+  EXPECT_TRUE(first.is_valid());
+  EXPECT_EQ(first.spec(), second.spec());
+  EXPECT_EQ(first.scheme(), second.scheme());
+  EXPECT_EQ(first.host(), second.host());
+  EXPECT_EQ(first.EffectiveIntPort(), second.EffectiveIntPort());
+  EXPECT_EQ(first.path(), second.path());
+  EXPECT_EQ(first.query(), second.query());
+  EXPECT_EQ(first.ref(), second.ref());
+
+  // Invalid URLs round-trip through the cache too.
+  GURL bad1("http://?k=v");
+  GURL bad2("http://?k=v");
+  EXPECT_FALSE(bad1.is_valid());
+  EXPECT_EQ(bad1.is_valid(), bad2.is_valid());
+
+  // Filesystem URLs bypass the cache and always get an inner URL.
+  GURL fs1("filesystem:http://example.com/temporary/f.txt");
+  GURL fs2("filesystem:http://example.com/temporary/f.txt");
+  ASSERT_TRUE(fs1.inner_url());
+  ASSERT_TRUE(fs2.inner_url());
+  EXPECT_EQ(*fs1.inner_url(), *fs2.inner_url());
+
+  ClearCanonicalizationCache();
+}
+
+}  // namespace url
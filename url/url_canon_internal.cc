@@ -11,6 +11,14 @@
 #include <string>
 
 #include "base/strings/utf_string_conversion_utils.h"
+#include "build/build_config.h"
+
+#if defined(ARCH_CPU_X86_FAMILY)
+// SSE2 is part of the minimum x86 spec, so it can be used unconditionally.
+#include <emmintrin.h>
+#elif defined(__ARM_NEON__)
+#include <arm_neon.h>
+#endif
 
 namespace url {
 
@@ -247,6 +255,82 @@ void AppendStringOfType(const base::char16* source, int length,
       source, length, type, output);
 }
 
+int FindRunOfOrdinaryChars(const char* spec,
+                           int begin,
+                           int end,
+                           char min_char,
+                           char max_char,
+                           const char* excluded,
+                           int num_excluded) {
+  int i = begin;
+
+#if defined(ARCH_CPU_X86_FAMILY)
+  // The clean ranges the callers use lie entirely below 0x80, so signed
+  // byte comparisons are sufficient: bytes with the high bit set compare as
+  // negative and fail the |min128| check.
+  const __m128i min128 = _mm_set1_epi8(min_char);
+  const __m128i max128 = _mm_set1_epi8(max_char);
+  __m128i excluded128[16];
+  DCHECK_LE(num_excluded, 16);
+  for (int e = 0; e < num_excluded; e++)
+    excluded128[e] = _mm_set1_epi8(excluded[e]);
+
+  while (i + 16 <= end) {
+    __m128i chunk =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(spec + i));
+    __m128i stop = _mm_or_si128(_mm_cmplt_epi8(chunk, min128),
+                                _mm_cmpgt_epi8(chunk, max128));
+    for (int e = 0; e < num_excluded; e++)
+      stop = _mm_or_si128(stop, _mm_cmpeq_epi8(chunk, excluded128[e]));
+    if (_mm_movemask_epi8(stop)) {
+      // Some byte in this block ends the run; the scalar loop below will
+      // find it within at most 16 characters.
+      break;
+    }
+    i += 16;
+  }
+#elif defined(__ARM_NEON__)
+  const uint8x16_t min128 = vdupq_n_u8(static_cast<uint8_t>(min_char));
+  const uint8x16_t max128 = vdupq_n_u8(static_cast<uint8_t>(max_char));
+  uint8x16_t excluded128[16];
+  DCHECK_LE(num_excluded, 16);
+  for (int e = 0; e < num_excluded; e++)
+    excluded128[e] = vdupq_n_u8(static_cast<uint8_t>(excluded[e]));
+
+  while (i + 16 <= end) {
+    uint8x16_t chunk =
+        vld1q_u8(reinterpret_cast<const uint8_t*>(spec + i));
+    uint8x16_t stop = vorrq_u8(vcltq_u8(chunk, min128),
+                               vcgtq_u8(chunk, max128));
+    for (int e = 0; e < num_excluded; e++)
+      stop = vorrq_u8(stop, vceqq_u8(chunk, excluded128[e]));
+    uint64x2_t stop64 = vreinterpretq_u64_u8(stop);
+    if (vgetq_lane_u64(stop64, 0) | vgetq_lane_u64(stop64, 1))
+      break;
+    i += 16;
+  }
+#endif
+
+  // Scalar scan; also finishes the trailing partial block and locates the
+  // exact end of the run when a vector block above contained a stop byte.
+  for (; i < end; i++) {
+    unsigned char ch = static_cast<unsigned char>(spec[i]);
+    if (ch < static_cast<unsigned char>(min_char) ||
+        ch > static_cast<unsigned char>(max_char))
+      break;
+    bool is_excluded = false;
+    for (int e = 0; e < num_excluded; e++) {
+      if (spec[i] == excluded[e]) {
+        is_excluded = true;
+        break;
+      }
+    }
+    if (is_excluded)
+      break;
+  }
+  return i - begin;
+}
+
 bool ReadUTFChar(const char* str, int* begin, int length,
                  unsigned* code_point_out) {
   // This depends on ints and int32s being the same thing.  If they're not, it
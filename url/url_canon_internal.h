@@ -77,6 +77,20 @@ inline bool IsComponentChar(unsigned char c) {
 void AppendStringOfType(const char* source, int length,
                         SharedCharTypes type,
                         CanonOutput* output);
+
+// Returns the length of the run of characters starting at |spec[begin]| and
+// bounded by |end| in which every byte lies in the inclusive range
+// [min_char, max_char] and is none of the |num_excluded| bytes in |excluded|.
+// The canonicalizers use this to find runs of characters that need no
+// escaping or other special handling so they can be copied to the output in
+// one shot; on x86 and NEON the scan checks 16 bytes per iteration.
+URL_EXPORT int FindRunOfOrdinaryChars(const char* spec,
+                                      int begin,
+                                      int end,
+                                      char min_char,
+                                      char max_char,
+                                      const char* excluded,
+                                      int num_excluded);
 void AppendStringOfType(const base::char16* source, int length,
                         SharedCharTypes type,
                         CanonOutput* output);
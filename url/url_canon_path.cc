@@ -75,6 +75,13 @@ const unsigned char kPathCharLookup[0x100] = {
      ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,
      ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE};
 
+// The printable ASCII characters whose entry in kPathCharLookup is not plain
+// PASS or UNESCAPE. FindRunOfOrdinaryChars stops on these (and on anything
+// outside [0x21, 0x7e]), so every character in the run it returns is one the
+// loop below would copy to the output unchanged.
+const char kPathRunStopChars[] = {
+    '"', '#', '%', '.', '<', '>', '?', '\\', '^', '`', '{', '|', '}'};
+
 enum DotDisposition {
   // The given dot is just part of a filename and is not special.
   NOT_A_DIRECTORY,
@@ -285,8 +292,19 @@ bool DoPartialPath(const CHAR* spec,
           AppendEscapedChar(out_ch, output);
         }
       } else {
-        // Nothing special about this character, just append it.
-        output->push_back(out_ch);
+        // Nothing special about this character. 8-bit input tends to sit in
+        // long runs of such characters, so find the end of the run and copy
+        // it in one shot rather than byte-at-a-time.
+        if (sizeof(CHAR) == 1) {
+          const char* spec8 = reinterpret_cast<const char*>(spec);
+          int run_len = FindRunOfOrdinaryChars(
+              spec8, i, end, 0x21, 0x7e,
+              kPathRunStopChars, arraysize(kPathRunStopChars));
+          output->Append(spec8 + i, run_len);
+          i += run_len - 1;
+        } else {
+          output->push_back(out_ch);
+        }
       }
     }
   }
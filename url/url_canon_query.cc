@@ -55,14 +55,34 @@ bool IsAllASCII(const CHAR* spec, const Component& query) {
 // match the given |type| in SharedCharTypes. This version will accept 8 or 16
 // bit characters, but assumes that they have only 7-bit values. It also assumes
 // that all UTF-8 values are correct, so doesn't bother checking
+// The printable ASCII characters for which IsQueryChar is false.
+// FindRunOfOrdinaryChars stops on these (and on anything outside
+// [0x21, 0x7e]), so every character in the run it returns passes IsQueryChar.
+const char kQueryRunStopChars[] = {'"', '#', '\'', '<', '>'};
+
 template<typename CHAR>
 void AppendRaw8BitQueryString(const CHAR* source, int length,
                               CanonOutput* output) {
-  for (int i = 0; i < length; i++) {
+  int i = 0;
+  while (i < length) {
+    // The common case is a long run of characters needing no escaping; for
+    // 8-bit input, find the whole run and copy it in one shot.
+    if (sizeof(CHAR) == 1) {
+      const char* source8 = reinterpret_cast<const char*>(source);
+      int run_len = FindRunOfOrdinaryChars(
+          source8, i, length, 0x21, 0x7e,
+          kQueryRunStopChars, arraysize(kQueryRunStopChars));
+      if (run_len > 0) {
+        output->Append(source8 + i, run_len);
+        i += run_len;
+        continue;
+      }
+    }
     if (!IsQueryChar(static_cast<unsigned char>(source[i])))
       AppendEscapedChar(static_cast<unsigned char>(source[i]), output);
     else  // Doesn't need escaping.
       output->push_back(static_cast<char>(source[i]));
+    i++;
   }
 }
 
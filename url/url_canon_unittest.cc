@@ -110,6 +110,35 @@ void SetupReplComp(
 
 }  // namespace
 
+TEST(URLCanonTest, FindRunOfOrdinaryChars) {
+  const char kExcluded[] = {'.', '%'};
+  const int kNumExcluded = 2;
+
+  // Every start offset of a string that mixes clean runs (long enough to
+  // exercise the 16-bytes-at-a-time scan) with range and exclusion stops.
+  const char kInput[] =
+      "abcdefghijklmnopqrstuvwxyz.0123456789ABCDEFGHIJKLMNOP%qq aa\x80zz\x01";
+  int len = static_cast<int>(strlen(kInput));
+  for (int begin = 0; begin < len; begin++) {
+    // Compute the expected run length the simple way.
+    int expected = 0;
+    for (int i = begin; i < len; i++, expected++) {
+      unsigned char ch = static_cast<unsigned char>(kInput[i]);
+      if (ch < 0x21 || ch > 0x7e || ch == '.' || ch == '%')
+        break;
+    }
+    EXPECT_EQ(expected,
+              FindRunOfOrdinaryChars(kInput, begin, len, 0x21, 0x7e,
+                                     kExcluded, kNumExcluded)) << begin;
+  }
+
+  // Runs are bounded by |end| even when more clean characters follow.
+  const char kClean[] = "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa";
+  EXPECT_EQ(7, FindRunOfOrdinaryChars(kClean, 0, 7, 0x21, 0x7e, NULL, 0));
+  EXPECT_EQ(0, FindRunOfOrdinaryChars(kClean, 5, 5, 0x21, 0x7e, NULL, 0));
+  EXPECT_EQ(33, FindRunOfOrdinaryChars(kClean, 3, 36, 0x21, 0x7e, NULL, 0));
+}
+
 TEST(URLCanonTest, DoAppendUTF8) {
   struct UTF8Case {
     unsigned input;
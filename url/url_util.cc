@@ -352,6 +352,131 @@ bool DoReplaceComponents(const char* spec,
   return ReplacePathURL(spec, parsed, replacements, output, out_parsed);
 }
 
+// Returns true for characters the path canonicalizer copies through
+// unchanged; see kPathCharLookup in url_canon_path.cc.  '.' and '%' are
+// deliberately excluded: dots may start a directory-navigation segment and
+// percents may start an escape sequence, both of which need the full
+// canonicalizer.
+bool IsCanonicalPathChar(unsigned char c) {
+  if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+      (c >= '0' && c <= '9'))
+    return true;
+  switch (c) {
+    case '!': case '$': case '&': case '\'': case '(': case ')':
+    case '*': case '+': case ',': case '-': case '/': case ':':
+    case ';': case '=': case '@': case '[': case ']': case '_':
+    case '~':
+      return true;
+  }
+  return false;
+}
+
+// Fast path for URLs that are already in canonical form.
+//
+// The browser repeatedly canonicalizes specs that are themselves the output
+// of canonicalization - URLs round-tripped through history, bookmarks or the
+// network stack - and the full pipeline is expensive.  This detects a
+// conservative subset of canonical ASCII http and https URLs; when it
+// returns true the spec has been appended to |output| unchanged and
+// |*output_parsed| has been filled in.  Returning false implies nothing
+// about validity; the caller must run the full pipeline.
+//
+// URLs with user info, ports, refs, escapes, dot segments, or hosts that
+// could parse as IP addresses all take the slow path.
+bool DoFastPathCanonicalizeHttpURL(const char* spec,
+                                   int spec_len,
+                                   CanonOutput* output,
+                                   Parsed* output_parsed) {
+  // Scheme must be lower-case http or https, already followed by "://".
+  int scheme_len;
+  if (spec_len > 7 && !memcmp(spec, "http://", 7))
+    scheme_len = 4;
+  else if (spec_len > 8 && !memcmp(spec, "https://", 8))
+    scheme_len = 5;
+  else
+    return false;
+
+  // Host may contain lower-case letters, digits, '-' and '.', with no empty
+  // labels.  Anything else - including ':' and '@', so ports and user info
+  // never get this far - bails out.
+  int host_begin = scheme_len + 3;
+  int host_end = host_begin;
+  bool last_label_alpha_only = true;
+  char prev = '.';  // Makes a leading dot look like an empty label.
+  while (host_end < spec_len) {
+    char c = spec[host_end];
+    if (c == '/' || c == '?' || c == '#')
+      break;
+    if (c == '.') {
+      if (prev == '.')
+        return false;  // Empty label.
+      last_label_alpha_only = true;
+    } else if (c >= 'a' && c <= 'z') {
+      // Letters never need rewriting.
+    } else if ((c >= '0' && c <= '9') || c == '-') {
+      last_label_alpha_only = false;
+    } else {
+      return false;
+    }
+    prev = c;
+    ++host_end;
+  }
+  if (host_end == host_begin || prev == '.')
+    return false;  // Empty host, or trailing dot.
+
+  // If the last label is not purely alphabetic the host could parse as an
+  // IPv4 address, whose canonical form may be different.
+  if (!last_label_alpha_only)
+    return false;
+
+  // The canonicalizer appends a slash to bare authorities, so the path must
+  // already be present, and must not contain anything that looks like a dot
+  // segment or an escape sequence.
+  if (host_end == spec_len || spec[host_end] != '/')
+    return false;
+
+  int path_begin = host_end;
+  int path_end = path_begin;
+  prev = 0;
+  while (path_end < spec_len) {
+    char c = spec[path_end];
+    if (c == '?' || c == '#')
+      break;
+    if (c == '.') {
+      if (prev == '/')
+        return false;  // Possible dot segment.
+    } else if (!IsCanonicalPathChar(static_cast<unsigned char>(c))) {
+      return false;
+    }
+    prev = c;
+    ++path_end;
+  }
+
+  // Refs take the slow path; the query, if any, must consist of characters
+  // the query canonicalizer copies through verbatim.
+  Component query;
+  if (path_end < spec_len) {
+    if (spec[path_end] == '#')
+      return false;
+    int query_begin = path_end + 1;
+    for (int i = query_begin; i < spec_len; ++i) {
+      char c = spec[i];
+      if (c == '#' || !IsQueryChar(static_cast<unsigned char>(c)))
+        return false;
+    }
+    query = Component(query_begin, spec_len - query_begin);
+  }
+
+  *output_parsed = Parsed();
+  output_parsed->scheme = Component(0, scheme_len);
+  output_parsed->host = Component(host_begin, host_end - host_begin);
+  output_parsed->path = Component(path_begin, path_end - path_begin);
+  output_parsed->query = query;
+
+  output->Append(spec, spec_len);
+  return true;
+}
+
 }  // namespace
 
 void Initialize() {
@@ -423,6 +548,8 @@ bool Canonicalize(const char* spec,
                   CharsetConverter* charset_converter,
                   CanonOutput* output,
                   Parsed* output_parsed) {
+  if (DoFastPathCanonicalizeHttpURL(spec, spec_len, output, output_parsed))
+    return true;
   return DoCanonicalize(spec, spec_len, trim_path_end, charset_converter,
                         output, output_parsed);
 }
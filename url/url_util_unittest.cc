@@ -294,4 +294,69 @@ TEST(URLUtilTest, TestResolveRelativeWithNonStandardBase) {
   }
 }
 
+// Canonicalize() short-circuits already-canonical ASCII http/https URLs.
+// Whatever route an input takes, the result must match running the standard
+// parse/canonicalize pipeline directly.
+static void CheckCanonicalizeMatchesStandardPipeline(const char* spec) {
+  int spec_len = static_cast<int>(strlen(spec));
+
+  Parsed reference_input_parsed;
+  ParseStandardURL(spec, spec_len, &reference_input_parsed);
+  std::string reference;
+  StdStringCanonOutput reference_output(&reference);
+  Parsed reference_parsed;
+  bool reference_valid =
+      CanonicalizeStandardURL(spec, spec_len, reference_input_parsed, NULL,
+                              &reference_output, &reference_parsed);
+  reference_output.Complete();
+
+  std::string actual;
+  StdStringCanonOutput actual_output(&actual);
+  Parsed actual_parsed;
+  bool actual_valid = Canonicalize(spec, spec_len, true, NULL, &actual_output,
+                                   &actual_parsed);
+  actual_output.Complete();
+
+  EXPECT_EQ(reference_valid, actual_valid) << spec;
+  EXPECT_EQ(reference, actual) << spec;
+  EXPECT_TRUE(reference_parsed.scheme == actual_parsed.scheme) << spec;
+  EXPECT_TRUE(reference_parsed.username == actual_parsed.username) << spec;
+  EXPECT_TRUE(reference_parsed.password == actual_parsed.password) << spec;
+  EXPECT_TRUE(reference_parsed.host == actual_parsed.host) << spec;
+  EXPECT_TRUE(reference_parsed.port == actual_parsed.port) << spec;
+  EXPECT_TRUE(reference_parsed.path == actual_parsed.path) << spec;
+  EXPECT_TRUE(reference_parsed.query == actual_parsed.query) << spec;
+  EXPECT_TRUE(reference_parsed.ref == actual_parsed.ref) << spec;
+}
+
+TEST(URLUtilTest, CanonicalizeFastPathEquivalence) {
+  const char* cases[] = {
+    // Already-canonical URLs that the fast path accepts.
+    "http://example.com/",
+    "https://example.com/",
+    "http://www.example.com/path/to/file.html",
+    "http://example.com/?q=term",
+    "http://a.b-c.example/x?y=z",
+    // Inputs the fast path must reject and hand to the full pipeline.
+    "HTTP://example.com/",             // Uppercase scheme.
+    "http://Example.com/",             // Uppercase host.
+    "http://example.com",              // Missing path slash.
+    "http://example.com./",            // Trailing dot in host.
+    "http://example..com/",            // Empty label.
+    "http://127.0.0.1/",               // IPv4, needs component rules.
+    "http://example.com:8080/",        // Explicit port.
+    "http://user@example.com/",        // Userinfo.
+    "http://example.com/a/../b",       // Dot segments.
+    "http://example.com/a%41b",        // Escapes may unescape.
+    "http://example.com/a b",          // Needs escaping.
+    "http://example.com/#ref",         // Ref component.
+    "http://example.com/?a#b",         // Ref after query.
+    "http://example.com/?a b",         // Query needs escaping.
+    "ftp://example.com/",              // Non-http standard scheme.
+  };
+
+  for (size_t i = 0; i < ARRAYSIZE_UNSAFE(cases); i++)
+    CheckCanonicalizeMatchesStandardPipeline(cases[i]);
+}
+
 }  // namespace url
@@ -140,8 +140,8 @@ void BlobStorageContext::AppendBlobDataItem(
   //    modification time.
   // 3) The FileSystem File item is denoted by the FileSystem URL, the range
   //    and the expected modification time.
-  // 4) The Blob items are expanded.
-  // TODO(michaeln): Would be nice to avoid copying Data items when expanding.
+  // 4) The Blob items are expanded. Data items of the source blob are
+  //    shared by reference rather than copied, see ExpandStorageItems.
 
   DCHECK(item.length() > 0);
   switch (item.type()) {
@@ -246,8 +246,9 @@ bool BlobStorageContext::ExpandStorageItems(
     uint64 current_length = iter->length() - offset;
     uint64 new_length = current_length > length ? length : current_length;
     if (iter->type() == BlobData::Item::TYPE_BYTES) {
-      if (!AppendBytesItem(
+      if (!AppendSharedBytesItem(
               target_blob_data,
+              src_blob_data,
               iter->bytes() + static_cast<size_t>(iter->offset() + offset),
               static_cast<int64>(new_length))) {
         return false;  // exceeded memory
@@ -285,6 +286,24 @@ bool BlobStorageContext::AppendBytesItem(
   return true;
 }
 
+bool BlobStorageContext::AppendSharedBytesItem(
+    BlobData* target_blob_data, BlobData* src_blob_data,
+    const char* bytes, int64 length) {
+  if (length < 0) {
+    DCHECK(false);
+    return false;
+  }
+  if (memory_usage_ + length > kMaxMemoryUsage)
+    return false;
+  // The bytes are shared with |src_blob_data| rather than copied, but are
+  // still charged against the memory cap so the accounting of each blob's
+  // GetMemoryUsage() stays balanced as blobs come and go.
+  target_blob_data->AppendSharedData(src_blob_data, bytes,
+                                     static_cast<size_t>(length));
+  memory_usage_ += length;
+  return true;
+}
+
 void BlobStorageContext::AppendFileItem(
     BlobData* target_blob_data,
     const base::FilePath& file_path, uint64 offset, uint64 length,
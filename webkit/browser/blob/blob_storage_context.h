@@ -89,6 +89,9 @@ class WEBKIT_STORAGE_BROWSER_EXPORT BlobStorageContext
                           uint64 length);
   bool AppendBytesItem(BlobData* target_blob_data,
                        const char* data, int64 length);
+  bool AppendSharedBytesItem(BlobData* target_blob_data,
+                             BlobData* src_blob_data,
+                             const char* data, int64 length);
   void AppendFileItem(BlobData* target_blob_data,
                       const base::FilePath& file_path,
                       uint64 offset, uint64 length,
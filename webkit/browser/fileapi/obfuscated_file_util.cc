@@ -137,22 +137,22 @@ class ObfuscatedFileEnumerator
     if (display_stack_.empty())
       return base::FilePath();
 
-    current_file_id_ = display_stack_.back();
+    FileIdAndInfo entry = display_stack_.back();
     display_stack_.pop_back();
+    current_file_id_ = entry.file_id;
 
-    FileInfo file_info;
     base::FilePath platform_file_path;
     base::File::Error error =
-        obfuscated_file_util_->GetFileInfoInternal(
-            db_, context_, root_url_, current_file_id_,
-            &file_info, &current_platform_file_info_, &platform_file_path);
+        obfuscated_file_util_->GetPlatformFileInfoInternal(
+            db_, context_, root_url_, entry.file_id, entry.info,
+            &current_platform_file_info_, &platform_file_path);
     if (error != base::File::FILE_OK)
       return Next();
 
     base::FilePath virtual_path =
-        current_parent_virtual_path_.Append(file_info.name);
-    if (recursive_ && file_info.is_directory()) {
-      FileRecord record = { current_file_id_, virtual_path };
+        current_parent_virtual_path_.Append(entry.info.name);
+    if (recursive_ && entry.info.is_directory()) {
+      FileRecord record = { entry.file_id, virtual_path };
       recurse_queue_.push(record);
     }
     return virtual_path;
@@ -173,6 +173,7 @@ class ObfuscatedFileEnumerator
  private:
   typedef SandboxDirectoryDatabase::FileId FileId;
   typedef SandboxDirectoryDatabase::FileInfo FileInfo;
+  typedef SandboxDirectoryDatabase::FileIdAndInfo FileIdAndInfo;
 
   struct FileRecord {
     FileId file_id;
@@ -183,7 +184,9 @@ class ObfuscatedFileEnumerator
     while (display_stack_.empty() && !recurse_queue_.empty()) {
       FileRecord entry = recurse_queue_.front();
       recurse_queue_.pop();
-      if (!db_->ListChildren(entry.file_id, &display_stack_)) {
+      // Fetch the children's ids and infos in one batch; reading the info
+      // record of each entry separately adds up for large directories.
+      if (!db_->ListChildrenWithInfo(entry.file_id, &display_stack_)) {
         display_stack_.clear();
         return;
       }
@@ -198,7 +201,7 @@ class ObfuscatedFileEnumerator
   bool recursive_;
 
   std::queue<FileRecord> recurse_queue_;
-  std::vector<FileId> display_stack_;
+  std::vector<FileIdAndInfo> display_stack_;
   base::FilePath current_parent_virtual_path_;
 
   FileId current_file_id_;
@@ -1004,19 +1007,35 @@ base::File::Error ObfuscatedFileUtil::GetFileInfoInternal(
     NOTREACHED();
     return base::File::FILE_ERROR_FAILED;
   }
+  return GetPlatformFileInfoInternal(db, context, url, file_id, *local_info,
+                                     file_info, platform_file_path);
+}
+
+base::File::Error ObfuscatedFileUtil::GetPlatformFileInfoInternal(
+    SandboxDirectoryDatabase* db,
+    FileSystemOperationContext* context,
+    const FileSystemURL& url,
+    FileId file_id,
+    const FileInfo& local_info,
+    base::File::Info* file_info,
+    base::FilePath* platform_file_path) {
+  DCHECK(db);
+  DCHECK(context);
+  DCHECK(file_info);
+  DCHECK(platform_file_path);
 
-  if (local_info->is_directory()) {
+  if (local_info.is_directory()) {
     file_info->size = 0;
     file_info->is_directory = true;
     file_info->is_symbolic_link = false;
-    file_info->last_modified = local_info->modification_time;
+    file_info->last_modified = local_info.modification_time;
     *platform_file_path = base::FilePath();
     // We don't fill in ctime or atime.
     return base::File::FILE_OK;
   }
-  if (local_info->data_path.empty())
+  if (local_info.data_path.empty())
     return base::File::FILE_ERROR_INVALID_OPERATION;
-  base::FilePath local_path = DataPathToLocalPath(url, local_info->data_path);
+  base::FilePath local_path = DataPathToLocalPath(url, local_info.data_path);
   base::File::Error error = NativeFileUtil::GetFileInfo(
       local_path, file_info);
   // We should not follow symbolic links in sandboxed file system.
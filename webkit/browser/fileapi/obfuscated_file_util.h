@@ -259,6 +259,18 @@ class WEBKIT_STORAGE_BROWSER_EXPORT_PRIVATE ObfuscatedFileUtil
       base::File::Info* file_info,
       base::FilePath* platform_file_path);
 
+  // Fills in |file_info| and |platform_file_path| for a database entry
+  // whose FileInfo has already been read. Used by GetFileInfoInternal and
+  // by the file enumerator, which reads directory entries in batches.
+  base::File::Error GetPlatformFileInfoInternal(
+      SandboxDirectoryDatabase* db,
+      FileSystemOperationContext* context,
+      const FileSystemURL& url,
+      FileId file_id,
+      const FileInfo& local_info,
+      base::File::Info* file_info,
+      base::FilePath* platform_file_path);
+
   // Creates a new file, both the underlying backing file and the entry in the
   // database.  |dest_file_info| is an in-out parameter.  Supply the name and
   // parent_id; data_path is ignored.  On success, data_path will
@@ -409,6 +409,12 @@ SandboxDirectoryDatabase::FileInfo::FileInfo() : parent_id(0) {
 SandboxDirectoryDatabase::FileInfo::~FileInfo() {
 }
 
+SandboxDirectoryDatabase::FileIdAndInfo::FileIdAndInfo() : file_id(0) {
+}
+
+SandboxDirectoryDatabase::FileIdAndInfo::~FileIdAndInfo() {
+}
+
 SandboxDirectoryDatabase::SandboxDirectoryDatabase(
     const base::FilePath& filesystem_data_directory,
     leveldb::Env* env_override)
@@ -486,6 +492,58 @@ bool SandboxDirectoryDatabase::ListChildren(
   return true;
 }
 
+bool SandboxDirectoryDatabase::ListChildrenWithInfo(
+    FileId parent_id, std::vector<FileIdAndInfo>* children) {
+  if (!Init(REPAIR_ON_CORRUPTION))
+    return false;
+  DCHECK(children);
+  std::string child_key_prefix = GetChildListingKeyPrefix(parent_id);
+
+  scoped_ptr<leveldb::Iterator> iter(db_->NewIterator(leveldb::ReadOptions()));
+  iter->Seek(child_key_prefix);
+  std::vector<FileId> child_ids;
+  while (iter->Valid() &&
+      StartsWithASCII(iter->key().ToString(), child_key_prefix, true)) {
+    std::string child_id_string = iter->value().ToString();
+    FileId child_id;
+    if (!base::StringToInt64(child_id_string, &child_id)) {
+      LOG(ERROR) << "Hit database corruption!";
+      return false;
+    }
+    child_ids.push_back(child_id);
+    iter->Next();
+  }
+
+  // Read each child's info with the same iterator rather than issuing a
+  // separate Get per child; this amortizes the per-lookup overhead when
+  // enumerating large directories.
+  children->clear();
+  children->reserve(child_ids.size());
+  for (size_t i = 0; i < child_ids.size(); ++i) {
+    std::string file_key = GetFileLookupKey(child_ids[i]);
+    iter->Seek(file_key);
+    if (!iter->Valid() || iter->key().ToString() != file_key) {
+      LOG(WARNING) << "Missing info for file " << child_ids[i];
+      continue;
+    }
+    FileIdAndInfo entry;
+    entry.file_id = child_ids[i];
+    std::string file_data_string = iter->value().ToString();
+    if (!FileInfoFromPickle(
+            Pickle(file_data_string.data(), file_data_string.length()),
+            &entry.info)) {
+      continue;
+    }
+    if (!VerifyDataPath(entry.info.data_path)) {
+      LOG(ERROR) << "Resolved data path is invalid: "
+                 << entry.info.data_path.value();
+      continue;
+    }
+    children->push_back(entry);
+  }
+  return true;
+}
+
 bool SandboxDirectoryDatabase::GetFileInfo(FileId file_id, FileInfo* info) {
   if (!Init(REPAIR_ON_CORRUPTION))
     return false;
@@ -61,6 +61,14 @@ class WEBKIT_STORAGE_BROWSER_EXPORT_PRIVATE SandboxDirectoryDatabase {
     base::Time modification_time;
   };
 
+  struct WEBKIT_STORAGE_BROWSER_EXPORT_PRIVATE FileIdAndInfo {
+    FileIdAndInfo();
+    ~FileIdAndInfo();
+
+    FileId file_id;
+    FileInfo info;
+  };
+
   SandboxDirectoryDatabase(
       const base::FilePath& filesystem_data_directory,
       leveldb::Env* env_override);
@@ -74,6 +82,13 @@ class WEBKIT_STORAGE_BROWSER_EXPORT_PRIVATE SandboxDirectoryDatabase {
   // ListChildren will succeed, returning 0 children, if parent_id doesn't
   // exist.
   bool ListChildren(FileId parent_id, std::vector<FileId>* children);
+  // Reads every child's FileInfo along with its id using a single database
+  // iterator, rather than a separate lookup per child. Children whose info
+  // records are missing or unreadable are omitted from the result. Like
+  // ListChildren, this succeeds with an empty result if parent_id doesn't
+  // exist.
+  bool ListChildrenWithInfo(FileId parent_id,
+                            std::vector<FileIdAndInfo>* children);
   bool GetFileInfo(FileId file_id, FileInfo* info);
   base::File::Error AddFileInfo(const FileInfo& info, FileId* file_id);
   bool RemoveFileInfo(FileId file_id);
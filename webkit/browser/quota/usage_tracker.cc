@@ -363,6 +363,7 @@ void ClientUsageTracker::UpdateUsageCache(
       return;
 
     cached_usage_by_host_[host][origin] += delta;
+    cached_host_usage_totals_[host] += delta;
     if (IsStorageUnlimited(origin))
       global_unlimited_usage_ += delta;
     else
@@ -422,6 +423,7 @@ void ClientUsageTracker::SetUsageCacheEnabled(const GURL& origin,
         cached_usage_for_host.erase(found);
         if (cached_usage_for_host.empty()) {
           cached_usage_by_host_.erase(found_host);
+          cached_host_usage_totals_.erase(host);
           cached_hosts_.erase(host);
         }
       }
@@ -580,6 +582,7 @@ void ClientUsageTracker::AddCachedOrigin(
   int64 delta = new_usage - *usage;
   *usage = new_usage;
   if (delta) {
+    cached_host_usage_totals_[host] += delta;
     if (IsStorageUnlimited(origin))
       global_unlimited_usage_ += delta;
     else
@@ -594,17 +597,15 @@ void ClientUsageTracker::AddCachedHost(const std::string& host) {
 }
 
 int64 ClientUsageTracker::GetCachedHostUsage(const std::string& host) const {
-  HostUsageMap::const_iterator found = cached_usage_by_host_.find(host);
-  if (found == cached_usage_by_host_.end())
+  // The per-host total is maintained incrementally as origin usage is
+  // cached and updated, so there is no need to sum the origin map here.
+  HostUsageTotalMap::const_iterator found =
+      cached_host_usage_totals_.find(host);
+  if (found == cached_host_usage_totals_.end())
     return 0;
 
-  int64 usage = 0;
-  const UsageMap& map = found->second;
-  for (UsageMap::const_iterator iter = map.begin();
-       iter != map.end(); ++iter) {
-    usage += iter->second;
-  }
-  return usage;
+  DCHECK_GE(found->second, 0);
+  return found->second;
 }
 
 bool ClientUsageTracker::GetCachedOriginUsage(
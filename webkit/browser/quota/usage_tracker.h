@@ -127,6 +127,7 @@ class ClientUsageTracker : public SpecialStoragePolicy::Observer,
   typedef std::set<std::string> HostSet;
   typedef std::map<GURL, int64> UsageMap;
   typedef std::map<std::string, UsageMap> HostUsageMap;
+  typedef std::map<std::string, int64> HostUsageTotalMap;
 
   struct AccumulateInfo {
     int pending_jobs;
@@ -186,6 +187,11 @@ class ClientUsageTracker : public SpecialStoragePolicy::Observer,
   HostSet cached_hosts_;
   HostUsageMap cached_usage_by_host_;
 
+  // Running per-host totals of |cached_usage_by_host_|, kept up to date as
+  // origin usage is cached and updated so host usage queries don't have to
+  // sum over all of a host's origins.
+  HostUsageTotalMap cached_host_usage_totals_;
+
   OriginSetByHost non_cached_limited_origins_by_host_;
   OriginSetByHost non_cached_unlimited_origins_by_host_;
 
@@ -24,6 +24,15 @@ void BlobData::AppendData(const char* data, size_t length) {
   items_.back().SetToBytes(data, length);
 }
 
+void BlobData::AppendSharedData(BlobData* owner, const char* data,
+                                size_t length) {
+  DCHECK(length > 0);
+  DCHECK(owner && owner != this);
+  items_.push_back(Item());
+  items_.back().SetToSharedBytes(data, length);
+  retained_blobs_.push_back(owner);
+}
+
 void BlobData::AppendFile(const base::FilePath& file_path,
                           uint64 offset, uint64 length,
                           const base::Time& expected_modification_time) {
@@ -34,6 +34,11 @@ class WEBKIT_STORAGE_COMMON_EXPORT BlobData
 
   void AppendData(const char* data, size_t length);
 
+  // Appends bytes owned by |owner|, another blob whose data is being shared
+  // with this one. The bytes are not copied; a reference to |owner| is
+  // retained to keep them alive for this blob's lifetime.
+  void AppendSharedData(BlobData* owner, const char* data, size_t length);
+
   void AppendFile(const base::FilePath& file_path, uint64 offset, uint64 length,
                   const base::Time& expected_modification_time);
   void AppendBlob(const std::string& uuid, uint64 offset, uint64 length);
@@ -70,6 +75,9 @@ class WEBKIT_STORAGE_COMMON_EXPORT BlobData
   std::vector<Item> items_;
   std::vector<scoped_refptr<ShareableFileReference> > shareable_files_;
 
+  // Blobs whose in-memory data is shared with items in |items_|.
+  std::vector<scoped_refptr<BlobData> > retained_blobs_;
+
   DISALLOW_COPY_AND_ASSIGN(BlobData);
 };
 